@@ -32,6 +32,7 @@
 #include "pitch.h"
 #include "kiss_fft.h"
 #include "mdct.h"
+#include "celt_output.h"
 
 #if defined(OPUS_HAVE_RTCD)
 
@@ -54,6 +55,60 @@ void (*const DUAL_INNER_PROD_IMPL[OPUS_ARCHMASK+1])(const opus_val16 *x, const o
 };
 # endif
 
+# if defined(OPUS_ARM_MAY_HAVE_NEON_INTR) && !defined(OPUS_ARM_PRESUME_NEON_INTR) && !defined(FIXED_POINT)
+void (*const COMB_FILTER_OVERLAP_IMPL[OPUS_ARCHMASK+1])(opus_val32 *y, const opus_val32 *x,
+      int T0, int T1, int N, const opus_val16 *g0, const opus_val16 *g1, const opus_val16 *window) = {
+  comb_filter_overlap_c,   /* ARMv4 */
+  comb_filter_overlap_c,   /* EDSP */
+  comb_filter_overlap_c,   /* Media */
+  comb_filter_overlap_neon,/* NEON */
+  comb_filter_overlap_neon /* DOTPROD */
+};
+
+celt_sig (*const DEEMPHASIS_CHANNEL_IMPL[OPUS_ARCHMASK+1])(const celt_sig *x, opus_val16 *y,
+      int N, int C, int downsample, opus_val16 coef0, celt_sig m) = {
+  deemphasis_channel_c,   /* ARMv4 */
+  deemphasis_channel_c,   /* EDSP */
+  deemphasis_channel_c,   /* Media */
+  deemphasis_channel_neon,/* NEON */
+  deemphasis_channel_neon /* DOTPROD */
+};
+
+void (*const DEEMPHASIS_STEREO_IMPL[OPUS_ARCHMASK+1])(const celt_sig *x0, const celt_sig *x1,
+      opus_val16 *pcm, int N, opus_val16 coef0, celt_sig *mem) = {
+  deemphasis_stereo_c,   /* ARMv4 */
+  deemphasis_stereo_c,   /* EDSP */
+  deemphasis_stereo_c,   /* Media */
+  deemphasis_stereo_neon,/* NEON */
+  deemphasis_stereo_neon /* DOTPROD */
+};
+
+void (*const SMOOTH_FADE_IMPL[OPUS_ARCHMASK+1])(const opus_val16 *in1, const opus_val16 *in2,
+      opus_val16 *out, int overlap, int channels, const opus_val16 *window, int inc) = {
+  smooth_fade_c,   /* ARMv4 */
+  smooth_fade_c,   /* EDSP */
+  smooth_fade_c,   /* Media */
+  smooth_fade_neon,/* NEON */
+  smooth_fade_neon /* DOTPROD */
+};
+
+void (*const CELT_FLOAT2INT16_IMPL[OPUS_ARCHMASK+1])(const float *in, opus_int16 *out, int cnt) = {
+  celt_float2int16_c,   /* ARMv4 */
+  celt_float2int16_c,   /* EDSP */
+  celt_float2int16_c,   /* Media */
+  celt_float2int16_neon,/* NEON */
+  celt_float2int16_neon /* DOTPROD */
+};
+
+int (*const OPUS_LIMIT2_CHECKWITHIN1_IMPL[OPUS_ARCHMASK+1])(float *samples, int cnt) = {
+  opus_limit2_checkwithin1_c,   /* ARMv4 */
+  opus_limit2_checkwithin1_c,   /* EDSP */
+  opus_limit2_checkwithin1_c,   /* Media */
+  opus_limit2_checkwithin1_neon,/* NEON */
+  opus_limit2_checkwithin1_neon /* DOTPROD */
+};
+# endif
+
 # if defined(FIXED_POINT)
 #  if ((defined(OPUS_ARM_MAY_HAVE_NEON) && !defined(OPUS_ARM_PRESUME_NEON)) || \
     (defined(OPUS_ARM_MAY_HAVE_MEDIA) && !defined(OPUS_ARM_PRESUME_MEDIA)) || \
@@ -0,0 +1,288 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <arm_neon.h>
+#include "../celt_output.h"
+#include "../float_cast.h"
+
+#if defined(OPUS_ARM_MAY_HAVE_NEON_INTR) && !defined(FIXED_POINT)
+
+void comb_filter_overlap_neon(opus_val32 *y, const opus_val32 *x, int T0,
+      int T1, int N, const opus_val16 *g0, const opus_val16 *g1,
+      const opus_val16 *window)
+{
+   int i;
+   float32x4_t one, g00, g01, g02, g10, g11, g12;
+   one = vdupq_n_f32(Q15ONE);
+   g00 = vdupq_n_f32(g0[0]);
+   g01 = vdupq_n_f32(g0[1]);
+   g02 = vdupq_n_f32(g0[2]);
+   g10 = vdupq_n_f32(g1[0]);
+   g11 = vdupq_n_f32(g1[1]);
+   g12 = vdupq_n_f32(g1[2]);
+   /* T0,T1 >= COMBFILTER_MINPERIOD, so when filtering in place every x[]
+      value read here has already been written. */
+   for (i=0;i<N-3;i+=4)
+   {
+      float32x4_t f, omf, t;
+      f = vld1q_f32(window+i);
+      f = vmulq_f32(f, f);
+      omf = vsubq_f32(one, f);
+      t = vld1q_f32(x+i);
+      t = vaddq_f32(t, vmulq_f32(vmulq_f32(omf, g00), vld1q_f32(x+i-T0)));
+      t = vaddq_f32(t, vmulq_f32(vmulq_f32(omf, g01),
+            vaddq_f32(vld1q_f32(x+i-T0+1), vld1q_f32(x+i-T0-1))));
+      t = vaddq_f32(t, vmulq_f32(vmulq_f32(omf, g02),
+            vaddq_f32(vld1q_f32(x+i-T0+2), vld1q_f32(x+i-T0-2))));
+      t = vaddq_f32(t, vmulq_f32(vmulq_f32(f, g10), vld1q_f32(x+i-T1)));
+      t = vaddq_f32(t, vmulq_f32(vmulq_f32(f, g11),
+            vaddq_f32(vld1q_f32(x+i-T1+1), vld1q_f32(x+i-T1-1))));
+      t = vaddq_f32(t, vmulq_f32(vmulq_f32(f, g12),
+            vaddq_f32(vld1q_f32(x+i-T1+2), vld1q_f32(x+i-T1-2))));
+      vst1q_f32(y+i, t);
+   }
+   if (i<N)
+      comb_filter_overlap_c(y+i, x+i, T0, T1, N-i, g0, g1, window+i);
+}
+
+/* Block form of the de-emphasis recursion, see deemph_scan4() in
+   x86/celt_output_sse2.c. */
+static OPUS_INLINE float32x4_t deemph_scan4(float32x4_t a, float32x4_t c1,
+      float32x4_t c2)
+{
+   const float32x4_t zero = vdupq_n_f32(0);
+   a = vaddq_f32(a, vmulq_f32(c1, vextq_f32(zero, a, 3)));
+   a = vaddq_f32(a, vmulq_f32(c2, vextq_f32(zero, a, 2)));
+   return a;
+}
+
+celt_sig deemphasis_channel_neon(const celt_sig *x, opus_val16 *y, int N,
+      int C, int downsample, opus_val16 coef0, celt_sig m)
+{
+   int j;
+   int o, next;
+   int Nd;
+   float c2;
+   float p[4];
+   float32x4_t c1v, c2v, pw, pw4, carry, vsmall, scale;
+   Nd = N/downsample;
+   c2 = coef0*coef0;
+   c1v = vdupq_n_f32(coef0);
+   c2v = vdupq_n_f32(c2);
+   p[0] = 1.f;
+   p[1] = coef0;
+   p[2] = c2;
+   p[3] = c2*coef0;
+   pw = vld1q_f32(p);
+   pw4 = vmulq_f32(pw, c1v);
+   carry = vdupq_n_f32(m);
+   vsmall = vdupq_n_f32(VERY_SMALL);
+   scale = vdupq_n_f32(1.f/CELT_SIG_SCALE);
+   o = next = 0;
+   for (j=0;j<N-3;j+=4)
+   {
+      float32x4_t tmp;
+      tmp = deemph_scan4(vaddq_f32(vld1q_f32(x+j), vsmall), c1v, c2v);
+      tmp = vaddq_f32(tmp, vmulq_f32(pw, carry));
+      carry = vdupq_n_f32(vgetq_lane_f32(tmp, 3));
+      pw = pw4;
+      tmp = vmulq_f32(tmp, scale);
+      if (downsample == 1 && C == 1)
+         vst1q_f32(y+j, tmp);
+      else {
+         float buf[4];
+         vst1q_f32(buf, tmp);
+         while (next < j+4 && o < Nd)
+         {
+            y[o*C] = buf[next-j];
+            o++;
+            next += downsample;
+         }
+      }
+   }
+   if (j > 0)
+      m = coef0*vgetq_lane_f32(carry, 0);
+   if (downsample == 1 && C == 1)
+      o = next = j;
+   for (;j<N;j++)
+   {
+      celt_sig tmp = x[j] + VERY_SMALL + m;
+      m = MULT16_32_Q15(coef0, tmp);
+      if (j == next && o < Nd)
+      {
+         y[o*C] = SCALEOUT(SIG2WORD16(tmp));
+         o++;
+         next += downsample;
+      }
+   }
+   return m;
+}
+
+void deemphasis_stereo_neon(const celt_sig *x0, const celt_sig *x1,
+      opus_val16 *pcm, int N, opus_val16 coef0, celt_sig *mem)
+{
+   int j;
+   float c2;
+   float p[4];
+   float32x4_t c1v, c2v, pw, pw4, carry0, carry1, vsmall, scale;
+   c2 = coef0*coef0;
+   c1v = vdupq_n_f32(coef0);
+   c2v = vdupq_n_f32(c2);
+   p[0] = 1.f;
+   p[1] = coef0;
+   p[2] = c2;
+   p[3] = c2*coef0;
+   pw = vld1q_f32(p);
+   pw4 = vmulq_f32(pw, c1v);
+   carry0 = vdupq_n_f32(mem[0]);
+   carry1 = vdupq_n_f32(mem[1]);
+   vsmall = vdupq_n_f32(VERY_SMALL);
+   scale = vdupq_n_f32(1.f/CELT_SIG_SCALE);
+   for (j=0;j<N-3;j+=4)
+   {
+      float32x4x2_t out;
+      float32x4_t tmp0, tmp1;
+      tmp0 = deemph_scan4(vaddq_f32(vld1q_f32(x0+j), vsmall), c1v, c2v);
+      tmp1 = deemph_scan4(vaddq_f32(vld1q_f32(x1+j), vsmall), c1v, c2v);
+      tmp0 = vaddq_f32(tmp0, vmulq_f32(pw, carry0));
+      tmp1 = vaddq_f32(tmp1, vmulq_f32(pw, carry1));
+      carry0 = vdupq_n_f32(vgetq_lane_f32(tmp0, 3));
+      carry1 = vdupq_n_f32(vgetq_lane_f32(tmp1, 3));
+      pw = pw4;
+      out.val[0] = vmulq_f32(tmp0, scale);
+      out.val[1] = vmulq_f32(tmp1, scale);
+      vst2q_f32(pcm+2*j, out);
+   }
+   if (j > 0)
+   {
+      mem[0] = coef0*vgetq_lane_f32(carry0, 0);
+      mem[1] = coef0*vgetq_lane_f32(carry1, 0);
+   }
+   if (j < N)
+      deemphasis_stereo_c(x0+j, x1+j, pcm+2*j, N-j, coef0, mem);
+}
+
+static OPUS_INLINE void smooth_fade4(const float *in1, const float *in2,
+      float *out, float32x4_t w, float32x4_t one)
+{
+   vst1q_f32(out, vaddq_f32(vmulq_f32(w, vld1q_f32(in2)),
+         vmulq_f32(vsubq_f32(one, w), vld1q_f32(in1))));
+}
+
+void smooth_fade_neon(const opus_val16 *in1, const opus_val16 *in2,
+      opus_val16 *out, int overlap, int channels,
+      const opus_val16 *window, int inc)
+{
+   int i;
+   float32x4_t one;
+   if (channels != 1 && channels != 2)
+   {
+      smooth_fade_c(in1, in2, out, overlap, channels, window, inc);
+      return;
+   }
+   one = vdupq_n_f32(Q15ONE);
+   for (i=0;i<overlap-3;i+=4)
+   {
+      float wbuf[4];
+      float32x4_t w;
+      wbuf[0] = window[i*inc];
+      wbuf[1] = window[(i+1)*inc];
+      wbuf[2] = window[(i+2)*inc];
+      wbuf[3] = window[(i+3)*inc];
+      w = vld1q_f32(wbuf);
+      w = vmulq_f32(w, w);
+      if (channels == 1)
+         smooth_fade4(in1+i, in2+i, out+i, w, one);
+      else {
+         float32x4x2_t w2 = vzipq_f32(w, w);
+         smooth_fade4(in1+2*i, in2+2*i, out+2*i, w2.val[0], one);
+         smooth_fade4(in1+2*i+4, in2+2*i+4, out+2*i+4, w2.val[1], one);
+      }
+   }
+   if (i<overlap)
+      smooth_fade_c(in1+i*channels, in2+i*channels, out+i*channels,
+            overlap-i, channels, window+i*inc, inc);
+}
+
+void celt_float2int16_neon(const float *in, opus_int16 *out, int cnt)
+{
+   int i;
+   float32x4_t scale, minval, maxval, round;
+   scale = vdupq_n_f32(CELT_SIG_SCALE);
+   minval = vdupq_n_f32(-32768.f);
+   maxval = vdupq_n_f32(32767.f);
+   /* Adding and subtracting 1.5*2^23 rounds to nearest-even like lrintf()
+      for the clamped range, and works on ARMv7 which lacks vcvtnq. */
+   round = vdupq_n_f32(12582912.f);
+   for (i=0;i<cnt-7;i+=8)
+   {
+      float32x4_t a, b;
+      a = vmulq_f32(vld1q_f32(in+i), scale);
+      b = vmulq_f32(vld1q_f32(in+i+4), scale);
+      a = vminq_f32(vmaxq_f32(a, minval), maxval);
+      b = vminq_f32(vmaxq_f32(b, minval), maxval);
+      a = vsubq_f32(vaddq_f32(a, round), round);
+      b = vsubq_f32(vaddq_f32(b, round), round);
+      vst1q_s16(out+i, vcombine_s16(vqmovn_s32(vcvtq_s32_f32(a)),
+            vqmovn_s32(vcvtq_s32_f32(b))));
+   }
+   for (;i<cnt;i++)
+      out[i] = FLOAT2INT16(in[i]);
+}
+
+int opus_limit2_checkwithin1_neon(float *samples, int cnt)
+{
+   int i;
+   int within1;
+   float32x4_t two, mtwo, one, mone;
+   uint32x4_t outside;
+   uint32x2_t outside2;
+   two = vdupq_n_f32(2.f);
+   mtwo = vdupq_n_f32(-2.f);
+   one = vdupq_n_f32(1.f);
+   mone = vdupq_n_f32(-1.f);
+   outside = vdupq_n_u32(0);
+   for (i=0;i<cnt-3;i+=4)
+   {
+      float32x4_t x;
+      x = vmaxq_f32(mtwo, vminq_f32(two, vld1q_f32(samples+i)));
+      vst1q_f32(samples+i, x);
+      outside = vorrq_u32(outside,
+            vorrq_u32(vcgtq_f32(x, one), vcltq_f32(x, mone)));
+   }
+   outside2 = vorr_u32(vget_low_u32(outside), vget_high_u32(outside));
+   within1 = (vget_lane_u32(outside2, 0) | vget_lane_u32(outside2, 1)) == 0;
+   if (i<cnt)
+      within1 &= opus_limit2_checkwithin1_c(samples+i, cnt-i);
+   return within1;
+}
+
+#endif
@@ -37,6 +37,7 @@
 #include "mdct.h"
 #include <math.h>
 #include "celt.h"
+#include "celt_output.h"
 #include "pitch.h"
 #include "bands.h"
 #include "modes.h"
@@ -191,10 +192,8 @@ void comb_filter(opus_val32 *y, opus_val32 *x, int T0, int T1, int N,
       opus_val16 g0, opus_val16 g1, int tapset0, int tapset1,
       const opus_val16 *window, int overlap, int arch)
 {
-   int i;
    /* printf ("%d %d %f %f\n", T0, T1, g0, g1); */
-   opus_val16 g00, g01, g02, g10, g11, g12;
-   opus_val32 x0, x1, x2, x3, x4;
+   opus_val16 tap0[3], tap1[3];
    static const opus_val16 gains[3][3] = {
          {QCONST16(0.3066406250f, 15), QCONST16(0.2170410156f, 15), QCONST16(0.1296386719f, 15)},
          {QCONST16(0.4638671875f, 15), QCONST16(0.2680664062f, 15), QCONST16(0.f, 15)},
@@ -211,38 +210,17 @@ void comb_filter(opus_val32 *y, opus_val32 *x, int T0, int T1, int N,
       to have then be at least 2 to avoid processing garbage data. */
    T0 = IMAX(T0, COMBFILTER_MINPERIOD);
    T1 = IMAX(T1, COMBFILTER_MINPERIOD);
-   g00 = MULT16_16_P15(g0, gains[tapset0][0]);
-   g01 = MULT16_16_P15(g0, gains[tapset0][1]);
-   g02 = MULT16_16_P15(g0, gains[tapset0][2]);
-   g10 = MULT16_16_P15(g1, gains[tapset1][0]);
-   g11 = MULT16_16_P15(g1, gains[tapset1][1]);
-   g12 = MULT16_16_P15(g1, gains[tapset1][2]);
-   x1 = x[-T1+1];
-   x2 = x[-T1  ];
-   x3 = x[-T1-1];
-   x4 = x[-T1-2];
+   tap0[0] = MULT16_16_P15(g0, gains[tapset0][0]);
+   tap0[1] = MULT16_16_P15(g0, gains[tapset0][1]);
+   tap0[2] = MULT16_16_P15(g0, gains[tapset0][2]);
+   tap1[0] = MULT16_16_P15(g1, gains[tapset1][0]);
+   tap1[1] = MULT16_16_P15(g1, gains[tapset1][1]);
+   tap1[2] = MULT16_16_P15(g1, gains[tapset1][2]);
    /* If the filter didn't change, we don't need the overlap */
    if (g0==g1 && T0==T1 && tapset0==tapset1)
       overlap=0;
-   for (i=0;i<overlap;i++)
-   {
-      opus_val16 f;
-      x0=x[i-T1+2];
-      f = MULT16_16_Q15(window[i],window[i]);
-      y[i] = x[i]
-               + MULT16_32_Q15(MULT16_16_Q15((Q15ONE-f),g00),x[i-T0])
-               + MULT16_32_Q15(MULT16_16_Q15((Q15ONE-f),g01),ADD32(x[i-T0+1],x[i-T0-1]))
-               + MULT16_32_Q15(MULT16_16_Q15((Q15ONE-f),g02),ADD32(x[i-T0+2],x[i-T0-2]))
-               + MULT16_32_Q15(MULT16_16_Q15(f,g10),x2)
-               + MULT16_32_Q15(MULT16_16_Q15(f,g11),ADD32(x1,x3))
-               + MULT16_32_Q15(MULT16_16_Q15(f,g12),ADD32(x0,x4));
-      y[i] = SATURATE(y[i], SIG_SAT);
-      x4=x3;
-      x3=x2;
-      x2=x1;
-      x1=x0;
-
-   }
+   if (overlap > 0)
+      comb_filter_overlap(y, x, T0, T1, overlap, tap0, tap1, window, arch);
    if (g1==0)
    {
       /* OPT: Happens to work without the OPUS_MOVE(), but only because the current encoder already copies x to y */
@@ -252,7 +230,7 @@ void comb_filter(opus_val32 *y, opus_val32 *x, int T0, int T1, int N,
    }
 
    /* Compute the part with the constant filter. */
-   comb_filter_const(y+i, x+i, T1, N-i, g10, g11, g12, arch);
+   comb_filter_const(y+overlap, x+overlap, T1, N-overlap, tap1[0], tap1[1], tap1[2], arch);
 }
 #endif /* OVERRIDE_comb_filter */
 
@@ -38,6 +38,7 @@
 #include "mdct.h"
 #include <math.h>
 #include "celt.h"
+#include "celt_output.h"
 #include "pitch.h"
 #include "bands.h"
 #include "modes.h"
@@ -50,6 +51,7 @@
 #include <stdarg.h>
 #include "celt_lpc.h"
 #include "vq.h"
+#include "profile.h"
 
 #ifdef ENABLE_DEEP_PLC
 #include "lpcnet.h"
@@ -242,42 +244,11 @@ void opus_custom_decoder_destroy(CELTDecoder *st)
 }
 #endif /* CUSTOM_MODES */
 
-#ifndef CUSTOM_MODES
-/* Special case for stereo with no downsampling and no accumulation. This is
-   quite common and we can make it faster by processing both channels in the
-   same loop, reducing overhead due to the dependency loop in the IIR filter. */
-static void deemphasis_stereo_simple(celt_sig *in[], opus_val16 *pcm, int N, const opus_val16 coef0,
-      celt_sig *mem)
-{
-   celt_sig * OPUS_RESTRICT x0;
-   celt_sig * OPUS_RESTRICT x1;
-   celt_sig m0, m1;
-   int j;
-   x0=in[0];
-   x1=in[1];
-   m0 = mem[0];
-   m1 = mem[1];
-   for (j=0;j<N;j++)
-   {
-      celt_sig tmp0, tmp1;
-      /* Add VERY_SMALL to x[] first to reduce dependency chain. */
-      tmp0 = x0[j] + VERY_SMALL + m0;
-      tmp1 = x1[j] + VERY_SMALL + m1;
-      m0 = MULT16_32_Q15(coef0, tmp0);
-      m1 = MULT16_32_Q15(coef0, tmp1);
-      pcm[2*j  ] = SCALEOUT(SIG2WORD16(tmp0));
-      pcm[2*j+1] = SCALEOUT(SIG2WORD16(tmp1));
-   }
-   mem[0] = m0;
-   mem[1] = m1;
-}
-#endif
-
 #ifndef RESYNTH
 static
 #endif
 void deemphasis(celt_sig *in[], opus_val16 *pcm, int N, int C, int downsample, const opus_val16 *coef,
-      celt_sig *mem, int accum)
+      celt_sig *mem, int accum, int arch)
 {
    int c;
    int Nd;
@@ -286,10 +257,12 @@ void deemphasis(celt_sig *in[], opus_val16 *pcm, int N, int C, int downsample, c
    VARDECL(celt_sig, scratch);
    SAVE_STACK;
 #ifndef CUSTOM_MODES
-   /* Short version for common case. */
+   /* Special case for stereo with no downsampling and no accumulation. This is
+      quite common and we can make it faster by processing both channels in the
+      same loop, reducing overhead due to the dependency loop in the IIR filter. */
    if (downsample == 1 && C == 2 && !accum)
    {
-      deemphasis_stereo_simple(in, pcm, N, coef[0], mem);
+      deemphasis_stereo(in[0], in[1], pcm, N, coef[0], mem, arch);
       return;
    }
 #endif
@@ -323,37 +296,32 @@ void deemphasis(celt_sig *in[], opus_val16 *pcm, int N, int C, int downsample, c
          apply_downsampling=1;
       } else
 #endif
-      if (downsample>1)
-      {
-         /* Shortcut for the standard (non-custom modes) case */
-         for (j=0;j<N;j++)
-         {
-            celt_sig tmp = x[j] + VERY_SMALL + m;
-            m = MULT16_32_Q15(coef0, tmp);
-            scratch[j] = tmp;
-         }
-         apply_downsampling=1;
-      } else {
-         /* Shortcut for the standard (non-custom modes) case */
 #ifdef FIXED_POINT
-         if (accum)
+      if (accum)
+      {
+         if (downsample>1)
          {
             for (j=0;j<N;j++)
             {
-               celt_sig tmp = x[j] + m + VERY_SMALL;
+               celt_sig tmp = x[j] + VERY_SMALL + m;
                m = MULT16_32_Q15(coef0, tmp);
-               y[j*C] = SAT16(ADD32(y[j*C], SCALEOUT(SIG2WORD16(tmp))));
+               scratch[j] = tmp;
             }
-         } else
-#endif
-         {
+            apply_downsampling=1;
+         } else {
             for (j=0;j<N;j++)
             {
-               celt_sig tmp = x[j] + VERY_SMALL + m;
+               celt_sig tmp = x[j] + m + VERY_SMALL;
                m = MULT16_32_Q15(coef0, tmp);
-               y[j*C] = SCALEOUT(SIG2WORD16(tmp));
+               y[j*C] = SAT16(ADD32(y[j*C], SCALEOUT(SIG2WORD16(tmp))));
             }
          }
+      } else
+#endif
+      {
+         /* Shortcut for the standard (non-custom modes) case: de-emphasis,
+            down-sampling and output scaling in a single pass. */
+         m = deemphasis_channel(x, y, N, C, downsample, coef0, m, arch);
       }
       mem[c] = m;
 
@@ -394,6 +362,7 @@ void celt_synthesis(const CELTMode *mode, celt_norm *X, celt_sig * out_syn[],
    int overlap;
    VARDECL(celt_sig, freq);
    SAVE_STACK;
+   OPUS_PROFILE_ENTER(OPUS_PROFILE_MDCT);
 
    overlap = mode->overlap;
    nbEBands = mode->nbEBands;
@@ -454,6 +423,7 @@ void celt_synthesis(const CELTMode *mode, celt_norm *X, celt_sig * out_syn[],
       for (i=0;i<N;i++)
          out_syn[c][i] = SATURATE(out_syn[c][i], SIG_SAT);
    } while (++c<CC);
+   OPUS_PROFILE_LEAVE(OPUS_PROFILE_MDCT);
    RESTORE_STACK;
 }
 
@@ -502,12 +472,14 @@ static int celt_plc_pitch_search(celt_sig *decode_mem[2], int C, int arch)
    VARDECL( opus_val16, lp_pitch_buf );
    SAVE_STACK;
    ALLOC( lp_pitch_buf, DECODE_BUFFER_SIZE>>1, opus_val16 );
+   OPUS_PROFILE_ENTER(OPUS_PROFILE_PITCH);
    pitch_downsample(decode_mem, lp_pitch_buf,
          DECODE_BUFFER_SIZE, C, arch);
    pitch_search(lp_pitch_buf+(PLC_PITCH_LAG_MAX>>1), lp_pitch_buf,
          DECODE_BUFFER_SIZE-PLC_PITCH_LAG_MAX,
          PLC_PITCH_LAG_MAX-PLC_PITCH_LAG_MIN, &pitch_index, arch);
    pitch_index = PLC_PITCH_LAG_MAX-pitch_index;
+   OPUS_PROFILE_LEAVE(OPUS_PROFILE_PITCH);
    RESTORE_STACK;
    return pitch_index;
 }
@@ -967,7 +939,7 @@ static void celt_decode_lost(CELTDecoder * OPUS_RESTRICT st, int N, int LM
    RESTORE_STACK;
 }
 
-int celt_decode_with_ec_dred(CELTDecoder * OPUS_RESTRICT st, const unsigned char *data,
+static int celt_decode_with_ec_dred_impl(CELTDecoder * OPUS_RESTRICT st, const unsigned char *data,
       int len, opus_val16 * OPUS_RESTRICT pcm, int frame_size, ec_dec *dec, int accum
 #ifdef ENABLE_DEEP_PLC
       ,LPCNetPLCState *lpcnet
@@ -1022,6 +994,11 @@ int celt_decode_with_ec_dred(CELTDecoder * OPUS_RESTRICT st, const unsigned char
    ALLOC_STACK;
 
    VALIDATE_CELT_DECODER(st);
+   if (!RESERVE_STACK(GLOBAL_STACK_SIZE))
+   {
+      RESTORE_STACK;
+      return OPUS_ALLOC_FAIL;
+   }
    mode = st->mode;
    nbEBands = mode->nbEBands;
    overlap = mode->overlap;
@@ -1090,7 +1067,7 @@ int celt_decode_with_ec_dred(CELTDecoder * OPUS_RESTRICT st, const unsigned char
       , lpcnet
 #endif
                       );
-      deemphasis(out_syn, pcm, N, CC, st->downsample, mode->preemph, st->preemph_memD, accum);
+      deemphasis(out_syn, pcm, N, CC, st->downsample, mode->preemph, st->preemph_memD, accum, st->arch);
       RESTORE_STACK;
       return frame_size/st->downsample;
    }
@@ -1197,8 +1174,10 @@ int celt_decode_with_ec_dred(CELTDecoder * OPUS_RESTRICT st, const unsigned char
       } while (++c<2);
    }
    /* Get band energies */
+   OPUS_PROFILE_ENTER(OPUS_PROFILE_ENTROPY);
    unquant_coarse_energy(mode, start, end, oldBandE,
          intra_ener, dec, C, LM);
+   OPUS_PROFILE_LEAVE(OPUS_PROFILE_ENTROPY);
 
    ALLOC(tf_res, nbEBands, int);
    tf_decode(start, end, isTransient, tf_res, LM, dec);
@@ -1357,7 +1336,7 @@ int celt_decode_with_ec_dred(CELTDecoder * OPUS_RESTRICT st, const unsigned char
    } while (++c<2);
    st->rng = dec->rng;
 
-   deemphasis(out_syn, pcm, N, CC, st->downsample, mode->preemph, st->preemph_memD, accum);
+   deemphasis(out_syn, pcm, N, CC, st->downsample, mode->preemph, st->preemph_memD, accum, st->arch);
    st->loss_duration = 0;
    st->prefilter_and_fold = 0;
    RESTORE_STACK;
@@ -1368,6 +1347,24 @@ int celt_decode_with_ec_dred(CELTDecoder * OPUS_RESTRICT st, const unsigned char
    return frame_size/st->downsample;
 }
 
+int celt_decode_with_ec_dred(CELTDecoder * OPUS_RESTRICT st, const unsigned char *data,
+      int len, opus_val16 * OPUS_RESTRICT pcm, int frame_size, ec_dec *dec, int accum
+#ifdef ENABLE_DEEP_PLC
+      ,LPCNetPLCState *lpcnet
+#endif
+      )
+{
+   int ret;
+   OPUS_PROFILE_ENTER(OPUS_PROFILE_CELT);
+   ret = celt_decode_with_ec_dred_impl(st, data, len, pcm, frame_size, dec, accum
+#ifdef ENABLE_DEEP_PLC
+         , lpcnet
+#endif
+         );
+   OPUS_PROFILE_LEAVE(OPUS_PROFILE_CELT);
+   return ret;
+}
+
 int celt_decode_with_ec(CELTDecoder * OPUS_RESTRICT st, const unsigned char *data,
       int len, opus_val16 * OPUS_RESTRICT pcm, int frame_size, ec_dec *dec, int accum)
 {
@@ -1399,6 +1396,11 @@ int opus_custom_decode_float(CELTDecoder * OPUS_RESTRICT st, const unsigned char
    C = st->channels;
    N = frame_size;
 
+   if (!RESERVE_STACK(GLOBAL_STACK_SIZE + C*N*sizeof(opus_int16)))
+   {
+      RESTORE_STACK;
+      return OPUS_ALLOC_FAIL;
+   }
    ALLOC(out, C*N, opus_int16);
    ret=celt_decode_with_ec(st, data, len, out, frame_size, NULL, 0);
    if (ret>0)
@@ -1428,6 +1430,11 @@ int opus_custom_decode(CELTDecoder * OPUS_RESTRICT st, const unsigned char *data
 
    C = st->channels;
    N = frame_size;
+   if (!RESERVE_STACK(GLOBAL_STACK_SIZE + C*N*sizeof(celt_sig)))
+   {
+      RESTORE_STACK;
+      return OPUS_ALLOC_FAIL;
+   }
    ALLOC(out, C*N, celt_sig);
 
    ret=celt_decode_with_ec(st, data, len, out, frame_size, NULL, 0);
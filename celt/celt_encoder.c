@@ -50,6 +50,7 @@
 #include <stdarg.h>
 #include "celt_lpc.h"
 #include "vq.h"
+#include "profile.h"
 
 
 /** Encoder state
@@ -467,6 +468,7 @@ static void compute_mdcts(const CELTMode *mode, int shortBlocks, celt_sig * OPUS
    int B;
    int shift;
    int i, b, c;
+   OPUS_PROFILE_ENTER(OPUS_PROFILE_MDCT);
    if (shortBlocks)
    {
       B = shortBlocks;
@@ -501,6 +503,7 @@ static void compute_mdcts(const CELTMode *mode, int shortBlocks, celt_sig * OPUS
          OPUS_CLEAR(&out[c*B*N+bound], B*N-bound);
       } while (++c<C);
    }
+   OPUS_PROFILE_LEAVE(OPUS_PROFILE_MDCT);
 }
 
 
@@ -1218,6 +1221,7 @@ static int run_prefilter(CELTEncoder *st, celt_sig *in, celt_sig *prefilter_mem,
       VARDECL(opus_val16, pitch_buf);
       ALLOC(pitch_buf, (COMBFILTER_MAXPERIOD+N)>>1, opus_val16);
 
+      OPUS_PROFILE_ENTER(OPUS_PROFILE_PITCH);
       pitch_downsample(pre, pitch_buf, COMBFILTER_MAXPERIOD+N, CC, st->arch);
       /* Don't search for the fir last 1.5 octave of the range because
          there's too many false-positives due to short-term correlation */
@@ -1228,6 +1232,7 @@ static int run_prefilter(CELTEncoder *st, celt_sig *in, celt_sig *prefilter_mem,
 
       gain1 = remove_doubling(pitch_buf, COMBFILTER_MAXPERIOD, COMBFILTER_MINPERIOD,
             N, &pitch_index, st->prefilter_period, st->prefilter_gain, st->arch);
+      OPUS_PROFILE_LEAVE(OPUS_PROFILE_PITCH);
       if (pitch_index > COMBFILTER_MAXPERIOD-2)
          pitch_index = COMBFILTER_MAXPERIOD-2;
       gain1 = MULT16_16_Q15(QCONST16(.7f,15),gain1);
@@ -1428,7 +1433,7 @@ static int compute_vbr(const CELTMode *mode, AnalysisInfo *analysis, opus_int32
    return target;
 }
 
-int celt_encode_with_ec(CELTEncoder * OPUS_RESTRICT st, const opus_val16 * pcm, int frame_size, unsigned char *compressed, int nbCompressedBytes, ec_enc *enc)
+static int celt_encode_with_ec_impl(CELTEncoder * OPUS_RESTRICT st, const opus_val16 * pcm, int frame_size, unsigned char *compressed, int nbCompressedBytes, ec_enc *enc)
 {
    int i, c, N;
    opus_int32 bits;
@@ -1502,6 +1507,11 @@ int celt_encode_with_ec(CELTEncoder * OPUS_RESTRICT st, const opus_val16 * pcm,
    VARDECL(opus_val16, surround_dynalloc);
    ALLOC_STACK;
 
+   if (!RESERVE_STACK(GLOBAL_STACK_SIZE))
+   {
+      RESTORE_STACK;
+      return OPUS_ALLOC_FAIL;
+   }
    mode = st->mode;
    nbEBands = mode->nbEBands;
    overlap = mode->overlap;
@@ -1955,10 +1965,12 @@ int celt_encode_with_ec(CELTEncoder * OPUS_RESTRICT st, const opus_val16 * pcm,
          }
       }
    } while (++c < C);
+   OPUS_PROFILE_ENTER(OPUS_PROFILE_ENTROPY);
    quant_coarse_energy(mode, start, end, effEnd, bandLogE,
          oldBandE, total_bits, error, enc,
          C, LM, nbAvailableBytes, st->force_intra,
          &st->delayedIntra, st->complexity >= 4, st->loss_rate, st->lfe);
+   OPUS_PROFILE_LEAVE(OPUS_PROFILE_ENTROPY);
 
    tf_encode(start, end, isTransient, tf_res, LM, tf_select, enc);
 
@@ -2299,7 +2311,7 @@ int celt_encode_with_ec(CELTEncoder * OPUS_RESTRICT st, const opus_val16 * pcm,
       } while (++c<CC);
 
       /* We reuse freq[] as scratch space for the de-emphasis */
-      deemphasis(out_mem, (opus_val16*)pcm, N, CC, st->upsample, mode->preemph, st->preemph_memD, 0);
+      deemphasis(out_mem, (opus_val16*)pcm, N, CC, st->upsample, mode->preemph, st->preemph_memD, 0, st->arch);
       st->prefilter_period_old = st->prefilter_period;
       st->prefilter_gain_old = st->prefilter_gain;
       st->prefilter_tapset_old = st->prefilter_tapset;
@@ -2367,6 +2379,15 @@ int celt_encode_with_ec(CELTEncoder * OPUS_RESTRICT st, const opus_val16 * pcm,
       return nbCompressedBytes;
 }
 
+int celt_encode_with_ec(CELTEncoder * OPUS_RESTRICT st, const opus_val16 * pcm, int frame_size, unsigned char *compressed, int nbCompressedBytes, ec_enc *enc)
+{
+   int ret;
+   OPUS_PROFILE_ENTER(OPUS_PROFILE_CELT);
+   ret = celt_encode_with_ec_impl(st, pcm, frame_size, compressed, nbCompressedBytes, enc);
+   OPUS_PROFILE_LEAVE(OPUS_PROFILE_CELT);
+   return ret;
+}
+
 
 #ifdef CUSTOM_MODES
 
@@ -2388,6 +2409,11 @@ int opus_custom_encode_float(CELTEncoder * OPUS_RESTRICT st, const float * pcm,
 
    C = st->channels;
    N = frame_size;
+   if (!RESERVE_STACK(GLOBAL_STACK_SIZE + C*N*sizeof(opus_int16)))
+   {
+      RESTORE_STACK;
+      return OPUS_ALLOC_FAIL;
+   }
    ALLOC(in, C*N, opus_int16);
 
    for (j=0;j<C*N;j++)
@@ -2415,6 +2441,11 @@ int opus_custom_encode(CELTEncoder * OPUS_RESTRICT st, const opus_int16 * pcm, i
 
    C=st->channels;
    N=frame_size;
+   if (!RESERVE_STACK(GLOBAL_STACK_SIZE + C*N*sizeof(celt_sig)))
+   {
+      RESTORE_STACK;
+      return OPUS_ALLOC_FAIL;
+   }
    ALLOC(in, C*N, celt_sig);
    for (j=0;j<C*N;j++) {
      in[j] = SCALEOUT(pcm[j]);
@@ -0,0 +1,151 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "celt_output.h"
+#include "float_cast.h"
+
+void comb_filter_overlap_c(opus_val32 *y, const opus_val32 *x, int T0, int T1,
+      int N, const opus_val16 *g0, const opus_val16 *g1,
+      const opus_val16 *window)
+{
+   int i;
+   opus_val32 x0, x1, x2, x3, x4;
+   x1 = x[-T1+1];
+   x2 = x[-T1  ];
+   x3 = x[-T1-1];
+   x4 = x[-T1-2];
+   for (i=0;i<N;i++)
+   {
+      opus_val16 f;
+      x0=x[i-T1+2];
+      f = MULT16_16_Q15(window[i],window[i]);
+      y[i] = x[i]
+               + MULT16_32_Q15(MULT16_16_Q15((Q15ONE-f),g0[0]),x[i-T0])
+               + MULT16_32_Q15(MULT16_16_Q15((Q15ONE-f),g0[1]),ADD32(x[i-T0+1],x[i-T0-1]))
+               + MULT16_32_Q15(MULT16_16_Q15((Q15ONE-f),g0[2]),ADD32(x[i-T0+2],x[i-T0-2]))
+               + MULT16_32_Q15(MULT16_16_Q15(f,g1[0]),x2)
+               + MULT16_32_Q15(MULT16_16_Q15(f,g1[1]),ADD32(x1,x3))
+               + MULT16_32_Q15(MULT16_16_Q15(f,g1[2]),ADD32(x0,x4));
+      y[i] = SATURATE(y[i], SIG_SAT);
+      x4=x3;
+      x3=x2;
+      x2=x1;
+      x1=x0;
+   }
+}
+
+celt_sig deemphasis_channel_c(const celt_sig *x, opus_val16 *y, int N, int C,
+      int downsample, opus_val16 coef0, celt_sig m)
+{
+   int j;
+   int Nd;
+   Nd = N/downsample;
+   for (j=0;j<Nd;j++)
+   {
+      int k;
+      celt_sig tmp = x[0] + VERY_SMALL + m;
+      m = MULT16_32_Q15(coef0, tmp);
+      y[j*C] = SCALEOUT(SIG2WORD16(tmp));
+      /* The skipped samples still have to go through the filter. */
+      for (k=1;k<downsample;k++)
+      {
+         tmp = x[k] + VERY_SMALL + m;
+         m = MULT16_32_Q15(coef0, tmp);
+      }
+      x += downsample;
+   }
+   for (j=Nd*downsample;j<N;j++)
+   {
+      celt_sig tmp = *x++ + VERY_SMALL + m;
+      m = MULT16_32_Q15(coef0, tmp);
+   }
+   return m;
+}
+
+void deemphasis_stereo_c(const celt_sig *x0, const celt_sig *x1,
+      opus_val16 *pcm, int N, opus_val16 coef0, celt_sig *mem)
+{
+   celt_sig m0, m1;
+   int j;
+   m0 = mem[0];
+   m1 = mem[1];
+   for (j=0;j<N;j++)
+   {
+      celt_sig tmp0, tmp1;
+      /* Add VERY_SMALL to x[] first to reduce dependency chain. */
+      tmp0 = x0[j] + VERY_SMALL + m0;
+      tmp1 = x1[j] + VERY_SMALL + m1;
+      m0 = MULT16_32_Q15(coef0, tmp0);
+      m1 = MULT16_32_Q15(coef0, tmp1);
+      pcm[2*j  ] = SCALEOUT(SIG2WORD16(tmp0));
+      pcm[2*j+1] = SCALEOUT(SIG2WORD16(tmp1));
+   }
+   mem[0] = m0;
+   mem[1] = m1;
+}
+
+void smooth_fade_c(const opus_val16 *in1, const opus_val16 *in2,
+      opus_val16 *out, int overlap, int channels,
+      const opus_val16 *window, int inc)
+{
+   int i, c;
+   for (c=0;c<channels;c++)
+   {
+      for (i=0;i<overlap;i++)
+      {
+         opus_val16 w = MULT16_16_Q15(window[i*inc], window[i*inc]);
+         out[i*channels+c] = SHR32(MAC16_16(MULT16_16(w,in2[i*channels+c]),
+                                   Q15ONE-w, in1[i*channels+c]), 15);
+      }
+   }
+}
+
+#ifndef DISABLE_FLOAT_API
+void celt_float2int16_c(const float *in, opus_int16 *out, int cnt)
+{
+   int i;
+   for (i=0;i<cnt;i++)
+      out[i] = FLOAT2INT16(in[i]);
+}
+
+int opus_limit2_checkwithin1_c(float *samples, int cnt)
+{
+   int i;
+   int within1 = 1;
+   for (i=0;i<cnt;i++)
+   {
+      float x = MAX16(-2.f, MIN16(2.f, samples[i]));
+      within1 &= !(x>1 || x<-1);
+      samples[i] = x;
+   }
+   return within1;
+}
+#endif
@@ -0,0 +1,103 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef CELT_OUTPUT_H
+#define CELT_OUTPUT_H
+
+#include "arch.h"
+#include "cpu_support.h"
+
+/* Kernels for the post-synthesis output stage: the comb (post-)filter
+   cross-fade, de-emphasis with down-sampling, soft-clip pre-pass, the
+   mode-transition cross-fade and the float to int16 conversion. */
+
+#if !defined(FIXED_POINT) && \
+  (defined(OPUS_X86_MAY_HAVE_SSE2) || defined(OPUS_X86_MAY_HAVE_AVX2))
+#include "x86/celt_output_sse.h"
+#endif
+
+#if defined(OPUS_ARM_MAY_HAVE_NEON_INTR) && !defined(FIXED_POINT)
+#include "arm/celt_output_arm.h"
+#endif
+
+/* Cross-fades comb filter (T0,g0) into (T1,g1) over the first N samples
+   using the squared window. g0 and g1 are the three tap gains already
+   scaled by the filter gain. Works in place (y == x). */
+void comb_filter_overlap_c(opus_val32 *y, const opus_val32 *x, int T0, int T1,
+      int N, const opus_val16 *g0, const opus_val16 *g1,
+      const opus_val16 *window);
+
+/* De-emphasizes one channel of N samples and writes every downsample-th
+   output sample to y with a stride of C. Returns the new filter memory. */
+celt_sig deemphasis_channel_c(const celt_sig *x, opus_val16 *y, int N, int C,
+      int downsample, opus_val16 coef0, celt_sig m);
+
+/* De-emphasizes two channels and interleaves them into pcm. */
+void deemphasis_stereo_c(const celt_sig *x0, const celt_sig *x1,
+      opus_val16 *pcm, int N, opus_val16 coef0, celt_sig *mem);
+
+/* out = w^2*in2 + (1-w^2)*in1 for interleaved audio, with the window
+   subsampled by inc. */
+void smooth_fade_c(const opus_val16 *in1, const opus_val16 *in2,
+      opus_val16 *out, int overlap, int channels,
+      const opus_val16 *window, int inc);
+
+#ifndef DISABLE_FLOAT_API
+/* Converts cnt samples with FLOAT2INT16(). */
+void celt_float2int16_c(const float *in, opus_int16 *out, int cnt);
+
+/* Saturates samples to +/-2 and returns 1 if they all are within +/-1. */
+int opus_limit2_checkwithin1_c(float *samples, int cnt);
+#endif
+
+#ifndef OVERRIDE_COMB_FILTER_OVERLAP
+#define comb_filter_overlap(y, x, T0, T1, N, g0, g1, window, arch) \
+    ((void)(arch),comb_filter_overlap_c(y, x, T0, T1, N, g0, g1, window))
+#endif
+
+#ifndef OVERRIDE_DEEMPHASIS
+#define deemphasis_channel(x, y, N, C, downsample, coef0, m, arch) \
+    ((void)(arch),deemphasis_channel_c(x, y, N, C, downsample, coef0, m))
+#define deemphasis_stereo(x0, x1, pcm, N, coef0, mem, arch) \
+    ((void)(arch),deemphasis_stereo_c(x0, x1, pcm, N, coef0, mem))
+#endif
+
+#ifndef OVERRIDE_SMOOTH_FADE
+#define smooth_fade(in1, in2, out, overlap, channels, window, inc, arch) \
+    ((void)(arch),smooth_fade_c(in1, in2, out, overlap, channels, window, inc))
+#endif
+
+#ifndef DISABLE_FLOAT_API
+#ifndef OVERRIDE_FLOAT2INT16
+#define celt_float2int16(in, out, cnt, arch) \
+    ((void)(arch),celt_float2int16_c(in, out, cnt))
+#define opus_limit2_checkwithin1(samples, cnt, arch) \
+    ((void)(arch),opus_limit2_checkwithin1_c(samples, cnt))
+#endif
+#endif
+
+#endif /* CELT_OUTPUT_H */
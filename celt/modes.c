@@ -308,6 +308,8 @@ CELTMode *opus_custom_mode_create(opus_int32 Fs, int frame_size, int *error)
       return NULL;
    }
 
+   if (!RESERVE_STACK(GLOBAL_STACK_SIZE))
+      goto failure;
    mode = opus_alloc(sizeof(CELTMode));
    if (mode==NULL)
       goto failure;
@@ -400,12 +402,14 @@ CELTMode *opus_custom_mode_create(opus_int32 Fs, int frame_size, int *error)
    if (error)
       *error = OPUS_OK;
 
+   RESTORE_STACK;
    return mode;
 failure:
    if (error)
       *error = OPUS_ALLOC_FAIL;
    if (mode!=NULL)
       opus_custom_mode_destroy(mode);
+   RESTORE_STACK;
    return NULL;
 #endif /* !CUSTOM_MODES */
 }
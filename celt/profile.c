@@ -0,0 +1,117 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "profile.h"
+
+#if defined(ENABLE_PROFILING) || defined(ENABLE_DEEP_PLC)
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+opus_uint64 opus_time_ns(void)
+{
+#if defined(_WIN32)
+   LARGE_INTEGER count, freq;
+   QueryPerformanceCounter(&count);
+   QueryPerformanceFrequency(&freq);
+   return (opus_uint64)(count.QuadPart/freq.QuadPart)*1000000000
+         + (opus_uint64)(count.QuadPart%freq.QuadPart)*1000000000/freq.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return (opus_uint64)ts.tv_sec*1000000000 + ts.tv_nsec;
+#else
+   return (opus_uint64)clock()*(1000000000/CLOCKS_PER_SEC);
+#endif
+}
+
+#endif
+
+#ifdef ENABLE_PROFILING
+
+#include "arch.h"
+
+#if defined(_MSC_VER)
+#define PROFILE_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+#define PROFILE_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+#define PROFILE_THREAD_LOCAL __thread
+#else
+/* Counters from concurrent encoders or decoders may be misattributed. */
+#define PROFILE_THREAD_LOCAL
+#endif
+
+typedef struct {
+   OpusProfileStats *stats;
+   opus_uint64 start[OPUS_PROFILE_NB_STAGES];
+   int depth[OPUS_PROFILE_NB_STAGES];
+} ProfileContext;
+
+static PROFILE_THREAD_LOCAL ProfileContext profile_ctx;
+
+OpusProfileStats *opus_profile_begin(OpusProfileStats *stats)
+{
+   OpusProfileStats *prev = profile_ctx.stats;
+   profile_ctx.stats = stats;
+   return prev;
+}
+
+void opus_profile_end(OpusProfileStats *prev)
+{
+   profile_ctx.stats = prev;
+}
+
+void opus_profile_enter(int stage)
+{
+   celt_assert(stage >= 0 && stage < OPUS_PROFILE_NB_STAGES);
+   if (!profile_ctx.stats) return;
+   /* Only the outermost entry of a stage is timed, so recursion and
+      stages calling themselves through other stages are not counted twice. */
+   if (profile_ctx.depth[stage]++ == 0)
+      profile_ctx.start[stage] = opus_time_ns();
+}
+
+void opus_profile_leave(int stage)
+{
+   celt_assert(stage >= 0 && stage < OPUS_PROFILE_NB_STAGES);
+   if (!profile_ctx.stats || profile_ctx.depth[stage] == 0) return;
+   if (--profile_ctx.depth[stage] == 0)
+   {
+      profile_ctx.stats->time_ns[stage] += opus_time_ns() - profile_ctx.start[stage];
+      profile_ctx.stats->calls[stage]++;
+   }
+}
+
+#endif /* ENABLE_PROFILING */
@@ -0,0 +1,60 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include "opus_types.h"
+#include "opus_defines.h"
+
+#if defined(ENABLE_PROFILING) || defined(ENABLE_DEEP_PLC)
+/* Monotonic wall-clock time in nanoseconds, from an arbitrary origin. */
+opus_uint64 opus_time_ns(void);
+#endif
+
+#ifdef ENABLE_PROFILING
+
+/* Makes stats the destination of the stage counters on the calling thread
+   and returns the previous destination, to be restored by
+   opus_profile_end(). Stages entered with no destination are not timed. */
+OpusProfileStats *opus_profile_begin(OpusProfileStats *stats);
+void opus_profile_end(OpusProfileStats *prev);
+
+void opus_profile_enter(int stage);
+void opus_profile_leave(int stage);
+
+#define OPUS_PROFILE_ENTER(stage) opus_profile_enter(stage)
+#define OPUS_PROFILE_LEAVE(stage) opus_profile_leave(stage)
+
+#else
+
+#define OPUS_PROFILE_ENTER(stage)
+#define OPUS_PROFILE_LEAVE(stage)
+
+#endif
+
+#endif /* PROFILE_H */
@@ -35,8 +35,8 @@
 #include "opus_types.h"
 #include "opus_defines.h"
 
-#if (!defined (VAR_ARRAYS) && !defined (USE_ALLOCA) && !defined (NONTHREADSAFE_PSEUDOSTACK))
-#error "Opus requires one of VAR_ARRAYS, USE_ALLOCA, or NONTHREADSAFE_PSEUDOSTACK be defined to select the temporary allocation mode."
+#if (!defined (VAR_ARRAYS) && !defined (USE_ALLOCA) && !defined (NONTHREADSAFE_PSEUDOSTACK) && !defined (SCRATCH_ARENA))
+#error "Opus requires one of VAR_ARRAYS, USE_ALLOCA, NONTHREADSAFE_PSEUDOSTACK, or SCRATCH_ARENA be defined to select the temporary allocation mode."
 #endif
 
 #ifdef USE_ALLOCA
@@ -88,13 +88,188 @@
  * @param type Type of element
  */
 
-#if defined(VAR_ARRAYS)
+/**
+ * @def RESERVE_STACK(size)
+ *
+ * Makes sure the call tree rooted here can allocate 'size' bytes. Evaluates
+ * to 0 when the memory cannot be had, in which case the caller returns
+ * OPUS_ALLOC_FAIL. Only scratch arena builds can fail.
+ *
+ * @param size Number of bytes
+ */
+
+#if defined(SCRATCH_ARENA)
+
+/* SCRATCH_ARENA takes precedence over VAR_ARRAYS and USE_ALLOCA, which the
+   build systems may define on their own. */
+
+#include "arch.h"
+#include "os_support.h"
+
+#if defined(_MSC_VER)
+#define OPUS_SCRATCH_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+#define OPUS_SCRATCH_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+#define OPUS_SCRATCH_THREAD_LOCAL __thread
+#else
+/* Instances must not be used concurrently from different threads. */
+#define OPUS_SCRATCH_THREAD_LOCAL
+#endif
+
+/* The arena ALLOC() takes memory from on the calling thread: scratch_ptr is
+   its start, global_stack its first free byte and global_stack_top its end.
+   Instances without an arena of their own share scratch_fallback, which is
+   allocated once per thread and freed by opus_thread_scratch_release().
+   ALLOC() itself never allocates. The function at the root of each call
+   tree first RESERVE_STACK()s all the tree can take: GLOBAL_STACK_SIZE (the
+   bound pseudostack builds assert) for a decoder, more for the buffers of a
+   wrapper around it. When the arena cannot hold that, a chunk is taken from
+   the heap and pushed on scratch_chunks, and freed again when RESTORE_STACK
+   unwinds past it. Only the reservation can fail, and the root then returns
+   OPUS_ALLOC_FAIL. */
+typedef struct OpusScratchChunk {
+   struct OpusScratchChunk *next;
+   char *top;
+} OpusScratchChunk;
+
+#ifdef CELT_C
+OPUS_SCRATCH_THREAD_LOCAL char *scratch_ptr=0;
+OPUS_SCRATCH_THREAD_LOCAL char *global_stack=0;
+OPUS_SCRATCH_THREAD_LOCAL char *global_stack_top=0;
+OPUS_SCRATCH_THREAD_LOCAL char *scratch_fallback=0;
+OPUS_SCRATCH_THREAD_LOCAL OpusScratchChunk *scratch_chunks=0;
+#else
+extern OPUS_SCRATCH_THREAD_LOCAL char *scratch_ptr;
+extern OPUS_SCRATCH_THREAD_LOCAL char *global_stack;
+extern OPUS_SCRATCH_THREAD_LOCAL char *global_stack_top;
+extern OPUS_SCRATCH_THREAD_LOCAL char *scratch_fallback;
+extern OPUS_SCRATCH_THREAD_LOCAL OpusScratchChunk *scratch_chunks;
+#endif /* CELT_C */
+
+#define SCRATCH_ALIGNMENT 16
+/* Room for the buffers of a wrapper on top of one encoder or decoder. */
+#define SCRATCH_FALLBACK_SIZE (GLOBAL_STACK_SIZE*2)
+
+typedef struct {
+   char *start;
+   char *stack;
+   char *top;
+} OpusScratchState;
+
+int opus_scratch_reserve(size_t size);
+void opus_scratch_unwind(char *top);
+
+static OPUS_INLINE void opus_scratch_init(void)
+{
+   if (global_stack == 0)
+   {
+      if (scratch_fallback == 0)
+         scratch_fallback = (char*)opus_alloc_scratch(SCRATCH_FALLBACK_SIZE);
+      scratch_ptr = global_stack = scratch_fallback;
+      /* Without a fallback, RESERVE_STACK() takes a chunk from the heap. */
+      global_stack_top = scratch_fallback != 0 ? scratch_fallback + SCRATCH_FALLBACK_SIZE : 0;
+   }
+}
+
+#ifdef CELT_C
+/* Makes sure the calling thread has size bytes of scratch memory. Only the
+   root of a call tree reserves: an arena that is already in use was
+   reserved by the caller. Returns 0 when the memory cannot be allocated. */
+int opus_scratch_reserve(size_t size)
+{
+   OpusScratchChunk *chunk;
+   size_t chunk_size;
+   char *ptr;
+   opus_scratch_init();
+   if (global_stack != scratch_ptr)
+      return 1;
+   ptr = global_stack + ((SCRATCH_ALIGNMENT - (size_t)global_stack) & (SCRATCH_ALIGNMENT - 1));
+   if (global_stack_top != 0 && ptr <= global_stack_top && size <= (size_t)(global_stack_top - ptr))
+      return 1;
+   chunk_size = size + SCRATCH_ALIGNMENT;
+   chunk = (OpusScratchChunk*)opus_alloc(sizeof(OpusScratchChunk) + chunk_size);
+   if (chunk == 0)
+      return 0;
+   chunk->next = scratch_chunks;
+   chunk->top = (char*)(chunk + 1) + chunk_size;
+   scratch_chunks = chunk;
+   global_stack = (char*)(chunk + 1);
+   global_stack_top = chunk->top;
+   return 1;
+}
+
+/* Frees the chunks pushed since the stack pointer ending at top was saved. */
+void opus_scratch_unwind(char *top)
+{
+   while (scratch_chunks != 0 && scratch_chunks->top != top)
+   {
+      OpusScratchChunk *next = scratch_chunks->next;
+      opus_free(scratch_chunks);
+      scratch_chunks = next;
+   }
+}
+#endif /* CELT_C */
+
+static OPUS_INLINE char *opus_scratch_push(size_t size)
+{
+   char *ptr;
+   /* Entry points that only SAVE_STACK may be the first to allocate. */
+   opus_scratch_init();
+   ptr = global_stack + ((SCRATCH_ALIGNMENT - (size_t)global_stack) & (SCRATCH_ALIGNMENT - 1));
+   /* Running out of the reserved memory means a reservation is too small. */
+   celt_assert(global_stack_top != 0 && ptr <= global_stack_top && size <= (size_t)(global_stack_top - ptr));
+   global_stack = ptr + size;
+   return ptr;
+}
+
+static OPUS_INLINE void opus_scratch_restore(char *stack, char *top)
+{
+   if (opus_unlikely(global_stack_top != top))
+      opus_scratch_unwind(top);
+   global_stack = stack;
+   global_stack_top = top;
+}
+
+/* Makes arena the scratch memory of the calling thread, unless it already is,
+   and returns the previous state to be restored by opus_scratch_end().
+   A NULL arena leaves the current one in place. */
+static OPUS_INLINE OpusScratchState opus_scratch_begin(void *arena, opus_int32 size)
+{
+   OpusScratchState prev;
+   prev.start = scratch_ptr;
+   prev.stack = global_stack;
+   prev.top = global_stack_top;
+   if (arena != 0 && (char*)arena != scratch_ptr)
+   {
+      scratch_ptr = global_stack = (char*)arena;
+      global_stack_top = (char*)arena + size;
+   }
+   return prev;
+}
+
+static OPUS_INLINE void opus_scratch_end(OpusScratchState prev)
+{
+   opus_scratch_restore(prev.stack, prev.top);
+   scratch_ptr = prev.start;
+}
+
+#define VARDECL(type, var) type *var
+#define ALLOC(var, size, type) var = ((type*)opus_scratch_push(sizeof(type)*(size)))
+#define SAVE_STACK char *_saved_stack = global_stack; char *_saved_top = global_stack_top
+#define RESTORE_STACK opus_scratch_restore(_saved_stack, _saved_top)
+#define ALLOC_STACK char *_saved_stack; char *_saved_top; opus_scratch_init(); _saved_stack = global_stack; _saved_top = global_stack_top;
+#define RESERVE_STACK(size) opus_scratch_reserve(size)
+#define ALLOC_NONE 0
+
+#elif defined(VAR_ARRAYS)
 
 #define VARDECL(type, var)
 #define ALLOC(var, size, type) type var[size]
 #define SAVE_STACK
 #define RESTORE_STACK
 #define ALLOC_STACK
+#define RESERVE_STACK(size) 1
 /* C99 does not allow VLAs of size zero */
 #define ALLOC_NONE 1
 
@@ -111,6 +286,7 @@
 #define SAVE_STACK
 #define RESTORE_STACK
 #define ALLOC_STACK
+#define RESERVE_STACK(size) 1
 #define ALLOC_NONE 0
 
 #else
@@ -155,6 +331,7 @@ extern char *global_stack_top;
 #define VARDECL(type, var) type *var
 #define ALLOC(var, size, type) var = PUSH(global_stack, size, type)
 #define SAVE_STACK char *_saved_stack = global_stack;
+#define RESERVE_STACK(size) 1
 #define ALLOC_NONE 0
 
 #endif /* VAR_ARRAYS */
@@ -38,6 +38,7 @@
 #include "bands.h"
 #include "rate.h"
 #include "pitch.h"
+#include "profile.h"
 
 #if defined(MIPSr1_ASM)
 #include "mips/vq_mipsr1.h"
@@ -101,7 +102,13 @@ void exp_rotation(celt_norm *X, int len, int dir, int stride, int K, int spread)
    /*NOTE: As a minor optimization, we could be passing around log2(B), not B, for both this and for
       extract_collapse_mask().*/
    len = celt_udiv(len, stride);
-   for (i=0;i<stride;i++)
+   i=0;
+#ifdef OVERRIDE_EXP_ROTATION_X4
+   /* Rotate the interleaved blocks four at a time. */
+   for (;i<stride-3;i+=4)
+      exp_rotation_x4(X+i*len, len, dir, stride2, c, s);
+#endif
+   for (;i<stride;i++)
    {
       if (dir < 0)
       {
@@ -341,6 +348,7 @@ unsigned alg_quant(celt_norm *X, int N, int K, int spread, int B, ec_enc *enc,
    /* Covers vectorization by up to 4. */
    ALLOC(iy, N+3, int);
 
+   OPUS_PROFILE_ENTER(OPUS_PROFILE_PVQ);
    exp_rotation(X, N, 1, B, K, spread);
 
    yy = op_pvq_search(X, iy, K, N, arch);
@@ -354,6 +362,7 @@ unsigned alg_quant(celt_norm *X, int N, int K, int spread, int B, ec_enc *enc,
    }
 
    collapse_mask = extract_collapse_mask(iy, N, B);
+   OPUS_PROFILE_LEAVE(OPUS_PROFILE_PVQ);
    RESTORE_STACK;
    return collapse_mask;
 }
@@ -371,10 +380,12 @@ unsigned alg_unquant(celt_norm *X, int N, int K, int spread, int B,
    celt_assert2(K>0, "alg_unquant() needs at least one pulse");
    celt_assert2(N>1, "alg_unquant() needs at least two dimensions");
    ALLOC(iy, N, int);
+   OPUS_PROFILE_ENTER(OPUS_PROFILE_PVQ);
    Ryy = decode_pulses(iy, N, K, dec);
    normalise_residual(iy, X, N, Ryy, gain);
    exp_rotation(X, N, -1, B, K, spread);
    collapse_mask = extract_collapse_mask(iy, N, B);
+   OPUS_PROFILE_LEAVE(OPUS_PROFILE_PVQ);
    RESTORE_STACK;
    return collapse_mask;
 }
@@ -0,0 +1,212 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+#include "celt_output.h"
+#include "float_cast.h"
+#include "x86cpu.h"
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(FIXED_POINT)
+
+/* Eight-sample version of deemph_scan4() in celt_output_sse2.c: lane k gets
+   sum_{i<=k} c^(k-i)*a[i]. */
+static OPUS_INLINE __m256 deemph_scan8(__m256 a, __m256 c1, __m256 c2, __m256 c4)
+{
+   const __m256 zero = _mm256_setzero_ps();
+   __m256 s;
+   s = _mm256_permutevar8x32_ps(a, _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6));
+   a = _mm256_add_ps(a, _mm256_mul_ps(c1, _mm256_blend_ps(s, zero, 0x01)));
+   s = _mm256_permutevar8x32_ps(a, _mm256_setr_epi32(0, 0, 0, 1, 2, 3, 4, 5));
+   a = _mm256_add_ps(a, _mm256_mul_ps(c2, _mm256_blend_ps(s, zero, 0x03)));
+   s = _mm256_permutevar8x32_ps(a, _mm256_setr_epi32(0, 0, 0, 0, 0, 1, 2, 3));
+   a = _mm256_add_ps(a, _mm256_mul_ps(c4, _mm256_blend_ps(s, zero, 0x0F)));
+   return a;
+}
+
+/* Powers of the de-emphasis coefficient applied to the state: c^0..c^7 for
+   the first block (state m), c^1..c^8 for the next ones (previous output). */
+static OPUS_INLINE void deemph_powers8(float coef0, __m256 *pw, __m256 *pw8)
+{
+   float p[8];
+   int k;
+   p[0] = 1.f;
+   for (k=1;k<8;k++)
+      p[k] = p[k-1]*coef0;
+   *pw = _mm256_loadu_ps(p);
+   *pw8 = _mm256_mul_ps(*pw, _mm256_set1_ps(coef0));
+}
+
+celt_sig deemphasis_channel_avx2(const celt_sig *x, opus_val16 *y, int N,
+      int C, int downsample, opus_val16 coef0, celt_sig m)
+{
+   int j;
+   int o, next;
+   int Nd;
+   __m256 c1v, c2v, c4v, pw, pw8, carry, vsmall, scale;
+   const __m256i last = _mm256_set1_epi32(7);
+   Nd = N/downsample;
+   c1v = _mm256_set1_ps(coef0);
+   c2v = _mm256_mul_ps(c1v, c1v);
+   c4v = _mm256_mul_ps(c2v, c2v);
+   deemph_powers8(coef0, &pw, &pw8);
+   carry = _mm256_set1_ps(m);
+   vsmall = _mm256_set1_ps(VERY_SMALL);
+   scale = _mm256_set1_ps(1.f/CELT_SIG_SCALE);
+   o = next = 0;
+   for (j=0;j<N-7;j+=8)
+   {
+      __m256 tmp;
+      tmp = deemph_scan8(_mm256_add_ps(_mm256_loadu_ps(x+j), vsmall), c1v, c2v, c4v);
+      tmp = _mm256_add_ps(tmp, _mm256_mul_ps(pw, carry));
+      carry = _mm256_permutevar8x32_ps(tmp, last);
+      pw = pw8;
+      tmp = _mm256_mul_ps(tmp, scale);
+      if (downsample == 1 && C == 1)
+         _mm256_storeu_ps(y+j, tmp);
+      else {
+         float buf[8];
+         _mm256_storeu_ps(buf, tmp);
+         while (next < j+8 && o < Nd)
+         {
+            y[o*C] = buf[next-j];
+            o++;
+            next += downsample;
+         }
+      }
+   }
+   if (j > 0)
+      m = coef0*_mm256_cvtss_f32(carry);
+   if (downsample == 1 && C == 1)
+      o = next = j;
+   for (;j<N;j++)
+   {
+      celt_sig tmp = x[j] + VERY_SMALL + m;
+      m = MULT16_32_Q15(coef0, tmp);
+      if (j == next && o < Nd)
+      {
+         y[o*C] = SCALEOUT(SIG2WORD16(tmp));
+         o++;
+         next += downsample;
+      }
+   }
+   return m;
+}
+
+void deemphasis_stereo_avx2(const celt_sig *x0, const celt_sig *x1,
+      opus_val16 *pcm, int N, opus_val16 coef0, celt_sig *mem)
+{
+   int j;
+   __m256 c1v, c2v, c4v, pw, pw8, carry0, carry1, vsmall, scale;
+   const __m256i last = _mm256_set1_epi32(7);
+   c1v = _mm256_set1_ps(coef0);
+   c2v = _mm256_mul_ps(c1v, c1v);
+   c4v = _mm256_mul_ps(c2v, c2v);
+   deemph_powers8(coef0, &pw, &pw8);
+   carry0 = _mm256_set1_ps(mem[0]);
+   carry1 = _mm256_set1_ps(mem[1]);
+   vsmall = _mm256_set1_ps(VERY_SMALL);
+   scale = _mm256_set1_ps(1.f/CELT_SIG_SCALE);
+   for (j=0;j<N-7;j+=8)
+   {
+      __m256 tmp0, tmp1, lo, hi;
+      tmp0 = deemph_scan8(_mm256_add_ps(_mm256_loadu_ps(x0+j), vsmall), c1v, c2v, c4v);
+      tmp1 = deemph_scan8(_mm256_add_ps(_mm256_loadu_ps(x1+j), vsmall), c1v, c2v, c4v);
+      tmp0 = _mm256_add_ps(tmp0, _mm256_mul_ps(pw, carry0));
+      tmp1 = _mm256_add_ps(tmp1, _mm256_mul_ps(pw, carry1));
+      carry0 = _mm256_permutevar8x32_ps(tmp0, last);
+      carry1 = _mm256_permutevar8x32_ps(tmp1, last);
+      pw = pw8;
+      tmp0 = _mm256_mul_ps(tmp0, scale);
+      tmp1 = _mm256_mul_ps(tmp1, scale);
+      /* unpack works within 128-bit lanes: lo = L0 R0 L1 R1 | L4 R4 L5 R5. */
+      lo = _mm256_unpacklo_ps(tmp0, tmp1);
+      hi = _mm256_unpackhi_ps(tmp0, tmp1);
+      _mm256_storeu_ps(pcm+2*j, _mm256_permute2f128_ps(lo, hi, 0x20));
+      _mm256_storeu_ps(pcm+2*j+8, _mm256_permute2f128_ps(lo, hi, 0x31));
+   }
+   if (j > 0)
+   {
+      mem[0] = coef0*_mm256_cvtss_f32(carry0);
+      mem[1] = coef0*_mm256_cvtss_f32(carry1);
+   }
+   if (j < N)
+      deemphasis_stereo_c(x0+j, x1+j, pcm+2*j, N-j, coef0, mem);
+}
+
+void celt_float2int16_avx2(const float *in, opus_int16 *out, int cnt)
+{
+   int i;
+   __m256 scale, minval, maxval;
+   scale = _mm256_set1_ps(CELT_SIG_SCALE);
+   minval = _mm256_set1_ps(-32768.f);
+   maxval = _mm256_set1_ps(32767.f);
+   for (i=0;i<cnt-15;i+=16)
+   {
+      __m256 a, b;
+      __m256i s;
+      a = _mm256_mul_ps(_mm256_loadu_ps(in+i), scale);
+      b = _mm256_mul_ps(_mm256_loadu_ps(in+i+8), scale);
+      a = _mm256_min_ps(_mm256_max_ps(a, minval), maxval);
+      b = _mm256_min_ps(_mm256_max_ps(b, minval), maxval);
+      s = _mm256_packs_epi32(_mm256_cvtps_epi32(a), _mm256_cvtps_epi32(b));
+      /* packs interleaves the 128-bit lanes of a and b. */
+      s = _mm256_permute4x64_epi64(s, _MM_SHUFFLE(3, 1, 2, 0));
+      _mm256_storeu_si256((__m256i*)(void*)(out+i), s);
+   }
+   for (;i<cnt;i++)
+      out[i] = FLOAT2INT16(in[i]);
+}
+
+int opus_limit2_checkwithin1_avx2(float *samples, int cnt)
+{
+   int i;
+   int within1;
+   __m256 two, mtwo, one, mone, outside;
+   two = _mm256_set1_ps(2.f);
+   mtwo = _mm256_set1_ps(-2.f);
+   one = _mm256_set1_ps(1.f);
+   mone = _mm256_set1_ps(-1.f);
+   outside = _mm256_setzero_ps();
+   for (i=0;i<cnt-7;i+=8)
+   {
+      __m256 x;
+      x = _mm256_max_ps(mtwo, _mm256_min_ps(two, _mm256_loadu_ps(samples+i)));
+      _mm256_storeu_ps(samples+i, x);
+      outside = _mm256_or_ps(outside, _mm256_or_ps(
+            _mm256_cmp_ps(x, one, _CMP_GT_OQ), _mm256_cmp_ps(x, mone, _CMP_LT_OQ)));
+   }
+   within1 = _mm256_movemask_ps(outside) == 0;
+   if (i<cnt)
+      within1 &= opus_limit2_checkwithin1_c(samples+i, cnt-i);
+   return within1;
+}
+
+#endif
@@ -0,0 +1,149 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef CELT_OUTPUT_SSE_H
+#define CELT_OUTPUT_SSE_H
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(FIXED_POINT)
+
+void comb_filter_overlap_sse2(opus_val32 *y, const opus_val32 *x, int T0,
+      int T1, int N, const opus_val16 *g0, const opus_val16 *g1,
+      const opus_val16 *window);
+
+celt_sig deemphasis_channel_sse2(const celt_sig *x, opus_val16 *y, int N,
+      int C, int downsample, opus_val16 coef0, celt_sig m);
+
+void deemphasis_stereo_sse2(const celt_sig *x0, const celt_sig *x1,
+      opus_val16 *pcm, int N, opus_val16 coef0, celt_sig *mem);
+
+void smooth_fade_sse2(const opus_val16 *in1, const opus_val16 *in2,
+      opus_val16 *out, int overlap, int channels,
+      const opus_val16 *window, int inc);
+
+void celt_float2int16_sse2(const float *in, opus_int16 *out, int cnt);
+
+int opus_limit2_checkwithin1_sse2(float *samples, int cnt);
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2)
+celt_sig deemphasis_channel_avx2(const celt_sig *x, opus_val16 *y, int N,
+      int C, int downsample, opus_val16 coef0, celt_sig m);
+
+void deemphasis_stereo_avx2(const celt_sig *x0, const celt_sig *x1,
+      opus_val16 *pcm, int N, opus_val16 coef0, celt_sig *mem);
+
+void celt_float2int16_avx2(const float *in, opus_int16 *out, int cnt);
+
+int opus_limit2_checkwithin1_avx2(float *samples, int cnt);
+#endif
+
+#if defined(OPUS_X86_PRESUME_AVX2)
+
+#define OVERRIDE_COMB_FILTER_OVERLAP
+#define comb_filter_overlap(y, x, T0, T1, N, g0, g1, window, arch) \
+    ((void)(arch),comb_filter_overlap_sse2(y, x, T0, T1, N, g0, g1, window))
+
+#define OVERRIDE_DEEMPHASIS
+#define deemphasis_channel(x, y, N, C, downsample, coef0, m, arch) \
+    ((void)(arch),deemphasis_channel_avx2(x, y, N, C, downsample, coef0, m))
+#define deemphasis_stereo(x0, x1, pcm, N, coef0, mem, arch) \
+    ((void)(arch),deemphasis_stereo_avx2(x0, x1, pcm, N, coef0, mem))
+
+#define OVERRIDE_SMOOTH_FADE
+#define smooth_fade(in1, in2, out, overlap, channels, window, inc, arch) \
+    ((void)(arch),smooth_fade_sse2(in1, in2, out, overlap, channels, window, inc))
+
+#define OVERRIDE_FLOAT2INT16
+#define celt_float2int16(in, out, cnt, arch) \
+    ((void)(arch),celt_float2int16_avx2(in, out, cnt))
+#define opus_limit2_checkwithin1(samples, cnt, arch) \
+    ((void)(arch),opus_limit2_checkwithin1_avx2(samples, cnt))
+
+#elif defined(OPUS_HAVE_RTCD) && \
+ (defined(OPUS_X86_MAY_HAVE_AVX2) || !defined(OPUS_X86_PRESUME_SSE2))
+
+#define OVERRIDE_COMB_FILTER_OVERLAP
+extern void (*const COMB_FILTER_OVERLAP_IMPL[OPUS_ARCHMASK + 1])(
+      opus_val32 *y, const opus_val32 *x, int T0, int T1, int N,
+      const opus_val16 *g0, const opus_val16 *g1, const opus_val16 *window);
+#define comb_filter_overlap(y, x, T0, T1, N, g0, g1, window, arch) \
+    ((*COMB_FILTER_OVERLAP_IMPL[(arch) & OPUS_ARCHMASK])(y, x, T0, T1, N, g0, g1, window))
+
+#define OVERRIDE_DEEMPHASIS
+extern celt_sig (*const DEEMPHASIS_CHANNEL_IMPL[OPUS_ARCHMASK + 1])(
+      const celt_sig *x, opus_val16 *y, int N, int C, int downsample,
+      opus_val16 coef0, celt_sig m);
+#define deemphasis_channel(x, y, N, C, downsample, coef0, m, arch) \
+    ((*DEEMPHASIS_CHANNEL_IMPL[(arch) & OPUS_ARCHMASK])(x, y, N, C, downsample, coef0, m))
+extern void (*const DEEMPHASIS_STEREO_IMPL[OPUS_ARCHMASK + 1])(
+      const celt_sig *x0, const celt_sig *x1, opus_val16 *pcm, int N,
+      opus_val16 coef0, celt_sig *mem);
+#define deemphasis_stereo(x0, x1, pcm, N, coef0, mem, arch) \
+    ((*DEEMPHASIS_STEREO_IMPL[(arch) & OPUS_ARCHMASK])(x0, x1, pcm, N, coef0, mem))
+
+#define OVERRIDE_SMOOTH_FADE
+extern void (*const SMOOTH_FADE_IMPL[OPUS_ARCHMASK + 1])(
+      const opus_val16 *in1, const opus_val16 *in2, opus_val16 *out,
+      int overlap, int channels, const opus_val16 *window, int inc);
+#define smooth_fade(in1, in2, out, overlap, channels, window, inc, arch) \
+    ((*SMOOTH_FADE_IMPL[(arch) & OPUS_ARCHMASK])(in1, in2, out, overlap, channels, window, inc))
+
+#define OVERRIDE_FLOAT2INT16
+extern void (*const CELT_FLOAT2INT16_IMPL[OPUS_ARCHMASK + 1])(
+      const float *in, opus_int16 *out, int cnt);
+#define celt_float2int16(in, out, cnt, arch) \
+    ((*CELT_FLOAT2INT16_IMPL[(arch) & OPUS_ARCHMASK])(in, out, cnt))
+extern int (*const OPUS_LIMIT2_CHECKWITHIN1_IMPL[OPUS_ARCHMASK + 1])(
+      float *samples, int cnt);
+#define opus_limit2_checkwithin1(samples, cnt, arch) \
+    ((*OPUS_LIMIT2_CHECKWITHIN1_IMPL[(arch) & OPUS_ARCHMASK])(samples, cnt))
+
+#elif defined(OPUS_X86_PRESUME_SSE2)
+
+#define OVERRIDE_COMB_FILTER_OVERLAP
+#define comb_filter_overlap(y, x, T0, T1, N, g0, g1, window, arch) \
+    ((void)(arch),comb_filter_overlap_sse2(y, x, T0, T1, N, g0, g1, window))
+
+#define OVERRIDE_DEEMPHASIS
+#define deemphasis_channel(x, y, N, C, downsample, coef0, m, arch) \
+    ((void)(arch),deemphasis_channel_sse2(x, y, N, C, downsample, coef0, m))
+#define deemphasis_stereo(x0, x1, pcm, N, coef0, mem, arch) \
+    ((void)(arch),deemphasis_stereo_sse2(x0, x1, pcm, N, coef0, mem))
+
+#define OVERRIDE_SMOOTH_FADE
+#define smooth_fade(in1, in2, out, overlap, channels, window, inc, arch) \
+    ((void)(arch),smooth_fade_sse2(in1, in2, out, overlap, channels, window, inc))
+
+#define OVERRIDE_FLOAT2INT16
+#define celt_float2int16(in, out, cnt, arch) \
+    ((void)(arch),celt_float2int16_sse2(in, out, cnt))
+#define opus_limit2_checkwithin1(samples, cnt, arch) \
+    ((void)(arch),opus_limit2_checkwithin1_sse2(samples, cnt))
+
+#endif
+#endif
+
+#endif
@@ -0,0 +1,280 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include "celt_output.h"
+#include "float_cast.h"
+#include "x86cpu.h"
+
+#if defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(FIXED_POINT)
+
+void comb_filter_overlap_sse2(opus_val32 *y, const opus_val32 *x, int T0,
+      int T1, int N, const opus_val16 *g0, const opus_val16 *g1,
+      const opus_val16 *window)
+{
+   int i;
+   __m128 one, g00, g01, g02, g10, g11, g12;
+   one = _mm_set1_ps(Q15ONE);
+   g00 = _mm_set1_ps(g0[0]);
+   g01 = _mm_set1_ps(g0[1]);
+   g02 = _mm_set1_ps(g0[2]);
+   g10 = _mm_set1_ps(g1[0]);
+   g11 = _mm_set1_ps(g1[1]);
+   g12 = _mm_set1_ps(g1[2]);
+   /* Same operations in the same order as the C code, so the output is
+      bit-exact. T0,T1 >= COMBFILTER_MINPERIOD, so when filtering in place
+      every x[] value read here has already been written. */
+   for (i=0;i<N-3;i+=4)
+   {
+      __m128 f, omf, t;
+      f = _mm_loadu_ps(window+i);
+      f = _mm_mul_ps(f, f);
+      omf = _mm_sub_ps(one, f);
+      t = _mm_loadu_ps(x+i);
+      t = _mm_add_ps(t, _mm_mul_ps(_mm_mul_ps(omf, g00), _mm_loadu_ps(x+i-T0)));
+      t = _mm_add_ps(t, _mm_mul_ps(_mm_mul_ps(omf, g01),
+            _mm_add_ps(_mm_loadu_ps(x+i-T0+1), _mm_loadu_ps(x+i-T0-1))));
+      t = _mm_add_ps(t, _mm_mul_ps(_mm_mul_ps(omf, g02),
+            _mm_add_ps(_mm_loadu_ps(x+i-T0+2), _mm_loadu_ps(x+i-T0-2))));
+      t = _mm_add_ps(t, _mm_mul_ps(_mm_mul_ps(f, g10), _mm_loadu_ps(x+i-T1)));
+      t = _mm_add_ps(t, _mm_mul_ps(_mm_mul_ps(f, g11),
+            _mm_add_ps(_mm_loadu_ps(x+i-T1+1), _mm_loadu_ps(x+i-T1-1))));
+      t = _mm_add_ps(t, _mm_mul_ps(_mm_mul_ps(f, g12),
+            _mm_add_ps(_mm_loadu_ps(x+i-T1+2), _mm_loadu_ps(x+i-T1-2))));
+      _mm_storeu_ps(y+i, t);
+   }
+   if (i<N)
+      comb_filter_overlap_c(y+i, x+i, T0, T1, N-i, g0, g1, window+i);
+}
+
+/* Runs the de-emphasis recursion tmp[j] = a[j] + c*tmp[j-1] over a block of
+   four samples starting from a zero state (a log-step prefix scan). The
+   caller then adds the contribution of the state with the powers of c.
+   The result differs from the serial filter only in rounding. */
+static OPUS_INLINE __m128 deemph_scan4(__m128 a, __m128 c1, __m128 c2)
+{
+   a = _mm_add_ps(a, _mm_mul_ps(c1,
+         _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(a), 4))));
+   a = _mm_add_ps(a, _mm_mul_ps(c2,
+         _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(a), 8))));
+   return a;
+}
+
+celt_sig deemphasis_channel_sse2(const celt_sig *x, opus_val16 *y, int N,
+      int C, int downsample, opus_val16 coef0, celt_sig m)
+{
+   int j;
+   int o, next;
+   int Nd;
+   float c2;
+   __m128 c1v, c2v, pw, pw4, carry, vsmall, scale;
+   Nd = N/downsample;
+   c2 = coef0*coef0;
+   c1v = _mm_set1_ps(coef0);
+   c2v = _mm_set1_ps(c2);
+   /* The first block depends on the state m, later ones on the last output
+      of the previous block (m = coef0*tmp). */
+   pw = _mm_setr_ps(1.f, coef0, c2, c2*coef0);
+   pw4 = _mm_mul_ps(pw, c1v);
+   carry = _mm_set1_ps(m);
+   vsmall = _mm_set1_ps(VERY_SMALL);
+   scale = _mm_set1_ps(1.f/CELT_SIG_SCALE);
+   o = next = 0;
+   for (j=0;j<N-3;j+=4)
+   {
+      __m128 tmp;
+      tmp = deemph_scan4(_mm_add_ps(_mm_loadu_ps(x+j), vsmall), c1v, c2v);
+      tmp = _mm_add_ps(tmp, _mm_mul_ps(pw, carry));
+      carry = _mm_shuffle_ps(tmp, tmp, _MM_SHUFFLE(3, 3, 3, 3));
+      pw = pw4;
+      tmp = _mm_mul_ps(tmp, scale);
+      if (downsample == 1 && C == 1)
+         _mm_storeu_ps(y+j, tmp);
+      else {
+         float buf[4];
+         _mm_storeu_ps(buf, tmp);
+         while (next < j+4 && o < Nd)
+         {
+            y[o*C] = buf[next-j];
+            o++;
+            next += downsample;
+         }
+      }
+   }
+   if (j > 0)
+      m = coef0*_mm_cvtss_f32(carry);
+   if (downsample == 1 && C == 1)
+      o = next = j;
+   for (;j<N;j++)
+   {
+      celt_sig tmp = x[j] + VERY_SMALL + m;
+      m = MULT16_32_Q15(coef0, tmp);
+      if (j == next && o < Nd)
+      {
+         y[o*C] = SCALEOUT(SIG2WORD16(tmp));
+         o++;
+         next += downsample;
+      }
+   }
+   return m;
+}
+
+void deemphasis_stereo_sse2(const celt_sig *x0, const celt_sig *x1,
+      opus_val16 *pcm, int N, opus_val16 coef0, celt_sig *mem)
+{
+   int j;
+   float c2;
+   celt_sig m0, m1;
+   __m128 c1v, c2v, pw, pw4, carry0, carry1, vsmall, scale;
+   c2 = coef0*coef0;
+   c1v = _mm_set1_ps(coef0);
+   c2v = _mm_set1_ps(c2);
+   pw = _mm_setr_ps(1.f, coef0, c2, c2*coef0);
+   pw4 = _mm_mul_ps(pw, c1v);
+   m0 = mem[0];
+   m1 = mem[1];
+   carry0 = _mm_set1_ps(m0);
+   carry1 = _mm_set1_ps(m1);
+   vsmall = _mm_set1_ps(VERY_SMALL);
+   scale = _mm_set1_ps(1.f/CELT_SIG_SCALE);
+   for (j=0;j<N-3;j+=4)
+   {
+      __m128 tmp0, tmp1;
+      tmp0 = deemph_scan4(_mm_add_ps(_mm_loadu_ps(x0+j), vsmall), c1v, c2v);
+      tmp1 = deemph_scan4(_mm_add_ps(_mm_loadu_ps(x1+j), vsmall), c1v, c2v);
+      tmp0 = _mm_add_ps(tmp0, _mm_mul_ps(pw, carry0));
+      tmp1 = _mm_add_ps(tmp1, _mm_mul_ps(pw, carry1));
+      carry0 = _mm_shuffle_ps(tmp0, tmp0, _MM_SHUFFLE(3, 3, 3, 3));
+      carry1 = _mm_shuffle_ps(tmp1, tmp1, _MM_SHUFFLE(3, 3, 3, 3));
+      pw = pw4;
+      tmp0 = _mm_mul_ps(tmp0, scale);
+      tmp1 = _mm_mul_ps(tmp1, scale);
+      _mm_storeu_ps(pcm+2*j, _mm_unpacklo_ps(tmp0, tmp1));
+      _mm_storeu_ps(pcm+2*j+4, _mm_unpackhi_ps(tmp0, tmp1));
+   }
+   if (j > 0)
+   {
+      m0 = coef0*_mm_cvtss_f32(carry0);
+      m1 = coef0*_mm_cvtss_f32(carry1);
+   }
+   mem[0] = m0;
+   mem[1] = m1;
+   if (j < N)
+      deemphasis_stereo_c(x0+j, x1+j, pcm+2*j, N-j, coef0, mem);
+}
+
+static OPUS_INLINE void smooth_fade4(const float *in1, const float *in2,
+      float *out, __m128 w, __m128 one)
+{
+   _mm_storeu_ps(out, _mm_add_ps(_mm_mul_ps(w, _mm_loadu_ps(in2)),
+         _mm_mul_ps(_mm_sub_ps(one, w), _mm_loadu_ps(in1))));
+}
+
+void smooth_fade_sse2(const opus_val16 *in1, const opus_val16 *in2,
+      opus_val16 *out, int overlap, int channels,
+      const opus_val16 *window, int inc)
+{
+   int i;
+   __m128 one;
+   if (channels != 1 && channels != 2)
+   {
+      smooth_fade_c(in1, in2, out, overlap, channels, window, inc);
+      return;
+   }
+   one = _mm_set1_ps(Q15ONE);
+   for (i=0;i<overlap-3;i+=4)
+   {
+      __m128 w;
+      w = _mm_setr_ps(window[i*inc], window[(i+1)*inc],
+            window[(i+2)*inc], window[(i+3)*inc]);
+      w = _mm_mul_ps(w, w);
+      if (channels == 1)
+         smooth_fade4(in1+i, in2+i, out+i, w, one);
+      else {
+         smooth_fade4(in1+2*i, in2+2*i, out+2*i, _mm_unpacklo_ps(w, w), one);
+         smooth_fade4(in1+2*i+4, in2+2*i+4, out+2*i+4, _mm_unpackhi_ps(w, w), one);
+      }
+   }
+   if (i<overlap)
+      smooth_fade_c(in1+i*channels, in2+i*channels, out+i*channels,
+            overlap-i, channels, window+i*inc, inc);
+}
+
+void celt_float2int16_sse2(const float *in, opus_int16 *out, int cnt)
+{
+   int i;
+   __m128 scale, minval, maxval;
+   scale = _mm_set1_ps(CELT_SIG_SCALE);
+   minval = _mm_set1_ps(-32768.f);
+   maxval = _mm_set1_ps(32767.f);
+   /* Same operand order as MAX32()/MIN32() so NaN maps to -32768, and
+      cvtps2dq rounds like float2int(). */
+   for (i=0;i<cnt-7;i+=8)
+   {
+      __m128 a, b;
+      a = _mm_mul_ps(_mm_loadu_ps(in+i), scale);
+      b = _mm_mul_ps(_mm_loadu_ps(in+i+4), scale);
+      a = _mm_min_ps(_mm_max_ps(a, minval), maxval);
+      b = _mm_min_ps(_mm_max_ps(b, minval), maxval);
+      _mm_storeu_si128((__m128i*)(void*)(out+i),
+            _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b)));
+   }
+   for (;i<cnt;i++)
+      out[i] = FLOAT2INT16(in[i]);
+}
+
+int opus_limit2_checkwithin1_sse2(float *samples, int cnt)
+{
+   int i;
+   int within1;
+   __m128 two, mtwo, one, mone, outside;
+   two = _mm_set1_ps(2.f);
+   mtwo = _mm_set1_ps(-2.f);
+   one = _mm_set1_ps(1.f);
+   mone = _mm_set1_ps(-1.f);
+   outside = _mm_setzero_ps();
+   for (i=0;i<cnt-3;i+=4)
+   {
+      __m128 x;
+      /* Operand order matches MAX16(-2.f, MIN16(2.f, x)), which keeps NaN. */
+      x = _mm_max_ps(mtwo, _mm_min_ps(two, _mm_loadu_ps(samples+i)));
+      _mm_storeu_ps(samples+i, x);
+      outside = _mm_or_ps(outside,
+            _mm_or_ps(_mm_cmpgt_ps(x, one), _mm_cmplt_ps(x, mone)));
+   }
+   within1 = _mm_movemask_ps(outside) == 0;
+   if (i<cnt)
+      within1 &= opus_limit2_checkwithin1_c(samples+i, cnt-i);
+   return within1;
+}
+
+#endif
@@ -0,0 +1,416 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+#include "x86cpu.h"
+#include "kiss_fft.h"
+#include "_kiss_fft_guts.h"
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(FIXED_POINT)
+
+/* All the butterflies below work on four interleaved complex values (one
+   __m256) at a time. They rely on the fact that for non-custom modes, every
+   stage other than the last one has m a multiple of 4. Stage layouts that
+   don't follow that are sent to the C implementation. */
+
+/* Loads w[0], w[stride], w[2*stride], w[3*stride]. */
+static OPUS_INLINE __m256 load_twiddles4(const kiss_twiddle_cpx *w, size_t stride)
+{
+   __m128i lo, hi;
+   lo = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)(const void*)&w[0]),
+                           _mm_loadl_epi64((const __m128i*)(const void*)&w[stride]));
+   hi = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)(const void*)&w[2*stride]),
+                           _mm_loadl_epi64((const __m128i*)(const void*)&w[3*stride]));
+   return _mm256_castsi256_ps(_mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1));
+}
+
+/* Complex multiplication a*b. */
+static OPUS_INLINE __m256 cmul_avx2(__m256 a, __m256 b)
+{
+   __m256 br, bi, as;
+   br = _mm256_moveldup_ps(b);
+   bi = _mm256_movehdup_ps(b);
+   as = _mm256_permute_ps(a, 0xB1);
+   return _mm256_fmaddsub_ps(a, br, _mm256_mul_ps(as, bi));
+}
+
+/* Multiplication by -j, i.e. (r, i) -> (i, -r). */
+static OPUS_INLINE __m256 mul_mj_avx2(__m256 x)
+{
+   const __m256 odd_sign = _mm256_set_ps(-0.f, 0.f, -0.f, 0.f, -0.f, 0.f, -0.f, 0.f);
+   return _mm256_xor_ps(_mm256_permute_ps(x, 0xB1), odd_sign);
+}
+
+#define LOAD_CPX4(p) _mm256_loadu_ps((const float*)(const void*)(p))
+#define STORE_CPX4(p, x) _mm256_storeu_ps((float*)(void*)(p), x)
+
+/* Degenerate radix-4 (all twiddles are 1) on two consecutive groups of four. */
+static OPUS_INLINE void bfly4_m1_x2(__m256 *g0, __m256 *g1)
+{
+   const __m256 sign3 = _mm256_set_ps(-0.f, 0.f, 0.f, 0.f, -0.f, 0.f, 0.f, 0.f);
+   __m256 lo, hi, a, b, x, y;
+   lo = _mm256_permute2f128_ps(*g0, *g1, 0x20);
+   hi = _mm256_permute2f128_ps(*g0, *g1, 0x31);
+   /* a = [F0+F2, F1+F3], b = [F0-F2, F1-F3] for each group. */
+   a = _mm256_add_ps(lo, hi);
+   b = _mm256_sub_ps(lo, hi);
+   x = _mm256_castpd_ps(_mm256_unpacklo_pd(_mm256_castps_pd(a), _mm256_castps_pd(b)));
+   y = _mm256_castpd_ps(_mm256_unpackhi_pd(_mm256_castps_pd(a), _mm256_castps_pd(b)));
+   /* Multiply the F1-F3 term by -j. */
+   y = _mm256_xor_ps(_mm256_permute_ps(y, 0xB4), sign3);
+   a = _mm256_add_ps(x, y);
+   b = _mm256_sub_ps(x, y);
+   *g0 = _mm256_permute2f128_ps(a, b, 0x20);
+   *g1 = _mm256_permute2f128_ps(a, b, 0x31);
+}
+
+static void kf_bfly4_m1_avx2(kiss_fft_cpx *Fout, int N)
+{
+   int i;
+   for (i=0;i<N-1;i+=2)
+   {
+      __m256 g0, g1;
+      g0 = LOAD_CPX4(Fout);
+      g1 = LOAD_CPX4(Fout+4);
+      bfly4_m1_x2(&g0, &g1);
+      STORE_CPX4(Fout, g0);
+      STORE_CPX4(Fout+4, g1);
+      Fout += 8;
+   }
+   if (i<N)
+   {
+      kiss_fft_cpx scratch0, scratch1;
+
+      C_SUB( scratch0 , *Fout, Fout[2] );
+      C_ADDTO(*Fout, Fout[2]);
+      C_ADD( scratch1 , Fout[1] , Fout[3] );
+      C_SUB( Fout[2], *Fout, scratch1 );
+      C_ADDTO( *Fout , scratch1 );
+      C_SUB( scratch1 , Fout[1] , Fout[3] );
+
+      Fout[1].r = ADD32_ovflw(scratch0.r, scratch1.i);
+      Fout[1].i = SUB32_ovflw(scratch0.i, scratch1.r);
+      Fout[3].r = SUB32_ovflw(scratch0.r, scratch1.i);
+      Fout[3].i = ADD32_ovflw(scratch0.i, scratch1.r);
+   }
+}
+
+/* Radix-8 made of the final degenerate radix-4 stage fused with the radix-2
+   (m==4) stage that always precedes it, saving a pass over the data. */
+static void kf_bfly8_avx2(kiss_fft_cpx *Fout, int N)
+{
+   int i;
+   __m256 ca, cb, cm;
+   opus_val16 tw;
+   tw = QCONST16(0.7071067812f, 15);
+   /* The radix-2 twiddles are 1, (1-j)/sqrt(2), -j and -(1+j)/sqrt(2). We
+      compute them as (x*ca + swap(x)*cb)*cm so that the result matches the
+      C code exactly. */
+   ca = _mm256_set_ps(-1.f, -1.f, 0.f, 0.f, 1.f, 1.f, 1.f, 1.f);
+   cb = _mm256_set_ps(-1.f, 1.f, -1.f, 1.f, -1.f, 1.f, 0.f, 0.f);
+   cm = _mm256_set_ps(tw, tw, 1.f, 1.f, tw, tw, 1.f, 1.f);
+   for (i=0;i<N;i++)
+   {
+      __m256 g0, g1, t;
+      g0 = LOAD_CPX4(Fout);
+      g1 = LOAD_CPX4(Fout+4);
+      bfly4_m1_x2(&g0, &g1);
+      t = _mm256_add_ps(_mm256_mul_ps(g1, ca),
+                        _mm256_mul_ps(_mm256_permute_ps(g1, 0xB1), cb));
+      t = _mm256_mul_ps(t, cm);
+      STORE_CPX4(Fout+4, _mm256_sub_ps(g0, t));
+      STORE_CPX4(Fout, _mm256_add_ps(g0, t));
+      Fout += 8;
+   }
+}
+
+static void kf_bfly4_avx2(
+                     kiss_fft_cpx * Fout,
+                     const size_t fstride,
+                     const kiss_fft_state *st,
+                     int m,
+                     int N,
+                     int mm
+                    )
+{
+   int i, j;
+   const int m2=2*m;
+   const int m3=3*m;
+   kiss_fft_cpx * Fout_beg = Fout;
+   for (i=0;i<N;i++)
+   {
+      Fout = Fout_beg + i*mm;
+      for (j=0;j<m;j+=4)
+      {
+         __m256 f0, s0, s1, s2, s3, s4, s5;
+         f0 = LOAD_CPX4(Fout+j);
+         s0 = cmul_avx2(LOAD_CPX4(Fout+m+j), load_twiddles4(&st->twiddles[j*fstride], fstride));
+         s1 = cmul_avx2(LOAD_CPX4(Fout+m2+j), load_twiddles4(&st->twiddles[2*j*fstride], 2*fstride));
+         s2 = cmul_avx2(LOAD_CPX4(Fout+m3+j), load_twiddles4(&st->twiddles[3*j*fstride], 3*fstride));
+
+         s5 = _mm256_sub_ps(f0, s1);
+         f0 = _mm256_add_ps(f0, s1);
+         s3 = _mm256_add_ps(s0, s2);
+         s4 = mul_mj_avx2(_mm256_sub_ps(s0, s2));
+         STORE_CPX4(Fout+m2+j, _mm256_sub_ps(f0, s3));
+         STORE_CPX4(Fout+j, _mm256_add_ps(f0, s3));
+         STORE_CPX4(Fout+m+j, _mm256_add_ps(s5, s4));
+         STORE_CPX4(Fout+m3+j, _mm256_sub_ps(s5, s4));
+      }
+   }
+}
+
+static void kf_bfly3_avx2(
+                     kiss_fft_cpx * Fout,
+                     const size_t fstride,
+                     const kiss_fft_state *st,
+                     int m,
+                     int N,
+                     int mm
+                    )
+{
+   int i, j;
+   const int m2 = 2*m;
+   __m256 epi3, half;
+   kiss_fft_cpx * Fout_beg = Fout;
+
+   epi3 = _mm256_set1_ps(st->twiddles[fstride*m].i);
+   half = _mm256_set1_ps(.5f);
+   for (i=0;i<N;i++)
+   {
+      Fout = Fout_beg + i*mm;
+      for (j=0;j<m;j+=4)
+      {
+         __m256 f0, fm, s0, s1, s2, s3;
+         s1 = cmul_avx2(LOAD_CPX4(Fout+m+j), load_twiddles4(&st->twiddles[j*fstride], fstride));
+         s2 = cmul_avx2(LOAD_CPX4(Fout+m2+j), load_twiddles4(&st->twiddles[2*j*fstride], 2*fstride));
+
+         s3 = _mm256_add_ps(s1, s2);
+         s0 = _mm256_sub_ps(s1, s2);
+         f0 = LOAD_CPX4(Fout+j);
+         fm = _mm256_sub_ps(f0, _mm256_mul_ps(half, s3));
+         s0 = mul_mj_avx2(_mm256_mul_ps(s0, epi3));
+         STORE_CPX4(Fout+j, _mm256_add_ps(f0, s3));
+         STORE_CPX4(Fout+m2+j, _mm256_add_ps(fm, s0));
+         STORE_CPX4(Fout+m+j, _mm256_sub_ps(fm, s0));
+      }
+   }
+}
+
+static void kf_bfly5_avx2(
+                     kiss_fft_cpx * Fout,
+                     const size_t fstride,
+                     const kiss_fft_state *st,
+                     int m,
+                     int N,
+                     int mm
+                    )
+{
+   int i, u;
+   __m256 yar, yai, ybr, ybi;
+   const kiss_twiddle_cpx *tw;
+   kiss_fft_cpx * Fout_beg = Fout;
+
+   yar = _mm256_set1_ps(st->twiddles[fstride*m].r);
+   yai = _mm256_set1_ps(st->twiddles[fstride*m].i);
+   ybr = _mm256_set1_ps(st->twiddles[fstride*2*m].r);
+   ybi = _mm256_set1_ps(st->twiddles[fstride*2*m].i);
+   tw = st->twiddles;
+
+   for (i=0;i<N;i++)
+   {
+      kiss_fft_cpx *Fout0, *Fout1, *Fout2, *Fout3, *Fout4;
+      Fout = Fout_beg + i*mm;
+      Fout0=Fout;
+      Fout1=Fout0+m;
+      Fout2=Fout0+2*m;
+      Fout3=Fout0+3*m;
+      Fout4=Fout0+4*m;
+
+      for (u=0;u<m;u+=4)
+      {
+         __m256 s0, s1, s2, s3, s4, s5, s6, s7, s8, s9, s10, s11, s12;
+         s0 = LOAD_CPX4(Fout0+u);
+         s1 = cmul_avx2(LOAD_CPX4(Fout1+u), load_twiddles4(&tw[u*fstride], fstride));
+         s2 = cmul_avx2(LOAD_CPX4(Fout2+u), load_twiddles4(&tw[2*u*fstride], 2*fstride));
+         s3 = cmul_avx2(LOAD_CPX4(Fout3+u), load_twiddles4(&tw[3*u*fstride], 3*fstride));
+         s4 = cmul_avx2(LOAD_CPX4(Fout4+u), load_twiddles4(&tw[4*u*fstride], 4*fstride));
+
+         s7 = _mm256_add_ps(s1, s4);
+         s10 = _mm256_sub_ps(s1, s4);
+         s8 = _mm256_add_ps(s2, s3);
+         s9 = _mm256_sub_ps(s2, s3);
+
+         STORE_CPX4(Fout0+u, _mm256_add_ps(s0, _mm256_add_ps(s7, s8)));
+
+         s5 = _mm256_add_ps(s0, _mm256_add_ps(_mm256_mul_ps(s7, yar), _mm256_mul_ps(s8, ybr)));
+         s6 = mul_mj_avx2(_mm256_add_ps(_mm256_mul_ps(s10, yai), _mm256_mul_ps(s9, ybi)));
+         STORE_CPX4(Fout1+u, _mm256_sub_ps(s5, s6));
+         STORE_CPX4(Fout4+u, _mm256_add_ps(s5, s6));
+
+         s11 = _mm256_add_ps(s0, _mm256_add_ps(_mm256_mul_ps(s7, ybr), _mm256_mul_ps(s8, yar)));
+         s12 = mul_mj_avx2(_mm256_sub_ps(_mm256_mul_ps(s9, yai), _mm256_mul_ps(s10, ybi)));
+         STORE_CPX4(Fout2+u, _mm256_add_ps(s11, s12));
+         STORE_CPX4(Fout3+u, _mm256_sub_ps(s11, s12));
+      }
+   }
+}
+
+/* Returns non-zero if the fused radix-8 can replace the last two stages. */
+static int use_bfly8(const kiss_fft_state *st, int L)
+{
+   return L >= 2 && st->factors[2*(L-1)] == 4 && st->factors[2*(L-2)] == 2
+         && st->factors[2*(L-2)+1] == 4;
+}
+
+static int fft_avx2_supported(const kiss_fft_state *st, int L)
+{
+   int i;
+   for (i=0;i<L;i++)
+   {
+      int p = st->factors[2*i];
+      int m = st->factors[2*i+1];
+      if (p == 4 && m == 1) continue;
+      if (p == 2 && i == L-2 && use_bfly8(st, L)) continue;
+      if ((p == 3 || p == 4 || p == 5) && (m&3) == 0) continue;
+      return 0;
+   }
+   return 1;
+}
+
+void opus_fft_impl_avx2(const kiss_fft_state *st,kiss_fft_cpx *fout)
+{
+   int m, mm;
+   int L;
+   int fstride[MAXFACTORS];
+   int i;
+   int shift;
+
+   /* st->shift can be -1 */
+   shift = st->shift>0 ? st->shift : 0;
+
+   fstride[0] = 1;
+   L=0;
+   do {
+      m = st->factors[2*L+1];
+      fstride[L+1] = fstride[L]*st->factors[2*L];
+      L++;
+   } while(m!=1);
+   if (!fft_avx2_supported(st, L))
+   {
+      opus_fft_impl(st, fout);
+      return;
+   }
+   i = L-1;
+   if (use_bfly8(st, L))
+   {
+      kf_bfly8_avx2(fout, fstride[L-2]);
+      i = L-3;
+   }
+   for (;i>=0;i--)
+   {
+      m = st->factors[2*i+1];
+      mm = i!=0 ? st->factors[2*i-1] : 1;
+      switch (st->factors[2*i])
+      {
+      case 4:
+         if (m == 1)
+            kf_bfly4_m1_avx2(fout, fstride[i]);
+         else
+            kf_bfly4_avx2(fout,fstride[i]<<shift,st,m, fstride[i], mm);
+         break;
+      case 3:
+         kf_bfly3_avx2(fout,fstride[i]<<shift,st,m, fstride[i], mm);
+         break;
+      case 5:
+         kf_bfly5_avx2(fout,fstride[i]<<shift,st,m, fstride[i], mm);
+         break;
+      }
+   }
+}
+
+/* Stores the two complex values of x to dst[0] and dst[1]. */
+static OPUS_INLINE void store_cpx2_scattered(kiss_fft_cpx *dst0, kiss_fft_cpx *dst1, __m128 x)
+{
+   _mm_storel_epi64((__m128i*)(void*)dst0, _mm_castps_si128(x));
+   _mm_storel_epi64((__m128i*)(void*)dst1, _mm_castps_si128(_mm_movehl_ps(x, x)));
+}
+
+void opus_fft_avx2(const kiss_fft_state *st,const kiss_fft_cpx *fin,kiss_fft_cpx *fout)
+{
+   int i;
+   __m256 scale;
+   const opus_int16 *bitrev = st->bitrev;
+
+   celt_assert2 (fin != fout, "In-place FFT not supported");
+   scale = _mm256_set1_ps(st->scale);
+   /* Bit-reverse the input */
+   for (i=0;i<st->nfft-3;i+=4)
+   {
+      __m256 x = _mm256_mul_ps(LOAD_CPX4(fin+i), scale);
+      store_cpx2_scattered(&fout[bitrev[i]], &fout[bitrev[i+1]], _mm256_castps256_ps128(x));
+      store_cpx2_scattered(&fout[bitrev[i+2]], &fout[bitrev[i+3]], _mm256_extractf128_ps(x, 1));
+   }
+   for (;i<st->nfft;i++)
+   {
+      kiss_fft_cpx x = fin[i];
+      fout[bitrev[i]].r = st->scale*x.r;
+      fout[bitrev[i]].i = st->scale*x.i;
+   }
+   opus_fft_impl_avx2(st, fout);
+}
+
+void opus_ifft_avx2(const kiss_fft_state *st,const kiss_fft_cpx *fin,kiss_fft_cpx *fout)
+{
+   int i;
+   const __m256 odd_sign = _mm256_set_ps(-0.f, 0.f, -0.f, 0.f, -0.f, 0.f, -0.f, 0.f);
+   const opus_int16 *bitrev = st->bitrev;
+
+   celt_assert2 (fin != fout, "In-place FFT not supported");
+   /* Bit-reverse and conjugate the input */
+   for (i=0;i<st->nfft-3;i+=4)
+   {
+      __m256 x = _mm256_xor_ps(LOAD_CPX4(fin+i), odd_sign);
+      store_cpx2_scattered(&fout[bitrev[i]], &fout[bitrev[i+1]], _mm256_castps256_ps128(x));
+      store_cpx2_scattered(&fout[bitrev[i+2]], &fout[bitrev[i+3]], _mm256_extractf128_ps(x, 1));
+   }
+   for (;i<st->nfft;i++)
+   {
+      fout[bitrev[i]].r = fin[i].r;
+      fout[bitrev[i]].i = -fin[i].i;
+   }
+   opus_fft_impl_avx2(st, fout);
+   for (i=0;i<st->nfft-3;i+=4)
+      STORE_CPX4(fout+i, _mm256_xor_ps(LOAD_CPX4(fout+i), odd_sign));
+   for (;i<st->nfft;i++)
+      fout[i].i = -fout[i].i;
+}
+
+#endif
@@ -0,0 +1,429 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+#include "x86cpu.h"
+#include "mdct.h"
+#include "kiss_fft.h"
+#include "_kiss_fft_guts.h"
+#include "stack_alloc.h"
+
+#if defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(FIXED_POINT)
+
+/* Loads p[0], p[2], p[4], p[6] without touching p[7]. */
+static OPUS_INLINE __m128 load_even4(const float *p)
+{
+   return _mm_shuffle_ps(_mm_loadu_ps(p), _mm_loadu_ps(p+3), _MM_SHUFFLE(3,1,2,0));
+}
+
+static OPUS_INLINE __m128 reverse4(__m128 x)
+{
+   return _mm_shuffle_ps(x, x, _MM_SHUFFLE(0,1,2,3));
+}
+
+/* Loads p[0], p[-2], p[-4], p[-6]. */
+static OPUS_INLINE __m128 load_rev_even4(const float *p)
+{
+   return reverse4(load_even4(p-6));
+}
+
+static OPUS_INLINE void store_interleaved4(float *p, __m128 re, __m128 im)
+{
+   _mm_storeu_ps(p, _mm_unpacklo_ps(re, im));
+   _mm_storeu_ps(p+4, _mm_unpackhi_ps(re, im));
+}
+
+/* Interleaves t[0..3] and t[N4..N4+3] as four complex twiddles. */
+static OPUS_INLINE __m256 load_trig4(const kiss_twiddle_scalar *t, int N4)
+{
+   __m128 t0, t1;
+   t0 = _mm_loadu_ps(t);
+   t1 = _mm_loadu_ps(t+N4);
+   return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_unpacklo_ps(t0, t1)),
+                               _mm_unpackhi_ps(t0, t1), 1);
+}
+
+/* Complex multiplication a*b. */
+static OPUS_INLINE __m256 cmul_avx2(__m256 a, __m256 b)
+{
+   __m256 br, bi, as;
+   br = _mm256_moveldup_ps(b);
+   bi = _mm256_movehdup_ps(b);
+   as = _mm256_permute_ps(a, 0xB1);
+   return _mm256_fmaddsub_ps(a, br, _mm256_mul_ps(as, bi));
+}
+
+static OPUS_INLINE void store_cpx2_scattered(kiss_fft_cpx *dst0, kiss_fft_cpx *dst1, __m128 x)
+{
+   _mm_storel_epi64((__m128i*)(void*)dst0, _mm_castps_si128(x));
+   _mm_storel_epi64((__m128i*)(void*)dst1, _mm_castps_si128(_mm_movehl_ps(x, x)));
+}
+
+void clt_mdct_forward_avx2(const mdct_lookup *l, kiss_fft_scalar *in, kiss_fft_scalar * OPUS_RESTRICT out,
+      const opus_val16 *window, int overlap, int shift, int stride, int arch)
+{
+   int i;
+   int N, N2, N4;
+   VARDECL(kiss_fft_scalar, f);
+   VARDECL(kiss_fft_cpx, f2);
+   const kiss_fft_state *st = l->kfft[shift];
+   const kiss_twiddle_scalar *trig;
+   opus_val16 scale;
+   SAVE_STACK;
+   (void)arch;
+   scale = st->scale;
+
+   N = l->n;
+   trig = l->trig;
+   for (i=0;i<shift;i++)
+   {
+      N >>= 1;
+      trig += N;
+   }
+   N2 = N>>1;
+   N4 = N>>2;
+
+   ALLOC(f, N2, kiss_fft_scalar);
+   ALLOC(f2, N4, kiss_fft_cpx);
+
+   /* Consider the input to be composed of four blocks: [a, b, c, d] */
+   /* Window, shuffle, fold */
+   {
+      const int L1 = (overlap+3)>>2;
+      const int L2 = N4-((overlap+3)>>2);
+      /* Temp pointers to make it really clear to the compiler what we're doing */
+      const kiss_fft_scalar * OPUS_RESTRICT xp1 = in+(overlap>>1);
+      const kiss_fft_scalar * OPUS_RESTRICT xp2 = in+N2-1+(overlap>>1);
+      kiss_fft_scalar * OPUS_RESTRICT yp = f;
+      const opus_val16 * OPUS_RESTRICT wp1 = window+(overlap>>1);
+      const opus_val16 * OPUS_RESTRICT wp2 = window+(overlap>>1)-1;
+      for(i=0;i<L1-3;i+=4)
+      {
+         __m128 re, im;
+         /* Real part arranged as -d-cR, Imag part arranged as -b+aR*/
+         re = _mm_add_ps(_mm_mul_ps(load_rev_even4(wp2), load_even4(xp1+N2)),
+                         _mm_mul_ps(load_even4(wp1), load_rev_even4(xp2)));
+         im = _mm_sub_ps(_mm_mul_ps(load_even4(wp1), load_even4(xp1)),
+                         _mm_mul_ps(load_rev_even4(wp2), load_rev_even4(xp2-N2)));
+         store_interleaved4(yp, re, im);
+         yp+=8;
+         xp1+=8;
+         xp2-=8;
+         wp1+=8;
+         wp2-=8;
+      }
+      for(;i<L1;i++)
+      {
+         *yp++ = MULT16_32_Q15(*wp2, xp1[N2]) + MULT16_32_Q15(*wp1,*xp2);
+         *yp++ = MULT16_32_Q15(*wp1, *xp1)    - MULT16_32_Q15(*wp2, xp2[-N2]);
+         xp1+=2;
+         xp2-=2;
+         wp1+=2;
+         wp2-=2;
+      }
+      wp1 = window;
+      wp2 = window+overlap-1;
+      for(;i<L2-3;i+=4)
+      {
+         /* Real part arranged as a-bR, Imag part arranged as -c-dR */
+         store_interleaved4(yp, load_rev_even4(xp2), load_even4(xp1));
+         yp+=8;
+         xp1+=8;
+         xp2-=8;
+      }
+      for(;i<L2;i++)
+      {
+         *yp++ = *xp2;
+         *yp++ = *xp1;
+         xp1+=2;
+         xp2-=2;
+      }
+      for(;i<N4-3;i+=4)
+      {
+         __m128 re, im;
+         /* Real part arranged as a-bR, Imag part arranged as -c-dR */
+         re = _mm_sub_ps(_mm_mul_ps(load_rev_even4(wp2), load_rev_even4(xp2)),
+                         _mm_mul_ps(load_even4(wp1), load_even4(xp1-N2)));
+         im = _mm_add_ps(_mm_mul_ps(load_rev_even4(wp2), load_even4(xp1)),
+                         _mm_mul_ps(load_even4(wp1), load_rev_even4(xp2+N2)));
+         store_interleaved4(yp, re, im);
+         yp+=8;
+         xp1+=8;
+         xp2-=8;
+         wp1+=8;
+         wp2-=8;
+      }
+      for(;i<N4;i++)
+      {
+         *yp++ =  -MULT16_32_Q15(*wp1, xp1[-N2]) + MULT16_32_Q15(*wp2, *xp2);
+         *yp++ = MULT16_32_Q15(*wp2, *xp1)     + MULT16_32_Q15(*wp1, xp2[N2]);
+         xp1+=2;
+         xp2-=2;
+         wp1+=2;
+         wp2-=2;
+      }
+   }
+   /* Pre-rotation, storing directly in bit-reversed order. */
+   {
+      const kiss_fft_scalar * OPUS_RESTRICT yp = f;
+      const kiss_twiddle_scalar *t = &trig[0];
+      const opus_int16 * OPUS_RESTRICT bitrev = st->bitrev;
+      __m256 scale8 = _mm256_set1_ps(scale);
+      for(i=0;i<N4-3;i+=4)
+      {
+         __m256 y;
+         y = cmul_avx2(_mm256_loadu_ps(yp), load_trig4(t+i, N4));
+         y = _mm256_mul_ps(y, scale8);
+         store_cpx2_scattered(&f2[bitrev[i]], &f2[bitrev[i+1]], _mm256_castps256_ps128(y));
+         store_cpx2_scattered(&f2[bitrev[i+2]], &f2[bitrev[i+3]], _mm256_extractf128_ps(y, 1));
+         yp += 8;
+      }
+      for(;i<N4;i++)
+      {
+         kiss_fft_cpx yc;
+         kiss_twiddle_scalar t0, t1;
+         kiss_fft_scalar re, im;
+         t0 = t[i];
+         t1 = t[N4+i];
+         re = *yp++;
+         im = *yp++;
+         yc.r = scale*(S_MUL(re,t0)  -  S_MUL(im,t1));
+         yc.i = scale*(S_MUL(im,t0)  +  S_MUL(re,t1));
+         f2[bitrev[i]] = yc;
+      }
+   }
+
+   /* N/4 complex FFT, does not downscale anymore */
+   opus_fft_impl_avx2(st, f2);
+
+   /* Post-rotate */
+   {
+      /* Temp pointers to make it really clear to the compiler what we're doing */
+      const kiss_fft_cpx * OPUS_RESTRICT fp = f2;
+      kiss_fft_scalar * OPUS_RESTRICT yp1 = out;
+      kiss_fft_scalar * OPUS_RESTRICT yp2 = out+stride*(N2-1);
+      const kiss_twiddle_scalar *t = &trig[0];
+      for(i=0;i<N4-3;i+=4)
+      {
+         int k;
+         float y[8];
+         _mm256_storeu_ps(y, cmul_avx2(_mm256_loadu_ps((const float*)(const void*)fp), load_trig4(t+i, N4)));
+         for (k=0;k<4;k++)
+         {
+            *yp1 = -y[2*k];
+            *yp2 = y[2*k+1];
+            yp1 += 2*stride;
+            yp2 -= 2*stride;
+         }
+         fp += 4;
+      }
+      for(;i<N4;i++)
+      {
+         kiss_fft_scalar yr, yi;
+         yr = S_MUL(fp->i,t[N4+i]) - S_MUL(fp->r,t[i]);
+         yi = S_MUL(fp->r,t[N4+i]) + S_MUL(fp->i,t[i]);
+         *yp1 = yr;
+         *yp2 = yi;
+         fp++;
+         yp1 += 2*stride;
+         yp2 -= 2*stride;
+      }
+   }
+   RESTORE_STACK;
+}
+
+void clt_mdct_backward_avx2(const mdct_lookup *l, kiss_fft_scalar *in, kiss_fft_scalar * OPUS_RESTRICT out,
+      const opus_val16 * OPUS_RESTRICT window, int overlap, int shift, int stride, int arch)
+{
+   int i;
+   int N, N2, N4;
+   const kiss_twiddle_scalar *trig;
+   (void) arch;
+
+   N = l->n;
+   trig = l->trig;
+   for (i=0;i<shift;i++)
+   {
+      N >>= 1;
+      trig += N;
+   }
+   N2 = N>>1;
+   N4 = N>>2;
+
+   /* Pre-rotate */
+   {
+      /* Temp pointers to make it really clear to the compiler what we're doing */
+      const kiss_fft_scalar * OPUS_RESTRICT xp1 = in;
+      const kiss_fft_scalar * OPUS_RESTRICT xp2 = in+stride*(N2-1);
+      kiss_fft_scalar * OPUS_RESTRICT yp = out+(overlap>>1);
+      const kiss_twiddle_scalar * OPUS_RESTRICT t = &trig[0];
+      const opus_int16 * OPUS_RESTRICT bitrev = l->kfft[shift]->bitrev;
+      kiss_fft_cpx *yc = (kiss_fft_cpx*)(void*)yp;
+      for(i=0;i<N4-3;i+=4)
+      {
+         __m128 x1, x2, t0, t1, yr, yi;
+         if (stride == 1)
+         {
+            x1 = load_even4(xp1);
+            x2 = load_rev_even4(xp2);
+         } else {
+            x1 = _mm_set_ps(xp1[6*stride], xp1[4*stride], xp1[2*stride], xp1[0]);
+            x2 = _mm_set_ps(xp2[-6*stride], xp2[-4*stride], xp2[-2*stride], xp2[0]);
+         }
+         t0 = _mm_loadu_ps(t+i);
+         t1 = _mm_loadu_ps(t+N4+i);
+         yr = _mm_add_ps(_mm_mul_ps(x2, t0), _mm_mul_ps(x1, t1));
+         yi = _mm_sub_ps(_mm_mul_ps(x1, t0), _mm_mul_ps(x2, t1));
+         /* We swap real and imag because we use an FFT instead of an IFFT. */
+         store_cpx2_scattered(&yc[bitrev[i]], &yc[bitrev[i+1]], _mm_unpacklo_ps(yi, yr));
+         store_cpx2_scattered(&yc[bitrev[i+2]], &yc[bitrev[i+3]], _mm_unpackhi_ps(yi, yr));
+         xp1+=8*stride;
+         xp2-=8*stride;
+      }
+      for(;i<N4;i++)
+      {
+         int rev;
+         kiss_fft_scalar yr, yi;
+         rev = bitrev[i];
+         yr = ADD32_ovflw(S_MUL(*xp2, t[i]), S_MUL(*xp1, t[N4+i]));
+         yi = SUB32_ovflw(S_MUL(*xp1, t[i]), S_MUL(*xp2, t[N4+i]));
+         yp[2*rev+1] = yr;
+         yp[2*rev] = yi;
+         xp1+=2*stride;
+         xp2-=2*stride;
+      }
+   }
+
+   opus_fft_impl_avx2(l->kfft[shift], (kiss_fft_cpx*)(out+(overlap>>1)));
+
+   /* Post-rotate and de-shuffle from both ends of the buffer at once to make
+      it in-place. */
+   {
+      kiss_fft_scalar * yp0 = out+(overlap>>1);
+      kiss_fft_scalar * yp1 = out+(overlap>>1)+N2-2;
+      const kiss_twiddle_scalar *t = &trig[0];
+      /* Four pairs at a time, as long as the blocks taken from both ends
+         don't overlap. */
+      for(i=0;2*i+8<=N4;i+=4)
+      {
+         __m128 fa, fb, ba, bb;
+         __m128 fre, fim, bre, bim;
+         __m128 t0f, t1f, t0b, t1b;
+         __m128 yrf, yif, yrb, yib;
+         fa = _mm_loadu_ps(yp0);
+         fb = _mm_loadu_ps(yp0+4);
+         ba = _mm_loadu_ps(yp1-6);
+         bb = _mm_loadu_ps(yp1-2);
+         /* We swap real and imag because we're using an FFT instead of an IFFT. */
+         fim = _mm_shuffle_ps(fa, fb, _MM_SHUFFLE(2,0,2,0));
+         fre = _mm_shuffle_ps(fa, fb, _MM_SHUFFLE(3,1,3,1));
+         bim = reverse4(_mm_shuffle_ps(ba, bb, _MM_SHUFFLE(2,0,2,0)));
+         bre = reverse4(_mm_shuffle_ps(ba, bb, _MM_SHUFFLE(3,1,3,1)));
+         t0f = _mm_loadu_ps(t+i);
+         t1f = _mm_loadu_ps(t+N4+i);
+         t0b = reverse4(_mm_loadu_ps(t+N4-4-i));
+         t1b = reverse4(_mm_loadu_ps(t+N2-4-i));
+         /* We'd scale up by 2 here, but instead it's done when mixing the windows */
+         yrf = _mm_add_ps(_mm_mul_ps(fre, t0f), _mm_mul_ps(fim, t1f));
+         yif = _mm_sub_ps(_mm_mul_ps(fre, t1f), _mm_mul_ps(fim, t0f));
+         yrb = _mm_add_ps(_mm_mul_ps(bre, t0b), _mm_mul_ps(bim, t1b));
+         yib = _mm_sub_ps(_mm_mul_ps(bre, t1b), _mm_mul_ps(bim, t0b));
+         store_interleaved4(yp0, yrf, yib);
+         store_interleaved4(yp1-6, reverse4(yrb), reverse4(yif));
+         yp0 += 8;
+         yp1 -= 8;
+      }
+      /* Loop to (N4+1)>>1 to handle odd N4. When N4 is odd, the
+         middle pair will be computed twice. */
+      for(;i<(N4+1)>>1;i++)
+      {
+         kiss_fft_scalar re, im, yr, yi;
+         kiss_twiddle_scalar t0, t1;
+         /* We swap real and imag because we're using an FFT instead of an IFFT. */
+         re = yp0[1];
+         im = yp0[0];
+         t0 = t[i];
+         t1 = t[N4+i];
+         /* We'd scale up by 2 here, but instead it's done when mixing the windows */
+         yr = ADD32_ovflw(S_MUL(re,t0), S_MUL(im,t1));
+         yi = SUB32_ovflw(S_MUL(re,t1), S_MUL(im,t0));
+         /* We swap real and imag because we're using an FFT instead of an IFFT. */
+         re = yp1[1];
+         im = yp1[0];
+         yp0[0] = yr;
+         yp1[1] = yi;
+
+         t0 = t[(N4-i-1)];
+         t1 = t[(N2-i-1)];
+         /* We'd scale up by 2 here, but instead it's done when mixing the windows */
+         yr = ADD32_ovflw(S_MUL(re,t0), S_MUL(im,t1));
+         yi = SUB32_ovflw(S_MUL(re,t1), S_MUL(im,t0));
+         yp1[0] = yr;
+         yp0[1] = yi;
+         yp0 += 2;
+         yp1 -= 2;
+      }
+   }
+
+   /* Mirror on both sides for TDAC */
+   {
+      kiss_fft_scalar * OPUS_RESTRICT xp1 = out+overlap-1;
+      kiss_fft_scalar * OPUS_RESTRICT yp1 = out;
+      const opus_val16 * OPUS_RESTRICT wp1 = window;
+      const opus_val16 * OPUS_RESTRICT wp2 = window+overlap-1;
+
+      for(i = 0; i+4 <= overlap/2; i+=4)
+      {
+         __m128 x1, x2, w1, w2;
+         x1 = reverse4(_mm_loadu_ps(xp1-3));
+         x2 = _mm_loadu_ps(yp1);
+         w1 = _mm_loadu_ps(wp1);
+         w2 = reverse4(_mm_loadu_ps(wp2-3));
+         _mm_storeu_ps(yp1, _mm_sub_ps(_mm_mul_ps(w2, x2), _mm_mul_ps(w1, x1)));
+         _mm_storeu_ps(xp1-3, reverse4(_mm_add_ps(_mm_mul_ps(w1, x2), _mm_mul_ps(w2, x1))));
+         yp1 += 4;
+         xp1 -= 4;
+         wp1 += 4;
+         wp2 -= 4;
+      }
+      for(; i < overlap/2; i++)
+      {
+         kiss_fft_scalar x1, x2;
+         x1 = *xp1;
+         x2 = *yp1;
+         *yp1++ = SUB32_ovflw(MULT16_32_Q15(*wp2, x2), MULT16_32_Q15(*wp1, x1));
+         *xp1-- = ADD32_ovflw(MULT16_32_Q15(*wp1, x2), MULT16_32_Q15(*wp2, x1));
+         wp1++;
+         wp2--;
+      }
+   }
+}
+
+#endif
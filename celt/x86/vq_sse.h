@@ -46,6 +46,16 @@ extern opus_val16 (*const OP_PVQ_SEARCH_IMPL[OPUS_ARCHMASK + 1])(
 #  define op_pvq_search(X, iy, K, N, arch) \
     ((*OP_PVQ_SEARCH_IMPL[(arch) & OPUS_ARCHMASK])(X, iy, K, N, arch))
 
+#endif
+
+#if defined(OPUS_X86_PRESUME_SSE2)
+
+#define OVERRIDE_EXP_ROTATION_X4
+void exp_rotation_x4_sse2(celt_norm *X, int len, int dir, int stride2,
+      opus_val16 c, opus_val16 s);
+#define exp_rotation_x4(X, len, dir, stride2, c, s) \
+    (exp_rotation_x4_sse2(X, len, dir, stride2, c, s))
+
 #endif
 #endif
 
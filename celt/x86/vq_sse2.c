@@ -214,4 +214,99 @@ opus_val16 op_pvq_search_sse2(celt_norm *_X, int *iy, int K, int N, int arch)
    return yy;
 }
 
+/* exp_rotation1() applied to four vectors at once that are interleaved in X
+   (X[4*i+k] is element i of vector k). */
+static void exp_rotation1_x4(float *X, int len, int stride, float c, float s)
+{
+   int i;
+   __m128 c4, s4;
+   c4 = _mm_set1_ps(c);
+   s4 = _mm_set1_ps(s);
+   for (i=0;i<len-stride;i++)
+   {
+      __m128 x1, x2;
+      x1 = _mm_loadu_ps(&X[4*i]);
+      x2 = _mm_loadu_ps(&X[4*(i+stride)]);
+      _mm_storeu_ps(&X[4*(i+stride)], _mm_add_ps(_mm_mul_ps(c4, x2), _mm_mul_ps(s4, x1)));
+      _mm_storeu_ps(&X[4*i], _mm_sub_ps(_mm_mul_ps(c4, x1), _mm_mul_ps(s4, x2)));
+   }
+   for (i=len-2*stride-1;i>=0;i--)
+   {
+      __m128 x1, x2;
+      x1 = _mm_loadu_ps(&X[4*i]);
+      x2 = _mm_loadu_ps(&X[4*(i+stride)]);
+      _mm_storeu_ps(&X[4*(i+stride)], _mm_add_ps(_mm_mul_ps(c4, x2), _mm_mul_ps(s4, x1)));
+      _mm_storeu_ps(&X[4*i], _mm_sub_ps(_mm_mul_ps(c4, x1), _mm_mul_ps(s4, x2)));
+   }
+}
+
+/* Transposes four blocks of len values between X and the interleaved layout
+   of tmp. */
+static void interleave_x4(float *tmp, float *X, int len, int to_tmp)
+{
+   int j;
+   for (j=0;j<len-3;j+=4)
+   {
+      __m128 r0, r1, r2, r3;
+      if (to_tmp)
+      {
+         r0 = _mm_loadu_ps(&X[j]);
+         r1 = _mm_loadu_ps(&X[len+j]);
+         r2 = _mm_loadu_ps(&X[2*len+j]);
+         r3 = _mm_loadu_ps(&X[3*len+j]);
+         _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+         _mm_storeu_ps(&tmp[4*j], r0);
+         _mm_storeu_ps(&tmp[4*j+4], r1);
+         _mm_storeu_ps(&tmp[4*j+8], r2);
+         _mm_storeu_ps(&tmp[4*j+12], r3);
+      } else {
+         r0 = _mm_loadu_ps(&tmp[4*j]);
+         r1 = _mm_loadu_ps(&tmp[4*j+4]);
+         r2 = _mm_loadu_ps(&tmp[4*j+8]);
+         r3 = _mm_loadu_ps(&tmp[4*j+12]);
+         _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+         _mm_storeu_ps(&X[j], r0);
+         _mm_storeu_ps(&X[len+j], r1);
+         _mm_storeu_ps(&X[2*len+j], r2);
+         _mm_storeu_ps(&X[3*len+j], r3);
+      }
+   }
+   for (;j<len;j++)
+   {
+      if (to_tmp)
+      {
+         tmp[4*j] = X[j];
+         tmp[4*j+1] = X[len+j];
+         tmp[4*j+2] = X[2*len+j];
+         tmp[4*j+3] = X[3*len+j];
+      } else {
+         X[j] = tmp[4*j];
+         X[len+j] = tmp[4*j+1];
+         X[2*len+j] = tmp[4*j+2];
+         X[3*len+j] = tmp[4*j+3];
+      }
+   }
+}
+
+void exp_rotation_x4_sse2(celt_norm *X, int len, int dir, int stride2,
+      opus_val16 c, opus_val16 s)
+{
+   VARDECL(float, tmp);
+   SAVE_STACK;
+   ALLOC(tmp, 4*len, float);
+   interleave_x4(tmp, X, len, 1);
+   if (dir < 0)
+   {
+      if (stride2)
+         exp_rotation1_x4(tmp, len, stride2, s, c);
+      exp_rotation1_x4(tmp, len, 1, c, s);
+   } else {
+      exp_rotation1_x4(tmp, len, 1, c, -s);
+      if (stride2)
+         exp_rotation1_x4(tmp, len, stride2, s, -c);
+   }
+   interleave_x4(tmp, X, len, 0);
+   RESTORE_STACK;
+}
+
 #endif
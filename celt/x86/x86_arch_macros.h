@@ -44,4 +44,11 @@
 #  endif
 # endif
 
+/* /arch:AVX2 also enables F16C but does not say so. */
+# ifdef __AVX2__
+#  ifndef __F16C__
+#   define __F16C__
+#  endif
+# endif
+
 #endif
@@ -34,6 +34,9 @@
 #include "pitch.h"
 #include "pitch_sse.h"
 #include "vq.h"
+#include "kiss_fft.h"
+#include "mdct.h"
+#include "celt_output.h"
 
 #if defined(OPUS_HAVE_RTCD)
 
@@ -53,7 +56,9 @@ void (*const CELT_FIR_IMPL[OPUS_ARCHMASK + 1])(
   celt_fir_c,
   celt_fir_c,
   MAY_HAVE_SSE4_1(celt_fir), /* sse4.1  */
-  MAY_HAVE_SSE4_1(celt_fir)  /* avx  */
+  MAY_HAVE_SSE4_1(celt_fir), /* avx  */
+  MAY_HAVE_SSE4_1(celt_fir), /* avx-vnni */
+  MAY_HAVE_SSE4_1(celt_fir)  /* avx512 */
 };
 
 void (*const XCORR_KERNEL_IMPL[OPUS_ARCHMASK + 1])(
@@ -66,7 +71,9 @@ void (*const XCORR_KERNEL_IMPL[OPUS_ARCHMASK + 1])(
   xcorr_kernel_c,
   xcorr_kernel_c,
   MAY_HAVE_SSE4_1(xcorr_kernel), /* sse4.1  */
-  MAY_HAVE_SSE4_1(xcorr_kernel)  /* avx  */
+  MAY_HAVE_SSE4_1(xcorr_kernel), /* avx  */
+  MAY_HAVE_SSE4_1(xcorr_kernel), /* avx-vnni */
+  MAY_HAVE_SSE4_1(xcorr_kernel)  /* avx512 */
 };
 
 #endif
@@ -83,7 +90,9 @@ opus_val32 (*const CELT_INNER_PROD_IMPL[OPUS_ARCHMASK + 1])(
   celt_inner_prod_c,
   MAY_HAVE_SSE2(celt_inner_prod),
   MAY_HAVE_SSE4_1(celt_inner_prod), /* sse4.1  */
-  MAY_HAVE_SSE4_1(celt_inner_prod)  /* avx  */
+  MAY_HAVE_SSE4_1(celt_inner_prod), /* avx  */
+  MAY_HAVE_SSE4_1(celt_inner_prod), /* avx-vnni */
+  MAY_HAVE_SSE4_1(celt_inner_prod)  /* avx512 */
 };
 
 #endif
@@ -104,9 +113,65 @@ void (*const PITCH_XCORR_IMPL[OPUS_ARCHMASK + 1])(
   celt_pitch_xcorr_c,
   celt_pitch_xcorr_c,
   celt_pitch_xcorr_c,
+  MAY_HAVE_AVX2(celt_pitch_xcorr),
+  MAY_HAVE_AVX2(celt_pitch_xcorr),
   MAY_HAVE_AVX2(celt_pitch_xcorr)
 };
 
+void (*const OPUS_FFT[OPUS_ARCHMASK+1])(const kiss_fft_state *cfg,
+                                        const kiss_fft_cpx *fin,
+                                        kiss_fft_cpx *fout) = {
+  opus_fft_c,                /* non-sse */
+  opus_fft_c,
+  opus_fft_c,
+  opus_fft_c,
+  MAY_HAVE_AVX2(opus_fft),
+  MAY_HAVE_AVX2(opus_fft),
+  MAY_HAVE_AVX2(opus_fft)
+};
+
+void (*const OPUS_IFFT[OPUS_ARCHMASK+1])(const kiss_fft_state *cfg,
+                                         const kiss_fft_cpx *fin,
+                                         kiss_fft_cpx *fout) = {
+  opus_ifft_c,                /* non-sse */
+  opus_ifft_c,
+  opus_ifft_c,
+  opus_ifft_c,
+  MAY_HAVE_AVX2(opus_ifft),
+  MAY_HAVE_AVX2(opus_ifft),
+  MAY_HAVE_AVX2(opus_ifft)
+};
+
+void (*const CLT_MDCT_FORWARD_IMPL[OPUS_ARCHMASK+1])(const mdct_lookup *l,
+                                                     kiss_fft_scalar *in,
+                                                     kiss_fft_scalar * OPUS_RESTRICT out,
+                                                     const opus_val16 *window,
+                                                     int overlap, int shift,
+                                                     int stride, int arch) = {
+  clt_mdct_forward_c,                /* non-sse */
+  clt_mdct_forward_c,
+  clt_mdct_forward_c,
+  clt_mdct_forward_c,
+  MAY_HAVE_AVX2(clt_mdct_forward),
+  MAY_HAVE_AVX2(clt_mdct_forward),
+  MAY_HAVE_AVX2(clt_mdct_forward)
+};
+
+void (*const CLT_MDCT_BACKWARD_IMPL[OPUS_ARCHMASK+1])(const mdct_lookup *l,
+                                                      kiss_fft_scalar *in,
+                                                      kiss_fft_scalar * OPUS_RESTRICT out,
+                                                      const opus_val16 *window,
+                                                      int overlap, int shift,
+                                                      int stride, int arch) = {
+  clt_mdct_backward_c,                /* non-sse */
+  clt_mdct_backward_c,
+  clt_mdct_backward_c,
+  clt_mdct_backward_c,
+  MAY_HAVE_AVX2(clt_mdct_backward),
+  MAY_HAVE_AVX2(clt_mdct_backward),
+  MAY_HAVE_AVX2(clt_mdct_backward)
+};
+
 #endif
 
 
@@ -122,6 +187,8 @@ void (*const XCORR_KERNEL_IMPL[OPUS_ARCHMASK + 1])(
   MAY_HAVE_SSE(xcorr_kernel),
   MAY_HAVE_SSE(xcorr_kernel),
   MAY_HAVE_SSE(xcorr_kernel),
+  MAY_HAVE_SSE(xcorr_kernel),
+  MAY_HAVE_SSE(xcorr_kernel),
   MAY_HAVE_SSE(xcorr_kernel)
 };
 
@@ -134,6 +201,8 @@ opus_val32 (*const CELT_INNER_PROD_IMPL[OPUS_ARCHMASK + 1])(
   MAY_HAVE_SSE(celt_inner_prod),
   MAY_HAVE_SSE(celt_inner_prod),
   MAY_HAVE_SSE(celt_inner_prod),
+  MAY_HAVE_SSE(celt_inner_prod),
+  MAY_HAVE_SSE(celt_inner_prod),
   MAY_HAVE_SSE(celt_inner_prod)
 };
 
@@ -149,6 +218,8 @@ void (*const DUAL_INNER_PROD_IMPL[OPUS_ARCHMASK + 1])(
   MAY_HAVE_SSE(dual_inner_prod),
   MAY_HAVE_SSE(dual_inner_prod),
   MAY_HAVE_SSE(dual_inner_prod),
+  MAY_HAVE_SSE(dual_inner_prod),
+  MAY_HAVE_SSE(dual_inner_prod),
   MAY_HAVE_SSE(dual_inner_prod)
 };
 
@@ -165,6 +236,8 @@ void (*const COMB_FILTER_CONST_IMPL[OPUS_ARCHMASK + 1])(
   MAY_HAVE_SSE(comb_filter_const),
   MAY_HAVE_SSE(comb_filter_const),
   MAY_HAVE_SSE(comb_filter_const),
+  MAY_HAVE_SSE(comb_filter_const),
+  MAY_HAVE_SSE(comb_filter_const),
   MAY_HAVE_SSE(comb_filter_const)
 };
 
@@ -179,9 +252,92 @@ opus_val16 (*const OP_PVQ_SEARCH_IMPL[OPUS_ARCHMASK + 1])(
   op_pvq_search_c,
   MAY_HAVE_SSE2(op_pvq_search),
   MAY_HAVE_SSE2(op_pvq_search),
+  MAY_HAVE_SSE2(op_pvq_search),
+  MAY_HAVE_SSE2(op_pvq_search),
   MAY_HAVE_SSE2(op_pvq_search)
 };
 #endif
 
+#if !defined(FIXED_POINT) && defined(OPUS_X86_MAY_HAVE_SSE2) && \
+ !defined(OPUS_X86_PRESUME_AVX2) && \
+ (defined(OPUS_X86_MAY_HAVE_AVX2) || !defined(OPUS_X86_PRESUME_SSE2))
+
+void (*const COMB_FILTER_OVERLAP_IMPL[OPUS_ARCHMASK + 1])(
+      opus_val32 *y, const opus_val32 *x, int T0, int T1, int N,
+      const opus_val16 *g0, const opus_val16 *g1, const opus_val16 *window
+) = {
+  comb_filter_overlap_c,                /* non-sse */
+  comb_filter_overlap_c,
+  MAY_HAVE_SSE2(comb_filter_overlap),
+  MAY_HAVE_SSE2(comb_filter_overlap),
+  MAY_HAVE_SSE2(comb_filter_overlap),   /* avx  */
+  MAY_HAVE_SSE2(comb_filter_overlap),   /* avx-vnni */
+  MAY_HAVE_SSE2(comb_filter_overlap)    /* avx512 */
+};
+
+celt_sig (*const DEEMPHASIS_CHANNEL_IMPL[OPUS_ARCHMASK + 1])(
+      const celt_sig *x, opus_val16 *y, int N, int C, int downsample,
+      opus_val16 coef0, celt_sig m
+) = {
+  deemphasis_channel_c,                 /* non-sse */
+  deemphasis_channel_c,
+  MAY_HAVE_SSE2(deemphasis_channel),
+  MAY_HAVE_SSE2(deemphasis_channel),
+  MAY_HAVE_AVX2(deemphasis_channel),    /* avx  */
+  MAY_HAVE_AVX2(deemphasis_channel),    /* avx-vnni */
+  MAY_HAVE_AVX2(deemphasis_channel)     /* avx512 */
+};
+
+void (*const DEEMPHASIS_STEREO_IMPL[OPUS_ARCHMASK + 1])(
+      const celt_sig *x0, const celt_sig *x1, opus_val16 *pcm, int N,
+      opus_val16 coef0, celt_sig *mem
+) = {
+  deemphasis_stereo_c,                  /* non-sse */
+  deemphasis_stereo_c,
+  MAY_HAVE_SSE2(deemphasis_stereo),
+  MAY_HAVE_SSE2(deemphasis_stereo),
+  MAY_HAVE_AVX2(deemphasis_stereo),     /* avx  */
+  MAY_HAVE_AVX2(deemphasis_stereo),     /* avx-vnni */
+  MAY_HAVE_AVX2(deemphasis_stereo)      /* avx512 */
+};
+
+void (*const SMOOTH_FADE_IMPL[OPUS_ARCHMASK + 1])(
+      const opus_val16 *in1, const opus_val16 *in2, opus_val16 *out,
+      int overlap, int channels, const opus_val16 *window, int inc
+) = {
+  smooth_fade_c,                        /* non-sse */
+  smooth_fade_c,
+  MAY_HAVE_SSE2(smooth_fade),
+  MAY_HAVE_SSE2(smooth_fade),
+  MAY_HAVE_SSE2(smooth_fade),           /* avx  */
+  MAY_HAVE_SSE2(smooth_fade),           /* avx-vnni */
+  MAY_HAVE_SSE2(smooth_fade)            /* avx512 */
+};
+
+void (*const CELT_FLOAT2INT16_IMPL[OPUS_ARCHMASK + 1])(
+      const float *in, opus_int16 *out, int cnt
+) = {
+  celt_float2int16_c,                   /* non-sse */
+  celt_float2int16_c,
+  MAY_HAVE_SSE2(celt_float2int16),
+  MAY_HAVE_SSE2(celt_float2int16),
+  MAY_HAVE_AVX2(celt_float2int16),      /* avx  */
+  MAY_HAVE_AVX2(celt_float2int16),      /* avx-vnni */
+  MAY_HAVE_AVX2(celt_float2int16)       /* avx512 */
+};
+
+int (*const OPUS_LIMIT2_CHECKWITHIN1_IMPL[OPUS_ARCHMASK + 1])(
+      float *samples, int cnt
+) = {
+  opus_limit2_checkwithin1_c,           /* non-sse */
+  opus_limit2_checkwithin1_c,
+  MAY_HAVE_SSE2(opus_limit2_checkwithin1),
+  MAY_HAVE_SSE2(opus_limit2_checkwithin1),
+  MAY_HAVE_AVX2(opus_limit2_checkwithin1), /* avx  */
+  MAY_HAVE_AVX2(opus_limit2_checkwithin1), /* avx-vnni */
+  MAY_HAVE_AVX2(opus_limit2_checkwithin1) /* avx512 */
+};
+#endif
+
 #endif
 #endif
@@ -39,14 +39,20 @@
   ((defined(OPUS_X86_MAY_HAVE_SSE) && !defined(OPUS_X86_PRESUME_SSE)) || \
   (defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(OPUS_X86_PRESUME_SSE2)) || \
   (defined(OPUS_X86_MAY_HAVE_SSE4_1) && !defined(OPUS_X86_PRESUME_SSE4_1)) || \
-  (defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(OPUS_X86_PRESUME_AVX2)))
+  (defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(OPUS_X86_PRESUME_AVX2)) || \
+  defined(OPUS_X86_MAY_HAVE_AVXVNNI) || defined(OPUS_X86_MAY_HAVE_AVX512))
 
 #if defined(_MSC_VER)
 
 #include <intrin.h>
-static _inline void cpuid(unsigned int CPUInfo[4], unsigned int InfoType)
+static _inline void cpuid_count(unsigned int CPUInfo[4], unsigned int InfoType, unsigned int SubLeaf)
 {
-    __cpuid((int*)CPUInfo, InfoType);
+    __cpuidex((int*)CPUInfo, InfoType, SubLeaf);
+}
+
+static _inline unsigned int xgetbv0(void)
+{
+    return (unsigned int)_xgetbv(0);
 }
 
 #else
@@ -55,7 +61,7 @@ static _inline void cpuid(unsigned int CPUInfo[4], unsigned int InfoType)
 #include <cpuid.h>
 #endif
 
-static void cpuid(unsigned int CPUInfo[4], unsigned int InfoType)
+static void cpuid_count(unsigned int CPUInfo[4], unsigned int InfoType, unsigned int SubLeaf)
 {
 #if defined(CPU_INFO_BY_ASM)
 #if defined(__i386__) && defined(__PIC__)
@@ -68,8 +74,7 @@ static void cpuid(unsigned int CPUInfo[4], unsigned int InfoType)
         "=r" (CPUInfo[1]),
         "=c" (CPUInfo[2]),
         "=d" (CPUInfo[3]) :
-        /* We clear ECX to avoid a valgrind false-positive prior to v3.17.0. */
-        "0" (InfoType), "2" (0)
+        "0" (InfoType), "2" (SubLeaf)
     );
 #else
     __asm__ __volatile__ (
@@ -78,14 +83,11 @@ static void cpuid(unsigned int CPUInfo[4], unsigned int InfoType)
         "=b" (CPUInfo[1]),
         "=c" (CPUInfo[2]),
         "=d" (CPUInfo[3]) :
-        /* We clear ECX to avoid a valgrind false-positive prior to v3.17.0. */
-        "0" (InfoType), "2" (0)
+        "0" (InfoType), "2" (SubLeaf)
     );
 #endif
 #elif defined(CPU_INFO_BY_C)
-    /* We use __get_cpuid_count to clear ECX to avoid a valgrind false-positive
-        prior to v3.17.0.*/
-    if (!__get_cpuid_count(InfoType, 0, &(CPUInfo[0]), &(CPUInfo[1]), &(CPUInfo[2]), &(CPUInfo[3]))) {
+    if (!__get_cpuid_count(InfoType, SubLeaf, &(CPUInfo[0]), &(CPUInfo[1]), &(CPUInfo[2]), &(CPUInfo[3]))) {
         /* Our function cannot fail, but __get_cpuid{_count} can.
            Returning all zeroes will effectively disable all SIMD, which is
             what we want on CPUs that don't support CPUID. */
@@ -97,8 +99,31 @@ static void cpuid(unsigned int CPUInfo[4], unsigned int InfoType)
 #endif
 }
 
+/* Reads XCR0 to find which register states the OS saves. Only call this when
+   CPUID reports OSXSAVE. */
+static unsigned int xgetbv0(void)
+{
+    unsigned int eax, edx;
+    /* Encoded by hand for assemblers that do not know xgetbv. */
+    __asm__ __volatile__ (
+        ".byte 0x0f, 0x01, 0xd0":
+        "=a" (eax),
+        "=d" (edx) :
+        "c" (0)
+    );
+    (void)edx;
+    return eax;
+}
+
 #endif
 
+/* We always set ECX (the sub-leaf) explicitly, which also avoids a valgrind
+   false-positive prior to v3.17.0. */
+static void cpuid(unsigned int CPUInfo[4], unsigned int InfoType)
+{
+    cpuid_count(CPUInfo, InfoType, 0);
+}
+
 typedef struct CPU_Feature{
     /*  SIMD: 128-bit */
     int HW_SSE;
@@ -106,25 +131,44 @@ typedef struct CPU_Feature{
     int HW_SSE41;
     /*  SIMD: 256-bit */
     int HW_AVX2;
+    /*  8-bit dot products, VEX (AVX-VNNI) or EVEX (AVX-512 VNNI + VL) */
+    int HW_AVXVNNI;
+    int HW_AVX512VNNI;
 } CPU_Feature;
 
 static void opus_cpu_feature_check(CPU_Feature *cpu_feature)
 {
     unsigned int info[4];
     unsigned int nIds = 0;
+    unsigned int xcr0 = 0;
 
     cpuid(info, 0);
     nIds = info[0];
 
+    cpu_feature->HW_AVXVNNI = 0;
+    cpu_feature->HW_AVX512VNNI = 0;
+
     if (nIds >= 1){
         cpuid(info, 1);
         cpu_feature->HW_SSE = (info[3] & (1 << 25)) != 0;
         cpu_feature->HW_SSE2 = (info[3] & (1 << 26)) != 0;
         cpu_feature->HW_SSE41 = (info[2] & (1 << 19)) != 0;
-        cpu_feature->HW_AVX2 = (info[2] & (1 << 28)) != 0 && (info[2] & (1 << 12)) != 0;
+        /* AVX, FMA and F16C. */
+        cpu_feature->HW_AVX2 = (info[2] & (1 << 28)) != 0 && (info[2] & (1 << 12)) != 0 && (info[2] & (1 << 29)) != 0;
+        if (info[2] & (1 << 27)) {
+            xcr0 = xgetbv0();
+        }
         if (cpu_feature->HW_AVX2 && nIds >= 7) {
             cpuid(info, 7);
             cpu_feature->HW_AVX2 = cpu_feature->HW_AVX2 && (info[1] & (1 << 5)) != 0;
+            /* AVX-512 F, VL and VNNI, with the OS saving the opmask and ZMM state. */
+            cpu_feature->HW_AVX512VNNI = cpu_feature->HW_AVX2 &&
+                (info[1] & (1 << 16)) != 0 && (info[1] & (1U << 31)) != 0 &&
+                (info[2] & (1 << 11)) != 0 && (xcr0 & 0xE6) == 0xE6;
+            if (cpu_feature->HW_AVX2 && info[0] >= 1 && (xcr0 & 0x6) == 0x6) {
+                cpuid_count(info, 7, 1);
+                cpu_feature->HW_AVXVNNI = (info[0] & (1 << 4)) != 0;
+            }
         } else {
             cpu_feature->HW_AVX2 = 0;
         }
@@ -169,6 +213,17 @@ static int opus_select_arch_impl(void)
     }
     arch++;
 
+    /* The two VNNI levels are not nested, so prefer AVX-512 VNNI when both
+       are present and skip the AVX-VNNI level entirely otherwise. */
+    if (cpu_feature.HW_AVX512VNNI)
+    {
+        return arch + 2;
+    }
+    if (cpu_feature.HW_AVXVNNI)
+    {
+        return arch + 1;
+    }
+
     return arch;
 }
 
@@ -176,7 +231,12 @@ int opus_select_arch(void) {
     int arch = opus_select_arch_impl();
 #ifdef FUZZING
     /* Randomly downgrade the architecture. */
-    arch = rand()%(arch+1);
+    {
+        int max_arch = arch;
+        arch = rand()%(arch+1);
+        /* AVX-512 VNNI does not imply AVX-VNNI. */
+        if (arch == 5 && max_arch == 6) arch = 4;
+    }
 #endif
     return arch;
 }
@@ -23,7 +23,9 @@ celt/mfrngcod.h \
 celt/modes.h \
 celt/os_support.h \
 celt/pitch.h \
+celt/profile.h \
 celt/celt_lpc.h \
+celt/celt_output.h \
 celt/x86/celt_lpc_sse.h \
 celt/quant_bands.h \
 celt/rate.h \
@@ -40,6 +42,7 @@ celt/arm/fixed_arm64.h \
 celt/arm/kiss_fft_armv4.h \
 celt/arm/kiss_fft_armv5e.h \
 celt/arm/pitch_arm.h \
+celt/arm/celt_output_arm.h \
 celt/arm/fft_arm.h \
 celt/arm/mdct_arm.h \
 celt/mips/celt_mipsr1.h \
@@ -48,7 +51,10 @@ celt/mips/kiss_fft_mipsr1.h \
 celt/mips/mdct_mipsr1.h \
 celt/mips/pitch_mipsr1.h \
 celt/mips/vq_mipsr1.h \
+celt/x86/kiss_fft_sse.h \
+celt/x86/mdct_sse.h \
 celt/x86/pitch_sse.h \
+celt/x86/celt_output_sse.h \
 celt/x86/vq_sse.h \
 celt/x86/x86_arch_macros.h \
 celt/x86/x86cpu.h
@@ -13,7 +13,9 @@ celt/mathops.c \
 celt/mdct.c \
 celt/modes.c \
 celt/pitch.c \
+celt/profile.c \
 celt/celt_lpc.c \
+celt/celt_output.c \
 celt/quant_bands.c \
 celt/rate.c \
 celt/vq.c
@@ -26,6 +28,7 @@ CELT_SOURCES_SSE = \
 celt/x86/pitch_sse.c
 
 CELT_SOURCES_SSE2 = \
+celt/x86/celt_output_sse2.c \
 celt/x86/pitch_sse2.c \
 celt/x86/vq_sse2.c
 
@@ -34,6 +37,9 @@ celt/x86/celt_lpc_sse4_1.c \
 celt/x86/pitch_sse4_1.c
 
 CELT_SOURCES_AVX2 = \
+celt/x86/celt_output_avx2.c \
+celt/x86/kiss_fft_avx2.c \
+celt/x86/mdct_avx2.c \
 celt/x86/pitch_avx.c
 
 CELT_SOURCES_ARM_RTCD = \
@@ -48,6 +54,7 @@ celt/arm/armopts.s.in
 
 CELT_SOURCES_ARM_NEON_INTR = \
 celt/arm/celt_neon_intr.c \
+celt/arm/celt_output_neon_intr.c \
 celt/arm/pitch_neon_intr.c
 
 CELT_SOURCES_ARM_NE10 = \
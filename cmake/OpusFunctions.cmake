@@ -49,7 +49,7 @@ endfunction()
 include(CheckIncludeFile)
 
 # This function determines if the compiler has support for SSE, SSE2, SSE4.1, AVX,
-# AVX2 and FMA. Should the target systems potentially lack SSE support, the
+# AVX2, FMA, AVX-VNNI and AVX-512 VNNI. Should the target systems potentially lack SSE support, the
 # OPUS_MAY_HAVE_SSE option is recommended for use. If, however, the target system is
 # assured to support SSE, the OPUS_PRESUME_SSE option can be employed, thus
 # eliminating the necessity for an SSE runtime check.
@@ -118,7 +118,7 @@ function(opus_detect_sse COMPILER_SUPPORT_SIMD)
     if(MSVC)
       check_flag(AVX2 /arch:AVX2)
     else()
-      check_flag(AVX2 -mavx2 -mfma -mavx)
+      check_flag(AVX2 -mavx2 -mfma -mavx -mf16c)
     endif()
   else()
     set(AVX2_SUPPORTED
@@ -126,6 +126,23 @@ function(opus_detect_sse COMPILER_SUPPORT_SIMD)
         PARENT_SCOPE)
   endif()
 
+  if(HAVE_IMMINTRIN_H AND AVX2_SUPPORTED) # DNN int8 dot products
+    if(MSVC)
+      check_flag(AVXVNNI /arch:AVX2)
+      check_flag(AVX512 /arch:AVX512)
+    else()
+      check_flag(AVXVNNI -mavxvnni)
+      check_flag(AVX512 -mavx512vnni)
+    endif()
+  else()
+    set(AVXVNNI_SUPPORTED
+        0
+        PARENT_SCOPE)
+    set(AVX512_SUPPORTED
+        0
+        PARENT_SCOPE)
+  endif()
+
   if(SSE1_SUPPORTED OR SSE2_SUPPORTED OR SSE4_1_SUPPORTED OR AVX2_SUPPORTED)
     set(COMPILER_SUPPORT_SIMD 1 PARENT_SCOPE)
   else()
@@ -20,6 +20,8 @@ get_opus_sources(SILK_SOURCES_ARM_NEON_INTR silk_sources.mk
                  silk_sources_arm_neon_intr)
 get_opus_sources(SILK_SOURCES_FIXED_ARM_NEON_INTR silk_sources.mk
                  silk_sources_fixed_arm_neon_intr)
+get_opus_sources(SILK_SOURCES_FLOAT_ARM_NEON_INTR silk_sources.mk
+                 silk_sources_float_arm_neon_intr)
 
 get_opus_sources(OPUS_HEAD opus_headers.mk opus_headers)
 get_opus_sources(OPUS_SOURCES opus_sources.mk opus_sources)
@@ -50,12 +52,15 @@ get_opus_sources(DNN_SOURCES_X86_RTCD lpcnet_sources.mk dnn_sources_x86_rtcd)
 get_opus_sources(DNN_SOURCES_SSE2 lpcnet_sources.mk dnn_sources_sse2)
 get_opus_sources(DNN_SOURCES_SSE4_1 lpcnet_sources.mk dnn_sources_sse4_1)
 get_opus_sources(DNN_SOURCES_AVX2 lpcnet_sources.mk dnn_sources_avx2)
+get_opus_sources(DNN_SOURCES_AVXVNNI lpcnet_sources.mk dnn_sources_avxvnni)
+get_opus_sources(DNN_SOURCES_AVX512 lpcnet_sources.mk dnn_sources_avx512)
 get_opus_sources(DNN_SOURCES_NEON lpcnet_sources.mk dnn_sources_arm_neon)
 get_opus_sources(DNN_SOURCES_DOTPROD lpcnet_sources.mk dnn_sources_arm_dotprod)
 
 get_opus_sources(opus_demo_SOURCES Makefile.am opus_demo_sources)
 get_opus_sources(opus_custom_demo_SOURCES Makefile.am opus_custom_demo_sources)
 get_opus_sources(opus_compare_SOURCES Makefile.am opus_compare_sources)
+get_opus_sources(opus_bench_SOURCES Makefile.am opus_bench_sources)
 get_opus_sources(tests_test_opus_api_SOURCES Makefile.am test_opus_api_sources)
 get_opus_sources(tests_test_opus_encode_SOURCES Makefile.am
                  test_opus_encode_sources)
@@ -67,3 +72,5 @@ get_opus_sources(tests_test_opus_padding_SOURCES Makefile.am
                  test_opus_padding_sources)
 get_opus_sources(tests_test_opus_dred_SOURCES Makefile.am
                  test_opus_dred_sources)
+get_opus_sources(tests_test_opus_dnn_SOURCES Makefile.am
+                 test_opus_dnn_sources)
@@ -48,6 +48,19 @@ void (*const DNN_COMPUTE_LINEAR_IMPL[OPUS_ARCHMASK + 1])(
   MAY_HAVE_DOTPROD(compute_linear) /* dotprod  */
 };
 
+void (*const DNN_COMPUTE_LINEAR_BATCH_IMPL[OPUS_ARCHMASK + 1])(
+         const LinearLayer *linear,
+         float *out,
+         const float *in,
+         int K
+) = {
+  compute_linear_batch_c,                /* default */
+  compute_linear_batch_c,
+  compute_linear_batch_c,
+  MAY_HAVE_NEON(compute_linear_batch),   /* neon  */
+  MAY_HAVE_DOTPROD(compute_linear_batch) /* dotprod  */
+};
+
 #endif
 
 #if (defined(OPUS_ARM_MAY_HAVE_DOTPROD) || defined(OPUS_ARM_MAY_HAVE_NEON)) && !defined(OPUS_ARM_PRESUME_NEON)
@@ -81,6 +94,24 @@ void (*const DNN_COMPUTE_CONV2D_IMPL[OPUS_ARCHMASK + 1])(
     MAY_HAVE_DOTPROD(compute_conv2d) /* dotprod  */
 };
 
+void (*const DNN_COMPUTE_CROSSFADE_CONV_IMPL[OPUS_ARCHMASK + 1])(
+         float *out,
+         const float *in0,
+         const float *kernel0,
+         const float *in1,
+         const float *kernel1,
+         const float *window,
+         int kernel_size,
+         int overlap_size,
+         int frame_size
+) = {
+    compute_crossfade_conv_c,                /* default */
+    compute_crossfade_conv_c,
+    compute_crossfade_conv_c,
+    MAY_HAVE_NEON(compute_crossfade_conv),   /* neon  */
+    MAY_HAVE_DOTPROD(compute_crossfade_conv) /* dotprod  */
+};
+
 
 #endif
 
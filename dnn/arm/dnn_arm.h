@@ -33,6 +33,8 @@
 
 void compute_linear_dotprod(const LinearLayer *linear, float *out, const float *in);
 void compute_linear_neon(const LinearLayer *linear, float *out, const float *in);
+void compute_linear_batch_dotprod(const LinearLayer *linear, float *out, const float *in, int K);
+void compute_linear_batch_neon(const LinearLayer *linear, float *out, const float *in, int K);
 
 void compute_activation_neon(float *output, const float *input, int N, int activation);
 void compute_activation_dotprod(float *output, const float *input, int N, int activation);
@@ -40,15 +42,22 @@ void compute_activation_dotprod(float *output, const float *input, int N, int ac
 void compute_conv2d_neon(const Conv2dLayer *conv, float *out, float *mem, const float *in, int height, int hstride, int activation);
 void compute_conv2d_dotprod(const Conv2dLayer *conv, float *out, float *mem, const float *in, int height, int hstride, int activation);
 
+void compute_crossfade_conv_neon(float *out, const float *in0, const float *kernel0, const float *in1, const float *kernel1, const float *window, int kernel_size, int overlap_size, int frame_size);
+void compute_crossfade_conv_dotprod(float *out, const float *in0, const float *kernel0, const float *in1, const float *kernel1, const float *window, int kernel_size, int overlap_size, int frame_size);
+
 #if defined(OPUS_ARM_PRESUME_DOTPROD)
 
 #define OVERRIDE_COMPUTE_LINEAR
 #define compute_linear(linear, out, in, arch) ((void)(arch),compute_linear_dotprod(linear, out, in))
+#define OVERRIDE_COMPUTE_LINEAR_BATCH
+#define compute_linear_batch(linear, out, in, K, arch) ((void)(arch),compute_linear_batch_dotprod(linear, out, in, K))
 
 #elif defined(OPUS_ARM_PRESUME_NEON_INTR) && !defined(OPUS_ARM_MAY_HAVE_DOTPROD)
 
 #define OVERRIDE_COMPUTE_LINEAR
 #define compute_linear(linear, out, in, arch) ((void)(arch),compute_linear_neon(linear, out, in))
+#define OVERRIDE_COMPUTE_LINEAR_BATCH
+#define compute_linear_batch(linear, out, in, K, arch) ((void)(arch),compute_linear_batch_neon(linear, out, in, K))
 
 #elif defined(OPUS_HAVE_RTCD) && (defined(OPUS_ARM_MAY_HAVE_DOTPROD) || defined(OPUS_ARM_MAY_HAVE_NEON))
 
@@ -61,6 +70,16 @@ extern void (*const DNN_COMPUTE_LINEAR_IMPL[OPUS_ARCHMASK + 1])(
 #define compute_linear(linear, out, in, arch) \
     ((*DNN_COMPUTE_LINEAR_IMPL[(arch) & OPUS_ARCHMASK])(linear, out, in))
 
+extern void (*const DNN_COMPUTE_LINEAR_BATCH_IMPL[OPUS_ARCHMASK + 1])(
+                    const LinearLayer *linear,
+                    float *out,
+                    const float *in,
+                    int K
+                    );
+#define OVERRIDE_COMPUTE_LINEAR_BATCH
+#define compute_linear_batch(linear, out, in, K, arch) \
+    ((*DNN_COMPUTE_LINEAR_BATCH_IMPL[(arch) & OPUS_ARCHMASK])(linear, out, in, K))
+
 
 #endif
 
@@ -70,6 +89,8 @@ extern void (*const DNN_COMPUTE_LINEAR_IMPL[OPUS_ARCHMASK + 1])(
 #define compute_activation(output, input, N, activation, arch) ((void)(arch),compute_activation_neon(output, input, N, activation))
 #define OVERRIDE_COMPUTE_CONV2D
 #define compute_conv2d(conv, out, mem, in, height, hstride, activation, arch) ((void)(arch),compute_conv2d_neon(conv, out, mem, in, height, hstride, activation))
+#define OVERRIDE_COMPUTE_CROSSFADE_CONV
+#define compute_crossfade_conv(out, in0, kernel0, in1, kernel1, window, kernel_size, overlap_size, frame_size, arch) ((void)(arch),compute_crossfade_conv_neon(out, in0, kernel0, in1, kernel1, window, kernel_size, overlap_size, frame_size))
 
 #elif defined(OPUS_HAVE_RTCD) && (defined(OPUS_ARM_MAY_HAVE_DOTPROD) || defined(OPUS_ARM_MAY_HAVE_NEON))
 
@@ -98,6 +119,22 @@ extern void (*const DNN_COMPUTE_CONV2D_IMPL[OPUS_ARCHMASK + 1])(
     ((*DNN_COMPUTE_CONV2D_IMPL[(arch) & OPUS_ARCHMASK])(conv, out, mem, in, height, hstride, activation))
 
 
+extern void (*const DNN_COMPUTE_CROSSFADE_CONV_IMPL[OPUS_ARCHMASK + 1])(
+                    float *out,
+                    const float *in0,
+                    const float *kernel0,
+                    const float *in1,
+                    const float *kernel1,
+                    const float *window,
+                    int kernel_size,
+                    int overlap_size,
+                    int frame_size
+                    );
+#define OVERRIDE_COMPUTE_CROSSFADE_CONV
+#define compute_crossfade_conv(out, in0, kernel0, in1, kernel1, window, kernel_size, overlap_size, frame_size, arch) \
+    ((*DNN_COMPUTE_CROSSFADE_CONV_IMPL[(arch) & OPUS_ARCHMASK])(out, in0, kernel0, in1, kernel1, window, kernel_size, overlap_size, frame_size))
+
+
 #endif
 
 
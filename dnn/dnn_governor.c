@@ -0,0 +1,186 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "dnn_governor.h"
+#include "arch.h"
+#include "os_support.h"
+#include "profile.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+# define DNN_GOVERNOR_ATOMIC_ADD(x, v) __atomic_add_fetch((x), (v), __ATOMIC_ACQ_REL)
+# define DNN_GOVERNOR_ATOMIC_CAS(x, old, new) __sync_bool_compare_and_swap((x), (old), (new))
+#elif defined(_MSC_VER)
+# include <intrin.h>
+# define DNN_GOVERNOR_ATOMIC_ADD(x, v) (_InterlockedExchangeAdd((volatile long*)(x), (v)) + (v))
+# define DNN_GOVERNOR_ATOMIC_CAS(x, old, new) \
+   (_InterlockedCompareExchange((volatile long*)(x), (long)(new), (long)(old)) == (long)(old))
+#else
+/* No atomics: the governor must then only be used from one thread. */
+# define DNN_GOVERNOR_ATOMIC_ADD(x, v) (*(x) += (v))
+# define DNN_GOVERNOR_ATOMIC_CAS(x, old, new) (*(x) == (old) ? (*(x) = (new), 1) : 0)
+#endif
+
+/* The load is measured over windows of 100 ms. Quality is only raised again
+   after one second under 75% of the budget, since the load just measured
+   was obtained at the lower quality. */
+#define GOVERNOR_WINDOW_US 100000
+#define GOVERNOR_CALM_WINDOWS 10
+
+static const int governor_max_complexity[DNN_GOVERNOR_NO_DEEP+1] = {10, 6, 5, 4};
+
+static opus_uint32 governor_now_us(void)
+{
+   return (opus_uint32)(opus_time_ns()/1000);
+}
+
+static void governor_unref(OpusDNNGovernor *governor)
+{
+   if (governor != NULL && DNN_GOVERNOR_ATOMIC_ADD(&governor->refcount, -1) == 0)
+      opus_free(governor);
+}
+
+OpusDNNGovernor *opus_dnn_governor_create(opus_int32 budget, int *error)
+{
+   OpusDNNGovernor *governor;
+   if (budget <= 0)
+   {
+      if (error) *error = OPUS_BAD_ARG;
+      return NULL;
+   }
+   governor = (OpusDNNGovernor *)opus_alloc(sizeof(OpusDNNGovernor));
+   if (governor == NULL)
+   {
+      if (error) *error = OPUS_ALLOC_FAIL;
+      return NULL;
+   }
+   OPUS_CLEAR((char*)governor, sizeof(*governor));
+   governor->refcount = 1;
+   governor->budget = budget;
+   governor->window_start = governor_now_us();
+   if (error) *error = OPUS_OK;
+   return governor;
+}
+
+int opus_dnn_governor_get_stats(const OpusDNNGovernor *governor, OpusDNNGovernorStats *stats)
+{
+   if (governor == NULL || stats == NULL)
+      return OPUS_BAD_ARG;
+   stats->level = governor->level;
+   stats->load = governor->load;
+   stats->decoders = governor->decoders;
+   stats->lace_frames = governor->lace_frames;
+   stats->no_osce_frames = governor->no_osce_frames;
+   stats->classic_plc_frames = governor->classic_plc_frames;
+   return OPUS_OK;
+}
+
+void opus_dnn_governor_destroy(OpusDNNGovernor *governor)
+{
+   governor_unref(governor);
+}
+
+OpusDNNGovernor *dnn_governor_attach(OpusDNNGovernor *governor)
+{
+   if (governor != NULL)
+   {
+      DNN_GOVERNOR_ATOMIC_ADD(&governor->refcount, 1);
+      DNN_GOVERNOR_ATOMIC_ADD(&governor->decoders, 1);
+   }
+   return governor;
+}
+
+void dnn_governor_detach(OpusDNNGovernor *governor)
+{
+   if (governor != NULL)
+   {
+      DNN_GOVERNOR_ATOMIC_ADD(&governor->decoders, -1);
+      governor_unref(governor);
+   }
+}
+
+int dnn_governor_complexity(OpusDNNGovernor *governor, int complexity, int lost, int silk)
+{
+   int max_complexity;
+   max_complexity = governor_max_complexity[governor->level];
+   if (complexity <= max_complexity)
+      return complexity;
+   if (lost)
+   {
+      if (complexity >= 5 && max_complexity < 5)
+         DNN_GOVERNOR_ATOMIC_ADD(&governor->classic_plc_frames, 1);
+   }
+#ifdef ENABLE_OSCE
+   else if (silk)
+   {
+      if (complexity >= 7 && max_complexity == 6)
+         DNN_GOVERNOR_ATOMIC_ADD(&governor->lace_frames, 1);
+      else if (complexity >= 6 && max_complexity < 6)
+         DNN_GOVERNOR_ATOMIC_ADD(&governor->no_osce_frames, 1);
+   }
+#else
+   (void)silk;
+#endif
+   return max_complexity;
+}
+
+void dnn_governor_charge(OpusDNNGovernor *governor, opus_uint64 time_ns)
+{
+   opus_uint32 now, start, elapsed;
+   opus_int32 used;
+   opus_int64 budget;
+   DNN_GOVERNOR_ATOMIC_ADD(&governor->used_us,
+         time_ns >= 1000000000 ? 1000000 : (opus_int32)(time_ns/1000));
+   now = governor_now_us();
+   start = governor->window_start;
+   elapsed = now - start;
+   /* Only the caller that manages to move the window start closes it. */
+   if (elapsed < GOVERNOR_WINDOW_US || !DNN_GOVERNOR_ATOMIC_CAS(&governor->window_start, start, now))
+      return;
+   used = DNN_GOVERNOR_ATOMIC_ADD(&governor->used_us, 0);
+   DNN_GOVERNOR_ATOMIC_ADD(&governor->used_us, -used);
+   /* Windows are longer than nominal when nothing was charged for a while. */
+   budget = (opus_int64)governor->budget*elapsed/1000000;
+   governor->load = (opus_int32)((opus_int64)used*1000000/elapsed);
+   if (used > budget)
+   {
+      governor->calm_windows = 0;
+      if (governor->level < DNN_GOVERNOR_NO_DEEP)
+         governor->level++;
+   } else if (4*(opus_int64)used < 3*budget) {
+      if (governor->level > DNN_GOVERNOR_FULL && ++governor->calm_windows >= GOVERNOR_CALM_WINDOWS)
+      {
+         governor->level--;
+         governor->calm_windows = 0;
+      }
+   } else {
+      governor->calm_windows = 0;
+   }
+}
@@ -0,0 +1,72 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef DNN_GOVERNOR_H
+#define DNN_GOVERNOR_H
+
+#include "opus.h"
+
+/* Degradation levels. Each one caps the effective decoder complexity, which
+   is what gates the neural features in the first place. */
+#define DNN_GOVERNOR_FULL      0  /* No cap */
+#define DNN_GOVERNOR_LACE      1  /* NoLACE replaced by LACE */
+#define DNN_GOVERNOR_NO_OSCE   2  /* OSCE disabled */
+#define DNN_GOVERNOR_NO_DEEP   3  /* Deep PLC replaced by classic PLC */
+
+struct OpusDNNGovernor {
+   int refcount;
+   opus_int32 budget;
+   /* Neural decoding time charged in the current window, in microseconds. */
+   opus_int32 used_us;
+   /* Start of the current window, in microseconds (wraps around). */
+   opus_uint32 window_start;
+   /* Only written by the caller closing a window; stale reads are harmless. */
+   int level;
+   int calm_windows;
+   opus_int32 load;
+   opus_int32 decoders;
+   opus_uint32 lace_frames;
+   opus_uint32 no_osce_frames;
+   opus_uint32 classic_plc_frames;
+};
+
+/* Takes a reference on governor (may be NULL) for a decoder and returns it. */
+OpusDNNGovernor *dnn_governor_attach(OpusDNNGovernor *governor);
+
+/* Drops the reference of a decoder on governor (may be NULL). */
+void dnn_governor_detach(OpusDNNGovernor *governor);
+
+/* Returns the effective complexity of a decoder configured with complexity
+   for one frame, counting the features the governor takes away from it.
+   lost is non-zero for a concealed frame, silk for a frame with a SILK layer. */
+int dnn_governor_complexity(OpusDNNGovernor *governor, int complexity, int lost, int silk);
+
+/* Charges time_ns of neural decoding to governor and updates its level at
+   the end of each window. */
+void dnn_governor_charge(OpusDNNGovernor *governor, opus_uint64 time_ns);
+
+#endif /* DNN_GOVERNOR_H */
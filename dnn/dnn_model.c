@@ -0,0 +1,139 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "dnn_model.h"
+#include "os_support.h"
+#include "plc_data.h"
+#include "fargan_data.h"
+#include "pitchdnn_data.h"
+
+#if defined(__GNUC__) || defined(__clang__)
+# define DNN_MODEL_ATOMIC_ADD(x, v) __atomic_add_fetch((x), (v), __ATOMIC_ACQ_REL)
+#elif defined(_MSC_VER)
+# include <intrin.h>
+# define DNN_MODEL_ATOMIC_ADD(x, v) (_InterlockedExchangeAdd((volatile long*)(x), (v)) + (v))
+#else
+/* No atomics: models must then only be attached/released from one thread. */
+# define DNN_MODEL_ATOMIC_ADD(x, v) (*(x) += (v))
+#endif
+
+static OpusDNNModel *dnn_model_create(const unsigned char *data, opus_int32 len, int copy, int *error)
+{
+   OpusDNNModel *model;
+   WeightArray *list;
+   if (data == NULL || len <= 0)
+   {
+      if (error) *error = OPUS_BAD_ARG;
+      return NULL;
+   }
+   model = (OpusDNNModel *)opus_alloc(sizeof(OpusDNNModel));
+   if (model == NULL)
+   {
+      if (error) *error = OPUS_ALLOC_FAIL;
+      return NULL;
+   }
+   OPUS_CLEAR((char*)model, sizeof(*model));
+   if (copy)
+   {
+      unsigned char *blob;
+      model->blob_alloc = opus_alloc(len + WEIGHT_BLOCK_SIZE - 1);
+      if (model->blob_alloc == NULL)
+      {
+         opus_free(model);
+         if (error) *error = OPUS_ALLOC_FAIL;
+         return NULL;
+      }
+      blob = (unsigned char *)model->blob_alloc;
+      blob += (WEIGHT_BLOCK_SIZE - ((size_t)blob & (WEIGHT_BLOCK_SIZE - 1))) & (WEIGHT_BLOCK_SIZE - 1);
+      OPUS_COPY(blob, data, len);
+      model->blob = blob;
+   } else {
+      model->blob = data;
+   }
+   if (parse_weights(&list, model->blob, len) < 0)
+   {
+      opus_free(model->blob_alloc);
+      opus_free(model);
+      if (error) *error = OPUS_BAD_ARG;
+      return NULL;
+   }
+   /* Each network is optional so that a blob can carry only some of them;
+      attaching a model that lacks a network the instance needs fails there. */
+   model->pitchdnn_loaded = init_pitchdnn(&model->pitchdnn, list) == 0;
+   model->plc_loaded = model->pitchdnn_loaded && init_plcmodel(&model->plc, list) == 0
+         && init_fargan(&model->fargan, list) == 0;
+#ifdef ENABLE_DRED
+   model->rdovae_enc_loaded = model->pitchdnn_loaded && init_rdovaeenc(&model->rdovae_enc, list) == 0;
+   model->rdovae_dec_loaded = init_rdovaedec(&model->rdovae_dec, list) == 0;
+#endif
+#ifdef ENABLE_OSCE
+   model->osce.loaded = osce_init_models(&model->osce, list) == 0;
+#endif
+   opus_free(list);
+   model->refcount = 1;
+   if (error) *error = OPUS_OK;
+   return model;
+}
+
+OpusDNNModel *opus_dnn_model_create(const unsigned char *data, opus_int32 len, int *error)
+{
+   return dnn_model_create(data, len, 1, error);
+}
+
+OpusDNNModel *opus_dnn_model_create_mapped(const unsigned char *data, opus_int32 len, int *error)
+{
+   if (((size_t)data & (WEIGHT_BLOCK_SIZE - 1)) != 0)
+   {
+      if (error) *error = OPUS_BAD_ARG;
+      return NULL;
+   }
+   return dnn_model_create(data, len, 0, error);
+}
+
+void opus_dnn_model_destroy(OpusDNNModel *model)
+{
+   dnn_model_unref(model);
+}
+
+OpusDNNModel *dnn_model_ref(OpusDNNModel *model)
+{
+   if (model != NULL)
+      DNN_MODEL_ATOMIC_ADD(&model->refcount, 1);
+   return model;
+}
+
+void dnn_model_unref(OpusDNNModel *model)
+{
+   if (model != NULL && DNN_MODEL_ATOMIC_ADD(&model->refcount, -1) == 0)
+   {
+      opus_free(model->blob_alloc);
+      opus_free(model);
+   }
+}
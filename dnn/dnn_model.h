@@ -0,0 +1,74 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef DNN_MODEL_H
+#define DNN_MODEL_H
+
+#include "opus.h"
+#include "nnet.h"
+#include "lpcnet_private.h"
+#ifdef ENABLE_DRED
+#include "dred_rdovae_enc.h"
+#include "dred_rdovae_dec.h"
+#include "dred_rdovae_enc_data.h"
+#include "dred_rdovae_dec_data.h"
+#endif
+#ifdef ENABLE_OSCE
+#include "osce.h"
+#endif
+
+/* Layer tables parsed once from a weights blob and shared (read-only) by any
+   number of encoders and decoders. The blob is copied, to a
+   WEIGHT_BLOCK_SIZE-aligned address, so that the weights the tables point to
+   live as long as the model, unless it was created with
+   opus_dnn_model_create_mapped(), in which case blob_alloc is NULL. */
+struct OpusDNNModel {
+   int refcount;
+   const unsigned char *blob;
+   void *blob_alloc;
+   int pitchdnn_loaded;
+   PitchDNN pitchdnn;
+   int plc_loaded;
+   PLCModel plc;
+   FARGAN fargan;
+#ifdef ENABLE_DRED
+   int rdovae_enc_loaded;
+   RDOVAEEnc rdovae_enc;
+   int rdovae_dec_loaded;
+   RDOVAEDec rdovae_dec;
+#endif
+#ifdef ENABLE_OSCE
+   OSCEModel osce;
+#endif
+};
+
+/* Takes a reference on model (may be NULL) and returns it. */
+OpusDNNModel *dnn_model_ref(OpusDNNModel *model);
+
+/* Drops a reference on model (may be NULL), freeing it with the last one. */
+void dnn_model_unref(OpusDNNModel *model);
+
+#endif /* DNN_MODEL_H */
@@ -31,16 +31,21 @@
 #include "opus.h"
 #include "dred_config.h"
 #include "dred_rdovae.h"
+#include "dred_rdovae_dec.h"
 #include "entcode.h"
 #include "dred_rdovae_constants.h"
 
 struct OpusDRED {
-    float        fec_features[2*DRED_NUM_REDUNDANCY_FRAMES*DRED_NUM_FEATURES];
     float        state[DRED_STATE_DIM];
     float        latents[(DRED_NUM_REDUNDANCY_FRAMES/2)*DRED_LATENT_DIM];
     int          nb_latents;
     int          process_stage;
     int          dred_offset;
+    /* Copied by opus_dred_process() for opus_decoder_dred_decode(), which
+       decodes the features itself, so that the packet no longer refers to the
+       DRED decoder. */
+    RDOVAEDec    model;
+    int          arch;
 };
 
 
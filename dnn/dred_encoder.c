@@ -45,6 +45,7 @@
 #include "os_support.h"
 #include "celt/laplace.h"
 #include "dred_rdovae_stats_data.h"
+#include "dnn_model.h"
 
 
 static void DRED_rdovae_init_encoder(RDOVAEEncState *enc_state)
@@ -62,17 +63,45 @@ int dred_encoder_load_model(DREDEnc* enc, const void *data, int len)
     if (ret == 0) {
       ret = lpcnet_encoder_load_model(&enc->lpcnet_enc_state, data, len);
     }
-    if (ret == 0) enc->loaded = 1;
+    if (ret == 0) {
+      enc->loaded = 1;
+      enc->shared_model = NULL;
+      enc->lpcnet_enc_state.pitchdnn.shared_model = NULL;
+    }
     return (ret == 0) ? OPUS_OK : OPUS_BAD_ARG;
 }
 
+int dred_encoder_set_model(DREDEnc* enc, const OpusDNNModel *model)
+{
+    if (model == NULL)
+    {
+        enc->shared_model = NULL;
+        enc->lpcnet_enc_state.pitchdnn.shared_model = NULL;
+        enc->loaded = 0;
+#ifndef USE_WEIGHTS_FILE
+        if (init_rdovaeenc(&enc->model, rdovaeenc_arrays) == 0 &&
+            init_pitchdnn(&enc->lpcnet_enc_state.pitchdnn.model, pitchdnn_arrays) == 0) enc->loaded = 1;
+#endif
+        return OPUS_OK;
+    }
+    if (!model->rdovae_enc_loaded) return OPUS_BAD_ARG;
+    enc->shared_model = &model->rdovae_enc;
+    enc->lpcnet_enc_state.pitchdnn.shared_model = &model->pitchdnn;
+    enc->loaded = 1;
+    return OPUS_OK;
+}
+
 void dred_encoder_reset(DREDEnc* enc)
 {
+    const PitchDNN *pitchdnn_model;
     OPUS_CLEAR((char*)&enc->DREDENC_RESET_START,
               sizeof(DREDEnc)-
               ((char*)&enc->DREDENC_RESET_START - (char*)enc));
     enc->input_buffer_fill = DRED_SILK_ENCODER_DELAY;
+    /* Keep the attached model across the encoder reinitialization. */
+    pitchdnn_model = enc->lpcnet_enc_state.pitchdnn.shared_model;
     lpcnet_encoder_init(&enc->lpcnet_enc_state);
+    enc->lpcnet_enc_state.pitchdnn.shared_model = pitchdnn_model;
     DRED_rdovae_init_encoder(&enc->rdovae_enc);
 }
 
@@ -81,21 +110,23 @@ void dred_encoder_init(DREDEnc* enc, opus_int32 Fs, int channels)
     enc->Fs = Fs;
     enc->channels = channels;
     enc->loaded = 0;
+    enc->shared_model = NULL;
+    enc->lpcnet_enc_state.pitchdnn.shared_model = NULL;
 #ifndef USE_WEIGHTS_FILE
     if (init_rdovaeenc(&enc->model, rdovaeenc_arrays) == 0) enc->loaded = 1;
 #endif
     dred_encoder_reset(enc);
 }
 
-static void dred_process_frame(DREDEnc *enc, int arch)
+/* Computes the RDOVAE encoder input for the double frame at the start of
+   input_buffer. The encoder itself runs once per call to
+   dred_compute_latents_16k(), on all the double frames at once. */
+static void dred_process_frame(DREDEnc *enc, float *input_buffer, int arch)
 {
     float feature_buffer[2 * 36];
-    float input_buffer[2*DRED_NUM_FEATURES] = {0};
 
     celt_assert(enc->loaded);
-    /* shift latents buffer */
-    OPUS_MOVE(enc->latents_buffer + DRED_LATENT_DIM, enc->latents_buffer, (DRED_MAX_FRAMES - 1) * DRED_LATENT_DIM);
-    OPUS_MOVE(enc->state_buffer + DRED_STATE_DIM, enc->state_buffer, (DRED_MAX_FRAMES - 1) * DRED_STATE_DIM);
+    celt_assert(enc->nb_pending < DRED_MAX_PENDING);
 
     /* calculate LPCNet features */
     lpcnet_compute_single_frame_features_float(&enc->lpcnet_enc_state, enc->input_buffer, feature_buffer, arch);
@@ -104,10 +135,7 @@ static void dred_process_frame(DREDEnc *enc, int arch)
     /* prepare input buffer (discard LPC coefficients) */
     OPUS_COPY(input_buffer, feature_buffer, DRED_NUM_FEATURES);
     OPUS_COPY(input_buffer + DRED_NUM_FEATURES, feature_buffer + 36, DRED_NUM_FEATURES);
-
-    /* run RDOVAE encoder */
-    dred_rdovae_encode_dframe(&enc->rdovae_enc, &enc->model, enc->latents_buffer, enc->state_buffer, input_buffer, arch);
-    enc->latents_buffer_fill = IMIN(enc->latents_buffer_fill+1, DRED_NUM_REDUNDANCY_FRAMES);
+    enc->nb_pending++;
 }
 
 void filter_df2t(const float *in, float *out, int len, float b0, const float *b, const float *a, int order, float *mem)
@@ -189,38 +217,86 @@ static void dred_convert_to_16k(DREDEnc *enc, const float *in, int in_len, float
     }
 }
 
-void dred_compute_latents(DREDEnc *enc, const float *pcm, int frame_size, int extra_delay, int arch)
+int dred_convert_frame_to_16k(DREDEnc *enc, const float *pcm, int frame_size, float *pcm16k)
 {
-    int curr_offset16k;
     int frame_size16k = frame_size * 16000 / enc->Fs;
+    int remaining16k = frame_size16k;
+    celt_assert(frame_size16k <= DRED_MAX_FRAME_SIZE16K);
+    /* Same chunks as the double frames, to keep the downmix buffer small. */
+    while (remaining16k > 0) {
+        int process_size16k;
+        int process_size;
+        process_size16k = IMIN(2*DRED_FRAME_SIZE, remaining16k);
+        process_size = process_size16k * enc->Fs / 16000;
+        dred_convert_to_16k(enc, pcm, process_size, pcm16k, process_size16k);
+        pcm += process_size;
+        pcm16k += process_size16k;
+        remaining16k -= process_size16k;
+    }
+    return frame_size16k;
+}
+
+void dred_compute_latents_16k(DREDEnc *enc, const float *pcm16k, int frame_size16k, int extra_delay, int arch)
+{
+    float input_buffer[DRED_MAX_PENDING*2*DRED_NUM_FEATURES];
+    int curr_offset16k;
     celt_assert(enc->loaded);
     curr_offset16k = 40 + extra_delay*16000/enc->Fs - enc->input_buffer_fill;
-    enc->dred_offset = (int)floor((curr_offset16k+20.f)/40.f);
-    enc->latent_offset = 0;
+    enc->pending_dred_offset = (int)floor((curr_offset16k+20.f)/40.f);
+    enc->pending_latent_offset = 0;
+    enc->nb_pending = 0;
     while (frame_size16k > 0) {
         int process_size16k;
-        int process_size;
         process_size16k = IMIN(2*DRED_FRAME_SIZE, frame_size16k);
-        process_size = process_size16k * enc->Fs / 16000;
-        dred_convert_to_16k(enc, pcm, process_size, &enc->input_buffer[enc->input_buffer_fill], process_size16k);
+        OPUS_COPY(&enc->input_buffer[enc->input_buffer_fill], pcm16k, process_size16k);
         enc->input_buffer_fill += process_size16k;
         if (enc->input_buffer_fill >= 2*DRED_FRAME_SIZE)
         {
-            curr_offset16k += 320;
-            dred_process_frame(enc, arch);
+            dred_process_frame(enc, &input_buffer[enc->nb_pending*2*DRED_NUM_FEATURES], arch);
             enc->input_buffer_fill -= 2*DRED_FRAME_SIZE;
             OPUS_MOVE(&enc->input_buffer[0], &enc->input_buffer[2*DRED_FRAME_SIZE], enc->input_buffer_fill);
             /* 15 ms (6*2.5 ms) is the ideal offset for DRED because it corresponds to our vocoder look-ahead. */
-            if (enc->dred_offset < 6) {
-                enc->dred_offset += 8;
+            if (enc->pending_dred_offset < 6) {
+                enc->pending_dred_offset += 8;
             } else {
-                enc->latent_offset++;
+                enc->pending_latent_offset++;
             }
         }
 
-        pcm += process_size;
+        pcm16k += process_size16k;
         frame_size16k -= process_size16k;
     }
+    /* run RDOVAE encoder */
+    if (enc->nb_pending > 0) {
+        dred_rdovae_encode_dframes(&enc->rdovae_enc, enc->shared_model ? enc->shared_model : &enc->model, enc->pending_latents, enc->pending_state,
+                                   input_buffer, enc->nb_pending, arch);
+    }
+}
+
+void dred_commit_latents(DREDEnc *enc, int delay)
+{
+    int i;
+    int n = enc->nb_pending;
+    /* shift latents buffer */
+    OPUS_MOVE(enc->latents_buffer + n*DRED_LATENT_DIM, enc->latents_buffer, (DRED_MAX_FRAMES - n) * DRED_LATENT_DIM);
+    OPUS_MOVE(enc->state_buffer + n*DRED_STATE_DIM, enc->state_buffer, (DRED_MAX_FRAMES - n) * DRED_STATE_DIM);
+    for (i=0;i<n;i++) {
+        OPUS_COPY(&enc->latents_buffer[(n-1-i)*DRED_LATENT_DIM], &enc->pending_latents[i*DRED_LATENT_DIM], DRED_LATENT_DIM);
+        OPUS_COPY(&enc->state_buffer[(n-1-i)*DRED_STATE_DIM], &enc->pending_state[i*DRED_STATE_DIM], DRED_STATE_DIM);
+    }
+    enc->latents_buffer_fill = IMIN(enc->latents_buffer_fill+n, DRED_NUM_REDUNDANCY_FRAMES);
+    enc->dred_offset = enc->pending_dred_offset - delay;
+    enc->latent_offset = enc->pending_latent_offset;
+    enc->nb_pending = 0;
+}
+
+void dred_compute_latents(DREDEnc *enc, const float *pcm, int frame_size, int extra_delay, int arch)
+{
+    float pcm16k[DRED_MAX_FRAME_SIZE16K];
+    int frame_size16k;
+    frame_size16k = dred_convert_frame_to_16k(enc, pcm, frame_size, pcm16k);
+    dred_compute_latents_16k(enc, pcm16k, frame_size16k, extra_delay, arch);
+    dred_commit_latents(enc, 0);
 }
 
 static void dred_encode_latents(ec_enc *enc, const float *x, const opus_uint8 *scale, const opus_uint8 *dzone, const opus_uint8 *r, const opus_uint8 *p0, int dim, int arch) {
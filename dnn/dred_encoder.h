@@ -38,8 +38,15 @@
 
 #define RESAMPLING_ORDER 8
 
+/* Largest frame given to dred_compute_latents() (60 ms), and the most double
+   frames of latents it can then produce. */
+#define DRED_MAX_FRAME_SIZE16K 960
+#define DRED_MAX_PENDING (DRED_MAX_FRAME_SIZE16K/DRED_DFRAME_SIZE)
+
 typedef struct {
     RDOVAEEnc model;
+    /* Tables of an attached OpusDNNModel, used instead of model when set. */
+    const RDOVAEEnc *shared_model;
     LPCNetEncState lpcnet_enc_state;
     RDOVAEEncState rdovae_enc;
     int loaded;
@@ -56,9 +63,18 @@ typedef struct {
     int latents_buffer_fill;
     float state_buffer[DRED_MAX_FRAMES * DRED_STATE_DIM];
     float resample_mem[RESAMPLING_ORDER + 1];
+    /* Output of dred_compute_latents_16k(), oldest first, until
+       dred_commit_latents() adds it to latents_buffer. */
+    float pending_latents[DRED_MAX_PENDING * DRED_LATENT_DIM];
+    float pending_state[DRED_MAX_PENDING * DRED_STATE_DIM];
+    int nb_pending;
+    int pending_dred_offset;
+    int pending_latent_offset;
 } DREDEnc;
 
 int dred_encoder_load_model(DREDEnc* enc, const void *data, int len);
+struct OpusDNNModel;
+int dred_encoder_set_model(DREDEnc* enc, const struct OpusDNNModel *model);
 void dred_encoder_init(DREDEnc* enc, opus_int32 Fs, int channels);
 void dred_encoder_reset(DREDEnc* enc);
 
@@ -66,6 +82,15 @@ void dred_deinit_encoder(DREDEnc *enc);
 
 void dred_compute_latents(DREDEnc *enc, const float *pcm, int frame_size, int extra_delay, int arch);
 
+/* dred_compute_latents() in three steps, so that the second one can run on
+   another thread. Only the first and last use the fields of enc read by
+   dred_encode_silk_frame(), and only the second uses the feature and RDOVAE
+   encoder states. delay is how much older (in 2.5 ms units) the latents are
+   than the frame dred_encode_silk_frame() is called for next. */
+int dred_convert_frame_to_16k(DREDEnc *enc, const float *pcm, int frame_size, float *pcm16k);
+void dred_compute_latents_16k(DREDEnc *enc, const float *pcm16k, int frame_size16k, int extra_delay, int arch);
+void dred_commit_latents(DREDEnc *enc, int delay);
+
 int dred_encode_silk_frame(DREDEnc *enc, unsigned char *buf, int max_chunks, int max_bytes, int q0, int dQ, int qmax, unsigned char *activity_mem, int arch);
 
 #endif
@@ -32,6 +32,7 @@
 #include "dred_rdovae_dec.h"
 #include "dred_rdovae_constants.h"
 #include "os_support.h"
+#include "arch.h"
 
 static void conv1_cond_init(float *mem, int len, int dilation, int *init)
 {
@@ -42,23 +43,31 @@ static void conv1_cond_init(float *mem, int len, int dilation, int *init)
     *init = 1;
 }
 
-void DRED_rdovae_decode_all(const RDOVAEDec *model, float *features, const float *state, const float *latents, int nb_latents, int arch)
+void DRED_rdovae_decode_range(RDOVAEDecState *dec, const RDOVAEDec *model, float *features, const float *state, const float *latents, int start, int end, int arch)
 {
-    int i;
-    RDOVAEDecState dec;
-    memset(&dec, 0, sizeof(dec));
-    dred_rdovae_dec_init_states(&dec, model, state, arch);
-    for (i = 0; i < 2*nb_latents; i += 2)
+    if (start == 0)
+    {
+        memset(dec, 0, sizeof(*dec));
+        dred_rdovae_dec_init_states(dec, model, state, arch);
+    }
+    if (end > start)
     {
-        dred_rdovae_decode_qframe(
-            &dec,
+        dred_rdovae_decode_qframes(
+            dec,
             model,
-            &features[2*i*DRED_NUM_FEATURES],
-            &latents[(i/2)*DRED_LATENT_DIM],
+            &features[4*start*DRED_NUM_FEATURES],
+            &latents[start*DRED_LATENT_DIM],
+            end - start,
             arch);
     }
 }
 
+void DRED_rdovae_decode_all(const RDOVAEDec *model, float *features, const float *state, const float *latents, int nb_latents, int arch)
+{
+    RDOVAEDecState dec;
+    DRED_rdovae_decode_range(&dec, model, features, state, latents, 0, nb_latents, arch);
+}
+
 void dred_rdovae_dec_init_states(
     RDOVAEDecState *h,            /* io: state buffer handle */
     const RDOVAEDec *model,
@@ -84,6 +93,104 @@ void dred_rdovae_dec_init_states(
 }
 
 
+#define DEC_BUFFER_SIZE (DEC_DENSE1_OUT_SIZE + DEC_GRU1_OUT_SIZE + DEC_GRU2_OUT_SIZE + DEC_GRU3_OUT_SIZE + DEC_GRU4_OUT_SIZE + DEC_GRU5_OUT_SIZE \
+                 + DEC_CONV1_OUT_SIZE + DEC_CONV2_OUT_SIZE + DEC_CONV3_OUT_SIZE + DEC_CONV4_OUT_SIZE + DEC_CONV5_OUT_SIZE)
+
+/* Copies the first size values of the nb frame buffers (DEC_BUFFER_SIZE apart)
+   to in, contiguously. */
+static void gather_frames(float *in, const float *buffer, int size, int nb)
+{
+    int k;
+    for (k=0;k<nb;k++) OPUS_COPY(&in[k*size], &buffer[k*DEC_BUFFER_SIZE], size);
+}
+
+static void scatter_frames(float *buffer, const float *out, int size, int nb)
+{
+    int k;
+    for (k=0;k<nb;k++) OPUS_COPY(&buffer[k*DEC_BUFFER_SIZE], &out[k*size], size);
+}
+
+/* Runs one GRU + GLU + conv stage of the decoder over nb frames, appending its
+   outputs to each frame buffer at *output_index. */
+static void decode_stage(
+    RDOVAEDecState *dec_state,
+    const LinearLayer *gru_input,
+    const LinearLayer *gru_recurrent,
+    const LinearLayer *glu,
+    const LinearLayer *conv,
+    float *gru_state,
+    float *conv_state,
+    float *buffer,
+    int *output_index,
+    int nb,
+    int arch
+    )
+{
+    float in[DNN_MAX_BATCH*DEC_BUFFER_SIZE];
+    float states[DNN_MAX_BATCH*DRED_MAX_RNN_NEURONS];
+    float out[DNN_MAX_BATCH*DRED_MAX_RNN_NEURONS];
+    int N = gru_recurrent->nb_inputs;
+    celt_assert(nb <= DNN_MAX_BATCH);
+    celt_assert(N <= DRED_MAX_RNN_NEURONS && conv->nb_outputs <= DRED_MAX_RNN_NEURONS);
+
+    gather_frames(in, buffer, *output_index, nb);
+    compute_generic_gru_seq(gru_input, gru_recurrent, gru_state, states, in, nb, arch);
+    compute_glu_batch(glu, out, states, nb, arch);
+    scatter_frames(&buffer[*output_index], out, N, nb);
+    *output_index += N;
+
+    conv1_cond_init(conv_state, *output_index, 1, &dec_state->initialized);
+    gather_frames(in, buffer, *output_index, nb);
+    compute_generic_conv1d_seq(conv, out, conv_state, in, *output_index, 1, nb, ACTIVATION_TANH, arch);
+    scatter_frames(&buffer[*output_index], out, conv->nb_outputs, nb);
+    *output_index += conv->nb_outputs;
+}
+
+/* Decodes nb consecutive latent vectors into nb quadruple feature frames. Each
+   layer is run over a batch of frames before moving on to the next, so that
+   everything but the recurrent products shares passes over the weights. Same
+   result as one dred_rdovae_decode_qframe() call per latent vector. */
+void dred_rdovae_decode_qframes(
+    RDOVAEDecState *dec_state,       /* io: state buffer handle */
+    const RDOVAEDec *model,
+    float *qframes,             /* o: nb quadruple feature frames */
+    const float *inputs,         /* i: nb latent vectors */
+    int nb,
+    int arch
+    )
+{
+    float buffer[DNN_MAX_BATCH*DEC_BUFFER_SIZE];
+    int k0;
+    celt_assert(model->dec_dense1.nb_inputs == DRED_LATENT_DIM);
+    celt_assert(model->dec_output.nb_outputs == 4*DRED_NUM_FEATURES);
+
+    for (k0=0;k0<nb;k0+=DNN_MAX_BATCH)
+    {
+        float dense1[DNN_MAX_BATCH*DEC_DENSE1_OUT_SIZE];
+        int n = IMIN(DNN_MAX_BATCH, nb-k0);
+        int output_index = 0;
+
+        /* run decoder stack and concatenate output in buffer*/
+        compute_generic_dense_batch(&model->dec_dense1, dense1, &inputs[k0*DRED_LATENT_DIM], n, ACTIVATION_TANH, arch);
+        scatter_frames(buffer, dense1, DEC_DENSE1_OUT_SIZE, n);
+        output_index += DEC_DENSE1_OUT_SIZE;
+
+        decode_stage(dec_state, &model->dec_gru1_input, &model->dec_gru1_recurrent, &model->dec_glu1, &model->dec_conv1,
+                     dec_state->gru1_state, dec_state->conv1_state, buffer, &output_index, n, arch);
+        decode_stage(dec_state, &model->dec_gru2_input, &model->dec_gru2_recurrent, &model->dec_glu2, &model->dec_conv2,
+                     dec_state->gru2_state, dec_state->conv2_state, buffer, &output_index, n, arch);
+        decode_stage(dec_state, &model->dec_gru3_input, &model->dec_gru3_recurrent, &model->dec_glu3, &model->dec_conv3,
+                     dec_state->gru3_state, dec_state->conv3_state, buffer, &output_index, n, arch);
+        decode_stage(dec_state, &model->dec_gru4_input, &model->dec_gru4_recurrent, &model->dec_glu4, &model->dec_conv4,
+                     dec_state->gru4_state, dec_state->conv4_state, buffer, &output_index, n, arch);
+        decode_stage(dec_state, &model->dec_gru5_input, &model->dec_gru5_recurrent, &model->dec_glu5, &model->dec_conv5,
+                     dec_state->gru5_state, dec_state->conv5_state, buffer, &output_index, n, arch);
+        celt_assert(output_index == DEC_BUFFER_SIZE);
+
+        compute_generic_dense_batch(&model->dec_output, &qframes[4*k0*DRED_NUM_FEATURES], buffer, n, ACTIVATION_LINEAR, arch);
+    }
+}
+
 void dred_rdovae_decode_qframe(
     RDOVAEDecState *dec_state,       /* io: state buffer handle */
     const RDOVAEDec *model,
@@ -92,48 +199,5 @@ void dred_rdovae_decode_qframe(
     int arch
     )
 {
-    float buffer[DEC_DENSE1_OUT_SIZE + DEC_GRU1_OUT_SIZE + DEC_GRU2_OUT_SIZE + DEC_GRU3_OUT_SIZE + DEC_GRU4_OUT_SIZE + DEC_GRU5_OUT_SIZE
-                 + DEC_CONV1_OUT_SIZE + DEC_CONV2_OUT_SIZE + DEC_CONV3_OUT_SIZE + DEC_CONV4_OUT_SIZE + DEC_CONV5_OUT_SIZE];
-    int output_index = 0;
-
-    /* run encoder stack and concatenate output in buffer*/
-    compute_generic_dense(&model->dec_dense1, &buffer[output_index], input, ACTIVATION_TANH, arch);
-    output_index += DEC_DENSE1_OUT_SIZE;
-
-    compute_generic_gru(&model->dec_gru1_input, &model->dec_gru1_recurrent, dec_state->gru1_state, buffer, arch);
-    compute_glu(&model->dec_glu1, &buffer[output_index], dec_state->gru1_state, arch);
-    output_index += DEC_GRU1_OUT_SIZE;
-    conv1_cond_init(dec_state->conv1_state, output_index, 1, &dec_state->initialized);
-    compute_generic_conv1d(&model->dec_conv1, &buffer[output_index], dec_state->conv1_state, buffer, output_index, ACTIVATION_TANH, arch);
-    output_index += DEC_CONV1_OUT_SIZE;
-
-    compute_generic_gru(&model->dec_gru2_input, &model->dec_gru2_recurrent, dec_state->gru2_state, buffer, arch);
-    compute_glu(&model->dec_glu2, &buffer[output_index], dec_state->gru2_state, arch);
-    output_index += DEC_GRU2_OUT_SIZE;
-    conv1_cond_init(dec_state->conv2_state, output_index, 1, &dec_state->initialized);
-    compute_generic_conv1d(&model->dec_conv2, &buffer[output_index], dec_state->conv2_state, buffer, output_index, ACTIVATION_TANH, arch);
-    output_index += DEC_CONV2_OUT_SIZE;
-
-    compute_generic_gru(&model->dec_gru3_input, &model->dec_gru3_recurrent, dec_state->gru3_state, buffer, arch);
-    compute_glu(&model->dec_glu3, &buffer[output_index], dec_state->gru3_state, arch);
-    output_index += DEC_GRU3_OUT_SIZE;
-    conv1_cond_init(dec_state->conv3_state, output_index, 1, &dec_state->initialized);
-    compute_generic_conv1d(&model->dec_conv3, &buffer[output_index], dec_state->conv3_state, buffer, output_index, ACTIVATION_TANH, arch);
-    output_index += DEC_CONV3_OUT_SIZE;
-
-    compute_generic_gru(&model->dec_gru4_input, &model->dec_gru4_recurrent, dec_state->gru4_state, buffer, arch);
-    compute_glu(&model->dec_glu4, &buffer[output_index], dec_state->gru4_state, arch);
-    output_index += DEC_GRU4_OUT_SIZE;
-    conv1_cond_init(dec_state->conv4_state, output_index, 1, &dec_state->initialized);
-    compute_generic_conv1d(&model->dec_conv4, &buffer[output_index], dec_state->conv4_state, buffer, output_index, ACTIVATION_TANH, arch);
-    output_index += DEC_CONV4_OUT_SIZE;
-
-    compute_generic_gru(&model->dec_gru5_input, &model->dec_gru5_recurrent, dec_state->gru5_state, buffer, arch);
-    compute_glu(&model->dec_glu5, &buffer[output_index], dec_state->gru5_state, arch);
-    output_index += DEC_GRU5_OUT_SIZE;
-    conv1_cond_init(dec_state->conv5_state, output_index, 1, &dec_state->initialized);
-    compute_generic_conv1d(&model->dec_conv5, &buffer[output_index], dec_state->conv5_state, buffer, output_index, ACTIVATION_TANH, arch);
-    output_index += DEC_CONV5_OUT_SIZE;
-
-    compute_generic_dense(&model->dec_output, qframe, buffer, ACTIVATION_LINEAR, arch);
+    dred_rdovae_decode_qframes(dec_state, model, qframe, input, 1, arch);
 }
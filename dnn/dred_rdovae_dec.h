@@ -48,6 +48,8 @@ struct RDOVAEDecStruct {
 
 void dred_rdovae_dec_init_states(RDOVAEDecState *h, const RDOVAEDec *model, const float * initial_state, int arch);
 void dred_rdovae_decode_qframe(RDOVAEDecState *h, const RDOVAEDec *model, float *qframe, const float * z, int arch);
+void dred_rdovae_decode_qframes(RDOVAEDecState *h, const RDOVAEDec *model, float *qframes, const float *z, int nb, int arch);
+void DRED_rdovae_decode_range(RDOVAEDecState *dec, const RDOVAEDec *model, float *features, const float *state, const float *latents, int start, int end, int arch);
 void DRED_rdovae_decode_all(const RDOVAEDec *model, float *features, const float *state, const float *latents, int nb_latents, int arch);
 
 #endif
@@ -34,6 +34,7 @@
 
 #include "dred_rdovae_enc.h"
 #include "os_support.h"
+#include "arch.h"
 #include "dred_rdovae_constants.h"
 
 static void conv1_cond_init(float *mem, int len, int dilation, int *init)
@@ -45,6 +46,115 @@ static void conv1_cond_init(float *mem, int len, int dilation, int *init)
     *init = 1;
 }
 
+#define ENC_BUFFER_SIZE (ENC_DENSE1_OUT_SIZE + ENC_GRU1_OUT_SIZE + ENC_GRU2_OUT_SIZE + ENC_GRU3_OUT_SIZE + ENC_GRU4_OUT_SIZE + ENC_GRU5_OUT_SIZE \
+               + ENC_CONV1_OUT_SIZE + ENC_CONV2_OUT_SIZE + ENC_CONV3_OUT_SIZE + ENC_CONV4_OUT_SIZE + ENC_CONV5_OUT_SIZE)
+
+/* Copies the first size values of the nb frame buffers (ENC_BUFFER_SIZE apart)
+   to in, contiguously. */
+static void gather_frames(float *in, const float *buffer, int size, int nb)
+{
+    int k;
+    for (k=0;k<nb;k++) OPUS_COPY(&in[k*size], &buffer[k*ENC_BUFFER_SIZE], size);
+}
+
+static void scatter_frames(float *buffer, const float *out, int size, int nb)
+{
+    int k;
+    for (k=0;k<nb;k++) OPUS_COPY(&buffer[k*ENC_BUFFER_SIZE], &out[k*size], size);
+}
+
+/* Runs one GRU + conv stage of the encoder over nb frames, appending its
+   outputs to each frame buffer at *output_index. */
+static void encode_stage(
+    RDOVAEEncState *enc_state,
+    const LinearLayer *gru_input,
+    const LinearLayer *gru_recurrent,
+    const LinearLayer *conv,
+    int dilation,
+    float *gru_state,
+    float *conv_state,
+    float *buffer,
+    int *output_index,
+    int nb,
+    int arch
+    )
+{
+    float in[DNN_MAX_BATCH*ENC_BUFFER_SIZE];
+    float out[DNN_MAX_BATCH*DRED_MAX_RNN_NEURONS];
+    int N = gru_recurrent->nb_inputs;
+    celt_assert(nb <= DNN_MAX_BATCH);
+    celt_assert(N <= DRED_MAX_RNN_NEURONS && conv->nb_outputs <= DRED_MAX_RNN_NEURONS);
+
+    gather_frames(in, buffer, *output_index, nb);
+    compute_generic_gru_seq(gru_input, gru_recurrent, gru_state, out, in, nb, arch);
+    scatter_frames(&buffer[*output_index], out, N, nb);
+    *output_index += N;
+
+    conv1_cond_init(conv_state, *output_index, dilation, &enc_state->initialized);
+    gather_frames(in, buffer, *output_index, nb);
+    compute_generic_conv1d_seq(conv, out, conv_state, in, *output_index, dilation, nb, ACTIVATION_TANH, arch);
+    scatter_frames(&buffer[*output_index], out, conv->nb_outputs, nb);
+    *output_index += conv->nb_outputs;
+}
+
+/* Encodes nb consecutive double feature frames. Each layer is run over a batch
+   of frames before moving on to the next, so that everything but the recurrent
+   products shares passes over the weights. Same result as one
+   dred_rdovae_encode_dframe() call per double frame. */
+void dred_rdovae_encode_dframes(
+    RDOVAEEncState *enc_state,           /* io: encoder state */
+    const RDOVAEEnc *model,
+    float *latents,                 /* o: nb latent vectors */
+    float *initial_states,          /* o: nb initial states */
+    const float *inputs,             /* i: nb double feature frames (concatenated) */
+    int nb,
+    int arch
+    )
+{
+    float buffer[DNN_MAX_BATCH*ENC_BUFFER_SIZE];
+    int k0;
+    celt_assert(model->enc_dense1.nb_inputs == 2*DRED_NUM_FEATURES);
+
+    for (k0=0;k0<nb;k0+=DNN_MAX_BATCH)
+    {
+        float dense1[DNN_MAX_BATCH*ENC_DENSE1_OUT_SIZE];
+        float padded_latents[DNN_MAX_BATCH*DRED_PADDED_LATENT_DIM];
+        float padded_state[DNN_MAX_BATCH*DRED_PADDED_STATE_DIM];
+        float state_hidden[DNN_MAX_BATCH*GDENSE1_OUT_SIZE];
+        int n = IMIN(DNN_MAX_BATCH, nb-k0);
+        int output_index = 0;
+        int k;
+
+        /* run encoder stack and concatenate output in buffer*/
+        compute_generic_dense_batch(&model->enc_dense1, dense1, &inputs[k0*2*DRED_NUM_FEATURES], n, ACTIVATION_TANH, arch);
+        scatter_frames(buffer, dense1, ENC_DENSE1_OUT_SIZE, n);
+        output_index += ENC_DENSE1_OUT_SIZE;
+
+        encode_stage(enc_state, &model->enc_gru1_input, &model->enc_gru1_recurrent, &model->enc_conv1, 1,
+                     enc_state->gru1_state, enc_state->conv1_state, buffer, &output_index, n, arch);
+        encode_stage(enc_state, &model->enc_gru2_input, &model->enc_gru2_recurrent, &model->enc_conv2, 2,
+                     enc_state->gru2_state, enc_state->conv2_state, buffer, &output_index, n, arch);
+        encode_stage(enc_state, &model->enc_gru3_input, &model->enc_gru3_recurrent, &model->enc_conv3, 2,
+                     enc_state->gru3_state, enc_state->conv3_state, buffer, &output_index, n, arch);
+        encode_stage(enc_state, &model->enc_gru4_input, &model->enc_gru4_recurrent, &model->enc_conv4, 2,
+                     enc_state->gru4_state, enc_state->conv4_state, buffer, &output_index, n, arch);
+        encode_stage(enc_state, &model->enc_gru5_input, &model->enc_gru5_recurrent, &model->enc_conv5, 2,
+                     enc_state->gru5_state, enc_state->conv5_state, buffer, &output_index, n, arch);
+        celt_assert(output_index == ENC_BUFFER_SIZE);
+
+        compute_generic_dense_batch(&model->enc_zdense, padded_latents, buffer, n, ACTIVATION_LINEAR, arch);
+
+        /* next, calculate initial state */
+        compute_generic_dense_batch(&model->gdense1, state_hidden, buffer, n, ACTIVATION_TANH, arch);
+        compute_generic_dense_batch(&model->gdense2, padded_state, state_hidden, n, ACTIVATION_LINEAR, arch);
+        for (k=0;k<n;k++)
+        {
+            OPUS_COPY(&latents[(k0+k)*DRED_LATENT_DIM], &padded_latents[k*DRED_PADDED_LATENT_DIM], DRED_LATENT_DIM);
+            OPUS_COPY(&initial_states[(k0+k)*DRED_STATE_DIM], &padded_state[k*DRED_PADDED_STATE_DIM], DRED_STATE_DIM);
+        }
+    }
+}
+
 void dred_rdovae_encode_dframe(
     RDOVAEEncState *enc_state,           /* io: encoder state */
     const RDOVAEEnc *model,
@@ -54,57 +164,5 @@ void dred_rdovae_encode_dframe(
     int arch
     )
 {
-    float padded_latents[DRED_PADDED_LATENT_DIM];
-    float padded_state[DRED_PADDED_STATE_DIM];
-    float buffer[ENC_DENSE1_OUT_SIZE + ENC_GRU1_OUT_SIZE + ENC_GRU2_OUT_SIZE + ENC_GRU3_OUT_SIZE + ENC_GRU4_OUT_SIZE + ENC_GRU5_OUT_SIZE
-               + ENC_CONV1_OUT_SIZE + ENC_CONV2_OUT_SIZE + ENC_CONV3_OUT_SIZE + ENC_CONV4_OUT_SIZE + ENC_CONV5_OUT_SIZE];
-    float state_hidden[GDENSE1_OUT_SIZE];
-    int output_index = 0;
-
-    /* run encoder stack and concatenate output in buffer*/
-    compute_generic_dense(&model->enc_dense1, &buffer[output_index], input, ACTIVATION_TANH, arch);
-    output_index += ENC_DENSE1_OUT_SIZE;
-
-    compute_generic_gru(&model->enc_gru1_input, &model->enc_gru1_recurrent, enc_state->gru1_state, buffer, arch);
-    OPUS_COPY(&buffer[output_index], enc_state->gru1_state, ENC_GRU1_OUT_SIZE);
-    output_index += ENC_GRU1_OUT_SIZE;
-    conv1_cond_init(enc_state->conv1_state, output_index, 1, &enc_state->initialized);
-    compute_generic_conv1d(&model->enc_conv1, &buffer[output_index], enc_state->conv1_state, buffer, output_index, ACTIVATION_TANH, arch);
-    output_index += ENC_CONV1_OUT_SIZE;
-
-    compute_generic_gru(&model->enc_gru2_input, &model->enc_gru2_recurrent, enc_state->gru2_state, buffer, arch);
-    OPUS_COPY(&buffer[output_index], enc_state->gru2_state, ENC_GRU2_OUT_SIZE);
-    output_index += ENC_GRU2_OUT_SIZE;
-    conv1_cond_init(enc_state->conv2_state, output_index, 2, &enc_state->initialized);
-    compute_generic_conv1d_dilation(&model->enc_conv2, &buffer[output_index], enc_state->conv2_state, buffer, output_index, 2, ACTIVATION_TANH, arch);
-    output_index += ENC_CONV2_OUT_SIZE;
-
-    compute_generic_gru(&model->enc_gru3_input, &model->enc_gru3_recurrent, enc_state->gru3_state, buffer, arch);
-    OPUS_COPY(&buffer[output_index], enc_state->gru3_state, ENC_GRU3_OUT_SIZE);
-    output_index += ENC_GRU3_OUT_SIZE;
-    conv1_cond_init(enc_state->conv3_state, output_index, 2, &enc_state->initialized);
-    compute_generic_conv1d_dilation(&model->enc_conv3, &buffer[output_index], enc_state->conv3_state, buffer, output_index, 2, ACTIVATION_TANH, arch);
-    output_index += ENC_CONV3_OUT_SIZE;
-
-    compute_generic_gru(&model->enc_gru4_input, &model->enc_gru4_recurrent, enc_state->gru4_state, buffer, arch);
-    OPUS_COPY(&buffer[output_index], enc_state->gru4_state, ENC_GRU4_OUT_SIZE);
-    output_index += ENC_GRU4_OUT_SIZE;
-    conv1_cond_init(enc_state->conv4_state, output_index, 2, &enc_state->initialized);
-    compute_generic_conv1d_dilation(&model->enc_conv4, &buffer[output_index], enc_state->conv4_state, buffer, output_index, 2, ACTIVATION_TANH, arch);
-    output_index += ENC_CONV4_OUT_SIZE;
-
-    compute_generic_gru(&model->enc_gru5_input, &model->enc_gru5_recurrent, enc_state->gru5_state, buffer, arch);
-    OPUS_COPY(&buffer[output_index], enc_state->gru5_state, ENC_GRU5_OUT_SIZE);
-    output_index += ENC_GRU5_OUT_SIZE;
-    conv1_cond_init(enc_state->conv5_state, output_index, 2, &enc_state->initialized);
-    compute_generic_conv1d_dilation(&model->enc_conv5, &buffer[output_index], enc_state->conv5_state, buffer, output_index, 2, ACTIVATION_TANH, arch);
-    output_index += ENC_CONV5_OUT_SIZE;
-
-    compute_generic_dense(&model->enc_zdense, padded_latents, buffer, ACTIVATION_LINEAR, arch);
-    OPUS_COPY(latents, padded_latents, DRED_LATENT_DIM);
-
-    /* next, calculate initial state */
-    compute_generic_dense(&model->gdense1, state_hidden, buffer, ACTIVATION_TANH, arch);
-    compute_generic_dense(&model->gdense2, padded_state, state_hidden, ACTIVATION_LINEAR, arch);
-    OPUS_COPY(initial_state, padded_state, DRED_STATE_DIM);
+    dred_rdovae_encode_dframes(enc_state, model, latents, initial_state, input, 1, arch);
 }
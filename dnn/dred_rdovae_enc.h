@@ -47,6 +47,7 @@ struct RDOVAEEncStruct {
 };
 
 void dred_rdovae_encode_dframe(RDOVAEEncState *enc_state, const RDOVAEEnc *model, float *latents, float *initial_state, const float *input, int arch);
+void dred_rdovae_encode_dframes(RDOVAEEncState *enc_state, const RDOVAEEnc *model, float *latents, float *initial_states, const float *inputs, int nb, int arch);
 
 
 #endif
@@ -42,11 +42,11 @@
 
 static void compute_fargan_cond(FARGANState *st, float *cond, const float *features, int period)
 {
-  FARGAN *model;
+  const FARGAN *model;
   float dense_in[NB_FEATURES+COND_NET_PEMBED_OUT_SIZE];
   float conv1_in[COND_NET_FCONV1_IN_SIZE];
   float fdense2_in[COND_NET_FCONV1_OUT_SIZE];
-  model = &st->model;
+  model = st->shared_model ? st->shared_model : &st->model;
   celt_assert(FARGAN_FEATURES+COND_NET_PEMBED_OUT_SIZE == model->cond_net_fdense1.nb_inputs);
   celt_assert(COND_NET_FCONV1_IN_SIZE == model->cond_net_fdense1.nb_outputs);
   celt_assert(COND_NET_FCONV1_OUT_SIZE == model->cond_net_fconv1.nb_outputs);
@@ -80,10 +80,10 @@ static void run_fargan_subframe(FARGANState *st, float *pcm, const float *cond,
   float gain_1;
   float skip_cat[10000];
   float skip_out[SIG_NET_SKIP_DENSE_OUT_SIZE];
-  FARGAN *model;
+  const FARGAN *model;
 
   celt_assert(st->cont_initialized);
-  model = &st->model;
+  model = st->shared_model ? st->shared_model : &st->model;
 
   compute_generic_dense(&model->sig_net_cond_gain_dense, &gain, cond, ACTIVATION_LINEAR, st->arch);
   gain = exp(gain);
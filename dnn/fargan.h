@@ -44,6 +44,8 @@
 #define FARGAN_MAX_RNN_NEURONS SIG_NET_GRU1_OUT_SIZE
 typedef struct {
   FARGAN model;
+  /* Tables of an attached OpusDNNModel, used instead of model when set. */
+  const FARGAN *shared_model;
   int arch;
   int cont_initialized;
   float deemph_mem;
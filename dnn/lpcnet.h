@@ -179,5 +179,7 @@ void lpcnet_plc_fec_clear(LPCNetPLCState *st);
 
 int lpcnet_load_model(LPCNetState *st, const void *data, int len);
 int lpcnet_plc_load_model(LPCNetPLCState *st, const void *data, int len);
+struct OpusDNNModel;
+int lpcnet_plc_set_model(LPCNetPLCState *st, const struct OpusDNNModel *model);
 
 #endif
@@ -31,6 +31,7 @@
 #include "lpcnet_private.h"
 #include "lpcnet.h"
 #include "plc_data.h"
+#include "dnn_model.h"
 #include "os_support.h"
 #include "common.h"
 #include "cpu_support.h"
@@ -43,10 +44,14 @@
 #define PLC_SKIP_UPDATES
 
 void lpcnet_plc_reset(LPCNetPLCState *st) {
+  const PitchDNN *pitchdnn_model;
   OPUS_CLEAR((char*)&st->LPCNET_PLC_RESET_START,
           sizeof(LPCNetPLCState)-
           ((char*)&st->LPCNET_PLC_RESET_START - (char*)st));
+  /* Keep the attached model across the encoder reinitialization. */
+  pitchdnn_model = st->enc.pitchdnn.shared_model;
   lpcnet_encoder_init(&st->enc);
+  st->enc.pitchdnn.shared_model = pitchdnn_model;
   OPUS_CLEAR(st->pcm, PLC_BUF_SIZE);
   st->blend = 0;
   st->loss_count = 0;
@@ -61,6 +66,7 @@ int lpcnet_plc_init(LPCNetPLCState *st) {
   fargan_init(&st->fargan);
   lpcnet_encoder_init(&st->enc);
   st->loaded = 0;
+  st->lookahead = 0;
 #ifndef USE_WEIGHTS_FILE
   ret = init_plcmodel(&st->model, plcmodel_arrays);
   if (ret == 0) st->loaded = 1;
@@ -84,10 +90,41 @@ int lpcnet_plc_load_model(LPCNetPLCState *st, const void *data, int len) {
   if (ret == 0) {
     ret = fargan_load_model(&st->fargan, data, len);
   }
-  if (ret == 0) st->loaded = 1;
+  if (ret == 0) {
+    st->loaded = 1;
+    st->shared_model = NULL;
+    st->fargan.shared_model = NULL;
+    st->enc.pitchdnn.shared_model = NULL;
+  }
   return ret;
 }
 
+/* Points at the tables of a shared model, or goes back to the built-in
+   weights (if any) when model is NULL. The model must outlive the state. */
+int lpcnet_plc_set_model(LPCNetPLCState *st, const OpusDNNModel *model) {
+  if (model == NULL) {
+    int ret = 0;
+    st->shared_model = NULL;
+    st->fargan.shared_model = NULL;
+    st->enc.pitchdnn.shared_model = NULL;
+#ifndef USE_WEIGHTS_FILE
+    ret = init_plcmodel(&st->model, plcmodel_arrays);
+    if (ret == 0) ret = init_fargan(&st->fargan.model, fargan_arrays);
+    if (ret == 0) ret = init_pitchdnn(&st->enc.pitchdnn.model, pitchdnn_arrays);
+    st->loaded = (ret == 0);
+#else
+    st->loaded = 0;
+#endif
+    return ret;
+  }
+  if (!model->plc_loaded) return -1;
+  st->shared_model = &model->plc;
+  st->fargan.shared_model = &model->fargan;
+  st->enc.pitchdnn.shared_model = &model->pitchdnn;
+  st->loaded = 1;
+  return 0;
+}
+
 void lpcnet_plc_fec_add(LPCNetPLCState *st, const float *features) {
   if (features == NULL) {
     st->fec_skip++;
@@ -109,7 +146,7 @@ void lpcnet_plc_fec_clear(LPCNetPLCState *st) {
 
 static void compute_plc_pred(LPCNetPLCState *st, float *out, const float *in) {
   float tmp[PLC_DENSE_IN_OUT_SIZE];
-  PLCModel *model = &st->model;
+  const PLCModel *model = st->shared_model ? st->shared_model : &st->model;
   PLCNetState *net = &st->plc_net;
   celt_assert(st->loaded);
   compute_generic_dense(&model->plc_dense_in, tmp, in, ACTIVATION_TANH, st->arch);
@@ -142,6 +179,35 @@ static void queue_features(LPCNetPLCState *st, const float *features) {
   OPUS_COPY(&st->cont_features[(CONT_VECTORS-1)*NB_FEATURES], features, NB_FEATURES);
 }
 
+/* Runs the feature analysis and the PLC network on the frames of the history
+   that have not been analyzed yet. The first frame after a gap in the analysis
+   only primes the feature analysis. */
+static void analyze_pending(LPCNetPLCState *st) {
+  int i;
+  if (!st->plc_net_resumed) {
+    st->plc_net = st->plc_bak[0];
+    st->plc_net_resumed = 1;
+  }
+  while (st->analysis_pos + FRAME_SIZE <= PLC_BUF_SIZE) {
+    float x[FRAME_SIZE];
+    float plc_features[2*NB_BANDS+NB_FEATURES+1];
+    celt_assert(st->analysis_pos >= 0);
+    for (i=0;i<FRAME_SIZE;i++) x[i] = 32768.f*st->pcm[st->analysis_pos+i];
+    burg_cepstral_analysis(plc_features, x);
+    lpcnet_compute_single_frame_features_float(&st->enc, x, st->features, st->arch);
+    if (!st->analysis_gap && st->analysis_pos >= st->predict_pos) {
+      queue_features(st, st->features);
+      OPUS_COPY(&plc_features[2*NB_BANDS], st->features, NB_FEATURES);
+      plc_features[2*NB_BANDS+NB_FEATURES] = 1;
+      st->plc_bak[0] = st->plc_bak[1];
+      st->plc_bak[1] = st->plc_net;
+      compute_plc_pred(st, st->features, plc_features);
+    }
+    st->analysis_pos += FRAME_SIZE;
+    st->analysis_gap = 0;
+  }
+}
+
 /* In this causal version of the code, the DNN model implemented by compute_plc_pred()
    needs to generate two feature vectors to conceal the first lost packet.*/
 
@@ -154,6 +220,9 @@ int lpcnet_plc_update(LPCNetPLCState *st, opus_int16 *pcm) {
   for (i=0;i<FRAME_SIZE;i++) st->pcm[PLC_BUF_SIZE-FRAME_SIZE+i] = (1.f/32768.f)*pcm[i];
   st->loss_count = 0;
   st->blend = 0;
+  /* In look-ahead mode, keep the analysis and the PLC network in step with the
+     good frames so that a loss only has to run the prediction and synthesis. */
+  if (st->lookahead && st->loaded) analyze_pending(st);
   return 0;
 }
 
@@ -162,26 +231,7 @@ int lpcnet_plc_conceal(LPCNetPLCState *st, opus_int16 *pcm) {
   int i;
   celt_assert(st->loaded);
   if (st->blend == 0) {
-    int count = 0;
-    st->plc_net = st->plc_bak[0];
-    while (st->analysis_pos + FRAME_SIZE <= PLC_BUF_SIZE) {
-      float x[FRAME_SIZE];
-      float plc_features[2*NB_BANDS+NB_FEATURES+1];
-      celt_assert(st->analysis_pos >= 0);
-      for (i=0;i<FRAME_SIZE;i++) x[i] = 32768.f*st->pcm[st->analysis_pos+i];
-      burg_cepstral_analysis(plc_features, x);
-      lpcnet_compute_single_frame_features_float(&st->enc, x, st->features, st->arch);
-      if ((!st->analysis_gap || count>0) && st->analysis_pos >= st->predict_pos) {
-        queue_features(st, st->features);
-        OPUS_COPY(&plc_features[2*NB_BANDS], st->features, NB_FEATURES);
-        plc_features[2*NB_BANDS+NB_FEATURES] = 1;
-        st->plc_bak[0] = st->plc_bak[1];
-        st->plc_bak[1] = st->plc_net;
-        compute_plc_pred(st, st->features, plc_features);
-      }
-      st->analysis_pos += FRAME_SIZE;
-      count++;
-    }
+    analyze_pending(st);
     st->plc_bak[0] = st->plc_bak[1];
     st->plc_bak[1] = st->plc_net;
     get_fec_or_pred(st, st->features);
@@ -207,5 +257,6 @@ int lpcnet_plc_conceal(LPCNetPLCState *st, opus_int16 *pcm) {
   OPUS_MOVE(st->pcm, &st->pcm[FRAME_SIZE], PLC_BUF_SIZE-FRAME_SIZE);
   for (i=0;i<FRAME_SIZE;i++) st->pcm[PLC_BUF_SIZE-FRAME_SIZE+i] = (1.f/32768.f)*pcm[i];
   st->blend = 1;
+  st->plc_net_resumed = 0;
   return 0;
 }
@@ -49,10 +49,14 @@ typedef struct {
 #define PLC_BUF_SIZE ((CONT_VECTORS+10)*FRAME_SIZE)
 struct LPCNetPLCState {
   PLCModel model;
+  /* Tables of an attached OpusDNNModel, used instead of model when set. */
+  const PLCModel *shared_model;
   FARGANState fargan;
   LPCNetEncState enc;
   int loaded;
   int arch;
+  /* Analyze each good frame as it arrives rather than on the first loss. */
+  int lookahead;
 
 #define LPCNET_PLC_RESET_START fec
   float fec[PLC_MAX_FEC][NB_FEATURES];
@@ -69,6 +73,8 @@ struct LPCNetPLCState {
   int loss_count;
   PLCNetState plc_net;
   PLCNetState plc_bak[2];
+  /* Set once plc_net has been rewound to plc_bak[0] after the last concealed frame. */
+  int plc_net_resumed;
 };
 
 void preemphasis(float *y, float *mem, const float *x, float coef, int N);
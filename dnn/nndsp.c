@@ -34,7 +34,6 @@
 #include "arch.h"
 #include "nnet.h"
 #include "os_support.h"
-#include "pitch.h"
 
 #include <math.h>
 
@@ -146,36 +145,28 @@ void adaconv_process_frame(
     float filter_gain_a,
     float filter_gain_b,
     float shape_gain,
-    float *window,
+    const float *window,
     int arch
 )
 {
-    float output_buffer[ADACONV_MAX_FRAME_SIZE * ADACONV_MAX_OUTPUT_CHANNELS];
     float kernel_buffer[ADACONV_MAX_KERNEL_SIZE * ADACONV_MAX_INPUT_CHANNELS * ADACONV_MAX_OUTPUT_CHANNELS];
     float input_buffer[ADACONV_MAX_INPUT_CHANNELS * (ADACONV_MAX_FRAME_SIZE + ADACONV_MAX_KERNEL_SIZE)];
-    float kernel0[ADACONV_MAX_KERNEL_SIZE];
-    float kernel1[ADACONV_MAX_KERNEL_SIZE];
-    float channel_buffer0[ADACONV_MAX_OVERLAP_SIZE];
-    float channel_buffer1[ADACONV_MAX_FRAME_SIZE];
     float gain_buffer[ADACONV_MAX_OUTPUT_CHANNELS];
     float *p_input;
-    int i_in_channels, i_out_channels, i_sample;
+    int i_in_channels, i_out_channels;
 
     (void) feature_dim; /* ToDo: figure out whether we might need this information */
 
     celt_assert(shape_gain == 1);
     celt_assert(left_padding == kernel_size - 1); /* currently only supports causal version. Non-causal version not difficult to implement but will require third loop */
     celt_assert(kernel_size < frame_size);
-
-    OPUS_CLEAR(output_buffer, ADACONV_MAX_FRAME_SIZE * ADACONV_MAX_OUTPUT_CHANNELS);
-    OPUS_CLEAR(kernel_buffer, ADACONV_MAX_KERNEL_SIZE * ADACONV_MAX_INPUT_CHANNELS * ADACONV_MAX_OUTPUT_CHANNELS);
-    OPUS_CLEAR(input_buffer, ADACONV_MAX_INPUT_CHANNELS * (ADACONV_MAX_FRAME_SIZE + ADACONV_MAX_KERNEL_SIZE));
+    celt_assert(overlap_size <= frame_size);
 
 #ifdef DEBUG_NNDSP
     print_float_vector("x_in", x_in, in_channels * frame_size);
 #endif
 
-    /* prepare input */
+    /* prepare input (before x_out gets written, as it may alias x_in) */
     for (i_in_channels=0; i_in_channels < in_channels; i_in_channels ++)
     {
         OPUS_COPY(input_buffer + i_in_channels * (kernel_size + frame_size), hAdaConv->history + i_in_channels * kernel_size, kernel_size);
@@ -200,33 +191,20 @@ void adaconv_process_frame(
     print_float_vector("adaconv_gain", gain_buffer, out_channels);
 #endif
 
-    /* calculate overlapping part using kernel from last frame */
-
+    /* filter with the new kernel, cross-fading from the kernel of the last frame over the overlap */
+    OPUS_CLEAR(x_out, out_channels * frame_size);
     for (i_out_channels = 0; i_out_channels < out_channels; i_out_channels++)
     {
         for (i_in_channels = 0; i_in_channels < in_channels; i_in_channels++)
         {
-            OPUS_CLEAR(kernel0, ADACONV_MAX_KERNEL_SIZE);
-            OPUS_CLEAR(kernel1, ADACONV_MAX_KERNEL_SIZE);
-
-            OPUS_COPY(kernel0, hAdaConv->last_kernel + KERNEL_INDEX(i_out_channels, i_in_channels, 0), kernel_size);
-            OPUS_COPY(kernel1, kernel_buffer + KERNEL_INDEX(i_out_channels, i_in_channels, 0), kernel_size);
-            celt_pitch_xcorr(kernel0, p_input + i_in_channels * (frame_size + kernel_size) - left_padding, channel_buffer0, ADACONV_MAX_KERNEL_SIZE, overlap_size, arch);
-            celt_pitch_xcorr(kernel1, p_input + i_in_channels * (frame_size + kernel_size) - left_padding, channel_buffer1, ADACONV_MAX_KERNEL_SIZE, frame_size, arch);
-            for (i_sample = 0; i_sample < overlap_size; i_sample++)
-            {
-                output_buffer[i_sample + i_out_channels * frame_size] +=  window[i_sample] * channel_buffer0[i_sample];
-                output_buffer[i_sample + i_out_channels * frame_size] += (1.f - window[i_sample]) * channel_buffer1[i_sample];
-            }
-            for (i_sample = overlap_size; i_sample < frame_size; i_sample++)
-            {
-                output_buffer[i_sample + i_out_channels * frame_size] += channel_buffer1[i_sample];
-            }
+            const float *p_channel = p_input + i_in_channels * (frame_size + kernel_size) - left_padding;
+            compute_crossfade_conv(x_out + i_out_channels * frame_size,
+                p_channel, hAdaConv->last_kernel + KERNEL_INDEX(i_out_channels, i_in_channels, 0),
+                p_channel, kernel_buffer + KERNEL_INDEX(i_out_channels, i_in_channels, 0),
+                window, kernel_size, overlap_size, frame_size, arch);
         }
     }
 
-    OPUS_COPY(x_out, output_buffer, out_channels * frame_size);
-
 #ifdef DEBUG_NNDSP
     print_float_vector("x_out", x_out, out_channels * frame_size);
 #endif
@@ -256,26 +234,24 @@ void adacomb_process_frame(
     float filter_gain_a,
     float filter_gain_b,
     float log_gain_limit,
-    float *window,
+    const float *window,
     int arch
 )
 {
-    float output_buffer[ADACOMB_MAX_FRAME_SIZE];
-    float output_buffer_last[ADACOMB_MAX_FRAME_SIZE];
     float kernel_buffer[ADACOMB_MAX_KERNEL_SIZE];
     float input_buffer[ADACOMB_MAX_FRAME_SIZE + ADACOMB_MAX_LAG + ADACOMB_MAX_KERNEL_SIZE];
     float gain, global_gain;
     float *p_input;
     int i_sample;
-    float kernel[16];
-    float last_kernel[16];
+    float kernel[ADACOMB_MAX_KERNEL_SIZE];
+    float last_kernel[ADACOMB_MAX_KERNEL_SIZE];
 
     (void) feature_dim; /* ToDo: figure out whether we might need this information */
 
-    OPUS_CLEAR(output_buffer, ADACOMB_MAX_FRAME_SIZE);
-    OPUS_CLEAR(kernel_buffer, ADACOMB_MAX_KERNEL_SIZE);
-    OPUS_CLEAR(input_buffer, ADACOMB_MAX_FRAME_SIZE + ADACOMB_MAX_LAG + ADACOMB_MAX_KERNEL_SIZE);
+    celt_assert(kernel_size <= ADACOMB_MAX_KERNEL_SIZE);
+    celt_assert(overlap_size <= frame_size);
 
+    /* prepare input (before x_out gets written, as it may alias x_in) */
     OPUS_COPY(input_buffer, hAdaComb->history, kernel_size + ADACOMB_MAX_LAG);
     OPUS_COPY(input_buffer + kernel_size + ADACOMB_MAX_LAG, x_in, frame_size);
     p_input = input_buffer + kernel_size + ADACOMB_MAX_LAG;
@@ -299,29 +275,29 @@ void adacomb_process_frame(
     print_float_vector("adacomb_gain", &gain, 1);
 #endif
 
-    OPUS_CLEAR(kernel, ADACOMB_MAX_KERNEL_SIZE);
-    OPUS_CLEAR(last_kernel, ADACOMB_MAX_KERNEL_SIZE);
-    OPUS_COPY(kernel, kernel_buffer, kernel_size);
-    OPUS_COPY(last_kernel, hAdaComb->last_kernel, kernel_size);
-
-    celt_pitch_xcorr(last_kernel, &p_input[- left_padding - hAdaComb->last_pitch_lag], output_buffer_last, ADACOMB_MAX_KERNEL_SIZE, overlap_size, arch);
-
-    celt_pitch_xcorr(kernel, &p_input[- left_padding - pitch_lag], output_buffer, ADACOMB_MAX_KERNEL_SIZE, frame_size, arch);
-    for (i_sample = 0; i_sample < overlap_size; i_sample++)
+    /* fold the global gains into the kernels so that the comb filters and the
+       cross-fade between them are a single pass */
+    for (i_sample = 0; i_sample < kernel_size; i_sample++)
     {
-      output_buffer[i_sample] = hAdaComb->last_global_gain * window[i_sample] * output_buffer_last[i_sample] + global_gain * (1.f - window[i_sample]) * output_buffer[i_sample];
+      last_kernel[i_sample] = hAdaComb->last_global_gain * hAdaComb->last_kernel[i_sample];
+      kernel[i_sample] = global_gain * kernel_buffer[i_sample];
     }
 
+    OPUS_CLEAR(x_out, frame_size);
+    compute_crossfade_conv(x_out,
+        &p_input[- left_padding - hAdaComb->last_pitch_lag], last_kernel,
+        &p_input[- left_padding - pitch_lag], kernel,
+        window, kernel_size, overlap_size, frame_size, arch);
+
     for (i_sample = 0; i_sample < overlap_size; i_sample++)
     {
-      output_buffer[i_sample] += (window[i_sample] * hAdaComb->last_global_gain + (1.f - window[i_sample]) * global_gain) * p_input[i_sample];
+      x_out[i_sample] += (window[i_sample] * hAdaComb->last_global_gain + (1.f - window[i_sample]) * global_gain) * p_input[i_sample];
     }
 
     for (i_sample = overlap_size; i_sample < frame_size; i_sample++)
     {
-      output_buffer[i_sample] = global_gain * (output_buffer[i_sample] + p_input[i_sample]);
+      x_out[i_sample] += global_gain * p_input[i_sample];
     }
-    OPUS_COPY(x_out, output_buffer, frame_size);
 
 #ifdef DEBUG_NNDSP
     print_float_vector("x_out", x_out, frame_size);
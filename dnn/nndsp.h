@@ -101,7 +101,7 @@ void adaconv_process_frame(
     float filter_gain_a,
     float filter_gain_b,
     float shape_gain,
-    float *window,
+    const float *window,
     int arch
 );
 
@@ -122,7 +122,7 @@ void adacomb_process_frame(
     float filter_gain_a,
     float filter_gain_b,
     float log_gain_limit,
-    float *window,
+    const float *window,
     int arch
 );
 
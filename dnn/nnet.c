@@ -40,6 +40,7 @@
 #include "fargan.h"
 #include "os_support.h"
 #include "vec.h"
+#include "profile.h"
 
 #ifdef ENABLE_OSCE
 #include "osce.h"
@@ -59,8 +60,22 @@
 
 void compute_generic_dense(const LinearLayer *layer, float *output, const float *input, int activation, int arch)
 {
+   OPUS_PROFILE_ENTER(OPUS_PROFILE_DNN);
    compute_linear(layer, output, input, arch);
    compute_activation(output, output, layer->nb_outputs, activation, arch);
+   OPUS_PROFILE_LEAVE(OPUS_PROFILE_DNN);
+}
+
+/* Applies a dense layer to K inputs (K x nb_inputs, contiguous), writing K
+   outputs (K x nb_outputs). All inputs share a single pass over the weights. */
+void compute_generic_dense_batch(const LinearLayer *layer, float *output, const float *input, int K, int activation, int arch)
+{
+   int k;
+   OPUS_PROFILE_ENTER(OPUS_PROFILE_DNN);
+   compute_linear_batch(layer, output, input, K, arch);
+   for (k=0;k<K;k++)
+      compute_activation(&output[k*layer->nb_outputs], &output[k*layer->nb_outputs], layer->nb_outputs, activation, arch);
+   OPUS_PROFILE_LEAVE(OPUS_PROFILE_DNN);
 }
 
 #ifdef ENABLE_OSCE
@@ -86,6 +101,7 @@ void compute_generic_gru(const LinearLayer *input_weights, const LinearLayer *re
   h = &zrh[2*N];
   celt_assert(recurrent_weights->nb_outputs <= 3*MAX_RNN_NEURONS_ALL);
   celt_assert(in != state);
+  OPUS_PROFILE_ENTER(OPUS_PROFILE_DNN);
   compute_linear(input_weights, zrh, in, arch);
   compute_linear(recurrent_weights, recur, state, arch);
   for (i=0;i<2*N;i++)
@@ -98,6 +114,49 @@ void compute_generic_gru(const LinearLayer *input_weights, const LinearLayer *re
      h[i] = z[i]*state[i] + (1-z[i])*h[i];
   for (i=0;i<N;i++)
      state[i] = h[i];
+  OPUS_PROFILE_LEAVE(OPUS_PROFILE_DNN);
+}
+
+/* Runs a GRU over T consecutive time steps (T x nb_inputs inputs, contiguous),
+   writing the state after each step to output (T x N). The input products of
+   all the steps share passes over the weights, only the recurrent product is
+   sequential. Produces the same result as T calls to compute_generic_gru(). */
+void compute_generic_gru_seq(const LinearLayer *input_weights, const LinearLayer *recurrent_weights, float *state, float *output, const float *in, int T, int arch)
+{
+  int i, t, t0;
+  int N, M;
+  float zrh[DNN_MAX_BATCH*3*MAX_RNN_NEURONS_ALL];
+  float recur[3*MAX_RNN_NEURONS_ALL];
+  celt_assert(3*recurrent_weights->nb_inputs == recurrent_weights->nb_outputs);
+  celt_assert(input_weights->nb_outputs == recurrent_weights->nb_outputs);
+  N = recurrent_weights->nb_inputs;
+  M = input_weights->nb_inputs;
+  celt_assert(recurrent_weights->nb_outputs <= 3*MAX_RNN_NEURONS_ALL);
+  celt_assert(in != state);
+  OPUS_PROFILE_ENTER(OPUS_PROFILE_DNN);
+  for (t0=0;t0<T;t0+=DNN_MAX_BATCH) {
+    int nb = IMIN(DNN_MAX_BATCH, T-t0);
+    compute_linear_batch(input_weights, zrh, &in[t0*M], nb, arch);
+    for (t=0;t<nb;t++) {
+      float *z, *r, *h;
+      z = &zrh[3*N*t];
+      r = &z[N];
+      h = &z[2*N];
+      compute_linear(recurrent_weights, recur, state, arch);
+      for (i=0;i<2*N;i++)
+         z[i] += recur[i];
+      compute_activation(z, z, 2*N, ACTIVATION_SIGMOID, arch);
+      for (i=0;i<N;i++)
+         h[i] += recur[2*N+i]*r[i];
+      compute_activation(h, h, N, ACTIVATION_TANH, arch);
+      for (i=0;i<N;i++)
+         h[i] = z[i]*state[i] + (1-z[i])*h[i];
+      for (i=0;i<N;i++)
+         state[i] = h[i];
+      OPUS_COPY(&output[(t0+t)*N], state, N);
+    }
+  }
+  OPUS_PROFILE_LEAVE(OPUS_PROFILE_DNN);
 }
 
 void compute_glu(const LinearLayer *layer, float *output, const float *input, int arch)
@@ -105,6 +164,7 @@ void compute_glu(const LinearLayer *layer, float *output, const float *input, in
    int i;
    float act2[MAX_INPUTS];
    celt_assert(layer->nb_inputs == layer->nb_outputs);
+   OPUS_PROFILE_ENTER(OPUS_PROFILE_DNN);
    compute_linear(layer, act2, input, arch);
    compute_activation(act2, act2, layer->nb_outputs, ACTIVATION_SIGMOID, arch);
    if (input == output) {
@@ -113,6 +173,27 @@ void compute_glu(const LinearLayer *layer, float *output, const float *input, in
    } else {
      for (i=0;i<layer->nb_outputs;i++) output[i] = input[i]*act2[i];
    }
+   OPUS_PROFILE_LEAVE(OPUS_PROFILE_DNN);
+}
+
+/* Batched compute_glu(): K inputs and K outputs, each stored contiguously.
+   Unlike compute_glu(), cannot run in place. */
+void compute_glu_batch(const LinearLayer *layer, float *output, const float *input, int K, int arch)
+{
+   int i, k;
+   int N;
+   celt_assert(layer->nb_inputs == layer->nb_outputs);
+   celt_assert(input != output);
+   OPUS_PROFILE_ENTER(OPUS_PROFILE_DNN);
+   N = layer->nb_outputs;
+   compute_linear_batch(layer, output, input, K, arch);
+   for (k=0;k<K;k++) {
+      float *y = &output[k*N];
+      const float *x = &input[k*N];
+      compute_activation(y, y, N, ACTIVATION_SIGMOID, arch);
+      for (i=0;i<N;i++) y[i] = x[i]*y[i];
+   }
+   OPUS_PROFILE_LEAVE(OPUS_PROFILE_DNN);
 }
 
 #define MAX_CONV_INPUTS_ALL DRED_MAX_CONV_INPUTS
@@ -122,11 +203,54 @@ void compute_generic_conv1d(const LinearLayer *layer, float *output, float *mem,
    float tmp[MAX_CONV_INPUTS_ALL];
    celt_assert(input != output);
    celt_assert(layer->nb_inputs <= MAX_CONV_INPUTS_ALL);
+   OPUS_PROFILE_ENTER(OPUS_PROFILE_DNN);
    if (layer->nb_inputs!=input_size) OPUS_COPY(tmp, mem, layer->nb_inputs-input_size);
    OPUS_COPY(&tmp[layer->nb_inputs-input_size], input, input_size);
    compute_linear(layer, output, tmp, arch);
    compute_activation(output, output, layer->nb_outputs, activation, arch);
    if (layer->nb_inputs!=input_size) OPUS_COPY(mem, &tmp[input_size], layer->nb_inputs-input_size);
+   OPUS_PROFILE_LEAVE(OPUS_PROFILE_DNN);
+}
+
+/* Runs a (dilated) conv1d over T consecutive time steps: T inputs of
+   input_size and T outputs, each stored contiguously. mem is the same as for
+   compute_generic_conv1d() (dilation 1) or compute_generic_conv1d_dilation(),
+   and so is the result. */
+void compute_generic_conv1d_seq(const LinearLayer *layer, float *output, float *mem, const float *input, int input_size, int dilation, int T, int activation, int arch)
+{
+   float tmp[DNN_MAX_BATCH*MAX_CONV_INPUTS_ALL];
+   int ksize;
+   int mem_frames;
+   int i, t, t0;
+   celt_assert(input != output);
+   celt_assert(layer->nb_inputs <= MAX_CONV_INPUTS_ALL);
+   OPUS_PROFILE_ENTER(OPUS_PROFILE_DNN);
+   ksize = layer->nb_inputs/input_size;
+   mem_frames = dilation*(ksize-1);
+   for (t0=0;t0<T;t0+=DNN_MAX_BATCH) {
+      int nb = IMIN(DNN_MAX_BATCH, T-t0);
+      for (t=0;t<nb;t++) {
+         float *x = &tmp[t*layer->nb_inputs];
+         /* Frame p of the history is mem for p < mem_frames, then the input. */
+         for (i=0;i<ksize;i++) {
+            int p = t0 + t + i*dilation;
+            if (p < mem_frames) OPUS_COPY(&x[i*input_size], &mem[p*input_size], input_size);
+            else OPUS_COPY(&x[i*input_size], &input[(p-mem_frames)*input_size], input_size);
+         }
+      }
+      compute_linear_batch(layer, &output[t0*layer->nb_outputs], tmp, nb, arch);
+      for (t=0;t<nb;t++) {
+         float *y = &output[(t0+t)*layer->nb_outputs];
+         compute_activation(y, y, layer->nb_outputs, activation, arch);
+      }
+   }
+   if (T >= mem_frames) {
+      OPUS_COPY(mem, &input[(T-mem_frames)*input_size], mem_frames*input_size);
+   } else {
+      OPUS_MOVE(mem, &mem[T*input_size], (mem_frames-T)*input_size);
+      OPUS_COPY(&mem[(mem_frames-T)*input_size], input, T*input_size);
+   }
+   OPUS_PROFILE_LEAVE(OPUS_PROFILE_DNN);
 }
 
 void compute_generic_conv1d_dilation(const LinearLayer *layer, float *output, float *mem, const float *input, int input_size, int dilation, int activation, int arch)
@@ -136,6 +260,7 @@ void compute_generic_conv1d_dilation(const LinearLayer *layer, float *output, fl
    int i;
    celt_assert(input != output);
    celt_assert(layer->nb_inputs <= MAX_CONV_INPUTS_ALL);
+   OPUS_PROFILE_ENTER(OPUS_PROFILE_DNN);
    if (dilation==1) OPUS_COPY(tmp, mem, layer->nb_inputs-input_size);
    else for (i=0;i<ksize-1;i++) OPUS_COPY(&tmp[i*input_size], &mem[i*input_size*dilation], input_size);
    OPUS_COPY(&tmp[layer->nb_inputs-input_size], input, input_size);
@@ -146,4 +271,5 @@ void compute_generic_conv1d_dilation(const LinearLayer *layer, float *output, fl
      OPUS_COPY(mem, &mem[input_size], input_size*dilation*(ksize-1)-input_size);
      OPUS_COPY(&mem[input_size*dilation*(ksize-1)-input_size], input, input_size);
    }
+   OPUS_PROFILE_LEAVE(OPUS_PROFILE_DNN);
 }
@@ -38,7 +38,16 @@
 #define ACTIVATION_SOFTMAX 4
 #define ACTIVATION_SWISH   5
 
-#define WEIGHT_BLOB_VERSION 0
+/* Number of streams the batched layer functions process per pass over the
+   weights (compute_linear_batch() itself takes any K). */
+#define DNN_MAX_BATCH 8
+
+/* Version 1 blobs start with a WEIGHT_TYPE_index record holding a hash table
+   of the names of the records that follow, and pad every payload to a
+   multiple of WEIGHT_BLOCK_SIZE so that, within a blob that is itself
+   WEIGHT_BLOCK_SIZE-aligned, all the tensors are too. Version 0 blobs remain
+   accepted (their index is built when they are parsed). */
+#define WEIGHT_BLOB_VERSION 1
 #define WEIGHT_BLOCK_SIZE 64
 typedef struct {
   const char *name;
@@ -51,6 +60,21 @@ typedef struct {
 #define WEIGHT_TYPE_int 1
 #define WEIGHT_TYPE_qweight 2
 #define WEIGHT_TYPE_int8 3
+#define WEIGHT_TYPE_index 4
+/* IEEE half-precision, only accepted for the float weights of dense (non-sparse)
+   linear layers and of conv2d layers. */
+#define WEIGHT_TYPE_float16 5
+
+#define WEIGHT_INDEX_NAME "__index__"
+#define WEIGHT_INDEX_EMPTY 0xFFFFFFFFU
+
+/* One bucket of the name index: the record number counts the records after
+   the index, from 0. The number of buckets is a power of two, and a name is
+   looked up by linear probing from bucket (weight_name_hash(name) & (nb_buckets-1)). */
+typedef struct {
+  opus_uint32 hash;
+  opus_uint32 record;
+} WeightIndexEntry;
 
 typedef struct {
   char head[4];
@@ -67,6 +91,7 @@ typedef struct {
   const float *subias;
   const opus_int8 *weights;
   const float *float_weights;
+  const opus_uint16 *float16_weights;
   const int *weights_idx;
   const float *diag;
   const float *scale;
@@ -74,10 +99,15 @@ typedef struct {
   int nb_outputs;
 } LinearLayer;
 
+/* Half-precision conv2d weights are widened to a stack buffer of this size
+   before use, so conv2d_init() rejects larger ones. */
+#define MAX_CONV2D_F16_WEIGHTS 4096
+
 /* Generic sparse affine transformation. */
 typedef struct {
   const float *bias;
   const float *float_weights;
+  const opus_uint16 *float16_weights;
   int in_channels;
   int out_channels;
   int ktime;
@@ -88,13 +118,22 @@ typedef struct {
 void compute_generic_dense(const LinearLayer *layer, float *output, const float *input, int activation, int arch);
 void compute_generic_gru(const LinearLayer *input_weights, const LinearLayer *recurrent_weights, float *state, const float *in, int arch);
 void compute_generic_conv1d(const LinearLayer *layer, float *output, float *mem, const float *input, int input_size, int activation, int arch);
+void compute_generic_dense_batch(const LinearLayer *layer, float *output, const float *input, int K, int activation, int arch);
 void compute_generic_conv1d_dilation(const LinearLayer *layer, float *output, float *mem, const float *input, int input_size, int dilation, int activation, int arch);
+void compute_generic_gru_seq(const LinearLayer *input_weights, const LinearLayer *recurrent_weights, float *state, float *output, const float *in, int T, int arch);
+void compute_generic_conv1d_seq(const LinearLayer *layer, float *output, float *mem, const float *input, int input_size, int dilation, int T, int activation, int arch);
 void compute_glu(const LinearLayer *layer, float *output, const float *input, int arch);
+void compute_glu_batch(const LinearLayer *layer, float *output, const float *input, int K, int arch);
 void compute_gated_activation(const LinearLayer *layer, float *output, const float *input, int activation, int arch);
 
 
+/* Lists returned by parse_weights() start with a WEIGHT_TYPE_index entry
+   (size is the number of buckets, data the WeightIndexEntry table) that
+   linear_init() and conv2d_init() use to find the tensors by name. */
 int parse_weights(WeightArray **list, const void *data, int len);
 
+opus_uint32 weight_name_hash(const char *name);
+
 
 extern const WeightArray lpcnet_arrays[];
 extern const WeightArray plcmodel_arrays[];
@@ -126,8 +165,10 @@ int conv2d_init(Conv2dLayer *layer, const WeightArray *arrays,
 
 
 void compute_linear_c(const LinearLayer *linear, float *out, const float *in);
+void compute_linear_batch_c(const LinearLayer *linear, float *out, const float *in, int K);
 void compute_activation_c(float *output, const float *input, int N, int activation);
 void compute_conv2d_c(const Conv2dLayer *conv, float *out, float *mem, const float *in, int height, int hstride, int activation);
+void compute_crossfade_conv_c(float *out, const float *in0, const float *kernel0, const float *in1, const float *kernel1, const float *window, int kernel_size, int overlap_size, int frame_size);
 
 
 #if defined(OPUS_ARM_MAY_HAVE_DOTPROD) || defined(OPUS_ARM_MAY_HAVE_NEON_INTR)
@@ -142,6 +183,10 @@ void compute_conv2d_c(const Conv2dLayer *conv, float *out, float *mem, const flo
 #define compute_linear(linear, out, in, arch) ((void)(arch),compute_linear_c(linear, out, in))
 #endif
 
+#ifndef OVERRIDE_COMPUTE_LINEAR_BATCH
+#define compute_linear_batch(linear, out, in, K, arch) ((void)(arch),compute_linear_batch_c(linear, out, in, K))
+#endif
+
 #ifndef OVERRIDE_COMPUTE_ACTIVATION
 #define compute_activation(output, input, N, activation, arch) ((void)(arch),compute_activation_c(output, input, N, activation))
 #endif
@@ -150,6 +195,10 @@ void compute_conv2d_c(const Conv2dLayer *conv, float *out, float *mem, const flo
 #define compute_conv2d(conv, out, mem, in, height, hstride, activation, arch) ((void)(arch),compute_conv2d_c(conv, out, mem, in, height, hstride, activation))
 #endif
 
+#ifndef OVERRIDE_COMPUTE_CROSSFADE_CONV
+#define compute_crossfade_conv(out, in0, kernel0, in1, kernel1, window, kernel_size, overlap_size, frame_size, arch) ((void)(arch),compute_crossfade_conv_c(out, in0, kernel0, in1, kernel1, window, kernel_size, overlap_size, frame_size))
+#endif
+
 #if defined(__x86_64__) && !defined(OPUS_X86_MAY_HAVE_SSE4_1) && !defined(OPUS_X86_MAY_HAVE_AVX2)
 #if defined(_MSC_VER)
 #pragma message ("Only SSE and SSE2 are available. On newer machines, enable SSSE3/AVX/AVX2 to get better performance")
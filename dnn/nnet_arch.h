@@ -128,6 +128,8 @@ void RTCD_SUF(compute_linear_) (const LinearLayer *linear, float *out, const flo
    if (linear->float_weights != NULL) {
      if (linear->weights_idx != NULL) sparse_sgemv8x4(out, linear->float_weights, linear->weights_idx, N, in);
      else sgemv(out, linear->float_weights, N, M, N, in);
+   } else if (linear->float16_weights != NULL) {
+     sgemv_f16(out, linear->float16_weights, N, M, N, in);
    } else if (linear->weights != NULL) {
      if (linear->weights_idx != NULL) sparse_cgemv8x4(out, linear->weights, linear->weights_idx, linear->scale, N, M, in);
      else cgemv8x4(out, linear->weights, linear->scale, N, M, in);
@@ -151,6 +153,86 @@ void RTCD_SUF(compute_linear_) (const LinearLayer *linear, float *out, const flo
    }
 }
 
+/* Weights processed per pass of compute_linear_batch(). Keeping each block
+   small enough to stay in L2 means it is only fetched from memory once no
+   matter how many inputs are in the batch. */
+#define GEMM_BLOCK_BYTES (128*1024)
+
+void RTCD_SUF(compute_linear_batch_) (const LinearLayer *linear, float *out, const float *in, int K)
+{
+   int i, k, M, N;
+   int r0, R;
+   const float *bias;
+   celt_assert(in != out);
+   bias = linear->bias;
+   M = linear->nb_inputs;
+   N = linear->nb_outputs;
+   if (linear->float16_weights != NULL) {
+      /* No batched kernel, but the blocking still keeps the weights in cache
+         across the batch. */
+      R = IMAX(16, (GEMM_BLOCK_BYTES/(sizeof(opus_uint16)*M)) & ~15);
+      for (r0=0;r0<N;r0+=R) {
+         int rows = IMIN(R, N-r0);
+         for (k=0;k<K;k++) sgemv_f16(&out[k*N + r0], &linear->float16_weights[r0], rows, M, N, &in[k*M]);
+      }
+   } else if (linear->float_weights != NULL || linear->weights != NULL) {
+      const int *idx;
+      int wsize;
+      wsize = linear->float_weights != NULL ? sizeof(float) : 1;
+      /* Multiple of 16 rows so the blocks line up with the single-vector kernels. */
+      R = IMAX(16, (GEMM_BLOCK_BYTES/(wsize*M)) & ~15);
+      idx = linear->weights_idx;
+      if (linear->float_weights != NULL) {
+         const float *w = linear->float_weights;
+         for (r0=0;r0<N;r0+=R) {
+            int rows = IMIN(R, N-r0);
+            if (idx != NULL) {
+               sparse_sgemm8x4(&out[r0], N, w, idx, rows, in, M, K);
+               for (i=0;i<rows;i+=8) {
+                  w += 32*idx[0];
+                  idx += idx[0]+1;
+               }
+            }
+            else sgemm(&out[r0], N, &w[r0], rows, M, N, in, M, K);
+         }
+      } else {
+         const opus_int8 *w = linear->weights;
+         for (r0=0;r0<N;r0+=R) {
+            int rows = IMIN(R, N-r0);
+            if (idx != NULL) {
+               sparse_cgemm8x4(&out[r0], N, w, idx, &linear->scale[r0], rows, M, in, M, K);
+               for (i=0;i<rows;i+=8) {
+                  w += 32*idx[0];
+                  idx += idx[0]+1;
+               }
+            }
+            else cgemm8x4(&out[r0], N, &w[r0*M], &linear->scale[r0], rows, M, in, M, K);
+         }
+         /* Only use SU biases on for integer matrices on SU archs. */
+#ifdef USE_SU_BIAS
+         bias = linear->subias;
+#endif
+      }
+   }
+   else OPUS_CLEAR(out, K*N);
+   for (k=0;k<K;k++) {
+      float *y = &out[k*N];
+      const float *x = &in[k*M];
+      if (bias != NULL) {
+         for (i=0;i<N;i++) y[i] += bias[i];
+      }
+      if (linear->diag) {
+         /* Diag is only used for GRU recurrent weights. */
+         celt_assert(3*M == N);
+         for (i=0;i<M;i++) {
+            y[i] += linear->diag[i]*x[i];
+            y[i+M] += linear->diag[i+M]*x[i];
+            y[i+2*M] += linear->diag[i+2*M]*x[i];
+         }
+      }
+   }
+}
+
 /* Computes non-padded convolution for input [ ksize1 x in_channels x (len2+ksize2) ],
    kernel [ out_channels x in_channels x ksize1 x ksize2 ],
    storing the output as [ out_channels x len2 ].
@@ -216,7 +298,9 @@ void RTCD_SUF(compute_conv2d_)(const Conv2dLayer *conv, float *out, float *mem,
 {
    int i;
    const float *bias;
+   const float *weights;
    float in_buf[MAX_CONV2D_INPUTS];
+   float w_buf[MAX_CONV2D_F16_WEIGHTS];
    int time_stride;
    celt_assert(in != out);
    time_stride = conv->in_channels*(height+conv->kheight-1);
@@ -225,10 +309,17 @@ void RTCD_SUF(compute_conv2d_)(const Conv2dLayer *conv, float *out, float *mem,
    OPUS_COPY(&in_buf[(conv->ktime-1)*time_stride], in, time_stride);
    OPUS_COPY(mem, &in_buf[time_stride], (conv->ktime-1)*time_stride);
    bias = conv->bias;
+   weights = conv->float_weights;
+   if (conv->float16_weights != NULL) {
+     int nb_weights = conv->in_channels*conv->out_channels*conv->ktime*conv->kheight;
+     celt_assert(nb_weights <= MAX_CONV2D_F16_WEIGHTS);
+     for (i=0;i<nb_weights;i++) w_buf[i] = float16_to_float(conv->float16_weights[i]);
+     weights = w_buf;
+   }
    if (conv->kheight == 3 && conv->ktime == 3)
-     conv2d_3x3_float(out, conv->float_weights, conv->in_channels, conv->out_channels, in_buf, height, hstride);
+     conv2d_3x3_float(out, weights, conv->in_channels, conv->out_channels, in_buf, height, hstride);
    else
-     conv2d_float(out, conv->float_weights, conv->in_channels, conv->out_channels, conv->ktime, conv->kheight, in_buf, height, hstride);
+     conv2d_float(out, weights, conv->in_channels, conv->out_channels, conv->ktime, conv->kheight, in_buf, height, hstride);
    if (bias != NULL) {
      for (i=0;i<conv->out_channels;i++) {
        int j;
@@ -240,6 +331,72 @@ void RTCD_SUF(compute_conv2d_)(const Conv2dLayer *conv, float *out, float *mem,
    }
 }
 
+/* Accumulates into out[0..frame_size-1] the convolution of in1 with kernel1,
+   cross-faded over the first overlap_size samples from the convolution of in0
+   with kernel0, i.e. for n < overlap_size
+     out[n] += window[n]*sum_j kernel0[j]*in0[n+j] + (1-window[n])*sum_j kernel1[j]*in1[n+j].
+   Like the conv2d above, this relies on the auto-vectorizer: the fixed-length
+   loops over CROSSFADE_BLOCK outputs become one vector accumulator per input
+   that stays in registers for all the taps. */
+#ifdef __AVX__
+#define CROSSFADE_BLOCK 8
+#else
+#define CROSSFADE_BLOCK 4
+#endif
+static OPUS_INLINE void crossfade_conv_sample(float *out, const float *in0, const float *kernel0, const float *in1, const float *kernel1, const float *window, int kernel_size, int overlap_size, int n)
+{
+   int j;
+   float sum0=0, sum1=0;
+   for (j=0;j<kernel_size;j++) {
+      sum1 += kernel1[j]*in1[n+j];
+   }
+   if (n<overlap_size) {
+      for (j=0;j<kernel_size;j++) {
+         sum0 += kernel0[j]*in0[n+j];
+      }
+      out[n] += window[n]*sum0 + (1.f - window[n])*sum1;
+   } else {
+      out[n] += sum1;
+   }
+}
+
+void RTCD_SUF(compute_crossfade_conv_)(float *out, const float *in0, const float *kernel0, const float *in1, const float *kernel1, const float *window, int kernel_size, int overlap_size, int frame_size)
+{
+   int i, j, n;
+   for (n=0;n+CROSSFADE_BLOCK<=frame_size;n+=CROSSFADE_BLOCK) {
+      float acc0[CROSSFADE_BLOCK] = {0};
+      float acc1[CROSSFADE_BLOCK] = {0};
+      if (n+CROSSFADE_BLOCK<=overlap_size) {
+         for (j=0;j<kernel_size;j++) {
+            for (i=0;i<CROSSFADE_BLOCK;i++) {
+               acc0[i] += kernel0[j]*in0[n+i+j];
+               acc1[i] += kernel1[j]*in1[n+i+j];
+            }
+         }
+         for (i=0;i<CROSSFADE_BLOCK;i++) {
+            out[n+i] += window[n+i]*acc0[i] + (1.f - window[n+i])*acc1[i];
+         }
+      } else if (n>=overlap_size) {
+         for (j=0;j<kernel_size;j++) {
+            for (i=0;i<CROSSFADE_BLOCK;i++) {
+               acc1[i] += kernel1[j]*in1[n+i+j];
+            }
+         }
+         for (i=0;i<CROSSFADE_BLOCK;i++) {
+            out[n+i] += acc1[i];
+         }
+      } else {
+         /* Block straddling the end of the overlap. */
+         for (i=0;i<CROSSFADE_BLOCK;i++) {
+            crossfade_conv_sample(out, in0, kernel0, in1, kernel1, window, kernel_size, overlap_size, n+i);
+         }
+      }
+   }
+   for (;n<frame_size;n++) {
+      crossfade_conv_sample(out, in0, kernel0, in1, kernel1, window, kernel_size, overlap_size, n);
+   }
+}
+
 #ifdef GCC_POP_OPTIONS
 #pragma GCC pop_options
 #endif
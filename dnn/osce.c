@@ -101,7 +101,7 @@ static void reset_lace_state(LACEState *state)
 }
 
 static void lace_feature_net(
-    LACE *hLACE,
+    const LACE *hLACE,
     LACEState *state,
     float *output,
     const float *features,
@@ -176,7 +176,7 @@ static void lace_feature_net(
 
 
 static void lace_process_20ms_frame(
-    LACE* hLACE,
+    const LACE* hLACE,
     LACEState *state,
     float *x_out,
     const float *x_in,
@@ -372,7 +372,7 @@ static void reset_nolace_state(NoLACEState *state)
 }
 
 static void nolace_feature_net(
-    NoLACE *hNoLACE,
+    const NoLACE *hNoLACE,
     NoLACEState *state,
     float *output,
     const float *features,
@@ -447,7 +447,7 @@ static void nolace_feature_net(
 
 
 static void nolace_process_20ms_frame(
-    NoLACE* hNoLACE,
+    const NoLACE* hNoLACE,
     NoLACEState *state,
     float *x_out,
     const float *x_in,
@@ -462,7 +462,7 @@ static void nolace_process_20ms_frame(
     float x_buffer1[8 * NOLACE_FRAME_SIZE];
     float x_buffer2[8 * NOLACE_FRAME_SIZE];
     int i_subframe, i_sample;
-    NOLACELayers *layers = &hNoLACE->layers;
+    const NOLACELayers *layers = &hNoLACE->layers;
 
 #ifdef DEBUG_NOLACE
     static FILE *f_features=NULL, *f_encfeatures=NULL, *f_xin=NULL, *f_xpreemph=NULL, *f_postcf1=NULL;
@@ -873,24 +873,31 @@ static void print_linear_layer(FILE *fid, const char *name, LinearLayer *layer)
 }
 #endif
 
-int osce_load_models(OSCEModel *model, const void *data, int len)
+int osce_init_models(OSCEModel *model, const WeightArray *list)
 {
     int ret = 0;
-    WeightArray *list;
-
-    if (data != NULL  && len)
-    {
-        /* init from buffer */
-        parse_weights(&list, data, len);
 
 #ifndef DISABLE_LACE
-        if (ret == 0) {ret = init_lace(&model->lace, list);}
+    if (ret == 0) {ret = init_lace(&model->lace, list);}
 #endif
 
 #ifndef DISABLE_NOLACE
-        if (ret == 0) {ret = init_nolace(&model->nolace, list);}
+    if (ret == 0) {ret = init_nolace(&model->nolace, list);}
 #endif
 
+    return ret ? -1 : 0;
+}
+
+int osce_load_models(OSCEModel *model, const void *data, int len)
+{
+    int ret = 0;
+    WeightArray *list;
+
+    if (data != NULL  && len)
+    {
+        /* init from buffer */
+        parse_weights(&list, data, len);
+        ret = osce_init_models(model, list);
         free(list);
     } else
     {
@@ -913,7 +920,7 @@ int osce_load_models(OSCEModel *model, const void *data, int len)
 }
 
 void osce_enhance_frame(
-    OSCEModel                   *model,                         /* I    OSCE model struct                           */
+    const OSCEModel             *model,                         /* I    OSCE model struct                           */
     silk_decoder_state          *psDec,                         /* I/O  Decoder state                               */
     silk_decoder_control        *psDecCtrl,                     /* I    Decoder control                             */
     opus_int16                  xq[],                           /* I/O  Decoded speech                              */
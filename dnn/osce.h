@@ -68,7 +68,7 @@
 
 
 void osce_enhance_frame(
-    OSCEModel                   *model,                         /* I    OSCE model struct                           */
+    const OSCEModel             *model,                         /* I    OSCE model struct                           */
     silk_decoder_state          *psDec,                         /* I/O  Decoder state                               */
     silk_decoder_control        *psDecCtrl,                     /* I    Decoder control                             */
     opus_int16                  xq[],                           /* I/O  Decoded speech                              */
@@ -78,6 +78,7 @@ void osce_enhance_frame(
 
 
 int osce_load_models(OSCEModel *hModel, const void *data, int len);
+int osce_init_models(OSCEModel *hModel, const WeightArray *list);
 void osce_reset(silk_OSCE_struct *hOSCE, int method);
 
 
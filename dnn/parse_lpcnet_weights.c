@@ -40,6 +40,7 @@ int parse_record(const void **data, int *len, WeightArray *array) {
   if (*len < WEIGHT_BLOCK_SIZE) return -1;
   if (h->block_size < h->size) return -1;
   if (h->block_size > *len-WEIGHT_BLOCK_SIZE) return -1;
+  if (h->version >= 1 && h->block_size%WEIGHT_BLOCK_SIZE != 0) return -1;
   if (h->name[sizeof(h->name)-1] != 0) return -1;
   if (h->size < 0) return -1;
   array->name = h->name;
@@ -52,33 +53,107 @@ int parse_record(const void **data, int *len, WeightArray *array) {
   return array->size;
 }
 
+/* FNV-1a, also used by write_lpcnet_weights to build the index. */
+opus_uint32 weight_name_hash(const char *name) {
+  opus_uint32 hash = 2166136261U;
+  while (*name) {
+    hash ^= (unsigned char)*name++;
+    hash *= 16777619U;
+  }
+  return hash;
+}
+
+/* Checks that the index stored in a blob only refers to existing records and
+   has at least one empty bucket, so that lookups always terminate. */
+static int check_index(const WeightArray *index, int nb_arrays) {
+  const WeightIndexEntry *table = index->data;
+  int nb_buckets;
+  int nb_empty=0;
+  int i;
+  if (index->size % sizeof(WeightIndexEntry) != 0) return 0;
+  nb_buckets = index->size/sizeof(WeightIndexEntry);
+  if (nb_buckets == 0 || (nb_buckets & (nb_buckets-1)) != 0) return 0;
+  for (i=0;i<nb_buckets;i++) {
+    if (table[i].record == WEIGHT_INDEX_EMPTY) nb_empty++;
+    else if (table[i].record >= (opus_uint32)nb_arrays) return 0;
+  }
+  return nb_empty > 0;
+}
+
 int parse_weights(WeightArray **list, const void *data, int len)
 {
   int nb_arrays=0;
-  int capacity=20;
-  *list = opus_alloc(capacity*sizeof(WeightArray));
-  while (len > 0) {
-    int ret;
+  int nb_buckets;
+  int has_index=0;
+  int i;
+  const void *p;
+  int remain;
+  WeightArray index = {NULL, 0, 0, NULL};
+  WeightIndexEntry *table;
+  *list = NULL;
+  /* Validate and count the records so that the list is allocated once. */
+  p = data;
+  remain = len;
+  while (remain > 0) {
     WeightArray array = {NULL, 0, 0, 0};
-    ret = parse_record(&data, &len, &array);
-    if (ret > 0) {
-      if (nb_arrays+1 >= capacity) {
-        /* Make sure there's room for the ending NULL element too. */
-        capacity = capacity*3/2;
-        *list = opus_realloc(*list, capacity*sizeof(WeightArray));
-      }
-      (*list)[nb_arrays++] = array;
+    if (parse_record(&p, &remain, &array) <= 0) return -1;
+    if (nb_arrays == 0 && !has_index && array.type == WEIGHT_TYPE_index && strcmp(array.name, WEIGHT_INDEX_NAME) == 0) {
+      index = array;
+      has_index = 1;
     } else {
-      opus_free(*list);
-      *list = NULL;
-      return -1;
+      nb_arrays++;
     }
   }
-  (*list)[nb_arrays].name=NULL;
+  if (has_index && !check_index(&index, nb_arrays)) return -1;
+  if (has_index) {
+    nb_buckets = index.size/sizeof(WeightIndexEntry);
+  } else {
+    nb_buckets = 2;
+    while (nb_buckets < 2*nb_arrays) nb_buckets <<= 1;
+  }
+  /* One extra entry at each end for the index and the ending NULL element. */
+  *list = opus_alloc((nb_arrays+2)*sizeof(WeightArray) + (has_index ? 0 : nb_buckets*sizeof(WeightIndexEntry)));
+  if (*list == NULL) return -1;
+  p = data;
+  remain = len;
+  /* Skip the index. */
+  if (has_index) parse_record(&p, &remain, &index);
+  for (i=0;i<nb_arrays;i++) parse_record(&p, &remain, &(*list)[i+1]);
+  (*list)[nb_arrays+1].name=NULL;
+  if (!has_index) {
+    /* Version 0 blob (or a v1 blob without index): build the index here. */
+    table = (WeightIndexEntry*)(void*)&(*list)[nb_arrays+2];
+    for (i=0;i<nb_buckets;i++) table[i].record = WEIGHT_INDEX_EMPTY;
+    for (i=0;i<nb_arrays;i++) {
+      opus_uint32 hash = weight_name_hash((*list)[i+1].name);
+      opus_uint32 pos = hash & (nb_buckets-1);
+      while (table[pos].record != WEIGHT_INDEX_EMPTY) pos = (pos+1) & (nb_buckets-1);
+      table[pos].hash = hash;
+      table[pos].record = i;
+    }
+    index.data = table;
+  }
+  (*list)[0].name = WEIGHT_INDEX_NAME;
+  (*list)[0].type = WEIGHT_TYPE_index;
+  (*list)[0].size = nb_buckets;
+  (*list)[0].data = index.data;
   return nb_arrays;
 }
 
 static const void *find_array_entry(const WeightArray *arrays, const char *name) {
+  static const WeightArray end = {NULL, 0, 0, NULL};
+  if (arrays->type == WEIGHT_TYPE_index) {
+    /* List from parse_weights(): hashed lookup. */
+    const WeightIndexEntry *table = arrays->data;
+    opus_uint32 mask = arrays->size-1;
+    opus_uint32 hash = weight_name_hash(name);
+    opus_uint32 pos;
+    for (pos = hash & mask; table[pos].record != WEIGHT_INDEX_EMPTY; pos = (pos+1) & mask) {
+      const WeightArray *a = &arrays[1+table[pos].record];
+      if (table[pos].hash == hash && strcmp(a->name, name) == 0) return a;
+    }
+    return &end;
+  }
   while (arrays->name && strcmp(arrays->name, name) != 0) arrays++;
   return arrays;
 }
@@ -96,6 +171,21 @@ static const void *opt_array_check(const WeightArray *arrays, const char *name,
   else return NULL;
 }
 
+/* Float weights may be stored either as float or (WEIGHT_TYPE_float16) as
+   half-precision, in which case the pointer goes to *float16 instead. */
+static const float *opt_float_array_check(const WeightArray *arrays, const char *name, int nb_weights, const opus_uint16 **float16, int *error) {
+  const WeightArray *a = find_array_entry(arrays, name);
+  *float16 = NULL;
+  if (a->name && a->type == WEIGHT_TYPE_float16) {
+    *error = a->size != nb_weights*(int)sizeof(opus_uint16);
+    if (!*error) *float16 = a->data;
+    return NULL;
+  }
+  *error = (a->name != NULL && a->size != nb_weights*(int)sizeof(float));
+  if (a->name && !*error) return a->data;
+  else return NULL;
+}
+
 static const void *find_idx_check(const WeightArray *arrays, const char *name, int nb_in, int nb_out, int *total_blocks) {
   int remain;
   const int *idx;
@@ -137,6 +227,7 @@ int linear_init(LinearLayer *layer, const WeightArray *arrays,
   layer->subias = NULL;
   layer->weights = NULL;
   layer->float_weights = NULL;
+  layer->float16_weights = NULL;
   layer->weights_idx = NULL;
   layer->diag = NULL;
   layer->scale = NULL;
@@ -161,7 +252,7 @@ int linear_init(LinearLayer *layer, const WeightArray *arrays,
       if ((layer->weights = find_array_check(arrays, weights, nb_inputs*nb_outputs*sizeof(layer->weights[0]))) == NULL) return 1;
     }
     if (float_weights != NULL) {
-      layer->float_weights = opt_array_check(arrays, float_weights, nb_inputs*nb_outputs*sizeof(layer->float_weights[0]), &err);
+      layer->float_weights = opt_float_array_check(arrays, float_weights, nb_inputs*nb_outputs, &layer->float16_weights, &err);
       if (err) return 1;
     }
   }
@@ -187,12 +278,14 @@ int conv2d_init(Conv2dLayer *layer, const WeightArray *arrays,
   int err;
   layer->bias = NULL;
   layer->float_weights = NULL;
+  layer->float16_weights = NULL;
   if (bias != NULL) {
     if ((layer->bias = find_array_check(arrays, bias, out_channels*sizeof(layer->bias[0]))) == NULL) return 1;
   }
   if (float_weights != NULL) {
-    layer->float_weights = opt_array_check(arrays, float_weights, in_channels*out_channels*ktime*kheight*sizeof(layer->float_weights[0]), &err);
+    layer->float_weights = opt_float_array_check(arrays, float_weights, in_channels*out_channels*ktime*kheight, &layer->float16_weights, &err);
     if (err) return 1;
+    if (layer->float16_weights != NULL && in_channels*out_channels*ktime*kheight > MAX_CONV2D_F16_WEIGHTS) return 1;
   }
   layer->in_channels = in_channels;
   layer->out_channels = out_channels;
@@ -226,7 +319,7 @@ int main()
   data = mmap(NULL, len, PROT_READ, MAP_SHARED, fd, 0);
   printf("size is %d\n", len);
   nb_arrays = parse_weights(&list, data, len);
-  for (i=0;i<nb_arrays;i++) {
+  for (i=1;i<=nb_arrays;i++) {
     printf("found %s: size %d\n", list[i].name, list[i].size);
   }
   printf("%p\n", list[i].name);
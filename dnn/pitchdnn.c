@@ -27,7 +27,7 @@ float compute_pitchdnn(
   float maxval=-1;
   float sum=0;
   float count=0;
-  PitchDNN *model = &st->model;
+  const PitchDNN *model = st->shared_model ? st->shared_model : &st->model;
   /* IF */
   compute_generic_dense(&model->dense_if_upsampler_1, if1_out, if_features, ACTIVATION_TANH, arch);
   compute_generic_dense(&model->dense_if_upsampler_2, &downsampler_in[NB_XCORR_FEATURES], if1_out, ACTIVATION_TANH, arch);
@@ -14,6 +14,8 @@ typedef struct PitchDNN PitchDNN;
 
 typedef struct {
   PitchDNN model;
+  /* Tables of an attached OpusDNNModel, used instead of model when set. */
+  const PitchDNN *shared_model;
   float gru_state[GRU_1_STATE_SIZE];
   float xcorr_mem1[(NB_XCORR_FEATURES + 2)*2];
   float xcorr_mem2[(NB_XCORR_FEATURES + 2)*2*8];
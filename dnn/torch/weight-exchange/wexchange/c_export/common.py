@@ -44,9 +44,13 @@ def print_vector(writer, vector, name, dtype='float', reshape_8x4=False, static=
         'opus_uint16' : 'uint16',
         'opus_int16' : 'int16',
         'int' : 'int',
-        'qweight': 'qweight'
+        'qweight': 'qweight',
+        'float16': 'float16'
     }
 
+    # half-precision values are stored as their IEEE bit patterns
+    ctype = 'opus_uint16' if dtype == 'float16' else dtype
+
 
     if binary_blob:
         f.write(
@@ -61,6 +65,8 @@ f'''
         vector = vector.transpose((2, 0, 3, 1))
 
     v = np.reshape(vector, (-1))
+    if dtype == 'float16':
+        v = v.astype(np.float16).view(np.uint16)
 
     if debug_float:
         f.write('#ifndef DISABLE_DEBUG_FLOAT\n')
@@ -74,7 +80,7 @@ f'''
     if static:
         f.write('static ')
 
-    f.write(f'const {dtype} {name}[{len(v)}] = {{\n    ')
+    f.write(f'const {ctype} {name}[{len(v)}] = {{\n    ')
 
     for i in range(0, len(v)):
 
@@ -197,7 +203,8 @@ def print_linear_layer(writer : CWriter,
                        scale : np.ndarray = None,
                        sparse : bool = False,
                        diagonal : bool = False,
-                       quantize : bool = True):
+                       quantize : bool = True,
+                       float16 : bool = False):
 
     """ prints linear layer
 
@@ -209,6 +216,8 @@ def print_linear_layer(writer : CWriter,
     ...
     scale: np.ndarray or None
         If None auto scaling will be applied. Otherwise, output channels will be multiplied by scale (the usual broadcasting rules apply).
+    float16: bool
+        If True, float weights are stored as half-precision. Only supported for non-sparse layers.
 
 
     """
@@ -216,6 +225,9 @@ def print_linear_layer(writer : CWriter,
     if len(weight.shape) != 2:
         raise ValueError('expecting 2-dim weight array in print_linear_layer')
 
+    if float16 and sparse:
+        raise ValueError('float16 weights are not supported for sparse layers')
+
 
     bias_name           = "NULL" if bias is None else name + "_bias"
     subias_name         = name + "_subias" if quantize else "NULL"
@@ -238,7 +250,7 @@ def print_linear_layer(writer : CWriter,
             weight_q = quantize_weight(weight, scale)
             print_vector(writer, weight_q, name + "_weights_int8", dtype='opus_int8', reshape_8x4=True)
 
-        print_vector(writer, weight, name + "_weights_float", dtype='float', reshape_8x4=False, debug_float=quantize)
+        print_vector(writer, weight, name + "_weights_float", dtype='float16' if float16 else 'float', reshape_8x4=False, debug_float=quantize)
 
     if quantize:
         subias = (np.zeros(nb_outputs) if bias is None else bias) - np.sum(weight_q * scale, axis=0)
@@ -265,12 +277,13 @@ def print_dense_layer(writer : CWriter,
                       format : str = 'torch',
                       sparse=False,
                       diagonal=False,
-                      quantize=False):
+                      quantize=False,
+                      float16=False):
 
     if format == 'torch':
         weight = weight.transpose()
 
-    print_linear_layer(writer, name, weight, bias, scale=scale, sparse=sparse, diagonal=diagonal, quantize=quantize)
+    print_linear_layer(writer, name, weight, bias, scale=scale, sparse=sparse, diagonal=diagonal, quantize=quantize, float16=float16)
 
     writer.header.write(f"\n#define {name.upper()}_OUT_SIZE {weight.shape[1]}\n")
 
@@ -282,7 +295,8 @@ def print_conv1d_layer(writer : CWriter,
                        scale=1/128,
                        format : str = 'torch',
                        quantize=False,
-                       sparse=False):
+                       sparse=False,
+                       float16=False):
 
 
     if format == "torch":
@@ -290,7 +304,7 @@ def print_conv1d_layer(writer : CWriter,
         weight = np.transpose(weight, (2, 1, 0))
 
     lin_weight = np.reshape(weight, (-1, weight.shape[-1]))
-    print_linear_layer(writer, name, lin_weight, bias, scale=scale, sparse=sparse, diagonal=False, quantize=quantize)
+    print_linear_layer(writer, name, lin_weight, bias, scale=scale, sparse=sparse, diagonal=False, quantize=quantize, float16=float16)
 
 
     writer.header.write(f"\n#define {name.upper()}_OUT_SIZE {weight.shape[2]}\n")
@@ -305,7 +319,8 @@ def print_conv2d_layer(writer : CWriter,
                        weight : np.ndarray,
                        bias : np.ndarray,
                        scale : float=1/128,
-                       quantize : bool=False):
+                       quantize : bool=False,
+                       float16 : bool=False):
 
     if quantize:
         print("[print_conv2d_layer] warning: quantize argument ignored")
@@ -313,7 +328,7 @@ def print_conv2d_layer(writer : CWriter,
     bias_name = name + "_bias"
     float_weight_name = name + "_weight_float"
 
-    print_vector(writer, weight, float_weight_name)
+    print_vector(writer, weight, float_weight_name, dtype='float16' if float16 else 'float')
     print_vector(writer, bias, bias_name)
 
     # init function
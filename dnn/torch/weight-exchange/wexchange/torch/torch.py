@@ -246,7 +246,7 @@ def load_torch_gru_weights(where, gru):
         gru.bias_hh_l0.set_(torch.from_numpy(b_hh))
 
 
-def dump_torch_dense_weights(where, dense, name='dense', scale=1/128, sparse=False, diagonal=False, quantize=False):
+def dump_torch_dense_weights(where, dense, name='dense', scale=1/128, sparse=False, diagonal=False, quantize=False, float16=False):
 
     w = dense.weight.detach().cpu().numpy().copy()
     if dense.bias is None:
@@ -255,7 +255,7 @@ def dump_torch_dense_weights(where, dense, name='dense', scale=1/128, sparse=Fal
         b = dense.bias.detach().cpu().numpy().copy()
 
     if isinstance(where, CWriter):
-        return print_dense_layer(where, name, w, b, scale=scale, format='torch', sparse=sparse, diagonal=diagonal, quantize=quantize)
+        return print_dense_layer(where, name, w, b, scale=scale, format='torch', sparse=sparse, diagonal=diagonal, quantize=quantize, float16=float16)
 
     else:
         os.makedirs(where, exist_ok=True)
@@ -275,7 +275,7 @@ def load_torch_dense_weights(where, dense):
             dense.bias.set_(torch.from_numpy(b))
 
 
-def dump_torch_conv1d_weights(where, conv, name='conv', scale=1/128, quantize=False, sparse=False):
+def dump_torch_conv1d_weights(where, conv, name='conv', scale=1/128, quantize=False, sparse=False, float16=False):
 
     w = conv.weight.detach().cpu().numpy().copy()
     if conv.bias is None:
@@ -285,7 +285,7 @@ def dump_torch_conv1d_weights(where, conv, name='conv', scale=1/128, quantize=Fa
 
     if isinstance(where, CWriter):
 
-        return print_conv1d_layer(where, name, w, b, scale=scale, format='torch', quantize=quantize, sparse=sparse)
+        return print_conv1d_layer(where, name, w, b, scale=scale, format='torch', quantize=quantize, sparse=sparse, float16=float16)
     else:
         os.makedirs(where, exist_ok=True)
 
@@ -335,7 +335,7 @@ def load_torch_tconv1d_weights(where, conv):
                 conv.bias.set_(torch.from_numpy(b))
 
 
-def dump_torch_conv2d_weights(where, conv, name='conv', scale=1/128, quantize=False):
+def dump_torch_conv2d_weights(where, conv, name='conv', scale=1/128, quantize=False, float16=False):
     w = conv.weight.detach().cpu().permute(0, 1, 3, 2).numpy().copy()
     if conv.bias is None:
         b = np.zeros(conv.out_channels, dtype=w.dtype)
@@ -343,7 +343,7 @@ def dump_torch_conv2d_weights(where, conv, name='conv', scale=1/128, quantize=Fa
         b = conv.bias.detach().cpu().numpy().copy()
 
     if isinstance(where, CWriter):
-        return print_conv2d_layer(where, name, w, b, scale=scale, quantize=quantize)
+        return print_conv2d_layer(where, name, w, b, scale=scale, quantize=quantize, float16=float16)
 
     else:
         os.makedirs(where, exist_ok=True)
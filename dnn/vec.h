@@ -34,6 +34,30 @@
 #include "arch.h"
 #include "x86/x86_arch_macros.h"
 
+/* Widens an IEEE half-precision value (as stored in WEIGHT_TYPE_float16
+   arrays) to float. */
+static inline float float16_to_float(opus_uint16 h)
+{
+   union {
+      opus_uint32 i;
+      float f;
+   } u;
+   opus_uint32 sign, e, m;
+   sign = (opus_uint32)(h&0x8000)<<16;
+   e = (h>>10)&0x1F;
+   m = h&0x3FF;
+   if (e == 0) {
+      /* Zero or subnormal: m*2^-24. */
+      u.f = m*(1.f/16777216.f);
+      u.i |= sign;
+   } else if (e == 31) {
+      u.i = sign | 0x7F800000 | (m<<13);
+   } else {
+      u.i = sign | ((e+112)<<23) | (m<<13);
+   }
+   return u.f;
+}
+
 
 #if defined(__AVX__) || defined(__SSE2__)
 #include "vec_avx.h"
@@ -386,4 +410,50 @@ static inline void vec_sigmoid(float *y, const float *x, int N)
 #define SCALE_1 (1.f/128.f/127.f)
 
 #endif /*no optimizations*/
+
+#ifndef VEC_HAVE_SGEMV_F16
+/* Same as sgemv() with half-precision weights. */
+static inline void sgemv_f16(float *out, const opus_uint16 *weights, int rows, int cols, int col_stride, const float *x)
+{
+   int i, j;
+   for (i=0;i<rows;i++) out[i] = 0;
+   for (j=0;j<cols;j++)
+   {
+      const opus_uint16 *w;
+      float xj;
+      w = &weights[j*col_stride];
+      xj = x[j];
+      for (i=0;i<rows;i++) out[i] += float16_to_float(w[i])*xj;
+   }
+}
+#endif
+
+#ifndef VEC_HAVE_GEMM
+/* Batched products over K inputs (spaced by x_stride) writing K outputs (spaced
+   by out_stride). Without a dedicated kernel, run one matrix-vector product per
+   input. */
+static inline void sgemm(float *out, int out_stride, const float *weights, int rows, int cols, int col_stride, const float *x, int x_stride, int K)
+{
+   int k;
+   for (k=0;k<K;k++) sgemv(&out[k*out_stride], weights, rows, cols, col_stride, &x[k*x_stride]);
+}
+
+static inline void sparse_sgemm8x4(float *out, int out_stride, const float *weights, const int *idx, int rows, const float *x, int x_stride, int K)
+{
+   int k;
+   for (k=0;k<K;k++) sparse_sgemv8x4(&out[k*out_stride], weights, idx, rows, &x[k*x_stride]);
+}
+
+static inline void sparse_cgemm8x4(float *out, int out_stride, const opus_int8 *w, const int *idx, const float *scale, int rows, int cols, const float *x, int x_stride, int K)
+{
+   int k;
+   for (k=0;k<K;k++) sparse_cgemv8x4(&out[k*out_stride], w, idx, scale, rows, cols, &x[k*x_stride]);
+}
+
+static inline void cgemm8x4(float *out, int out_stride, const opus_int8 *w, const float *scale, int rows, int cols, const float *x, int x_stride, int K)
+{
+   int k;
+   for (k=0;k<K;k++) cgemv8x4(&out[k*out_stride], w, scale, rows, cols, &x[k*x_stride]);
+}
+#endif
 #endif /*VEC_H*/
@@ -620,10 +620,14 @@ static inline void vec_sigmoid(float *y, const float *x, int N)
 
 #endif
 
-#if defined(__AVXVNNI__) || defined(__AVX512VNNI__)
+#if defined(__AVX512VNNI__) && defined(__AVX512VL__)
 
 #define opus_mm256_dpbusds_epi32(src, a, b) _mm256_dpbusds_epi32(src, a, b)
 
+#elif defined(__AVXVNNI__)
+
+#define opus_mm256_dpbusds_epi32(src, a, b) _mm256_dpbusds_avx_epi32(src, a, b)
+
 #elif defined(__AVX2__)
 
 static inline __m256i opus_mm256_dpbusds_epi32(__m256i src, __m256i a, __m256i b) {
@@ -736,6 +740,61 @@ static inline void sgemv(float *out, const float *weights, int rows, int cols, i
   }
 }
 
+#ifdef __F16C__
+#define VEC_HAVE_SGEMV_F16
+/* Same as sgemv() with half-precision weights, widened to float as they are
+   loaded. */
+static inline void sgemv_f16(float *out, const opus_uint16 *weights, int rows, int cols, int col_stride, const float *x)
+{
+  int i, j;
+  i=0;
+  for (;i<rows-15;i+=16)
+  {
+     float *y;
+     __m256 vy0, vy8;
+     y = &out[i];
+     vy0 = _mm256_setzero_ps();
+     vy8 = _mm256_setzero_ps();
+     for (j=0;j<cols;j++)
+     {
+        __m256 vxj;
+        __m256 vw;
+        vxj = _mm256_broadcast_ss(&x[j]);
+
+        vw = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(const void *)&weights[j*col_stride + i]));
+        vy0 = _mm256_fmadd_ps(vw, vxj, vy0);
+
+        vw = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(const void *)&weights[j*col_stride + i + 8]));
+        vy8 = _mm256_fmadd_ps(vw, vxj, vy8);
+     }
+     _mm256_storeu_ps (&y[0], vy0);
+     _mm256_storeu_ps (&y[8], vy8);
+  }
+  for (;i<rows-7;i+=8)
+  {
+     float *y;
+     __m256 vy0;
+     y = &out[i];
+     vy0 = _mm256_setzero_ps();
+     for (j=0;j<cols;j++)
+     {
+        __m256 vxj;
+        __m256 vw;
+        vxj = _mm256_broadcast_ss(&x[j]);
+
+        vw = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)(const void *)&weights[j*col_stride + i]));
+        vy0 = _mm256_fmadd_ps(vw, vxj, vy0);
+     }
+     _mm256_storeu_ps (&y[0], vy0);
+  }
+  for (;i<rows;i++)
+  {
+    out[i] = 0;
+    for (j=0;j<cols;j++) out[i] += float16_to_float(weights[j*col_stride + i])*x[j];
+  }
+}
+#endif
+
 static inline void sparse_sgemv8x4(float *out, const float *weights, const int *idx, int rows, const float *x)
 {
    int i, j;
@@ -790,26 +849,33 @@ static inline void sparse_cgemv8x4(float *_out, const opus_int8 *w, const int *i
       vy0 = _mm256_setzero_si256();
       j=0;
 #if 1 /* Unrolling by 4 gives some gain, comment out if it does not. */
-      for (;j<colblocks-3;j+=4)
       {
-         __m256i vxj;
-         __m256i vw;
-         vxj = _mm256_broadcastd_epi32(_mm_loadu_si32(&x[*idx++]));
-         vw = _mm256_loadu_si256((const __m256i *)(void*)w);
-         vy0 = opus_mm256_dpbusds_epi32(vy0, vxj, vw);
-         w += 32;
-         vxj = _mm256_broadcastd_epi32(_mm_loadu_si32(&x[*idx++]));
-         vw = _mm256_loadu_si256((const __m256i *)(void*)w);
-         vy0 = opus_mm256_dpbusds_epi32(vy0, vxj, vw);
-         w += 32;
-         vxj = _mm256_broadcastd_epi32(_mm_loadu_si32(&x[*idx++]));
-         vw = _mm256_loadu_si256((const __m256i *)(void*)w);
-         vy0 = opus_mm256_dpbusds_epi32(vy0, vxj, vw);
-         w += 32;
-         vxj = _mm256_broadcastd_epi32(_mm_loadu_si32(&x[*idx++]));
-         vw = _mm256_loadu_si256((const __m256i *)(void*)w);
-         vy0 = opus_mm256_dpbusds_epi32(vy0, vxj, vw);
-         w += 32;
+         /* Separate accumulators keep the (multi-cycle latency) VNNI
+            instructions from being serialized. */
+         __m256i vy1, vy2, vy3;
+         vy1 = vy2 = vy3 = _mm256_setzero_si256();
+         for (;j<colblocks-3;j+=4)
+         {
+            __m256i vxj;
+            __m256i vw;
+            vxj = _mm256_broadcastd_epi32(_mm_loadu_si32(&x[*idx++]));
+            vw = _mm256_loadu_si256((const __m256i *)(void*)w);
+            vy0 = opus_mm256_dpbusds_epi32(vy0, vxj, vw);
+            w += 32;
+            vxj = _mm256_broadcastd_epi32(_mm_loadu_si32(&x[*idx++]));
+            vw = _mm256_loadu_si256((const __m256i *)(void*)w);
+            vy1 = opus_mm256_dpbusds_epi32(vy1, vxj, vw);
+            w += 32;
+            vxj = _mm256_broadcastd_epi32(_mm_loadu_si32(&x[*idx++]));
+            vw = _mm256_loadu_si256((const __m256i *)(void*)w);
+            vy2 = opus_mm256_dpbusds_epi32(vy2, vxj, vw);
+            w += 32;
+            vxj = _mm256_broadcastd_epi32(_mm_loadu_si32(&x[*idx++]));
+            vw = _mm256_loadu_si256((const __m256i *)(void*)w);
+            vy3 = opus_mm256_dpbusds_epi32(vy3, vxj, vw);
+            w += 32;
+         }
+         vy0 = _mm256_add_epi32(_mm256_add_epi32(vy0, vy1), _mm256_add_epi32(vy2, vy3));
       }
 #endif
       for (;j<colblocks;j++)
@@ -839,26 +905,33 @@ static inline void cgemv8x4(float *_out, const opus_int8 *w, const float *scale,
       vy0 = _mm256_setzero_si256();
       j=0;
 #if 1 /* Unrolling by 4 gives some gain, comment out if it does not. */
-      for (;j<cols-12;j+=16)
       {
-         __m256i vxj;
-         __m256i vw;
-         vxj = _mm256_broadcastd_epi32(_mm_loadu_si32(&x[j]));
-         vw = _mm256_loadu_si256((const __m256i *)(void*)w);
-         vy0 = opus_mm256_dpbusds_epi32(vy0, vxj, vw);
-         w += 32;
-         vxj = _mm256_broadcastd_epi32(_mm_loadu_si32(&x[j+4]));
-         vw = _mm256_loadu_si256((const __m256i *)(void*)w);
-         vy0 = opus_mm256_dpbusds_epi32(vy0, vxj, vw);
-         w += 32;
-         vxj = _mm256_broadcastd_epi32(_mm_loadu_si32(&x[j+8]));
-         vw = _mm256_loadu_si256((const __m256i *)(void*)w);
-         vy0 = opus_mm256_dpbusds_epi32(vy0, vxj, vw);
-         w += 32;
-         vxj = _mm256_broadcastd_epi32(_mm_loadu_si32(&x[j+12]));
-         vw = _mm256_loadu_si256((const __m256i *)(void*)w);
-         vy0 = opus_mm256_dpbusds_epi32(vy0, vxj, vw);
-         w += 32;
+         /* Separate accumulators keep the (multi-cycle latency) VNNI
+            instructions from being serialized. */
+         __m256i vy1, vy2, vy3;
+         vy1 = vy2 = vy3 = _mm256_setzero_si256();
+         for (;j<cols-12;j+=16)
+         {
+            __m256i vxj;
+            __m256i vw;
+            vxj = _mm256_broadcastd_epi32(_mm_loadu_si32(&x[j]));
+            vw = _mm256_loadu_si256((const __m256i *)(void*)w);
+            vy0 = opus_mm256_dpbusds_epi32(vy0, vxj, vw);
+            w += 32;
+            vxj = _mm256_broadcastd_epi32(_mm_loadu_si32(&x[j+4]));
+            vw = _mm256_loadu_si256((const __m256i *)(void*)w);
+            vy1 = opus_mm256_dpbusds_epi32(vy1, vxj, vw);
+            w += 32;
+            vxj = _mm256_broadcastd_epi32(_mm_loadu_si32(&x[j+8]));
+            vw = _mm256_loadu_si256((const __m256i *)(void*)w);
+            vy2 = opus_mm256_dpbusds_epi32(vy2, vxj, vw);
+            w += 32;
+            vxj = _mm256_broadcastd_epi32(_mm_loadu_si32(&x[j+12]));
+            vw = _mm256_loadu_si256((const __m256i *)(void*)w);
+            vy3 = opus_mm256_dpbusds_epi32(vy3, vxj, vw);
+            w += 32;
+         }
+         vy0 = _mm256_add_epi32(_mm256_add_epi32(vy0, vy1), _mm256_add_epi32(vy2, vy3));
       }
 #endif
       for (;j<cols;j+=4)
@@ -876,6 +949,206 @@ static inline void cgemv8x4(float *_out, const opus_int8 *w, const float *scale,
    }
 }
 
+/* Batched products over K inputs (spaced by x_stride) writing K outputs (spaced
+   by out_stride). Each weight load is shared by four inputs and every output is
+   accumulated in the same order as the single-vector kernels above, so the
+   results are identical to calling them once per input. */
+#define VEC_HAVE_GEMM
+
+static inline void sgemm(float *out, int out_stride, const float *weights, int rows, int cols, int col_stride, const float *x, int x_stride, int K)
+{
+  int i, j, k;
+  for (k=0;k<K-3;k+=4)
+  {
+     const float *x0, *x1, *x2, *x3;
+     x0 = &x[k*x_stride];
+     x1 = x0 + x_stride;
+     x2 = x1 + x_stride;
+     x3 = x2 + x_stride;
+     for (i=0;i<rows-15;i+=16)
+     {
+        float *y;
+        __m256 vy00, vy08, vy10, vy18, vy20, vy28, vy30, vy38;
+        vy00 = vy08 = vy10 = vy18 = _mm256_setzero_ps();
+        vy20 = vy28 = vy30 = vy38 = _mm256_setzero_ps();
+        for (j=0;j<cols;j++)
+        {
+           __m256 vxj;
+           __m256 vw0, vw8;
+           vw0 = _mm256_loadu_ps(&weights[j*col_stride + i]);
+           vw8 = _mm256_loadu_ps(&weights[j*col_stride + i + 8]);
+
+           vxj = _mm256_broadcast_ss(&x0[j]);
+           vy00 = _mm256_fmadd_ps(vw0, vxj, vy00);
+           vy08 = _mm256_fmadd_ps(vw8, vxj, vy08);
+
+           vxj = _mm256_broadcast_ss(&x1[j]);
+           vy10 = _mm256_fmadd_ps(vw0, vxj, vy10);
+           vy18 = _mm256_fmadd_ps(vw8, vxj, vy18);
+
+           vxj = _mm256_broadcast_ss(&x2[j]);
+           vy20 = _mm256_fmadd_ps(vw0, vxj, vy20);
+           vy28 = _mm256_fmadd_ps(vw8, vxj, vy28);
+
+           vxj = _mm256_broadcast_ss(&x3[j]);
+           vy30 = _mm256_fmadd_ps(vw0, vxj, vy30);
+           vy38 = _mm256_fmadd_ps(vw8, vxj, vy38);
+        }
+        y = &out[k*out_stride + i];
+        _mm256_storeu_ps (&y[0], vy00);
+        _mm256_storeu_ps (&y[8], vy08);
+        y += out_stride;
+        _mm256_storeu_ps (&y[0], vy10);
+        _mm256_storeu_ps (&y[8], vy18);
+        y += out_stride;
+        _mm256_storeu_ps (&y[0], vy20);
+        _mm256_storeu_ps (&y[8], vy28);
+        y += out_stride;
+        _mm256_storeu_ps (&y[0], vy30);
+        _mm256_storeu_ps (&y[8], vy38);
+     }
+     if (i<rows)
+     {
+        sgemv(&out[k*out_stride + i], &weights[i], rows-i, cols, col_stride, x0);
+        sgemv(&out[(k+1)*out_stride + i], &weights[i], rows-i, cols, col_stride, x1);
+        sgemv(&out[(k+2)*out_stride + i], &weights[i], rows-i, cols, col_stride, x2);
+        sgemv(&out[(k+3)*out_stride + i], &weights[i], rows-i, cols, col_stride, x3);
+     }
+  }
+  for (;k<K;k++) sgemv(&out[k*out_stride], weights, rows, cols, col_stride, &x[k*x_stride]);
+}
+
+static inline void sparse_sgemm8x4(float *out, int out_stride, const float *weights, const int *idx, int rows, const float *x, int x_stride, int K)
+{
+   int i, j, k;
+   for (k=0;k<K-3;k+=4)
+   {
+      const float *x0, *x1, *x2, *x3;
+      const float *w;
+      const int *id_ptr;
+      x0 = &x[k*x_stride];
+      x1 = x0 + x_stride;
+      x2 = x1 + x_stride;
+      x3 = x2 + x_stride;
+      w = weights;
+      id_ptr = idx;
+      for (i=0;i<rows;i+=8)
+      {
+         float *y;
+         int cols;
+         __m256 vy0, vy1, vy2, vy3;
+         vy0 = vy1 = vy2 = vy3 = _mm256_setzero_ps();
+         cols = *id_ptr++;
+         for (j=0;j<cols;j++)
+         {
+            int id;
+            int m;
+            id = *id_ptr++;
+            for (m=0;m<4;m++)
+            {
+               __m256 vw;
+               vw = _mm256_loadu_ps(&w[8*m]);
+               vy0 = _mm256_fmadd_ps(vw, _mm256_broadcast_ss(&x0[id+m]), vy0);
+               vy1 = _mm256_fmadd_ps(vw, _mm256_broadcast_ss(&x1[id+m]), vy1);
+               vy2 = _mm256_fmadd_ps(vw, _mm256_broadcast_ss(&x2[id+m]), vy2);
+               vy3 = _mm256_fmadd_ps(vw, _mm256_broadcast_ss(&x3[id+m]), vy3);
+            }
+            w += 32;
+         }
+         y = &out[k*out_stride + i];
+         _mm256_storeu_ps (y, vy0);
+         _mm256_storeu_ps (y+out_stride, vy1);
+         _mm256_storeu_ps (y+2*out_stride, vy2);
+         _mm256_storeu_ps (y+3*out_stride, vy3);
+      }
+   }
+   for (;k<K;k++) sparse_sgemv8x4(&out[k*out_stride], weights, idx, rows, &x[k*x_stride]);
+}
+
+static inline void sparse_cgemm8x4(float *_out, int out_stride, const opus_int8 *weights, const int *idx, const float *scale, int rows, int cols, const float *_x, int x_stride, int K)
+{
+   int i, j, k;
+   unsigned char x[4][MAX_INPUTS];
+   for (k=0;k<K-3;k+=4)
+   {
+      const opus_int8 *w;
+      const int *id_ptr;
+      vector_ps_to_epi8(x[0], &_x[k*x_stride], cols);
+      vector_ps_to_epi8(x[1], &_x[(k+1)*x_stride], cols);
+      vector_ps_to_epi8(x[2], &_x[(k+2)*x_stride], cols);
+      vector_ps_to_epi8(x[3], &_x[(k+3)*x_stride], cols);
+      w = weights;
+      id_ptr = idx;
+      for (i=0;i<rows;i+=8)
+      {
+         int colblocks;
+         __m256i vy0, vy1, vy2, vy3;
+         __m256 vscale;
+         float *y;
+         colblocks = *id_ptr++;
+         vy0 = vy1 = vy2 = vy3 = _mm256_setzero_si256();
+         for (j=0;j<colblocks;j++)
+         {
+            int id;
+            __m256i vw;
+            id = *id_ptr++;
+            vw = _mm256_loadu_si256((const __m256i *)(void*)w);
+            vy0 = opus_mm256_dpbusds_epi32(vy0, _mm256_broadcastd_epi32(_mm_loadu_si32(&x[0][id])), vw);
+            vy1 = opus_mm256_dpbusds_epi32(vy1, _mm256_broadcastd_epi32(_mm_loadu_si32(&x[1][id])), vw);
+            vy2 = opus_mm256_dpbusds_epi32(vy2, _mm256_broadcastd_epi32(_mm_loadu_si32(&x[2][id])), vw);
+            vy3 = opus_mm256_dpbusds_epi32(vy3, _mm256_broadcastd_epi32(_mm_loadu_si32(&x[3][id])), vw);
+            w += 32;
+         }
+         vscale = _mm256_loadu_ps(&scale[i]);
+         y = &_out[k*out_stride + i];
+         _mm256_storeu_ps(y, _mm256_mul_ps(_mm256_cvtepi32_ps(vy0), vscale));
+         _mm256_storeu_ps(y+out_stride, _mm256_mul_ps(_mm256_cvtepi32_ps(vy1), vscale));
+         _mm256_storeu_ps(y+2*out_stride, _mm256_mul_ps(_mm256_cvtepi32_ps(vy2), vscale));
+         _mm256_storeu_ps(y+3*out_stride, _mm256_mul_ps(_mm256_cvtepi32_ps(vy3), vscale));
+      }
+   }
+   for (;k<K;k++) sparse_cgemv8x4(&_out[k*out_stride], weights, idx, scale, rows, cols, &_x[k*x_stride]);
+}
+
+static inline void cgemm8x4(float *_out, int out_stride, const opus_int8 *weights, const float *scale, int rows, int cols, const float *_x, int x_stride, int K)
+{
+   int i, j, k;
+   unsigned char x[4][MAX_INPUTS];
+   for (k=0;k<K-3;k+=4)
+   {
+      const opus_int8 *w;
+      vector_ps_to_epi8(x[0], &_x[k*x_stride], cols);
+      vector_ps_to_epi8(x[1], &_x[(k+1)*x_stride], cols);
+      vector_ps_to_epi8(x[2], &_x[(k+2)*x_stride], cols);
+      vector_ps_to_epi8(x[3], &_x[(k+3)*x_stride], cols);
+      w = weights;
+      for (i=0;i<rows;i+=8)
+      {
+         __m256i vy0, vy1, vy2, vy3;
+         __m256 vscale;
+         float *y;
+         vy0 = vy1 = vy2 = vy3 = _mm256_setzero_si256();
+         for (j=0;j<cols;j+=4)
+         {
+            __m256i vw;
+            vw = _mm256_loadu_si256((const __m256i *)(void*)w);
+            vy0 = opus_mm256_dpbusds_epi32(vy0, _mm256_broadcastd_epi32(_mm_loadu_si32(&x[0][j])), vw);
+            vy1 = opus_mm256_dpbusds_epi32(vy1, _mm256_broadcastd_epi32(_mm_loadu_si32(&x[1][j])), vw);
+            vy2 = opus_mm256_dpbusds_epi32(vy2, _mm256_broadcastd_epi32(_mm_loadu_si32(&x[2][j])), vw);
+            vy3 = opus_mm256_dpbusds_epi32(vy3, _mm256_broadcastd_epi32(_mm_loadu_si32(&x[3][j])), vw);
+            w += 32;
+         }
+         vscale = _mm256_loadu_ps(&scale[i]);
+         y = &_out[k*out_stride + i];
+         _mm256_storeu_ps(y, _mm256_mul_ps(_mm256_cvtepi32_ps(vy0), vscale));
+         _mm256_storeu_ps(y+out_stride, _mm256_mul_ps(_mm256_cvtepi32_ps(vy1), vscale));
+         _mm256_storeu_ps(y+2*out_stride, _mm256_mul_ps(_mm256_cvtepi32_ps(vy2), vscale));
+         _mm256_storeu_ps(y+3*out_stride, _mm256_mul_ps(_mm256_cvtepi32_ps(vy3), vscale));
+      }
+   }
+   for (;k<K;k++) cgemv8x4(&_out[k*out_stride], weights, scale, rows, cols, &_x[k*x_stride]);
+}
+
 #define SCALE (128.f*127.f)
 #define SCALE_1 (1.f/128.f/127.f)
 #define USE_SU_BIAS
@@ -298,6 +298,39 @@ static inline void sgemv(float *out, const float *weights, int rows, int cols, i
    }
 }
 
+#if defined(__aarch64__) && defined(__ARM_FP16_FORMAT_IEEE)
+#define VEC_HAVE_SGEMV_F16
+/* Same as sgemv() with half-precision weights, widened to float as they are
+   loaded. */
+static inline void sgemv_f16(float *out, const opus_uint16 *weights, int rows, int cols, int col_stride, const float *x)
+{
+   int i, j;
+   i=0;
+   for (;i<rows-7;i+=8)
+   {
+      float * restrict y = &out[i];
+      float32x4_t y0_3 = vdupq_n_f32(0);
+      float32x4_t y4_7 = vdupq_n_f32(0);
+      for (j=0;j<cols;j++)
+      {
+         uint16x8_t wvec;
+         float32x4_t xj;
+         wvec = vld1q_u16(&weights[j*col_stride + i]);
+         xj = vld1q_dup_f32(&x[j]);
+         y0_3 = vmlaq_f32(y0_3, vcvt_f32_f16(vreinterpret_f16_u16(vget_low_u16(wvec))), xj);
+         y4_7 = vmlaq_f32(y4_7, vcvt_f32_f16(vreinterpret_f16_u16(vget_high_u16(wvec))), xj);
+      }
+      vst1q_f32(&y[0], y0_3);
+      vst1q_f32(&y[4], y4_7);
+   }
+   for (;i<rows;i++)
+   {
+      out[i] = 0;
+      for (j=0;j<cols;j++) out[i] += float16_to_float(weights[j*col_stride + i])*x[j];
+   }
+}
+#endif
+
 /* Temporarily use unoptimized version */
 static inline void sparse_sgemv8x4(float *out, const float *w, const int *idx, int rows, const float *x)
 {
@@ -29,6 +29,7 @@
 #endif
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stddef.h>
 #include "nnet.h"
@@ -51,47 +52,88 @@
 #include "nolace_data.c"
 #endif
 
+static void write_record(const char *name, int type, int size, const void *data, FILE *fout)
+{
+  unsigned char zeros[WEIGHT_BLOCK_SIZE] = {0};
+  WeightHead h;
+  if (strlen(name) >= sizeof(h.name) - 1) {
+    printf("[write_weights] warning: name %s too long\n", name);
+  }
+  memcpy(h.head, "DNNw", 4);
+  h.version = WEIGHT_BLOB_VERSION;
+  h.type = type;
+  h.size = size;
+  h.block_size = (h.size+WEIGHT_BLOCK_SIZE-1)/WEIGHT_BLOCK_SIZE*WEIGHT_BLOCK_SIZE;
+  OPUS_CLEAR(h.name, sizeof(h.name));
+  strncpy(h.name, name, sizeof(h.name));
+  h.name[sizeof(h.name)-1] = 0;
+  celt_assert(sizeof(h) == WEIGHT_BLOCK_SIZE);
+  fwrite(&h, 1, WEIGHT_BLOCK_SIZE, fout);
+  fwrite(data, 1, h.size, fout);
+  fwrite(zeros, 1, h.block_size-h.size, fout);
+}
+
+/* Writes the name index of all the records in lists, which must then be
+   written in the same order. */
+void write_index(const WeightArray *const *lists, int nb_lists, FILE *fout)
+{
+  int i, j;
+  int nb_arrays=0;
+  int nb_buckets=2;
+  int record=0;
+  WeightIndexEntry *table;
+  for (i=0;i<nb_lists;i++) {
+    for (j=0;lists[i][j].name != NULL;j++) nb_arrays++;
+  }
+  while (nb_buckets < 2*nb_arrays) nb_buckets <<= 1;
+  table = malloc(nb_buckets*sizeof(*table));
+  for (i=0;i<nb_buckets;i++) {
+    table[i].hash = 0;
+    table[i].record = WEIGHT_INDEX_EMPTY;
+  }
+  for (i=0;i<nb_lists;i++) {
+    for (j=0;lists[i][j].name != NULL;j++) {
+      opus_uint32 hash = weight_name_hash(lists[i][j].name);
+      opus_uint32 pos = hash & (nb_buckets-1);
+      while (table[pos].record != WEIGHT_INDEX_EMPTY) pos = (pos+1) & (nb_buckets-1);
+      table[pos].hash = hash;
+      table[pos].record = record++;
+    }
+  }
+  write_record(WEIGHT_INDEX_NAME, WEIGHT_TYPE_index, nb_buckets*sizeof(*table), table, fout);
+  free(table);
+}
+
 void write_weights(const WeightArray *list, FILE *fout)
 {
   int i=0;
-  unsigned char zeros[WEIGHT_BLOCK_SIZE] = {0};
   while (list[i].name != NULL) {
-    WeightHead h;
-    if (strlen(list[i].name) >= sizeof(h.name) - 1) {
-      printf("[write_weights] warning: name %s too long\n", list[i].name);
-    }
-    memcpy(h.head, "DNNw", 4);
-    h.version = WEIGHT_BLOB_VERSION;
-    h.type = list[i].type;
-    h.size = list[i].size;
-    h.block_size = (h.size+WEIGHT_BLOCK_SIZE-1)/WEIGHT_BLOCK_SIZE*WEIGHT_BLOCK_SIZE;
-    OPUS_CLEAR(h.name, sizeof(h.name));
-    strncpy(h.name, list[i].name, sizeof(h.name));
-    h.name[sizeof(h.name)-1] = 0;
-    celt_assert(sizeof(h) == WEIGHT_BLOCK_SIZE);
-    fwrite(&h, 1, WEIGHT_BLOCK_SIZE, fout);
-    fwrite(list[i].data, 1, h.size, fout);
-    fwrite(zeros, 1, h.block_size-h.size, fout);
+    write_record(list[i].name, list[i].type, list[i].size, list[i].data, fout);
     i++;
   }
 }
 
 int main(void)
 {
+  const WeightArray *lists[16];
+  int nb_lists=0;
+  int i;
   FILE *fout = fopen("weights_blob.bin", "w");
-  write_weights(pitchdnn_arrays, fout);
-  write_weights(fargan_arrays, fout);
-  write_weights(plcmodel_arrays, fout);
-  write_weights(rdovaeenc_arrays, fout);
-  write_weights(rdovaedec_arrays, fout);
+  lists[nb_lists++] = pitchdnn_arrays;
+  lists[nb_lists++] = fargan_arrays;
+  lists[nb_lists++] = plcmodel_arrays;
+  lists[nb_lists++] = rdovaeenc_arrays;
+  lists[nb_lists++] = rdovaedec_arrays;
 #ifdef ENABLE_OSCE
 #ifndef DISABLE_LACE
-  write_weights(lacelayers_arrays, fout);
+  lists[nb_lists++] = lacelayers_arrays;
 #endif
 #ifndef DISABLE_NOLACE
-  write_weights(nolacelayers_arrays, fout);
+  lists[nb_lists++] = nolacelayers_arrays;
 #endif
 #endif
+  write_index(lists, nb_lists, fout);
+  for (i=0;i<nb_lists;i++) write_weights(lists[i], fout);
   fclose(fout);
   return 0;
 }
@@ -33,49 +33,83 @@
 
 #if defined(OPUS_X86_MAY_HAVE_SSE2)
 void compute_linear_sse2(const LinearLayer *linear, float *out, const float *in);
+void compute_linear_batch_sse2(const LinearLayer *linear, float *out, const float *in, int K);
 void compute_activation_sse2(float *output, const float *input, int N, int activation);
 void compute_conv2d_sse2(const Conv2dLayer *conv, float *out, float *mem, const float *in, int height, int hstride, int activation);
+void compute_crossfade_conv_sse2(float *out, const float *in0, const float *kernel0, const float *in1, const float *kernel1, const float *window, int kernel_size, int overlap_size, int frame_size);
 #endif
 
 #if defined(OPUS_X86_MAY_HAVE_SSE4_1)
 void compute_linear_sse4_1(const LinearLayer *linear, float *out, const float *in);
+void compute_linear_batch_sse4_1(const LinearLayer *linear, float *out, const float *in, int K);
 void compute_activation_sse4_1(float *output, const float *input, int N, int activation);
 void compute_conv2d_sse4_1(const Conv2dLayer *conv, float *out, float *mem, const float *in, int height, int hstride, int activation);
+void compute_crossfade_conv_sse4_1(float *out, const float *in0, const float *kernel0, const float *in1, const float *kernel1, const float *window, int kernel_size, int overlap_size, int frame_size);
 #endif
 
 #if defined(OPUS_X86_MAY_HAVE_AVX2)
 void compute_linear_avx2(const LinearLayer *linear, float *out, const float *in);
+void compute_linear_batch_avx2(const LinearLayer *linear, float *out, const float *in, int K);
 void compute_activation_avx2(float *output, const float *input, int N, int activation);
 void compute_conv2d_avx2(const Conv2dLayer *conv, float *out, float *mem, const float *in, int height, int hstride, int activation);
+void compute_crossfade_conv_avx2(float *out, const float *in0, const float *kernel0, const float *in1, const float *kernel1, const float *window, int kernel_size, int overlap_size, int frame_size);
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_AVXVNNI)
+void compute_linear_avxvnni(const LinearLayer *linear, float *out, const float *in);
+void compute_linear_batch_avxvnni(const LinearLayer *linear, float *out, const float *in, int K);
+void compute_activation_avxvnni(float *output, const float *input, int N, int activation);
+void compute_conv2d_avxvnni(const Conv2dLayer *conv, float *out, float *mem, const float *in, int height, int hstride, int activation);
+void compute_crossfade_conv_avxvnni(float *out, const float *in0, const float *kernel0, const float *in1, const float *kernel1, const float *window, int kernel_size, int overlap_size, int frame_size);
+#endif
+
+#if defined(OPUS_X86_MAY_HAVE_AVX512)
+void compute_linear_avx512(const LinearLayer *linear, float *out, const float *in);
+void compute_linear_batch_avx512(const LinearLayer *linear, float *out, const float *in, int K);
+void compute_activation_avx512(float *output, const float *input, int N, int activation);
+void compute_conv2d_avx512(const Conv2dLayer *conv, float *out, float *mem, const float *in, int height, int hstride, int activation);
+void compute_crossfade_conv_avx512(float *out, const float *in0, const float *kernel0, const float *in1, const float *kernel1, const float *window, int kernel_size, int overlap_size, int frame_size);
 #endif
 
 
-#if defined(OPUS_X86_PRESUME_AVX2)
+#if defined(OPUS_X86_PRESUME_AVX2) && !defined(OPUS_X86_MAY_HAVE_AVXVNNI) && !defined(OPUS_X86_MAY_HAVE_AVX512)
 
 #define OVERRIDE_COMPUTE_LINEAR
 #define compute_linear(linear, out, in, arch) ((void)(arch),compute_linear_avx2(linear, out, in))
+#define OVERRIDE_COMPUTE_LINEAR_BATCH
+#define compute_linear_batch(linear, out, in, K, arch) ((void)(arch),compute_linear_batch_avx2(linear, out, in, K))
 #define OVERRIDE_COMPUTE_ACTIVATION
 #define compute_activation(output, input, N, activation, arch) ((void)(arch),compute_activation_avx2(output, input, N, activation))
 #define OVERRIDE_COMPUTE_CONV2D
 #define compute_conv2d(conv, out, mem, in, height, hstride, activation, arch) ((void)(arch),compute_conv2d_avx2(conv, out, mem, in, height, hstride, activation))
+#define OVERRIDE_COMPUTE_CROSSFADE_CONV
+#define compute_crossfade_conv(out, in0, kernel0, in1, kernel1, window, kernel_size, overlap_size, frame_size, arch) ((void)(arch),compute_crossfade_conv_avx2(out, in0, kernel0, in1, kernel1, window, kernel_size, overlap_size, frame_size))
 
 #elif defined(OPUS_X86_PRESUME_SSE4_1) && !defined(OPUS_X86_MAY_HAVE_AVX2)
 
 #define OVERRIDE_COMPUTE_LINEAR
 #define compute_linear(linear, out, in, arch) ((void)(arch),compute_linear_sse4_1(linear, out, in))
+#define OVERRIDE_COMPUTE_LINEAR_BATCH
+#define compute_linear_batch(linear, out, in, K, arch) ((void)(arch),compute_linear_batch_sse4_1(linear, out, in, K))
 #define OVERRIDE_COMPUTE_ACTIVATION
 #define compute_activation(output, input, N, activation, arch) ((void)(arch),compute_activation_sse4_1(output, input, N, activation))
 #define OVERRIDE_COMPUTE_CONV2D
 #define compute_conv2d(conv, out, mem, in, height, hstride, activation, arch) ((void)(arch),compute_conv2d_sse4_1(conv, out, mem, in, height, hstride, activation))
+#define OVERRIDE_COMPUTE_CROSSFADE_CONV
+#define compute_crossfade_conv(out, in0, kernel0, in1, kernel1, window, kernel_size, overlap_size, frame_size, arch) ((void)(arch),compute_crossfade_conv_sse4_1(out, in0, kernel0, in1, kernel1, window, kernel_size, overlap_size, frame_size))
 
 #elif defined(OPUS_X86_PRESUME_SSE2) && !defined(OPUS_X86_MAY_HAVE_AVX2) && !defined(OPUS_X86_MAY_HAVE_SSE4_1)
 
 #define OVERRIDE_COMPUTE_LINEAR
 #define compute_linear(linear, out, in, arch) ((void)(arch),compute_linear_sse2(linear, out, in))
+#define OVERRIDE_COMPUTE_LINEAR_BATCH
+#define compute_linear_batch(linear, out, in, K, arch) ((void)(arch),compute_linear_batch_sse2(linear, out, in, K))
 #define OVERRIDE_COMPUTE_ACTIVATION
 #define compute_activation(output, input, N, activation, arch) ((void)(arch),compute_activation_sse2(output, input, N, activation))
 #define OVERRIDE_COMPUTE_CONV2D
 #define compute_conv2d(conv, out, mem, in, height, hstride, activation, arch) ((void)(arch),compute_conv2d_sse2(conv, out, mem, in, height, hstride, activation))
+#define OVERRIDE_COMPUTE_CROSSFADE_CONV
+#define compute_crossfade_conv(out, in0, kernel0, in1, kernel1, window, kernel_size, overlap_size, frame_size, arch) ((void)(arch),compute_crossfade_conv_sse2(out, in0, kernel0, in1, kernel1, window, kernel_size, overlap_size, frame_size))
 
 #elif defined(OPUS_HAVE_RTCD) && (defined(OPUS_X86_MAY_HAVE_AVX2) || defined(OPUS_X86_MAY_HAVE_SSE4_1) || defined(OPUS_X86_MAY_HAVE_SSE2))
 
@@ -88,6 +122,16 @@ extern void (*const DNN_COMPUTE_LINEAR_IMPL[OPUS_ARCHMASK + 1])(
 #define compute_linear(linear, out, in, arch) \
     ((*DNN_COMPUTE_LINEAR_IMPL[(arch) & OPUS_ARCHMASK])(linear, out, in))
 
+extern void (*const DNN_COMPUTE_LINEAR_BATCH_IMPL[OPUS_ARCHMASK + 1])(
+                    const LinearLayer *linear,
+                    float *out,
+                    const float *in,
+                    int K
+                    );
+#define OVERRIDE_COMPUTE_LINEAR_BATCH
+#define compute_linear_batch(linear, out, in, K, arch) \
+    ((*DNN_COMPUTE_LINEAR_BATCH_IMPL[(arch) & OPUS_ARCHMASK])(linear, out, in, K))
+
 
 extern void (*const DNN_COMPUTE_ACTIVATION_IMPL[OPUS_ARCHMASK + 1])(
                     float *output,
@@ -114,6 +158,22 @@ extern void (*const DNN_COMPUTE_CONV2D_IMPL[OPUS_ARCHMASK + 1])(
     ((*DNN_COMPUTE_CONV2D_IMPL[(arch) & OPUS_ARCHMASK])(conv, out, mem, in, height, hstride, activation))
 
 
+extern void (*const DNN_COMPUTE_CROSSFADE_CONV_IMPL[OPUS_ARCHMASK + 1])(
+                    float *out,
+                    const float *in0,
+                    const float *kernel0,
+                    const float *in1,
+                    const float *kernel1,
+                    const float *window,
+                    int kernel_size,
+                    int overlap_size,
+                    int frame_size
+                    );
+#define OVERRIDE_COMPUTE_CROSSFADE_CONV
+#define compute_crossfade_conv(out, in0, kernel0, in1, kernel1, window, kernel_size, overlap_size, frame_size, arch) \
+    ((*DNN_COMPUTE_CROSSFADE_CONV_IMPL[(arch) & OPUS_ARCHMASK])(out, in0, kernel0, in1, kernel1, window, kernel_size, overlap_size, frame_size))
+
+
 #endif
 
 
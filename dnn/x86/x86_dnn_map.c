@@ -34,7 +34,8 @@
 
 #if defined(OPUS_HAVE_RTCD)
 
-#if (defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(OPUS_X86_PRESUME_AVX2))
+#if (defined(OPUS_X86_MAY_HAVE_SSE2) && !defined(OPUS_X86_PRESUME_AVX2)) || \
+ defined(OPUS_X86_MAY_HAVE_AVXVNNI) || defined(OPUS_X86_MAY_HAVE_AVX512)
 
 void (*const DNN_COMPUTE_LINEAR_IMPL[OPUS_ARCHMASK + 1])(
          const LinearLayer *linear,
@@ -45,7 +46,24 @@ void (*const DNN_COMPUTE_LINEAR_IMPL[OPUS_ARCHMASK + 1])(
   compute_linear_c,
   MAY_HAVE_SSE2(compute_linear),
   MAY_HAVE_SSE4_1(compute_linear), /* sse4.1  */
-  MAY_HAVE_AVX2(compute_linear)  /* avx  */
+  MAY_HAVE_AVX2(compute_linear), /* avx  */
+  MAY_HAVE_AVXVNNI(compute_linear), /* avx-vnni */
+  MAY_HAVE_AVX512(compute_linear) /* avx512 */
+};
+
+void (*const DNN_COMPUTE_LINEAR_BATCH_IMPL[OPUS_ARCHMASK + 1])(
+         const LinearLayer *linear,
+         float *out,
+         const float *in,
+         int K
+) = {
+  compute_linear_batch_c,                /* non-sse */
+  compute_linear_batch_c,
+  MAY_HAVE_SSE2(compute_linear_batch),
+  MAY_HAVE_SSE4_1(compute_linear_batch), /* sse4.1  */
+  MAY_HAVE_AVX2(compute_linear_batch), /* avx  */
+  MAY_HAVE_AVXVNNI(compute_linear_batch), /* avx-vnni */
+  MAY_HAVE_AVX512(compute_linear_batch) /* avx512 */
 };
 
 void (*const DNN_COMPUTE_ACTIVATION_IMPL[OPUS_ARCHMASK + 1])(
@@ -58,7 +76,9 @@ void (*const DNN_COMPUTE_ACTIVATION_IMPL[OPUS_ARCHMASK + 1])(
   compute_activation_c,
   MAY_HAVE_SSE2(compute_activation),
   MAY_HAVE_SSE4_1(compute_activation), /* sse4.1  */
-  MAY_HAVE_AVX2(compute_activation)  /* avx  */
+  MAY_HAVE_AVX2(compute_activation), /* avx  */
+  MAY_HAVE_AVXVNNI(compute_activation), /* avx-vnni */
+  MAY_HAVE_AVX512(compute_activation) /* avx512 */
 };
 
 void (*const DNN_COMPUTE_CONV2D_IMPL[OPUS_ARCHMASK + 1])(
@@ -74,7 +94,29 @@ void (*const DNN_COMPUTE_CONV2D_IMPL[OPUS_ARCHMASK + 1])(
   compute_conv2d_c,
   MAY_HAVE_SSE2(compute_conv2d),
   MAY_HAVE_SSE4_1(compute_conv2d), /* sse4.1  */
-  MAY_HAVE_AVX2(compute_conv2d)  /* avx  */
+  MAY_HAVE_AVX2(compute_conv2d), /* avx  */
+  MAY_HAVE_AVXVNNI(compute_conv2d), /* avx-vnni */
+  MAY_HAVE_AVX512(compute_conv2d) /* avx512 */
+};
+
+void (*const DNN_COMPUTE_CROSSFADE_CONV_IMPL[OPUS_ARCHMASK + 1])(
+         float *out,
+         const float *in0,
+         const float *kernel0,
+         const float *in1,
+         const float *kernel1,
+         const float *window,
+         int kernel_size,
+         int overlap_size,
+         int frame_size
+) = {
+  compute_crossfade_conv_c,                /* non-sse */
+  compute_crossfade_conv_c,
+  MAY_HAVE_SSE2(compute_crossfade_conv),
+  MAY_HAVE_SSE4_1(compute_crossfade_conv), /* sse4.1  */
+  MAY_HAVE_AVX2(compute_crossfade_conv), /* avx  */
+  MAY_HAVE_AVXVNNI(compute_crossfade_conv), /* avx-vnni */
+  MAY_HAVE_AVX512(compute_crossfade_conv) /* avx512 */
 };
 
 #endif
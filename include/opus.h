@@ -170,6 +170,34 @@ typedef struct OpusEncoder OpusEncoder;
   */
 OPUS_EXPORT OPUS_WARN_UNUSED_RESULT int opus_encoder_get_size(int channels);
 
+/** Gets the size of the scratch arena to attach to an encoder with
+  * #OPUS_SET_SCRATCH_ARENA.
+  * With an arena attached, the temporary buffers of opus_encode() and
+  * opus_encode_float() are taken from it instead of from the stack.
+  * @param[in] channels <tt>int</tt>: Number of channels.
+  *                                   This must be 1 or 2.
+  * @returns The size in bytes, or 0 if libopus was built without scratch
+  *          arena support, in which case the encoder needs no arena.
+  */
+OPUS_EXPORT OPUS_WARN_UNUSED_RESULT int opus_encoder_get_scratch_size(int channels);
+
+/** Frees the scratch memory libopus allocated for the calling thread.
+  * In builds with scratch arena support, instances without an arena of their
+  * own (decoders, multistream wrappers, encoders without
+  * #OPUS_SET_SCRATCH_ARENA) take their temporary buffers from a block that is
+  * allocated on first use and kept for the lifetime of the thread. A call
+  * that cannot get this block takes its memory from the heap, and returns
+  * #OPUS_ALLOC_FAIL if that fails too.
+  * The threads behind a multistream task runner or #OPUS_SET_DRED_WORKER are
+  * no exception: the first task libopus runs on one of them gives that thread
+  * a block of its own, which only a call to this function on that thread
+  * frees.
+  * Threads that exit should call this first; it must not be called while the
+  * thread is inside an encode or decode call. Later calls allocate the block
+  * again. In other builds it does nothing.
+  */
+OPUS_EXPORT void opus_thread_scratch_release(void);
+
 /**
  */
 
@@ -314,6 +342,16 @@ OPUS_EXPORT OPUS_WARN_UNUSED_RESULT opus_int32 opus_encode_float(
   */
 OPUS_EXPORT void opus_encoder_destroy(OpusEncoder *st);
 
+/** Releases what an encoder initialized with opus_encoder_init() holds outside
+  * its own memory, i.e. its reference to a model attached with #OPUS_SET_DNN_MODEL
+  * and any DRED analysis still running on a worker.
+  * It must be called before the memory of such an encoder is released or
+  * initialized again. The encoder must not be used afterwards until it has
+  * been initialized again. opus_encoder_destroy() does this itself.
+  * @param[in] st <tt>OpusEncoder*</tt>: Encoder state. May be NULL.
+  */
+OPUS_EXPORT void opus_encoder_deinit(OpusEncoder *st);
+
 /** Perform a CTL function on an Opus encoder.
   *
   * Generally the request and subsequent arguments are generated
@@ -405,6 +443,35 @@ typedef struct OpusDecoder OpusDecoder;
   */
 typedef struct OpusDREDDecoder OpusDREDDecoder;
 
+/** Opus DNN model.
+  * This contains the network layer tables parsed from a weights blob. A
+  * single model can be attached to any number of encoders, decoders and DRED
+  * decoders with #OPUS_SET_DNN_MODEL; it is never modified once created, so
+  * it can be shared between threads.
+  * @see opus_dnn_model_create,OPUS_SET_DNN_MODEL
+  */
+typedef struct OpusDNNModel OpusDNNModel;
+
+/** Opus DNN CPU governor.
+  * This tracks the time spent by all the decoders attached to it on neural
+  * decoding (deep PLC, OSCE and DRED) against a shared CPU budget, and
+  * degrades those features across all of them as the load exceeds it.
+  * @see opus_dnn_governor_create,OPUS_SET_DNN_GOVERNOR
+  */
+typedef struct OpusDNNGovernor OpusDNNGovernor;
+
+/** Counters of an #OpusDNNGovernor.
+  * @see opus_dnn_governor_get_stats
+  */
+typedef struct OpusDNNGovernorStats {
+  opus_int32 level;              /**< Current degradation level: 0 none, 1 NoLACE replaced by LACE, 2 OSCE disabled, 3 deep PLC replaced by classic PLC */
+  opus_int32 load;               /**< Neural decoding load measured over the last window, in microseconds per second */
+  opus_int32 decoders;           /**< Number of decoders currently attached */
+  opus_uint32 lace_frames;       /**< Frames enhanced with LACE instead of NoLACE */
+  opus_uint32 no_osce_frames;    /**< Frames decoded without the OSCE enhancement they were configured for */
+  opus_uint32 classic_plc_frames; /**< Lost frames concealed by the classic PLC instead of deep PLC */
+} OpusDNNGovernorStats;
+
 
 /** Opus DRED state.
   * This contains the complete state of an Opus DRED packet.
@@ -526,6 +593,16 @@ OPUS_EXPORT int opus_decoder_ctl(OpusDecoder *st, int request, ...) OPUS_ARG_NON
   */
 OPUS_EXPORT void opus_decoder_destroy(OpusDecoder *st);
 
+/** Releases what a decoder initialized with opus_decoder_init() holds outside
+  * its own memory, i.e. its references to a model attached with #OPUS_SET_DNN_MODEL
+  * and to a governor attached with #OPUS_SET_DNN_GOVERNOR.
+  * It must be called before the memory of such a decoder is released or
+  * initialized again. The decoder must not be used afterwards until it has
+  * been initialized again. opus_decoder_destroy() does this itself.
+  * @param[in] st <tt>OpusDecoder*</tt>: Decoder state. May be NULL.
+  */
+OPUS_EXPORT void opus_decoder_deinit(OpusDecoder *st);
+
 /** Gets the size of an <code>OpusDREDDecoder</code> structure.
   * @returns The size in bytes.
   */
@@ -546,6 +623,14 @@ OPUS_EXPORT int opus_dred_decoder_init(OpusDREDDecoder *dec);
   */
 OPUS_EXPORT void opus_dred_decoder_destroy(OpusDREDDecoder *dec);
 
+/** Releases the reference to a model attached with #OPUS_SET_DNN_MODEL held by a
+  * DRED decoder initialized with opus_dred_decoder_init().
+  * It must be called before the memory of such a DRED decoder is released or
+  * initialized again. opus_dred_decoder_destroy() does this itself.
+  * @param[in] dec <tt>OpusDREDDecoder*</tt>: DRED decoder state. May be NULL.
+  */
+OPUS_EXPORT void opus_dred_decoder_deinit(OpusDREDDecoder *dec);
+
 /** Perform a CTL function on an Opus DRED decoder.
   *
   * Generally the request and subsequent arguments are generated
@@ -559,6 +644,84 @@ OPUS_EXPORT void opus_dred_decoder_destroy(OpusDREDDecoder *dec);
   */
 OPUS_EXPORT int opus_dred_decoder_ctl(OpusDREDDecoder *dred_dec, int request, ...);
 
+/** Parses a DNN weights blob into a model that can be shared by many encoders and decoders.
+  *
+  * The blob is parsed and the layer tables are built once, instead of once
+  * per instance as with #OPUS_SET_DNN_BLOB. The data is copied, so the
+  * caller may release it once this returns.
+  * @param [in] data <tt>const unsigned char*</tt>: Weights blob, in the same format as for #OPUS_SET_DNN_BLOB
+  * @param [in] len <tt>opus_int32</tt>: Length of the blob in bytes
+  * @param [out] error <tt>int*</tt>: #OPUS_OK Success or @ref opus_errorcodes.
+  *  #OPUS_UNIMPLEMENTED is returned when libopus was built without any DNN feature.
+  * @returns The new model, holding one reference owned by the caller, or NULL on error
+  */
+OPUS_EXPORT OPUS_WARN_UNUSED_RESULT OpusDNNModel *opus_dnn_model_create(const unsigned char *data, opus_int32 len, int *error);
+
+/** Like opus_dnn_model_create(), but uses the blob in place instead of copying it.
+  *
+  * This is meant for a weights file mapped with <code>mmap()</code> (or
+  * <code>MapViewOfFile()</code>): the weights are then read straight from
+  * the page cache, which is shared by all the processes mapping the file.
+  * The data must remain mapped and unchanged until the model is freed, i.e.
+  * until after opus_dnn_model_destroy() has been called and every encoder and
+  * decoder it was attached to has released it.
+  * @param [in] data <tt>const unsigned char*</tt>: Weights blob, aligned to at least 64 bytes
+  * @param [in] len <tt>opus_int32</tt>: Length of the blob in bytes
+  * @param [out] error <tt>int*</tt>: #OPUS_OK Success or @ref opus_errorcodes.
+  *  #OPUS_BAD_ARG is returned when the data is not 64-byte aligned.
+  * @returns The new model, holding one reference owned by the caller, or NULL on error
+  */
+OPUS_EXPORT OPUS_WARN_UNUSED_RESULT OpusDNNModel *opus_dnn_model_create_mapped(const unsigned char *data, opus_int32 len, int *error);
+
+/** Releases the caller's reference to a model created with opus_dnn_model_create().
+  *
+  * Every encoder or decoder the model is attached to holds its own reference,
+  * which it drops when it is destroyed or when another model is attached, so
+  * the model may be released while it is still in use. States allocated by the
+  * application and initialized with opus_encoder_init(), opus_decoder_init()
+  * or opus_dred_decoder_init() drop theirs in opus_encoder_deinit(),
+  * opus_decoder_deinit() or opus_dred_decoder_deinit().
+  * @param[in] model <tt>OpusDNNModel*</tt>: Model to release. May be NULL.
+  */
+OPUS_EXPORT void opus_dnn_model_destroy(OpusDNNModel *model);
+
+/** Creates a CPU governor for the neural decoding features.
+  *
+  * Decoders attached to it with #OPUS_SET_DNN_GOVERNOR report how long their
+  * neural decoding takes, and the governor lowers their effective complexity,
+  * one step at a time, whenever the combined load exceeds the budget: NoLACE
+  * is first replaced by LACE, then OSCE is disabled, then lost frames are
+  * concealed by the classic SILK and CELT PLC. Quality is restored, one step
+  * at a time, once the load has remained well under the budget for a while.
+  * A decoder is never raised above its own #OPUS_SET_COMPLEXITY.
+  * The governor can be shared by decoders running on different threads.
+  * @param [in] budget <tt>opus_int32</tt>: CPU budget in microseconds of neural
+  *  decoding per second of wall-clock time, summed over all the decoders
+  *  (1000000 is one full core)
+  * @param [out] error <tt>int*</tt>: #OPUS_OK Success or @ref opus_errorcodes.
+  *  #OPUS_UNIMPLEMENTED is returned when libopus was built without deep PLC.
+  * @returns The new governor, holding one reference owned by the caller, or NULL on error
+  */
+OPUS_EXPORT OPUS_WARN_UNUSED_RESULT OpusDNNGovernor *opus_dnn_governor_create(opus_int32 budget, int *error);
+
+/** Reads the counters of a governor.
+  * The frame counters are summed over all the decoders attached since the
+  * governor was created, and wrap around.
+  * @param [in] governor <tt>const OpusDNNGovernor*</tt>: Governor
+  * @param [out] stats <tt>OpusDNNGovernorStats*</tt>: Returns a copy of the counters
+  * @returns @ref opus_errorcodes
+  */
+OPUS_EXPORT int opus_dnn_governor_get_stats(const OpusDNNGovernor *governor, OpusDNNGovernorStats *stats);
+
+/** Releases the caller's reference to a governor created with opus_dnn_governor_create().
+  *
+  * As with opus_dnn_model_destroy(), every attached decoder holds its own
+  * reference, which decoders initialized with opus_decoder_init() drop in
+  * opus_decoder_deinit().
+  * @param[in] governor <tt>OpusDNNGovernor*</tt>: Governor to release. May be NULL.
+  */
+OPUS_EXPORT void opus_dnn_governor_destroy(OpusDNNGovernor *governor);
+
 /** Gets the size of an <code>OpusDRED</code> structure.
   * @returns The size in bytes.
   */
@@ -589,6 +752,10 @@ OPUS_EXPORT int opus_dred_parse(OpusDREDDecoder *dred_dec, OpusDRED *dred, const
 
 /** Finish decoding an Opus DRED packet. The function only needs to be called if opus_dred_parse() was called with defer_processing=1.
   * The source and destination will often be the same DRED state.
+  * The redundant features are decoded on demand by opus_decoder_dred_decode(), only as deep as the offsets actually requested,
+  * and cached in the decoder state rather than in \a dst, so a processed DRED state may be shared by several decoders.
+  * It does not refer to \a dred_dec, but the weights \a dred_dec was given with #OPUS_SET_DNN_BLOB or #OPUS_SET_DNN_MODEL
+  * must stay valid as long as \a dst is used for decoding.
   * @param [in] dred_dec <tt>OpusDRED*</tt>: DRED Decoder state
   * @param [in] src <tt>OpusDRED*</tt>: Source DRED state to start the processing from.
   * @param [out] dst <tt>OpusDRED*</tt>: Destination DRED state to store the updated state after processing.
@@ -173,6 +173,19 @@ extern "C" {
 #define OPUS_GET_DRED_DURATION_REQUEST 4051
 #define OPUS_SET_DNN_BLOB_REQUEST 4052
 /*#define OPUS_GET_DNN_BLOB_REQUEST 4053 */
+#define OPUS_SET_DNN_MODEL_REQUEST 4054
+#define OPUS_RESET_PROFILE_STATS_REQUEST 4056
+#define OPUS_GET_PROFILE_STATS_REQUEST 4057
+#define OPUS_SET_SCRATCH_ARENA_REQUEST 4058
+/*#define OPUS_GET_SCRATCH_OVERFLOWS_REQUEST 4059 */
+#define OPUS_SET_DNN_GOVERNOR_REQUEST 4060
+#define OPUS_SET_DRED_WORKER_REQUEST 4062
+#define OPUS_GET_DRED_DELAY_REQUEST 4063
+#define OPUS_SET_DEEP_PLC_LOOKAHEAD_REQUEST 4064
+#define OPUS_GET_DEEP_PLC_LOOKAHEAD_REQUEST 4065
+#define OPUS_GET_SILK_RATE_PASSES_REQUEST 4066
+#define OPUS_SET_PITCH_TRACKING_REQUEST 4067
+#define OPUS_GET_PITCH_TRACKING_REQUEST 4068
 
 /** Defines for the presence of extended APIs. */
 #define OPUS_HAVE_OPUS_PROJECTION_H
@@ -188,12 +201,16 @@ extern "C" {
 #define __opus_check_uint8_ptr(ptr) (ptr)
 #define __opus_check_val16_ptr(ptr) (ptr)
 #define __opus_check_void_ptr(ptr) (ptr)
+#define __opus_check_profile_ptr(ptr) (ptr)
+#define __opus_check_dred_worker_ptr(ptr) (ptr)
 #else
 #define __opus_check_int_ptr(ptr) ((ptr) + ((ptr) - (opus_int32*)(ptr)))
 #define __opus_check_uint_ptr(ptr) ((ptr) + ((ptr) - (opus_uint32*)(ptr)))
 #define __opus_check_uint8_ptr(ptr) ((ptr) + ((ptr) - (opus_uint8*)(ptr)))
 #define __opus_check_val16_ptr(ptr) ((ptr) + ((ptr) - (opus_val16*)(ptr)))
 #define __opus_check_void_ptr(x) ((void)((void *)0 == (x)), (x))
+#define __opus_check_profile_ptr(ptr) ((ptr) + ((ptr) - (OpusProfileStats*)(ptr)))
+#define __opus_check_dred_worker_ptr(ptr) ((void)((ptr) == (const OpusDREDWorker*)0), (ptr))
 #endif
 /** @endcond */
 
@@ -637,6 +654,29 @@ extern "C" {
   * @hideinitializer */
 #define OPUS_GET_PREDICTION_DISABLED(x) OPUS_GET_PREDICTION_DISABLED_REQUEST, __opus_check_int_ptr(x)
 
+/** If set to 1, the SILK pitch estimator first searches around the previous
+  * frame's pitch lag when that frame was strongly voiced, and only runs the
+  * full search if the lag no longer fits the signal. This speeds up the
+  * encoding of stationary voiced speech, but may occasionally miss a pitch
+  * jump that the full search would have found.
+  * @see OPUS_GET_PITCH_TRACKING
+  * @param[in] x <tt>opus_int32</tt>: Allowed values:
+  * <dl>
+  * <dt>0</dt><dd>Always run the full pitch search (default).</dd>
+  * <dt>1</dt><dd>Track the previous pitch lag.</dd>
+  * </dl>
+  * @hideinitializer */
+#define OPUS_SET_PITCH_TRACKING(x) OPUS_SET_PITCH_TRACKING_REQUEST, __opus_check_int(x)
+/** Gets the encoder's configured pitch tracking mode.
+  * @see OPUS_SET_PITCH_TRACKING
+  * @param[out] x <tt>opus_int32 *</tt>: Returns one of the following values:
+  * <dl>
+  * <dt>0</dt><dd>Full pitch search (default).</dd>
+  * <dt>1</dt><dd>Pitch tracking enabled.</dd>
+  * </dl>
+  * @hideinitializer */
+#define OPUS_GET_PITCH_TRACKING(x) OPUS_GET_PITCH_TRACKING_REQUEST, __opus_check_int_ptr(x)
+
 /** If non-zero, enables Deep Redundancy (DRED) and use the specified maximum number of 10-ms redundant frames
   * @hideinitializer */
 #define OPUS_SET_DRED_DURATION(x) OPUS_SET_DRED_DURATION_REQUEST, __opus_check_int(x)
@@ -644,10 +684,115 @@ extern "C" {
   * @hideinitializer */
 #define OPUS_GET_DRED_DURATION(x) OPUS_GET_DRED_DURATION_REQUEST, __opus_check_int_ptr(x)
 
+/** Application-supplied worker thread for #OPUS_SET_DRED_WORKER. */
+typedef struct OpusDREDWorker {
+  /** Starts <code>task(arg)</code> on the worker and returns without waiting for it. */
+  void (*start)(void *user_data, void (*task)(void *arg), void *arg);
+  /** Returns once the task last given to start() has completed. */
+  void (*wait)(void *user_data);
+  /** Opaque pointer passed back to start() and wait(). */
+  void *user_data;
+} OpusDREDWorker;
+
+/** Moves the Deep Redundancy (DRED) analysis off the encoding thread.
+  * While a worker is set, the DRED features and latents of each frame are
+  * computed by the worker while the calling thread encodes that frame, and
+  * the encoder waits for them at the start of the next frame. The DRED data
+  * of each packet then ends one frame earlier than it otherwise would (see
+  * #OPUS_GET_DRED_DELAY). At most one task per encoder is outstanding at a
+  * time, so each encoder needs a worker of its own, though many can share a
+  * thread pool. The worker is copied, survives #OPUS_RESET_STATE, and the
+  * encoder waits for its task when destroyed; states allocated by the
+  * application (including multistream encoders) must detach it with
+  * <code>OPUS_SET_DRED_WORKER(NULL)</code> before their memory is released.
+  * @retval OPUS_UNIMPLEMENTED libopus was built without DRED, or with a
+  *                            non thread-safe stack allocator.
+  * @param[in] x <tt>const OpusDREDWorker *</tt>: The worker, or NULL to compute
+  *                                               DRED on the calling thread
+  *                                               (the default).
+  * @hideinitializer */
+#define OPUS_SET_DRED_WORKER(x) OPUS_SET_DRED_WORKER_REQUEST, __opus_check_dred_worker_ptr(x)
+/** Gets how much older the DRED data of the last packet is because of
+  * #OPUS_SET_DRED_WORKER, i.e. the duration of its audio frame, or 0 when
+  * DRED is computed on the calling thread.
+  * @param[out] x <tt>opus_int32 *</tt>: Delay in samples (at the encoder's sampling rate).
+  * @hideinitializer */
+#define OPUS_GET_DRED_DELAY(x) OPUS_GET_DRED_DELAY_REQUEST, __opus_check_int_ptr(x)
+
+/** Gets the number of noise shaping quantization passes the SILK rate
+  * control needed for the last encoded packet, summed over its SILK frames
+  * and channels.
+  * With a bitrate cap or CBR, SILK re-quantizes a frame with adjusted gains
+  * until it fits the budget, so the count divided by the number of frames
+  * shows how hard the budget was to hit. It is 0 for CELT-only packets and
+  * packets that were not coded.
+  * @param[out] x <tt>opus_int32 *</tt>: Number of passes.
+  * @hideinitializer */
+#define OPUS_GET_SILK_RATE_PASSES(x) OPUS_GET_SILK_RATE_PASSES_REQUEST, __opus_check_int_ptr(x)
+
 /** Provide external DNN weights from binary object (only when explicitly built without the weights)
   * @hideinitializer */
 #define OPUS_SET_DNN_BLOB(data, len) OPUS_SET_DNN_BLOB_REQUEST, __opus_check_void_ptr(data), __opus_check_int(len)
 
+/** Attaches a shared DNN model created with opus_dnn_model_create(), or detaches it when NULL.
+  * The encoder or decoder keeps a reference to the model until it is destroyed
+  * or another model is attached. Detaching returns to the built-in weights, if any.
+  * @retval OPUS_BAD_ARG The model lacks a network this encoder or decoder needs.
+  * @hideinitializer */
+#define OPUS_SET_DNN_MODEL(x) OPUS_SET_DNN_MODEL_REQUEST, __opus_check_void_ptr(x)
+
+/** Attaches a decoder to a CPU governor created with opus_dnn_governor_create(),
+  * or detaches it when NULL.
+  * The decoder keeps a reference to the governor until it is destroyed or
+  * another governor is attached, and survives #OPUS_RESET_STATE.
+  * @retval OPUS_UNIMPLEMENTED libopus was built without deep PLC.
+  * @param[in] x <tt>OpusDNNGovernor *</tt>: Governor, or NULL.
+  * @hideinitializer */
+#define OPUS_SET_DNN_GOVERNOR(x) OPUS_SET_DNN_GOVERNOR_REQUEST, __opus_check_void_ptr(x)
+
+/** Makes the decoder run the deep PLC analysis on every good frame instead
+  * of on the first lost frame.
+  * Normally the feature analysis and the PLC network catch up on up to
+  * 150 ms of past audio when a loss begins, so the first concealed frame
+  * costs much more than the following ones. In look-ahead mode that work is
+  * spread over the good frames, one 10 ms step at a time, and the first loss
+  * costs about as much as any other concealed frame. This raises the
+  * average decoding cost and changes the concealed audio (the PLC network
+  * then sees the whole history instead of the last 150 ms). It has no effect
+  * below complexity 5, and only applies to wideband SILK and hybrid frames,
+  * since the
+  * decoder only hands good CELT frames to the deep PLC once a loss begins.
+  * The setting survives #OPUS_RESET_STATE.
+  * @see OPUS_GET_DEEP_PLC_LOOKAHEAD
+  * @retval OPUS_UNIMPLEMENTED libopus was built without deep PLC.
+  * @param[in] x <tt>opus_int32</tt>: Allowed values:
+  * <dl>
+  * <dt>0</dt><dd>Analyze on the first lost frame (default).</dd>
+  * <dt>1</dt><dd>Analyze every good frame.</dd>
+  * </dl>
+  * @hideinitializer */
+#define OPUS_SET_DEEP_PLC_LOOKAHEAD(x) OPUS_SET_DEEP_PLC_LOOKAHEAD_REQUEST, __opus_check_int(x)
+/** Gets the decoder's deep PLC look-ahead mode.
+  * @see OPUS_SET_DEEP_PLC_LOOKAHEAD
+  * @param[out] x <tt>opus_int32 *</tt>: Returns 0 or 1.
+  * @hideinitializer */
+#define OPUS_GET_DEEP_PLC_LOOKAHEAD(x) OPUS_GET_DEEP_PLC_LOOKAHEAD_REQUEST, __opus_check_int_ptr(x)
+
+/** Attaches a scratch arena of at least opus_encoder_get_scratch_size() bytes
+  * to the encoder, or detaches it when NULL.
+  * While an arena is attached, the temporary buffers of each encode call are
+  * bump-allocated from it, so that the call needs little stack and does not
+  * allocate. opus_encoder_get_scratch_size() covers everything an encode call
+  * takes, so the arena is never overrun. The arena must stay valid while it is
+  * attached, and must not be used by another encoder or thread during an
+  * encode call. It survives #OPUS_RESET_STATE.
+  * @retval OPUS_BAD_ARG The arena is smaller than opus_encoder_get_scratch_size().
+  * @retval OPUS_UNIMPLEMENTED libopus was built without scratch arena support.
+  * @param[in] x <tt>void *</tt>: Start of the arena, or NULL.
+  * @param[in] y <tt>opus_int32</tt>: Size of the arena in bytes.
+  * @hideinitializer */
+#define OPUS_SET_SCRATCH_ARENA(x, y) OPUS_SET_SCRATCH_ARENA_REQUEST, __opus_check_void_ptr(x), __opus_check_int(y)
+
 
 /**@}*/
 
@@ -758,6 +903,50 @@ extern "C" {
   * @hideinitializer */
 #define OPUS_GET_IN_DTX(x) OPUS_GET_IN_DTX_REQUEST, __opus_check_int_ptr(x)
 
+/** @name Profiling stages
+  * Indices into the arrays of #OpusProfileStats. Stages nest (for example
+  * #OPUS_PROFILE_SILK_NSQ runs inside #OPUS_PROFILE_SILK), so the time of
+  * each stage includes the time of the stages it calls.
+  * @{
+  */
+#define OPUS_PROFILE_TOTAL                   0 /**< Whole encode or decode call */
+#define OPUS_PROFILE_ANALYSIS                1 /**< Tonality analysis */
+#define OPUS_PROFILE_SILK                    2 /**< SILK encoder or decoder */
+#define OPUS_PROFILE_SILK_NSQ                3 /**< SILK noise shaping quantization */
+#define OPUS_PROFILE_PITCH                   4 /**< SILK and CELT pitch analysis */
+#define OPUS_PROFILE_CELT                    5 /**< CELT encoder or decoder */
+#define OPUS_PROFILE_MDCT                    6 /**< CELT forward MDCT or synthesis */
+#define OPUS_PROFILE_PVQ                     7 /**< CELT PVQ search or decoding */
+#define OPUS_PROFILE_ENTROPY                 8 /**< SILK indices and pulses, CELT coarse energy */
+#define OPUS_PROFILE_DNN                     9 /**< DNN layers (deep PLC, DRED, OSCE) */
+#define OPUS_PROFILE_DRED                   10 /**< DRED latent computation */
+#define OPUS_PROFILE_RESAMPLER              11 /**< SILK resampler */
+#define OPUS_PROFILE_NB_STAGES              12
+/** Size of the #OpusProfileStats arrays, leaving room for new stages. */
+#define OPUS_PROFILE_MAX_STAGES             16
+/**@}*/
+
+/** Per-stage timing counters of an encoder or decoder.
+  * Only collected when libopus is built with profiling enabled.
+  * @see OPUS_GET_PROFILE_STATS */
+typedef struct OpusProfileStats {
+  opus_uint64 time_ns[OPUS_PROFILE_MAX_STAGES]; /**< Accumulated wall-clock time per stage, in nanoseconds */
+  opus_uint64 calls[OPUS_PROFILE_MAX_STAGES];   /**< Number of times each stage was entered */
+} OpusProfileStats;
+
+/** Gets the per-stage timing counters accumulated since the encoder or decoder
+  * was created or since the last #OPUS_RESET_PROFILE_STATS.
+  * The counters survive #OPUS_RESET_STATE.
+  * @retval OPUS_UNIMPLEMENTED libopus was built without profiling.
+  * @param[out] x <tt>OpusProfileStats *</tt>: Returns a copy of the counters.
+  * @hideinitializer */
+#define OPUS_GET_PROFILE_STATS(x) OPUS_GET_PROFILE_STATS_REQUEST, __opus_check_profile_ptr(x)
+
+/** Clears the per-stage timing counters.
+  * @retval OPUS_UNIMPLEMENTED libopus was built without profiling.
+  * @hideinitializer */
+#define OPUS_RESET_PROFILE_STATS OPUS_RESET_PROFILE_STATS_REQUEST
+
 /**@}*/
 
 /** @defgroup opus_decoderctls Decoder related CTLs
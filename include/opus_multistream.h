@@ -39,6 +39,20 @@
 extern "C" {
 #endif
 
+/** A unit of work handed to an #opus_ms_run_tasks_func.
+  * @param arg The <code>arg</code> pointer given to the runner.
+  * @param index The index of the task, in <code>[0, count)</code>.
+  */
+typedef void (*opus_ms_run_task_func)(void *arg, int index);
+
+/** Application-supplied task runner for #OPUS_MULTISTREAM_SET_TASK_RUNNER.
+  * @param user_data The opaque pointer registered with the runner.
+  * @param task The function to run for each task.
+  * @param arg Argument to pass to every invocation of \a task.
+  * @param count Number of tasks to run.
+  */
+typedef void (*opus_ms_run_tasks_func)(void *user_data, opus_ms_run_task_func task, void *arg, int count);
+
 /** @cond OPUS_INTERNAL_DOC */
 
 /** Macros to trigger compilation errors when the wrong types are provided to a
@@ -46,6 +60,7 @@ extern "C" {
 /**@{*/
 #define __opus_check_encstate_ptr(ptr) ((ptr) + ((ptr) - (OpusEncoder**)(ptr)))
 #define __opus_check_decstate_ptr(ptr) ((ptr) + ((ptr) - (OpusDecoder**)(ptr)))
+#define __opus_check_run_tasks(x) (((void)((x) == (opus_ms_run_tasks_func)0)), (opus_ms_run_tasks_func)(x))
 /**@}*/
 
 /** These are the actual encoder and decoder CTL ID numbers.
@@ -54,6 +69,7 @@ extern "C" {
 /**@{*/
 #define OPUS_MULTISTREAM_GET_ENCODER_STATE_REQUEST 5120
 #define OPUS_MULTISTREAM_GET_DECODER_STATE_REQUEST 5122
+#define OPUS_MULTISTREAM_SET_TASK_RUNNER_REQUEST 5124
 /**@}*/
 
 /** @endcond */
@@ -98,6 +114,31 @@ extern "C" {
   */
 #define OPUS_MULTISTREAM_GET_DECODER_STATE(x,y) OPUS_MULTISTREAM_GET_DECODER_STATE_REQUEST, __opus_check_int(x), __opus_check_decstate_ptr(y)
 
+/** Configures a task runner used to encode the elementary streams of a
+  * multistream encoder concurrently.
+  *
+  * The runner is called once per packet with the per-stream encoding work.
+  * It must invoke <code>task(arg, i)</code> exactly once for each
+  * <code>i</code> in <code>[0, count)</code>, in any order and from any
+  * thread, and return only once all of these calls have completed.
+  * The packets produced are byte-identical to those of a serial encode.
+  * Streams are only encoded concurrently in VBR mode and when the output
+  * buffer is large enough that no stream's byte budget can depend on the
+  * size of the streams before it (at least 1280 bytes per stream for frames
+  * of 20 ms or less); otherwise the encoder silently falls back to encoding
+  * the streams one after another on the calling thread.
+  * This is only available when libopus is built with a thread-safe stack
+  * allocator (i.e. not with <code>NONTHREADSAFE_PSEUDOSTACK</code>).
+  * @param[in] x <tt>opus_ms_run_tasks_func</tt>: The task runner, or NULL to
+  *                                               disable concurrent encoding
+  *                                               (the default).
+  * @param[in] y <tt>void*</tt>: Opaque pointer passed back to the runner.
+  * @retval OPUS_UNIMPLEMENTED The library was built without a thread-safe
+  *                            stack allocator.
+  * @hideinitializer
+  */
+#define OPUS_MULTISTREAM_SET_TASK_RUNNER(x,y) OPUS_MULTISTREAM_SET_TASK_RUNNER_REQUEST, __opus_check_run_tasks(x), __opus_check_void_ptr(y)
+
 /**@}*/
 
 /** @defgroup opus_multistream Opus Multistream API
@@ -2,6 +2,8 @@ DEEP_PLC_HEAD = \
 dnn/lpcnet.h \
 dnn/burg.h \
 dnn/common.h \
+dnn/dnn_governor.h \
+dnn/dnn_model.h \
 dnn/freq.h \
 dnn/fargan.h \
 dnn/fargan_data.h \
@@ -1,5 +1,7 @@
 DEEP_PLC_SOURCES = \
 dnn/burg.c \
+dnn/dnn_governor.c \
+dnn/dnn_model.c \
 dnn/freq.c \
 dnn/fargan.c \
 dnn/fargan_data.c \
@@ -36,6 +38,8 @@ dnn/lossgen_data.c
 
 DNN_SOURCES_X86_RTCD = dnn/x86/x86_dnn_map.c
 DNN_SOURCES_AVX2 = dnn/x86/nnet_avx2.c
+DNN_SOURCES_AVXVNNI = dnn/x86/nnet_avxvnni.c
+DNN_SOURCES_AVX512 = dnn/x86/nnet_avx512.c
 DNN_SOURCES_SSE4_1 = dnn/x86/nnet_sse4_1.c
 DNN_SOURCES_SSE2 = dnn/x86/nnet_sse2.c
 
@@ -102,6 +102,15 @@ opus_int silk_LoadOSCEModels(
     int len                                             /* I    length of binary blob data                      */
 );
 
+/*****************************************/
+/* Use the OSCE models of a shared model */
+/*****************************************/
+struct OpusDNNModel;
+opus_int silk_SetOSCEModels(
+    void *decState,                                     /* O    I/O State                                       */
+    const struct OpusDNNModel *model                    /* I    shared model, NULL for the built-in weights     */
+);
+
 /***********************************************/
 /* Get size in bytes of the Silk decoder state */
 /***********************************************/
@@ -73,7 +73,8 @@ opus_int silk_resampler(
     silk_resampler_state_struct *S,                 /* I/O  Resampler state                                             */
     opus_int16                  out[],              /* O    Output signal                                               */
     const opus_int16            in[],               /* I    Input signal                                                */
-    opus_int32                  inLen               /* I    Number of input samples                                     */
+    opus_int32                  inLen,              /* I    Number of input samples                                     */
+    int                         arch                /* I    Run-time architecture                                       */
 );
 
 /*!
@@ -271,6 +272,7 @@ opus_int silk_pitch_analysis_core(                  /* O    Voicing estimate: 0
     const opus_int              Fs_kHz,             /* I    Sample frequency (kHz)                                      */
     const opus_int              complexity,         /* I    Complexity setting, 0-2, where 2 is highest                 */
     const opus_int              nb_subfr,           /* I    number of 5 ms subframes                                    */
+    const opus_int              trackLag,           /* I    Only search around prevLag; unvoiced if it no longer fits   */
     int                         arch                /* I    Run-time architecture                                       */
 );
 
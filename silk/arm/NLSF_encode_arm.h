@@ -0,0 +1,110 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SILK_NLSF_ENCODE_ARM_H
+# define SILK_NLSF_ENCODE_ARM_H
+
+# include "celt/arm/armcpu.h"
+
+# if defined(OPUS_ARM_MAY_HAVE_NEON_INTR)
+void silk_NLSF_VQ_neon(
+    opus_int32                  err_Q24[],                      /* O    Quantization errors [K]                     */
+    const opus_int16            in_Q15[],                       /* I    Input vectors to be quantized [LPC_order]   */
+    const opus_uint8            pCB_Q8[],                       /* I    Codebook vectors [K*LPC_order]              */
+    const opus_int16            pWght_Q9[],                     /* I    Codebook weights [K*LPC_order]              */
+    const opus_int              K,                              /* I    Number of codebook vectors                  */
+    const opus_int              LPC_order                       /* I    Number of LPCs                              */
+);
+
+opus_int32 silk_NLSF_del_dec_quant_neon(                        /* O    Returns RD value in Q25                     */
+    opus_int8                   indices[],                      /* O    Quantization indices [ order ]              */
+    const opus_int16            x_Q10[],                        /* I    Input [ order ]                             */
+    const opus_int16            w_Q5[],                         /* I    Weights [ order ]                           */
+    const opus_uint8            pred_coef_Q8[],                 /* I    Backward predictor coefs [ order ]          */
+    const opus_int16            ec_ix[],                        /* I    Indices to entropy coding tables [ order ]  */
+    const opus_uint8            ec_rates_Q5[],                  /* I    Rates []                                    */
+    const opus_int              quant_step_size_Q16,            /* I    Quantization step size                      */
+    const opus_int16            inv_quant_step_size_Q6,         /* I    Inverse quantization step size              */
+    const opus_int32            mu_Q20,                         /* I    R/D tradeoff                                */
+    const opus_int16            order                           /* I    Number of input values                      */
+);
+
+#  if !defined(OPUS_HAVE_RTCD) && defined(OPUS_ARM_PRESUME_NEON)
+#   define OVERRIDE_silk_NLSF_VQ (1)
+#   define silk_NLSF_VQ(err_Q24, in_Q15, pCB_Q8, pWght_Q9, K, LPC_order, arch) \
+    ((void)(arch), PRESUME_NEON(silk_NLSF_VQ)(err_Q24, in_Q15, pCB_Q8, pWght_Q9, K, LPC_order))
+#   define OVERRIDE_silk_NLSF_del_dec_quant (1)
+#   define silk_NLSF_del_dec_quant(indices, x_Q10, w_Q5, pred_coef_Q8, ec_ix, ec_rates_Q5, quant_step_size_Q16, \
+        inv_quant_step_size_Q6, mu_Q20, order, arch) \
+    ((void)(arch), PRESUME_NEON(silk_NLSF_del_dec_quant)(indices, x_Q10, w_Q5, pred_coef_Q8, ec_ix, ec_rates_Q5, \
+        quant_step_size_Q16, inv_quant_step_size_Q6, mu_Q20, order))
+#  endif
+# endif
+
+# if !defined(OVERRIDE_silk_NLSF_VQ)
+/*Is run-time CPU detection enabled on this platform?*/
+#  if defined(OPUS_HAVE_RTCD) && (defined(OPUS_ARM_MAY_HAVE_NEON_INTR) && !defined(OPUS_ARM_PRESUME_NEON_INTR))
+extern void (*const SILK_NLSF_VQ_IMPL[OPUS_ARCHMASK+1])(
+    opus_int32                  err_Q24[],                      /* O    Quantization errors [K]                     */
+    const opus_int16            in_Q15[],                       /* I    Input vectors to be quantized [LPC_order]   */
+    const opus_uint8            pCB_Q8[],                       /* I    Codebook vectors [K*LPC_order]              */
+    const opus_int16            pWght_Q9[],                     /* I    Codebook weights [K*LPC_order]              */
+    const opus_int              K,                              /* I    Number of codebook vectors                  */
+    const opus_int              LPC_order                       /* I    Number of LPCs                              */
+);
+extern opus_int32 (*const SILK_NLSF_DEL_DEC_QUANT_IMPL[OPUS_ARCHMASK+1])(
+    opus_int8                   indices[],                      /* O    Quantization indices [ order ]              */
+    const opus_int16            x_Q10[],                        /* I    Input [ order ]                             */
+    const opus_int16            w_Q5[],                         /* I    Weights [ order ]                           */
+    const opus_uint8            pred_coef_Q8[],                 /* I    Backward predictor coefs [ order ]          */
+    const opus_int16            ec_ix[],                        /* I    Indices to entropy coding tables [ order ]  */
+    const opus_uint8            ec_rates_Q5[],                  /* I    Rates []                                    */
+    const opus_int              quant_step_size_Q16,            /* I    Quantization step size                      */
+    const opus_int16            inv_quant_step_size_Q6,         /* I    Inverse quantization step size              */
+    const opus_int32            mu_Q20,                         /* I    R/D tradeoff                                */
+    const opus_int16            order                           /* I    Number of input values                      */
+);
+#   define OVERRIDE_silk_NLSF_VQ (1)
+#   define silk_NLSF_VQ(err_Q24, in_Q15, pCB_Q8, pWght_Q9, K, LPC_order, arch) \
+    ((*SILK_NLSF_VQ_IMPL[(arch)&OPUS_ARCHMASK])(err_Q24, in_Q15, pCB_Q8, pWght_Q9, K, LPC_order))
+#   define OVERRIDE_silk_NLSF_del_dec_quant (1)
+#   define silk_NLSF_del_dec_quant(indices, x_Q10, w_Q5, pred_coef_Q8, ec_ix, ec_rates_Q5, quant_step_size_Q16, \
+        inv_quant_step_size_Q6, mu_Q20, order, arch) \
+    ((*SILK_NLSF_DEL_DEC_QUANT_IMPL[(arch)&OPUS_ARCHMASK])(indices, x_Q10, w_Q5, pred_coef_Q8, ec_ix, ec_rates_Q5, \
+        quant_step_size_Q16, inv_quant_step_size_Q6, mu_Q20, order))
+#  elif defined(OPUS_ARM_PRESUME_NEON_INTR)
+#   define OVERRIDE_silk_NLSF_VQ (1)
+#   define silk_NLSF_VQ(err_Q24, in_Q15, pCB_Q8, pWght_Q9, K, LPC_order, arch) \
+    ((void)(arch), silk_NLSF_VQ_neon(err_Q24, in_Q15, pCB_Q8, pWght_Q9, K, LPC_order))
+#   define OVERRIDE_silk_NLSF_del_dec_quant (1)
+#   define silk_NLSF_del_dec_quant(indices, x_Q10, w_Q5, pred_coef_Q8, ec_ix, ec_rates_Q5, quant_step_size_Q16, \
+        inv_quant_step_size_Q6, mu_Q20, order, arch) \
+    ((void)(arch), silk_NLSF_del_dec_quant_neon(indices, x_Q10, w_Q5, pred_coef_Q8, ec_ix, ec_rates_Q5, \
+        quant_step_size_Q16, inv_quant_step_size_Q6, mu_Q20, order))
+#  endif
+# endif
+
+#endif /* end SILK_NLSF_ENCODE_ARM_H */
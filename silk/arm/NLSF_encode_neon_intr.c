@@ -0,0 +1,300 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <arm_neon.h>
+#include "main.h"
+
+/* Weighted absolute predictive errors of one codebook vector, summed into four lanes */
+static OPUS_INLINE int32x4_t silk_NLSF_VQ_err( int16x8_t in_lo, int16x8_t in_hi, const opus_uint8 *pCB_Q8,
+    const opus_int16 *pWght_Q9, opus_int LPC_order )
+{
+    uint8x8_t cb;
+    int16x8_t diff, w;
+    int32x4_t d0, d1, d2, d3, sum;
+
+    /* The 16-bit differences wrap the same way silk_SMULBB() truncates them */
+    diff = vsubq_s16( in_lo, vreinterpretq_s16_u16( vshll_n_u8( vld1_u8( pCB_Q8 ), 7 ) ) );
+    w    = vld1q_s16( pWght_Q9 );
+    d0   = vmull_s16( vget_low_s16( diff ), vget_low_s16( w ) );
+    d1   = vmull_s16( vget_high_s16( diff ), vget_high_s16( w ) );
+    if( LPC_order == 16 ) {
+        cb = vld1_u8( &pCB_Q8[ 8 ] );
+        w  = vld1q_s16( &pWght_Q9[ 8 ] );
+    } else {
+        /* Entries 8 and 9; the unused lanes have zero weight */
+        cb = vset_lane_u8( pCB_Q8[ 9 ], vset_lane_u8( pCB_Q8[ 8 ], vdup_n_u8( 0 ), 0 ), 1 );
+        w  = vsetq_lane_s16( pWght_Q9[ 9 ], vsetq_lane_s16( pWght_Q9[ 8 ], vdupq_n_s16( 0 ), 0 ), 1 );
+    }
+    diff = vsubq_s16( in_hi, vreinterpretq_s16_u16( vshll_n_u8( cb, 7 ) ) );
+    d2   = vmull_s16( vget_low_s16( diff ), vget_low_s16( w ) );
+    d3   = vmull_s16( vget_high_s16( diff ), vget_high_s16( w ) );
+
+    /* Element m is predicted from half of element m + 1, and the last one from zero */
+    sum = vabdq_s32( d0, vshrq_n_s32( vextq_s32( d0, d1, 1 ), 1 ) );
+    sum = vabaq_s32( sum, d1, vshrq_n_s32( vextq_s32( d1, d2, 1 ), 1 ) );
+    sum = vabaq_s32( sum, d2, vshrq_n_s32( vextq_s32( d2, d3, 1 ), 1 ) );
+    sum = vabaq_s32( sum, d3, vshrq_n_s32( vextq_s32( d3, vdupq_n_s32( 0 ), 1 ), 1 ) );
+    return sum;
+}
+
+static OPUS_INLINE int32x2_t silk_NLSF_VQ_hadd_x2( int32x4_t a, int32x4_t b )
+{
+    return vpadd_s32( vadd_s32( vget_low_s32( a ), vget_high_s32( a ) ),
+                      vadd_s32( vget_low_s32( b ), vget_high_s32( b ) ) );
+}
+
+void silk_NLSF_VQ_neon(
+    opus_int32                  err_Q24[],                      /* O    Quantization errors [K]                     */
+    const opus_int16            in_Q15[],                       /* I    Input vectors to be quantized [LPC_order]   */
+    const opus_uint8            pCB_Q8[],                       /* I    Codebook vectors [K*LPC_order]              */
+    const opus_int16            pWght_Q9[],                     /* I    Codebook weights [K*LPC_order]              */
+    const opus_int              K,                              /* I    Number of codebook vectors                  */
+    const opus_int              LPC_order                       /* I    Number of LPCs                              */
+)
+{
+    opus_int  i;
+    int16x8_t in_lo, in_hi;
+    int32x4_t s0, s1, s2, s3;
+
+    celt_assert( LPC_order == 10 || LPC_order == 16 );
+
+    in_lo = vld1q_s16( &in_Q15[ 0 ] );
+    if( LPC_order == 16 ) {
+        in_hi = vld1q_s16( &in_Q15[ 8 ] );
+    } else {
+        in_hi = vsetq_lane_s16( in_Q15[ 9 ], vsetq_lane_s16( in_Q15[ 8 ], vdupq_n_s16( 0 ), 0 ), 1 );
+    }
+
+    for( i = 0; i < K - 3; i += 4 ) {
+        s0 = silk_NLSF_VQ_err( in_lo, in_hi, &pCB_Q8[ ( i + 0 ) * LPC_order ], &pWght_Q9[ ( i + 0 ) * LPC_order ], LPC_order );
+        s1 = silk_NLSF_VQ_err( in_lo, in_hi, &pCB_Q8[ ( i + 1 ) * LPC_order ], &pWght_Q9[ ( i + 1 ) * LPC_order ], LPC_order );
+        s2 = silk_NLSF_VQ_err( in_lo, in_hi, &pCB_Q8[ ( i + 2 ) * LPC_order ], &pWght_Q9[ ( i + 2 ) * LPC_order ], LPC_order );
+        s3 = silk_NLSF_VQ_err( in_lo, in_hi, &pCB_Q8[ ( i + 3 ) * LPC_order ], &pWght_Q9[ ( i + 3 ) * LPC_order ], LPC_order );
+        vst1q_s32( &err_Q24[ i ], vcombine_s32( silk_NLSF_VQ_hadd_x2( s0, s1 ), silk_NLSF_VQ_hadd_x2( s2, s3 ) ) );
+    }
+    for( ; i < K; i++ ) {
+        s0 = silk_NLSF_VQ_err( in_lo, in_hi, &pCB_Q8[ i * LPC_order ], &pWght_Q9[ i * LPC_order ], LPC_order );
+        err_Q24[ i ] = vget_lane_s32( silk_NLSF_VQ_hadd_x2( s0, s0 ), 0 );
+    }
+}
+
+/* Minimum of all lanes, in all lanes */
+static OPUS_INLINE int32x4_t silk_vhminq_s32( int32x4_t a )
+{
+    int32x2_t m;
+    m = vpmin_s32( vget_low_s32( a ), vget_high_s32( a ) );
+    m = vpmin_s32( m, m );
+    return vcombine_s32( m, m );
+}
+
+/* Maximum of all lanes, in all lanes */
+static OPUS_INLINE int32x4_t silk_vhmaxq_s32( int32x4_t a )
+{
+    int32x2_t m;
+    m = vpmax_s32( vget_low_s32( a ), vget_high_s32( a ) );
+    m = vpmax_s32( m, m );
+    return vcombine_s32( m, m );
+}
+
+/* Index of the first lane of a that equals b, in all lanes */
+static OPUS_INLINE int32x4_t silk_NLSF_first_equal( int32x4_t a, int32x4_t b, int32x4_t lanes )
+{
+    return silk_vhminq_s32( vbslq_s32( vceqq_s32( a, b ), lanes, vdupq_n_s32( NLSF_QUANT_DEL_DEC_STATES ) ) );
+}
+
+/* The one lane of a selected by mask, in all lanes */
+static OPUS_INLINE int16x4_t silk_NLSF_select_lane( int16x4_t a, uint16x4_t mask )
+{
+    a = vand_s16( a, vreinterpret_s16_u16( mask ) );
+    a = vpadd_s16( a, a );
+    return vpadd_s16( a, a );
+}
+
+/* Reconstructed value and RD cost of quantizing the residual of each state to level ind.  */
+/* 16-bit lanes for the outputs wrap like the opus_int16 values of the C code.            */
+static OPUS_INLINE int32x4_t silk_NLSF_del_dec_level( int16x4_t *out, int16x4_t ind, int16x4_t pred,
+    int16x4_t in, opus_int32 w, uint8x8_t rates, opus_int16 step, opus_int16 mu, int32x4_t RD )
+{
+    int16x4_t level, abs_ind, rate, diff;
+    uint8x8_t rate_ix;
+
+    /* Level ind is ind - 0.1 for ind > 0 and ind + 0.1 for ind < 0, in Q10 */
+    level = vsub_s16( vshl_n_s16( ind, 10 ), vmul_n_s16( vmax_s16( vmin_s16( ind, vdup_n_s16( 1 ) ),
+                vdup_n_s16( -1 ) ), SILK_FIX_CONST( NLSF_QUANT_LEVEL_ADJ, 10 ) ) );
+    *out  = vadd_s16( vshrn_n_s32( vmull_n_s16( level, step ), 16 ), pred );
+
+    /* Table rate for |ind| < NLSF_QUANT_MAX_AMPLITUDE, linear in |ind| beyond; */
+    /* out of range table indices give zero                                      */
+    abs_ind = vabs_s16( ind );
+    rate_ix = vreinterpret_u8_s8( vmovn_s16( vcombine_s16( vadd_s16( ind, vdup_n_s16( NLSF_QUANT_MAX_AMPLITUDE ) ),
+                  vdup_n_s16( -1 ) ) ) );
+    rate    = vget_low_s16( vreinterpretq_s16_u16( vmovl_u8( vtbl1_u8( rates, rate_ix ) ) ) );
+    rate    = vbsl_s16( vclt_s16( abs_ind, vdup_n_s16( NLSF_QUANT_MAX_AMPLITUDE ) ), rate,
+                  vmla_n_s16( vdup_n_s16( 280 - 43 * NLSF_QUANT_MAX_AMPLITUDE ), abs_ind, 43 ) );
+
+    diff = vsub_s16( in, *out );
+    RD   = vmlaq_n_s32( RD, vmull_s16( diff, diff ), w );
+    return vmlal_n_s16( RD, rate, mu );
+}
+
+/* Delayed-decision quantizer for NLSF residuals, with the states in the lanes of a vector.  */
+/* Rather than copying index paths between states, each step stores the index and the      */
+/* parent state of every survivor, and the winning path is traced back at the end.         */
+opus_int32 silk_NLSF_del_dec_quant_neon(                        /* O    Returns RD value in Q25                     */
+    opus_int8                   indices[],                      /* O    Quantization indices [ order ]              */
+    const opus_int16            x_Q10[],                        /* I    Input [ order ]                             */
+    const opus_int16            w_Q5[],                         /* I    Weights [ order ]                           */
+    const opus_uint8            pred_coef_Q8[],                 /* I    Backward predictor coefs [ order ]          */
+    const opus_int16            ec_ix[],                        /* I    Indices to entropy coding tables [ order ]  */
+    const opus_uint8            ec_rates_Q5[],                  /* I    Rates []                                    */
+    const opus_int              quant_step_size_Q16,            /* I    Quantization step size                      */
+    const opus_int16            inv_quant_step_size_Q6,         /* I    Inverse quantization step size              */
+    const opus_int32            mu_Q20,                         /* I    R/D tradeoff                                */
+    const opus_int16            order                           /* I    Number of input values                      */
+)
+{
+    static const opus_int32 lane_ix[ NLSF_QUANT_DEL_DEC_STATES ]        = { 0, 1, 2, 3 };
+    static const opus_int16 half_parent_ix[ NLSF_QUANT_DEL_DEC_STATES ] = { 0, 1, 0, 1 };
+    opus_int         i, j, nStates, ind_tmp;
+    opus_int32       min_Q25;
+    opus_int32       RD_Q25[ 2 * NLSF_QUANT_DEL_DEC_STATES ];
+    opus_int8        path[ MAX_LPC_ORDER ][ 2 * NLSF_QUANT_DEL_DEC_STATES ];
+    uint8x8_t        rates;
+    uint16x4_t       swap, src16, dst16;
+    uint32x4_t       src, dst;
+    int16x4_t        in, pred, ind0, ind1, prev_out, prev_lose, out0, out1, ind_sort, parent;
+    int32x4_t        lanes, RD, RD0, RD1, RD_max, RD_min, RD_lose, min_max, max_min, ind_max_min;
+
+    silk_assert( NLSF_QUANT_DEL_DEC_STATES == 4 );
+    celt_assert( order == 10 || order == 16 );
+
+    lanes = vld1q_s32( lane_ix );
+
+    nStates  = 1;
+    RD       = vdupq_n_s32( 0 );
+    RD_max   = vdupq_n_s32( 0 );
+    prev_out = vdup_n_s16( 0 );
+    for( i = order - 1; i >= 0; i-- ) {
+        rates = vld1_u8( &ec_rates_Q5[ ec_ix[ i ] ] );
+        in    = vdup_n_s16( x_Q10[ i ] );
+
+        pred = vmovn_s32( vshrq_n_s32( vmull_n_s16( prev_out, (opus_int16)pred_coef_Q8[ i ] ), 8 ) );
+        ind0 = vshrn_n_s32( vmull_n_s16( vsub_s16( in, pred ), inv_quant_step_size_Q6 ), 16 );
+        ind0 = vmax_s16( vmin_s16( ind0, vdup_n_s16( NLSF_QUANT_MAX_AMPLITUDE_EXT - 1 ) ),
+                   vdup_n_s16( -NLSF_QUANT_MAX_AMPLITUDE_EXT ) );
+        ind1 = vadd_s16( ind0, vdup_n_s16( 1 ) );
+        RD0  = silk_NLSF_del_dec_level( &out0, ind0, pred, in, w_Q5[ i ], rates,
+                   (opus_int16)quant_step_size_Q16, (opus_int16)mu_Q20, RD );
+        RD1  = silk_NLSF_del_dec_level( &out1, ind1, pred, in, w_Q5[ i ], rates,
+                   (opus_int16)quant_step_size_Q16, (opus_int16)mu_Q20, RD );
+
+        if( nStates <= NLSF_QUANT_DEL_DEC_STATES/2 ) {
+            /* double number of states: state j + nStates takes the upper level of state j */
+            if( nStates == 1 ) {
+                RD       = vzipq_s32( RD0, RD1 ).val[ 0 ];
+                prev_out = vzip_s16( out0, out1 ).val[ 0 ];
+                ind0     = vzip_s16( ind0, ind1 ).val[ 0 ];
+                parent   = vdup_n_s16( 0 );
+            } else {
+                RD       = vcombine_s32( vget_low_s32( RD0 ), vget_low_s32( RD1 ) );
+                prev_out = vreinterpret_s16_s32( vzip_s32( vreinterpret_s32_s16( out0 ), vreinterpret_s32_s16( out1 ) ).val[ 0 ] );
+                ind0     = vreinterpret_s16_s32( vzip_s32( vreinterpret_s32_s16( ind0 ), vreinterpret_s32_s16( ind1 ) ).val[ 0 ] );
+                parent   = vld1_s16( half_parent_ix );
+            }
+            nStates = silk_LSHIFT( nStates, 1 );
+        } else {
+            /* sort lower and upper half of RD, pairwise */
+            swap      = vmovn_u32( vcgtq_s32( RD0, RD1 ) );
+            RD        = vminq_s32( RD0, RD1 );
+            RD_max    = vmaxq_s32( RD0, RD1 );
+            prev_out  = vbsl_s16( swap, out1, out0 );
+            prev_lose = vbsl_s16( swap, out0, out1 );
+            ind_sort  = vorr_s16( vmovn_s32( lanes ),
+                            vand_s16( vreinterpret_s16_u16( swap ), vdup_n_s16( NLSF_QUANT_DEL_DEC_STATES ) ) );
+
+            /* compare the highest RD values of the winning half with the lowest one in the losing half, */
+            /* and copy if necessary; afterwards ind_sort holds where each survivor came from             */
+            RD_min  = RD;
+            RD_lose = RD_max;
+            min_max = silk_vhminq_s32( RD_lose );
+            max_min = vmaxq_s32( silk_vhmaxq_s32( RD_min ), vdupq_n_s32( 0 ) );
+            while( vgetq_lane_s32( min_max, 0 ) < vgetq_lane_s32( max_min, 0 ) ) {
+                /* first minimum of the losing half, first maximum above zero of the winning half */
+                src         = vceqq_s32( lanes, silk_NLSF_first_equal( RD_lose, min_max, lanes ) );
+                ind_max_min = vbslq_s32( vcgtq_s32( max_min, vdupq_n_s32( 0 ) ),
+                                  silk_NLSF_first_equal( RD_min, max_min, lanes ), vdupq_n_s32( 0 ) );
+                dst         = vceqq_s32( lanes, ind_max_min );
+                /* copy ind_min_max to ind_max_min */
+                src16    = vmovn_u32( src );
+                dst16    = vmovn_u32( dst );
+                ind_sort = vbsl_s16( dst16, veor_s16( silk_NLSF_select_lane( ind_sort, src16 ),
+                               vdup_n_s16( NLSF_QUANT_DEL_DEC_STATES ) ), ind_sort );
+                RD       = vbslq_s32( dst, min_max, RD );
+                prev_out = vbsl_s16( dst16, silk_NLSF_select_lane( prev_lose, src16 ), prev_out );
+                RD_min   = vbicq_s32( RD_min, vreinterpretq_s32_u32( dst ) );
+                RD_lose  = vbslq_s32( src, vdupq_n_s32( silk_int32_MAX ), RD_lose );
+                min_max  = silk_vhminq_s32( RD_lose );
+                max_min  = vmaxq_s32( silk_vhmaxq_s32( RD_min ), vdupq_n_s32( 0 ) );
+            }
+
+            /* each survivor continues the path of its parent, with the index incremented if it */
+            /* comes from the upper half                                                         */
+            parent = vand_s16( ind_sort, vdup_n_s16( NLSF_QUANT_DEL_DEC_STATES - 1 ) );
+            ind0   = vget_low_s16( vmovl_s8( vtbl1_s8( vmovn_s16( vcombine_s16( ind0, ind0 ) ),
+                         vmovn_s16( vcombine_s16( parent, parent ) ) ) ) );
+            ind0   = vadd_s16( ind0, vshr_n_s16( ind_sort, NLSF_QUANT_DEL_DEC_STATES_LOG2 ) );
+        }
+        vst1_s8( path[ i ], vmovn_s16( vcombine_s16( ind0, parent ) ) );
+    }
+
+    /* last sample: find winner, trace back its indices and return RD value */
+    vst1q_s32( &RD_Q25[ 0 ], RD );
+    vst1q_s32( &RD_Q25[ NLSF_QUANT_DEL_DEC_STATES ], RD_max );
+    ind_tmp = 0;
+    min_Q25 = silk_int32_MAX;
+    for( j = 0; j < 2 * NLSF_QUANT_DEL_DEC_STATES; j++ ) {
+        if( min_Q25 > RD_Q25[ j ] ) {
+            min_Q25 = RD_Q25[ j ];
+            ind_tmp = j;
+        }
+    }
+    j = ind_tmp & ( NLSF_QUANT_DEL_DEC_STATES - 1 );
+    for( i = 0; i < order; i++ ) {
+        indices[ i ] = path[ i ][ j ];
+        j = path[ i ][ NLSF_QUANT_DEL_DEC_STATES + j ];
+        silk_assert( indices[ i ] >= -NLSF_QUANT_MAX_AMPLITUDE_EXT );
+        silk_assert( indices[ i ] <=  NLSF_QUANT_MAX_AMPLITUDE_EXT );
+    }
+    indices[ 0 ] += silk_RSHIFT( ind_tmp, NLSF_QUANT_DEL_DEC_STATES_LOG2 );
+    silk_assert( indices[ 0 ] <= NLSF_QUANT_MAX_AMPLITUDE_EXT );
+    silk_assert( min_Q25 >= 0 );
+    return min_Q25;
+}
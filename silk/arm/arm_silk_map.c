@@ -28,9 +28,14 @@ POSSIBILITY OF SUCH DAMAGE.
 # include "config.h"
 #endif
 
+#ifdef FIXED_POINT
 #include "main_FIX.h"
+#else
+#include "main_FLP.h"
+#endif
 #include "NSQ.h"
 #include "SigProc_FIX.h"
+#include "resampler_private.h"
 
 #if defined(OPUS_HAVE_RTCD)
 
@@ -103,6 +108,98 @@ opus_int32
   silk_NSQ_noise_shape_feedback_loop_neon, /* dotprod */
 };
 
+void (*const SILK_LTP_SYNTHESIS_IMPL[OPUS_ARCHMASK + 1])(
+        opus_int32                  pres_Q14[],         /* O    LPC excitation [ length ]                                   */
+        opus_int32                  sLTP_Q15[],         /* I/O  LTP state, new samples from sLTP_Q15[ 0 ]                   */
+        const opus_int32            exc_Q14[],          /* I    Excitation [ length ]                                       */
+        const opus_int16            B_Q14[ LTP_ORDER ], /* I    LTP coefficients                                            */
+        const opus_int              lag,                /* I    Pitch lag                                                   */
+        const opus_int              length              /* I    Subframe length                                             */
+) = {
+      silk_LTP_synthesis_c,    /* ARMv4 */
+      silk_LTP_synthesis_c,    /* EDSP */
+      silk_LTP_synthesis_c,    /* Media */
+      silk_LTP_synthesis_neon, /* Neon */
+      silk_LTP_synthesis_neon, /* dotprod */
+};
+
+void (*const SILK_LPC_SYNTHESIS_IMPL[OPUS_ARCHMASK + 1])(
+        opus_int32                  sLPC_Q14[],         /* I/O  State [ MAX_LPC_ORDER ], then output                        */
+        const opus_int32            pres_Q14[],         /* I    LPC excitation [ length ]                                   */
+        const opus_int16            A_Q12[],            /* I    Prediction coefficients [ order ]                           */
+        const opus_int              order,              /* I    Prediction order, 10 or 16                                  */
+        const opus_int              length              /* I    Signal length                                               */
+) = {
+      silk_LPC_synthesis_c,    /* ARMv4 */
+      silk_LPC_synthesis_c,    /* EDSP */
+      silk_LPC_synthesis_c,    /* Media */
+      silk_LPC_synthesis_neon, /* Neon */
+      silk_LPC_synthesis_neon, /* dotprod */
+};
+
+void (*const SILK_NLSF_VQ_IMPL[OPUS_ARCHMASK + 1])(
+        opus_int32                  err_Q24[],          /* O    Quantization errors [K]                                     */
+        const opus_int16            in_Q15[],           /* I    Input vectors to be quantized [LPC_order]                   */
+        const opus_uint8            pCB_Q8[],           /* I    Codebook vectors [K*LPC_order]                              */
+        const opus_int16            pWght_Q9[],         /* I    Codebook weights [K*LPC_order]                              */
+        const opus_int              K,                  /* I    Number of codebook vectors                                  */
+        const opus_int              LPC_order           /* I    Number of LPCs                                              */
+) = {
+      silk_NLSF_VQ_c,          /* ARMv4 */
+      silk_NLSF_VQ_c,          /* EDSP */
+      silk_NLSF_VQ_c,          /* Media */
+      silk_NLSF_VQ_neon,       /* Neon */
+      silk_NLSF_VQ_neon,       /* dotprod */
+};
+
+opus_int32 (*const SILK_NLSF_DEL_DEC_QUANT_IMPL[OPUS_ARCHMASK + 1])(
+        opus_int8                   indices[],          /* O    Quantization indices [ order ]                              */
+        const opus_int16            x_Q10[],            /* I    Input [ order ]                                             */
+        const opus_int16            w_Q5[],             /* I    Weights [ order ]                                           */
+        const opus_uint8            pred_coef_Q8[],     /* I    Backward predictor coefs [ order ]                          */
+        const opus_int16            ec_ix[],            /* I    Indices to entropy coding tables [ order ]                  */
+        const opus_uint8            ec_rates_Q5[],      /* I    Rates []                                                    */
+        const opus_int              quant_step_size_Q16, /* I    Quantization step size                                     */
+        const opus_int16            inv_quant_step_size_Q6, /* I    Inverse quantization step size                          */
+        const opus_int32            mu_Q20,             /* I    R/D tradeoff                                                */
+        const opus_int16            order               /* I    Number of input values                                      */
+) = {
+      silk_NLSF_del_dec_quant_c,    /* ARMv4 */
+      silk_NLSF_del_dec_quant_c,    /* EDSP */
+      silk_NLSF_del_dec_quant_c,    /* Media */
+      silk_NLSF_del_dec_quant_neon, /* Neon */
+      silk_NLSF_del_dec_quant_neon, /* dotprod */
+};
+
+opus_int16 *(*const SILK_RESAMPLER_PRIVATE_IIR_FIR_INTERPOL_IMPL[OPUS_ARCHMASK + 1])(
+        opus_int16                  *out,               /* O    Output signal                                               */
+        opus_int16                  *buf,               /* I    Upsampled signal                                            */
+        opus_int32                  max_index_Q16,      /* I    End of the input, Q16                                       */
+        opus_int32                  index_increment_Q16 /* I    Input step, Q16                                             */
+) = {
+      silk_resampler_private_IIR_FIR_INTERPOL_c,    /* ARMv4 */
+      silk_resampler_private_IIR_FIR_INTERPOL_c,    /* EDSP */
+      silk_resampler_private_IIR_FIR_INTERPOL_c,    /* Media */
+      silk_resampler_private_IIR_FIR_INTERPOL_neon, /* Neon */
+      silk_resampler_private_IIR_FIR_INTERPOL_neon, /* dotprod */
+};
+
+opus_int16 *(*const SILK_RESAMPLER_PRIVATE_DOWN_FIR_INTERPOL_IMPL[OPUS_ARCHMASK + 1])(
+        opus_int16                  *out,               /* O    Output signal                                               */
+        opus_int32                  *buf,               /* I    Filtered signal, Q8                                         */
+        const opus_int16            *FIR_Coefs,         /* I    FIR coefficients, Q14                                       */
+        opus_int                    FIR_Order,          /* I    FIR order                                                   */
+        opus_int                    FIR_Fracs,          /* I    Number of FIR phases                                        */
+        opus_int32                  max_index_Q16,      /* I    End of the input, Q16                                       */
+        opus_int32                  index_increment_Q16 /* I    Input step, Q16                                             */
+) = {
+      silk_resampler_private_down_FIR_INTERPOL_c,    /* ARMv4 */
+      silk_resampler_private_down_FIR_INTERPOL_c,    /* EDSP */
+      silk_resampler_private_down_FIR_INTERPOL_c,    /* Media */
+      silk_resampler_private_down_FIR_INTERPOL_neon, /* Neon */
+      silk_resampler_private_down_FIR_INTERPOL_neon, /* dotprod */
+};
+
 # endif
 
 # if defined(FIXED_POINT) && \
@@ -125,4 +222,49 @@ void (*const SILK_WARPED_AUTOCORRELATION_FIX_IMPL[OPUS_ARCHMASK + 1])(
 
 # endif
 
+# if !defined(FIXED_POINT) && \
+ defined(OPUS_ARM_MAY_HAVE_NEON_INTR) && !defined(OPUS_ARM_PRESUME_NEON_INTR)
+
+double (*const SILK_INNER_PRODUCT_FLP_IMPL[OPUS_ARCHMASK + 1])(
+    const silk_float                *data1,
+    const silk_float                *data2,
+    opus_int                        dataSize
+) = {
+      silk_inner_product_FLP_c,    /* ARMv4 */
+      silk_inner_product_FLP_c,    /* EDSP */
+      silk_inner_product_FLP_c,    /* Media */
+      silk_inner_product_FLP_neon, /* Neon */
+      silk_inner_product_FLP_neon, /* dotprod */
+};
+
+void (*const SILK_WARPED_AUTOCORRELATION_FLP_IMPL[OPUS_ARCHMASK + 1])(
+    silk_float                      *corr,                              /* O    Result [order + 1]                          */
+    const silk_float                *input,                             /* I    Input data to correlate                     */
+    const silk_float                warping,                            /* I    Warping coefficient                         */
+    const opus_int                  length,                             /* I    Length of input                             */
+    const opus_int                  order                               /* I    Correlation order (even)                    */
+) = {
+      silk_warped_autocorrelation_FLP_c,    /* ARMv4 */
+      silk_warped_autocorrelation_FLP_c,    /* EDSP */
+      silk_warped_autocorrelation_FLP_c,    /* Media */
+      silk_warped_autocorrelation_FLP_neon, /* Neon */
+      silk_warped_autocorrelation_FLP_neon, /* dotprod */
+};
+
+void (*const SILK_LPC_ANALYSIS_FILTER_FLP_IMPL[OPUS_ARCHMASK + 1])(
+    silk_float                      r_LPC[],                            /* O    LPC residual signal                         */
+    const silk_float                PredCoef[],                         /* I    LPC coefficients                            */
+    const silk_float                s[],                                /* I    Input signal                                */
+    const opus_int                  length,                             /* I    Length of input signal                      */
+    const opus_int                  Order                               /* I    LPC order                                   */
+) = {
+      silk_LPC_analysis_filter_FLP_c,    /* ARMv4 */
+      silk_LPC_analysis_filter_FLP_c,    /* EDSP */
+      silk_LPC_analysis_filter_FLP_c,    /* Media */
+      silk_LPC_analysis_filter_FLP_neon, /* Neon */
+      silk_LPC_analysis_filter_FLP_neon, /* dotprod */
+};
+
+# endif
+
 #endif /* OPUS_HAVE_RTCD */
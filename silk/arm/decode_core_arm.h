@@ -0,0 +1,95 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef SILK_DECODE_CORE_ARM_H
+# define SILK_DECODE_CORE_ARM_H
+
+# include "celt/arm/armcpu.h"
+
+# if defined(OPUS_ARM_MAY_HAVE_NEON_INTR)
+void silk_LTP_synthesis_neon(
+    opus_int32                  pres_Q14[],                     /* O    LPC excitation [ length ]                   */
+    opus_int32                  sLTP_Q15[],                     /* I/O  LTP state, new samples from sLTP_Q15[ 0 ]   */
+    const opus_int32            exc_Q14[],                      /* I    Excitation [ length ]                       */
+    const opus_int16            B_Q14[ LTP_ORDER ],             /* I    LTP coefficients                            */
+    const opus_int              lag,                            /* I    Pitch lag                                   */
+    const opus_int              length                          /* I    Subframe length                             */
+);
+
+void silk_LPC_synthesis_neon(
+    opus_int32                  sLPC_Q14[],                     /* I/O  State [ MAX_LPC_ORDER ], then output        */
+    const opus_int32            pres_Q14[],                     /* I    LPC excitation [ length ]                   */
+    const opus_int16            A_Q12[],                        /* I    Prediction coefficients [ order ]           */
+    const opus_int              order,                          /* I    Prediction order, 10 or 16                  */
+    const opus_int              length                          /* I    Signal length                               */
+);
+
+#  if !defined(OPUS_HAVE_RTCD) && defined(OPUS_ARM_PRESUME_NEON)
+#   define OVERRIDE_silk_LTP_synthesis (1)
+#   define silk_LTP_synthesis(pres_Q14, sLTP_Q15, exc_Q14, B_Q14, lag, length, arch) \
+    ((void)(arch), PRESUME_NEON(silk_LTP_synthesis)(pres_Q14, sLTP_Q15, exc_Q14, B_Q14, lag, length))
+#   define OVERRIDE_silk_LPC_synthesis (1)
+#   define silk_LPC_synthesis(sLPC_Q14, pres_Q14, A_Q12, order, length, arch) \
+    ((void)(arch), PRESUME_NEON(silk_LPC_synthesis)(sLPC_Q14, pres_Q14, A_Q12, order, length))
+#  endif
+# endif
+
+# if !defined(OVERRIDE_silk_LTP_synthesis)
+/*Is run-time CPU detection enabled on this platform?*/
+#  if defined(OPUS_HAVE_RTCD) && (defined(OPUS_ARM_MAY_HAVE_NEON_INTR) && !defined(OPUS_ARM_PRESUME_NEON_INTR))
+extern void (*const SILK_LTP_SYNTHESIS_IMPL[OPUS_ARCHMASK+1])(
+    opus_int32                  pres_Q14[],                     /* O    LPC excitation [ length ]                   */
+    opus_int32                  sLTP_Q15[],                     /* I/O  LTP state, new samples from sLTP_Q15[ 0 ]   */
+    const opus_int32            exc_Q14[],                      /* I    Excitation [ length ]                       */
+    const opus_int16            B_Q14[ LTP_ORDER ],             /* I    LTP coefficients                            */
+    const opus_int              lag,                            /* I    Pitch lag                                   */
+    const opus_int              length                          /* I    Subframe length                             */
+);
+extern void (*const SILK_LPC_SYNTHESIS_IMPL[OPUS_ARCHMASK+1])(
+    opus_int32                  sLPC_Q14[],                     /* I/O  State [ MAX_LPC_ORDER ], then output        */
+    const opus_int32            pres_Q14[],                     /* I    LPC excitation [ length ]                   */
+    const opus_int16            A_Q12[],                        /* I    Prediction coefficients [ order ]           */
+    const opus_int              order,                          /* I    Prediction order, 10 or 16                  */
+    const opus_int              length                          /* I    Signal length                               */
+);
+#   define OVERRIDE_silk_LTP_synthesis (1)
+#   define silk_LTP_synthesis(pres_Q14, sLTP_Q15, exc_Q14, B_Q14, lag, length, arch) \
+    ((*SILK_LTP_SYNTHESIS_IMPL[(arch)&OPUS_ARCHMASK])(pres_Q14, sLTP_Q15, exc_Q14, B_Q14, lag, length))
+#   define OVERRIDE_silk_LPC_synthesis (1)
+#   define silk_LPC_synthesis(sLPC_Q14, pres_Q14, A_Q12, order, length, arch) \
+    ((*SILK_LPC_SYNTHESIS_IMPL[(arch)&OPUS_ARCHMASK])(sLPC_Q14, pres_Q14, A_Q12, order, length))
+#  elif defined(OPUS_ARM_PRESUME_NEON_INTR)
+#   define OVERRIDE_silk_LTP_synthesis (1)
+#   define silk_LTP_synthesis(pres_Q14, sLTP_Q15, exc_Q14, B_Q14, lag, length, arch) \
+    ((void)(arch), silk_LTP_synthesis_neon(pres_Q14, sLTP_Q15, exc_Q14, B_Q14, lag, length))
+#   define OVERRIDE_silk_LPC_synthesis (1)
+#   define silk_LPC_synthesis(sLPC_Q14, pres_Q14, A_Q12, order, length, arch) \
+    ((void)(arch), silk_LPC_synthesis_neon(sLPC_Q14, pres_Q14, A_Q12, order, length))
+#  endif
+# endif
+
+#endif /* end SILK_DECODE_CORE_ARM_H */
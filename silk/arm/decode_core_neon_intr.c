@@ -0,0 +1,135 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <arm_neon.h>
+#include "main.h"
+
+/* With the coefficients shifted left by 15, vqdmulhq_s32() gives silk_SMULWB() exactly. */
+
+void silk_LTP_synthesis_neon(
+    opus_int32                  pres_Q14[],                     /* O    LPC excitation [ length ]                   */
+    opus_int32                  sLTP_Q15[],                     /* I/O  LTP state, new samples from sLTP_Q15[ 0 ]   */
+    const opus_int32            exc_Q14[],                      /* I    Excitation [ length ]                       */
+    const opus_int16            B_Q14[ LTP_ORDER ],             /* I    LTP coefficients                            */
+    const opus_int              lag,                            /* I    Pitch lag                                   */
+    const opus_int              length                          /* I    Subframe length                             */
+)
+{
+    opus_int   i, j;
+    opus_int32 LTP_pred_Q13;
+    const opus_int32 *pred_lag_ptr;
+    int32x4_t B_Q15[ LTP_ORDER ], pred, pres;
+
+    pred_lag_ptr = &sLTP_Q15[ -lag + LTP_ORDER / 2 ];
+    i = 0;
+    /* Four outputs at a time only read state written before them */
+    if( lag >= LTP_ORDER / 2 + 4 ) {
+        for( j = 0; j < LTP_ORDER; j++ ) {
+            B_Q15[ j ] = vdupq_n_s32( silk_LSHIFT32( (opus_int32)B_Q14[ j ], 15 ) );
+        }
+        for( ; i < length - 3; i += 4 ) {
+            /* Avoids introducing a bias because silk_SMLAWB() always rounds to -inf */
+            pred = vdupq_n_s32( 2 );
+            for( j = 0; j < LTP_ORDER; j++ ) {
+                pred = vaddq_s32( pred, vqdmulhq_s32( vld1q_s32( &pred_lag_ptr[ i - j ] ), B_Q15[ j ] ) );
+            }
+            pres = vaddq_s32( vld1q_s32( &exc_Q14[ i ] ), vshlq_n_s32( pred, 1 ) );
+            vst1q_s32( &pres_Q14[ i ], pres );
+            vst1q_s32( &sLTP_Q15[ i ], vshlq_n_s32( pres, 1 ) );
+        }
+    }
+    for( ; i < length; i++ ) {
+        LTP_pred_Q13 = 2;
+        for( j = 0; j < LTP_ORDER; j++ ) {
+            LTP_pred_Q13 = silk_SMLAWB( LTP_pred_Q13, pred_lag_ptr[ i - j ], B_Q14[ j ] );
+        }
+        pres_Q14[ i ] = silk_ADD_LSHIFT32( exc_Q14[ i ], LTP_pred_Q13, 1 );
+        sLTP_Q15[ i ] = silk_LSHIFT( pres_Q14[ i ], 1 );
+    }
+}
+
+void silk_LPC_synthesis_neon(
+    opus_int32                  sLPC_Q14[],                     /* I/O  State [ MAX_LPC_ORDER ], then output        */
+    const opus_int32            pres_Q14[],                     /* I    LPC excitation [ length ]                   */
+    const opus_int16            A_Q12[],                        /* I    Prediction coefficients [ order ]           */
+    const opus_int              order,                          /* I    Prediction order, 10 or 16                  */
+    const opus_int              length                          /* I    Signal length                               */
+)
+{
+    opus_int   i;
+    opus_int32 LPC_pred_Q10, out_Q14, prev_Q14;
+    opus_int32 A_rev[ 16 ];
+    int32x4_t  s0, s1, s2, s3, a0, a1, a2, a3, sum;
+    int32x2_t  sum2;
+
+    celt_assert( order == 10 || order == 16 );
+    silk_assert( MAX_LPC_ORDER == 16 );
+
+    /* The newest tap is done in scalar code, so the vector part only needs samples that   */
+    /* are one step old and stays off the critical path. Lane k holds the sample from     */
+    /* 17 - k steps back, and is multiplied by A_Q12[ 16 - k ]; lane 0 is unused.         */
+    silk_memset( A_rev, 0, sizeof( A_rev ) );
+    for( i = 1; i < order; i++ ) {
+        A_rev[ 16 - i ] = silk_LSHIFT32( (opus_int32)A_Q12[ i ], 15 );
+    }
+    a0 = vld1q_s32( &A_rev[ 0 ] );
+    a1 = vld1q_s32( &A_rev[ 4 ] );
+    a2 = vld1q_s32( &A_rev[ 8 ] );
+    a3 = vld1q_s32( &A_rev[ 12 ] );
+
+    s0 = vextq_s32( vdupq_n_s32( 0 ), vld1q_s32( &sLPC_Q14[ 0 ] ), 3 );
+    s1 = vld1q_s32( &sLPC_Q14[ 3 ] );
+    s2 = vld1q_s32( &sLPC_Q14[ 7 ] );
+    s3 = vld1q_s32( &sLPC_Q14[ 11 ] );
+
+    prev_Q14 = sLPC_Q14[ MAX_LPC_ORDER - 1 ];
+    for( i = 0; i < length; i++ ) {
+        sum  = vaddq_s32( vaddq_s32( vqdmulhq_s32( s0, a0 ), vqdmulhq_s32( s1, a1 ) ),
+                          vaddq_s32( vqdmulhq_s32( s2, a2 ), vqdmulhq_s32( s3, a3 ) ) );
+        sum2 = vadd_s32( vget_low_s32( sum ), vget_high_s32( sum ) );
+        sum2 = vpadd_s32( sum2, sum2 );
+
+        /* Shift in the previous output for the next sample */
+        s0 = vextq_s32( s0, s1, 1 );
+        s1 = vextq_s32( s1, s2, 1 );
+        s2 = vextq_s32( s2, s3, 1 );
+        s3 = vextq_s32( s3, vdupq_n_s32( prev_Q14 ), 1 );
+
+        /* Avoids introducing a bias because silk_SMLAWB() always rounds to -inf */
+        LPC_pred_Q10 = silk_RSHIFT( order, 1 ) + vget_lane_s32( sum2, 0 );
+        LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, prev_Q14, A_Q12[ 0 ] );
+
+        /* Add prediction to LPC excitation */
+        out_Q14 = silk_ADD_SAT32( pres_Q14[ i ], silk_LSHIFT_SAT32( LPC_pred_Q10, 4 ) );
+        sLPC_Q14[ MAX_LPC_ORDER + i ] = out_Q14;
+        prev_Q14 = out_Q14;
+    }
+}
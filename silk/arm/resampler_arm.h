@@ -0,0 +1,69 @@
+
+#ifndef SILK_RESAMPLER_ARM_H
+# define SILK_RESAMPLER_ARM_H
+
+# include "celt/arm/armcpu.h"
+
+# if defined(OPUS_ARM_MAY_HAVE_NEON_INTR)
+opus_int16 *silk_resampler_private_IIR_FIR_INTERPOL_neon(
+    opus_int16                      *out,           /* O    Output signal               */
+    opus_int16                      *buf,           /* I    Upsampled signal            */
+    opus_int32                      max_index_Q16,  /* I    End of the input, Q16       */
+    opus_int32                      index_increment_Q16 /* I    Input step, Q16     */
+);
+
+opus_int16 *silk_resampler_private_down_FIR_INTERPOL_neon(
+    opus_int16                      *out,           /* O    Output signal               */
+    opus_int32                      *buf,           /* I    Filtered signal, Q8         */
+    const opus_int16                *FIR_Coefs,     /* I    FIR coefficients, Q14       */
+    opus_int                        FIR_Order,      /* I    FIR order                   */
+    opus_int                        FIR_Fracs,      /* I    Number of FIR phases        */
+    opus_int32                      max_index_Q16,  /* I    End of the input, Q16       */
+    opus_int32                      index_increment_Q16 /* I    Input step, Q16     */
+);
+
+#  if !defined(OPUS_HAVE_RTCD) && defined(OPUS_ARM_PRESUME_NEON)
+#   define OVERRIDE_silk_resampler_private_IIR_FIR_INTERPOL (1)
+#   define silk_resampler_private_IIR_FIR_INTERPOL(out, buf, max_index_Q16, index_increment_Q16, arch) \
+    ((void)(arch), PRESUME_NEON(silk_resampler_private_IIR_FIR_INTERPOL)(out, buf, max_index_Q16, index_increment_Q16))
+#   define OVERRIDE_silk_resampler_private_down_FIR_INTERPOL (1)
+#   define silk_resampler_private_down_FIR_INTERPOL(out, buf, FIR_Coefs, FIR_Order, FIR_Fracs, max_index_Q16, index_increment_Q16, arch) \
+    ((void)(arch), PRESUME_NEON(silk_resampler_private_down_FIR_INTERPOL)(out, buf, FIR_Coefs, FIR_Order, FIR_Fracs, max_index_Q16, index_increment_Q16))
+#  endif
+# endif
+
+# if !defined(OVERRIDE_silk_resampler_private_IIR_FIR_INTERPOL)
+/*Is run-time CPU detection enabled on this platform?*/
+#  if defined(OPUS_HAVE_RTCD) && (defined(OPUS_ARM_MAY_HAVE_NEON_INTR) && !defined(OPUS_ARM_PRESUME_NEON_INTR))
+extern opus_int16 *(*const SILK_RESAMPLER_PRIVATE_IIR_FIR_INTERPOL_IMPL[OPUS_ARCHMASK+1])(
+    opus_int16                      *out,           /* O    Output signal               */
+    opus_int16                      *buf,           /* I    Upsampled signal            */
+    opus_int32                      max_index_Q16,  /* I    End of the input, Q16       */
+    opus_int32                      index_increment_Q16 /* I    Input step, Q16     */
+);
+extern opus_int16 *(*const SILK_RESAMPLER_PRIVATE_DOWN_FIR_INTERPOL_IMPL[OPUS_ARCHMASK+1])(
+    opus_int16                      *out,           /* O    Output signal               */
+    opus_int32                      *buf,           /* I    Filtered signal, Q8         */
+    const opus_int16                *FIR_Coefs,     /* I    FIR coefficients, Q14       */
+    opus_int                        FIR_Order,      /* I    FIR order                   */
+    opus_int                        FIR_Fracs,      /* I    Number of FIR phases        */
+    opus_int32                      max_index_Q16,  /* I    End of the input, Q16       */
+    opus_int32                      index_increment_Q16 /* I    Input step, Q16     */
+);
+#   define OVERRIDE_silk_resampler_private_IIR_FIR_INTERPOL (1)
+#   define silk_resampler_private_IIR_FIR_INTERPOL(out, buf, max_index_Q16, index_increment_Q16, arch) \
+    ((*SILK_RESAMPLER_PRIVATE_IIR_FIR_INTERPOL_IMPL[(arch)&OPUS_ARCHMASK])(out, buf, max_index_Q16, index_increment_Q16))
+#   define OVERRIDE_silk_resampler_private_down_FIR_INTERPOL (1)
+#   define silk_resampler_private_down_FIR_INTERPOL(out, buf, FIR_Coefs, FIR_Order, FIR_Fracs, max_index_Q16, index_increment_Q16, arch) \
+    ((*SILK_RESAMPLER_PRIVATE_DOWN_FIR_INTERPOL_IMPL[(arch)&OPUS_ARCHMASK])(out, buf, FIR_Coefs, FIR_Order, FIR_Fracs, max_index_Q16, index_increment_Q16))
+#  elif defined(OPUS_ARM_PRESUME_NEON_INTR)
+#   define OVERRIDE_silk_resampler_private_IIR_FIR_INTERPOL (1)
+#   define silk_resampler_private_IIR_FIR_INTERPOL(out, buf, max_index_Q16, index_increment_Q16, arch) \
+    ((void)(arch), silk_resampler_private_IIR_FIR_INTERPOL_neon(out, buf, max_index_Q16, index_increment_Q16))
+#   define OVERRIDE_silk_resampler_private_down_FIR_INTERPOL (1)
+#   define silk_resampler_private_down_FIR_INTERPOL(out, buf, FIR_Coefs, FIR_Order, FIR_Fracs, max_index_Q16, index_increment_Q16, arch) \
+    ((void)(arch), silk_resampler_private_down_FIR_INTERPOL_neon(out, buf, FIR_Coefs, FIR_Order, FIR_Fracs, max_index_Q16, index_increment_Q16))
+#  endif
+# endif
+
+#endif /* end SILK_RESAMPLER_ARM_H */
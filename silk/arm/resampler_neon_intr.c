@@ -0,0 +1,210 @@
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <arm_neon.h>
+#include "SigProc_FIX.h"
+#include "resampler_private.h"
+
+/* Sums each of the four vectors, returning the four sums in order */
+static OPUS_INLINE int32x4_t silk_resampler_hsum4_s32x4( const int32x4_t a0, const int32x4_t a1, const int32x4_t a2, const int32x4_t a3 )
+{
+    int32x4_t t0, t1;
+    t0 = vcombine_s32( vpadd_s32( vget_low_s32( a0 ), vget_high_s32( a0 ) ), vpadd_s32( vget_low_s32( a1 ), vget_high_s32( a1 ) ) );
+    t1 = vcombine_s32( vpadd_s32( vget_low_s32( a2 ), vget_high_s32( a2 ) ), vpadd_s32( vget_low_s32( a3 ), vget_high_s32( a3 ) ) );
+    return vcombine_s32( vpadd_s32( vget_low_s32( t0 ), vget_high_s32( t0 ) ), vpadd_s32( vget_low_s32( t1 ), vget_high_s32( t1 ) ) );
+}
+
+static OPUS_INLINE opus_int32 silk_resampler_hsum_s32x4( const int32x4_t a )
+{
+    int32x2_t t;
+    t = vadd_s32( vget_low_s32( a ), vget_high_s32( a ) );
+    return vget_lane_s32( vpadd_s32( t, t ), 0 );
+}
+
+/* silk_SMULWB() on four lanes; b holds sign-extended 16-bit values */
+static OPUS_INLINE int32x4_t silk_resampler_smulwb_s32x4( const int32x4_t a, const int32x4_t b )
+{
+    return vcombine_s32( vshrn_n_s64( vmull_s32( vget_low_s32( a ), vget_low_s32( b ) ), 16 ),
+                         vshrn_n_s64( vmull_s32( vget_high_s32( a ), vget_high_s32( b ) ), 16 ) );
+}
+
+/* Loads buf[ 0 ] to buf[ 3 ] in reverse order */
+static OPUS_INLINE int32x4_t silk_resampler_ld1r_s32x4( const opus_int32 *buf )
+{
+    int32x4_t t;
+    t = vrev64q_s32( vld1q_s32( buf ) );
+    return vcombine_s32( vget_high_s32( t ), vget_low_s32( t ) );
+}
+
+static OPUS_INLINE int32x4_t silk_resampler_IIR_FIR_tap8( const opus_int16 *buf_ptr, const int16x8_t coefs )
+{
+    int16x8_t x;
+    int32x4_t acc;
+    x   = vld1q_s16( buf_ptr );
+    acc = vmull_s16( vget_low_s16( x ), vget_low_s16( coefs ) );
+    return vmlal_s16( acc, vget_high_s16( x ), vget_high_s16( coefs ) );
+}
+
+opus_int16 *silk_resampler_private_IIR_FIR_INTERPOL_neon(
+    opus_int16                      *out,           /* O    Output signal               */
+    opus_int16                      *buf,           /* I    Upsampled signal            */
+    opus_int32                      max_index_Q16,  /* I    End of the input, Q16       */
+    opus_int32                      index_increment_Q16 /* I    Input step, Q16     */
+)
+{
+    opus_int32 index_Q16, res_Q15;
+    opus_int32 table_index;
+    opus_int   i;
+    int16x8_t  coefs[ 12 ];
+
+    /* All 8 taps of each phase: the first half of the phase followed by the
+       second half of the mirrored phase, reversed. */
+    for( i = 0; i < 12; i++ ) {
+        opus_int16 c[ 8 ];
+        c[ 0 ] = silk_resampler_frac_FIR_12[      i ][ 0 ];
+        c[ 1 ] = silk_resampler_frac_FIR_12[      i ][ 1 ];
+        c[ 2 ] = silk_resampler_frac_FIR_12[      i ][ 2 ];
+        c[ 3 ] = silk_resampler_frac_FIR_12[      i ][ 3 ];
+        c[ 4 ] = silk_resampler_frac_FIR_12[ 11 - i ][ 3 ];
+        c[ 5 ] = silk_resampler_frac_FIR_12[ 11 - i ][ 2 ];
+        c[ 6 ] = silk_resampler_frac_FIR_12[ 11 - i ][ 1 ];
+        c[ 7 ] = silk_resampler_frac_FIR_12[ 11 - i ][ 0 ];
+        coefs[ i ] = vld1q_s16( c );
+    }
+
+    /* Four output samples per iteration */
+    for( index_Q16 = 0; index_Q16 + 3 * index_increment_Q16 < max_index_Q16; index_Q16 += 4 * index_increment_Q16 ) {
+        int32x4_t acc[ 4 ];
+        opus_int32 idx;
+        for( i = 0; i < 4; i++ ) {
+            idx = index_Q16 + i * index_increment_Q16;
+            acc[ i ] = silk_resampler_IIR_FIR_tap8( &buf[ idx >> 16 ], coefs[ silk_SMULWB( idx & 0xFFFF, 12 ) ] );
+        }
+        /* vrshrq_n_s32() matches silk_RSHIFT_ROUND() and vqmovn_s32() saturates */
+        vst1_s16( out, vqmovn_s32( vrshrq_n_s32( silk_resampler_hsum4_s32x4( acc[ 0 ], acc[ 1 ], acc[ 2 ], acc[ 3 ] ), 15 ) ) );
+        out += 4;
+    }
+
+    for( ; index_Q16 < max_index_Q16; index_Q16 += index_increment_Q16 ) {
+        table_index = silk_SMULWB( index_Q16 & 0xFFFF, 12 );
+        res_Q15 = silk_resampler_hsum_s32x4( silk_resampler_IIR_FIR_tap8( &buf[ index_Q16 >> 16 ], coefs[ table_index ] ) );
+        *out++ = (opus_int16)silk_SAT16( silk_RSHIFT_ROUND( res_Q15, 15 ) );
+    }
+    return out;
+}
+
+opus_int16 *silk_resampler_private_down_FIR_INTERPOL_neon(
+    opus_int16                      *out,           /* O    Output signal               */
+    opus_int32                      *buf,           /* I    Filtered signal, Q8         */
+    const opus_int16                *FIR_Coefs,     /* I    FIR coefficients, Q14       */
+    opus_int                        FIR_Order,      /* I    FIR order                   */
+    opus_int                        FIR_Fracs,      /* I    Number of FIR phases        */
+    opus_int32                      max_index_Q16,  /* I    End of the input, Q16       */
+    opus_int32                      index_increment_Q16 /* I    Input step, Q16     */
+)
+{
+    opus_int32 index_Q16, res_Q6;
+    opus_int32 *buf_ptr;
+    opus_int32 interpol_ind;
+    const opus_int16 *interpol_ptr;
+    int32x4_t  acc;
+    opus_int   k;
+
+    switch( FIR_Order ) {
+        case RESAMPLER_DOWN_ORDER_FIR0:
+        {
+            /* Coefficients of each phase for taps 0-15, as 32-bit values */
+            int32x4_t coefs[ 3 ][ 4 ];
+            opus_int i;
+            celt_assert( FIR_Fracs <= 3 );
+            for( i = 0; i < FIR_Fracs; i++ ) {
+                opus_int32 c[ 16 ];
+                interpol_ptr = &FIR_Coefs[ RESAMPLER_DOWN_ORDER_FIR0 / 2 * i ];
+                for( k = 0; k < 9; k++ ) {
+                    c[ k ] = interpol_ptr[ k ];
+                }
+                interpol_ptr = &FIR_Coefs[ RESAMPLER_DOWN_ORDER_FIR0 / 2 * ( FIR_Fracs - 1 - i ) ];
+                for( k = 9; k < 16; k++ ) {
+                    c[ k ] = interpol_ptr[ 17 - k ];
+                }
+                for( k = 0; k < 4; k++ ) {
+                    coefs[ i ][ k ] = vld1q_s32( &c[ 4 * k ] );
+                }
+            }
+            for( index_Q16 = 0; index_Q16 < max_index_Q16; index_Q16 += index_increment_Q16 ) {
+                /* Integer part gives pointer to buffered input */
+                buf_ptr = buf + silk_RSHIFT( index_Q16, 16 );
+
+                /* Fractional part gives interpolation coefficients */
+                interpol_ind = silk_SMULWB( index_Q16 & 0xFFFF, FIR_Fracs );
+
+                /* Inner product */
+                acc = silk_resampler_smulwb_s32x4( vld1q_s32( &buf_ptr[ 0 ] ), coefs[ interpol_ind ][ 0 ] );
+                for( k = 1; k < 4; k++ ) {
+                    acc = vaddq_s32( acc, silk_resampler_smulwb_s32x4( vld1q_s32( &buf_ptr[ 4 * k ] ), coefs[ interpol_ind ][ k ] ) );
+                }
+                res_Q6 = silk_resampler_hsum_s32x4( acc );
+                interpol_ptr = &FIR_Coefs[ RESAMPLER_DOWN_ORDER_FIR0 / 2 * ( FIR_Fracs - 1 - interpol_ind ) ];
+                res_Q6 = silk_SMLAWB( res_Q6, buf_ptr[ 17 ], interpol_ptr[ 0 ] );
+                res_Q6 = silk_SMLAWB( res_Q6, buf_ptr[ 16 ], interpol_ptr[ 1 ] );
+
+                /* Scale down, saturate and store in output array */
+                *out++ = (opus_int16)silk_SAT16( silk_RSHIFT_ROUND( res_Q6, 6 ) );
+            }
+            break;
+        }
+        case RESAMPLER_DOWN_ORDER_FIR1:
+        {
+            int32x4_t coefs[ 3 ];
+            for( k = 0; k < 3; k++ ) {
+                coefs[ k ] = vmovl_s16( vld1_s16( &FIR_Coefs[ 4 * k ] ) );
+            }
+            for( index_Q16 = 0; index_Q16 < max_index_Q16; index_Q16 += index_increment_Q16 ) {
+                /* Integer part gives pointer to buffered input */
+                buf_ptr = buf + silk_RSHIFT( index_Q16, 16 );
+
+                /* Inner product of the symmetric filter */
+                acc = vdupq_n_s32( 0 );
+                for( k = 0; k < 3; k++ ) {
+                    acc = vaddq_s32( acc, silk_resampler_smulwb_s32x4(
+                        vaddq_s32( vld1q_s32( &buf_ptr[ 4 * k ] ), silk_resampler_ld1r_s32x4( &buf_ptr[ 20 - 4 * k ] ) ), coefs[ k ] ) );
+                }
+                res_Q6 = silk_resampler_hsum_s32x4( acc );
+
+                /* Scale down, saturate and store in output array */
+                *out++ = (opus_int16)silk_SAT16( silk_RSHIFT_ROUND( res_Q6, 6 ) );
+            }
+            break;
+        }
+        case RESAMPLER_DOWN_ORDER_FIR2:
+        {
+            int32x4_t coefs[ 4 ];
+            for( k = 0; k < 4; k++ ) {
+                coefs[ k ] = vmovl_s16( vld1_s16( &FIR_Coefs[ 4 * k ] ) );
+            }
+            for( index_Q16 = 0; index_Q16 < max_index_Q16; index_Q16 += index_increment_Q16 ) {
+                /* Integer part gives pointer to buffered input */
+                buf_ptr = buf + silk_RSHIFT( index_Q16, 16 );
+
+                /* Inner product of the symmetric filter */
+                acc = vdupq_n_s32( 0 );
+                for( k = 0; k < 4; k++ ) {
+                    acc = vaddq_s32( acc, silk_resampler_smulwb_s32x4(
+                        vaddq_s32( vld1q_s32( &buf_ptr[ 4 * k ] ), silk_resampler_ld1r_s32x4( &buf_ptr[ 32 - 4 * k ] ) ), coefs[ k ] ) );
+                }
+                res_Q6 = silk_resampler_hsum_s32x4( acc );
+                res_Q6 = silk_SMLAWB( res_Q6, silk_ADD32( buf_ptr[ 16 ], buf_ptr[ 19 ] ), FIR_Coefs[ 16 ] );
+                res_Q6 = silk_SMLAWB( res_Q6, silk_ADD32( buf_ptr[ 17 ], buf_ptr[ 18 ] ), FIR_Coefs[ 17 ] );
+
+                /* Scale down, saturate and store in output array */
+                *out++ = (opus_int16)silk_SAT16( silk_RSHIFT_ROUND( res_Q6, 6 ) );
+            }
+            break;
+        }
+        default:
+            celt_assert( 0 );
+    }
+    return out;
+}
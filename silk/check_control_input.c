@@ -85,6 +85,10 @@ opus_int check_control_input(
         celt_assert( 0 );
         return SILK_ENC_INVALID_INBAND_FEC_SETTING;
     }
+    if( encControl->pitchTracking < 0 || encControl->pitchTracking > 1 ) {
+        celt_assert( 0 );
+        return SILK_ENC_INVALID_PITCH_TRACKING_SETTING;
+    }
     if( encControl->nChannelsAPI < 1 || encControl->nChannelsAPI > ENCODER_NUM_CHANNELS ) {
         celt_assert( 0 );
         return SILK_ENC_INVALID_NUMBER_OF_CHANNELS_ERROR;
@@ -101,6 +101,9 @@ typedef struct {
     /* I: Make frames as independent as possible (but still use LPC)                        */
     opus_int reducedDependency;
 
+    /* I:   Flag to search around the previous pitch lag first in voiced speech; 0/1        */
+    opus_int pitchTracking;
+
     /* O:   Internal sampling rate used, in Hertz; 8000/12000/16000                         */
     opus_int32 internalSampleRate;
 
@@ -121,6 +124,9 @@ typedef struct {
 
     /* O: SILK offset (dithering) */
     opus_int offset;
+
+    /* O:   Number of quantization passes the rate control used for the frames of the last call */
+    opus_int nRatePasses;
 } silk_EncControlStruct;
 
 /**************************************************************************/
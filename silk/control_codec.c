@@ -79,6 +79,7 @@ opus_int silk_control_encoder(
     psEnc->sCmn.minInternal_fs_Hz      = encControl->minInternalSampleRate;
     psEnc->sCmn.desiredInternal_fs_Hz  = encControl->desiredInternalSampleRate;
     psEnc->sCmn.useInBandFEC           = encControl->useInBandFEC;
+    psEnc->sCmn.pitchTracking          = encControl->pitchTracking;
     psEnc->sCmn.nChannelsAPI           = encControl->nChannelsAPI;
     psEnc->sCmn.nChannelsInternal      = encControl->nChannelsInternal;
     psEnc->sCmn.allow_bandwidth_switch = allow_bw_switch;
@@ -176,13 +177,13 @@ static opus_int silk_setup_resamplers(
 
             /* Temporary resampling of x_buf data to API_fs_Hz */
             ALLOC( x_buf_API_fs_Hz, api_buf_samples, opus_int16 );
-            ret += silk_resampler( temp_resampler_state, x_buf_API_fs_Hz, x_bufFIX, old_buf_samples );
+            ret += silk_resampler( temp_resampler_state, x_buf_API_fs_Hz, x_bufFIX, old_buf_samples, psEnc->sCmn.arch );
 
             /* Initialize the resampler for enc_API.c preparing resampling from API_fs_Hz to fs_kHz */
             ret += silk_resampler_init( &psEnc->sCmn.resampler_state, psEnc->sCmn.API_fs_Hz, silk_SMULBB( fs_kHz, 1000 ), 1 );
 
             /* Correct resampler state by resampling buffered data from API_fs_Hz to fs_kHz */
-            ret += silk_resampler( &psEnc->sCmn.resampler_state, x_bufFIX, x_buf_API_fs_Hz, api_buf_samples );
+            ret += silk_resampler( &psEnc->sCmn.resampler_state, x_bufFIX, x_buf_API_fs_Hz, api_buf_samples, psEnc->sCmn.arch );
 
 #ifndef FIXED_POINT
             silk_short2float_array( psEnc->x_buf, x_bufFIX, new_buf_samples);
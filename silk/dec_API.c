@@ -36,6 +36,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #ifdef ENABLE_OSCE
 #include "osce.h"
 #include "osce_structs.h"
+#include "dnn_model.h"
 #endif
 
 /************************/
@@ -49,6 +50,8 @@ typedef struct {
     opus_int                         prev_decode_only_middle;
 #ifdef ENABLE_OSCE
     OSCEModel                        osce_model;
+    /* Tables of an attached OpusDNNModel, used instead of osce_model when set. */
+    const OSCEModel                  *shared_osce_model;
 #endif
 } silk_decoder;
 
@@ -65,6 +68,9 @@ opus_int silk_LoadOSCEModels(void *decState, const unsigned char *data, int len)
 
     ret = osce_load_models(&((silk_decoder *)decState)->osce_model, data, len);
     ((silk_decoder *)decState)->osce_model.loaded = (ret == 0);
+    if (ret == 0) {
+        ((silk_decoder *)decState)->shared_osce_model = NULL;
+    }
     return ret;
 #else
     (void) decState;
@@ -74,6 +80,31 @@ opus_int silk_LoadOSCEModels(void *decState, const unsigned char *data, int len)
 #endif
 }
 
+opus_int silk_SetOSCEModels(void *decState, const struct OpusDNNModel *model)
+{
+#ifdef ENABLE_OSCE
+    silk_decoder *psDec = (silk_decoder *)decState;
+    if (model == NULL) {
+        psDec->shared_osce_model = NULL;
+        psDec->osce_model.loaded = 0;
+#ifndef USE_WEIGHTS_FILE
+        return silk_LoadOSCEModels(decState, NULL, 0);
+#else
+        return SILK_NO_ERROR;
+#endif
+    }
+    if (!model->osce.loaded) {
+        return -1;
+    }
+    psDec->shared_osce_model = &model->osce;
+    return SILK_NO_ERROR;
+#else
+    (void) decState;
+    (void) model;
+    return SILK_NO_ERROR;
+#endif
+}
+
 opus_int silk_Get_Decoder_Size(                         /* O    Returns error code                              */
     opus_int                        *decSizeBytes       /* O    Number of bytes in SILK decoder state           */
 )
@@ -112,6 +143,7 @@ opus_int silk_InitDecoder(                              /* O    Returns error co
     silk_decoder_state *channel_state = ((silk_decoder *)decState)->channel_state;
 #ifdef ENABLE_OSCE
     ((silk_decoder *)decState)->osce_model.loaded = 0;
+    ((silk_decoder *)decState)->shared_osce_model = NULL;
 #endif
 #ifndef USE_WEIGHTS_FILE
     /* load osce models */
@@ -362,7 +394,7 @@ opus_int silk_Decode(                                   /* O    Returns error co
                 n == 0 ? lpcnet : NULL,
 #endif
 #ifdef ENABLE_OSCE
-                &psDec->osce_model,
+                psDec->shared_osce_model ? psDec->shared_osce_model : &psDec->osce_model,
 #endif
                 arch);
         } else {
@@ -404,7 +436,7 @@ opus_int silk_Decode(                                   /* O    Returns error co
     for( n = 0; n < silk_min( decControl->nChannelsAPI, decControl->nChannelsInternal ); n++ ) {
 
         /* Resample decoded signal to API_sampleRate */
-        ret += silk_resampler( &channel_state[ n ].resampler_state, resample_out_ptr, &samplesOut1_tmp[ n ][ 1 ], nSamplesOutDec );
+        ret += silk_resampler( &channel_state[ n ].resampler_state, resample_out_ptr, &samplesOut1_tmp[ n ][ 1 ], nSamplesOutDec, arch );
 
         /* Interleave if stereo output and stereo stream */
         if( decControl->nChannelsAPI == 2 ) {
@@ -419,7 +451,7 @@ opus_int silk_Decode(                                   /* O    Returns error co
         if ( stereo_to_mono ){
             /* Resample right channel for newly collapsed stereo just in case
                we weren't doing collapsing when switching to mono */
-            ret += silk_resampler( &channel_state[ 1 ].resampler_state, resample_out_ptr, &samplesOut1_tmp[ 0 ][ 1 ], nSamplesOutDec );
+            ret += silk_resampler( &channel_state[ 1 ].resampler_state, resample_out_ptr, &samplesOut1_tmp[ 0 ][ 1 ], nSamplesOutDec, arch );
 
             for( i = 0; i < *nSamplesOut; i++ ) {
                 samplesOut[ 1 + 2 * i ] = resample_out_ptr[ i ];
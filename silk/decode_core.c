@@ -32,6 +32,83 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "main.h"
 #include "stack_alloc.h"
 
+void silk_LTP_synthesis_c(
+    opus_int32                  pres_Q14[],                     /* O    LPC excitation [ length ]                   */
+    opus_int32                  sLTP_Q15[],                     /* I/O  LTP state, new samples from sLTP_Q15[ 0 ]   */
+    const opus_int32            exc_Q14[],                      /* I    Excitation [ length ]                       */
+    const opus_int16            B_Q14[ LTP_ORDER ],             /* I    LTP coefficients                            */
+    const opus_int              lag,                            /* I    Pitch lag                                   */
+    const opus_int              length                          /* I    Subframe length                             */
+)
+{
+    opus_int   i;
+    opus_int32 LTP_pred_Q13;
+    const opus_int32 *pred_lag_ptr;
+
+    pred_lag_ptr = &sLTP_Q15[ -lag + LTP_ORDER / 2 ];
+    for( i = 0; i < length; i++ ) {
+        /* Unrolled loop */
+        /* Avoids introducing a bias because silk_SMLAWB() always rounds to -inf */
+        LTP_pred_Q13 = 2;
+        LTP_pred_Q13 = silk_SMLAWB( LTP_pred_Q13, pred_lag_ptr[  0 ], B_Q14[ 0 ] );
+        LTP_pred_Q13 = silk_SMLAWB( LTP_pred_Q13, pred_lag_ptr[ -1 ], B_Q14[ 1 ] );
+        LTP_pred_Q13 = silk_SMLAWB( LTP_pred_Q13, pred_lag_ptr[ -2 ], B_Q14[ 2 ] );
+        LTP_pred_Q13 = silk_SMLAWB( LTP_pred_Q13, pred_lag_ptr[ -3 ], B_Q14[ 3 ] );
+        LTP_pred_Q13 = silk_SMLAWB( LTP_pred_Q13, pred_lag_ptr[ -4 ], B_Q14[ 4 ] );
+        pred_lag_ptr++;
+
+        /* Generate LPC excitation */
+        pres_Q14[ i ] = silk_ADD_LSHIFT32( exc_Q14[ i ], LTP_pred_Q13, 1 );
+
+        /* Update states */
+        sLTP_Q15[ i ] = silk_LSHIFT( pres_Q14[ i ], 1 );
+    }
+}
+
+void silk_LPC_synthesis_c(
+    opus_int32                  sLPC_Q14[],                     /* I/O  State [ MAX_LPC_ORDER ], then output        */
+    const opus_int32            pres_Q14[],                     /* I    LPC excitation [ length ]                   */
+    const opus_int16            A_Q12[],                        /* I    Prediction coefficients [ order ]           */
+    const opus_int              order,                          /* I    Prediction order, 10 or 16                  */
+    const opus_int              length                          /* I    Signal length                               */
+)
+{
+    opus_int   i;
+    opus_int32 LPC_pred_Q10;
+    opus_int16 A_Q12_tmp[ MAX_LPC_ORDER ];
+
+    celt_assert( order == 10 || order == 16 );
+
+    /* Preload LPC coeficients to array on stack. Gives small performance gain */
+    silk_memcpy( A_Q12_tmp, A_Q12, order * sizeof( opus_int16 ) );
+
+    for( i = 0; i < length; i++ ) {
+        /* Avoids introducing a bias because silk_SMLAWB() always rounds to -inf */
+        LPC_pred_Q10 = silk_RSHIFT( order, 1 );
+        LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i -  1 ], A_Q12_tmp[ 0 ] );
+        LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i -  2 ], A_Q12_tmp[ 1 ] );
+        LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i -  3 ], A_Q12_tmp[ 2 ] );
+        LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i -  4 ], A_Q12_tmp[ 3 ] );
+        LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i -  5 ], A_Q12_tmp[ 4 ] );
+        LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i -  6 ], A_Q12_tmp[ 5 ] );
+        LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i -  7 ], A_Q12_tmp[ 6 ] );
+        LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i -  8 ], A_Q12_tmp[ 7 ] );
+        LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i -  9 ], A_Q12_tmp[ 8 ] );
+        LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i - 10 ], A_Q12_tmp[ 9 ] );
+        if( order == 16 ) {
+            LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i - 11 ], A_Q12_tmp[ 10 ] );
+            LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i - 12 ], A_Q12_tmp[ 11 ] );
+            LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i - 13 ], A_Q12_tmp[ 12 ] );
+            LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i - 14 ], A_Q12_tmp[ 13 ] );
+            LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i - 15 ], A_Q12_tmp[ 14 ] );
+            LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i - 16 ], A_Q12_tmp[ 15 ] );
+        }
+
+        /* Add prediction to LPC excitation */
+        sLPC_Q14[ MAX_LPC_ORDER + i ] = silk_ADD_SAT32( pres_Q14[ i ], silk_LSHIFT_SAT32( LPC_pred_Q10, 4 ) );
+    }
+}
+
 /**********************************************************/
 /* Core decoder. Performs inverse NSQ operation LTP + LPC */
 /**********************************************************/
@@ -44,11 +121,11 @@ void silk_decode_core(
 )
 {
     opus_int   i, k, lag = 0, start_idx, sLTP_buf_idx, NLSF_interpolation_flag, signalType;
-    opus_int16 *A_Q12, *B_Q14, *pxq, A_Q12_tmp[ MAX_LPC_ORDER ];
+    opus_int16 *A_Q12, *B_Q14, *pxq;
     VARDECL( opus_int16, sLTP );
     VARDECL( opus_int32, sLTP_Q15 );
-    opus_int32 LTP_pred_Q13, LPC_pred_Q10, Gain_Q10, inv_gain_Q31, gain_adj_Q16, rand_seed, offset_Q10;
-    opus_int32 *pred_lag_ptr, *pexc_Q14, *pres_Q14;
+    opus_int32 Gain_Q10, inv_gain_Q31, gain_adj_Q16, rand_seed, offset_Q10;
+    opus_int32 *pexc_Q14, *pres_Q14;
     VARDECL( opus_int32, res_Q14 );
     VARDECL( opus_int32, sLPC_Q14 );
     SAVE_STACK;
@@ -98,8 +175,6 @@ void silk_decode_core(
         pres_Q14 = res_Q14;
         A_Q12 = psDecCtrl->PredCoef_Q12[ k >> 1 ];
 
-        /* Preload LPC coeficients to array on stack. Gives small performance gain */
-        silk_memcpy( A_Q12_tmp, A_Q12, psDec->LPC_order * sizeof( opus_int16 ) );
         B_Q14        = &psDecCtrl->LTPCoef_Q14[ k * LTP_ORDER ];
         signalType   = psDec->indices.signalType;
 
@@ -170,57 +245,16 @@ void silk_decode_core(
 
         /* Long-term prediction */
         if( signalType == TYPE_VOICED ) {
-            /* Set up pointer */
-            pred_lag_ptr = &sLTP_Q15[ sLTP_buf_idx - lag + LTP_ORDER / 2 ];
-            for( i = 0; i < psDec->subfr_length; i++ ) {
-                /* Unrolled loop */
-                /* Avoids introducing a bias because silk_SMLAWB() always rounds to -inf */
-                LTP_pred_Q13 = 2;
-                LTP_pred_Q13 = silk_SMLAWB( LTP_pred_Q13, pred_lag_ptr[  0 ], B_Q14[ 0 ] );
-                LTP_pred_Q13 = silk_SMLAWB( LTP_pred_Q13, pred_lag_ptr[ -1 ], B_Q14[ 1 ] );
-                LTP_pred_Q13 = silk_SMLAWB( LTP_pred_Q13, pred_lag_ptr[ -2 ], B_Q14[ 2 ] );
-                LTP_pred_Q13 = silk_SMLAWB( LTP_pred_Q13, pred_lag_ptr[ -3 ], B_Q14[ 3 ] );
-                LTP_pred_Q13 = silk_SMLAWB( LTP_pred_Q13, pred_lag_ptr[ -4 ], B_Q14[ 4 ] );
-                pred_lag_ptr++;
-
-                /* Generate LPC excitation */
-                pres_Q14[ i ] = silk_ADD_LSHIFT32( pexc_Q14[ i ], LTP_pred_Q13, 1 );
-
-                /* Update states */
-                sLTP_Q15[ sLTP_buf_idx ] = silk_LSHIFT( pres_Q14[ i ], 1 );
-                sLTP_buf_idx++;
-            }
+            silk_LTP_synthesis( pres_Q14, &sLTP_Q15[ sLTP_buf_idx ], pexc_Q14, B_Q14, lag, psDec->subfr_length, arch );
+            sLTP_buf_idx += psDec->subfr_length;
         } else {
             pres_Q14 = pexc_Q14;
         }
 
-        for( i = 0; i < psDec->subfr_length; i++ ) {
-            /* Short-term prediction */
-            celt_assert( psDec->LPC_order == 10 || psDec->LPC_order == 16 );
-            /* Avoids introducing a bias because silk_SMLAWB() always rounds to -inf */
-            LPC_pred_Q10 = silk_RSHIFT( psDec->LPC_order, 1 );
-            LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i -  1 ], A_Q12_tmp[ 0 ] );
-            LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i -  2 ], A_Q12_tmp[ 1 ] );
-            LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i -  3 ], A_Q12_tmp[ 2 ] );
-            LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i -  4 ], A_Q12_tmp[ 3 ] );
-            LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i -  5 ], A_Q12_tmp[ 4 ] );
-            LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i -  6 ], A_Q12_tmp[ 5 ] );
-            LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i -  7 ], A_Q12_tmp[ 6 ] );
-            LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i -  8 ], A_Q12_tmp[ 7 ] );
-            LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i -  9 ], A_Q12_tmp[ 8 ] );
-            LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i - 10 ], A_Q12_tmp[ 9 ] );
-            if( psDec->LPC_order == 16 ) {
-                LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i - 11 ], A_Q12_tmp[ 10 ] );
-                LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i - 12 ], A_Q12_tmp[ 11 ] );
-                LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i - 13 ], A_Q12_tmp[ 12 ] );
-                LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i - 14 ], A_Q12_tmp[ 13 ] );
-                LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i - 15 ], A_Q12_tmp[ 14 ] );
-                LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, sLPC_Q14[ MAX_LPC_ORDER + i - 16 ], A_Q12_tmp[ 15 ] );
-            }
-
-            /* Add prediction to LPC excitation */
-            sLPC_Q14[ MAX_LPC_ORDER + i ] = silk_ADD_SAT32( pres_Q14[ i ], silk_LSHIFT_SAT32( LPC_pred_Q10, 4 ) );
+        /* Short-term prediction */
+        silk_LPC_synthesis( sLPC_Q14, pres_Q14, A_Q12, psDec->LPC_order, psDec->subfr_length, arch );
 
+        for( i = 0; i < psDec->subfr_length; i++ ) {
             /* Scale with gain */
             pxq[ i ] = (opus_int16)silk_SAT16( silk_RSHIFT_ROUND( silk_SMULWW( sLPC_Q14[ MAX_LPC_ORDER + i ], Gain_Q10 ), 8 ) );
         }
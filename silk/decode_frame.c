@@ -51,7 +51,7 @@ opus_int silk_decode_frame(
     LPCNetPLCState              *lpcnet,
 #endif
 #ifdef ENABLE_OSCE
-    OSCEModel                   *osce_model,
+    const OSCEModel             *osce_model,
 #endif
     int                         arch                            /* I    Run-time architecture                       */
 )
@@ -30,6 +30,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 #include "main.h"
+#include "profile.h"
 
 /* Decode side-information parameters from payload */
 void silk_decode_indices(
@@ -45,6 +46,7 @@ void silk_decode_indices(
     opus_int16 ec_ix[ MAX_LPC_ORDER ];
     opus_uint8 pred_Q8[ MAX_LPC_ORDER ];
 
+    OPUS_PROFILE_ENTER( OPUS_PROFILE_ENTROPY );
     /*******************************************/
     /* Decode signal type and quantizer offset */
     /*******************************************/
@@ -148,4 +150,5 @@ void silk_decode_indices(
     /* Decode seed */
     /***************/
     psDec->indices.Seed = (opus_int8)ec_dec_icdf( psRangeDec, silk_uniform4_iCDF, 8 );
+    OPUS_PROFILE_LEAVE( OPUS_PROFILE_ENTROPY );
 }
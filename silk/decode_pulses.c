@@ -30,6 +30,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 #include "main.h"
+#include "profile.h"
 
 /*********************************************/
 /* Decode quantization indices of excitation */
@@ -47,6 +48,7 @@ void silk_decode_pulses(
     opus_int16 *pulses_ptr;
     const opus_uint8 *cdf_ptr;
 
+    OPUS_PROFILE_ENTER( OPUS_PROFILE_ENTROPY );
     /*********************/
     /* Decode rate level */
     /*********************/
@@ -112,4 +114,5 @@ void silk_decode_pulses(
     /* Decode and add signs to pulse signal */
     /****************************************/
     silk_decode_signs( psRangeDec, pulses, frame_length, signalType, quantOffsetType, sum_pulses );
+    OPUS_PROFILE_LEAVE( OPUS_PROFILE_ENTROPY );
 }
@@ -30,6 +30,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 #include "main.h"
+#include "profile.h"
 
 /* Encode side-information parameters to payload */
 void silk_encode_indices(
@@ -46,6 +47,7 @@ void silk_encode_indices(
     opus_uint8 pred_Q8[ MAX_LPC_ORDER ];
     const SideInfoIndices *psIndices;
 
+    OPUS_PROFILE_ENTER( OPUS_PROFILE_ENTROPY );
     if( encode_LBRR ) {
          psIndices = &psEncC->indices_LBRR[ FrameIndex ];
     } else {
@@ -178,4 +180,5 @@ void silk_encode_indices(
     /***************/
     silk_assert( psIndices->Seed >= 0 && psIndices->Seed < 4 );
     ec_enc_icdf( psRangeEnc, psIndices->Seed, silk_uniform4_iCDF, 8 );
+    OPUS_PROFILE_LEAVE( OPUS_PROFILE_ENTROPY );
 }
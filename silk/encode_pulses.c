@@ -31,6 +31,7 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #include "main.h"
 #include "stack_alloc.h"
+#include "profile.h"
 
 /*********************************************/
 /* Encode quantization indices of excitation */
@@ -76,6 +77,7 @@ void silk_encode_pulses(
     const opus_uint8 *cdf_ptr;
     const opus_uint8 *nBits_ptr;
     SAVE_STACK;
+    OPUS_PROFILE_ENTER( OPUS_PROFILE_ENTROPY );
 
     silk_memset( pulses_comb, 0, 8 * sizeof( opus_int ) ); /* Fixing Valgrind reported problem*/
 
@@ -202,5 +204,6 @@ void silk_encode_pulses(
     /* Encode signs */
     /****************/
     silk_encode_signs( psRangeEnc, pulses, frame_length, signalType, quantOffsetType, sum_pulses );
+    OPUS_PROFILE_LEAVE( OPUS_PROFILE_ENTROPY );
     RESTORE_STACK;
 }
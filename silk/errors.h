@@ -75,6 +75,9 @@ extern "C"
 /* Internal encoder error */
 #define SILK_ENC_INVALID_NUMBER_OF_CHANNELS_ERROR   -111
 
+/* Pitch tracking setting not valid, use 0 or 1 */
+#define SILK_ENC_INVALID_PITCH_TRACKING_SETTING     -112
+
 /**************************/
 /* Decoder error messages */
 /**************************/
@@ -33,6 +33,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "main_FIX.h"
 #include "stack_alloc.h"
 #include "tuning_parameters.h"
+#include "profile.h"
 
 /* Low Bitrate Redundancy (LBRR) encoding. Reuse all parameters but encode with lower bitrate           */
 static OPUS_INLINE void silk_LBRR_encode_FIX(
@@ -98,6 +99,8 @@ opus_int silk_encode_frame_FIX(
     silk_nsq_state sNSQ_copy, sNSQ_copy2;
     opus_int32   seed_copy, nBits, nBits_lower, nBits_upper, gainMult_lower, gainMult_upper;
     opus_int32   gainsID, gainsID_lower, gainsID_upper;
+    opus_int32   pulseBits, gainMult_pred, gainMult_prev, nBits_prev;
+    opus_int     predict;
     opus_int16   gainMult_Q8;
     opus_int16   ec_prevLagIndex_copy;
     opus_int     ec_prevSignalType_copy;
@@ -111,9 +114,10 @@ opus_int silk_encode_frame_FIX(
     /* For CBR, 5 bits below budget is close enough. For VBR, allow up to 25% below the cap if we initially busted the budget. */
     bits_margin = useCBR ? 5 : maxBits/4;
     /* This is totally unnecessary but many compilers (including gcc) are too dumb to realise it */
-    LastGainIndex_copy2 = nBits_lower = nBits_upper = gainMult_lower = gainMult_upper = 0;
+    LastGainIndex_copy2 = nBits_lower = nBits_upper = gainMult_lower = gainMult_upper = pulseBits = 0;
 
     psEnc->sCmn.indices.Seed = psEnc->sCmn.frameCounter++ & 3;
+    psEnc->sCmn.nRatePasses = 0;
 
     /**************************************************************/
     /* Set up Input Pointers, and insert frame in input buffer   */
@@ -145,7 +149,9 @@ opus_int silk_encode_frame_FIX(
         /*****************************************/
         /* Find pitch lags, initial LPC analysis */
         /*****************************************/
+        OPUS_PROFILE_ENTER( OPUS_PROFILE_PITCH );
         silk_find_pitch_lags_FIX( psEnc, &sEncCtrl, res_pitch, x_frame - psEnc->sCmn.ltp_mem_length, psEnc->sCmn.arch );
+        OPUS_PROFILE_LEAVE( OPUS_PROFILE_PITCH );
 
         /************************/
         /* Noise shape analysis */
@@ -172,6 +178,8 @@ opus_int silk_encode_frame_FIX(
         gainMult_Q8 = SILK_FIX_CONST( 1, 8 );
         found_lower = 0;
         found_upper = 0;
+        gainMult_prev = 0;
+        nBits_prev = 0;
         gainsID = silk_gains_ID( psEnc->sCmn.indices.GainsIndices, psEnc->sCmn.nb_subfr );
         gainsID_lower = -1;
         gainsID_upper = -1;
@@ -183,6 +191,7 @@ opus_int silk_encode_frame_FIX(
         ec_prevSignalType_copy = psEnc->sCmn.ec_prevSignalType;
         ALLOC( ec_buf_copy, 1275, opus_uint8 );
         for( iter = 0; ; iter++ ) {
+            predict = 0;
             if( gainsID == gainsID_lower ) {
                 nBits = nBits_lower;
             } else if( gainsID == gainsID_upper ) {
@@ -200,6 +209,7 @@ opus_int silk_encode_frame_FIX(
                 /*****************************************/
                 /* Noise shaping quantization            */
                 /*****************************************/
+                OPUS_PROFILE_ENTER( OPUS_PROFILE_SILK_NSQ );
                 if( psEnc->sCmn.nStatesDelayedDecision > 1 || psEnc->sCmn.warping_Q16 > 0 ) {
                     silk_NSQ_del_dec( &psEnc->sCmn, &psEnc->sCmn.sNSQ, &psEnc->sCmn.indices, x_frame, psEnc->sCmn.pulses,
                            sEncCtrl.PredCoef_Q12[ 0 ], sEncCtrl.LTPCoef_Q14, sEncCtrl.AR_Q13, sEncCtrl.HarmShapeGain_Q14,
@@ -211,6 +221,9 @@ opus_int silk_encode_frame_FIX(
                             sEncCtrl.Tilt_Q14, sEncCtrl.LF_shp_Q14, sEncCtrl.Gains_Q16, sEncCtrl.pitchL, sEncCtrl.Lambda_Q10, sEncCtrl.LTP_scale_Q14,
                             psEnc->sCmn.arch);
                 }
+                OPUS_PROFILE_LEAVE( OPUS_PROFILE_SILK_NSQ );
+
+                psEnc->sCmn.nRatePasses++;
 
                 if ( iter == maxIter && !found_lower ) {
                     silk_memcpy( &sRangeEnc_copy2, psRangeEnc, sizeof( ec_enc ) );
@@ -224,10 +237,14 @@ opus_int silk_encode_frame_FIX(
                 /****************************************/
                 /* Encode Excitation Signal             */
                 /****************************************/
+                pulseBits = ec_tell( psRangeEnc );
                 silk_encode_pulses( psRangeEnc, psEnc->sCmn.indices.signalType, psEnc->sCmn.indices.quantOffsetType,
                     psEnc->sCmn.pulses, psEnc->sCmn.frame_length );
 
                 nBits = ec_tell( psRangeEnc );
+                pulseBits = nBits - pulseBits;
+                /* The pulses are those of the current gains, so they can predict the next ones */
+                predict = 1;
 
                 /* If we still bust after the last iteration, do some damage control. */
                 if ( iter == maxIter && !found_lower && nBits > maxBits ) {
@@ -303,7 +320,8 @@ opus_int silk_encode_frame_FIX(
                 break;
             }
 
-            if ( !found_lower && nBits > maxBits ) {
+            /* Only fresh pulses tell whether the current gains lowered the sums */
+            if ( !found_lower && nBits > maxBits && predict ) {
                 int j;
                 for ( i = 0; i < psEnc->sCmn.nb_subfr; i++ ) {
                     int sum=0;
@@ -319,22 +337,42 @@ opus_int silk_encode_frame_FIX(
                 }
             }
             if( ( found_lower & found_upper ) == 0 ) {
-                /* Adjust gain according to high-rate rate/distortion curve */
+                /* Predict the gain from the pulses just coded, aiming for the middle of the accepted range */
+                gainMult_pred = 0;
+                if( predict ) {
+                    gainMult_pred = silk_predict_gain_mult( psEnc->sCmn.pulses, psEnc->sCmn.frame_length, gainMult_Q8,
+                        nBits, pulseBits, maxBits - silk_RSHIFT( bits_margin, 1 ), gainMult_prev, nBits_prev );
+                    gainMult_prev = gainMult_Q8;
+                    nBits_prev = nBits;
+                }
                 if( nBits > maxBits ) {
-                    gainMult_Q8 = silk_min_32( 1024, gainMult_Q8*3/2 );
+                    if( gainMult_pred > gainMult_Q8 ) {
+                        gainMult_Q8 = gainMult_pred;
+                    } else {
+                        /* Adjust gain according to high-rate rate/distortion curve */
+                        gainMult_Q8 = silk_min_32( 1024, gainMult_Q8*3/2 );
+                    }
                 } else {
-                    gainMult_Q8 = silk_max_32( 64, gainMult_Q8*4/5 );
+                    if( gainMult_pred > 0 && gainMult_pred < gainMult_Q8 ) {
+                        gainMult_Q8 = gainMult_pred;
+                    } else {
+                        gainMult_Q8 = silk_max_32( 64, gainMult_Q8*4/5 );
+                    }
                 }
             } else {
-                /* Adjust gain by interpolating */
-                gainMult_Q8 = gainMult_lower + silk_DIV32_16( silk_MUL( gainMult_upper - gainMult_lower, maxBits - nBits_lower ), nBits_upper - nBits_lower );
-                /* New gain multplier must be between 25% and 75% of old range (note that gainMult_upper < gainMult_lower) */
-                if( gainMult_Q8 > silk_ADD_RSHIFT32( gainMult_lower, gainMult_upper - gainMult_lower, 2 ) ) {
-                    gainMult_Q8 = silk_ADD_RSHIFT32( gainMult_lower, gainMult_upper - gainMult_lower, 2 );
+                /* Adjust gain by interpolating the log gain, aiming for the middle of the accepted range */
+                opus_int32 log_lower_Q7, log_upper_Q7, log_Q7;
+                log_lower_Q7 = silk_lin2log( gainMult_lower );
+                log_upper_Q7 = silk_lin2log( gainMult_upper );
+                log_Q7 = log_lower_Q7 + silk_DIV32_16( silk_MUL( log_upper_Q7 - log_lower_Q7, maxBits - silk_RSHIFT( bits_margin, 1 ) - nBits_lower ), nBits_upper - nBits_lower );
+                /* New log gain must be between 12.5% and 87.5% of old range (note that gainMult_upper < gainMult_lower) */
+                if( log_Q7 > silk_ADD_RSHIFT32( log_lower_Q7, log_upper_Q7 - log_lower_Q7, 3 ) ) {
+                    log_Q7 = silk_ADD_RSHIFT32( log_lower_Q7, log_upper_Q7 - log_lower_Q7, 3 );
                 } else
-                if( gainMult_Q8 < silk_SUB_RSHIFT32( gainMult_upper, gainMult_upper - gainMult_lower, 2 ) ) {
-                    gainMult_Q8 = silk_SUB_RSHIFT32( gainMult_upper, gainMult_upper - gainMult_lower, 2 );
+                if( log_Q7 < silk_SUB_RSHIFT32( log_upper_Q7, log_upper_Q7 - log_lower_Q7, 3 ) ) {
+                    log_Q7 = silk_SUB_RSHIFT32( log_upper_Q7, log_upper_Q7 - log_lower_Q7, 3 );
                 }
+                gainMult_Q8 = silk_log2lin( log_Q7 );
             }
 
             for( i = 0; i < psEnc->sCmn.nb_subfr; i++ ) {
@@ -426,6 +464,7 @@ static OPUS_INLINE void silk_LBRR_encode_FIX(
         /*****************************************/
         /* Noise shaping quantization            */
         /*****************************************/
+        OPUS_PROFILE_ENTER( OPUS_PROFILE_SILK_NSQ );
         if( psEnc->sCmn.nStatesDelayedDecision > 1 || psEnc->sCmn.warping_Q16 > 0 ) {
             silk_NSQ_del_dec( &psEnc->sCmn, &sNSQ_LBRR, psIndices_LBRR, x16,
                 psEnc->sCmn.pulses_LBRR[ psEnc->sCmn.nFramesEncoded ], psEncCtrl->PredCoef_Q12[ 0 ], psEncCtrl->LTPCoef_Q14,
@@ -437,6 +476,7 @@ static OPUS_INLINE void silk_LBRR_encode_FIX(
                 psEncCtrl->AR_Q13, psEncCtrl->HarmShapeGain_Q14, psEncCtrl->Tilt_Q14, psEncCtrl->LF_shp_Q14,
                 psEncCtrl->Gains_Q16, psEncCtrl->pitchL, psEncCtrl->Lambda_Q10, psEncCtrl->LTP_scale_Q14, psEnc->sCmn.arch );
         }
+        OPUS_PROFILE_LEAVE( OPUS_PROFILE_SILK_NSQ );
 
         /* Restore original gains */
         silk_memcpy( psEncCtrl->Gains_Q16, TempGains_Q16, psEnc->sCmn.nb_subfr * sizeof( opus_int32 ) );
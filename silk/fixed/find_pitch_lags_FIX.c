@@ -32,6 +32,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "main_FIX.h"
 #include "stack_alloc.h"
 #include "tuning_parameters.h"
+#include "pitch_est_defines.h"
 
 /* Find pitch lags */
 void silk_find_pitch_lags_FIX(
@@ -42,7 +43,7 @@ void silk_find_pitch_lags_FIX(
     int                             arch                                    /* I    Run-time architecture                                                       */
 )
 {
-    opus_int   buf_len, i, scale;
+    opus_int   buf_len, i, scale, voicing, prevLTPCorr_Q15;
     opus_int32 thrhld_Q13, res_nrg;
     const opus_int16 *x_ptr;
     VARDECL( opus_int16, Wsig );
@@ -124,10 +125,26 @@ void silk_find_pitch_lags_FIX(
         /*****************************************/
         /* Call pitch estimator                  */
         /*****************************************/
-        if( silk_pitch_analysis_core( res, psEncCtrl->pitchL, &psEnc->sCmn.indices.lagIndex, &psEnc->sCmn.indices.contourIndex,
-                &psEnc->LTPCorr_Q15, psEnc->sCmn.prevLag, psEnc->sCmn.pitchEstimationThreshold_Q16,
-                (opus_int)thrhld_Q13, psEnc->sCmn.fs_kHz, psEnc->sCmn.pitchEstimationComplexity, psEnc->sCmn.nb_subfr,
-                psEnc->sCmn.arch) == 0 )
+        voicing = 1;
+        if( psEnc->sCmn.pitchTracking && psEnc->sCmn.prevSignalType == TYPE_VOICED && psEnc->sCmn.prevLag > 0 &&
+            psEnc->LTPCorr_Q15 >= SILK_FIX_CONST( PE_TRACK_CORR_THRES, 15 ) ) {
+            /* Stationary voiced speech: first try to follow the previous lag */
+            prevLTPCorr_Q15 = psEnc->LTPCorr_Q15;
+            voicing = silk_pitch_analysis_core( res, psEncCtrl->pitchL, &psEnc->sCmn.indices.lagIndex, &psEnc->sCmn.indices.contourIndex,
+                    &psEnc->LTPCorr_Q15, psEnc->sCmn.prevLag, psEnc->sCmn.pitchEstimationThreshold_Q16,
+                    (opus_int)thrhld_Q13, psEnc->sCmn.fs_kHz, psEnc->sCmn.pitchEstimationComplexity, psEnc->sCmn.nb_subfr,
+                    1, psEnc->sCmn.arch );
+            if( voicing != 0 ) {
+                psEnc->LTPCorr_Q15 = prevLTPCorr_Q15;
+            }
+        }
+        if( voicing != 0 ) {
+            voicing = silk_pitch_analysis_core( res, psEncCtrl->pitchL, &psEnc->sCmn.indices.lagIndex, &psEnc->sCmn.indices.contourIndex,
+                    &psEnc->LTPCorr_Q15, psEnc->sCmn.prevLag, psEnc->sCmn.pitchEstimationThreshold_Q16,
+                    (opus_int)thrhld_Q13, psEnc->sCmn.fs_kHz, psEnc->sCmn.pitchEstimationComplexity, psEnc->sCmn.nb_subfr,
+                    0, psEnc->sCmn.arch );
+        }
+        if( voicing == 0 )
         {
             psEnc->sCmn.indices.signalType = TYPE_VOICED;
         } else {
@@ -91,6 +91,7 @@ opus_int silk_pitch_analysis_core(                  /* O    Voicing estimate: 0
     const opus_int              Fs_kHz,             /* I    Sample frequency (kHz)                                      */
     const opus_int              complexity,         /* I    Complexity setting, 0-2, where 2 is highest                 */
     const opus_int              nb_subfr,           /* I    number of 5 ms subframes                                    */
+    const opus_int              trackLag,           /* I    Only search around prevLag; unvoiced if it no longer fits   */
     int                         arch                /* I    Run-time architecture                                       */
 )
 {
@@ -99,7 +100,7 @@ opus_int silk_pitch_analysis_core(                  /* O    Voicing estimate: 0
     VARDECL( opus_int16, frame_scaled );
     opus_int32 filt_state[ 6 ];
     const opus_int16 *frame, *frame_8kHz;
-    opus_int   i, k, d, j;
+    opus_int   i, k, d, j, d_max;
     VARDECL( opus_int16, C );
     VARDECL( opus_int32, xcorr32 );
     const opus_int16 *target_ptr, *basis_ptr;
@@ -111,6 +112,8 @@ opus_int silk_pitch_analysis_core(                  /* O    Voicing estimate: 0
     opus_int32 CC[ PE_NB_CBKS_STAGE2_EXT ], CCmax, CCmax_b, CCmax_new_b, CCmax_new;
     VARDECL( silk_pe_stage3_vals, energies_st3 );
     VARDECL( silk_pe_stage3_vals, cross_corr_st3 );
+    opus_int32 cross_corr_sum[ PE_NB_CBKS_STAGE3_MAX * PE_NB_STAGE3_LAGS ];
+    opus_int32 energy_sum[ PE_NB_CBKS_STAGE3_MAX * PE_NB_STAGE3_LAGS ];
     opus_int   frame_length, frame_length_8kHz, frame_length_4kHz;
     opus_int   sf_length;
     opus_int   min_lag;
@@ -168,113 +171,134 @@ opus_int silk_pitch_analysis_core(                  /* O    Voicing estimate: 0
         frame_8kHz = frame;
     }
 
-    /* Decimate again to 4 kHz */
-    silk_memset( filt_state, 0, 2 * sizeof( opus_int32 ) );/* Set state to zero */
-    ALLOC( frame_4kHz, frame_length_4kHz, opus_int16 );
-    silk_resampler_down2( filt_state, frame_4kHz, frame_8kHz, frame_length_8kHz );
+    ALLOC( C, nb_subfr * CSTRIDE_8KHZ, opus_int16 );
+    ALLOC( xcorr32, MAX_LAG_8KHZ - MIN_LAG_8KHZ + 4, opus_int32 );
 
-    /* Low-pass filter */
-    for( i = frame_length_4kHz - 1; i > 0; i-- ) {
-        frame_4kHz[ i ] = silk_ADD_SAT16( frame_4kHz[ i ], frame_4kHz[ i - 1 ] );
+    /* Previous lag at 8 kHz */
+    if( prevLag > 0 ) {
+        if( Fs_kHz == 12 ) {
+            prevLag = silk_DIV32_16( silk_LSHIFT( prevLag, 1 ), 3 );
+        } else if( Fs_kHz == 16 ) {
+            prevLag = silk_RSHIFT( prevLag, 1 );
+        }
+        prevLag_log2_Q7 = silk_lin2log( (opus_int32)prevLag );
+    } else {
+        prevLag_log2_Q7 = 0;
     }
 
+    if( trackLag ) {
+        /* Stationary voiced speech: skip the first stage and only search around the previous lag */
+        celt_assert( prevLag > 0 );
+        prevLag = silk_LIMIT_int( prevLag, MIN_LAG_8KHZ + 1, MAX_LAG_8KHZ - 1 );
+        d_srch[ 0 ] = prevLag - 1;
+        d_srch[ 1 ] = prevLag + 1;
+        length_d_srch = 2;
+    } else {
+        /* Decimate again to 4 kHz */
+        silk_memset( filt_state, 0, 2 * sizeof( opus_int32 ) );/* Set state to zero */
+        ALLOC( frame_4kHz, frame_length_4kHz, opus_int16 );
+        silk_resampler_down2( filt_state, frame_4kHz, frame_8kHz, frame_length_8kHz );
+
+        /* Low-pass filter */
+        for( i = frame_length_4kHz - 1; i > 0; i-- ) {
+            frame_4kHz[ i ] = silk_ADD_SAT16( frame_4kHz[ i ], frame_4kHz[ i - 1 ] );
+        }
 
-    /******************************************************************************
-    * FIRST STAGE, operating in 4 khz
-    ******************************************************************************/
-    ALLOC( C, nb_subfr * CSTRIDE_8KHZ, opus_int16 );
-    ALLOC( xcorr32, MAX_LAG_4KHZ-MIN_LAG_4KHZ+1, opus_int32 );
-    silk_memset( C, 0, (nb_subfr >> 1) * CSTRIDE_4KHZ * sizeof( opus_int16 ) );
-    target_ptr = &frame_4kHz[ silk_LSHIFT( SF_LENGTH_4KHZ, 2 ) ];
-    for( k = 0; k < nb_subfr >> 1; k++ ) {
-        /* Check that we are within range of the array */
-        celt_assert( target_ptr >= frame_4kHz );
-        celt_assert( target_ptr + SF_LENGTH_8KHZ <= frame_4kHz + frame_length_4kHz );
+        /******************************************************************************
+        * FIRST STAGE, operating in 4 khz
+        ******************************************************************************/
+        silk_memset( C, 0, (nb_subfr >> 1) * CSTRIDE_4KHZ * sizeof( opus_int16 ) );
+        target_ptr = &frame_4kHz[ silk_LSHIFT( SF_LENGTH_4KHZ, 2 ) ];
+        for( k = 0; k < nb_subfr >> 1; k++ ) {
+            /* Check that we are within range of the array */
+            celt_assert( target_ptr >= frame_4kHz );
+            celt_assert( target_ptr + SF_LENGTH_8KHZ <= frame_4kHz + frame_length_4kHz );
 
-        basis_ptr = target_ptr - MIN_LAG_4KHZ;
+            basis_ptr = target_ptr - MIN_LAG_4KHZ;
 
-        /* Check that we are within range of the array */
-        celt_assert( basis_ptr >= frame_4kHz );
-        celt_assert( basis_ptr + SF_LENGTH_8KHZ <= frame_4kHz + frame_length_4kHz );
+            /* Check that we are within range of the array */
+            celt_assert( basis_ptr >= frame_4kHz );
+            celt_assert( basis_ptr + SF_LENGTH_8KHZ <= frame_4kHz + frame_length_4kHz );
 
-        celt_pitch_xcorr( target_ptr, target_ptr - MAX_LAG_4KHZ, xcorr32, SF_LENGTH_8KHZ, MAX_LAG_4KHZ - MIN_LAG_4KHZ + 1, arch );
+            celt_pitch_xcorr( target_ptr, target_ptr - MAX_LAG_4KHZ, xcorr32, SF_LENGTH_8KHZ, MAX_LAG_4KHZ - MIN_LAG_4KHZ + 1, arch );
 
-        /* Calculate first vector products before loop */
-        cross_corr = xcorr32[ MAX_LAG_4KHZ - MIN_LAG_4KHZ ];
-        normalizer = silk_inner_prod_aligned( target_ptr, target_ptr, SF_LENGTH_8KHZ, arch );
-        normalizer = silk_ADD32( normalizer, silk_inner_prod_aligned( basis_ptr,  basis_ptr, SF_LENGTH_8KHZ, arch ) );
-        normalizer = silk_ADD32( normalizer, silk_SMULBB( SF_LENGTH_8KHZ, 4000 ) );
+            /* Calculate first vector products before loop */
+            cross_corr = xcorr32[ MAX_LAG_4KHZ - MIN_LAG_4KHZ ];
+            normalizer = silk_inner_prod_aligned( target_ptr, target_ptr, SF_LENGTH_8KHZ, arch );
+            normalizer = silk_ADD32( normalizer, silk_inner_prod_aligned( basis_ptr,  basis_ptr, SF_LENGTH_8KHZ, arch ) );
+            normalizer = silk_ADD32( normalizer, silk_SMULBB( SF_LENGTH_8KHZ, 4000 ) );
 
-        matrix_ptr( C, k, 0, CSTRIDE_4KHZ ) =
-            (opus_int16)silk_DIV32_varQ( cross_corr, normalizer, 13 + 1 );                      /* Q13 */
+            matrix_ptr( C, k, 0, CSTRIDE_4KHZ ) =
+                (opus_int16)silk_DIV32_varQ( cross_corr, normalizer, 13 + 1 );                      /* Q13 */
 
-        /* From now on normalizer is computed recursively */
-        for( d = MIN_LAG_4KHZ + 1; d <= MAX_LAG_4KHZ; d++ ) {
-            basis_ptr--;
+            /* From now on normalizer is computed recursively */
+            for( d = MIN_LAG_4KHZ + 1; d <= MAX_LAG_4KHZ; d++ ) {
+                basis_ptr--;
 
-            /* Check that we are within range of the array */
-            silk_assert( basis_ptr >= frame_4kHz );
-            silk_assert( basis_ptr + SF_LENGTH_8KHZ <= frame_4kHz + frame_length_4kHz );
+                /* Check that we are within range of the array */
+                silk_assert( basis_ptr >= frame_4kHz );
+                silk_assert( basis_ptr + SF_LENGTH_8KHZ <= frame_4kHz + frame_length_4kHz );
 
-            cross_corr = xcorr32[ MAX_LAG_4KHZ - d ];
+                cross_corr = xcorr32[ MAX_LAG_4KHZ - d ];
 
-            /* Add contribution of new sample and remove contribution from oldest sample */
-            normalizer = silk_ADD32( normalizer,
-                silk_SMULBB( basis_ptr[ 0 ], basis_ptr[ 0 ] ) -
-                silk_SMULBB( basis_ptr[ SF_LENGTH_8KHZ ], basis_ptr[ SF_LENGTH_8KHZ ] ) );
+                /* Add contribution of new sample and remove contribution from oldest sample */
+                normalizer = silk_ADD32( normalizer,
+                    silk_SMULBB( basis_ptr[ 0 ], basis_ptr[ 0 ] ) -
+                    silk_SMULBB( basis_ptr[ SF_LENGTH_8KHZ ], basis_ptr[ SF_LENGTH_8KHZ ] ) );
 
-            matrix_ptr( C, k, d - MIN_LAG_4KHZ, CSTRIDE_4KHZ) =
-                (opus_int16)silk_DIV32_varQ( cross_corr, normalizer, 13 + 1 );                  /* Q13 */
+                matrix_ptr( C, k, d - MIN_LAG_4KHZ, CSTRIDE_4KHZ) =
+                    (opus_int16)silk_DIV32_varQ( cross_corr, normalizer, 13 + 1 );                  /* Q13 */
+            }
+            /* Update target pointer */
+            target_ptr += SF_LENGTH_8KHZ;
         }
-        /* Update target pointer */
-        target_ptr += SF_LENGTH_8KHZ;
-    }
 
-    /* Combine two subframes into single correlation measure and apply short-lag bias */
-    if( nb_subfr == PE_MAX_NB_SUBFR ) {
-        for( i = MAX_LAG_4KHZ; i >= MIN_LAG_4KHZ; i-- ) {
-            sum = (opus_int32)matrix_ptr( C, 0, i - MIN_LAG_4KHZ, CSTRIDE_4KHZ )
-                + (opus_int32)matrix_ptr( C, 1, i - MIN_LAG_4KHZ, CSTRIDE_4KHZ );               /* Q14 */
-            sum = silk_SMLAWB( sum, sum, silk_LSHIFT( -i, 4 ) );                                /* Q14 */
-            C[ i - MIN_LAG_4KHZ ] = (opus_int16)sum;                                            /* Q14 */
-        }
-    } else {
-        /* Only short-lag bias */
-        for( i = MAX_LAG_4KHZ; i >= MIN_LAG_4KHZ; i-- ) {
-            sum = silk_LSHIFT( (opus_int32)C[ i - MIN_LAG_4KHZ ], 1 );                          /* Q14 */
-            sum = silk_SMLAWB( sum, sum, silk_LSHIFT( -i, 4 ) );                                /* Q14 */
-            C[ i - MIN_LAG_4KHZ ] = (opus_int16)sum;                                            /* Q14 */
+        /* Combine two subframes into single correlation measure and apply short-lag bias */
+        if( nb_subfr == PE_MAX_NB_SUBFR ) {
+            for( i = MAX_LAG_4KHZ; i >= MIN_LAG_4KHZ; i-- ) {
+                sum = (opus_int32)matrix_ptr( C, 0, i - MIN_LAG_4KHZ, CSTRIDE_4KHZ )
+                    + (opus_int32)matrix_ptr( C, 1, i - MIN_LAG_4KHZ, CSTRIDE_4KHZ );               /* Q14 */
+                sum = silk_SMLAWB( sum, sum, silk_LSHIFT( -i, 4 ) );                                /* Q14 */
+                C[ i - MIN_LAG_4KHZ ] = (opus_int16)sum;                                            /* Q14 */
+            }
+        } else {
+            /* Only short-lag bias */
+            for( i = MAX_LAG_4KHZ; i >= MIN_LAG_4KHZ; i-- ) {
+                sum = silk_LSHIFT( (opus_int32)C[ i - MIN_LAG_4KHZ ], 1 );                          /* Q14 */
+                sum = silk_SMLAWB( sum, sum, silk_LSHIFT( -i, 4 ) );                                /* Q14 */
+                C[ i - MIN_LAG_4KHZ ] = (opus_int16)sum;                                            /* Q14 */
+            }
         }
-    }
-
-    /* Sort */
-    length_d_srch = silk_ADD_LSHIFT32( 4, complexity, 1 );
-    celt_assert( 3 * length_d_srch <= PE_D_SRCH_LENGTH );
-    silk_insertion_sort_decreasing_int16( C, d_srch, CSTRIDE_4KHZ,
-                                          length_d_srch );
 
-    /* Escape if correlation is very low already here */
-    Cmax = (opus_int)C[ 0 ];                                                    /* Q14 */
-    if( Cmax < SILK_FIX_CONST( 0.2, 14 ) ) {
-        silk_memset( pitch_out, 0, nb_subfr * sizeof( opus_int ) );
-        *LTPCorr_Q15  = 0;
-        *lagIndex     = 0;
-        *contourIndex = 0;
-        RESTORE_STACK;
-        return 1;
-    }
+        /* Sort */
+        length_d_srch = silk_ADD_LSHIFT32( 4, complexity, 1 );
+        celt_assert( 3 * length_d_srch <= PE_D_SRCH_LENGTH );
+        silk_insertion_sort_decreasing_int16( C, d_srch, CSTRIDE_4KHZ,
+                                              length_d_srch );
+
+        /* Escape if correlation is very low already here */
+        Cmax = (opus_int)C[ 0 ];                                                    /* Q14 */
+        if( Cmax < SILK_FIX_CONST( 0.2, 14 ) ) {
+            silk_memset( pitch_out, 0, nb_subfr * sizeof( opus_int ) );
+            *LTPCorr_Q15  = 0;
+            *lagIndex     = 0;
+            *contourIndex = 0;
+            RESTORE_STACK;
+            return 1;
+        }
 
-    threshold = silk_SMULWB( search_thres1_Q16, Cmax );
-    for( i = 0; i < length_d_srch; i++ ) {
-        /* Convert to 8 kHz indices for the sorted correlation that exceeds the threshold */
-        if( C[ i ] > threshold ) {
-            d_srch[ i ] = silk_LSHIFT( d_srch[ i ] + MIN_LAG_4KHZ, 1 );
-        } else {
-            length_d_srch = i;
-            break;
+        threshold = silk_SMULWB( search_thres1_Q16, Cmax );
+        for( i = 0; i < length_d_srch; i++ ) {
+            /* Convert to 8 kHz indices for the sorted correlation that exceeds the threshold */
+            if( C[ i ] > threshold ) {
+                d_srch[ i ] = silk_LSHIFT( d_srch[ i ] + MIN_LAG_4KHZ, 1 );
+            } else {
+                length_d_srch = i;
+                break;
+            }
         }
+        celt_assert( length_d_srch > 0 );
     }
-    celt_assert( length_d_srch > 0 );
 
     ALLOC( d_comp, D_COMP_STRIDE, opus_int16 );
     for( i = D_COMP_MIN; i < D_COMP_MAX; i++ ) {
@@ -329,24 +353,37 @@ opus_int silk_pitch_analysis_core(                  /* O    Voicing estimate: 0
         celt_assert( target_ptr + SF_LENGTH_8KHZ <= frame_8kHz + frame_length_8kHz );
 
         energy_target = silk_ADD32( silk_inner_prod_aligned( target_ptr, target_ptr, SF_LENGTH_8KHZ, arch ), 1 );
-        for( j = 0; j < length_d_comp; j++ ) {
-            d = d_comp[ j ];
-            basis_ptr = target_ptr - d;
+        for( j = 0; j < length_d_comp; j = i ) {
+            /* Correlate each run of consecutive lags in one go */
+            for( i = j + 1; i < length_d_comp && d_comp[ i ] == d_comp[ i - 1 ] + 1; i++ ) {
+            }
+            d_max = d_comp[ i - 1 ];
+            celt_pitch_xcorr( target_ptr, target_ptr - d_max, xcorr32, SF_LENGTH_8KHZ, d_max - d_comp[ j ] + 1, arch );
+
+            basis_ptr = target_ptr - d_comp[ j ];
+            energy_basis = silk_inner_prod_aligned( basis_ptr, basis_ptr, SF_LENGTH_8KHZ, arch );
+            for( d = d_comp[ j ]; d <= d_max; d++ ) {
+                if( d > d_comp[ j ] ) {
+                    /* Energy is computed recursively along the run */
+                    basis_ptr--;
+                    energy_basis -= silk_SMULBB( basis_ptr[ SF_LENGTH_8KHZ ], basis_ptr[ SF_LENGTH_8KHZ ] );
+                    energy_basis = silk_ADD_SAT32( energy_basis, silk_SMULBB( basis_ptr[ 0 ], basis_ptr[ 0 ] ) );
+                }
 
-            /* Check that we are within range of the array */
-            silk_assert( basis_ptr >= frame_8kHz );
-            silk_assert( basis_ptr + SF_LENGTH_8KHZ <= frame_8kHz + frame_length_8kHz );
-
-            cross_corr = silk_inner_prod_aligned( target_ptr, basis_ptr, SF_LENGTH_8KHZ, arch );
-            if( cross_corr > 0 ) {
-                energy_basis = silk_inner_prod_aligned( basis_ptr, basis_ptr, SF_LENGTH_8KHZ, arch );
-                matrix_ptr( C, k, d - ( MIN_LAG_8KHZ - 2 ), CSTRIDE_8KHZ ) =
-                    (opus_int16)silk_DIV32_varQ( cross_corr,
-                                                 silk_ADD32( energy_target,
-                                                             energy_basis ),
-                                                 13 + 1 );                                      /* Q13 */
-            } else {
-                matrix_ptr( C, k, d - ( MIN_LAG_8KHZ - 2 ), CSTRIDE_8KHZ ) = 0;
+                /* Check that we are within range of the array */
+                silk_assert( basis_ptr >= frame_8kHz );
+                silk_assert( basis_ptr + SF_LENGTH_8KHZ <= frame_8kHz + frame_length_8kHz );
+
+                cross_corr = xcorr32[ d_max - d ];
+                if( cross_corr > 0 ) {
+                    matrix_ptr( C, k, d - ( MIN_LAG_8KHZ - 2 ), CSTRIDE_8KHZ ) =
+                        (opus_int16)silk_DIV32_varQ( cross_corr,
+                                                     silk_ADD32( energy_target,
+                                                                 energy_basis ),
+                                                     13 + 1 );                                  /* Q13 */
+                } else {
+                    matrix_ptr( C, k, d - ( MIN_LAG_8KHZ - 2 ), CSTRIDE_8KHZ ) = 0;
+                }
             }
         }
         target_ptr += SF_LENGTH_8KHZ;
@@ -361,16 +398,6 @@ opus_int silk_pitch_analysis_core(                  /* O    Voicing estimate: 0
     CBimax = 0; /* To avoid returning undefined lag values */
     lag = -1;   /* To check if lag with strong enough correlation has been found */
 
-    if( prevLag > 0 ) {
-        if( Fs_kHz == 12 ) {
-            prevLag = silk_DIV32_16( silk_LSHIFT( prevLag, 1 ), 3 );
-        } else if( Fs_kHz == 16 ) {
-            prevLag = silk_RSHIFT( prevLag, 1 );
-        }
-        prevLag_log2_Q7 = silk_lin2log( (opus_int32)prevLag );
-    } else {
-        prevLag_log2_Q7 = 0;
-    }
     silk_assert( search_thres2_Q13 == silk_SAT16( search_thres2_Q13 ) );
     /* Set up stage 2 codebook based on number of subframes */
     if( nb_subfr == PE_MAX_NB_SUBFR ) {
@@ -440,8 +467,8 @@ opus_int silk_pitch_analysis_core(                  /* O    Voicing estimate: 0
         }
     }
 
-    if( lag == -1 ) {
-        /* No suitable candidate found */
+    if( lag == -1 || ( trackLag && CCmax < silk_SMULBB( nb_subfr, SILK_FIX_CONST( PE_TRACK_CORR_THRES, 13 ) ) ) ) {
+        /* No suitable candidate found, or the previous lag is no longer a safe bet */
         silk_memset( pitch_out, 0, nb_subfr * sizeof( opus_int ) );
         *LTPCorr_Q15  = 0;
         *lagIndex     = 0;
@@ -503,19 +530,26 @@ opus_int silk_pitch_analysis_core(                  /* O    Voicing estimate: 0
 
         target_ptr = &frame[ PE_LTP_MEM_LENGTH_MS * Fs_kHz ];
         energy_target = silk_ADD32( silk_inner_prod_aligned( target_ptr, target_ptr, nb_subfr * sf_length, arch ), 1 );
+
+        /* Sum over the subframes for all codebook vectors and lags at once */
+        for( i = 0; i < nb_cbk_search * PE_NB_STAGE3_LAGS; i++ ) {
+            cross_corr_sum[ i ] = 0;
+            energy_sum[ i ]     = energy_target;
+        }
+        for( k = 0; k < nb_subfr; k++ ) {
+            const opus_int32 *cross_corr_ptr = cross_corr_st3[ k * nb_cbk_search ];
+            const opus_int32 *energy_ptr     = energies_st3[ k * nb_cbk_search ];
+            for( i = 0; i < nb_cbk_search * PE_NB_STAGE3_LAGS; i++ ) {
+                cross_corr_sum[ i ] = silk_ADD32( cross_corr_sum[ i ], cross_corr_ptr[ i ] );
+                energy_sum[ i ]     = silk_ADD32( energy_sum[ i ], energy_ptr[ i ] );
+            }
+        }
+
         for( d = start_lag; d <= end_lag; d++ ) {
             for( j = 0; j < nb_cbk_search; j++ ) {
-                cross_corr = 0;
-                energy     = energy_target;
-                for( k = 0; k < nb_subfr; k++ ) {
-                    cross_corr = silk_ADD32( cross_corr,
-                        matrix_ptr( cross_corr_st3, k, j,
-                                    nb_cbk_search )[ lag_counter ] );
-                    energy     = silk_ADD32( energy,
-                        matrix_ptr( energies_st3, k, j,
-                                    nb_cbk_search )[ lag_counter ] );
-                    silk_assert( energy >= 0 );
-                }
+                cross_corr = cross_corr_sum[ j * PE_NB_STAGE3_LAGS + lag_counter ];
+                energy     = energy_sum[ j * PE_NB_STAGE3_LAGS + lag_counter ];
+                silk_assert( energy >= 0 );
                 if( cross_corr > 0 ) {
                     CCmax_new = silk_DIV32_varQ( cross_corr, energy, 13 + 1 );          /* Q13 */
                     /* Reduce depending on flatness of contour */
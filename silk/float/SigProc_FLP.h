@@ -33,6 +33,10 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "main.h"
 #include <math.h>
 
+#if (defined(OPUS_ARM_ASM) || defined(OPUS_ARM_MAY_HAVE_NEON_INTR))
+#include "arm/SigProc_FLP_arm.h"
+#endif
+
 #ifdef  __cplusplus
 extern "C"
 {
@@ -90,6 +94,7 @@ opus_int silk_pitch_analysis_core_FLP(      /* O    Voicing estimate: 0 voiced,
     const opus_int      Fs_kHz,             /* I    sample frequency (kHz)                                      */
     const opus_int      complexity,         /* I    Complexity setting, 0-2, where 2 is highest                 */
     const opus_int      nb_subfr,           /* I    Number of 5 ms subframes                                    */
+    const opus_int      trackLag,           /* I    Only search around prevLag; unvoiced if it no longer fits   */
     int                 arch                /* I    Run-time architecture                                       */
 );
 
@@ -101,7 +106,7 @@ void silk_insertion_sort_decreasing_FLP(
 );
 
 /* Compute reflection coefficients from input signal */
-silk_float silk_burg_modified_FLP(          /* O    returns residual energy                                     */
+silk_float silk_burg_modified_FLP_c(        /* O    returns residual energy                                     */
     silk_float          A[],                /* O    prediction coefficients (length order)                      */
     const silk_float    x[],                /* I    input signal, length: nb_subfr*(D+L_sub)                    */
     const silk_float    minInvGain,         /* I    minimum inverse prediction gain                             */
@@ -111,6 +116,11 @@ silk_float silk_burg_modified_FLP(          /* O    returns residual energy
     int                 arch
 );
 
+#ifndef OVERRIDE_burg_modified_FLP
+#define silk_burg_modified_FLP(A, x, minInvGain, subfr_length, nb_subfr, D, arch) \
+    (silk_burg_modified_FLP_c(A, x, minInvGain, subfr_length, nb_subfr, D, arch))
+#endif
+
 /* multiply a vector by a constant */
 void silk_scale_vector_FLP(
     silk_float          *data1,
@@ -0,0 +1,80 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <arm_neon.h>
+#include "main_FLP.h"
+
+/************************************************/
+/* LPC analysis filter                          */
+/* NB! State is kept internally and the         */
+/* filter always starts with zero state         */
+/* first Order output samples are set to zero   */
+/************************************************/
+void silk_LPC_analysis_filter_FLP_neon(
+    silk_float                      r_LPC[],                            /* O    LPC residual signal                         */
+    const silk_float                PredCoef[],                         /* I    LPC coefficients                            */
+    const silk_float                s[],                                /* I    Input signal                                */
+    const opus_int                  length,                             /* I    Length of input signal                      */
+    const opus_int                  Order                               /* I    LPC order                                   */
+)
+{
+    opus_int   ix, k;
+    silk_float LPC_pred;
+    const silk_float *s_ptr;
+
+    celt_assert( Order <= length );
+
+    /* Eight output samples at a time */
+    for( ix = Order; ix < length - 7; ix += 8 ) {
+        float32x4_t pred0, pred1;
+        s_ptr = &s[ ix - 1 ];
+        pred0 = pred1 = vdupq_n_f32( 0 );
+        for( k = 0; k < Order; k++ ) {
+            pred0 = vmlaq_n_f32( pred0, vld1q_f32( &s_ptr[ -k ] ),     PredCoef[ k ] );
+            pred1 = vmlaq_n_f32( pred1, vld1q_f32( &s_ptr[ 4 - k ] ), PredCoef[ k ] );
+        }
+        /* prediction error */
+        vst1q_f32( &r_LPC[ ix ],     vsubq_f32( vld1q_f32( &s[ ix ] ),     pred0 ) );
+        vst1q_f32( &r_LPC[ ix + 4 ], vsubq_f32( vld1q_f32( &s[ ix + 4 ] ), pred1 ) );
+    }
+    for( ; ix < length; ix++ ) {
+        s_ptr = &s[ ix - 1 ];
+        LPC_pred = 0;
+        for( k = 0; k < Order; k++ ) {
+            LPC_pred += s_ptr[ -k ] * PredCoef[ k ];
+        }
+        /* prediction error */
+        r_LPC[ ix ] = s_ptr[ 1 ] - LPC_pred;
+    }
+
+    /* Set first Order output samples to zero */
+    silk_memset( r_LPC, 0, Order * sizeof( silk_float ) );
+}
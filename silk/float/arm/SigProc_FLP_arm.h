@@ -0,0 +1,113 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifndef SILK_SIGPROC_FLP_ARM_H
+# define SILK_SIGPROC_FLP_ARM_H
+
+# include "celt/arm/armcpu.h"
+
+# if defined(OPUS_ARM_MAY_HAVE_NEON_INTR)
+double silk_inner_product_FLP_neon(
+    const silk_float    *data1,
+    const silk_float    *data2,
+    opus_int            dataSize
+);
+
+void silk_warped_autocorrelation_FLP_neon(
+    silk_float          *corr,              /* O    Result [order + 1]                                          */
+    const silk_float    *input,             /* I    Input data to correlate                                     */
+    const silk_float    warping,            /* I    Warping coefficient                                         */
+    const opus_int      length,             /* I    Length of input                                             */
+    const opus_int      order               /* I    Correlation order (even)                                    */
+);
+
+void silk_LPC_analysis_filter_FLP_neon(
+    silk_float          r_LPC[],            /* O    LPC residual signal                                         */
+    const silk_float    PredCoef[],         /* I    LPC coefficients                                            */
+    const silk_float    s[],                /* I    Input signal                                                */
+    const opus_int      length,             /* I    Length of input signal                                      */
+    const opus_int      Order               /* I    LPC order                                                   */
+);
+
+#  if !defined(OPUS_HAVE_RTCD) && defined(OPUS_ARM_PRESUME_NEON)
+#   define OVERRIDE_inner_product_FLP (1)
+#   define silk_inner_product_FLP(data1, data2, dataSize, arch) \
+    ((void)(arch), PRESUME_NEON(silk_inner_product_FLP)(data1, data2, dataSize))
+#   define OVERRIDE_warped_autocorrelation_FLP (1)
+#   define silk_warped_autocorrelation_FLP(corr, input, warping, length, order, arch) \
+    ((void)(arch), PRESUME_NEON(silk_warped_autocorrelation_FLP)(corr, input, warping, length, order))
+#   define OVERRIDE_LPC_analysis_filter_FLP (1)
+#   define silk_LPC_analysis_filter_FLP(r_LPC, PredCoef, s, length, Order, arch) \
+    ((void)(arch), PRESUME_NEON(silk_LPC_analysis_filter_FLP)(r_LPC, PredCoef, s, length, Order))
+#  endif
+# endif
+
+# if !defined(OVERRIDE_inner_product_FLP)
+/*Is run-time CPU detection enabled on this platform?*/
+#  if defined(OPUS_HAVE_RTCD) && (defined(OPUS_ARM_MAY_HAVE_NEON_INTR) && !defined(OPUS_ARM_PRESUME_NEON_INTR))
+extern double (*const SILK_INNER_PRODUCT_FLP_IMPL[OPUS_ARCHMASK+1])(
+    const silk_float    *data1,
+    const silk_float    *data2,
+    opus_int            dataSize
+);
+extern void (*const SILK_WARPED_AUTOCORRELATION_FLP_IMPL[OPUS_ARCHMASK+1])(
+    silk_float          *corr,
+    const silk_float    *input,
+    const silk_float    warping,
+    const opus_int      length,
+    const opus_int      order
+);
+extern void (*const SILK_LPC_ANALYSIS_FILTER_FLP_IMPL[OPUS_ARCHMASK+1])(
+    silk_float          r_LPC[],
+    const silk_float    PredCoef[],
+    const silk_float    s[],
+    const opus_int      length,
+    const opus_int      Order
+);
+#   define OVERRIDE_inner_product_FLP (1)
+#   define silk_inner_product_FLP(data1, data2, dataSize, arch) \
+    ((*SILK_INNER_PRODUCT_FLP_IMPL[(arch)&OPUS_ARCHMASK])(data1, data2, dataSize))
+#   define OVERRIDE_warped_autocorrelation_FLP (1)
+#   define silk_warped_autocorrelation_FLP(corr, input, warping, length, order, arch) \
+    ((*SILK_WARPED_AUTOCORRELATION_FLP_IMPL[(arch)&OPUS_ARCHMASK])(corr, input, warping, length, order))
+#   define OVERRIDE_LPC_analysis_filter_FLP (1)
+#   define silk_LPC_analysis_filter_FLP(r_LPC, PredCoef, s, length, Order, arch) \
+    ((*SILK_LPC_ANALYSIS_FILTER_FLP_IMPL[(arch)&OPUS_ARCHMASK])(r_LPC, PredCoef, s, length, Order))
+#  elif defined(OPUS_ARM_PRESUME_NEON_INTR)
+#   define OVERRIDE_inner_product_FLP (1)
+#   define silk_inner_product_FLP(data1, data2, dataSize, arch) \
+    ((void)(arch), silk_inner_product_FLP_neon(data1, data2, dataSize))
+#   define OVERRIDE_warped_autocorrelation_FLP (1)
+#   define silk_warped_autocorrelation_FLP(corr, input, warping, length, order, arch) \
+    ((void)(arch), silk_warped_autocorrelation_FLP_neon(corr, input, warping, length, order))
+#   define OVERRIDE_LPC_analysis_filter_FLP (1)
+#   define silk_LPC_analysis_filter_FLP(r_LPC, PredCoef, s, length, Order, arch) \
+    ((void)(arch), silk_LPC_analysis_filter_FLP_neon(r_LPC, PredCoef, s, length, Order))
+#  endif
+# endif
+
+#endif /* end SILK_SIGPROC_FLP_ARM_H */
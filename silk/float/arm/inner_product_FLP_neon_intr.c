@@ -0,0 +1,77 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <arm_neon.h>
+#include "SigProc_FLP.h"
+
+/* inner product of two silk_float arrays, with result as double */
+double silk_inner_product_FLP_neon(
+    const silk_float    *data1,
+    const silk_float    *data2,
+    opus_int            dataSize
+)
+{
+#if defined(__ARM_ARCH_ISA_A64)
+    opus_int    i;
+    double      result;
+    float64x2_t acc0, acc1, acc2, acc3;
+
+    /* 8x unrolled loop, accumulating in double precision */
+    acc0 = acc1 = acc2 = acc3 = vdupq_n_f64( 0 );
+    for( i = 0; i < dataSize - 7; i += 8 ) {
+        float32x4_t x0 = vld1q_f32( &data1[ i ] );
+        float32x4_t y0 = vld1q_f32( &data2[ i ] );
+        float32x4_t x1 = vld1q_f32( &data1[ i + 4 ] );
+        float32x4_t y1 = vld1q_f32( &data2[ i + 4 ] );
+        acc0 = vfmaq_f64( acc0, vcvt_f64_f32( vget_low_f32( x0 ) ), vcvt_f64_f32( vget_low_f32( y0 ) ) );
+        acc1 = vfmaq_f64( acc1, vcvt_high_f64_f32( x0 ), vcvt_high_f64_f32( y0 ) );
+        acc2 = vfmaq_f64( acc2, vcvt_f64_f32( vget_low_f32( x1 ) ), vcvt_f64_f32( vget_low_f32( y1 ) ) );
+        acc3 = vfmaq_f64( acc3, vcvt_high_f64_f32( x1 ), vcvt_high_f64_f32( y1 ) );
+    }
+    for( ; i < dataSize - 3; i += 4 ) {
+        float32x4_t x0 = vld1q_f32( &data1[ i ] );
+        float32x4_t y0 = vld1q_f32( &data2[ i ] );
+        acc0 = vfmaq_f64( acc0, vcvt_f64_f32( vget_low_f32( x0 ) ), vcvt_f64_f32( vget_low_f32( y0 ) ) );
+        acc1 = vfmaq_f64( acc1, vcvt_high_f64_f32( x0 ), vcvt_high_f64_f32( y0 ) );
+    }
+    result = vaddvq_f64( vaddq_f64( vaddq_f64( acc0, acc1 ), vaddq_f64( acc2, acc3 ) ) );
+
+    /* add any remaining products */
+    for( ; i < dataSize; i++ ) {
+        result += data1[ i ] * (double)data2[ i ];
+    }
+
+    return result;
+#else
+    /* 32-bit Neon has no double precision vectors */
+    return silk_inner_product_FLP_c( data1, data2, dataSize );
+#endif
+}
@@ -0,0 +1,102 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <arm_neon.h>
+#include "main_FLP.h"
+
+/* Autocorrelations for a warped frequency axis */
+/* Wavefront evaluation of the allpass chain, see silk_warped_autocorrelation_FLP_avx2(). */
+void silk_warped_autocorrelation_FLP_neon(
+    silk_float                      *corr,                              /* O    Result [order + 1]                          */
+    const silk_float                *input,                             /* I    Input data to correlate                     */
+    const silk_float                warping,                            /* I    Warping coefficient                         */
+    const opus_int                  length,                             /* I    Length of input                             */
+    const opus_int                  order                               /* I    Correlation order (even)                    */
+)
+{
+#if defined(__ARM_ARCH_ISA_A64)
+    opus_int    n, i, q, nv;
+    double      x_buf[ MAX_SHAPE_LPC_ORDER + SHAPE_LPC_WIN_MAX + MAX_SHAPE_LPC_ORDER ];
+    double      C[ MAX_SHAPE_LPC_ORDER ];
+    double      C0;
+    double      *x;
+    float64x2_t state[ MAX_SHAPE_LPC_ORDER / 2 ], prev[ MAX_SHAPE_LPC_ORDER / 2 ], acc[ MAX_SHAPE_LPC_ORDER / 2 ];
+    float64x2_t w;
+
+    /* Order must be even */
+    celt_assert( ( order & 1 ) == 0 );
+    celt_assert( order <= MAX_SHAPE_LPC_ORDER && length <= SHAPE_LPC_WIN_MAX );
+
+    /* Zero padded copy of the input, so the first and last samples of the wavefront need no special casing */
+    x = x_buf + MAX_SHAPE_LPC_ORDER;
+    for( i = 0; i < MAX_SHAPE_LPC_ORDER; i++ ) {
+        x_buf[ i ] = 0;
+        x[ length + i ] = 0;
+    }
+    C0 = 0;
+    for( n = 0; n < length; n++ ) {
+        x[ n ] = input[ n ];
+        C0 += x[ n ] * x[ n ];
+    }
+
+    /* Lane j of vector q holds allpass section order - 2 * q - j */
+    nv = order >> 1;
+    w = vdupq_n_f64( warping );
+    for( q = 0; q < nv; q++ ) {
+        state[ q ] = prev[ q ] = acc[ q ] = vdupq_n_f64( 0 );
+    }
+    for( n = 0; n < length + order - 1; n++ ) {
+        const double *x_ptr = &x[ n - order + 1 ];
+        for( q = 0; q < nv; q++ ) {
+            float64x2_t next, shifted, tmp;
+            /* Input of each section, i.e. the previous section shifted in by one lane */
+            next = q + 1 < nv ? state[ q + 1 ] : vdupq_n_f64( x[ n ] );
+            shifted = vextq_f64( state[ q ], next, 1 );
+            tmp = vfmsq_f64( vfmaq_f64( prev[ q ], state[ q ], w ), shifted, w );
+            prev[ q ] = shifted;
+            state[ q ] = tmp;
+            acc[ q ] = vfmaq_f64( acc[ q ], vld1q_f64( &x_ptr[ 2 * q ] ), tmp );
+        }
+    }
+    for( q = 0; q < nv; q++ ) {
+        vst1q_f64( &C[ 2 * q ], acc[ q ] );
+    }
+
+    /* Copy correlations in silk_float output format */
+    corr[ 0 ] = ( silk_float )C0;
+    for( i = 1; i < order + 1; i++ ) {
+        corr[ i ] = ( silk_float )C[ order - i ];
+    }
+#else
+    /* 32-bit Neon has no double precision vectors */
+    silk_warped_autocorrelation_FLP_c( corr, input, warping, length, order );
+#endif
+}
@@ -36,7 +36,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include "main_FLP.h"
 
 /* Calculates correlation vector X'*t */
-void silk_corrVector_FLP(
+void silk_corrVector_FLP_c(
     const silk_float                *x,                                 /* I    x vector [L+order-1] used to create X       */
     const silk_float                *t,                                 /* I    Target vector [L]                           */
     const opus_int                  L,                                  /* I    Length of vecors                            */
@@ -57,7 +57,7 @@ void silk_corrVector_FLP(
 }
 
 /* Calculates correlation matrix X'*X */
-void silk_corrMatrix_FLP(
+void silk_corrMatrix_FLP_c(
     const silk_float                *x,                                 /* I    x vector [ L+order-1 ] used to create X     */
     const opus_int                  L,                                  /* I    Length of vectors                           */
     const opus_int                  Order,                              /* I    Max lag for correlation                     */
@@ -32,6 +32,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <stdlib.h>
 #include "main_FLP.h"
 #include "tuning_parameters.h"
+#include "profile.h"
 
 /* Low Bitrate Redundancy (LBRR) encoding. Reuse all parameters but encode with lower bitrate */
 static OPUS_INLINE void silk_LBRR_encode_FLP(
@@ -98,6 +99,8 @@ opus_int silk_encode_frame_FLP(
     silk_nsq_state sNSQ_copy, sNSQ_copy2;
     opus_int32   seed_copy, nBits, nBits_lower, nBits_upper, gainMult_lower, gainMult_upper;
     opus_int32   gainsID, gainsID_lower, gainsID_upper;
+    opus_int32   pulseBits, gainMult_pred, gainMult_prev, nBits_prev;
+    opus_int     predict;
     opus_int16   gainMult_Q8;
     opus_int16   ec_prevLagIndex_copy;
     opus_int     ec_prevSignalType_copy;
@@ -112,9 +115,10 @@ opus_int silk_encode_frame_FLP(
     /* For CBR, 5 bits below budget is close enough. For VBR, allow up to 25% below the cap if we initially busted the budget. */
     bits_margin = useCBR ? 5 : maxBits/4;
     /* This is totally unnecessary but many compilers (including gcc) are too dumb to realise it */
-    LastGainIndex_copy2 = nBits_lower = nBits_upper = gainMult_lower = gainMult_upper = 0;
+    LastGainIndex_copy2 = nBits_lower = nBits_upper = gainMult_lower = gainMult_upper = pulseBits = 0;
 
     psEnc->sCmn.indices.Seed = psEnc->sCmn.frameCounter++ & 3;
+    psEnc->sCmn.nRatePasses = 0;
 
     /**************************************************************/
     /* Set up Input Pointers, and insert frame in input buffer    */
@@ -142,7 +146,9 @@ opus_int silk_encode_frame_FLP(
         /*****************************************/
         /* Find pitch lags, initial LPC analysis */
         /*****************************************/
+        OPUS_PROFILE_ENTER( OPUS_PROFILE_PITCH );
         silk_find_pitch_lags_FLP( psEnc, &sEncCtrl, res_pitch, x_frame, psEnc->sCmn.arch );
+        OPUS_PROFILE_LEAVE( OPUS_PROFILE_PITCH );
 
         /************************/
         /* Noise shape analysis */
@@ -169,6 +175,8 @@ opus_int silk_encode_frame_FLP(
         gainMult_Q8 = SILK_FIX_CONST( 1, 8 );
         found_lower = 0;
         found_upper = 0;
+        gainMult_prev = 0;
+        nBits_prev = 0;
         gainsID = silk_gains_ID( psEnc->sCmn.indices.GainsIndices, psEnc->sCmn.nb_subfr );
         gainsID_lower = -1;
         gainsID_upper = -1;
@@ -179,6 +187,7 @@ opus_int silk_encode_frame_FLP(
         ec_prevLagIndex_copy = psEnc->sCmn.ec_prevLagIndex;
         ec_prevSignalType_copy = psEnc->sCmn.ec_prevSignalType;
         for( iter = 0; ; iter++ ) {
+            predict = 0;
             if( gainsID == gainsID_lower ) {
                 nBits = nBits_lower;
             } else if( gainsID == gainsID_upper ) {
@@ -198,6 +207,8 @@ opus_int silk_encode_frame_FLP(
                 /*****************************************/
                 silk_NSQ_wrapper_FLP( psEnc, &sEncCtrl, &psEnc->sCmn.indices, &psEnc->sCmn.sNSQ, psEnc->sCmn.pulses, x_frame );
 
+                psEnc->sCmn.nRatePasses++;
+
                 if ( iter == maxIter && !found_lower ) {
                     silk_memcpy( &sRangeEnc_copy2, psRangeEnc, sizeof( ec_enc ) );
                 }
@@ -210,10 +221,14 @@ opus_int silk_encode_frame_FLP(
                 /****************************************/
                 /* Encode Excitation Signal             */
                 /****************************************/
+                pulseBits = ec_tell( psRangeEnc );
                 silk_encode_pulses( psRangeEnc, psEnc->sCmn.indices.signalType, psEnc->sCmn.indices.quantOffsetType,
                       psEnc->sCmn.pulses, psEnc->sCmn.frame_length );
 
                 nBits = ec_tell( psRangeEnc );
+                pulseBits = nBits - pulseBits;
+                /* The pulses are those of the current gains, so they can predict the next ones */
+                predict = 1;
 
                 /* If we still bust after the last iteration, do some damage control. */
                 if ( iter == maxIter && !found_lower && nBits > maxBits ) {
@@ -291,7 +306,8 @@ opus_int silk_encode_frame_FLP(
                 break;
             }
 
-            if ( !found_lower && nBits > maxBits ) {
+            /* Only fresh pulses tell whether the current gains lowered the sums */
+            if ( !found_lower && nBits > maxBits && predict ) {
                 int j;
                 for ( i = 0; i < psEnc->sCmn.nb_subfr; i++ ) {
                     int sum=0;
@@ -307,22 +323,42 @@ opus_int silk_encode_frame_FLP(
                 }
             }
             if( ( found_lower & found_upper ) == 0 ) {
-                /* Adjust gain according to high-rate rate/distortion curve */
+                /* Predict the gain from the pulses just coded, aiming for the middle of the accepted range */
+                gainMult_pred = 0;
+                if( predict ) {
+                    gainMult_pred = silk_predict_gain_mult( psEnc->sCmn.pulses, psEnc->sCmn.frame_length, gainMult_Q8,
+                        nBits, pulseBits, maxBits - silk_RSHIFT( bits_margin, 1 ), gainMult_prev, nBits_prev );
+                    gainMult_prev = gainMult_Q8;
+                    nBits_prev = nBits;
+                }
                 if( nBits > maxBits ) {
-                    gainMult_Q8 = silk_min_32( 1024, gainMult_Q8*3/2 );
+                    if( gainMult_pred > gainMult_Q8 ) {
+                        gainMult_Q8 = gainMult_pred;
+                    } else {
+                        /* Adjust gain according to high-rate rate/distortion curve */
+                        gainMult_Q8 = silk_min_32( 1024, gainMult_Q8*3/2 );
+                    }
                 } else {
-                    gainMult_Q8 = silk_max_32( 64, gainMult_Q8*4/5 );
+                    if( gainMult_pred > 0 && gainMult_pred < gainMult_Q8 ) {
+                        gainMult_Q8 = gainMult_pred;
+                    } else {
+                        gainMult_Q8 = silk_max_32( 64, gainMult_Q8*4/5 );
+                    }
                 }
             } else {
-                /* Adjust gain by interpolating */
-                gainMult_Q8 = gainMult_lower + ( ( gainMult_upper - gainMult_lower ) * ( maxBits - nBits_lower ) ) / ( nBits_upper - nBits_lower );
-                /* New gain multplier must be between 25% and 75% of old range (note that gainMult_upper < gainMult_lower) */
-                if( gainMult_Q8 > silk_ADD_RSHIFT32( gainMult_lower, gainMult_upper - gainMult_lower, 2 ) ) {
-                    gainMult_Q8 = silk_ADD_RSHIFT32( gainMult_lower, gainMult_upper - gainMult_lower, 2 );
+                /* Adjust gain by interpolating the log gain, aiming for the middle of the accepted range */
+                opus_int32 log_lower_Q7, log_upper_Q7, log_Q7;
+                log_lower_Q7 = silk_lin2log( gainMult_lower );
+                log_upper_Q7 = silk_lin2log( gainMult_upper );
+                log_Q7 = log_lower_Q7 + ( ( log_upper_Q7 - log_lower_Q7 ) * ( maxBits - silk_RSHIFT( bits_margin, 1 ) - nBits_lower ) ) / ( nBits_upper - nBits_lower );
+                /* New log gain must be between 12.5% and 87.5% of old range (note that gainMult_upper < gainMult_lower) */
+                if( log_Q7 > silk_ADD_RSHIFT32( log_lower_Q7, log_upper_Q7 - log_lower_Q7, 3 ) ) {
+                    log_Q7 = silk_ADD_RSHIFT32( log_lower_Q7, log_upper_Q7 - log_lower_Q7, 3 );
                 } else
-                if( gainMult_Q8 < silk_SUB_RSHIFT32( gainMult_upper, gainMult_upper - gainMult_lower, 2 ) ) {
-                    gainMult_Q8 = silk_SUB_RSHIFT32( gainMult_upper, gainMult_upper - gainMult_lower, 2 );
+                if( log_Q7 < silk_SUB_RSHIFT32( log_upper_Q7, log_upper_Q7 - log_lower_Q7, 3 ) ) {
+                    log_Q7 = silk_SUB_RSHIFT32( log_upper_Q7, log_upper_Q7 - log_lower_Q7, 3 );
                 }
+                gainMult_Q8 = silk_log2lin( log_Q7 );
             }
 
             for( i = 0; i < psEnc->sCmn.nb_subfr; i++ ) {
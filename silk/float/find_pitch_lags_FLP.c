@@ -32,6 +32,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #include <stdlib.h>
 #include "main_FLP.h"
 #include "tuning_parameters.h"
+#include "pitch_est_defines.h"
 
 void silk_find_pitch_lags_FLP(
     silk_encoder_state_FLP          *psEnc,                             /* I/O  Encoder state FLP                           */
@@ -41,8 +42,8 @@ void silk_find_pitch_lags_FLP(
     int                             arch                                /* I    Run-time architecture                       */
 )
 {
-    opus_int   buf_len;
-    silk_float thrhld, res_nrg;
+    opus_int   buf_len, voicing;
+    silk_float thrhld, res_nrg, prevLTPCorr;
     const silk_float *x_buf_ptr, *x_buf;
     silk_float auto_corr[ MAX_FIND_PITCH_LPC_ORDER + 1 ];
     silk_float A[         MAX_FIND_PITCH_LPC_ORDER ];
@@ -102,7 +103,7 @@ void silk_find_pitch_lags_FLP(
     /*****************************************/
     /* LPC analysis filtering                */
     /*****************************************/
-    silk_LPC_analysis_filter_FLP( res, A, x_buf, buf_len, psEnc->sCmn.pitchEstimationLPCOrder );
+    silk_LPC_analysis_filter_FLP( res, A, x_buf, buf_len, psEnc->sCmn.pitchEstimationLPCOrder, arch );
 
     if( psEnc->sCmn.indices.signalType != TYPE_NO_VOICE_ACTIVITY && psEnc->sCmn.first_frame_after_reset == 0 ) {
         /* Threshold for pitch estimator */
@@ -115,9 +116,24 @@ void silk_find_pitch_lags_FLP(
         /*****************************************/
         /* Call Pitch estimator                  */
         /*****************************************/
-        if( silk_pitch_analysis_core_FLP( res, psEncCtrl->pitchL, &psEnc->sCmn.indices.lagIndex,
-            &psEnc->sCmn.indices.contourIndex, &psEnc->LTPCorr, psEnc->sCmn.prevLag, psEnc->sCmn.pitchEstimationThreshold_Q16 / 65536.0f,
-            thrhld, psEnc->sCmn.fs_kHz, psEnc->sCmn.pitchEstimationComplexity, psEnc->sCmn.nb_subfr, arch ) == 0 )
+        voicing = 1;
+        if( psEnc->sCmn.pitchTracking && psEnc->sCmn.prevSignalType == TYPE_VOICED && psEnc->sCmn.prevLag > 0 &&
+            psEnc->LTPCorr >= PE_TRACK_CORR_THRES ) {
+            /* Stationary voiced speech: first try to follow the previous lag */
+            prevLTPCorr = psEnc->LTPCorr;
+            voicing = silk_pitch_analysis_core_FLP( res, psEncCtrl->pitchL, &psEnc->sCmn.indices.lagIndex,
+                &psEnc->sCmn.indices.contourIndex, &psEnc->LTPCorr, psEnc->sCmn.prevLag, psEnc->sCmn.pitchEstimationThreshold_Q16 / 65536.0f,
+                thrhld, psEnc->sCmn.fs_kHz, psEnc->sCmn.pitchEstimationComplexity, psEnc->sCmn.nb_subfr, 1, arch );
+            if( voicing != 0 ) {
+                psEnc->LTPCorr = prevLTPCorr;
+            }
+        }
+        if( voicing != 0 ) {
+            voicing = silk_pitch_analysis_core_FLP( res, psEncCtrl->pitchL, &psEnc->sCmn.indices.lagIndex,
+                &psEnc->sCmn.indices.contourIndex, &psEnc->LTPCorr, psEnc->sCmn.prevLag, psEnc->sCmn.pitchEstimationThreshold_Q16 / 65536.0f,
+                thrhld, psEnc->sCmn.fs_kHz, psEnc->sCmn.pitchEstimationComplexity, psEnc->sCmn.nb_subfr, 0, arch );
+        }
+        if( voicing == 0 )
         {
             psEnc->sCmn.indices.signalType = TYPE_VOICED;
         } else {
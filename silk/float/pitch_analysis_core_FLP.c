@@ -76,10 +76,11 @@ opus_int silk_pitch_analysis_core_FLP(      /* O    Voicing estimate: 0 voiced,
     const opus_int      Fs_kHz,             /* I    sample frequency (kHz)                                      */
     const opus_int      complexity,         /* I    Complexity setting, 0-2, where 2 is highest                 */
     const opus_int      nb_subfr,           /* I    Number of 5 ms subframes                                    */
+    const opus_int      trackLag,           /* I    Only search around prevLag; unvoiced if it no longer fits   */
     int                 arch                /* I    Run-time architecture                                       */
 )
 {
-    opus_int   i, k, d, j;
+    opus_int   i, k, d, j, d_max;
     silk_float frame_8kHz[  PE_MAX_FRAME_LENGTH_MS * 8 ];
     silk_float frame_4kHz[  PE_MAX_FRAME_LENGTH_MS * 4 ];
     opus_int16 frame_8_FIX[ PE_MAX_FRAME_LENGTH_MS * 8 ];
@@ -87,7 +88,7 @@ opus_int silk_pitch_analysis_core_FLP(      /* O    Voicing estimate: 0 voiced,
     opus_int32 filt_state[ 6 ];
     silk_float threshold, contour_bias;
     silk_float C[ PE_MAX_NB_SUBFR][ (PE_MAX_LAG >> 1) + 5 ];
-    opus_val32 xcorr[ PE_MAX_LAG_MS * 4 - PE_MIN_LAG_MS * 4 + 1 ];
+    opus_val32 xcorr[ PE_MAX_LAG_MS * 8 - PE_MIN_LAG_MS * 8 + 4 ];
     silk_float CC[ PE_NB_CBKS_STAGE2_EXT ];
     const silk_float *target_ptr, *basis_ptr;
     double    cross_corr, normalizer, energy, energy_tmp;
@@ -100,6 +101,8 @@ opus_int silk_pitch_analysis_core_FLP(      /* O    Voicing estimate: 0 voiced,
     silk_float lag_log2, prevLag_log2, delta_lag_log2_sqr;
     silk_float energies_st3[ PE_MAX_NB_SUBFR ][ PE_NB_CBKS_STAGE3_MAX ][ PE_NB_STAGE3_LAGS ];
     silk_float cross_corr_st3[ PE_MAX_NB_SUBFR ][ PE_NB_CBKS_STAGE3_MAX ][ PE_NB_STAGE3_LAGS ];
+    double     cross_corr_sum[ PE_NB_CBKS_STAGE3_MAX ][ PE_NB_STAGE3_LAGS ];
+    double     energy_sum[ PE_NB_CBKS_STAGE3_MAX ][ PE_NB_STAGE3_LAGS ];
     opus_int   lag_counter;
     opus_int   frame_length, frame_length_8kHz, frame_length_4kHz;
     opus_int   sf_length, sf_length_8kHz, sf_length_4kHz;
@@ -152,93 +155,114 @@ opus_int silk_pitch_analysis_core_FLP(      /* O    Voicing estimate: 0 voiced,
         silk_float2short_array( frame_8_FIX, frame, frame_length_8kHz );
     }
 
-    /* Decimate again to 4 kHz */
-    silk_memset( filt_state, 0, 2 * sizeof( opus_int32 ) );
-    silk_resampler_down2( filt_state, frame_4_FIX, frame_8_FIX, frame_length_8kHz );
-    silk_short2float_array( frame_4kHz, frame_4_FIX, frame_length_4kHz );
-
-    /* Low-pass filter */
-    for( i = frame_length_4kHz - 1; i > 0; i-- ) {
-        frame_4kHz[ i ] = silk_ADD_SAT16( frame_4kHz[ i ], frame_4kHz[ i - 1 ] );
+    /* Previous lag at 8 kHz */
+    if( prevLag > 0 ) {
+        if( Fs_kHz == 12 ) {
+            prevLag = silk_LSHIFT( prevLag, 1 ) / 3;
+        } else if( Fs_kHz == 16 ) {
+            prevLag = silk_RSHIFT( prevLag, 1 );
+        }
+        prevLag_log2 = silk_log2( (silk_float)prevLag );
+    } else {
+        prevLag_log2 = 0;
     }
 
-    /******************************************************************************
-    * FIRST STAGE, operating in 4 khz
-    ******************************************************************************/
-    silk_memset(C, 0, sizeof(silk_float) * nb_subfr * ((PE_MAX_LAG >> 1) + 5));
-    target_ptr = &frame_4kHz[ silk_LSHIFT( sf_length_4kHz, 2 ) ];
-    for( k = 0; k < nb_subfr >> 1; k++ ) {
-        /* Check that we are within range of the array */
-        celt_assert( target_ptr >= frame_4kHz );
-        celt_assert( target_ptr + sf_length_8kHz <= frame_4kHz + frame_length_4kHz );
+    if( trackLag ) {
+        /* Stationary voiced speech: skip the first stage and only search around the previous lag */
+        celt_assert( prevLag > 0 );
+        prevLag = silk_LIMIT_int( prevLag, min_lag_8kHz + 1, max_lag_8kHz - 1 );
+        d_srch[ 0 ] = prevLag - 1;
+        d_srch[ 1 ] = prevLag + 1;
+        length_d_srch = 2;
+    } else {
+        /* Decimate again to 4 kHz */
+        silk_memset( filt_state, 0, 2 * sizeof( opus_int32 ) );
+        silk_resampler_down2( filt_state, frame_4_FIX, frame_8_FIX, frame_length_8kHz );
+        silk_short2float_array( frame_4kHz, frame_4_FIX, frame_length_4kHz );
 
-        basis_ptr = target_ptr - min_lag_4kHz;
+        /* Low-pass filter */
+        for( i = frame_length_4kHz - 1; i > 0; i-- ) {
+            frame_4kHz[ i ] = silk_ADD_SAT16( frame_4kHz[ i ], frame_4kHz[ i - 1 ] );
+        }
 
-        /* Check that we are within range of the array */
-        celt_assert( basis_ptr >= frame_4kHz );
-        celt_assert( basis_ptr + sf_length_8kHz <= frame_4kHz + frame_length_4kHz );
+        /******************************************************************************
+        * FIRST STAGE, operating in 4 khz
+        ******************************************************************************/
+        silk_memset(C, 0, sizeof(silk_float) * nb_subfr * ((PE_MAX_LAG >> 1) + 5));
+        target_ptr = &frame_4kHz[ silk_LSHIFT( sf_length_4kHz, 2 ) ];
+        for( k = 0; k < nb_subfr >> 1; k++ ) {
+            /* Check that we are within range of the array */
+            celt_assert( target_ptr >= frame_4kHz );
+            celt_assert( target_ptr + sf_length_8kHz <= frame_4kHz + frame_length_4kHz );
 
-        celt_pitch_xcorr( target_ptr, target_ptr-max_lag_4kHz, xcorr, sf_length_8kHz, max_lag_4kHz - min_lag_4kHz + 1, arch );
+            basis_ptr = target_ptr - min_lag_4kHz;
 
-        /* Calculate first vector products before loop */
-        cross_corr = xcorr[ max_lag_4kHz - min_lag_4kHz ];
-        normalizer = silk_energy_FLP( target_ptr, sf_length_8kHz ) +
-                     silk_energy_FLP( basis_ptr,  sf_length_8kHz ) +
-                     sf_length_8kHz * 4000.0f;
+            /* Check that we are within range of the array */
+            celt_assert( basis_ptr >= frame_4kHz );
+            celt_assert( basis_ptr + sf_length_8kHz <= frame_4kHz + frame_length_4kHz );
 
-        C[ 0 ][ min_lag_4kHz ] += (silk_float)( 2 * cross_corr / normalizer );
+            celt_pitch_xcorr( target_ptr, target_ptr-max_lag_4kHz, xcorr, sf_length_8kHz, max_lag_4kHz - min_lag_4kHz + 1, arch );
 
-        /* From now on normalizer is computed recursively */
-        for( d = min_lag_4kHz + 1; d <= max_lag_4kHz; d++ ) {
-            basis_ptr--;
+            /* Calculate first vector products before loop */
+            cross_corr = xcorr[ max_lag_4kHz - min_lag_4kHz ];
+            normalizer = silk_energy_FLP( target_ptr, sf_length_8kHz ) +
+                         silk_energy_FLP( basis_ptr,  sf_length_8kHz ) +
+                         sf_length_8kHz * 4000.0f;
 
-            /* Check that we are within range of the array */
-            silk_assert( basis_ptr >= frame_4kHz );
-            silk_assert( basis_ptr + sf_length_8kHz <= frame_4kHz + frame_length_4kHz );
+            C[ 0 ][ min_lag_4kHz ] += (silk_float)( 2 * cross_corr / normalizer );
 
-            cross_corr = xcorr[ max_lag_4kHz - d ];
+            /* From now on normalizer is computed recursively */
+            for( d = min_lag_4kHz + 1; d <= max_lag_4kHz; d++ ) {
+                basis_ptr--;
 
-            /* Add contribution of new sample and remove contribution from oldest sample */
-            normalizer +=
-                basis_ptr[ 0 ] * (double)basis_ptr[ 0 ] -
-                basis_ptr[ sf_length_8kHz ] * (double)basis_ptr[ sf_length_8kHz ];
-            C[ 0 ][ d ] += (silk_float)( 2 * cross_corr / normalizer );
-        }
-        /* Update target pointer */
-        target_ptr += sf_length_8kHz;
-    }
+                /* Check that we are within range of the array */
+                silk_assert( basis_ptr >= frame_4kHz );
+                silk_assert( basis_ptr + sf_length_8kHz <= frame_4kHz + frame_length_4kHz );
 
-    /* Apply short-lag bias */
-    for( i = max_lag_4kHz; i >= min_lag_4kHz; i-- ) {
-        C[ 0 ][ i ] -= C[ 0 ][ i ] * i / 4096.0f;
-    }
+                cross_corr = xcorr[ max_lag_4kHz - d ];
 
-    /* Sort */
-    length_d_srch = 4 + 2 * complexity;
-    celt_assert( 3 * length_d_srch <= PE_D_SRCH_LENGTH );
-    silk_insertion_sort_decreasing_FLP( &C[ 0 ][ min_lag_4kHz ], d_srch, max_lag_4kHz - min_lag_4kHz + 1, length_d_srch );
+                /* Add contribution of new sample and remove contribution from oldest sample */
+                normalizer +=
+                    basis_ptr[ 0 ] * (double)basis_ptr[ 0 ] -
+                    basis_ptr[ sf_length_8kHz ] * (double)basis_ptr[ sf_length_8kHz ];
+                C[ 0 ][ d ] += (silk_float)( 2 * cross_corr / normalizer );
+            }
+            /* Update target pointer */
+            target_ptr += sf_length_8kHz;
+        }
 
-    /* Escape if correlation is very low already here */
-    Cmax = C[ 0 ][ min_lag_4kHz ];
-    if( Cmax < 0.2f ) {
-        silk_memset( pitch_out, 0, nb_subfr * sizeof( opus_int ) );
-        *LTPCorr      = 0.0f;
-        *lagIndex     = 0;
-        *contourIndex = 0;
-        return 1;
-    }
+        /* Apply short-lag bias */
+        for( i = max_lag_4kHz; i >= min_lag_4kHz; i-- ) {
+            C[ 0 ][ i ] -= C[ 0 ][ i ] * i / 4096.0f;
+        }
 
-    threshold = search_thres1 * Cmax;
-    for( i = 0; i < length_d_srch; i++ ) {
-        /* Convert to 8 kHz indices for the sorted correlation that exceeds the threshold */
-        if( C[ 0 ][ min_lag_4kHz + i ] > threshold ) {
-            d_srch[ i ] = silk_LSHIFT( d_srch[ i ] + min_lag_4kHz, 1 );
-        } else {
-            length_d_srch = i;
-            break;
+        /* Sort */
+        length_d_srch = 4 + 2 * complexity;
+        celt_assert( 3 * length_d_srch <= PE_D_SRCH_LENGTH );
+        silk_insertion_sort_decreasing_FLP( &C[ 0 ][ min_lag_4kHz ], d_srch, max_lag_4kHz - min_lag_4kHz + 1, length_d_srch );
+
+        /* Escape if correlation is very low already here */
+        Cmax = C[ 0 ][ min_lag_4kHz ];
+        if( Cmax < 0.2f ) {
+            silk_memset( pitch_out, 0, nb_subfr * sizeof( opus_int ) );
+            *LTPCorr      = 0.0f;
+            *lagIndex     = 0;
+            *contourIndex = 0;
+            return 1;
         }
+
+        threshold = search_thres1 * Cmax;
+        for( i = 0; i < length_d_srch; i++ ) {
+            /* Convert to 8 kHz indices for the sorted correlation that exceeds the threshold */
+            if( C[ 0 ][ min_lag_4kHz + i ] > threshold ) {
+                d_srch[ i ] = silk_LSHIFT( d_srch[ i ] + min_lag_4kHz, 1 );
+            } else {
+                length_d_srch = i;
+                break;
+            }
+        }
+        celt_assert( length_d_srch > 0 );
     }
-    celt_assert( length_d_srch > 0 );
 
     for( i = min_lag_8kHz - 5; i < max_lag_8kHz + 5; i++ ) {
         d_comp[ i ] = 0;
@@ -288,15 +312,29 @@ opus_int silk_pitch_analysis_core_FLP(      /* O    Voicing estimate: 0 voiced,
     }
     for( k = 0; k < nb_subfr; k++ ) {
         energy_tmp = silk_energy_FLP( target_ptr, sf_length_8kHz ) + 1.0;
-        for( j = 0; j < length_d_comp; j++ ) {
-            d = d_comp[ j ];
-            basis_ptr = target_ptr - d;
-            cross_corr = silk_inner_product_FLP( basis_ptr, target_ptr, sf_length_8kHz, arch );
-            if( cross_corr > 0.0f ) {
-                energy = silk_energy_FLP( basis_ptr, sf_length_8kHz );
-                C[ k ][ d ] = (silk_float)( 2 * cross_corr / ( energy + energy_tmp ) );
-            } else {
-                C[ k ][ d ] = 0.0f;
+        for( j = 0; j < length_d_comp; j = i ) {
+            /* Correlate each run of consecutive lags in one go */
+            for( i = j + 1; i < length_d_comp && d_comp[ i ] == d_comp[ i - 1 ] + 1; i++ ) {
+            }
+            d_max = d_comp[ i - 1 ];
+            celt_pitch_xcorr( target_ptr, target_ptr - d_max, xcorr, sf_length_8kHz, d_max - d_comp[ j ] + 1, arch );
+
+            basis_ptr = target_ptr - d_comp[ j ];
+            energy = silk_energy_FLP( basis_ptr, sf_length_8kHz );
+            for( d = d_comp[ j ]; d <= d_max; d++ ) {
+                if( d > d_comp[ j ] ) {
+                    /* Energy is computed recursively along the run */
+                    basis_ptr--;
+                    energy +=
+                        basis_ptr[ 0 ] * (double)basis_ptr[ 0 ] -
+                        basis_ptr[ sf_length_8kHz ] * (double)basis_ptr[ sf_length_8kHz ];
+                }
+                cross_corr = xcorr[ d_max - d ];
+                if( cross_corr > 0.0f ) {
+                    C[ k ][ d ] = (silk_float)( 2 * cross_corr / ( energy + energy_tmp ) );
+                } else {
+                    C[ k ][ d ] = 0.0f;
+                }
             }
         }
         target_ptr += sf_length_8kHz;
@@ -311,17 +349,6 @@ opus_int silk_pitch_analysis_core_FLP(      /* O    Voicing estimate: 0 voiced,
     CBimax = 0; /* To avoid returning undefined lag values */
     lag = -1;   /* To check if lag with strong enough correlation has been found */
 
-    if( prevLag > 0 ) {
-        if( Fs_kHz == 12 ) {
-            prevLag = silk_LSHIFT( prevLag, 1 ) / 3;
-        } else if( Fs_kHz == 16 ) {
-            prevLag = silk_RSHIFT( prevLag, 1 );
-        }
-        prevLag_log2 = silk_log2( (silk_float)prevLag );
-    } else {
-        prevLag_log2 = 0;
-    }
-
     /* Set up stage 2 codebook based on number of subframes */
     if( nb_subfr == PE_MAX_NB_SUBFR ) {
         cbk_size   = PE_NB_CBKS_STAGE2_EXT;
@@ -378,8 +405,8 @@ opus_int silk_pitch_analysis_core_FLP(      /* O    Voicing estimate: 0 voiced,
         }
     }
 
-    if( lag == -1 ) {
-        /* No suitable candidate found */
+    if( lag == -1 || ( trackLag && CCmax < nb_subfr * PE_TRACK_CORR_THRES ) ) {
+        /* No suitable candidate found, or the previous lag is no longer a safe bet */
         silk_memset( pitch_out, 0, PE_MAX_NB_SUBFR * sizeof(opus_int) );
         *LTPCorr      = 0.0f;
         *lagIndex     = 0;
@@ -431,14 +458,27 @@ opus_int silk_pitch_analysis_core_FLP(      /* O    Voicing estimate: 0 voiced,
 
         target_ptr = &frame[ PE_LTP_MEM_LENGTH_MS * Fs_kHz ];
         energy_tmp = silk_energy_FLP( target_ptr, nb_subfr * sf_length ) + 1.0;
-        for( d = start_lag; d <= end_lag; d++ ) {
+
+        /* Sum over the subframes for all codebook vectors and lags at once */
+        for( j = 0; j < nb_cbk_search; j++ ) {
+            for( i = 0; i < PE_NB_STAGE3_LAGS; i++ ) {
+                cross_corr_sum[ j ][ i ] = 0.0;
+                energy_sum[ j ][ i ]     = energy_tmp;
+            }
+        }
+        for( k = 0; k < nb_subfr; k++ ) {
             for( j = 0; j < nb_cbk_search; j++ ) {
-                cross_corr = 0.0;
-                energy = energy_tmp;
-                for( k = 0; k < nb_subfr; k++ ) {
-                    cross_corr += cross_corr_st3[ k ][ j ][ lag_counter ];
-                    energy     +=   energies_st3[ k ][ j ][ lag_counter ];
+                for( i = 0; i < PE_NB_STAGE3_LAGS; i++ ) {
+                    cross_corr_sum[ j ][ i ] += cross_corr_st3[ k ][ j ][ i ];
+                    energy_sum[ j ][ i ]     +=   energies_st3[ k ][ j ][ i ];
                 }
+            }
+        }
+
+        for( d = start_lag; d <= end_lag; d++ ) {
+            for( j = 0; j < nb_cbk_search; j++ ) {
+                cross_corr = cross_corr_sum[ j ][ lag_counter ];
+                energy     = energy_sum[ j ][ lag_counter ];
                 if( cross_corr > 0.0 ) {
                     CCmax_new = (silk_float)( 2 * cross_corr / energy );
                     /* Reduce depending on flatness of contour */
@@ -30,6 +30,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 #include "main_FLP.h"
+#include "profile.h"
 
 /* Wrappers. Calls flp / fix code */
 
@@ -160,6 +161,7 @@ void silk_NSQ_wrapper_FLP(
     }
 
     /* Call NSQ */
+    OPUS_PROFILE_ENTER( OPUS_PROFILE_SILK_NSQ );
     if( psEnc->sCmn.nStatesDelayedDecision > 1 || psEnc->sCmn.warping_Q16 > 0 ) {
         silk_NSQ_del_dec( &psEnc->sCmn, psNSQ, psIndices, x16, pulses, PredCoef_Q12[ 0 ], LTPCoef_Q14,
             AR_Q13, HarmShapeGain_Q14, Tilt_Q14, LF_shp_Q14, Gains_Q16, psEncCtrl->pitchL, Lambda_Q10, LTP_scale_Q14, psEnc->sCmn.arch );
@@ -167,6 +169,7 @@ void silk_NSQ_wrapper_FLP(
         silk_NSQ( &psEnc->sCmn, psNSQ, psIndices, x16, pulses, PredCoef_Q12[ 0 ], LTPCoef_Q14,
             AR_Q13, HarmShapeGain_Q14, Tilt_Q14, LF_shp_Q14, Gains_Q16, psEncCtrl->pitchL, Lambda_Q10, LTP_scale_Q14, psEnc->sCmn.arch );
     }
+    OPUS_PROFILE_LEAVE( OPUS_PROFILE_SILK_NSQ );
 }
 
 /***********************************************/
@@ -0,0 +1,97 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+#include "main_FLP.h"
+
+/************************************************/
+/* LPC analysis filter                          */
+/* NB! State is kept internally and the         */
+/* filter always starts with zero state         */
+/* first Order output samples are set to zero   */
+/************************************************/
+void silk_LPC_analysis_filter_FLP_avx2(
+    silk_float                      r_LPC[],                            /* O    LPC residual signal                         */
+    const silk_float                PredCoef[],                         /* I    LPC coefficients                            */
+    const silk_float                s[],                                /* I    Input signal                                */
+    const opus_int                  length,                             /* I    Length of input signal                      */
+    const opus_int                  Order                               /* I    LPC order                                   */
+)
+{
+    opus_int   ix, k;
+    silk_float LPC_pred;
+    const silk_float *s_ptr;
+
+    celt_assert( Order <= length );
+    celt_assert( ( Order & 1 ) == 0 );
+
+    /* Sixteen output samples at a time, sharing each coefficient broadcast between two vectors */
+    for( ix = Order; ix < length - 15; ix += 16 ) {
+        __m256 pred0, pred1, pred2, pred3, c;
+        s_ptr = &s[ ix - 1 ];
+        pred0 = pred1 = pred2 = pred3 = _mm256_setzero_ps();
+        for( k = 0; k < Order; k += 2 ) {
+            c     = _mm256_set1_ps( PredCoef[ k ] );
+            pred0 = _mm256_fmadd_ps( c, _mm256_loadu_ps( &s_ptr[ -k ] ),     pred0 );
+            pred1 = _mm256_fmadd_ps( c, _mm256_loadu_ps( &s_ptr[ 8 - k ] ),  pred1 );
+            c     = _mm256_set1_ps( PredCoef[ k + 1 ] );
+            pred2 = _mm256_fmadd_ps( c, _mm256_loadu_ps( &s_ptr[ -k - 1 ] ), pred2 );
+            pred3 = _mm256_fmadd_ps( c, _mm256_loadu_ps( &s_ptr[ 7 - k ] ),  pred3 );
+        }
+        /* prediction error */
+        _mm256_storeu_ps( &r_LPC[ ix ],     _mm256_sub_ps( _mm256_loadu_ps( &s[ ix ] ),     _mm256_add_ps( pred0, pred2 ) ) );
+        _mm256_storeu_ps( &r_LPC[ ix + 8 ], _mm256_sub_ps( _mm256_loadu_ps( &s[ ix + 8 ] ), _mm256_add_ps( pred1, pred3 ) ) );
+    }
+    if( ix < length - 7 ) {
+        __m256 pred0, pred2;
+        s_ptr = &s[ ix - 1 ];
+        pred0 = pred2 = _mm256_setzero_ps();
+        for( k = 0; k < Order; k += 2 ) {
+            pred0 = _mm256_fmadd_ps( _mm256_set1_ps( PredCoef[ k ] ),     _mm256_loadu_ps( &s_ptr[ -k ] ),     pred0 );
+            pred2 = _mm256_fmadd_ps( _mm256_set1_ps( PredCoef[ k + 1 ] ), _mm256_loadu_ps( &s_ptr[ -k - 1 ] ), pred2 );
+        }
+        /* prediction error */
+        _mm256_storeu_ps( &r_LPC[ ix ], _mm256_sub_ps( _mm256_loadu_ps( &s[ ix ] ), _mm256_add_ps( pred0, pred2 ) ) );
+        ix += 8;
+    }
+    for( ; ix < length; ix++ ) {
+        s_ptr = &s[ ix - 1 ];
+        LPC_pred = 0;
+        for( k = 0; k < Order; k++ ) {
+            LPC_pred += s_ptr[ -k ] * PredCoef[ k ];
+        }
+        /* prediction error */
+        r_LPC[ ix ] = s_ptr[ 1 ] - LPC_pred;
+    }
+
+    /* Set first Order output samples to zero */
+    silk_memset( r_LPC, 0, Order * sizeof( silk_float ) );
+}
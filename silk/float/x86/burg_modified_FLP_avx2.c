@@ -0,0 +1,261 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+#include "SigProc_FLP.h"
+#include "tuning_parameters.h"
+#include "define.h"
+
+#define MAX_FRAME_SIZE              384 /* subfr_length * nb_subfr = ( 0.005 * 16000 + 16 ) * 4 = 384*/
+
+static OPUS_INLINE double silk_hsum_pd( __m256d x )
+{
+    __m128d s = _mm_add_pd( _mm256_castpd256_pd128( x ), _mm256_extractf128_pd( x, 1 ) );
+    return _mm_cvtsd_f64( _mm_add_sd( s, _mm_unpackhi_pd( s, s ) ) );
+}
+
+static OPUS_INLINE double silk_inner_product_pd( const double *a, const double *b, opus_int len )
+{
+    opus_int i;
+    double   sum;
+    __m256d  acc0, acc1;
+
+    acc0 = acc1 = _mm256_setzero_pd();
+    for( i = 0; i < len - 7; i += 8 ) {
+        acc0 = _mm256_fmadd_pd( _mm256_loadu_pd( &a[ i ] ),     _mm256_loadu_pd( &b[ i ] ),     acc0 );
+        acc1 = _mm256_fmadd_pd( _mm256_loadu_pd( &a[ i + 4 ] ), _mm256_loadu_pd( &b[ i + 4 ] ), acc1 );
+    }
+    for( ; i < len - 3; i += 4 ) {
+        acc0 = _mm256_fmadd_pd( _mm256_loadu_pd( &a[ i ] ), _mm256_loadu_pd( &b[ i ] ), acc0 );
+    }
+    sum = silk_hsum_pd( _mm256_add_pd( acc0, acc1 ) );
+    for( ; i < len; i++ ) {
+        sum += a[ i ] * b[ i ];
+    }
+    return sum;
+}
+
+/* Compute reflection coefficients from input signal */
+/* Same algorithm as silk_burg_modified_FLP_c(). Each subframe is kept in double precision in both time */
+/* directions, so that the row and C * A updates, which walk the signal backwards, become forward loads. */
+silk_float silk_burg_modified_FLP_avx2(     /* O    returns residual energy                                     */
+    silk_float          A[],                /* O    prediction coefficients (length order)                      */
+    const silk_float    x[],                /* I    input signal, length: nb_subfr*(D+L_sub)                    */
+    const silk_float    minInvGain,         /* I    minimum inverse prediction gain                             */
+    const opus_int      subfr_length,       /* I    input signal subframe length (incl. D preceding samples)    */
+    const opus_int      nb_subfr,           /* I    number of subframes stacked in x                            */
+    const opus_int      D,                  /* I    order                                                       */
+    int                 arch
+)
+{
+    opus_int         k, n, s, reached_max_gain;
+    double           C0, invGain, num, nrg_f, nrg_b, rc, Atmp, tmp1, tmp2;
+    const double     *f, *r;
+    double           xf[ MAX_FRAME_SIZE ], xr[ MAX_FRAME_SIZE ];
+    double           C_first_row[ SILK_MAX_ORDER_LPC ], C_last_row[ SILK_MAX_ORDER_LPC ];
+    double           CAf[ SILK_MAX_ORDER_LPC + 1 ], CAb[ SILK_MAX_ORDER_LPC + 1 ];
+    double           Af[ SILK_MAX_ORDER_LPC ];
+    const __m256i    lanes = _mm256_setr_epi64x( 0, 1, 2, 3 );
+
+    (void)arch;
+    celt_assert( subfr_length * nb_subfr <= MAX_FRAME_SIZE );
+
+    /* Forward and time reversed copies of each subframe */
+    for( s = 0; s < nb_subfr; s++ ) {
+        for( k = 0; k < subfr_length; k++ ) {
+            xf[ s * subfr_length + k ] = x[ s * subfr_length + k ];
+            xr[ s * subfr_length + k ] = x[ s * subfr_length + subfr_length - k - 1 ];
+        }
+    }
+
+    /* Compute autocorrelations, added over subframes */
+    C0 = silk_inner_product_pd( xf, xf, nb_subfr * subfr_length );
+    silk_memset( C_first_row, 0, SILK_MAX_ORDER_LPC * sizeof( double ) );
+    for( s = 0; s < nb_subfr; s++ ) {
+        f = &xf[ s * subfr_length ];
+        for( n = 1; n < D + 1; n++ ) {
+            C_first_row[ n - 1 ] += silk_inner_product_pd( f, f + n, subfr_length - n );
+        }
+    }
+    silk_memcpy( C_last_row, C_first_row, SILK_MAX_ORDER_LPC * sizeof( double ) );
+
+    /* Initialize */
+    CAb[ 0 ] = CAf[ 0 ] = C0 + FIND_LPC_COND_FAC * C0 + 1e-9f;
+    invGain = 1.0f;
+    reached_max_gain = 0;
+    for( n = 0; n < D; n++ ) {
+        /* Masks for the last partial vector of the n and n + 1 long loops below */
+        const __m256i mask0 = _mm256_cmpgt_epi64( _mm256_set1_epi64x( n & 3 ), lanes );
+        const __m256i mask1 = _mm256_cmpgt_epi64( _mm256_set1_epi64x( ( n + 1 ) & 3 ), lanes );
+        /* Update first row of correlation matrix (without first element) */
+        /* Update last row of correlation matrix (without last element, stored in reversed order) */
+        /* Update C * Af */
+        /* Update C * flipud(Af) (stored in reversed order) */
+        for( s = 0; s < nb_subfr; s++ ) {
+            __m256d xn, xe, a, vr, vf, t1, t2;
+            const double *pr, *pf;
+            f = &xf[ s * subfr_length ];
+            r = &xr[ s * subfr_length ];
+            /* x_ptr[ n - k - 1 ] == pr[ k ], x_ptr[ subfr_length - n + k ] == pf[ k ] */
+            pr = &r[ subfr_length - n ];
+            pf = &f[ subfr_length - n ];
+            xn = _mm256_set1_pd( f[ n ] );
+            xe = _mm256_set1_pd( f[ subfr_length - n - 1 ] );
+            t1 = t2 = _mm256_setzero_pd();
+            for( k = 0; k < n - 3; k += 4 ) {
+                a  = _mm256_loadu_pd( &Af[ k ] );
+                vr = _mm256_loadu_pd( &pr[ k ] );
+                vf = _mm256_loadu_pd( &pf[ k ] );
+                _mm256_storeu_pd( &C_first_row[ k ], _mm256_fnmadd_pd( xn, vr, _mm256_loadu_pd( &C_first_row[ k ] ) ) );
+                _mm256_storeu_pd( &C_last_row[ k ],  _mm256_fnmadd_pd( xe, vf, _mm256_loadu_pd( &C_last_row[ k ] ) ) );
+                t1 = _mm256_fmadd_pd( vr, a, t1 );
+                t2 = _mm256_fmadd_pd( vf, a, t2 );
+            }
+            if( k < n ) {
+                a  = _mm256_maskload_pd( &Af[ k ], mask0 );
+                vr = _mm256_maskload_pd( &pr[ k ], mask0 );
+                vf = _mm256_maskload_pd( &pf[ k ], mask0 );
+                _mm256_maskstore_pd( &C_first_row[ k ], mask0, _mm256_fnmadd_pd( xn, vr, _mm256_maskload_pd( &C_first_row[ k ], mask0 ) ) );
+                _mm256_maskstore_pd( &C_last_row[ k ],  mask0, _mm256_fnmadd_pd( xe, vf, _mm256_maskload_pd( &C_last_row[ k ], mask0 ) ) );
+                t1 = _mm256_fmadd_pd( vr, a, t1 );
+                t2 = _mm256_fmadd_pd( vf, a, t2 );
+            }
+            tmp1 = f[ n ] + silk_hsum_pd( t1 );
+            tmp2 = f[ subfr_length - n - 1 ] + silk_hsum_pd( t2 );
+
+            /* x_ptr[ n - k ] == pr[ k ], x_ptr[ subfr_length - n + k - 1 ] == pf[ k ] */
+            pr = &r[ subfr_length - n - 1 ];
+            pf = &f[ subfr_length - n - 1 ];
+            t1 = _mm256_set1_pd( tmp1 );
+            t2 = _mm256_set1_pd( tmp2 );
+            for( k = 0; k < n - 2; k += 4 ) {
+                _mm256_storeu_pd( &CAf[ k ], _mm256_fnmadd_pd( t1, _mm256_loadu_pd( &pr[ k ] ), _mm256_loadu_pd( &CAf[ k ] ) ) );
+                _mm256_storeu_pd( &CAb[ k ], _mm256_fnmadd_pd( t2, _mm256_loadu_pd( &pf[ k ] ), _mm256_loadu_pd( &CAb[ k ] ) ) );
+            }
+            if( k <= n ) {
+                _mm256_maskstore_pd( &CAf[ k ], mask1, _mm256_fnmadd_pd( t1, _mm256_maskload_pd( &pr[ k ], mask1 ), _mm256_maskload_pd( &CAf[ k ], mask1 ) ) );
+                _mm256_maskstore_pd( &CAb[ k ], mask1, _mm256_fnmadd_pd( t2, _mm256_maskload_pd( &pf[ k ], mask1 ), _mm256_maskload_pd( &CAb[ k ], mask1 ) ) );
+            }
+        }
+        tmp1 = C_first_row[ n ];
+        tmp2 = C_last_row[ n ];
+        for( k = 0; k < n; k++ ) {
+            Atmp = Af[ k ];
+            tmp1 += C_last_row[  n - k - 1 ] * Atmp;
+            tmp2 += C_first_row[ n - k - 1 ] * Atmp;
+        }
+        CAf[ n + 1 ] = tmp1;
+        CAb[ n + 1 ] = tmp2;
+
+        /* Calculate nominator and denominator for the next order reflection (parcor) coefficient */
+        num = CAb[ n + 1 ];
+        nrg_b = CAb[ 0 ];
+        nrg_f = CAf[ 0 ];
+        for( k = 0; k < n; k++ ) {
+            Atmp = Af[ k ];
+            num   += CAb[ n - k ] * Atmp;
+            nrg_b += CAb[ k + 1 ] * Atmp;
+            nrg_f += CAf[ k + 1 ] * Atmp;
+        }
+        silk_assert( nrg_f > 0.0 );
+        silk_assert( nrg_b > 0.0 );
+
+        /* Calculate the next order reflection (parcor) coefficient */
+        rc = -2.0 * num / ( nrg_f + nrg_b );
+        silk_assert( rc > -1.0 && rc < 1.0 );
+
+        /* Update inverse prediction gain */
+        tmp1 = invGain * ( 1.0 - rc * rc );
+        if( tmp1 <= minInvGain ) {
+            /* Max prediction gain exceeded; set reflection coefficient such that max prediction gain is exactly hit */
+            rc = sqrt( 1.0 - minInvGain / invGain );
+            if( num > 0 ) {
+                /* Ensure adjusted reflection coefficients has the original sign */
+                rc = -rc;
+            }
+            invGain = minInvGain;
+            reached_max_gain = 1;
+        } else {
+            invGain = tmp1;
+        }
+
+        /* Update the AR coefficients */
+        for( k = 0; k < (n + 1) >> 1; k++ ) {
+            tmp1 = Af[ k ];
+            tmp2 = Af[ n - k - 1 ];
+            Af[ k ]         = tmp1 + rc * tmp2;
+            Af[ n - k - 1 ] = tmp2 + rc * tmp1;
+        }
+        Af[ n ] = rc;
+
+        if( reached_max_gain ) {
+            /* Reached max prediction gain; set remaining coefficients to zero and exit loop */
+            for( k = n + 1; k < D; k++ ) {
+                Af[ k ] = 0.0;
+            }
+            break;
+        }
+
+        /* Update C * Af and C * Ab */
+        for( k = 0; k <= n + 1; k++ ) {
+            tmp1 = CAf[ k ];
+            CAf[ k ]          += rc * CAb[ n - k + 1 ];
+            CAb[ n - k + 1  ] += rc * tmp1;
+        }
+    }
+
+    if( reached_max_gain ) {
+        /* Convert to silk_float */
+        for( k = 0; k < D; k++ ) {
+            A[ k ] = (silk_float)( -Af[ k ] );
+        }
+        /* Subtract energy of preceding samples from C0 */
+        for( s = 0; s < nb_subfr; s++ ) {
+            C0 -= silk_inner_product_pd( &xf[ s * subfr_length ], &xf[ s * subfr_length ], D );
+        }
+        /* Approximate residual energy */
+        nrg_f = C0 * invGain;
+    } else {
+        /* Compute residual energy and store coefficients as silk_float */
+        nrg_f = CAf[ 0 ];
+        tmp1 = 1.0;
+        for( k = 0; k < D; k++ ) {
+            Atmp = Af[ k ];
+            nrg_f += CAf[ k + 1 ] * Atmp;
+            tmp1  += Atmp * Atmp;
+            A[ k ] = (silk_float)(-Atmp);
+        }
+        nrg_f -= FIND_LPC_COND_FAC * C0 * tmp1;
+    }
+
+    /* Return residual energy */
+    return (silk_float)nrg_f;
+}
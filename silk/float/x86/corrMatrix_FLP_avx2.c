@@ -0,0 +1,142 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+/**********************************************************************
+ * Correlation matrix computations for LS estimate.
+ **********************************************************************/
+
+#include <immintrin.h>
+#include "main_FLP.h"
+
+static OPUS_INLINE double silk_hsum_pd( __m256d x )
+{
+    __m128d s = _mm_add_pd( _mm256_castpd256_pd128( x ), _mm256_extractf128_pd( x, 1 ) );
+    return _mm_cvtsd_f64( _mm_add_sd( s, _mm_unpackhi_pd( s, s ) ) );
+}
+
+/* Computes ref'*( ptr - lag ) for lag = 0 .. LTP_ORDER - 1 in a single pass over ref */
+static OPUS_INLINE void silk_xcorr_LTP_avx2(
+    const silk_float                *ptr,
+    const silk_float                *ref,
+    const opus_int                  L,
+    double                          out[ LTP_ORDER ]
+)
+{
+    opus_int i, lag;
+    __m256d  acc[ LTP_ORDER ];
+
+    for( lag = 0; lag < LTP_ORDER; lag++ ) {
+        acc[ lag ] = _mm256_setzero_pd();
+    }
+    for( i = 0; i < L - 3; i += 4 ) {
+        __m256d r = _mm256_cvtps_pd( _mm_loadu_ps( &ref[ i ] ) );
+        for( lag = 0; lag < LTP_ORDER; lag++ ) {
+            acc[ lag ] = _mm256_fmadd_pd( r, _mm256_cvtps_pd( _mm_loadu_ps( &ptr[ i - lag ] ) ), acc[ lag ] );
+        }
+    }
+    for( lag = 0; lag < LTP_ORDER; lag++ ) {
+        out[ lag ] = silk_hsum_pd( acc[ lag ] );
+    }
+    for( ; i < L; i++ ) {
+        for( lag = 0; lag < LTP_ORDER; lag++ ) {
+            out[ lag ] += ref[ i ] * (double)ptr[ i - lag ];
+        }
+    }
+}
+
+/* Calculates correlation vector X'*t */
+void silk_corrVector_FLP_avx2(
+    const silk_float                *x,                                 /* I    x vector [L+order-1] used to create X       */
+    const silk_float                *t,                                 /* I    Target vector [L]                           */
+    const opus_int                  L,                                  /* I    Length of vecors                            */
+    const opus_int                  Order,                              /* I    Max lag for correlation                     */
+    silk_float                      *Xt,                                /* O    X'*t correlation vector [order]             */
+    int                             arch
+)
+{
+    opus_int lag;
+    double   xt[ LTP_ORDER ];
+
+    if( Order != LTP_ORDER ) {
+        silk_corrVector_FLP_c( x, t, L, Order, Xt, arch );
+        return;
+    }
+    /* Column lag of X starts at x[ Order - 1 - lag ] */
+    silk_xcorr_LTP_avx2( &x[ Order - 1 ], t, L, xt );
+    for( lag = 0; lag < Order; lag++ ) {
+        Xt[ lag ] = (silk_float)xt[ lag ];
+    }
+}
+
+/* Calculates correlation matrix X'*X */
+void silk_corrMatrix_FLP_avx2(
+    const silk_float                *x,                                 /* I    x vector [ L+order-1 ] used to create X     */
+    const opus_int                  L,                                  /* I    Length of vectors                           */
+    const opus_int                  Order,                              /* I    Max lag for correlation                     */
+    silk_float                      *XX,                                /* O    X'*X correlation matrix [order x order]     */
+    int                             arch
+)
+{
+    opus_int j, lag;
+    double   energy, xx[ LTP_ORDER ];
+    const silk_float *ptr1, *ptr2;
+
+    if( Order != LTP_ORDER ) {
+        silk_corrMatrix_FLP_c( x, L, Order, XX, arch );
+        return;
+    }
+    /* First row of X'*X, i.e. X[:,0]'*X[:,lag] for all lags */
+    ptr1 = &x[ Order - 1 ];                     /* First sample of column 0 of X */
+    silk_xcorr_LTP_avx2( ptr1, ptr1, L, xx );
+
+    energy = xx[ 0 ];
+    matrix_ptr( XX, 0, 0, Order ) = ( silk_float )energy;
+    for( j = 1; j < Order; j++ ) {
+        /* Calculate X[:,j]'*X[:,j] */
+        energy += ptr1[ -j ] * ptr1[ -j ] - ptr1[ L - j ] * ptr1[ L - j ];
+        matrix_ptr( XX, j, j, Order ) = ( silk_float )energy;
+    }
+
+    ptr2 = &x[ Order - 2 ];                     /* First sample of column 1 of X */
+    for( lag = 1; lag < Order; lag++ ) {
+        /* X[:,0]'*X[:,lag] */
+        energy = xx[ lag ];
+        matrix_ptr( XX, lag, 0, Order ) = ( silk_float )energy;
+        matrix_ptr( XX, 0, lag, Order ) = ( silk_float )energy;
+        /* Calculate X[:,j]'*X[:,j + lag] */
+        for( j = 1; j < ( Order - lag ); j++ ) {
+            energy += ptr1[ -j ] * ptr2[ -j ] - ptr1[ L - j ] * ptr2[ L - j ];
+            matrix_ptr( XX, lag + j, j, Order ) = ( silk_float )energy;
+            matrix_ptr( XX, j, lag + j, Order ) = ( silk_float )energy;
+        }
+        ptr2--;                                 /* Next column of X */
+    }
+}
@@ -0,0 +1,109 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+#include "main_FLP.h"
+
+/* Autocorrelations for a warped frequency axis */
+/* The allpass chain is evaluated as a wavefront: section i works on sample n - i, so that each step   */
+/* only depends on the two previous steps and all sections are updated in parallel. The sections are   */
+/* stored in reverse order, four per vector, which makes the input samples they need a plain load.     */
+void silk_warped_autocorrelation_FLP_avx2(
+    silk_float                      *corr,                              /* O    Result [order + 1]                          */
+    const silk_float                *input,                             /* I    Input data to correlate                     */
+    const silk_float                warping,                            /* I    Warping coefficient                         */
+    const opus_int                  length,                             /* I    Length of input                             */
+    const opus_int                  order                               /* I    Correlation order (even)                    */
+)
+{
+    opus_int    n, i, q, nv, L;
+    double      x_buf[ MAX_SHAPE_LPC_ORDER + SHAPE_LPC_WIN_MAX + MAX_SHAPE_LPC_ORDER ];
+    double      C[ MAX_SHAPE_LPC_ORDER ];
+    double      C0;
+    double      *x;
+    __m256d     state[ MAX_SHAPE_LPC_ORDER / 4 ], prev[ MAX_SHAPE_LPC_ORDER / 4 ], acc[ MAX_SHAPE_LPC_ORDER / 4 ];
+    __m256d     w, e;
+
+    /* Order must be even */
+    celt_assert( ( order & 1 ) == 0 );
+    celt_assert( order <= MAX_SHAPE_LPC_ORDER && length <= SHAPE_LPC_WIN_MAX );
+
+    /* Zero padded copy of the input, so the first and last samples of the wavefront need no special casing */
+    x = x_buf + MAX_SHAPE_LPC_ORDER;
+    for( i = 0; i < MAX_SHAPE_LPC_ORDER; i++ ) {
+        x_buf[ i ] = 0;
+        x[ length + i ] = 0;
+    }
+    e = _mm256_setzero_pd();
+    for( n = 0; n < length - 3; n += 4 ) {
+        __m256d xd = _mm256_cvtps_pd( _mm_loadu_ps( &input[ n ] ) );
+        _mm256_storeu_pd( &x[ n ], xd );
+        e = _mm256_fmadd_pd( xd, xd, e );
+    }
+    e = _mm256_add_pd( e, _mm256_permute2f128_pd( e, e, 1 ) );
+    e = _mm256_hadd_pd( e, e );
+    C0 = _mm256_cvtsd_f64( e );
+    for( ; n < length; n++ ) {
+        x[ n ] = input[ n ];
+        C0 += x[ n ] * x[ n ];
+    }
+
+    /* Lane j of vector q holds allpass section L - 4 * q - j */
+    nv = ( order + 3 ) >> 2;
+    L = nv << 2;
+    w = _mm256_set1_pd( warping );
+    for( q = 0; q < nv; q++ ) {
+        state[ q ] = prev[ q ] = acc[ q ] = _mm256_setzero_pd();
+    }
+    for( n = 0; n < length + order - 1; n++ ) {
+        const double *x_ptr = &x[ n - L + 1 ];
+        for( q = 0; q < nv; q++ ) {
+            __m256d next, shifted, tmp;
+            /* Input of each section, i.e. the previous section shifted in by one lane */
+            next = q + 1 < nv ? state[ q + 1 ] : _mm256_set1_pd( x[ n ] );
+            shifted = _mm256_shuffle_pd( state[ q ], _mm256_permute2f128_pd( state[ q ], next, 0x21 ), 0x5 );
+            /* Two multiplies rather than a factored expression, to keep the shift off the critical path */
+            tmp = _mm256_fnmadd_pd( w, shifted, _mm256_fmadd_pd( w, state[ q ], prev[ q ] ) );
+            prev[ q ] = shifted;
+            state[ q ] = tmp;
+            acc[ q ] = _mm256_fmadd_pd( _mm256_loadu_pd( &x_ptr[ 4 * q ] ), tmp, acc[ q ] );
+        }
+    }
+    for( q = 0; q < nv; q++ ) {
+        _mm256_storeu_pd( &C[ 4 * q ], acc[ q ] );
+    }
+
+    /* Copy correlations in silk_float output format */
+    corr[ 0 ] = ( silk_float )C0;
+    for( i = 1; i < order + 1; i++ ) {
+        corr[ i ] = ( silk_float )C[ L - i ];
+    }
+}
@@ -44,6 +44,8 @@ POSSIBILITY OF SUCH DAMAGE.
 
 #if (defined(OPUS_ARM_ASM) || defined(OPUS_ARM_MAY_HAVE_NEON_INTR))
 #include "arm/NSQ_del_dec_arm.h"
+#include "arm/decode_core_arm.h"
+#include "arm/NLSF_encode_arm.h"
 #endif
 
 /* Convert Left/Right stereo signal to adaptive Mid/Side representation */
@@ -198,6 +200,18 @@ opus_int32 silk_gains_ID(                                       /* O    returns
     const opus_int              nb_subfr                        /* I    number of subframes                         */
 );
 
+/* Predict the gain multiplier that makes a frame cost targetBits */
+opus_int32 silk_predict_gain_mult(                              /* O    predicted gain multiplier (Q8), or 0        */
+    const opus_int8             pulses[],                       /* I    pulses of the last quantization             */
+    const opus_int              frame_length,                   /* I    frame length                                */
+    const opus_int32            gainMult_Q8,                    /* I    gain multiplier of the last quantization    */
+    const opus_int32            nBits,                          /* I    bits used by the last quantization          */
+    const opus_int32            pulseBits,                      /* I    part of nBits spent on the pulses           */
+    const opus_int32            targetBits,                     /* I    bits to aim for                             */
+    const opus_int32            prevGainMult_Q8,                /* I    gain multiplier of an earlier one, or 0     */
+    const opus_int32            prevNBits                       /* I    bits used by the earlier quantization       */
+);
+
 /* Interpolate two vectors */
 void silk_interpolate(
     opus_int16                  xi[ MAX_LPC_ORDER ],            /* O    interpolated vector                         */
@@ -342,11 +356,12 @@ opus_int32 silk_NLSF_encode(                                    /* O    Returns
     const opus_int16            *pW_QW,                         /* I    NLSF weight vector [ LPC_ORDER ]            */
     const opus_int              NLSF_mu_Q20,                    /* I    Rate weight for the RD optimization         */
     const opus_int              nSurvivors,                     /* I    Max survivors after first stage             */
-    const opus_int              signalType                      /* I    Signal type: 0/1/2                          */
+    const opus_int              signalType,                     /* I    Signal type: 0/1/2                          */
+    int                         arch                            /* I    Run-time architecture                       */
 );
 
 /* Compute quantization errors for an LPC_order element input vector for a VQ codebook */
-void silk_NLSF_VQ(
+void silk_NLSF_VQ_c(
     opus_int32                  err_Q26[],                      /* O    Quantization errors [K]                     */
     const opus_int16            in_Q15[],                       /* I    Input vectors to be quantized [LPC_order]   */
     const opus_uint8            pCB_Q8[],                       /* I    Codebook vectors [K*LPC_order]              */
@@ -355,8 +370,13 @@ void silk_NLSF_VQ(
     const opus_int              LPC_order                       /* I    Number of LPCs                              */
 );
 
+#if !defined(OVERRIDE_silk_NLSF_VQ)
+#define silk_NLSF_VQ(err_Q24, in_Q15, pCB_Q8, pWght_Q9, K, LPC_order, arch) \
+    ((void)(arch), silk_NLSF_VQ_c(err_Q24, in_Q15, pCB_Q8, pWght_Q9, K, LPC_order))
+#endif
+
 /* Delayed-decision quantizer for NLSF residuals */
-opus_int32 silk_NLSF_del_dec_quant(                             /* O    Returns RD value in Q25                     */
+opus_int32 silk_NLSF_del_dec_quant_c(                           /* O    Returns RD value in Q25                     */
     opus_int8                   indices[],                      /* O    Quantization indices [ order ]              */
     const opus_int16            x_Q10[],                        /* I    Input [ order ]                             */
     const opus_int16            w_Q5[],                         /* I    Weights [ order ]                           */
@@ -369,6 +389,13 @@ opus_int32 silk_NLSF_del_dec_quant(                             /* O    Returns
     const opus_int16            order                           /* I    Number of input values                      */
 );
 
+#if !defined(OVERRIDE_silk_NLSF_del_dec_quant)
+#define silk_NLSF_del_dec_quant(indices, x_Q10, w_Q5, pred_coef_Q8, ec_ix, ec_rates_Q5, quant_step_size_Q16, \
+                                inv_quant_step_size_Q6, mu_Q20, order, arch) \
+    ((void)(arch), silk_NLSF_del_dec_quant_c(indices, x_Q10, w_Q5, pred_coef_Q8, ec_ix, ec_rates_Q5, \
+                                             quant_step_size_Q16, inv_quant_step_size_Q6, mu_Q20, order))
+#endif
+
 /* Unpack predictor values and indices for entropy coding tables */
 void silk_NLSF_unpack(
           opus_int16            ec_ix[],                        /* O    Indices to entropy tables [ LPC_ORDER ]     */
@@ -418,7 +445,7 @@ opus_int silk_decode_frame(
     LPCNetPLCState              *lpcnet,
 #endif
 #ifdef ENABLE_OSCE
-    OSCEModel                   *osce_model,
+    const OSCEModel             *osce_model,
 #endif
     int                         arch                            /* I    Run-time architecture                       */
 );
@@ -448,6 +475,36 @@ void silk_decode_core(
     int                         arch                            /* I    Run-time architecture                       */
 );
 
+/* LTP synthesis of one subframe; the new LTP state starts at sLTP_Q15[ 0 ] */
+void silk_LTP_synthesis_c(
+    opus_int32                  pres_Q14[],                     /* O    LPC excitation [ length ]                   */
+    opus_int32                  sLTP_Q15[],                     /* I/O  LTP state, new samples from sLTP_Q15[ 0 ]   */
+    const opus_int32            exc_Q14[],                      /* I    Excitation [ length ]                       */
+    const opus_int16            B_Q14[ LTP_ORDER ],             /* I    LTP coefficients                            */
+    const opus_int              lag,                            /* I    Pitch lag                                   */
+    const opus_int              length                          /* I    Subframe length                             */
+);
+
+#if !defined(OVERRIDE_silk_LTP_synthesis)
+#define silk_LTP_synthesis(pres_Q14, sLTP_Q15, exc_Q14, B_Q14, lag, length, arch) \
+    ((void)(arch), silk_LTP_synthesis_c(pres_Q14, sLTP_Q15, exc_Q14, B_Q14, lag, length))
+#endif
+
+/* LPC synthesis filter; sLPC_Q14 holds MAX_LPC_ORDER samples of state followed by the output */
+/* pres_Q14 may point to sLPC_Q14 + MAX_LPC_ORDER to filter in place                         */
+void silk_LPC_synthesis_c(
+    opus_int32                  sLPC_Q14[],                     /* I/O  State [ MAX_LPC_ORDER ], then output        */
+    const opus_int32            pres_Q14[],                     /* I    LPC excitation [ length ]                   */
+    const opus_int16            A_Q12[],                        /* I    Prediction coefficients [ order ]           */
+    const opus_int              order,                          /* I    Prediction order, 10 or 16                  */
+    const opus_int              length                          /* I    Signal length                               */
+);
+
+#if !defined(OVERRIDE_silk_LPC_synthesis)
+#define silk_LPC_synthesis(sLPC_Q14, pres_Q14, A_Q12, order, length, arch) \
+    ((void)(arch), silk_LPC_synthesis_c(sLPC_Q14, pres_Q14, A_Q12, order, length))
+#endif
+
 /* Decode quantization indices of excitation (Shell coding) */
 void silk_decode_pulses(
     ec_dec                      *psRangeDec,                    /* I/O  Compressor data structure                   */
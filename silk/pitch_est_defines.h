@@ -68,6 +68,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #define PE_SHORTLAG_BIAS            0.2f    /* for logarithmic weighting    */
 #define PE_PREVLAG_BIAS             0.2f    /* for logarithmic weighting    */
 #define PE_FLATCONTOUR_BIAS         0.05f
+#define PE_TRACK_CORR_THRES         0.8f    /* min. normalized correlation to keep tracking the previous lag */
 
 #define SILK_PE_MIN_COMPLEX         0
 #define SILK_PE_MID_COMPLEX         1
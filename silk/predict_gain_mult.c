@@ -0,0 +1,144 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "main.h"
+
+#define MIN_GAIN_MULT_Q8        64
+#define MAX_GAIN_MULT_Q8        1024
+/* Fraction (Q8) of the model's log-gain step to take. The model ignores the  */
+/* rate/distortion tradeoff of the quantizer and underestimates how many bits */
+/* a gain change moves, so its steps are shortened.                           */
+#define GAIN_STEP_DAMPING_Q8    192
+
+/* Estimated bits (Q7) to code the pulses of a shell block whose absolute  */
+/* values sum to sum_abs, after scaling the gains by gainMult_Q8 / new_Q8. */
+/* Models the pulses as geometrically distributed with the block's mean,   */
+/* plus one sign bit per non-zero pulse.                                   */
+static opus_int32 silk_block_bits_Q7(
+    opus_int32                  sum_abs,                        /* I    sum of absolute pulses in block             */
+    opus_int32                  gainMult_Q8,                    /* I    gain multiplier of the pulses               */
+    opus_int32                  new_Q8                          /* I    gain multiplier to estimate for             */
+)
+{
+    opus_int32 mean_Q8, log_1p_Q7, log_Q7, entropy_Q7, sign_Q7;
+
+    /* Mean absolute pulse, in Q8 */
+    mean_Q8 = silk_DIV32( silk_MUL( sum_abs, gainMult_Q8 ) << ( 8 - LOG2_SHELL_CODEC_FRAME_LENGTH ), new_Q8 );
+    if( mean_Q8 <= 0 ) {
+        return 0;
+    }
+    /* Entropy of a geometric distribution with mean a: (1 + a) * log2(1 + a) - a * log2(a) */
+    log_1p_Q7 = silk_lin2log( mean_Q8 + 256 ) - ( 8 << 7 );
+    log_Q7    = silk_lin2log( mean_Q8 ) - ( 8 << 7 );
+    entropy_Q7 = (opus_int32)silk_RSHIFT64( silk_SMULL( mean_Q8 + 256, log_1p_Q7 ) - silk_SMULL( mean_Q8, log_Q7 ), 8 );
+    /* Probability of a non-zero pulse: a / (1 + a) */
+    sign_Q7 = silk_DIV32( silk_LSHIFT( mean_Q8, 7 ), mean_Q8 + 256 );
+    return silk_LSHIFT( entropy_Q7 + sign_Q7, LOG2_SHELL_CODEC_FRAME_LENGTH );
+}
+
+static opus_int32 silk_pulses_bits_Q7(
+    const opus_int32            sum_abs[],                      /* I    sum of absolute pulses per shell block      */
+    const opus_int              nBlocks,                        /* I    number of shell blocks                      */
+    opus_int32                  gainMult_Q8,                    /* I    gain multiplier of the pulses               */
+    opus_int32                  new_Q8                          /* I    gain multiplier to estimate for             */
+)
+{
+    opus_int   i;
+    opus_int32 bits_Q7 = 0;
+    for( i = 0; i < nBlocks; i++ ) {
+        bits_Q7 += silk_block_bits_Q7( sum_abs[ i ], gainMult_Q8, new_Q8 );
+    }
+    return bits_Q7;
+}
+
+/* Predicts the gain multiplier that makes a frame cost targetBits, from one  */
+/* quantization of that frame. The bits spent on the pulses are assumed to    */
+/* follow silk_pulses_bits_Q7(), scaled to match the bits actually spent, and */
+/* the other bits are assumed not to depend on the gains. When an earlier     */
+/* quantization is given, the bits are instead extrapolated through both, as  */
+/* a linear function of the log gain. With CBR, the accepted range of bits    */
+/* is narrower than what one gain quantization step moves, so the rate loop   */
+/* still needs a few passes to land in it; this saves the bracketing ones.    */
+opus_int32 silk_predict_gain_mult(                              /* O    predicted gain multiplier (Q8), or 0        */
+    const opus_int8             pulses[],                       /* I    pulses of the last quantization             */
+    const opus_int              frame_length,                   /* I    frame length                                */
+    const opus_int32            gainMult_Q8,                    /* I    gain multiplier of the last quantization    */
+    const opus_int32            nBits,                          /* I    bits used by the last quantization          */
+    const opus_int32            pulseBits,                      /* I    part of nBits spent on the pulses           */
+    const opus_int32            targetBits,                     /* I    bits to aim for                             */
+    const opus_int32            prevGainMult_Q8,                /* I    gain multiplier of an earlier one, or 0     */
+    const opus_int32            prevNBits                       /* I    bits used by the earlier quantization       */
+)
+{
+    opus_int   i, j, nBlocks;
+    opus_int32 sum_abs[ MAX_NB_SHELL_BLOCKS ];
+    opus_int32 ref_Q7, target_pulse_bits, lo_Q8, hi_Q8, mid_Q8, log_Q7, prev_log_Q7;
+
+    log_Q7 = silk_lin2log( gainMult_Q8 );
+    if( prevGainMult_Q8 > 0 ) {
+        prev_log_Q7 = silk_lin2log( prevGainMult_Q8 );
+        /* Only a secant along which higher gains cost fewer bits is of use */
+        if( silk_SMULL( prev_log_Q7 - log_Q7, prevNBits - nBits ) < 0 ) {
+            log_Q7 += silk_DIV32( silk_MUL( targetBits - nBits, log_Q7 - prev_log_Q7 ), nBits - prevNBits );
+            return silk_LIMIT_32( silk_log2lin( log_Q7 ), MIN_GAIN_MULT_Q8, MAX_GAIN_MULT_Q8 );
+        }
+    }
+
+    nBlocks = silk_RSHIFT( frame_length + SHELL_CODEC_FRAME_LENGTH - 1, LOG2_SHELL_CODEC_FRAME_LENGTH );
+    for( i = 0; i < nBlocks; i++ ) {
+        sum_abs[ i ] = 0;
+        for( j = i * SHELL_CODEC_FRAME_LENGTH; j < silk_min_int( ( i + 1 ) * SHELL_CODEC_FRAME_LENGTH, frame_length ); j++ ) {
+            sum_abs[ i ] += silk_abs( pulses[ j ] );
+        }
+    }
+    ref_Q7 = silk_pulses_bits_Q7( sum_abs, nBlocks, gainMult_Q8, gainMult_Q8 );
+    target_pulse_bits = targetBits - ( nBits - pulseBits );
+    if( ref_Q7 <= 0 || pulseBits <= 0 || target_pulse_bits <= 0 ) {
+        /* Nothing to scale, or the target cannot be reached by changing the gains */
+        return 0;
+    }
+
+    /* Smallest multiplier whose estimate fits: pulseBits * bits(m) / bits(gainMult) <= target_pulse_bits */
+    lo_Q8 = MIN_GAIN_MULT_Q8;
+    hi_Q8 = MAX_GAIN_MULT_Q8;
+    if( silk_SMULL( pulseBits, silk_pulses_bits_Q7( sum_abs, nBlocks, gainMult_Q8, lo_Q8 ) ) <= silk_SMULL( target_pulse_bits, ref_Q7 ) ) {
+        hi_Q8 = lo_Q8;
+    }
+    while( hi_Q8 - lo_Q8 > 1 ) {
+        mid_Q8 = silk_RSHIFT( lo_Q8 + hi_Q8, 1 );
+        if( silk_SMULL( pulseBits, silk_pulses_bits_Q7( sum_abs, nBlocks, gainMult_Q8, mid_Q8 ) ) <= silk_SMULL( target_pulse_bits, ref_Q7 ) ) {
+            hi_Q8 = mid_Q8;
+        } else {
+            lo_Q8 = mid_Q8;
+        }
+    }
+    log_Q7 += silk_RSHIFT( silk_MUL( silk_lin2log( hi_Q8 ) - log_Q7, GAIN_STEP_DAMPING_Q8 ), 8 );
+    return silk_LIMIT_32( silk_log2lin( log_Q7 ), MIN_GAIN_MULT_Q8, MAX_GAIN_MULT_Q8 );
+}
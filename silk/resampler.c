@@ -48,6 +48,7 @@ POSSIBILITY OF SUCH DAMAGE.
  */
 
 #include "resampler_private.h"
+#include "profile.h"
 
 /* Tables with delay compensation values to equalize total delay for different modes */
 static const opus_int8 delay_matrix_enc[ 5 ][ 3 ] = {
@@ -175,7 +176,8 @@ opus_int silk_resampler(
     silk_resampler_state_struct *S,                 /* I/O  Resampler state                                             */
     opus_int16                  out[],              /* O    Output signal                                               */
     const opus_int16            in[],               /* I    Input signal                                                */
-    opus_int32                  inLen               /* I    Number of input samples                                     */
+    opus_int32                  inLen,              /* I    Number of input samples                                     */
+    int                         arch                /* I    Run-time architecture                                       */
 )
 {
     opus_int nSamples;
@@ -185,6 +187,7 @@ opus_int silk_resampler(
     /* Delay can't exceed the 1 ms of buffering */
     celt_assert( S->inputDelay <= S->Fs_in_kHz );
 
+    OPUS_PROFILE_ENTER( OPUS_PROFILE_RESAMPLER );
     nSamples = S->Fs_in_kHz - S->inputDelay;
 
     /* Copy to delay buffer */
@@ -196,12 +199,12 @@ opus_int silk_resampler(
             silk_resampler_private_up2_HQ_wrapper( S, &out[ S->Fs_out_kHz ], &in[ nSamples ], inLen - S->Fs_in_kHz );
             break;
         case USE_silk_resampler_private_IIR_FIR:
-            silk_resampler_private_IIR_FIR( S, out, S->delayBuf, S->Fs_in_kHz );
-            silk_resampler_private_IIR_FIR( S, &out[ S->Fs_out_kHz ], &in[ nSamples ], inLen - S->Fs_in_kHz );
+            silk_resampler_private_IIR_FIR( S, out, S->delayBuf, S->Fs_in_kHz, arch );
+            silk_resampler_private_IIR_FIR( S, &out[ S->Fs_out_kHz ], &in[ nSamples ], inLen - S->Fs_in_kHz, arch );
             break;
         case USE_silk_resampler_private_down_FIR:
-            silk_resampler_private_down_FIR( S, out, S->delayBuf, S->Fs_in_kHz );
-            silk_resampler_private_down_FIR( S, &out[ S->Fs_out_kHz ], &in[ nSamples ], inLen - S->Fs_in_kHz );
+            silk_resampler_private_down_FIR( S, out, S->delayBuf, S->Fs_in_kHz, arch );
+            silk_resampler_private_down_FIR( S, &out[ S->Fs_out_kHz ], &in[ nSamples ], inLen - S->Fs_in_kHz, arch );
             break;
         default:
             silk_memcpy( out, S->delayBuf, S->Fs_in_kHz * sizeof( opus_int16 ) );
@@ -210,6 +213,7 @@ opus_int silk_resampler(
 
     /* Copy to delay buffer */
     silk_memcpy( S->delayBuf, &in[ inLen - S->inputDelay ], S->inputDelay * sizeof( opus_int16 ) );
+    OPUS_PROFILE_LEAVE( OPUS_PROFILE_RESAMPLER );
 
     return 0;
 }
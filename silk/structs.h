@@ -185,6 +185,7 @@ typedef struct {
     opus_int                     shapingLPCOrder;                   /* Filter order for noise shaping filters                           */
     opus_int                     predictLPCOrder;                   /* Filter order for prediction filters                              */
     opus_int                     pitchEstimationComplexity;         /* Complexity level for pitch estimator                             */
+    opus_int                     pitchTracking;                     /* Flag for searching around the previous lag first                 */
     opus_int                     pitchEstimationLPCOrder;           /* Whitening filter order for pitch estimator                       */
     opus_int32                   pitchEstimationThreshold_Q16;      /* Threshold for pitch estimator                                    */
     opus_int32                   sum_log_gain_Q7;                   /* Cumulative max prediction gain                                   */
@@ -226,6 +227,7 @@ typedef struct {
     /* Specifically for entropy coding */
     opus_int                     ec_prevSignalType;
     opus_int16                   ec_prevLagIndex;
+    opus_int                     nRatePasses;                       /* Quantization passes the rate control used for the last frame     */
 
     silk_resampler_state_struct resampler_state;
 
@@ -0,0 +1,129 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+#include "main.h"
+#include "celt/x86/x86cpu.h"
+
+/* Two 128-bit loads into the low and high lanes */
+#define SILK_LOADU_X2( a, b ) \
+    _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( (__m128i *)(void *)( a ) ) ), \
+                             _mm_loadu_si128( (__m128i *)(void *)( b ) ), 1 )
+
+/* Codebook entries 8 and up, for LPC orders 10 and 16; the unused lanes have zero weight */
+static OPUS_INLINE __m128i silk_NLSF_VQ_cb_hi( const opus_uint8 *pCB_Q8, opus_int LPC_order )
+{
+    if( LPC_order == 16 ) {
+        return _mm_cvtepu8_epi16( _mm_loadl_epi64( (__m128i *)(void *)&pCB_Q8[ 8 ] ) );
+    }
+    return _mm_cvtsi32_si128( pCB_Q8[ 8 ] | ( (opus_int32)pCB_Q8[ 9 ] << 16 ) );
+}
+
+static OPUS_INLINE __m128i silk_NLSF_VQ_w_hi( const opus_int16 *pWght_Q9, opus_int LPC_order )
+{
+    if( LPC_order == 16 ) {
+        return _mm_loadu_si128( (__m128i *)(void *)&pWght_Q9[ 8 ] );
+    }
+    return _mm_cvtsi32_si128( (opus_uint16)pWght_Q9[ 8 ] | ( (opus_int32)pWght_Q9[ 9 ] << 16 ) );
+}
+
+/* Weighted absolute predictive errors of codebook vectors a and b, summed into four */
+/* lanes of the low and high half respectively                                        */
+static OPUS_INLINE __m256i silk_NLSF_VQ_err_x2( __m256i in_lo, __m256i in_hi, const opus_uint8 *cb_a,
+    const opus_int16 *w_a, const opus_uint8 *cb_b, const opus_int16 *w_b, opus_int LPC_order )
+{
+    __m256i cb, w, diff, lo, hi, d0, d1, d2, d3, sum;
+
+    /* The 16-bit differences wrap the same way silk_SMULBB() truncates them */
+    cb   = _mm256_cvtepu8_epi16( _mm_unpacklo_epi64( _mm_loadl_epi64( (__m128i *)(void *)cb_a ),
+                                                     _mm_loadl_epi64( (__m128i *)(void *)cb_b ) ) );
+    w    = SILK_LOADU_X2( w_a, w_b );
+    diff = _mm256_sub_epi16( in_lo, _mm256_slli_epi16( cb, 7 ) );
+    lo   = _mm256_mullo_epi16( diff, w );
+    hi   = _mm256_mulhi_epi16( diff, w );
+    d0   = _mm256_unpacklo_epi16( lo, hi );
+    d1   = _mm256_unpackhi_epi16( lo, hi );
+    cb   = _mm256_inserti128_si256( _mm256_castsi128_si256( silk_NLSF_VQ_cb_hi( cb_a, LPC_order ) ),
+                                    silk_NLSF_VQ_cb_hi( cb_b, LPC_order ), 1 );
+    w    = _mm256_inserti128_si256( _mm256_castsi128_si256( silk_NLSF_VQ_w_hi( w_a, LPC_order ) ),
+                                    silk_NLSF_VQ_w_hi( w_b, LPC_order ), 1 );
+    diff = _mm256_sub_epi16( in_hi, _mm256_slli_epi16( cb, 7 ) );
+    lo   = _mm256_mullo_epi16( diff, w );
+    hi   = _mm256_mulhi_epi16( diff, w );
+    d2   = _mm256_unpacklo_epi16( lo, hi );
+    d3   = _mm256_unpackhi_epi16( lo, hi );
+
+    /* Element m is predicted from half of element m + 1, and the last one from zero */
+    sum = _mm256_abs_epi32( _mm256_sub_epi32( d0, _mm256_srai_epi32( _mm256_alignr_epi8( d1, d0, 4 ), 1 ) ) );
+    sum = _mm256_add_epi32( sum, _mm256_abs_epi32( _mm256_sub_epi32( d1, _mm256_srai_epi32( _mm256_alignr_epi8( d2, d1, 4 ), 1 ) ) ) );
+    sum = _mm256_add_epi32( sum, _mm256_abs_epi32( _mm256_sub_epi32( d2, _mm256_srai_epi32( _mm256_alignr_epi8( d3, d2, 4 ), 1 ) ) ) );
+    sum = _mm256_add_epi32( sum, _mm256_abs_epi32( _mm256_sub_epi32( d3, _mm256_srai_epi32( _mm256_srli_si256( d3, 4 ), 1 ) ) ) );
+    return sum;
+}
+
+void silk_NLSF_VQ_avx2(
+    opus_int32                  err_Q24[],                      /* O    Quantization errors [K]                     */
+    const opus_int16            in_Q15[],                       /* I    Input vectors to be quantized [LPC_order]   */
+    const opus_uint8            pCB_Q8[],                       /* I    Codebook vectors [K*LPC_order]              */
+    const opus_int16            pWght_Q9[],                     /* I    Codebook weights [K*LPC_order]              */
+    const opus_int              K,                              /* I    Number of codebook vectors                  */
+    const opus_int              LPC_order                       /* I    Number of LPCs                              */
+)
+{
+    opus_int i, k;
+    __m128i  in_hi;
+    __m256i  in_lo_x2, in_hi_x2, s[ 4 ];
+
+    celt_assert( LPC_order == 10 || LPC_order == 16 );
+
+    in_lo_x2 = _mm256_broadcastsi128_si256( _mm_loadu_si128( (__m128i *)(void *)&in_Q15[ 0 ] ) );
+    if( LPC_order == 16 ) {
+        in_hi = _mm_loadu_si128( (__m128i *)(void *)&in_Q15[ 8 ] );
+    } else {
+        in_hi = _mm_cvtsi32_si128( (opus_uint16)in_Q15[ 8 ] | ( (opus_int32)in_Q15[ 9 ] << 16 ) );
+    }
+    in_hi_x2 = _mm256_broadcastsi128_si256( in_hi );
+
+    /* Eight codebook vectors at a time: vectors i + k and i + k + 4 share a register, */
+    /* so two rounds of horizontal adds leave the errors in order                      */
+    for( i = 0; i < K - 7; i += 8 ) {
+        for( k = 0; k < 4; k++ ) {
+            s[ k ] = silk_NLSF_VQ_err_x2( in_lo_x2, in_hi_x2,
+                &pCB_Q8[ ( i + k ) * LPC_order ], &pWght_Q9[ ( i + k ) * LPC_order ],
+                &pCB_Q8[ ( i + k + 4 ) * LPC_order ], &pWght_Q9[ ( i + k + 4 ) * LPC_order ], LPC_order );
+        }
+        s[ 0 ] = _mm256_hadd_epi32( _mm256_hadd_epi32( s[ 0 ], s[ 1 ] ), _mm256_hadd_epi32( s[ 2 ], s[ 3 ] ) );
+        _mm256_storeu_si256( (__m256i *)(void *)&err_Q24[ i ], s[ 0 ] );
+    }
+    if( i < K ) {
+        silk_NLSF_VQ_c( &err_Q24[ i ], in_Q15, &pCB_Q8[ i * LPC_order ], &pWght_Q9[ i * LPC_order ], K - i, LPC_order );
+    }
+}
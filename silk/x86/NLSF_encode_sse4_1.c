@@ -0,0 +1,311 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <smmintrin.h>
+#include "main.h"
+#include "celt/x86/x86cpu.h"
+
+#ifdef _MSC_VER
+#include <intsafe.h>
+static inline int __builtin_ctz(unsigned int x)
+{
+    DWORD res = 0;
+    return _BitScanForward(&res, x) ? res : 32;
+}
+#endif
+
+/* Codebook entries 8 and up, for LPC orders 10 and 16; the unused lanes have zero weight */
+static OPUS_INLINE void silk_NLSF_VQ_load_hi( __m128i *cb, __m128i *w, const opus_uint8 *pCB_Q8,
+    const opus_int16 *pWght_Q9, opus_int LPC_order )
+{
+    if( LPC_order == 16 ) {
+        *cb = _mm_cvtepu8_epi16( _mm_loadl_epi64( (__m128i *)(void *)&pCB_Q8[ 8 ] ) );
+        *w  = _mm_loadu_si128( (__m128i *)(void *)&pWght_Q9[ 8 ] );
+    } else {
+        *cb = _mm_cvtsi32_si128( pCB_Q8[ 8 ] | ( (opus_int32)pCB_Q8[ 9 ] << 16 ) );
+        *w  = _mm_cvtsi32_si128( (opus_uint16)pWght_Q9[ 8 ] | ( (opus_int32)pWght_Q9[ 9 ] << 16 ) );
+    }
+}
+
+/* Weighted absolute predictive errors of one codebook vector, summed into four lanes */
+static OPUS_INLINE __m128i silk_NLSF_VQ_err( __m128i in_lo, __m128i in_hi, const opus_uint8 *pCB_Q8,
+    const opus_int16 *pWght_Q9, opus_int LPC_order )
+{
+    __m128i cb, w, diff, lo, hi, d0, d1, d2, d3, sum;
+
+    /* The 16-bit differences wrap the same way silk_SMULBB() truncates them */
+    cb   = _mm_cvtepu8_epi16( _mm_loadl_epi64( (__m128i *)(void *)pCB_Q8 ) );
+    w    = _mm_loadu_si128( (__m128i *)(void *)pWght_Q9 );
+    diff = _mm_sub_epi16( in_lo, _mm_slli_epi16( cb, 7 ) );
+    lo   = _mm_mullo_epi16( diff, w );
+    hi   = _mm_mulhi_epi16( diff, w );
+    d0   = _mm_unpacklo_epi16( lo, hi );
+    d1   = _mm_unpackhi_epi16( lo, hi );
+    silk_NLSF_VQ_load_hi( &cb, &w, pCB_Q8, pWght_Q9, LPC_order );
+    diff = _mm_sub_epi16( in_hi, _mm_slli_epi16( cb, 7 ) );
+    lo   = _mm_mullo_epi16( diff, w );
+    hi   = _mm_mulhi_epi16( diff, w );
+    d2   = _mm_unpacklo_epi16( lo, hi );
+    d3   = _mm_unpackhi_epi16( lo, hi );
+
+    /* Element m is predicted from half of element m + 1, and the last one from zero */
+    sum = _mm_abs_epi32( _mm_sub_epi32( d0, _mm_srai_epi32( _mm_alignr_epi8( d1, d0, 4 ), 1 ) ) );
+    sum = _mm_add_epi32( sum, _mm_abs_epi32( _mm_sub_epi32( d1, _mm_srai_epi32( _mm_alignr_epi8( d2, d1, 4 ), 1 ) ) ) );
+    sum = _mm_add_epi32( sum, _mm_abs_epi32( _mm_sub_epi32( d2, _mm_srai_epi32( _mm_alignr_epi8( d3, d2, 4 ), 1 ) ) ) );
+    sum = _mm_add_epi32( sum, _mm_abs_epi32( _mm_sub_epi32( d3, _mm_srai_epi32( _mm_srli_si128( d3, 4 ), 1 ) ) ) );
+    return sum;
+}
+
+void silk_NLSF_VQ_sse4_1(
+    opus_int32                  err_Q24[],                      /* O    Quantization errors [K]                     */
+    const opus_int16            in_Q15[],                       /* I    Input vectors to be quantized [LPC_order]   */
+    const opus_uint8            pCB_Q8[],                       /* I    Codebook vectors [K*LPC_order]              */
+    const opus_int16            pWght_Q9[],                     /* I    Codebook weights [K*LPC_order]              */
+    const opus_int              K,                              /* I    Number of codebook vectors                  */
+    const opus_int              LPC_order                       /* I    Number of LPCs                              */
+)
+{
+    opus_int i;
+    __m128i  in_lo, in_hi, s0, s1, s2, s3;
+
+    celt_assert( LPC_order == 10 || LPC_order == 16 );
+
+    in_lo = _mm_loadu_si128( (__m128i *)(void *)&in_Q15[ 0 ] );
+    if( LPC_order == 16 ) {
+        in_hi = _mm_loadu_si128( (__m128i *)(void *)&in_Q15[ 8 ] );
+    } else {
+        in_hi = _mm_cvtsi32_si128( (opus_uint16)in_Q15[ 8 ] | ( (opus_int32)in_Q15[ 9 ] << 16 ) );
+    }
+
+    /* Four codebook vectors at a time, reduced with two rounds of horizontal adds */
+    for( i = 0; i < K - 3; i += 4 ) {
+        s0 = silk_NLSF_VQ_err( in_lo, in_hi, &pCB_Q8[ ( i + 0 ) * LPC_order ], &pWght_Q9[ ( i + 0 ) * LPC_order ], LPC_order );
+        s1 = silk_NLSF_VQ_err( in_lo, in_hi, &pCB_Q8[ ( i + 1 ) * LPC_order ], &pWght_Q9[ ( i + 1 ) * LPC_order ], LPC_order );
+        s2 = silk_NLSF_VQ_err( in_lo, in_hi, &pCB_Q8[ ( i + 2 ) * LPC_order ], &pWght_Q9[ ( i + 2 ) * LPC_order ], LPC_order );
+        s3 = silk_NLSF_VQ_err( in_lo, in_hi, &pCB_Q8[ ( i + 3 ) * LPC_order ], &pWght_Q9[ ( i + 3 ) * LPC_order ], LPC_order );
+        s0 = _mm_hadd_epi32( _mm_hadd_epi32( s0, s1 ), _mm_hadd_epi32( s2, s3 ) );
+        _mm_storeu_si128( (__m128i *)(void *)&err_Q24[ i ], s0 );
+    }
+    for( ; i < K; i++ ) {
+        s0 = silk_NLSF_VQ_err( in_lo, in_hi, &pCB_Q8[ i * LPC_order ], &pWght_Q9[ i * LPC_order ], LPC_order );
+        s0 = _mm_hadd_epi32( s0, s0 );
+        err_Q24[ i ] = _mm_cvtsi128_si32( _mm_hadd_epi32( s0, s0 ) );
+    }
+}
+
+static OPUS_INLINE __m128i silk_mm_hmin_epi32( __m128i num )
+{
+    num = _mm_min_epi32( num, _mm_shuffle_epi32( num, 0x4E ) ); /* 0123 -> 2301 */
+    num = _mm_min_epi32( num, _mm_shuffle_epi32( num, 0xB1 ) ); /* 0123 -> 1032 */
+    return num;
+}
+
+static OPUS_INLINE __m128i silk_mm_hmax_epi32( __m128i num )
+{
+    num = _mm_max_epi32( num, _mm_shuffle_epi32( num, 0x4E ) ); /* 0123 -> 2301 */
+    num = _mm_max_epi32( num, _mm_shuffle_epi32( num, 0xB1 ) ); /* 0123 -> 1032 */
+    return num;
+}
+
+static OPUS_INLINE opus_int silk_index_of_first_equal_epi32( __m128i a, __m128i b )
+{
+    unsigned int mask = _mm_movemask_epi8( _mm_cmpeq_epi32( a, b ) ) & 0x1111;
+    silk_assert( mask != 0 );
+    return __builtin_ctz( mask ) >> 2;
+}
+
+/* Reconstructed value and RD cost of quantizing the residual of each state to level ind.  */
+/* Only the low 16 bits of the states' outputs are valid, matching the opus_int16 outputs */
+/* of the C code; _mm_madd_epi16() against constants with zero high halves ignores the    */
+/* rest. All RD values are exact, wrap-around included.                                    */
+static OPUS_INLINE __m128i silk_NLSF_del_dec_level( __m128i *out, __m128i ind, __m128i pred,
+    __m128i in, __m128i w, __m128i rates, __m128i step, __m128i mu, __m128i RD )
+{
+    __m128i level, abs_ind, rate, diff;
+
+    /* Level ind is ind - 0.1 for ind > 0 and ind + 0.1 for ind < 0, in Q10 */
+    level = _mm_sub_epi32( _mm_slli_epi32( ind, 10 ),
+                _mm_sign_epi32( _mm_set1_epi32( SILK_FIX_CONST( NLSF_QUANT_LEVEL_ADJ, 10 ) ), ind ) );
+    *out  = _mm_add_epi32( _mm_srai_epi32( _mm_madd_epi16( level, step ), 16 ), pred );
+
+    /* Table rate for |ind| < NLSF_QUANT_MAX_AMPLITUDE, linear in |ind| beyond */
+    abs_ind = _mm_abs_epi32( ind );
+    rate = _mm_shuffle_epi8( rates, _mm_or_si128( _mm_add_epi32( ind, _mm_set1_epi32( NLSF_QUANT_MAX_AMPLITUDE ) ),
+               _mm_set1_epi32( -256 ) ) );
+    rate = _mm_blendv_epi8( _mm_add_epi32( _mm_mullo_epi16( abs_ind, _mm_set1_epi32( 43 ) ),
+               _mm_set1_epi32( 280 - 43 * NLSF_QUANT_MAX_AMPLITUDE ) ), rate,
+               _mm_cmpgt_epi32( _mm_set1_epi32( NLSF_QUANT_MAX_AMPLITUDE ), abs_ind ) );
+
+    diff = _mm_and_si128( _mm_sub_epi32( in, *out ), _mm_set1_epi32( 0xFFFF ) );
+    RD   = _mm_add_epi32( RD, _mm_mullo_epi32( _mm_madd_epi16( diff, diff ), w ) );
+    return _mm_add_epi32( RD, _mm_madd_epi16( rate, mu ) );
+}
+
+/* Delayed-decision quantizer for NLSF residuals, with the states in the lanes of a vector.  */
+/* Rather than copying index paths between states, each step stores the index and the      */
+/* parent state of every survivor, and the winning path is traced back at the end.         */
+opus_int32 silk_NLSF_del_dec_quant_sse4_1(                      /* O    Returns RD value in Q25                     */
+    opus_int8                   indices[],                      /* O    Quantization indices [ order ]              */
+    const opus_int16            x_Q10[],                        /* I    Input [ order ]                             */
+    const opus_int16            w_Q5[],                         /* I    Weights [ order ]                           */
+    const opus_uint8            pred_coef_Q8[],                 /* I    Backward predictor coefs [ order ]          */
+    const opus_int16            ec_ix[],                        /* I    Indices to entropy coding tables [ order ]  */
+    const opus_uint8            ec_rates_Q5[],                  /* I    Rates []                                    */
+    const opus_int              quant_step_size_Q16,            /* I    Quantization step size                      */
+    const opus_int16            inv_quant_step_size_Q6,         /* I    Inverse quantization step size              */
+    const opus_int32            mu_Q20,                         /* I    R/D tradeoff                                */
+    const opus_int16            order                           /* I    Number of input values                      */
+)
+{
+    opus_int         i, j, nStates, ind_min_max, ind_max_min, ind_tmp;
+    opus_int32       min_Q25;
+    opus_int32       RD_Q25[ 2 * NLSF_QUANT_DEL_DEC_STATES ];
+    opus_int8        path[ MAX_LPC_ORDER ][ 2 * NLSF_QUANT_DEL_DEC_STATES ];
+    __m128i          step, inv_step, mu, in, w, coef, rates, pred, ind0, ind1, lanes, sel;
+    __m128i          prev_out, prev_lose, out0, out1, RD, RD0, RD1, RD_max, RD_min, RD_lose;
+    __m128i          swap, ind_sort, parent, dst, min_max, max_min;
+
+    silk_assert( NLSF_QUANT_DEL_DEC_STATES == 4 );
+    celt_assert( order == 10 || order == 16 );
+
+    /* Constants for _mm_madd_epi16() have zero high halves */
+    step     = _mm_set1_epi32( (opus_uint16)quant_step_size_Q16 );
+    inv_step = _mm_set1_epi32( (opus_uint16)inv_quant_step_size_Q6 );
+    mu       = _mm_set1_epi32( (opus_uint16)mu_Q20 );
+    lanes    = _mm_set_epi32( 3, 2, 1, 0 );
+
+    nStates  = 1;
+    RD       = _mm_setzero_si128();
+    RD_max   = _mm_setzero_si128();
+    prev_out = _mm_setzero_si128();
+    for( i = order - 1; i >= 0; i-- ) {
+        rates = _mm_loadl_epi64( (__m128i *)(void *)&ec_rates_Q5[ ec_ix[ i ] ] );
+        in    = _mm_set1_epi32( x_Q10[ i ] );
+        w     = _mm_set1_epi32( w_Q5[ i ] );
+        coef  = _mm_set1_epi32( pred_coef_Q8[ i ] );
+
+        pred = _mm_srai_epi32( _mm_madd_epi16( prev_out, coef ), 8 );
+        ind0 = _mm_srai_epi32( _mm_madd_epi16( _mm_sub_epi32( in, pred ), inv_step ), 16 );
+        ind0 = _mm_max_epi32( _mm_min_epi32( ind0, _mm_set1_epi32( NLSF_QUANT_MAX_AMPLITUDE_EXT - 1 ) ),
+                   _mm_set1_epi32( -NLSF_QUANT_MAX_AMPLITUDE_EXT ) );
+        ind1 = _mm_add_epi32( ind0, _mm_set1_epi32( 1 ) );
+        RD0  = silk_NLSF_del_dec_level( &out0, ind0, pred, in, w, rates, step, mu, RD );
+        RD1  = silk_NLSF_del_dec_level( &out1, ind1, pred, in, w, rates, step, mu, RD );
+
+        if( nStates <= NLSF_QUANT_DEL_DEC_STATES/2 ) {
+            /* double number of states: state j + nStates takes the upper level of state j */
+            if( nStates == 1 ) {
+                RD       = _mm_unpacklo_epi32( RD0, RD1 );
+                prev_out = _mm_unpacklo_epi32( out0, out1 );
+                ind0     = _mm_unpacklo_epi32( ind0, ind1 );
+                parent   = _mm_setzero_si128();
+            } else {
+                RD       = _mm_unpacklo_epi64( RD0, RD1 );
+                prev_out = _mm_unpacklo_epi64( out0, out1 );
+                ind0     = _mm_unpacklo_epi64( ind0, ind1 );
+                parent   = _mm_set_epi32( 1, 0, 1, 0 );
+            }
+            nStates = silk_LSHIFT( nStates, 1 );
+        } else {
+            /* sort lower and upper half of RD, pairwise */
+            swap      = _mm_cmpgt_epi32( RD0, RD1 );
+            RD        = _mm_min_epi32( RD0, RD1 );
+            RD_max    = _mm_max_epi32( RD0, RD1 );
+            prev_out  = _mm_blendv_epi8( out0, out1, swap );
+            prev_lose = _mm_blendv_epi8( out1, out0, swap );
+            ind_sort  = _mm_or_si128( lanes, _mm_and_si128( swap, _mm_set1_epi32( NLSF_QUANT_DEL_DEC_STATES ) ) );
+
+            /* compare the highest RD values of the winning half with the lowest one in the losing half, */
+            /* and copy if necessary; afterwards ind_sort holds where each survivor came from             */
+            RD_min  = RD;
+            RD_lose = RD_max;
+            min_max = silk_mm_hmin_epi32( RD_lose );
+            max_min = _mm_max_epi32( silk_mm_hmax_epi32( RD_min ), _mm_setzero_si128() );
+            while( _mm_cvtsi128_si32( min_max ) < _mm_cvtsi128_si32( max_min ) ) {
+                /* first minimum of the losing half, first maximum above zero of the winning half */
+                ind_min_max = silk_index_of_first_equal_epi32( RD_lose, min_max );
+                ind_max_min = 0;
+                if( _mm_cvtsi128_si32( max_min ) > 0 ) {
+                    ind_max_min = silk_index_of_first_equal_epi32( RD_min, max_min );
+                }
+                /* copy ind_min_max to ind_max_min */
+                sel      = _mm_set1_epi32( 0x03020100 + 0x04040404 * ind_min_max );
+                dst      = _mm_cmpeq_epi32( lanes, _mm_set1_epi32( ind_max_min ) );
+                ind_sort = _mm_blendv_epi8( ind_sort, _mm_xor_si128( _mm_shuffle_epi8( ind_sort, sel ),
+                               _mm_set1_epi32( NLSF_QUANT_DEL_DEC_STATES ) ), dst );
+                RD       = _mm_blendv_epi8( RD, min_max, dst );
+                prev_out = _mm_blendv_epi8( prev_out, _mm_shuffle_epi8( prev_lose, sel ), dst );
+                RD_min   = _mm_andnot_si128( dst, RD_min );
+                RD_lose  = _mm_blendv_epi8( RD_lose, _mm_set1_epi32( silk_int32_MAX ),
+                               _mm_cmpeq_epi32( lanes, _mm_set1_epi32( ind_min_max ) ) );
+                min_max  = silk_mm_hmin_epi32( RD_lose );
+                max_min  = _mm_max_epi32( silk_mm_hmax_epi32( RD_min ), _mm_setzero_si128() );
+            }
+
+            /* each survivor continues the path of its parent, with the index incremented if it */
+            /* comes from the upper half                                                         */
+            parent = _mm_and_si128( ind_sort, _mm_set1_epi32( NLSF_QUANT_DEL_DEC_STATES - 1 ) );
+            sel    = _mm_shuffle_epi8( _mm_slli_epi32( parent, 2 ),
+                         _mm_set_epi8( 12, 12, 12, 12, 8, 8, 8, 8, 4, 4, 4, 4, 0, 0, 0, 0 ) );
+            sel    = _mm_add_epi8( sel, _mm_set1_epi32( 0x03020100 ) );
+            ind0   = _mm_add_epi32( _mm_shuffle_epi8( ind0, sel ),
+                         _mm_srli_epi32( ind_sort, NLSF_QUANT_DEL_DEC_STATES_LOG2 ) );
+        }
+        ind0 = _mm_packs_epi16( _mm_packs_epi32( ind0, parent ), ind0 );
+        _mm_storel_epi64( (__m128i *)(void *)path[ i ], ind0 );
+    }
+
+    /* last sample: find winner, trace back its indices and return RD value */
+    _mm_storeu_si128( (__m128i *)(void *)&RD_Q25[ 0 ], RD );
+    _mm_storeu_si128( (__m128i *)(void *)&RD_Q25[ NLSF_QUANT_DEL_DEC_STATES ], RD_max );
+    ind_tmp = 0;
+    min_Q25 = silk_int32_MAX;
+    for( j = 0; j < 2 * NLSF_QUANT_DEL_DEC_STATES; j++ ) {
+        if( min_Q25 > RD_Q25[ j ] ) {
+            min_Q25 = RD_Q25[ j ];
+            ind_tmp = j;
+        }
+    }
+    j = ind_tmp & ( NLSF_QUANT_DEL_DEC_STATES - 1 );
+    for( i = 0; i < order; i++ ) {
+        indices[ i ] = path[ i ][ j ];
+        j = path[ i ][ NLSF_QUANT_DEL_DEC_STATES + j ];
+        silk_assert( indices[ i ] >= -NLSF_QUANT_MAX_AMPLITUDE_EXT );
+        silk_assert( indices[ i ] <=  NLSF_QUANT_MAX_AMPLITUDE_EXT );
+    }
+    indices[ 0 ] += silk_RSHIFT( ind_tmp, NLSF_QUANT_DEL_DEC_STATES_LOG2 );
+    silk_assert( indices[ 0 ] <= NLSF_QUANT_MAX_AMPLITUDE_EXT );
+    silk_assert( min_Q25 >= 0 );
+    return min_Q25;
+}
@@ -0,0 +1,83 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <immintrin.h>
+#include "main.h"
+#include "celt/x86/x86cpu.h"
+
+void silk_LTP_synthesis_avx2(
+    opus_int32                  pres_Q14[],                     /* O    LPC excitation [ length ]                   */
+    opus_int32                  sLTP_Q15[],                     /* I/O  LTP state, new samples from sLTP_Q15[ 0 ]   */
+    const opus_int32            exc_Q14[],                      /* I    Excitation [ length ]                       */
+    const opus_int16            B_Q14[ LTP_ORDER ],             /* I    LTP coefficients                            */
+    const opus_int              lag,                            /* I    Pitch lag                                   */
+    const opus_int              length                          /* I    Subframe length                             */
+)
+{
+    opus_int   i, j;
+    opus_int32 LTP_pred_Q13;
+    const opus_int32 *pred_lag_ptr;
+    __m256i B_Q16[ LTP_ORDER ], x, even, odd, pred, pres;
+
+    pred_lag_ptr = &sLTP_Q15[ -lag + LTP_ORDER / 2 ];
+    i = 0;
+    /* Eight outputs at a time only read state written before them */
+    if( lag >= LTP_ORDER / 2 + 8 ) {
+        for( j = 0; j < LTP_ORDER; j++ ) {
+            B_Q16[ j ] = _mm256_set1_epi32( silk_LSHIFT32( (opus_int32)B_Q14[ j ], 16 ) );
+        }
+        for( ; i < length - 7; i += 8 ) {
+            /* The high dword of each 64-bit product is silk_SMULWB() */
+            even = _mm256_setzero_si256();
+            odd  = _mm256_setzero_si256();
+            for( j = 0; j < LTP_ORDER; j++ ) {
+                x    = _mm256_loadu_si256( (__m256i *)(void *)&pred_lag_ptr[ i - j ] );
+                even = _mm256_add_epi32( even, _mm256_mul_epi32( x, B_Q16[ j ] ) );
+                odd  = _mm256_add_epi32( odd, _mm256_mul_epi32( _mm256_srli_epi64( x, 32 ), B_Q16[ j ] ) );
+            }
+            pred = _mm256_blend_epi32( _mm256_srli_epi64( even, 32 ), odd, 0xAA );
+
+            /* Avoids introducing a bias because silk_SMLAWB() always rounds to -inf */
+            pred = _mm256_add_epi32( pred, _mm256_set1_epi32( 2 ) );
+            pres = _mm256_add_epi32( _mm256_loadu_si256( (__m256i *)(void *)&exc_Q14[ i ] ), _mm256_slli_epi32( pred, 1 ) );
+            _mm256_storeu_si256( (__m256i *)(void *)&pres_Q14[ i ], pres );
+            _mm256_storeu_si256( (__m256i *)(void *)&sLTP_Q15[ i ], _mm256_slli_epi32( pres, 1 ) );
+        }
+    }
+    for( ; i < length; i++ ) {
+        LTP_pred_Q13 = 2;
+        for( j = 0; j < LTP_ORDER; j++ ) {
+            LTP_pred_Q13 = silk_SMLAWB( LTP_pred_Q13, pred_lag_ptr[ i - j ], B_Q14[ j ] );
+        }
+        pres_Q14[ i ] = silk_ADD_LSHIFT32( exc_Q14[ i ], LTP_pred_Q13, 1 );
+        sLTP_Q15[ i ] = silk_LSHIFT( pres_Q14[ i ], 1 );
+    }
+}
@@ -0,0 +1,166 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <smmintrin.h>
+#include "main.h"
+#include "celt/x86/x86cpu.h"
+
+/* Four LTP predictions, each the sum of silk_SMULWB( pred_lag_ptr[ i - j ], B_Q14[ j ] ) */
+/* B_Q16 holds the coefficients shifted left by 16, so the high dword of _mm_mul_epi32() */
+/* is the rounded-down product.                                                          */
+static OPUS_INLINE __m128i silk_LTP_pred_x4( const opus_int32 *pred_lag_ptr, const __m128i B_Q16[ LTP_ORDER ] )
+{
+    opus_int j;
+    __m128i x, even, odd;
+
+    even = _mm_setzero_si128();
+    odd  = _mm_setzero_si128();
+    for( j = 0; j < LTP_ORDER; j++ ) {
+        x    = _mm_loadu_si128( (__m128i *)(void *)&pred_lag_ptr[ -j ] );
+        even = _mm_add_epi32( even, _mm_mul_epi32( x, B_Q16[ j ] ) );
+        odd  = _mm_add_epi32( odd, _mm_mul_epi32( _mm_srli_epi64( x, 32 ), B_Q16[ j ] ) );
+    }
+    return _mm_blend_epi16( _mm_srli_epi64( even, 32 ), odd, 0xCC );
+}
+
+void silk_LTP_synthesis_sse4_1(
+    opus_int32                  pres_Q14[],                     /* O    LPC excitation [ length ]                   */
+    opus_int32                  sLTP_Q15[],                     /* I/O  LTP state, new samples from sLTP_Q15[ 0 ]   */
+    const opus_int32            exc_Q14[],                      /* I    Excitation [ length ]                       */
+    const opus_int16            B_Q14[ LTP_ORDER ],             /* I    LTP coefficients                            */
+    const opus_int              lag,                            /* I    Pitch lag                                   */
+    const opus_int              length                          /* I    Subframe length                             */
+)
+{
+    opus_int   i, j;
+    opus_int32 LTP_pred_Q13;
+    const opus_int32 *pred_lag_ptr;
+    __m128i B_Q16[ LTP_ORDER ], pred, pres;
+
+    pred_lag_ptr = &sLTP_Q15[ -lag + LTP_ORDER / 2 ];
+    i = 0;
+    /* Four outputs at a time only read state written before them */
+    if( lag >= LTP_ORDER / 2 + 4 ) {
+        for( j = 0; j < LTP_ORDER; j++ ) {
+            B_Q16[ j ] = _mm_set1_epi32( silk_LSHIFT32( (opus_int32)B_Q14[ j ], 16 ) );
+        }
+        for( ; i < length - 3; i += 4 ) {
+            /* Avoids introducing a bias because silk_SMLAWB() always rounds to -inf */
+            pred = _mm_add_epi32( silk_LTP_pred_x4( &pred_lag_ptr[ i ], B_Q16 ), _mm_set1_epi32( 2 ) );
+            pres = _mm_add_epi32( _mm_loadu_si128( (__m128i *)(void *)&exc_Q14[ i ] ), _mm_slli_epi32( pred, 1 ) );
+            _mm_storeu_si128( (__m128i *)(void *)&pres_Q14[ i ], pres );
+            _mm_storeu_si128( (__m128i *)(void *)&sLTP_Q15[ i ], _mm_slli_epi32( pres, 1 ) );
+        }
+    }
+    for( ; i < length; i++ ) {
+        LTP_pred_Q13 = 2;
+        for( j = 0; j < LTP_ORDER; j++ ) {
+            LTP_pred_Q13 = silk_SMLAWB( LTP_pred_Q13, pred_lag_ptr[ i - j ], B_Q14[ j ] );
+        }
+        pres_Q14[ i ] = silk_ADD_LSHIFT32( exc_Q14[ i ], LTP_pred_Q13, 1 );
+        sLTP_Q15[ i ] = silk_LSHIFT( pres_Q14[ i ], 1 );
+    }
+}
+
+void silk_LPC_synthesis_sse4_1(
+    opus_int32                  sLPC_Q14[],                     /* I/O  State [ MAX_LPC_ORDER ], then output        */
+    const opus_int32            pres_Q14[],                     /* I    LPC excitation [ length ]                   */
+    const opus_int16            A_Q12[],                        /* I    Prediction coefficients [ order ]           */
+    const opus_int              order,                          /* I    Prediction order, 10 or 16                  */
+    const opus_int              length                          /* I    Signal length                               */
+)
+{
+    opus_int   i;
+    opus_int32 LPC_pred_Q10, out_Q14, prev_Q14;
+    opus_int16 A_rev[ 16 ];
+    opus_int32 tmp[ 16 ];
+    __m128i    hi_0, hi_1, lo_0, lo_1, a_0, a_1, sum, lo_sum, lo16, ones, shuf, xmm_a, xmm_b;
+
+    celt_assert( order == 10 || order == 16 );
+    silk_assert( MAX_LPC_ORDER == 16 );
+
+    /* The newest tap is done in scalar code, so the vector part only needs samples that   */
+    /* are one step old and stays off the critical path. Lane k holds the sample from     */
+    /* 17 - k steps back, and is multiplied by A_Q12[ 16 - k ]; lane 0 is unused.         */
+    silk_memset( A_rev, 0, sizeof( A_rev ) );
+    for( i = 1; i < order; i++ ) {
+        A_rev[ 16 - i ] = A_Q12[ i ];
+    }
+    a_0 = _mm_loadu_si128( (__m128i *)(void *)&A_rev[ 0 ] );
+    a_1 = _mm_loadu_si128( (__m128i *)(void *)&A_rev[ 8 ] );
+
+    /* Split the state into the signed high and the unsigned low 16 bits of each sample */
+    tmp[ 0 ] = 0;
+    silk_memcpy( &tmp[ 1 ], sLPC_Q14, ( MAX_LPC_ORDER - 1 ) * sizeof( opus_int32 ) );
+    shuf  = _mm_set_epi8( 15, 14, 11, 10, 7, 6, 3, 2, 13, 12, 9, 8, 5, 4, 1, 0 );
+    xmm_a = _mm_shuffle_epi8( _mm_loadu_si128( (__m128i *)(void *)&tmp[ 0 ] ), shuf );
+    xmm_b = _mm_shuffle_epi8( _mm_loadu_si128( (__m128i *)(void *)&tmp[ 4 ] ), shuf );
+    hi_0  = _mm_unpackhi_epi64( xmm_a, xmm_b );
+    lo_0  = _mm_unpacklo_epi64( xmm_a, xmm_b );
+    xmm_a = _mm_shuffle_epi8( _mm_loadu_si128( (__m128i *)(void *)&tmp[ 8 ] ), shuf );
+    xmm_b = _mm_shuffle_epi8( _mm_loadu_si128( (__m128i *)(void *)&tmp[ 12 ] ), shuf );
+    hi_1  = _mm_unpackhi_epi64( xmm_a, xmm_b );
+    lo_1  = _mm_unpacklo_epi64( xmm_a, xmm_b );
+
+    ones = _mm_set1_epi16( 1 );
+    prev_Q14 = sLPC_Q14[ MAX_LPC_ORDER - 1 ];
+    for( i = 0; i < length; i++ ) {
+        /* High parts with pmaddwd; low parts with pmulhw, corrected for being unsigned */
+        sum    = _mm_add_epi32( _mm_madd_epi16( hi_0, a_0 ), _mm_madd_epi16( hi_1, a_1 ) );
+        lo16   = _mm_add_epi16( _mm_mulhi_epi16( lo_0, a_0 ),
+                     _mm_and_si128( _mm_cmpgt_epi16( _mm_setzero_si128(), lo_0 ), a_0 ) );
+        lo_sum = _mm_madd_epi16( lo16, ones );
+        lo16   = _mm_add_epi16( _mm_mulhi_epi16( lo_1, a_1 ),
+                     _mm_and_si128( _mm_cmpgt_epi16( _mm_setzero_si128(), lo_1 ), a_1 ) );
+        lo_sum = _mm_add_epi32( lo_sum, _mm_madd_epi16( lo16, ones ) );
+        sum    = _mm_add_epi32( sum, lo_sum );
+        sum    = _mm_add_epi32( sum, _mm_unpackhi_epi64( sum, sum ) );
+        sum    = _mm_add_epi32( sum, _mm_shufflelo_epi16( sum, 0x0E ) );
+
+        /* Shift in the previous output for the next sample */
+        hi_0 = _mm_alignr_epi8( hi_1, hi_0, 2 );
+        lo_0 = _mm_alignr_epi8( lo_1, lo_0, 2 );
+        hi_1 = _mm_insert_epi16( _mm_srli_si128( hi_1, 2 ), prev_Q14 >> 16, 7 );
+        lo_1 = _mm_insert_epi16( _mm_srli_si128( lo_1, 2 ), prev_Q14, 7 );
+
+        /* Avoids introducing a bias because silk_SMLAWB() always rounds to -inf */
+        LPC_pred_Q10 = silk_RSHIFT( order, 1 ) + _mm_cvtsi128_si32( sum );
+        LPC_pred_Q10 = silk_SMLAWB( LPC_pred_Q10, prev_Q14, A_Q12[ 0 ] );
+
+        /* Add prediction to LPC excitation */
+        out_Q14 = silk_ADD_SAT32( pres_Q14[ i ], silk_LSHIFT_SAT32( LPC_pred_Q10, 4 ) );
+        sLPC_Q14[ MAX_LPC_ORDER + i ] = out_Q14;
+        prev_Q14 = out_Q14;
+    }
+}
@@ -269,6 +269,174 @@ extern opus_int (*const SILK_VAD_GETSA_Q8_IMPL[OPUS_ARCHMASK + 1])(
 
 #  endif
 
+void silk_LTP_synthesis_sse4_1(
+    opus_int32                  pres_Q14[],                     /* O    LPC excitation [ length ]                   */
+    opus_int32                  sLTP_Q15[],                     /* I/O  LTP state, new samples from sLTP_Q15[ 0 ]   */
+    const opus_int32            exc_Q14[],                      /* I    Excitation [ length ]                       */
+    const opus_int16            B_Q14[ LTP_ORDER ],             /* I    LTP coefficients                            */
+    const opus_int              lag,                            /* I    Pitch lag                                   */
+    const opus_int              length                          /* I    Subframe length                             */
+);
+
+void silk_LTP_synthesis_avx2(
+    opus_int32                  pres_Q14[],                     /* O    LPC excitation [ length ]                   */
+    opus_int32                  sLTP_Q15[],                     /* I/O  LTP state, new samples from sLTP_Q15[ 0 ]   */
+    const opus_int32            exc_Q14[],                      /* I    Excitation [ length ]                       */
+    const opus_int16            B_Q14[ LTP_ORDER ],             /* I    LTP coefficients                            */
+    const opus_int              lag,                            /* I    Pitch lag                                   */
+    const opus_int              length                          /* I    Subframe length                             */
+);
+
+#  if defined(OPUS_X86_PRESUME_AVX2)
+
+#   define OVERRIDE_silk_LTP_synthesis
+#   define silk_LTP_synthesis(pres_Q14, sLTP_Q15, exc_Q14, B_Q14, lag, length, arch) \
+    ((void)(arch), silk_LTP_synthesis_avx2(pres_Q14, sLTP_Q15, exc_Q14, B_Q14, lag, length))
+
+#  elif defined(OPUS_X86_PRESUME_SSE4_1) && !defined(OPUS_X86_MAY_HAVE_AVX2)
+
+#   define OVERRIDE_silk_LTP_synthesis
+#   define silk_LTP_synthesis(pres_Q14, sLTP_Q15, exc_Q14, B_Q14, lag, length, arch) \
+    ((void)(arch), silk_LTP_synthesis_sse4_1(pres_Q14, sLTP_Q15, exc_Q14, B_Q14, lag, length))
+
+#  elif defined(OPUS_HAVE_RTCD)
+
+extern void (*const SILK_LTP_SYNTHESIS_IMPL[OPUS_ARCHMASK + 1])(
+    opus_int32                  pres_Q14[],                     /* O    LPC excitation [ length ]                   */
+    opus_int32                  sLTP_Q15[],                     /* I/O  LTP state, new samples from sLTP_Q15[ 0 ]   */
+    const opus_int32            exc_Q14[],                      /* I    Excitation [ length ]                       */
+    const opus_int16            B_Q14[ LTP_ORDER ],             /* I    LTP coefficients                            */
+    const opus_int              lag,                            /* I    Pitch lag                                   */
+    const opus_int              length                          /* I    Subframe length                             */
+);
+
+#   define OVERRIDE_silk_LTP_synthesis
+#   define silk_LTP_synthesis(pres_Q14, sLTP_Q15, exc_Q14, B_Q14, lag, length, arch) \
+    ((*SILK_LTP_SYNTHESIS_IMPL[(arch) & OPUS_ARCHMASK])(pres_Q14, sLTP_Q15, exc_Q14, B_Q14, lag, length))
+
+#  endif
+
+void silk_LPC_synthesis_sse4_1(
+    opus_int32                  sLPC_Q14[],                     /* I/O  State [ MAX_LPC_ORDER ], then output        */
+    const opus_int32            pres_Q14[],                     /* I    LPC excitation [ length ]                   */
+    const opus_int16            A_Q12[],                        /* I    Prediction coefficients [ order ]           */
+    const opus_int              order,                          /* I    Prediction order, 10 or 16                  */
+    const opus_int              length                          /* I    Signal length                               */
+);
+
+#  if defined(OPUS_X86_PRESUME_SSE4_1)
+
+#   define OVERRIDE_silk_LPC_synthesis
+#   define silk_LPC_synthesis(sLPC_Q14, pres_Q14, A_Q12, order, length, arch) \
+    ((void)(arch), silk_LPC_synthesis_sse4_1(sLPC_Q14, pres_Q14, A_Q12, order, length))
+
+#  elif defined(OPUS_HAVE_RTCD)
+
+extern void (*const SILK_LPC_SYNTHESIS_IMPL[OPUS_ARCHMASK + 1])(
+    opus_int32                  sLPC_Q14[],                     /* I/O  State [ MAX_LPC_ORDER ], then output        */
+    const opus_int32            pres_Q14[],                     /* I    LPC excitation [ length ]                   */
+    const opus_int16            A_Q12[],                        /* I    Prediction coefficients [ order ]           */
+    const opus_int              order,                          /* I    Prediction order, 10 or 16                  */
+    const opus_int              length                          /* I    Signal length                               */
+);
+
+#   define OVERRIDE_silk_LPC_synthesis
+#   define silk_LPC_synthesis(sLPC_Q14, pres_Q14, A_Q12, order, length, arch) \
+    ((*SILK_LPC_SYNTHESIS_IMPL[(arch) & OPUS_ARCHMASK])(sLPC_Q14, pres_Q14, A_Q12, order, length))
+
+#  endif
+
+void silk_NLSF_VQ_sse4_1(
+    opus_int32                  err_Q24[],                      /* O    Quantization errors [K]                     */
+    const opus_int16            in_Q15[],                       /* I    Input vectors to be quantized [LPC_order]   */
+    const opus_uint8            pCB_Q8[],                       /* I    Codebook vectors [K*LPC_order]              */
+    const opus_int16            pWght_Q9[],                     /* I    Codebook weights [K*LPC_order]              */
+    const opus_int              K,                              /* I    Number of codebook vectors                  */
+    const opus_int              LPC_order                       /* I    Number of LPCs                              */
+);
+
+void silk_NLSF_VQ_avx2(
+    opus_int32                  err_Q24[],                      /* O    Quantization errors [K]                     */
+    const opus_int16            in_Q15[],                       /* I    Input vectors to be quantized [LPC_order]   */
+    const opus_uint8            pCB_Q8[],                       /* I    Codebook vectors [K*LPC_order]              */
+    const opus_int16            pWght_Q9[],                     /* I    Codebook weights [K*LPC_order]              */
+    const opus_int              K,                              /* I    Number of codebook vectors                  */
+    const opus_int              LPC_order                       /* I    Number of LPCs                              */
+);
+
+#  if defined(OPUS_X86_PRESUME_AVX2)
+
+#   define OVERRIDE_silk_NLSF_VQ
+#   define silk_NLSF_VQ(err_Q24, in_Q15, pCB_Q8, pWght_Q9, K, LPC_order, arch) \
+    ((void)(arch), silk_NLSF_VQ_avx2(err_Q24, in_Q15, pCB_Q8, pWght_Q9, K, LPC_order))
+
+#  elif defined(OPUS_X86_PRESUME_SSE4_1) && !defined(OPUS_X86_MAY_HAVE_AVX2)
+
+#   define OVERRIDE_silk_NLSF_VQ
+#   define silk_NLSF_VQ(err_Q24, in_Q15, pCB_Q8, pWght_Q9, K, LPC_order, arch) \
+    ((void)(arch), silk_NLSF_VQ_sse4_1(err_Q24, in_Q15, pCB_Q8, pWght_Q9, K, LPC_order))
+
+#  elif defined(OPUS_HAVE_RTCD)
+
+extern void (*const SILK_NLSF_VQ_IMPL[OPUS_ARCHMASK + 1])(
+    opus_int32                  err_Q24[],                      /* O    Quantization errors [K]                     */
+    const opus_int16            in_Q15[],                       /* I    Input vectors to be quantized [LPC_order]   */
+    const opus_uint8            pCB_Q8[],                       /* I    Codebook vectors [K*LPC_order]              */
+    const opus_int16            pWght_Q9[],                     /* I    Codebook weights [K*LPC_order]              */
+    const opus_int              K,                              /* I    Number of codebook vectors                  */
+    const opus_int              LPC_order                       /* I    Number of LPCs                              */
+);
+
+#   define OVERRIDE_silk_NLSF_VQ
+#   define silk_NLSF_VQ(err_Q24, in_Q15, pCB_Q8, pWght_Q9, K, LPC_order, arch) \
+    ((*SILK_NLSF_VQ_IMPL[(arch) & OPUS_ARCHMASK])(err_Q24, in_Q15, pCB_Q8, pWght_Q9, K, LPC_order))
+
+#  endif
+
+opus_int32 silk_NLSF_del_dec_quant_sse4_1(                      /* O    Returns RD value in Q25                     */
+    opus_int8                   indices[],                      /* O    Quantization indices [ order ]              */
+    const opus_int16            x_Q10[],                        /* I    Input [ order ]                             */
+    const opus_int16            w_Q5[],                         /* I    Weights [ order ]                           */
+    const opus_uint8            pred_coef_Q8[],                 /* I    Backward predictor coefs [ order ]          */
+    const opus_int16            ec_ix[],                        /* I    Indices to entropy coding tables [ order ]  */
+    const opus_uint8            ec_rates_Q5[],                  /* I    Rates []                                    */
+    const opus_int              quant_step_size_Q16,            /* I    Quantization step size                      */
+    const opus_int16            inv_quant_step_size_Q6,         /* I    Inverse quantization step size              */
+    const opus_int32            mu_Q20,                         /* I    R/D tradeoff                                */
+    const opus_int16            order                           /* I    Number of input values                      */
+);
+
+#  if defined(OPUS_X86_PRESUME_SSE4_1)
+
+#   define OVERRIDE_silk_NLSF_del_dec_quant
+#   define silk_NLSF_del_dec_quant(indices, x_Q10, w_Q5, pred_coef_Q8, ec_ix, ec_rates_Q5, quant_step_size_Q16, \
+                                   inv_quant_step_size_Q6, mu_Q20, order, arch) \
+    ((void)(arch), silk_NLSF_del_dec_quant_sse4_1(indices, x_Q10, w_Q5, pred_coef_Q8, ec_ix, ec_rates_Q5, \
+                                                  quant_step_size_Q16, inv_quant_step_size_Q6, mu_Q20, order))
+
+#  elif defined(OPUS_HAVE_RTCD)
+
+extern opus_int32 (*const SILK_NLSF_DEL_DEC_QUANT_IMPL[OPUS_ARCHMASK + 1])(
+    opus_int8                   indices[],                      /* O    Quantization indices [ order ]              */
+    const opus_int16            x_Q10[],                        /* I    Input [ order ]                             */
+    const opus_int16            w_Q5[],                         /* I    Weights [ order ]                           */
+    const opus_uint8            pred_coef_Q8[],                 /* I    Backward predictor coefs [ order ]          */
+    const opus_int16            ec_ix[],                        /* I    Indices to entropy coding tables [ order ]  */
+    const opus_uint8            ec_rates_Q5[],                  /* I    Rates []                                    */
+    const opus_int              quant_step_size_Q16,            /* I    Quantization step size                      */
+    const opus_int16            inv_quant_step_size_Q6,         /* I    Inverse quantization step size              */
+    const opus_int32            mu_Q20,                         /* I    R/D tradeoff                                */
+    const opus_int16            order                           /* I    Number of input values                      */
+);
+
+#   define OVERRIDE_silk_NLSF_del_dec_quant
+#   define silk_NLSF_del_dec_quant(indices, x_Q10, w_Q5, pred_coef_Q8, ec_ix, ec_rates_Q5, quant_step_size_Q16, \
+                                   inv_quant_step_size_Q6, mu_Q20, order, arch) \
+    ((*SILK_NLSF_DEL_DEC_QUANT_IMPL[(arch) & OPUS_ARCHMASK])(indices, x_Q10, w_Q5, pred_coef_Q8, ec_ix, ec_rates_Q5, \
+                                                              quant_step_size_Q16, inv_quant_step_size_Q6, mu_Q20, order))
+
+#  endif
+
 #ifndef FIXED_POINT
 double silk_inner_product_FLP_avx2(
     const silk_float    *data1,
@@ -292,6 +460,129 @@ extern double (*const SILK_INNER_PRODUCT_FLP_IMPL[OPUS_ARCHMASK + 1])(
 
 #define silk_inner_product_FLP(data1, data2, dataSize, arch) ((void)arch,(*SILK_INNER_PRODUCT_FLP_IMPL[(arch) & OPUS_ARCHMASK])(data1, data2, dataSize))
 
+#endif
+
+silk_float silk_burg_modified_FLP_avx2(
+    silk_float          A[],
+    const silk_float    x[],
+    const silk_float    minInvGain,
+    const opus_int      subfr_length,
+    const opus_int      nb_subfr,
+    const opus_int      D,
+    int                 arch
+);
+
+void silk_warped_autocorrelation_FLP_avx2(
+    silk_float          *corr,
+    const silk_float    *input,
+    const silk_float    warping,
+    const opus_int      length,
+    const opus_int      order
+);
+
+void silk_LPC_analysis_filter_FLP_avx2(
+    silk_float          r_LPC[],
+    const silk_float    PredCoef[],
+    const silk_float    s[],
+    const opus_int      length,
+    const opus_int      Order
+);
+
+void silk_corrMatrix_FLP_avx2(
+    const silk_float    *x,
+    const opus_int      L,
+    const opus_int      Order,
+    silk_float          *XX,
+    int                 arch
+);
+
+void silk_corrVector_FLP_avx2(
+    const silk_float    *x,
+    const silk_float    *t,
+    const opus_int      L,
+    const opus_int      Order,
+    silk_float          *Xt,
+    int                 arch
+);
+
+#if defined (OPUS_X86_PRESUME_AVX2)
+
+#define OVERRIDE_burg_modified_FLP
+#define silk_burg_modified_FLP(A, x, minInvGain, subfr_length, nb_subfr, D, arch) \
+    (silk_burg_modified_FLP_avx2(A, x, minInvGain, subfr_length, nb_subfr, D, arch))
+
+#define OVERRIDE_warped_autocorrelation_FLP
+#define silk_warped_autocorrelation_FLP(corr, input, warping, length, order, arch) \
+    ((void)(arch), silk_warped_autocorrelation_FLP_avx2(corr, input, warping, length, order))
+
+#define OVERRIDE_LPC_analysis_filter_FLP
+#define silk_LPC_analysis_filter_FLP(r_LPC, PredCoef, s, length, Order, arch) \
+    ((void)(arch), silk_LPC_analysis_filter_FLP_avx2(r_LPC, PredCoef, s, length, Order))
+
+#define OVERRIDE_corrMatrix_FLP
+#define silk_corrMatrix_FLP(x, L, Order, XX, arch) \
+    (silk_corrMatrix_FLP_avx2(x, L, Order, XX, arch))
+#define silk_corrVector_FLP(x, t, L, Order, Xt, arch) \
+    (silk_corrVector_FLP_avx2(x, t, L, Order, Xt, arch))
+
+#elif defined(OPUS_HAVE_RTCD) && defined(OPUS_X86_MAY_HAVE_AVX2)
+
+extern silk_float (*const SILK_BURG_MODIFIED_FLP_IMPL[OPUS_ARCHMASK + 1])(
+    silk_float          A[],
+    const silk_float    x[],
+    const silk_float    minInvGain,
+    const opus_int      subfr_length,
+    const opus_int      nb_subfr,
+    const opus_int      D,
+    int                 arch
+);
+#define OVERRIDE_burg_modified_FLP
+#define silk_burg_modified_FLP(A, x, minInvGain, subfr_length, nb_subfr, D, arch) \
+    ((*SILK_BURG_MODIFIED_FLP_IMPL[(arch) & OPUS_ARCHMASK])(A, x, minInvGain, subfr_length, nb_subfr, D, arch))
+
+extern void (*const SILK_WARPED_AUTOCORRELATION_FLP_IMPL[OPUS_ARCHMASK + 1])(
+    silk_float          *corr,
+    const silk_float    *input,
+    const silk_float    warping,
+    const opus_int      length,
+    const opus_int      order
+);
+#define OVERRIDE_warped_autocorrelation_FLP
+#define silk_warped_autocorrelation_FLP(corr, input, warping, length, order, arch) \
+    ((*SILK_WARPED_AUTOCORRELATION_FLP_IMPL[(arch) & OPUS_ARCHMASK])(corr, input, warping, length, order))
+
+extern void (*const SILK_LPC_ANALYSIS_FILTER_FLP_IMPL[OPUS_ARCHMASK + 1])(
+    silk_float          r_LPC[],
+    const silk_float    PredCoef[],
+    const silk_float    s[],
+    const opus_int      length,
+    const opus_int      Order
+);
+#define OVERRIDE_LPC_analysis_filter_FLP
+#define silk_LPC_analysis_filter_FLP(r_LPC, PredCoef, s, length, Order, arch) \
+    ((*SILK_LPC_ANALYSIS_FILTER_FLP_IMPL[(arch) & OPUS_ARCHMASK])(r_LPC, PredCoef, s, length, Order))
+
+extern void (*const SILK_CORRMATRIX_FLP_IMPL[OPUS_ARCHMASK + 1])(
+    const silk_float    *x,
+    const opus_int      L,
+    const opus_int      Order,
+    silk_float          *XX,
+    int                 arch
+);
+extern void (*const SILK_CORRVECTOR_FLP_IMPL[OPUS_ARCHMASK + 1])(
+    const silk_float    *x,
+    const silk_float    *t,
+    const opus_int      L,
+    const opus_int      Order,
+    silk_float          *Xt,
+    int                 arch
+);
+#define OVERRIDE_corrMatrix_FLP
+#define silk_corrMatrix_FLP(x, L, Order, XX, arch) \
+    ((*SILK_CORRMATRIX_FLP_IMPL[(arch) & OPUS_ARCHMASK])(x, L, Order, XX, arch))
+#define silk_corrVector_FLP(x, t, L, Order, Xt, arch) \
+    ((*SILK_CORRVECTOR_FLP_IMPL[(arch) & OPUS_ARCHMASK])(x, t, L, Order, Xt, arch))
+
 #endif
 #endif
 
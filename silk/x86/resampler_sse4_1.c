@@ -0,0 +1,232 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <smmintrin.h>
+#include "SigProc_FIX.h"
+#include "resampler_private.h"
+#include "celt/x86/x86cpu.h"
+
+/* silk_SMULWB() on four 32-bit lanes; b holds sign-extended 16-bit values.
+   Bits 16 to 47 of the 64-bit products are the same whether the shift is
+   arithmetic or logical. */
+static OPUS_INLINE __m128i silk_mm_smulwb_epi32( __m128i a, __m128i b )
+{
+    __m128i even, odd;
+    even = _mm_srli_epi64( _mm_mul_epi32( a, b ), 16 );
+    odd  = _mm_slli_epi64( _mm_mul_epi32( _mm_srli_epi64( a, 32 ), _mm_srli_epi64( b, 32 ) ), 16 );
+    return _mm_blend_epi16( even, odd, 0xCC );
+}
+
+static OPUS_INLINE opus_int32 silk_mm_hsum_epi32( __m128i x )
+{
+    x = _mm_add_epi32( x, _mm_shuffle_epi32( x, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+    x = _mm_add_epi32( x, _mm_shuffle_epi32( x, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+    return _mm_cvtsi128_si32( x );
+}
+
+opus_int16 *silk_resampler_private_IIR_FIR_INTERPOL_sse4_1(
+    opus_int16                      *out,           /* O    Output signal               */
+    opus_int16                      *buf,           /* I    Upsampled signal            */
+    opus_int32                      max_index_Q16,  /* I    End of the input, Q16       */
+    opus_int32                      index_increment_Q16 /* I    Input step, Q16     */
+)
+{
+    opus_int32 index_Q16, res_Q15;
+    opus_int16 *buf_ptr;
+    opus_int32 table_index;
+    opus_int   i;
+    __m128i    coefs[ 12 ];
+
+    /* All 8 taps of each phase: the first half of the phase followed by the
+       second half of the mirrored phase, reversed. */
+    for( i = 0; i < 12; i++ ) {
+        coefs[ i ] = _mm_setr_epi16(
+            silk_resampler_frac_FIR_12[      i ][ 0 ], silk_resampler_frac_FIR_12[      i ][ 1 ],
+            silk_resampler_frac_FIR_12[      i ][ 2 ], silk_resampler_frac_FIR_12[      i ][ 3 ],
+            silk_resampler_frac_FIR_12[ 11 - i ][ 3 ], silk_resampler_frac_FIR_12[ 11 - i ][ 2 ],
+            silk_resampler_frac_FIR_12[ 11 - i ][ 1 ], silk_resampler_frac_FIR_12[ 11 - i ][ 0 ] );
+    }
+
+    /* Four output samples per iteration. The products and sums wrap exactly
+       like the 32-bit C arithmetic, so the order of the additions doesn't
+       matter. */
+    for( index_Q16 = 0; index_Q16 + 3 * index_increment_Q16 < max_index_Q16; index_Q16 += 4 * index_increment_Q16 ) {
+        __m128i acc0, acc1, acc2, acc3;
+        opus_int32 idx;
+
+        idx  = index_Q16;
+        acc0 = _mm_madd_epi16( _mm_loadu_si128( (__m128i *)&buf[ idx >> 16 ] ), coefs[ silk_SMULWB( idx & 0xFFFF, 12 ) ] );
+        idx += index_increment_Q16;
+        acc1 = _mm_madd_epi16( _mm_loadu_si128( (__m128i *)&buf[ idx >> 16 ] ), coefs[ silk_SMULWB( idx & 0xFFFF, 12 ) ] );
+        idx += index_increment_Q16;
+        acc2 = _mm_madd_epi16( _mm_loadu_si128( (__m128i *)&buf[ idx >> 16 ] ), coefs[ silk_SMULWB( idx & 0xFFFF, 12 ) ] );
+        idx += index_increment_Q16;
+        acc3 = _mm_madd_epi16( _mm_loadu_si128( (__m128i *)&buf[ idx >> 16 ] ), coefs[ silk_SMULWB( idx & 0xFFFF, 12 ) ] );
+
+        acc0 = _mm_hadd_epi32( _mm_hadd_epi32( acc0, acc1 ), _mm_hadd_epi32( acc2, acc3 ) );
+
+        /* silk_RSHIFT_ROUND( res_Q15, 15 ), then saturate to 16 bits */
+        acc0 = _mm_srai_epi32( _mm_add_epi32( _mm_srai_epi32( acc0, 14 ), _mm_set1_epi32( 1 ) ), 1 );
+        _mm_storel_epi64( (__m128i *)out, _mm_packs_epi32( acc0, acc0 ) );
+        out += 4;
+    }
+
+    for( ; index_Q16 < max_index_Q16; index_Q16 += index_increment_Q16 ) {
+        table_index = silk_SMULWB( index_Q16 & 0xFFFF, 12 );
+        buf_ptr = &buf[ index_Q16 >> 16 ];
+
+        res_Q15 = silk_mm_hsum_epi32( _mm_madd_epi16( _mm_loadu_si128( (__m128i *)buf_ptr ), coefs[ table_index ] ) );
+        *out++ = (opus_int16)silk_SAT16( silk_RSHIFT_ROUND( res_Q15, 15 ) );
+    }
+    return out;
+}
+
+opus_int16 *silk_resampler_private_down_FIR_INTERPOL_sse4_1(
+    opus_int16                      *out,           /* O    Output signal               */
+    opus_int32                      *buf,           /* I    Filtered signal, Q8         */
+    const opus_int16                *FIR_Coefs,     /* I    FIR coefficients, Q14       */
+    opus_int                        FIR_Order,      /* I    FIR order                   */
+    opus_int                        FIR_Fracs,      /* I    Number of FIR phases        */
+    opus_int32                      max_index_Q16,  /* I    End of the input, Q16       */
+    opus_int32                      index_increment_Q16 /* I    Input step, Q16     */
+)
+{
+    opus_int32 index_Q16, res_Q6;
+    opus_int32 *buf_ptr;
+    opus_int32 interpol_ind;
+    const opus_int16 *interpol_ptr;
+    __m128i    acc;
+
+    switch( FIR_Order ) {
+        case RESAMPLER_DOWN_ORDER_FIR0:
+        {
+            /* Coefficients of each phase for taps 0-15, as 32-bit values */
+            __m128i coefs[ 3 ][ 4 ];
+            opus_int i, k;
+            celt_assert( FIR_Fracs <= 3 );
+            for( i = 0; i < FIR_Fracs; i++ ) {
+                opus_int32 c[ 16 ];
+                interpol_ptr = &FIR_Coefs[ RESAMPLER_DOWN_ORDER_FIR0 / 2 * i ];
+                for( k = 0; k < 9; k++ ) {
+                    c[ k ] = interpol_ptr[ k ];
+                }
+                interpol_ptr = &FIR_Coefs[ RESAMPLER_DOWN_ORDER_FIR0 / 2 * ( FIR_Fracs - 1 - i ) ];
+                for( k = 9; k < 16; k++ ) {
+                    c[ k ] = interpol_ptr[ 17 - k ];
+                }
+                for( k = 0; k < 4; k++ ) {
+                    coefs[ i ][ k ] = _mm_loadu_si128( (__m128i *)&c[ 4 * k ] );
+                }
+            }
+            for( index_Q16 = 0; index_Q16 < max_index_Q16; index_Q16 += index_increment_Q16 ) {
+                /* Integer part gives pointer to buffered input */
+                buf_ptr = buf + silk_RSHIFT( index_Q16, 16 );
+
+                /* Fractional part gives interpolation coefficients */
+                interpol_ind = silk_SMULWB( index_Q16 & 0xFFFF, FIR_Fracs );
+
+                /* Inner product */
+                acc =                         silk_mm_smulwb_epi32( _mm_loadu_si128( (__m128i *)&buf_ptr[  0 ] ), coefs[ interpol_ind ][ 0 ] );
+                acc = _mm_add_epi32( acc,     silk_mm_smulwb_epi32( _mm_loadu_si128( (__m128i *)&buf_ptr[  4 ] ), coefs[ interpol_ind ][ 1 ] ) );
+                acc = _mm_add_epi32( acc,     silk_mm_smulwb_epi32( _mm_loadu_si128( (__m128i *)&buf_ptr[  8 ] ), coefs[ interpol_ind ][ 2 ] ) );
+                acc = _mm_add_epi32( acc,     silk_mm_smulwb_epi32( _mm_loadu_si128( (__m128i *)&buf_ptr[ 12 ] ), coefs[ interpol_ind ][ 3 ] ) );
+                res_Q6 = silk_mm_hsum_epi32( acc );
+                interpol_ptr = &FIR_Coefs[ RESAMPLER_DOWN_ORDER_FIR0 / 2 * ( FIR_Fracs - 1 - interpol_ind ) ];
+                res_Q6 = silk_SMLAWB( res_Q6, buf_ptr[ 17 ], interpol_ptr[ 0 ] );
+                res_Q6 = silk_SMLAWB( res_Q6, buf_ptr[ 16 ], interpol_ptr[ 1 ] );
+
+                /* Scale down, saturate and store in output array */
+                *out++ = (opus_int16)silk_SAT16( silk_RSHIFT_ROUND( res_Q6, 6 ) );
+            }
+            break;
+        }
+        case RESAMPLER_DOWN_ORDER_FIR1:
+        {
+            __m128i coefs[ 3 ];
+            opus_int k;
+            for( k = 0; k < 3; k++ ) {
+                coefs[ k ] = _mm_cvtepi16_epi32( _mm_loadl_epi64( (__m128i *)&FIR_Coefs[ 4 * k ] ) );
+            }
+            for( index_Q16 = 0; index_Q16 < max_index_Q16; index_Q16 += index_increment_Q16 ) {
+                /* Integer part gives pointer to buffered input */
+                buf_ptr = buf + silk_RSHIFT( index_Q16, 16 );
+
+                /* Inner product of the symmetric filter */
+                acc = _mm_setzero_si128();
+                for( k = 0; k < 3; k++ ) {
+                    __m128i x;
+                    x = _mm_add_epi32( _mm_loadu_si128( (__m128i *)&buf_ptr[ 4 * k ] ),
+                        _mm_shuffle_epi32( _mm_loadu_si128( (__m128i *)&buf_ptr[ 20 - 4 * k ] ), _MM_SHUFFLE( 0, 1, 2, 3 ) ) );
+                    acc = _mm_add_epi32( acc, silk_mm_smulwb_epi32( x, coefs[ k ] ) );
+                }
+                res_Q6 = silk_mm_hsum_epi32( acc );
+
+                /* Scale down, saturate and store in output array */
+                *out++ = (opus_int16)silk_SAT16( silk_RSHIFT_ROUND( res_Q6, 6 ) );
+            }
+            break;
+        }
+        case RESAMPLER_DOWN_ORDER_FIR2:
+        {
+            __m128i coefs[ 4 ];
+            opus_int k;
+            for( k = 0; k < 4; k++ ) {
+                coefs[ k ] = _mm_cvtepi16_epi32( _mm_loadl_epi64( (__m128i *)&FIR_Coefs[ 4 * k ] ) );
+            }
+            for( index_Q16 = 0; index_Q16 < max_index_Q16; index_Q16 += index_increment_Q16 ) {
+                /* Integer part gives pointer to buffered input */
+                buf_ptr = buf + silk_RSHIFT( index_Q16, 16 );
+
+                /* Inner product of the symmetric filter */
+                acc = _mm_setzero_si128();
+                for( k = 0; k < 4; k++ ) {
+                    __m128i x;
+                    x = _mm_add_epi32( _mm_loadu_si128( (__m128i *)&buf_ptr[ 4 * k ] ),
+                        _mm_shuffle_epi32( _mm_loadu_si128( (__m128i *)&buf_ptr[ 32 - 4 * k ] ), _MM_SHUFFLE( 0, 1, 2, 3 ) ) );
+                    acc = _mm_add_epi32( acc, silk_mm_smulwb_epi32( x, coefs[ k ] ) );
+                }
+                res_Q6 = silk_mm_hsum_epi32( acc );
+                res_Q6 = silk_SMLAWB( res_Q6, silk_ADD32( buf_ptr[ 16 ], buf_ptr[ 19 ] ), FIR_Coefs[ 16 ] );
+                res_Q6 = silk_SMLAWB( res_Q6, silk_ADD32( buf_ptr[ 17 ], buf_ptr[ 18 ] ), FIR_Coefs[ 17 ] );
+
+                /* Scale down, saturate and store in output array */
+                *out++ = (opus_int16)silk_SAT16( silk_RSHIFT_ROUND( res_Q6, 6 ) );
+            }
+            break;
+        }
+        default:
+            celt_assert( 0 );
+    }
+    return out;
+}
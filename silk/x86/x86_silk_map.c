@@ -33,10 +33,11 @@
 #include "structs.h"
 #include "SigProc_FIX.h"
 #ifndef FIXED_POINT
-#include "SigProc_FLP.h"
+#include "main_FLP.h"
 #endif
 #include "pitch.h"
 #include "main.h"
+#include "resampler_private.h"
 
 #if defined(OPUS_HAVE_RTCD) && !defined(OPUS_X86_PRESUME_AVX2)
 
@@ -53,7 +54,9 @@ opus_int64 (*const SILK_INNER_PROD16_IMPL[ OPUS_ARCHMASK + 1 ] )(
   silk_inner_prod16_c,
   silk_inner_prod16_c,
   MAY_HAVE_SSE4_1( silk_inner_prod16 ), /* sse4.1 */
-  MAY_HAVE_SSE4_1( silk_inner_prod16 )  /* avx */
+  MAY_HAVE_SSE4_1( silk_inner_prod16 ), /* avx */
+  MAY_HAVE_SSE4_1( silk_inner_prod16 ), /* avx-vnni */
+  MAY_HAVE_SSE4_1( silk_inner_prod16 )  /* avx512 */
 };
 
 #endif
@@ -66,7 +69,9 @@ opus_int (*const SILK_VAD_GETSA_Q8_IMPL[ OPUS_ARCHMASK + 1 ] )(
   silk_VAD_GetSA_Q8_c,
   silk_VAD_GetSA_Q8_c,
   MAY_HAVE_SSE4_1( silk_VAD_GetSA_Q8 ), /* sse4.1 */
-  MAY_HAVE_SSE4_1( silk_VAD_GetSA_Q8 )  /* avx */
+  MAY_HAVE_SSE4_1( silk_VAD_GetSA_Q8 ), /* avx */
+  MAY_HAVE_SSE4_1( silk_VAD_GetSA_Q8 ), /* avx-vnni */
+  MAY_HAVE_SSE4_1( silk_VAD_GetSA_Q8 )  /* avx512 */
 };
 
 void (*const SILK_NSQ_IMPL[ OPUS_ARCHMASK + 1 ] )(
@@ -90,7 +95,9 @@ void (*const SILK_NSQ_IMPL[ OPUS_ARCHMASK + 1 ] )(
   silk_NSQ_c,
   silk_NSQ_c,
   MAY_HAVE_SSE4_1( silk_NSQ ), /* sse4.1 */
-  MAY_HAVE_SSE4_1( silk_NSQ )  /* avx */
+  MAY_HAVE_SSE4_1( silk_NSQ ), /* avx */
+  MAY_HAVE_SSE4_1( silk_NSQ ), /* avx-vnni */
+  MAY_HAVE_SSE4_1( silk_NSQ )  /* avx512 */
 };
 
 void (*const SILK_VQ_WMAT_EC_IMPL[ OPUS_ARCHMASK + 1 ] )(
@@ -111,7 +118,9 @@ void (*const SILK_VQ_WMAT_EC_IMPL[ OPUS_ARCHMASK + 1 ] )(
   silk_VQ_WMat_EC_c,
   silk_VQ_WMat_EC_c,
   MAY_HAVE_SSE4_1( silk_VQ_WMat_EC ), /* sse4.1 */
-  MAY_HAVE_SSE4_1( silk_VQ_WMat_EC )  /* avx */
+  MAY_HAVE_SSE4_1( silk_VQ_WMat_EC ), /* avx */
+  MAY_HAVE_SSE4_1( silk_VQ_WMat_EC ), /* avx-vnni */
+  MAY_HAVE_SSE4_1( silk_VQ_WMat_EC )  /* avx512 */
 };
 
 void (*const SILK_NSQ_DEL_DEC_IMPL[ OPUS_ARCHMASK + 1 ] )(
@@ -135,7 +144,113 @@ void (*const SILK_NSQ_DEL_DEC_IMPL[ OPUS_ARCHMASK + 1 ] )(
   silk_NSQ_del_dec_c,
   silk_NSQ_del_dec_c,
   MAY_HAVE_SSE4_1( silk_NSQ_del_dec ), /* sse4.1 */
-  MAY_HAVE_AVX2( silk_NSQ_del_dec )  /* avx */
+  MAY_HAVE_AVX2( silk_NSQ_del_dec ), /* avx */
+  MAY_HAVE_AVX2( silk_NSQ_del_dec ), /* avx-vnni */
+  MAY_HAVE_AVX2( silk_NSQ_del_dec )  /* avx512 */
+};
+
+void (*const SILK_LTP_SYNTHESIS_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    opus_int32                  pres_Q14[],                     /* O    LPC excitation [ length ]                   */
+    opus_int32                  sLTP_Q15[],                     /* I/O  LTP state, new samples from sLTP_Q15[ 0 ]   */
+    const opus_int32            exc_Q14[],                      /* I    Excitation [ length ]                       */
+    const opus_int16            B_Q14[ LTP_ORDER ],             /* I    LTP coefficients                            */
+    const opus_int              lag,                            /* I    Pitch lag                                   */
+    const opus_int              length                          /* I    Subframe length                             */
+) = {
+  silk_LTP_synthesis_c,                  /* non-sse */
+  silk_LTP_synthesis_c,
+  silk_LTP_synthesis_c,
+  MAY_HAVE_SSE4_1( silk_LTP_synthesis ), /* sse4.1 */
+  MAY_HAVE_AVX2( silk_LTP_synthesis ),   /* avx */
+  MAY_HAVE_AVX2( silk_LTP_synthesis ),   /* avx-vnni */
+  MAY_HAVE_AVX2( silk_LTP_synthesis )    /* avx512 */
+};
+
+void (*const SILK_LPC_SYNTHESIS_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    opus_int32                  sLPC_Q14[],                     /* I/O  State [ MAX_LPC_ORDER ], then output        */
+    const opus_int32            pres_Q14[],                     /* I    LPC excitation [ length ]                   */
+    const opus_int16            A_Q12[],                        /* I    Prediction coefficients [ order ]           */
+    const opus_int              order,                          /* I    Prediction order, 10 or 16                  */
+    const opus_int              length                          /* I    Signal length                               */
+) = {
+  silk_LPC_synthesis_c,                  /* non-sse */
+  silk_LPC_synthesis_c,
+  silk_LPC_synthesis_c,
+  MAY_HAVE_SSE4_1( silk_LPC_synthesis ), /* sse4.1 */
+  MAY_HAVE_SSE4_1( silk_LPC_synthesis ), /* avx */
+  MAY_HAVE_SSE4_1( silk_LPC_synthesis ), /* avx-vnni */
+  MAY_HAVE_SSE4_1( silk_LPC_synthesis )  /* avx512 */
+};
+
+void (*const SILK_NLSF_VQ_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    opus_int32                  err_Q24[],                      /* O    Quantization errors [K]                     */
+    const opus_int16            in_Q15[],                       /* I    Input vectors to be quantized [LPC_order]   */
+    const opus_uint8            pCB_Q8[],                       /* I    Codebook vectors [K*LPC_order]              */
+    const opus_int16            pWght_Q9[],                     /* I    Codebook weights [K*LPC_order]              */
+    const opus_int              K,                              /* I    Number of codebook vectors                  */
+    const opus_int              LPC_order                       /* I    Number of LPCs                              */
+) = {
+  silk_NLSF_VQ_c,                  /* non-sse */
+  silk_NLSF_VQ_c,
+  silk_NLSF_VQ_c,
+  MAY_HAVE_SSE4_1( silk_NLSF_VQ ), /* sse4.1 */
+  MAY_HAVE_AVX2( silk_NLSF_VQ ),   /* avx */
+  MAY_HAVE_AVX2( silk_NLSF_VQ ),   /* avx-vnni */
+  MAY_HAVE_AVX2( silk_NLSF_VQ )    /* avx512 */
+};
+
+opus_int32 (*const SILK_NLSF_DEL_DEC_QUANT_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    opus_int8                   indices[],                      /* O    Quantization indices [ order ]              */
+    const opus_int16            x_Q10[],                        /* I    Input [ order ]                             */
+    const opus_int16            w_Q5[],                         /* I    Weights [ order ]                           */
+    const opus_uint8            pred_coef_Q8[],                 /* I    Backward predictor coefs [ order ]          */
+    const opus_int16            ec_ix[],                        /* I    Indices to entropy coding tables [ order ]  */
+    const opus_uint8            ec_rates_Q5[],                  /* I    Rates []                                    */
+    const opus_int              quant_step_size_Q16,            /* I    Quantization step size                      */
+    const opus_int16            inv_quant_step_size_Q6,         /* I    Inverse quantization step size              */
+    const opus_int32            mu_Q20,                         /* I    R/D tradeoff                                */
+    const opus_int16            order                           /* I    Number of input values                      */
+) = {
+  silk_NLSF_del_dec_quant_c,                  /* non-sse */
+  silk_NLSF_del_dec_quant_c,
+  silk_NLSF_del_dec_quant_c,
+  MAY_HAVE_SSE4_1( silk_NLSF_del_dec_quant ), /* sse4.1 */
+  MAY_HAVE_SSE4_1( silk_NLSF_del_dec_quant ), /* avx */
+  MAY_HAVE_SSE4_1( silk_NLSF_del_dec_quant ), /* avx-vnni */
+  MAY_HAVE_SSE4_1( silk_NLSF_del_dec_quant )  /* avx512 */
+};
+
+opus_int16 *(*const SILK_RESAMPLER_PRIVATE_IIR_FIR_INTERPOL_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    opus_int16                      *out,           /* O    Output signal               */
+    opus_int16                      *buf,           /* I    Upsampled signal            */
+    opus_int32                      max_index_Q16,  /* I    End of the input, Q16       */
+    opus_int32                      index_increment_Q16 /* I    Input step, Q16     */
+) = {
+  silk_resampler_private_IIR_FIR_INTERPOL_c,                  /* non-sse */
+  silk_resampler_private_IIR_FIR_INTERPOL_c,
+  silk_resampler_private_IIR_FIR_INTERPOL_c,
+  MAY_HAVE_SSE4_1( silk_resampler_private_IIR_FIR_INTERPOL ), /* sse4.1 */
+  MAY_HAVE_AVX2( silk_resampler_private_IIR_FIR_INTERPOL ),   /* avx */
+  MAY_HAVE_AVX2( silk_resampler_private_IIR_FIR_INTERPOL ),   /* avx-vnni */
+  MAY_HAVE_AVX2( silk_resampler_private_IIR_FIR_INTERPOL )    /* avx512 */
+};
+
+opus_int16 *(*const SILK_RESAMPLER_PRIVATE_DOWN_FIR_INTERPOL_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    opus_int16                      *out,           /* O    Output signal               */
+    opus_int32                      *buf,           /* I    Filtered signal, Q8         */
+    const opus_int16                *FIR_Coefs,     /* I    FIR coefficients, Q14       */
+    opus_int                        FIR_Order,      /* I    FIR order                   */
+    opus_int                        FIR_Fracs,      /* I    Number of FIR phases        */
+    opus_int32                      max_index_Q16,  /* I    End of the input, Q16       */
+    opus_int32                      index_increment_Q16 /* I    Input step, Q16     */
+) = {
+  silk_resampler_private_down_FIR_INTERPOL_c,                  /* non-sse */
+  silk_resampler_private_down_FIR_INTERPOL_c,
+  silk_resampler_private_down_FIR_INTERPOL_c,
+  MAY_HAVE_SSE4_1( silk_resampler_private_down_FIR_INTERPOL ), /* sse4.1 */
+  MAY_HAVE_AVX2( silk_resampler_private_down_FIR_INTERPOL ),   /* avx */
+  MAY_HAVE_AVX2( silk_resampler_private_down_FIR_INTERPOL ),   /* avx-vnni */
+  MAY_HAVE_AVX2( silk_resampler_private_down_FIR_INTERPOL )    /* avx512 */
 };
 
 #if defined(FIXED_POINT)
@@ -155,7 +270,9 @@ void (*const SILK_BURG_MODIFIED_IMPL[ OPUS_ARCHMASK + 1 ] )(
   silk_burg_modified_c,
   silk_burg_modified_c,
   MAY_HAVE_SSE4_1( silk_burg_modified ), /* sse4.1 */
-  MAY_HAVE_SSE4_1( silk_burg_modified )  /* avx */
+  MAY_HAVE_SSE4_1( silk_burg_modified ), /* avx */
+  MAY_HAVE_SSE4_1( silk_burg_modified ), /* avx-vnni */
+  MAY_HAVE_SSE4_1( silk_burg_modified )  /* avx512 */
 };
 
 #endif
@@ -171,7 +288,92 @@ double (*const SILK_INNER_PRODUCT_FLP_IMPL[ OPUS_ARCHMASK + 1 ] )(
   silk_inner_product_FLP_c,
   silk_inner_product_FLP_c,
   silk_inner_product_FLP_c, /* sse4.1 */
-  MAY_HAVE_AVX2( silk_inner_product_FLP )  /* avx */
+  MAY_HAVE_AVX2( silk_inner_product_FLP ), /* avx */
+  MAY_HAVE_AVX2( silk_inner_product_FLP ), /* avx-vnni */
+  MAY_HAVE_AVX2( silk_inner_product_FLP )  /* avx512 */
+};
+
+silk_float (*const SILK_BURG_MODIFIED_FLP_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    silk_float          A[],                /* O    prediction coefficients (length order)                      */
+    const silk_float    x[],                /* I    input signal, length: nb_subfr*(D+L_sub)                    */
+    const silk_float    minInvGain,         /* I    minimum inverse prediction gain                             */
+    const opus_int      subfr_length,       /* I    input signal subframe length (incl. D preceding samples)    */
+    const opus_int      nb_subfr,           /* I    number of subframes stacked in x                            */
+    const opus_int      D,                  /* I    order                                                       */
+    int                 arch                /* I    Run-time architecture                                       */
+) = {
+  silk_burg_modified_FLP_c,                  /* non-sse */
+  silk_burg_modified_FLP_c,
+  silk_burg_modified_FLP_c,
+  silk_burg_modified_FLP_c, /* sse4.1 */
+  MAY_HAVE_AVX2( silk_burg_modified_FLP ), /* avx */
+  MAY_HAVE_AVX2( silk_burg_modified_FLP ), /* avx-vnni */
+  MAY_HAVE_AVX2( silk_burg_modified_FLP )  /* avx512 */
+};
+
+void (*const SILK_WARPED_AUTOCORRELATION_FLP_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    silk_float          *corr,              /* O    Result [order + 1]                                          */
+    const silk_float    *input,             /* I    Input data to correlate                                     */
+    const silk_float    warping,            /* I    Warping coefficient                                         */
+    const opus_int      length,             /* I    Length of input                                             */
+    const opus_int      order               /* I    Correlation order (even)                                    */
+) = {
+  silk_warped_autocorrelation_FLP_c,                  /* non-sse */
+  silk_warped_autocorrelation_FLP_c,
+  silk_warped_autocorrelation_FLP_c,
+  silk_warped_autocorrelation_FLP_c, /* sse4.1 */
+  MAY_HAVE_AVX2( silk_warped_autocorrelation_FLP ), /* avx */
+  MAY_HAVE_AVX2( silk_warped_autocorrelation_FLP ), /* avx-vnni */
+  MAY_HAVE_AVX2( silk_warped_autocorrelation_FLP )  /* avx512 */
+};
+
+void (*const SILK_LPC_ANALYSIS_FILTER_FLP_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    silk_float          r_LPC[],            /* O    LPC residual signal                                         */
+    const silk_float    PredCoef[],         /* I    LPC coefficients                                            */
+    const silk_float    s[],                /* I    Input signal                                                */
+    const opus_int      length,             /* I    Length of input signal                                      */
+    const opus_int      Order               /* I    LPC order                                                   */
+) = {
+  silk_LPC_analysis_filter_FLP_c,                  /* non-sse */
+  silk_LPC_analysis_filter_FLP_c,
+  silk_LPC_analysis_filter_FLP_c,
+  silk_LPC_analysis_filter_FLP_c, /* sse4.1 */
+  MAY_HAVE_AVX2( silk_LPC_analysis_filter_FLP ), /* avx */
+  MAY_HAVE_AVX2( silk_LPC_analysis_filter_FLP ), /* avx-vnni */
+  MAY_HAVE_AVX2( silk_LPC_analysis_filter_FLP )  /* avx512 */
+};
+
+void (*const SILK_CORRMATRIX_FLP_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    const silk_float    *x,                 /* I    x vector [ L+order-1 ] used to create X                     */
+    const opus_int      L,                  /* I    Length of vectors                                           */
+    const opus_int      Order,              /* I    Max lag for correlation                                     */
+    silk_float          *XX,                /* O    X'*X correlation matrix [order x order]                     */
+    int                 arch                /* I    Run-time architecture                                       */
+) = {
+  silk_corrMatrix_FLP_c,                  /* non-sse */
+  silk_corrMatrix_FLP_c,
+  silk_corrMatrix_FLP_c,
+  silk_corrMatrix_FLP_c, /* sse4.1 */
+  MAY_HAVE_AVX2( silk_corrMatrix_FLP ), /* avx */
+  MAY_HAVE_AVX2( silk_corrMatrix_FLP ), /* avx-vnni */
+  MAY_HAVE_AVX2( silk_corrMatrix_FLP )  /* avx512 */
+};
+
+void (*const SILK_CORRVECTOR_FLP_IMPL[ OPUS_ARCHMASK + 1 ] )(
+    const silk_float    *x,                 /* I    x vector [L+order-1] used to create X                       */
+    const silk_float    *t,                 /* I    Target vector [L]                                           */
+    const opus_int      L,                  /* I    Length of vectors                                           */
+    const opus_int      Order,              /* I    Max lag for correlation                                     */
+    silk_float          *Xt,                /* O    X'*t correlation vector [order]                             */
+    int                 arch                /* I    Run-time architecture                                       */
+) = {
+  silk_corrVector_FLP_c,                  /* non-sse */
+  silk_corrVector_FLP_c,
+  silk_corrVector_FLP_c,
+  silk_corrVector_FLP_c, /* sse4.1 */
+  MAY_HAVE_AVX2( silk_corrVector_FLP ), /* avx */
+  MAY_HAVE_AVX2( silk_corrVector_FLP ), /* avx-vnni */
+  MAY_HAVE_AVX2( silk_corrVector_FLP )  /* avx512 */
 };
 
 #endif
@@ -22,6 +22,7 @@ silk/resampler_rom.h \
 silk/resampler_structs.h \
 silk/SigProc_FIX.h \
 silk/x86/SigProc_FIX_sse.h \
+silk/x86/resampler_sse.h \
 silk/arm/biquad_alt_arm.h \
 silk/arm/LPC_inv_pred_gain_arm.h \
 silk/arm/macros_armv4.h \
@@ -30,7 +31,10 @@ silk/arm/macros_arm64.h \
 silk/arm/SigProc_FIX_armv4.h \
 silk/arm/SigProc_FIX_armv5e.h \
 silk/arm/NSQ_del_dec_arm.h \
+silk/arm/decode_core_arm.h \
+silk/arm/NLSF_encode_arm.h \
 silk/arm/NSQ_neon.h \
+silk/arm/resampler_arm.h \
 silk/fixed/main_FIX.h \
 silk/fixed/structs_FIX.h \
 silk/fixed/arm/warped_autocorrelation_FIX_arm.h \
@@ -39,6 +43,7 @@ silk/fixed/mips/warped_autocorrelation_FIX_mipsr1.h \
 silk/float/main_FLP.h \
 silk/float/structs_FLP.h \
 silk/float/SigProc_FLP.h \
+silk/float/arm/SigProc_FLP_arm.h \
 silk/mips/macros_mipsr1.h \
 silk/mips/NSQ_del_dec_mipsr1.h \
 silk/mips/sigproc_fix_mipsr1.h
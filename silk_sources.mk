@@ -13,6 +13,7 @@ silk/enc_API.c \
 silk/encode_indices.c \
 silk/encode_pulses.c \
 silk/gain_quant.c \
+silk/predict_gain_mult.c \
 silk/interpolate.c \
 silk/LP_variable_cutoff.c \
 silk/NLSF_decode.c \
@@ -81,21 +82,30 @@ SILK_SOURCES_X86_RTCD = \
 silk/x86/x86_silk_map.c
 
 SILK_SOURCES_SSE4_1 = \
+silk/x86/decode_core_sse4_1.c \
+silk/x86/NLSF_encode_sse4_1.c \
 silk/x86/NSQ_sse4_1.c \
 silk/x86/NSQ_del_dec_sse4_1.c \
+silk/x86/resampler_sse4_1.c \
 silk/x86/VAD_sse4_1.c \
 silk/x86/VQ_WMat_EC_sse4_1.c
 
 SILK_SOURCES_AVX2 =  \
-silk/x86/NSQ_del_dec_avx2.c
+silk/x86/decode_core_avx2.c \
+silk/x86/NLSF_encode_avx2.c \
+silk/x86/NSQ_del_dec_avx2.c \
+silk/x86/resampler_avx2.c
 
 SILK_SOURCES_ARM_RTCD = \
 silk/arm/arm_silk_map.c
 
 SILK_SOURCES_ARM_NEON_INTR = \
 silk/arm/biquad_alt_neon_intr.c \
+silk/arm/decode_core_neon_intr.c \
+silk/arm/NLSF_encode_neon_intr.c \
 silk/arm/LPC_inv_pred_gain_neon_intr.c \
 silk/arm/NSQ_del_dec_neon_intr.c \
+silk/arm/resampler_neon_intr.c \
 silk/arm/NSQ_neon.c
 
 SILK_SOURCES_FIXED = \
@@ -160,5 +170,14 @@ silk/float/scale_vector_FLP.c \
 silk/float/schur_FLP.c \
 silk/float/sort_FLP.c
 
+SILK_SOURCES_FLOAT_ARM_NEON_INTR = \
+silk/float/arm/inner_product_FLP_neon_intr.c \
+silk/float/arm/LPC_analysis_filter_FLP_neon_intr.c \
+silk/float/arm/warped_autocorrelation_FLP_neon_intr.c
+
 SILK_SOURCES_FLOAT_AVX2 = \
-silk/float/x86/inner_product_FLP_avx2.c
\ No newline at end of file
+silk/float/x86/inner_product_FLP_avx2.c \
+silk/float/x86/burg_modified_FLP_avx2.c \
+silk/float/x86/corrMatrix_FLP_avx2.c \
+silk/float/x86/LPC_analysis_filter_FLP_avx2.c \
+silk/float/x86/warped_autocorrelation_FLP_avx2.c
\ No newline at end of file
@@ -31,12 +31,15 @@
 
 #include "opus.h"
 #include "opus_private.h"
+#include "celt_output.h"
+#include "stack_alloc.h"
 
 #ifndef DISABLE_FLOAT_API
-OPUS_EXPORT void opus_pcm_soft_clip(float *_x, int N, int C, float *declip_mem)
+void opus_pcm_soft_clip_impl(float *_x, int N, int C, float *declip_mem, int arch)
 {
    int c;
    int i;
+   int all_within1;
    float *x;
 
    if (C<1 || N<1 || !_x || !declip_mem) return;
@@ -45,14 +48,17 @@ OPUS_EXPORT void opus_pcm_soft_clip(float *_x, int N, int C, float *declip_mem)
       non-linearity can handle. At the point where the signal reaches +/-2,
       the derivative will be zero anyway, so this doesn't introduce any
       discontinuity in the derivative. */
-   for (i=0;i<N*C;i++)
-      _x[i] = MAX16(-2.f, MIN16(2.f, _x[i]));
+   all_within1 = opus_limit2_checkwithin1(_x, N*C, arch);
    for (c=0;c<C;c++)
    {
       float a;
       float x0;
       int curr;
 
+      /* Nothing to clip and no non-linearity left over from the previous
+         frame: the loop below would leave this channel unchanged. */
+      if (all_within1 && declip_mem[c] == 0)
+         continue;
       x = _x+c;
       a = declip_mem[c];
       /* Continue applying the non-linearity from the previous frame to avoid
@@ -135,7 +141,22 @@ OPUS_EXPORT void opus_pcm_soft_clip(float *_x, int N, int C, float *declip_mem)
       declip_mem[c] = a;
    }
 }
+
+OPUS_EXPORT void opus_pcm_soft_clip(float *_x, int N, int C, float *declip_mem)
+{
+   opus_pcm_soft_clip_impl(_x, N, C, declip_mem, opus_select_arch());
+}
+#endif
+
+void opus_thread_scratch_release(void)
+{
+#ifdef SCRATCH_ARENA
+   opus_scratch_unwind(0);
+   if (scratch_fallback != 0)
+      opus_free(scratch_fallback);
+   scratch_ptr = global_stack = global_stack_top = scratch_fallback = 0;
 #endif
+}
 
 int encode_size(int size, unsigned char *data)
 {
@@ -360,3 +381,46 @@ int opus_packet_parse(const unsigned char *data, opus_int32 len,
                                  frames, size, payload_offset, NULL, NULL, NULL);
 }
 
+
+#ifndef ENABLE_DEEP_PLC
+/* Without any DNN feature there is nothing to share; see dnn/dnn_model.c. */
+OpusDNNModel *opus_dnn_model_create(const unsigned char *data, opus_int32 len, int *error)
+{
+   (void)data;
+   (void)len;
+   if (error)
+      *error = OPUS_UNIMPLEMENTED;
+   return NULL;
+}
+
+OpusDNNModel *opus_dnn_model_create_mapped(const unsigned char *data, opus_int32 len, int *error)
+{
+   return opus_dnn_model_create(data, len, error);
+}
+
+void opus_dnn_model_destroy(OpusDNNModel *model)
+{
+   (void)model;
+}
+
+/* Likewise there is nothing to govern; see dnn/dnn_governor.c. */
+OpusDNNGovernor *opus_dnn_governor_create(opus_int32 budget, int *error)
+{
+   (void)budget;
+   if (error)
+      *error = OPUS_UNIMPLEMENTED;
+   return NULL;
+}
+
+int opus_dnn_governor_get_stats(const OpusDNNGovernor *governor, OpusDNNGovernorStats *stats)
+{
+   (void)governor;
+   (void)stats;
+   return OPUS_UNIMPLEMENTED;
+}
+
+void opus_dnn_governor_destroy(OpusDNNGovernor *governor)
+{
+   (void)governor;
+}
+#endif
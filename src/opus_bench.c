@@ -0,0 +1,797 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/* Performance harness: times the run-time dispatched kernels at every
+   available arch level and full encode/decode runs at every complexity,
+   and writes the results as JSON. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "opus.h"
+#include "opus_private.h"
+#include "cpu_support.h"
+#include "os_support.h"
+#include "modes.h"
+#include "mdct.h"
+#include "pitch.h"
+#include "vq.h"
+#include "celt.h"
+#include "celt_output.h"
+#include "main.h"
+#ifdef ENABLE_DEEP_PLC
+#include "nnet.h"
+#endif
+
+#define MAX_PACKET 1500
+#define MAX_FRAME_SAMPLES 960
+
+#ifndef M_PI
+#define M_PI 3.141592653
+#endif
+
+static double kernel_min_ns = 50e6;
+
+static double bench_now_ns(void)
+{
+#if defined(_WIN32)
+   LARGE_INTEGER count, freq;
+   QueryPerformanceCounter(&count);
+   QueryPerformanceFrequency(&freq);
+   return (double)count.QuadPart*1e9/(double)freq.QuadPart;
+#elif defined(CLOCK_MONOTONIC)
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec*1e9 + ts.tv_nsec;
+#else
+   return clock()*(1e9/CLOCKS_PER_SEC);
+#endif
+}
+
+static opus_uint32 bench_seed = 1;
+
+static float bench_rand(void)
+{
+   bench_seed = 1664525*bench_seed + 1013904223;
+   return (float)((opus_int32)bench_seed)*(1.f/2147483648.f);
+}
+
+/* Voiced, syllable-modulated harmonic signal with a little noise, so that
+   the encoders take their speech code paths. */
+static void bench_signal(opus_int16 *pcm, int len, int channels, opus_int32 Fs)
+{
+   int i, c, k;
+   double phase = 0;
+   for (i=0;i<len;i++)
+   {
+      double t = (double)i/Fs;
+      double f0 = 140 + 40*sin(2*M_PI*.7*t);
+      double env = .5 + .5*sin(2*M_PI*4*t);
+      double x = 0;
+      phase += 2*M_PI*f0/Fs;
+      for (k=1;k*f0<Fs/2 && k<=20;k++)
+         x += sin(k*phase)/k;
+      for (c=0;c<channels;c++)
+      {
+         double y = 6000*env*env*x + 300*bench_rand();
+         if (c==1) y *= .7;
+         pcm[i*channels+c] = (opus_int16)floor(.5 + (y > 32767 ? 32767 : y < -32768 ? -32768 : y));
+      }
+   }
+}
+
+static void bench_fill_val16(opus_val16 *x, int len)
+{
+   int i;
+   for (i=0;i<len;i++)
+#ifdef FIXED_POINT
+      x[i] = (opus_val16)(8192*bench_rand());
+#else
+      x[i] = bench_rand();
+#endif
+}
+
+#ifdef ENABLE_DEEP_PLC
+/* On x86 the AVX-VNNI level (5) is not implied by the AVX-512 one (6), so
+   it can only be exercised when it is the level that was detected. */
+static int bench_arch_usable(int arch, int max_arch)
+{
+#if defined(OPUS_HAVE_RTCD) && (defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64))
+   return !(arch == 5 && max_arch == 6);
+#else
+   (void)arch;
+   (void)max_arch;
+   return 1;
+#endif
+}
+#endif
+
+static const char *bench_arch_name(int arch)
+{
+#ifdef OPUS_HAVE_RTCD
+# if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+   static const char *const names[] = {"c", "sse", "sse2", "sse4.1", "avx2", "avx-vnni", "avx512"};
+# else
+   static const char *const names[] = {"armv4", "armv5e", "armv6", "neon", "dotprod"};
+# endif
+   if (arch >= 0 && arch < (int)(sizeof(names)/sizeof(names[0])))
+      return names[arch];
+   return "unknown";
+#else
+   (void)arch;
+   return "native";
+#endif
+}
+
+typedef void (*kernel_func)(void *ctx, int arch);
+
+typedef struct {
+   FILE *out;
+   int first;
+} JSONList;
+
+static void json_item(JSONList *list)
+{
+   fprintf(list->out, "%s\n    ", list->first ? "" : ",");
+   list->first = 0;
+}
+
+/* Runs the kernel in batches of doubling size until a batch takes at least
+   kernel_min_ns, and reports the time per call of that batch. */
+static void bench_kernel(JSONList *list, const char *name, const char *params,
+      kernel_func func, void *ctx, int arch)
+{
+   opus_int64 calls = 16;
+   double elapsed;
+   opus_int64 i;
+   func(ctx, arch);
+   for (;;)
+   {
+      double start = bench_now_ns();
+      for (i=0;i<calls;i++)
+         func(ctx, arch);
+      elapsed = bench_now_ns() - start;
+      if (elapsed >= kernel_min_ns || calls >= ((opus_int64)1<<40))
+         break;
+      calls *= 2;
+   }
+   json_item(list);
+   fprintf(list->out, "{\"name\": \"%s\", \"params\": \"%s\", \"arch\": %d, \"arch_name\": \"%s\", "
+         "\"calls\": %lld, \"ns_per_call\": %.1f}",
+         name, params, arch, bench_arch_name(arch), (long long)calls, elapsed/calls);
+}
+
+typedef struct {
+   opus_val16 x[240];
+   opus_val16 y[240+256];
+   opus_val32 xcorr[256];
+} PitchCtx;
+
+static void kernel_pitch_xcorr(void *ctx, int arch)
+{
+   PitchCtx *c = (PitchCtx*)ctx;
+   celt_pitch_xcorr(c->x, c->y, c->xcorr, 240, 256, arch);
+}
+
+static void kernel_xcorr(void *ctx, int arch)
+{
+   PitchCtx *c = (PitchCtx*)ctx;
+   xcorr_kernel(c->x, c->y, c->xcorr, 240, arch);
+}
+
+typedef struct {
+   celt_norm X[16];
+   int iy[16+3];
+} PVQCtx;
+
+static void kernel_pvq_search(void *ctx, int arch)
+{
+   PVQCtx *c = (PVQCtx*)ctx;
+   op_pvq_search(c->X, c->iy, 10, 16, arch);
+}
+
+typedef struct {
+   const CELTMode *mode;
+   celt_sig sig[2][COMBFILTER_MAXPERIOD+960];
+   celt_sig mem[2];
+   opus_val16 pcm[2*960];
+   opus_int16 pcm16[2*960];
+} OutputCtx;
+
+static void kernel_comb_filter(void *ctx, int arch)
+{
+   OutputCtx *c = (OutputCtx*)ctx;
+   comb_filter(c->sig[1]+COMBFILTER_MAXPERIOD, c->sig[0]+COMBFILTER_MAXPERIOD, 300, 310, 960,
+         QCONST16(.4f, 15), QCONST16(.5f, 15), 0, 1, c->mode->window, c->mode->overlap, arch);
+}
+
+static void kernel_deemphasis(void *ctx, int arch)
+{
+   OutputCtx *c = (OutputCtx*)ctx;
+   deemphasis_stereo(c->sig[0], c->sig[1], c->pcm, 960, c->mode->preemph[0], c->mem, arch);
+}
+
+#if !defined(FIXED_POINT) && !defined(DISABLE_FLOAT_API)
+static void kernel_float2int16(void *ctx, int arch)
+{
+   OutputCtx *c = (OutputCtx*)ctx;
+   celt_float2int16(c->pcm, c->pcm16, 2*960, arch);
+}
+#endif
+
+typedef struct {
+   const CELTMode *mode;
+   kiss_fft_scalar in[960+120];
+   kiss_fft_scalar out[960];
+} MDCTCtx;
+
+static void kernel_mdct(void *ctx, int arch)
+{
+   MDCTCtx *c = (MDCTCtx*)ctx;
+   clt_mdct_forward(&c->mode->mdct, c->in, c->out, c->mode->window,
+         c->mode->overlap, 0, 1, arch);
+}
+
+typedef struct {
+   silk_encoder_state enc;
+   silk_nsq_state nsq;
+   SideInfoIndices indices;
+   opus_int16 x16[320];
+   opus_int8 pulses[320];
+   opus_int16 PredCoef_Q12[2*MAX_LPC_ORDER];
+   opus_int16 LTPCoef_Q14[LTP_ORDER*MAX_NB_SUBFR];
+   opus_int16 AR_Q13[MAX_NB_SUBFR*MAX_SHAPE_LPC_ORDER];
+   opus_int HarmShapeGain_Q14[MAX_NB_SUBFR];
+   opus_int Tilt_Q14[MAX_NB_SUBFR];
+   opus_int32 LF_shp_Q14[MAX_NB_SUBFR];
+   opus_int32 Gains_Q16[MAX_NB_SUBFR];
+   opus_int pitchL[MAX_NB_SUBFR];
+} NSQCtx;
+
+/* A 20 ms voiced wideband frame quantized with the maximum number of
+   delayed-decision states, as at complexity 10. */
+static void bench_nsq_init(NSQCtx *c)
+{
+   int i;
+   OPUS_CLEAR(c, 1);
+   c->enc.nb_subfr = MAX_NB_SUBFR;
+   c->enc.subfr_length = 80;
+   c->enc.frame_length = 320;
+   c->enc.ltp_mem_length = 320;
+   c->enc.predictLPCOrder = MAX_LPC_ORDER;
+   c->enc.shapingLPCOrder = MAX_SHAPE_LPC_ORDER;
+   c->enc.nStatesDelayedDecision = MAX_DEL_DEC_STATES;
+   c->nsq.prev_gain_Q16 = 65536;
+   c->indices.signalType = TYPE_VOICED;
+   c->indices.NLSFInterpCoef_Q2 = 4;
+   bench_signal(c->x16, 320, 1, 16000);
+   c->PredCoef_Q12[0] = c->PredCoef_Q12[MAX_LPC_ORDER] = 2048;
+   for (i=0;i<MAX_NB_SUBFR;i++)
+   {
+      c->LTPCoef_Q14[i*LTP_ORDER+LTP_ORDER/2] = 6554;
+      c->AR_Q13[i*MAX_SHAPE_LPC_ORDER] = 2458;
+      c->HarmShapeGain_Q14[i] = 4000;
+      c->Tilt_Q14[i] = -2000;
+      c->Gains_Q16[i] = 100<<16;
+      c->pitchL[i] = 100;
+   }
+}
+
+static void kernel_nsq_del_dec(void *ctx, int arch)
+{
+   NSQCtx *c = (NSQCtx*)ctx;
+   silk_NSQ_del_dec(&c->enc, &c->nsq, &c->indices, c->x16, c->pulses, c->PredCoef_Q12,
+         c->LTPCoef_Q14, c->AR_Q13, c->HarmShapeGain_Q14, c->Tilt_Q14, c->LF_shp_Q14,
+         c->Gains_Q16, c->pitchL, 1024, 15565, arch);
+}
+
+typedef struct {
+   silk_resampler_state_struct state;
+   opus_int16 in[960];
+   opus_int16 out[960];
+   int in_len;
+} ResamplerCtx;
+
+static void kernel_resampler(void *ctx, int arch)
+{
+   ResamplerCtx *c = (ResamplerCtx*)ctx;
+   silk_resampler(&c->state, c->out, c->in, c->in_len, arch);
+}
+
+/* One 5 ms wideband subframe of the decoder's LTP and LPC synthesis */
+typedef struct {
+   opus_int32 sLTP_Q15[320+80];
+   opus_int32 sLPC_Q14[MAX_LPC_ORDER+80];
+   opus_int32 exc_Q14[80];
+   opus_int32 res_Q14[80];
+   opus_int16 A_Q12[MAX_LPC_ORDER];
+   opus_int16 B_Q14[LTP_ORDER];
+} SynthesisCtx;
+
+static void bench_synthesis_init(SynthesisCtx *c)
+{
+   int i;
+   OPUS_CLEAR(c, 1);
+   for (i=0;i<320;i++)
+      c->sLTP_Q15[i] = (opus_int32)(100000*bench_rand());
+   for (i=0;i<MAX_LPC_ORDER;i++)
+   {
+      c->sLPC_Q14[i] = (opus_int32)(100000*bench_rand());
+      c->A_Q12[i] = (opus_int16)(2048*bench_rand());
+   }
+   for (i=0;i<80;i++)
+      c->exc_Q14[i] = (opus_int32)(100000*bench_rand());
+   c->B_Q14[LTP_ORDER/2] = 6554;
+}
+
+static void kernel_LTP_synthesis(void *ctx, int arch)
+{
+   SynthesisCtx *c = (SynthesisCtx*)ctx;
+   silk_LTP_synthesis(c->res_Q14, &c->sLTP_Q15[320], c->exc_Q14, c->B_Q14, 100, 80, arch);
+}
+
+static void kernel_LPC_synthesis(void *ctx, int arch)
+{
+   SynthesisCtx *c = (SynthesisCtx*)ctx;
+   silk_LPC_synthesis(c->sLPC_Q14, c->exc_Q14, c->A_Q12, MAX_LPC_ORDER, 80, arch);
+}
+
+/* Wideband NLSF quantization with the survivors used at complexity 10 */
+typedef struct {
+   opus_int16 in_Q15[MAX_LPC_ORDER];
+   opus_int16 NLSF_Q15[MAX_LPC_ORDER];
+   opus_int16 W_QW[MAX_LPC_ORDER];
+   opus_int8 indices[MAX_LPC_ORDER+1];
+} NLSFCtx;
+
+static void bench_nlsf_init(NLSFCtx *c)
+{
+   int i;
+   OPUS_CLEAR(c, 1);
+   for (i=0;i<MAX_LPC_ORDER;i++)
+      c->in_Q15[i] = (opus_int16)((i+1)*32768/(MAX_LPC_ORDER+1) + 600*bench_rand());
+   silk_NLSF_VQ_weights_laroia(c->W_QW, c->in_Q15, MAX_LPC_ORDER);
+}
+
+static void kernel_NLSF_encode(void *ctx, int arch)
+{
+   NLSFCtx *c = (NLSFCtx*)ctx;
+   OPUS_COPY(c->NLSF_Q15, c->in_Q15, MAX_LPC_ORDER);
+   silk_NLSF_encode(c->indices, c->NLSF_Q15, &silk_NLSF_CB_WB, c->W_QW,
+         SILK_FIX_CONST(0.003, 20), 16, TYPE_VOICED, arch);
+}
+
+#ifdef ENABLE_DEEP_PLC
+#define LINEAR_SIZE 256
+
+typedef struct {
+   LinearLayer layer;
+   float bias[LINEAR_SIZE];
+   float subias[LINEAR_SIZE];
+   float scale[LINEAR_SIZE];
+   float float_weights[LINEAR_SIZE*LINEAR_SIZE];
+   opus_int8 weights[LINEAR_SIZE*LINEAR_SIZE];
+   float in[LINEAR_SIZE];
+   float out[LINEAR_SIZE];
+} LinearCtx;
+
+static void bench_linear_init(LinearCtx *c, int quantized)
+{
+   int i;
+   OPUS_CLEAR(c, 1);
+   for (i=0;i<LINEAR_SIZE;i++)
+   {
+      c->bias[i] = c->subias[i] = .1f*bench_rand();
+      c->scale[i] = 1.f/128;
+      c->in[i] = .9f*bench_rand();
+   }
+   for (i=0;i<LINEAR_SIZE*LINEAR_SIZE;i++)
+   {
+      c->float_weights[i] = .1f*bench_rand();
+      c->weights[i] = (opus_int8)(127*bench_rand());
+   }
+   c->layer.bias = c->bias;
+   c->layer.subias = c->subias;
+   c->layer.scale = c->scale;
+   if (quantized)
+      c->layer.weights = c->weights;
+   else
+      c->layer.float_weights = c->float_weights;
+   c->layer.nb_inputs = LINEAR_SIZE;
+   c->layer.nb_outputs = LINEAR_SIZE;
+}
+
+static void kernel_linear(void *ctx, int arch)
+{
+   LinearCtx *c = (LinearCtx*)ctx;
+   compute_linear(&c->layer, c->out, c->in, arch);
+}
+#endif
+
+static void run_kernels(JSONList *list)
+{
+   int arch, first_arch, max_arch;
+   int err;
+   PitchCtx *pitch;
+   PVQCtx *pvq;
+   MDCTCtx *mdct;
+   OutputCtx *output;
+   NSQCtx *nsq;
+   SynthesisCtx *synthesis;
+   NLSFCtx *nlsf;
+   ResamplerCtx *resampler;
+#ifdef ENABLE_DEEP_PLC
+   LinearCtx *linear;
+#endif
+   max_arch = opus_select_arch();
+#ifdef OPUS_HAVE_RTCD
+   first_arch = 0;
+#else
+   first_arch = max_arch;
+#endif
+
+   pitch = (PitchCtx*)calloc(1, sizeof(*pitch));
+   bench_fill_val16(pitch->x, 240);
+   bench_fill_val16(pitch->y, 240+256);
+   for (arch=first_arch;arch<=max_arch;arch++)
+      bench_kernel(list, "celt_pitch_xcorr", "len=240,max_pitch=256", kernel_pitch_xcorr, pitch, arch);
+   for (arch=first_arch;arch<=max_arch;arch++)
+      bench_kernel(list, "xcorr_kernel", "len=240", kernel_xcorr, pitch, arch);
+   free(pitch);
+
+   pvq = (PVQCtx*)calloc(1, sizeof(*pvq));
+   bench_fill_val16(pvq->X, 16);
+   for (arch=first_arch;arch<=max_arch;arch++)
+      bench_kernel(list, "op_pvq_search", "N=16,K=10", kernel_pvq_search, pvq, arch);
+   free(pvq);
+
+   mdct = (MDCTCtx*)calloc(1, sizeof(*mdct));
+   mdct->mode = opus_custom_mode_create(48000, 960, &err);
+   if (mdct->mode)
+   {
+      int i;
+      for (i=0;i<960+120;i++)
+#ifdef FIXED_POINT
+         mdct->in[i] = (kiss_fft_scalar)(SIG_SAT/4*bench_rand());
+#else
+         mdct->in[i] = 8192*bench_rand();
+#endif
+      for (arch=first_arch;arch<=max_arch;arch++)
+         bench_kernel(list, "clt_mdct_forward", "N=1920", kernel_mdct, mdct, arch);
+   }
+   free(mdct);
+
+   output = (OutputCtx*)calloc(1, sizeof(*output));
+   output->mode = opus_custom_mode_create(48000, 960, &err);
+   if (output->mode)
+   {
+      int i;
+      for (i=0;i<COMBFILTER_MAXPERIOD+960;i++)
+      {
+#ifdef FIXED_POINT
+         output->sig[0][i] = (celt_sig)(SIG_SAT/8*bench_rand());
+         output->sig[1][i] = (celt_sig)(SIG_SAT/8*bench_rand());
+#else
+         output->sig[0][i] = 8192*bench_rand();
+         output->sig[1][i] = 8192*bench_rand();
+#endif
+      }
+      for (arch=first_arch;arch<=max_arch;arch++)
+         bench_kernel(list, "comb_filter", "N=960,overlap=120", kernel_comb_filter, output, arch);
+      for (arch=first_arch;arch<=max_arch;arch++)
+         bench_kernel(list, "deemphasis", "N=960,stereo", kernel_deemphasis, output, arch);
+#if !defined(FIXED_POINT) && !defined(DISABLE_FLOAT_API)
+      for (arch=first_arch;arch<=max_arch;arch++)
+         bench_kernel(list, "celt_float2int16", "N=1920", kernel_float2int16, output, arch);
+#endif
+   }
+   free(output);
+
+   nsq = (NSQCtx*)malloc(sizeof(*nsq));
+   for (arch=first_arch;arch<=max_arch;arch++)
+   {
+      bench_nsq_init(nsq);
+      bench_kernel(list, "silk_NSQ_del_dec", "fs=16000,states=4", kernel_nsq_del_dec, nsq, arch);
+   }
+   free(nsq);
+
+   synthesis = (SynthesisCtx*)malloc(sizeof(*synthesis));
+   bench_synthesis_init(synthesis);
+   for (arch=first_arch;arch<=max_arch;arch++)
+      bench_kernel(list, "silk_LTP_synthesis", "len=80,lag=100", kernel_LTP_synthesis, synthesis, arch);
+   for (arch=first_arch;arch<=max_arch;arch++)
+      bench_kernel(list, "silk_LPC_synthesis", "len=80,order=16", kernel_LPC_synthesis, synthesis, arch);
+   free(synthesis);
+
+   nlsf = (NLSFCtx*)malloc(sizeof(*nlsf));
+   bench_nlsf_init(nlsf);
+   for (arch=first_arch;arch<=max_arch;arch++)
+      bench_kernel(list, "silk_NLSF_encode", "order=16,survivors=16", kernel_NLSF_encode, nlsf, arch);
+   free(nlsf);
+
+#ifdef ENABLE_DEEP_PLC
+   linear = (LinearCtx*)malloc(sizeof(*linear));
+   bench_linear_init(linear, 0);
+   for (arch=first_arch;arch<=max_arch;arch++)
+      if (bench_arch_usable(arch, max_arch))
+         bench_kernel(list, "compute_linear", "256x256,float", kernel_linear, linear, arch);
+   bench_linear_init(linear, 1);
+   for (arch=first_arch;arch<=max_arch;arch++)
+      if (bench_arch_usable(arch, max_arch))
+         bench_kernel(list, "compute_linear", "256x256,int8", kernel_linear, linear, arch);
+   free(linear);
+#endif
+
+   resampler = (ResamplerCtx*)calloc(1, sizeof(*resampler));
+   bench_signal(resampler->in, 960, 1, 48000);
+   resampler->in_len = 960;
+   for (arch=first_arch;arch<=max_arch;arch++)
+   {
+      silk_resampler_init(&resampler->state, 48000, 16000, 1);
+      bench_kernel(list, "silk_resampler", "48000->16000", kernel_resampler, resampler, arch);
+   }
+   resampler->in_len = 320;
+   for (arch=first_arch;arch<=max_arch;arch++)
+   {
+      silk_resampler_init(&resampler->state, 16000, 48000, 0);
+      bench_kernel(list, "silk_resampler", "16000->48000", kernel_resampler, resampler, arch);
+   }
+   free(resampler);
+}
+
+typedef struct {
+   const char *name;
+   opus_int32 Fs;
+   int channels;
+   int application;
+   opus_int32 bitrate;
+   int force_mode;
+   int dred_duration;
+} BenchScenario;
+
+static const BenchScenario scenarios[] = {
+   {"voip_16k_silk",    16000, 1, OPUS_APPLICATION_VOIP,  16000, MODE_SILK_ONLY, 0},
+   {"hybrid_48k",       48000, 1, OPUS_APPLICATION_VOIP,  32000, MODE_HYBRID, 0},
+   {"celt_48k_stereo",  48000, 2, OPUS_APPLICATION_AUDIO, 128000, MODE_CELT_ONLY, 0},
+#ifdef ENABLE_DRED
+   {"dred_16k",         16000, 1, OPUS_APPLICATION_VOIP,  24000, MODE_SILK_ONLY, 100},
+#endif
+#ifdef ENABLE_OSCE
+   /* OSCE runs in the SILK decoder once its complexity reaches 6. */
+   {"osce_16k",         16000, 1, OPUS_APPLICATION_VOIP,  12000, MODE_SILK_ONLY, 0},
+#endif
+};
+
+static int run_scenario(JSONList *list, const BenchScenario *sc, int complexity,
+      const opus_int16 *pcm, int nb_frames)
+{
+   OpusEncoder *enc;
+   OpusDecoder *dec;
+#ifdef ENABLE_DRED
+   OpusDREDDecoder *dred_dec=NULL;
+   OpusDRED *dred=NULL;
+#endif
+   unsigned char *packets;
+   opus_int32 *lens;
+   opus_int16 out[2*MAX_FRAME_SAMPLES];
+   int frame_size = sc->Fs/50;
+   double start, enc_ns, dec_ns, audio_ns;
+   opus_int64 total_bytes = 0;
+   int i, err;
+
+   enc = opus_encoder_create(sc->Fs, sc->channels, sc->application, &err);
+   if (err != OPUS_OK) return err;
+   dec = opus_decoder_create(sc->Fs, sc->channels, &err);
+   if (err != OPUS_OK)
+   {
+      opus_encoder_destroy(enc);
+      return err;
+   }
+   opus_encoder_ctl(enc, OPUS_SET_COMPLEXITY(complexity));
+   opus_encoder_ctl(enc, OPUS_SET_BITRATE(sc->bitrate));
+   opus_encoder_ctl(enc, OPUS_SET_FORCE_MODE(sc->force_mode));
+   opus_decoder_ctl(dec, OPUS_SET_COMPLEXITY(complexity));
+#ifdef ENABLE_DRED
+   if (sc->dred_duration)
+   {
+      opus_encoder_ctl(enc, OPUS_SET_DRED_DURATION(sc->dred_duration));
+      opus_encoder_ctl(enc, OPUS_SET_PACKET_LOSS_PERC(10));
+      dred_dec = opus_dred_decoder_create(&err);
+      dred = opus_dred_alloc(&err);
+   }
+#endif
+   packets = (unsigned char*)malloc((size_t)nb_frames*MAX_PACKET);
+   lens = (opus_int32*)malloc(nb_frames*sizeof(*lens));
+
+   start = bench_now_ns();
+   for (i=0;i<nb_frames;i++)
+   {
+      lens[i] = opus_encode(enc, pcm+i*frame_size*sc->channels, frame_size,
+            packets+i*MAX_PACKET, MAX_PACKET);
+      if (lens[i] < 0) break;
+      total_bytes += lens[i];
+   }
+   enc_ns = bench_now_ns() - start;
+   err = i < nb_frames ? lens[i] : OPUS_OK;
+
+   start = bench_now_ns();
+   for (i=0;i<nb_frames && err==OPUS_OK;i++)
+   {
+      int ret;
+#ifdef ENABLE_DRED
+      if (dred)
+      {
+         int dred_end;
+         opus_dred_parse(dred_dec, dred, packets+i*MAX_PACKET, lens[i],
+               sc->dred_duration*sc->Fs/100, sc->Fs, &dred_end, 0);
+      }
+#endif
+      ret = opus_decode(dec, packets+i*MAX_PACKET, lens[i], out, frame_size, 0);
+      if (ret < 0) err = ret;
+   }
+   dec_ns = bench_now_ns() - start;
+
+   if (err == OPUS_OK)
+   {
+      audio_ns = nb_frames*20e6;
+      json_item(list);
+      fprintf(list->out, "{\"name\": \"%s\", \"complexity\": %d, \"frames\": %d, "
+            "\"frame_ms\": 20, \"bitrate\": %.0f, "
+            "\"encode_ns_per_frame\": %.0f, \"decode_ns_per_frame\": %.0f, "
+            "\"encode_realtime_factor\": %.2f, \"decode_realtime_factor\": %.2f, "
+            "\"realtime_factor\": %.2f}",
+            sc->name, complexity, nb_frames, total_bytes*8*50./nb_frames,
+            enc_ns/nb_frames, dec_ns/nb_frames,
+            audio_ns/enc_ns, audio_ns/dec_ns, audio_ns/(enc_ns+dec_ns));
+   }
+
+   free(lens);
+   free(packets);
+#ifdef ENABLE_DRED
+   if (dred) opus_dred_free(dred);
+   if (dred_dec) opus_dred_decoder_destroy(dred_dec);
+#endif
+   opus_decoder_destroy(dec);
+   opus_encoder_destroy(enc);
+   return err;
+}
+
+static void print_usage(char *argv[])
+{
+   fprintf(stderr, "Usage: %s [options]\n", argv[0]);
+   fprintf(stderr, "options:\n");
+   fprintf(stderr, "-kernels             : only run the kernel benchmarks\n");
+   fprintf(stderr, "-e2e                 : only run the end-to-end encode/decode benchmarks\n");
+   fprintf(stderr, "-frames <n>          : number of 20 ms frames per end-to-end run (default 250)\n");
+   fprintf(stderr, "-time <ms>           : minimum measurement time per kernel (default 50)\n");
+   fprintf(stderr, "-complexity <c>      : only run end-to-end benchmarks at complexity c\n");
+   fprintf(stderr, "-o <file>            : write the JSON report to file instead of stdout\n");
+}
+
+int main(int argc, char *argv[])
+{
+   int do_kernels = 1;
+   int do_e2e = 1;
+   int nb_frames = 250;
+   int min_complexity = 0;
+   int max_complexity = 10;
+   FILE *out = stdout;
+   JSONList list;
+   int i, ret = 0;
+
+   for (i=1;i<argc;i++)
+   {
+      if (strcmp(argv[i], "-kernels") == 0) {
+         do_e2e = 0;
+      } else if (strcmp(argv[i], "-e2e") == 0) {
+         do_kernels = 0;
+      } else if (strcmp(argv[i], "-frames") == 0 && i+1 < argc) {
+         nb_frames = atoi(argv[++i]);
+      } else if (strcmp(argv[i], "-time") == 0 && i+1 < argc) {
+         kernel_min_ns = atof(argv[++i])*1e6;
+      } else if (strcmp(argv[i], "-complexity") == 0 && i+1 < argc) {
+         min_complexity = max_complexity = atoi(argv[++i]);
+      } else if (strcmp(argv[i], "-o") == 0 && i+1 < argc) {
+         out = fopen(argv[++i], "w");
+         if (!out)
+         {
+            fprintf(stderr, "Could not open output file %s\n", argv[i]);
+            return EXIT_FAILURE;
+         }
+      } else {
+         print_usage(argv);
+         return EXIT_FAILURE;
+      }
+   }
+   if (nb_frames < 1 || min_complexity < 0 || max_complexity > 10)
+   {
+      print_usage(argv);
+      return EXIT_FAILURE;
+   }
+
+   fprintf(out, "{\n  \"version\": \"%s\",\n", opus_get_version_string());
+#ifdef FIXED_POINT
+   fprintf(out, "  \"fixed_point\": true,\n");
+#else
+   fprintf(out, "  \"fixed_point\": false,\n");
+#endif
+#ifdef OPUS_HAVE_RTCD
+   fprintf(out, "  \"rtcd\": true,\n");
+#else
+   fprintf(out, "  \"rtcd\": false,\n");
+#endif
+   fprintf(out, "  \"max_arch\": %d,\n  \"max_arch_name\": \"%s\",\n",
+         opus_select_arch(), bench_arch_name(opus_select_arch()));
+
+   fprintf(out, "  \"kernels\": [");
+   list.out = out;
+   list.first = 1;
+   if (do_kernels)
+      run_kernels(&list);
+   fprintf(out, "\n  ],\n");
+
+   fprintf(out, "  \"scenarios\": [");
+   list.first = 1;
+   if (do_e2e)
+   {
+      unsigned s;
+      for (s=0;s<sizeof(scenarios)/sizeof(scenarios[0]);s++)
+      {
+         const BenchScenario *sc = &scenarios[s];
+         opus_int16 *pcm;
+         int c;
+         pcm = (opus_int16*)malloc((size_t)nb_frames*sc->Fs/50*sc->channels*sizeof(*pcm));
+         bench_seed = 1;
+         bench_signal(pcm, nb_frames*sc->Fs/50, sc->channels, sc->Fs);
+         for (c=min_complexity;c<=max_complexity;c++)
+         {
+            int err = run_scenario(&list, sc, c, pcm, nb_frames);
+            if (err != OPUS_OK)
+            {
+               fprintf(stderr, "%s at complexity %d failed: %s\n", sc->name, c, opus_strerror(err));
+               ret = EXIT_FAILURE;
+            }
+         }
+         free(pcm);
+      }
+   }
+   fprintf(out, "\n  ]\n}\n");
+   if (out != stdout)
+      fclose(out);
+   return ret;
+}
@@ -39,6 +39,7 @@
 
 #include <stdarg.h>
 #include "celt.h"
+#include "celt_output.h"
 #include "opus.h"
 #include "entdec.h"
 #include "modes.h"
@@ -51,10 +52,13 @@
 #include "define.h"
 #include "mathops.h"
 #include "cpu_support.h"
+#include "profile.h"
 
 #ifdef ENABLE_DEEP_PLC
 #include "dred_rdovae_dec_data.h"
 #include "dred_rdovae_dec.h"
+#include "dnn_model.h"
+#include "dnn_governor.h"
 #endif
 
 #ifdef ENABLE_OSCE
@@ -72,6 +76,17 @@ struct OpusDecoder {
    int          arch;
 #ifdef ENABLE_DEEP_PLC
     LPCNetPLCState lpcnet;
+    OpusDNNModel *dnn_model;
+    OpusDNNGovernor *governor;
+    /* Complexity last given to the CELT decoder, which the governor may lower. */
+    int celt_complexity;
+    /* Set when the decode call being timed for the governor used neural features. */
+    int dnn_active;
+    /* Value of OPUS_SET_DEEP_PLC_LOOKAHEAD. */
+    int plc_lookahead;
+#endif
+#ifdef ENABLE_PROFILING
+   OpusProfileStats profile;
 #endif
 
    /* Everything beyond this point gets cleared on a reset */
@@ -89,6 +104,17 @@ struct OpusDecoder {
 #endif
 
    opus_uint32  rangeFinal;
+#ifdef ENABLE_DRED
+   /* Features of the last OpusDRED given to opus_decoder_dred_decode(),
+      decoded newest latent first and only as deep as asked for so far, along
+      with the model, initial state and latents they were decoded from. */
+   float        dred_features[2*DRED_NUM_REDUNDANCY_FRAMES*DRED_NUM_FEATURES];
+   RDOVAEDecState dred_dec_state;
+   RDOVAEDec    dred_model;
+   float        dred_state[DRED_STATE_DIM];
+   float        dred_latents[(DRED_NUM_REDUNDANCY_FRAMES/2)*DRED_LATENT_DIM];
+   int          dred_nb_decoded;
+#endif
 };
 
 #if defined(ENABLE_HARDENING) || defined(ENABLE_ASSERTIONS)
@@ -202,23 +228,6 @@ OpusDecoder *opus_decoder_create(opus_int32 Fs, int channels, int *error)
    return st;
 }
 
-static void smooth_fade(const opus_val16 *in1, const opus_val16 *in2,
-      opus_val16 *out, int overlap, int channels,
-      const opus_val16 *window, opus_int32 Fs)
-{
-   int i, c;
-   int inc = 48000/Fs;
-   for (c=0;c<channels;c++)
-   {
-      for (i=0;i<overlap;i++)
-      {
-         opus_val16 w = MULT16_16_Q15(window[i*inc], window[i*inc]);
-         out[i*channels+c] = SHR32(MAC16_16(MULT16_16(w,in2[i*channels+c]),
-                                   Q15ONE-w, in1[i*channels+c]), 15);
-      }
-   }
-}
-
 static int opus_packet_get_mode(const unsigned char *data)
 {
    int mode;
@@ -265,8 +274,14 @@ static int opus_decode_frame(OpusDecoder *st, const unsigned char *data,
    const opus_val16 *window;
    opus_uint32 redundant_rng = 0;
    int celt_accum;
+   int complexity;
    ALLOC_STACK;
 
+   if (!RESERVE_STACK(GLOBAL_STACK_SIZE))
+   {
+      RESTORE_STACK;
+      return OPUS_ALLOC_FAIL;
+   }
    silk_dec = (char*)st+st->silk_dec_offset;
    celt_dec = (CELTDecoder*)((char*)st+st->celt_dec_offset);
    F20 = st->Fs/50;
@@ -370,6 +385,29 @@ static int opus_decode_frame(OpusDecoder *st, const unsigned char *data,
       frame_size = audiosize;
    }
 
+   complexity = st->complexity;
+#ifdef ENABLE_DEEP_PLC
+   if (st->governor != NULL)
+   {
+      int neural;
+      complexity = dnn_governor_complexity(st->governor, st->complexity, data == NULL, mode != MODE_CELT_ONLY);
+      if (complexity != st->celt_complexity)
+      {
+         MUST_SUCCEED(celt_decoder_ctl(celt_dec, OPUS_SET_COMPLEXITY(complexity)));
+         st->celt_complexity = complexity;
+      }
+      /* Deep PLC for lost frames (and for SILK frames in look-ahead mode),
+         OSCE for SILK frames. */
+      neural = complexity >= 5 && (data == NULL || (st->plc_lookahead && mode != MODE_CELT_ONLY));
+#ifdef ENABLE_OSCE
+      neural = neural || (data != NULL && mode != MODE_CELT_ONLY && complexity >= 6);
+#endif
+      st->dnn_active |= neural;
+   }
+   /* Deep PLC only runs from complexity 5, so there is nothing to look ahead for below. */
+   st->lpcnet.lookahead = st->plc_lookahead && complexity >= 5;
+#endif
+
    /* Don't allocate any memory when in CELT-only mode */
    pcm_silk_size = (mode != MODE_CELT_ONLY && !celt_accum) ? IMAX(F10, frame_size)*st->channels : ALLOC_NONE;
    ALLOC(pcm_silk, pcm_silk_size, opus_int16);
@@ -411,14 +449,14 @@ static int opus_decode_frame(OpusDecoder *st, const unsigned char *data,
            st->DecControl.internalSampleRate = 16000;
         }
      }
-     st->DecControl.enable_deep_plc = st->complexity >= 5;
+     st->DecControl.enable_deep_plc = complexity >= 5;
 #ifdef ENABLE_OSCE
      st->DecControl.osce_method = OSCE_METHOD_NONE;
 #ifndef DISABLE_LACE
-     if (st->complexity >= 6) {st->DecControl.osce_method = OSCE_METHOD_LACE;}
+     if (complexity >= 6) {st->DecControl.osce_method = OSCE_METHOD_LACE;}
 #endif
 #ifndef DISABLE_NOLACE
-     if (st->complexity >= 7) {st->DecControl.osce_method = OSCE_METHOD_NOLACE;}
+     if (complexity >= 7) {st->DecControl.osce_method = OSCE_METHOD_NOLACE;}
 #endif
 #endif
 
@@ -427,12 +465,14 @@ static int opus_decode_frame(OpusDecoder *st, const unsigned char *data,
      do {
         /* Call SILK decoder */
         int first_frame = decoded_samples == 0;
+        OPUS_PROFILE_ENTER(OPUS_PROFILE_SILK);
         silk_ret = silk_Decode( silk_dec, &st->DecControl,
                                 lost_flag, first_frame, &dec, pcm_ptr, &silk_frame_size,
 #ifdef ENABLE_DEEP_PLC
                                 &st->lpcnet,
 #endif
                                 st->arch );
+        OPUS_PROFILE_LEAVE(OPUS_PROFILE_SILK);
         if( silk_ret ) {
            if (lost_flag) {
               /* PLC failure should not be fatal */
@@ -600,7 +640,7 @@ static int opus_decode_frame(OpusDecoder *st, const unsigned char *data,
       celt_decode_with_ec(celt_dec, data+len, redundancy_bytes, redundant_audio, F5, NULL, 0);
       MUST_SUCCEED(celt_decoder_ctl(celt_dec, OPUS_GET_FINAL_RANGE(&redundant_rng)));
       smooth_fade(pcm+st->channels*(frame_size-F2_5), redundant_audio+st->channels*F2_5,
-                  pcm+st->channels*(frame_size-F2_5), F2_5, st->channels, window, st->Fs);
+                  pcm+st->channels*(frame_size-F2_5), F2_5, st->channels, window, 48000/st->Fs, st->arch);
    }
    /* 5ms redundant frame for CELT->SILK; ignore if the previous frame did not
       use CELT (the first redundancy frame in a transition from SILK may have
@@ -613,7 +653,7 @@ static int opus_decode_frame(OpusDecoder *st, const unsigned char *data,
             pcm[st->channels*i+c] = redundant_audio[st->channels*i+c];
       }
       smooth_fade(redundant_audio+st->channels*F2_5, pcm+st->channels*F2_5,
-                  pcm+st->channels*F2_5, F2_5, st->channels, window, st->Fs);
+                  pcm+st->channels*F2_5, F2_5, st->channels, window, 48000/st->Fs, st->arch);
    }
    if (transition)
    {
@@ -623,7 +663,7 @@ static int opus_decode_frame(OpusDecoder *st, const unsigned char *data,
             pcm[i] = pcm_transition[i];
          smooth_fade(pcm_transition+st->channels*F2_5, pcm+st->channels*F2_5,
                      pcm+st->channels*F2_5, F2_5,
-                     st->channels, window, st->Fs);
+                     st->channels, window, 48000/st->Fs, st->arch);
       } else {
          /* Not enough time to do a clean transition, but we do it anyway
             This will not preserve amplitude perfectly and may introduce
@@ -632,7 +672,7 @@ static int opus_decode_frame(OpusDecoder *st, const unsigned char *data,
             transition it pretty silly in the first place */
          smooth_fade(pcm_transition, pcm,
                      pcm, F2_5,
-                     st->channels, window, st->Fs);
+                     st->channels, window, 48000/st->Fs, st->arch);
       }
    }
 
@@ -667,7 +707,36 @@ static int opus_decode_frame(OpusDecoder *st, const unsigned char *data,
 
 }
 
-int opus_decode_native(OpusDecoder *st, const unsigned char *data,
+#ifdef ENABLE_DRED
+/* Makes the first nb_latents latents of dred available in st->dred_features.
+   Features depend only on the model, the initial state and the latents before
+   them, so what is cached carries over to any packet that shares those, such
+   as the same packet at a deeper offset. */
+static void dred_decode_features(OpusDecoder *st, const OpusDRED *dred, int nb_latents)
+{
+   int start;
+   start = st->dred_nb_decoded;
+   if (start > dred->nb_latents
+         || memcmp(&st->dred_model, &dred->model, sizeof(dred->model)) != 0
+         || memcmp(st->dred_state, dred->state, sizeof(dred->state)) != 0
+         || memcmp(st->dred_latents, dred->latents, start*DRED_LATENT_DIM*sizeof(float)) != 0)
+   {
+      start = 0;
+      OPUS_COPY(&st->dred_model, &dred->model, 1);
+      OPUS_COPY(st->dred_state, dred->state, DRED_STATE_DIM);
+   }
+   if (nb_latents > start)
+   {
+      OPUS_COPY(&st->dred_latents[start*DRED_LATENT_DIM], &dred->latents[start*DRED_LATENT_DIM],
+            (nb_latents - start)*DRED_LATENT_DIM);
+      DRED_rdovae_decode_range(&st->dred_dec_state, &dred->model, st->dred_features, dred->state,
+            dred->latents, start, nb_latents, dred->arch);
+   }
+   st->dred_nb_decoded = IMAX(start, nb_latents);
+}
+#endif
+
+static int opus_decode_native_impl(OpusDecoder *st, const unsigned char *data,
       opus_int32 len, opus_val16 *pcm, int frame_size, int decode_fec,
       int self_delimited, opus_int32 *packet_offset, int soft_clip, const OpusDRED *dred, opus_int32 dred_offset)
 {
@@ -689,19 +758,24 @@ int opus_decode_native(OpusDecoder *st, const unsigned char *data,
       int features_per_frame;
       int needed_feature_frames;
       int init_frames;
+      int max_offset;
       lpcnet_plc_fec_clear(&st->lpcnet);
       F10 = st->Fs/100;
       /* if blend==0, the last PLC call was "update" and we need to feed two extra 10-ms frames. */
       init_frames = (st->lpcnet.blend == 0) ? 2 : 0;
       features_per_frame = IMAX(1, frame_size/F10);
       needed_feature_frames = init_frames + features_per_frame;
+      /* The deepest feature we read is the first one (i=0). Each latent covers 4 feature frames. */
+      max_offset = init_frames - 2 + (int)floor(((float)dred_offset + dred->dred_offset*F10/4)/F10);
+      if (max_offset >= 0)
+         dred_decode_features(st, dred, IMIN(dred->nb_latents, max_offset/4 + 1));
       lpcnet_plc_fec_clear(&st->lpcnet);
       for (i=0;i<needed_feature_frames;i++) {
          int feature_offset;
          /* We floor instead of rounding because 5-ms overlap compensates for the missing 0.5 rounding offset. */
          feature_offset = init_frames - i - 2 + (int)floor(((float)dred_offset + dred->dred_offset*F10/4)/F10);
          if (feature_offset <= 4*dred->nb_latents-1 && feature_offset >= 0) {
-           lpcnet_plc_fec_add(&st->lpcnet, dred->fec_features+feature_offset*DRED_NUM_FEATURES);
+           lpcnet_plc_fec_add(&st->lpcnet, st->dred_features+feature_offset*DRED_NUM_FEATURES);
          } else {
            if (feature_offset >= 0) lpcnet_plc_fec_add(&st->lpcnet, NULL);
          }
@@ -748,12 +822,12 @@ int opus_decode_native(OpusDecoder *st, const unsigned char *data,
       int ret;
       /* If no FEC can be present, run the PLC (recursive call) */
       if (frame_size < packet_frame_size || packet_mode == MODE_CELT_ONLY || st->mode == MODE_CELT_ONLY)
-         return opus_decode_native(st, NULL, 0, pcm, frame_size, 0, 0, NULL, soft_clip, NULL, 0);
+         return opus_decode_native_impl(st, NULL, 0, pcm, frame_size, 0, 0, NULL, soft_clip, NULL, 0);
       /* Otherwise, run the PLC on everything except the size for which we might have FEC */
       duration_copy = st->last_packet_duration;
       if (frame_size-packet_frame_size!=0)
       {
-         ret = opus_decode_native(st, NULL, 0, pcm, frame_size-packet_frame_size, 0, 0, NULL, soft_clip, NULL, 0);
+         ret = opus_decode_native_impl(st, NULL, 0, pcm, frame_size-packet_frame_size, 0, 0, NULL, soft_clip, NULL, 0);
          if (ret<0)
          {
             st->last_packet_duration = duration_copy;
@@ -803,13 +877,48 @@ int opus_decode_native(OpusDecoder *st, const unsigned char *data,
       OPUS_PRINT_INT(nb_samples);
 #ifndef FIXED_POINT
    if (soft_clip)
-      opus_pcm_soft_clip(pcm, nb_samples, st->channels, st->softclip_mem);
+      opus_pcm_soft_clip_impl(pcm, nb_samples, st->channels, st->softclip_mem, st->arch);
    else
       st->softclip_mem[0]=st->softclip_mem[1]=0;
 #endif
    return nb_samples;
 }
 
+int opus_decode_native(OpusDecoder *st, const unsigned char *data,
+      opus_int32 len, opus_val16 *pcm, int frame_size, int decode_fec,
+      int self_delimited, opus_int32 *packet_offset, int soft_clip, const OpusDRED *dred, opus_int32 dred_offset)
+{
+   int ret;
+#ifdef ENABLE_DEEP_PLC
+   opus_uint64 dnn_start = 0;
+#endif
+#ifdef ENABLE_PROFILING
+   OpusProfileStats *prev_profile;
+   prev_profile = opus_profile_begin(&st->profile);
+   OPUS_PROFILE_ENTER(OPUS_PROFILE_TOTAL);
+#endif
+#ifdef ENABLE_DEEP_PLC
+   /* The whole call is charged to the governor when it used any neural
+      feature; the classic decoding it includes is comparatively cheap. */
+   if (st->governor != NULL)
+   {
+      st->dnn_active = dred != NULL;
+      dnn_start = opus_time_ns();
+   }
+#endif
+   ret = opus_decode_native_impl(st, data, len, pcm, frame_size, decode_fec,
+         self_delimited, packet_offset, soft_clip, dred, dred_offset);
+#ifdef ENABLE_DEEP_PLC
+   if (st->governor != NULL && st->dnn_active)
+      dnn_governor_charge(st->governor, opus_time_ns() - dnn_start);
+#endif
+#ifdef ENABLE_PROFILING
+   OPUS_PROFILE_LEAVE(OPUS_PROFILE_TOTAL);
+   opus_profile_end(prev_profile);
+#endif
+   return ret;
+}
+
 #ifdef FIXED_POINT
 
 int opus_decode(OpusDecoder *st, const unsigned char *data,
@@ -843,6 +952,11 @@ int opus_decode_float(OpusDecoder *st, const unsigned char *data,
          return OPUS_INVALID_PACKET;
    }
    celt_assert(st->channels == 1 || st->channels == 2);
+   if (!RESERVE_STACK(GLOBAL_STACK_SIZE + frame_size*st->channels*sizeof(opus_int16)))
+   {
+      RESTORE_STACK;
+      return OPUS_ALLOC_FAIL;
+   }
    ALLOC(out, frame_size*st->channels, opus_int16);
 
    ret = opus_decode_native(st, data, len, out, frame_size, decode_fec, 0, NULL, 0, NULL, 0);
@@ -862,7 +976,7 @@ int opus_decode(OpusDecoder *st, const unsigned char *data,
       opus_int32 len, opus_int16 *pcm, int frame_size, int decode_fec)
 {
    VARDECL(float, out);
-   int ret, i;
+   int ret;
    int nb_samples;
    ALLOC_STACK;
 
@@ -881,13 +995,17 @@ int opus_decode(OpusDecoder *st, const unsigned char *data,
          return OPUS_INVALID_PACKET;
    }
    celt_assert(st->channels == 1 || st->channels == 2);
+   if (!RESERVE_STACK(GLOBAL_STACK_SIZE + frame_size*st->channels*sizeof(float)))
+   {
+      RESTORE_STACK;
+      return OPUS_ALLOC_FAIL;
+   }
    ALLOC(out, frame_size*st->channels, float);
 
    ret = opus_decode_native(st, data, len, out, frame_size, decode_fec, 0, NULL, 1, NULL, 0);
    if (ret > 0)
    {
-      for (i=0;i<ret*st->channels;i++)
-         pcm[i] = FLOAT2INT16(out[i]);
+      celt_float2int16(out, pcm, ret*st->channels, st->arch);
    }
    RESTORE_STACK;
    return ret;
@@ -937,6 +1055,9 @@ int opus_decoder_ctl(OpusDecoder *st, int request, ...)
        }
        st->complexity = value;
        celt_decoder_ctl(celt_dec, OPUS_SET_COMPLEXITY(value));
+#ifdef ENABLE_DEEP_PLC
+       st->celt_complexity = value;
+#endif
    }
    break;
    case OPUS_GET_COMPLEXITY_REQUEST:
@@ -1058,6 +1179,78 @@ int opus_decoder_ctl(OpusDecoder *st, int request, ...)
        }
        ret = lpcnet_plc_load_model(&st->lpcnet, data, len);
        ret = silk_LoadOSCEModels(silk_dec, data, len) || ret;
+       if (ret == 0)
+       {
+          /* The blob replaces any attached model. */
+          dnn_model_unref(st->dnn_model);
+          st->dnn_model = NULL;
+       }
+   }
+   break;
+#endif
+#ifdef ENABLE_DEEP_PLC
+   case OPUS_SET_DNN_MODEL_REQUEST:
+   {
+       OpusDNNModel *value = va_arg(ap, OpusDNNModel *);
+       if (value != NULL && !value->plc_loaded)
+          goto bad_arg;
+#ifdef ENABLE_OSCE
+       if (value != NULL && !value->osce.loaded)
+          goto bad_arg;
+#endif
+       lpcnet_plc_set_model(&st->lpcnet, value);
+       silk_SetOSCEModels(silk_dec, value);
+       dnn_model_ref(value);
+       dnn_model_unref(st->dnn_model);
+       st->dnn_model = value;
+   }
+   break;
+   case OPUS_SET_DNN_GOVERNOR_REQUEST:
+   {
+       OpusDNNGovernor *value = va_arg(ap, OpusDNNGovernor *);
+       dnn_governor_attach(value);
+       dnn_governor_detach(st->governor);
+       st->governor = value;
+       /* Undo whatever the previous governor did to the CELT complexity. */
+       celt_decoder_ctl(celt_dec, OPUS_SET_COMPLEXITY(st->complexity));
+       st->celt_complexity = st->complexity;
+   }
+   break;
+   case OPUS_SET_DEEP_PLC_LOOKAHEAD_REQUEST:
+   {
+       opus_int32 value = va_arg(ap, opus_int32);
+       if(value<0 || value>1)
+       {
+          goto bad_arg;
+       }
+       st->plc_lookahead = value;
+   }
+   break;
+   case OPUS_GET_DEEP_PLC_LOOKAHEAD_REQUEST:
+   {
+       opus_int32 *value = va_arg(ap, opus_int32*);
+       if (!value)
+       {
+          goto bad_arg;
+       }
+       *value = st->plc_lookahead;
+   }
+   break;
+#endif
+#ifdef ENABLE_PROFILING
+   case OPUS_GET_PROFILE_STATS_REQUEST:
+   {
+      OpusProfileStats *value = va_arg(ap, OpusProfileStats*);
+      if (!value)
+      {
+         goto bad_arg;
+      }
+      *value = st->profile;
+   }
+   break;
+   case OPUS_RESET_PROFILE_STATS_REQUEST:
+   {
+      OPUS_CLEAR(&st->profile, 1);
    }
    break;
 #endif
@@ -1074,8 +1267,24 @@ bad_arg:
    return OPUS_BAD_ARG;
 }
 
+void opus_decoder_deinit(OpusDecoder *st)
+{
+#ifdef ENABLE_DEEP_PLC
+   if (st)
+   {
+      dnn_model_unref(st->dnn_model);
+      st->dnn_model = NULL;
+      dnn_governor_detach(st->governor);
+      st->governor = NULL;
+   }
+#else
+   (void)st;
+#endif
+}
+
 void opus_decoder_destroy(OpusDecoder *st)
 {
+   opus_decoder_deinit(st);
    opus_free(st);
 }
 
@@ -1170,6 +1379,7 @@ int opus_decoder_get_nb_samples(const OpusDecoder *dec,
 struct OpusDREDDecoder {
 #ifdef ENABLE_DRED
    RDOVAEDec model;
+   OpusDNNModel *dnn_model;
 #endif
    int loaded;
    int arch;
@@ -1204,7 +1414,13 @@ int dred_decoder_load_model(OpusDREDDecoder *dec, const unsigned char *data, int
     parse_weights(&list, data, len);
     ret = init_rdovaedec(&dec->model, list);
     opus_free(list);
-    if (ret == 0) dec->loaded = 1;
+    if (ret == 0)
+    {
+       dec->loaded = 1;
+       /* The blob replaces any attached model. */
+       dnn_model_unref(dec->dnn_model);
+       dec->dnn_model = NULL;
+    }
     return (ret == 0) ? OPUS_OK : OPUS_BAD_ARG;
 }
 #endif
@@ -1213,6 +1429,9 @@ int opus_dred_decoder_init(OpusDREDDecoder *dec)
 {
    int ret = 0;
    dec->loaded = 0;
+#ifdef ENABLE_DRED
+   dec->dnn_model = NULL;
+#endif
 #if defined(ENABLE_DRED) && !defined(USE_WEIGHTS_FILE)
    ret = init_rdovaedec(&dec->model, rdovaedec_arrays);
    if (ret == 0) dec->loaded = 1;
@@ -1245,8 +1464,22 @@ OpusDREDDecoder *opus_dred_decoder_create(int *error)
    return dec;
 }
 
+void opus_dred_decoder_deinit(OpusDREDDecoder *dec)
+{
+#ifdef ENABLE_DRED
+   if (dec)
+   {
+      dnn_model_unref(dec->dnn_model);
+      dec->dnn_model = NULL;
+   }
+#else
+   (void)dec;
+#endif
+}
+
 void opus_dred_decoder_destroy(OpusDREDDecoder *dec)
 {
+   opus_dred_decoder_deinit(dec);
    if (dec) dec->magic = 0xDE57801D;
    opus_free(dec);
 }
@@ -1274,6 +1507,26 @@ int opus_dred_decoder_ctl(OpusDREDDecoder *dred_dec, int request, ...)
    }
    break;
 # endif
+   case OPUS_SET_DNN_MODEL_REQUEST:
+   {
+      OpusDNNModel *value = va_arg(ap, OpusDNNModel *);
+      if (value == NULL)
+      {
+         dred_dec->loaded = 0;
+# ifndef USE_WEIGHTS_FILE
+         if (init_rdovaedec(&dred_dec->model, rdovaedec_arrays) == 0) dred_dec->loaded = 1;
+# endif
+      } else if (value->rdovae_dec_loaded) {
+         dred_dec->loaded = 1;
+      } else {
+         ret = OPUS_BAD_ARG;
+         break;
+      }
+      dnn_model_ref(value);
+      dnn_model_unref(dred_dec->dnn_model);
+      dred_dec->dnn_model = value;
+   }
+   break;
    default:
      /*fprintf(stderr, "unknown opus_decoder_ctl() request: %d", request);*/
      ret = OPUS_UNIMPLEMENTED;
@@ -1428,7 +1681,10 @@ int opus_dred_process(OpusDREDDecoder *dred_dec, const OpusDRED *src, OpusDRED *
       OPUS_COPY(dst, src, 1);
    if (dst->process_stage == 2)
       return OPUS_OK;
-   DRED_rdovae_decode_all(&dred_dec->model, dst->fec_features, dst->state, dst->latents, dst->nb_latents, dred_dec->arch);
+   /* The RDOVAE decoding itself is deferred to opus_decoder_dred_decode(),
+      which only runs it as deep as the requested offset. */
+   dst->model = dred_dec->dnn_model ? dred_dec->dnn_model->rdovae_dec : dred_dec->model;
+   dst->arch = dred_dec->arch;
    dst->process_stage = 2;
    return OPUS_OK;
 #else
@@ -1443,7 +1699,7 @@ int opus_decoder_dred_decode(OpusDecoder *st, const OpusDRED *dred, opus_int32 d
 {
 #ifdef ENABLE_DRED
    VARDECL(float, out);
-   int ret, i;
+   int ret;
    ALLOC_STACK;
 
    if(frame_size<=0)
@@ -1453,13 +1709,17 @@ int opus_decoder_dred_decode(OpusDecoder *st, const OpusDRED *dred, opus_int32 d
    }
 
    celt_assert(st->channels == 1 || st->channels == 2);
+   if (!RESERVE_STACK(GLOBAL_STACK_SIZE + frame_size*st->channels*sizeof(float)))
+   {
+      RESTORE_STACK;
+      return OPUS_ALLOC_FAIL;
+   }
    ALLOC(out, frame_size*st->channels, float);
 
    ret = opus_decode_native(st, NULL, 0, out, frame_size, 0, 0, NULL, 1, dred, dred_offset);
    if (ret > 0)
    {
-      for (i=0;i<ret*st->channels;i++)
-         pcm[i] = FLOAT2INT16(out[i]);
+      celt_float2int16(out, pcm, ret*st->channels, st->arch);
    }
    RESTORE_STACK;
    return ret;
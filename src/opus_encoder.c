@@ -45,9 +45,11 @@
 #include "analysis.h"
 #include "mathops.h"
 #include "tuning_parameters.h"
+#include "profile.h"
 
 #ifdef ENABLE_DRED
 #include "dred_coding.h"
+#include "dnn_model.h"
 #endif
 
 #ifdef FIXED_POINT
@@ -61,6 +63,14 @@
 
 #define MAX_ENCODER_BUFFER 480
 
+/* Peak scratch usage, measured over all modes, rates and complexities with
+   120 ms frames, is about 17 kB plus 42 kB per channel. The margin brings
+   stereo to GLOBAL_STACK_SIZE. DRED takes nothing from the arena, and the
+   streams of a multistream encoder encode one at a time in their own arenas;
+   test_scratch_api() checks both. Each encode call reserves this much up
+   front, so a smaller arena makes it take a heap block instead. */
+#define OPUS_ENCODER_SCRATCH_SIZE(channels) (24000 + 48000*(channels))
+
 #ifndef DISABLE_FLOAT_API
 #define PSEUDO_SNR_THRESHOLD 316.23f    /* 10^(25/10) */
 #endif
@@ -77,6 +87,8 @@ struct OpusEncoder {
     silk_EncControlStruct silk_mode;
 #ifdef ENABLE_DRED
     DREDEnc      dred_encoder;
+    OpusDNNModel *dnn_model;
+    OpusDREDWorker dred_worker;
 #endif
     int          application;
     int          channels;
@@ -102,6 +114,13 @@ struct OpusEncoder {
 #ifndef DISABLE_FLOAT_API
     TonalityAnalysisState analysis;
 #endif
+#ifdef ENABLE_PROFILING
+    OpusProfileStats profile;
+#endif
+#ifdef SCRATCH_ARENA
+    char        *scratch;
+    opus_int32   scratch_size;
+#endif
 
 #define OPUS_ENCODER_RESET_START stream_channels
     int          stream_channels;
@@ -117,6 +136,8 @@ struct OpusEncoder {
     /* Bandwidth determined automatically from the rate (before any other adjustment) */
     int          auto_bandwidth;
     int          silk_bw_switch;
+    /* Quantization passes the SILK rate control used for the last packet */
+    int          silk_rate_passes;
     /* Sampling rate (at the API level) */
     int          first;
     opus_val16 * energy_masking;
@@ -134,6 +155,16 @@ struct OpusEncoder {
     int          dred_qmax;
     int          dred_target_chunks;
     unsigned char activity_mem[DRED_MAX_FRAMES*4]; /* 2.5ms resolution*/
+    /* Frame being analysed by dred_worker, if dred_job_running. */
+    float        dred_pcm16k[DRED_MAX_FRAME_SIZE16K];
+    int          dred_job_size16k;
+    int          dred_job_extra_delay;
+    int          dred_job_frame_size;
+    int          dred_job_activity;
+    int          dred_job_running;
+    /* The worker could not get scratch memory for the frame. */
+    int          dred_job_failed;
+    int          dred_delay;
 #endif
     int          nonfinal_frame; /* current frame is not the final in a packet */
     opus_uint32  rangeFinal;
@@ -199,6 +230,17 @@ int opus_encoder_get_size(int channels)
     return align(sizeof(OpusEncoder))+silkEncSizeBytes+celtEncSizeBytes;
 }
 
+int opus_encoder_get_scratch_size(int channels)
+{
+   if (channels<1 || channels > 2)
+      return 0;
+#ifdef SCRATCH_ARENA
+   return OPUS_ENCODER_SCRATCH_SIZE(channels);
+#else
+   return 0;
+#endif
+}
+
 int opus_encoder_init(OpusEncoder* st, opus_int32 Fs, int channels, int application)
 {
     void *silk_enc;
@@ -247,6 +289,7 @@ int opus_encoder_init(OpusEncoder* st, opus_int32 Fs, int channels, int applicat
     st->silk_mode.useDTX                    = 0;
     st->silk_mode.useCBR                    = 0;
     st->silk_mode.reducedDependency         = 0;
+    st->silk_mode.pitchTracking             = 0;
 
     /* Create CELT encoder */
     /* Initialize CELT encoder */
@@ -634,6 +677,42 @@ static opus_int32 compute_dred_bitrate(OpusEncoder *st, opus_int32 bitrate_bps,
    st->dred_target_chunks = target_chunks;
    return dred_bitrate;
 }
+
+static void dred_update_activity(OpusEncoder *st, int frame_size, int activity)
+{
+   int i;
+   int frame_size_400Hz = frame_size*400/st->Fs;
+   OPUS_MOVE(&st->activity_mem[frame_size_400Hz], st->activity_mem, 4*DRED_MAX_FRAMES-frame_size_400Hz);
+   for (i=0;i<frame_size_400Hz;i++)
+      st->activity_mem[i] = activity;
+}
+
+static void dred_worker_task(void *arg)
+{
+   OpusEncoder *st = (OpusEncoder *)arg;
+   SAVE_STACK;
+   st->dred_job_failed = !RESERVE_STACK(GLOBAL_STACK_SIZE);
+   if (!st->dred_job_failed)
+      dred_compute_latents_16k(&st->dred_encoder, st->dred_pcm16k, st->dred_job_size16k, st->dred_job_extra_delay, st->arch);
+   RESTORE_STACK;
+}
+
+/* Waits for the latents of the frame given to the worker, if any, and makes
+   them available to the next packet, which ends delay samples after them. */
+static void dred_finish_job(OpusEncoder *st, int delay)
+{
+   if (!st->dred_job_running)
+      return;
+   st->dred_worker.wait(st->dred_worker.user_data);
+   st->dred_job_running = 0;
+   /* Without the frame, the latents no longer line up with the audio. */
+   if (st->dred_job_failed)
+      st->dred_encoder.latents_buffer_fill = 0;
+   else
+      dred_commit_latents(&st->dred_encoder, delay*400/st->Fs);
+   dred_update_activity(st, st->dred_job_frame_size, st->dred_job_activity);
+   st->dred_delay = delay;
+}
 #endif
 
 static opus_int32 user_bitrate_to_bitrate(OpusEncoder *st, int frame_size, int max_data_bytes)
@@ -1054,7 +1133,7 @@ static opus_int32 opus_encode_frame_native(OpusEncoder *st, const opus_val16 *pc
                 int redundancy, int celt_to_silk, int prefill,
                 opus_int32 equiv_rate, int to_celt);
 
-opus_int32 opus_encode_native(OpusEncoder *st, const opus_val16 *pcm, int frame_size,
+static opus_int32 opus_encode_native_impl(OpusEncoder *st, const opus_val16 *pcm, int frame_size,
                 unsigned char *data, opus_int32 out_data_bytes, int lsb_depth,
                 const void *analysis_pcm, opus_int32 analysis_size, int c1, int c2,
                 int analysis_channels, downmix_func downmix, int float_api)
@@ -1120,9 +1199,11 @@ opus_int32 opus_encode_native(OpusEncoder *st, const opus_val16 *pcm, int frame_
        is_silence = is_digital_silence(pcm, frame_size, st->channels, lsb_depth);
        analysis_read_pos_bak = st->analysis.read_pos;
        analysis_read_subframe_bak = st->analysis.read_subframe;
+       OPUS_PROFILE_ENTER(OPUS_PROFILE_ANALYSIS);
        run_analysis(&st->analysis, celt_mode, analysis_pcm, analysis_size, frame_size,
              c1, c2, analysis_channels, st->Fs,
              lsb_depth, downmix, &analysis_info);
+       OPUS_PROFILE_LEAVE(OPUS_PROFILE_ANALYSIS);
 
        /* Track the peak signal energy */
        if (!is_silence && analysis_info.activity_probability > DTX_ACTIVITY_THRESHOLD)
@@ -1695,6 +1776,43 @@ opus_int32 opus_encode_native(OpusEncoder *st, const opus_val16 *pcm, int frame_
     }
 }
 
+opus_int32 opus_encode_native(OpusEncoder *st, const opus_val16 *pcm, int frame_size,
+                unsigned char *data, opus_int32 out_data_bytes, int lsb_depth,
+                const void *analysis_pcm, opus_int32 analysis_size, int c1, int c2,
+                int analysis_channels, downmix_func downmix, int float_api)
+{
+    opus_int32 ret;
+#ifdef SCRATCH_ARENA
+    OpusScratchState prev_scratch;
+#endif
+#ifdef ENABLE_PROFILING
+    OpusProfileStats *prev_profile;
+#endif
+#ifdef SCRATCH_ARENA
+    prev_scratch = opus_scratch_begin(st->scratch, st->scratch_size);
+    if (!RESERVE_STACK(OPUS_ENCODER_SCRATCH_SIZE(st->channels)))
+    {
+       opus_scratch_end(prev_scratch);
+       return OPUS_ALLOC_FAIL;
+    }
+#endif
+#ifdef ENABLE_PROFILING
+    prev_profile = opus_profile_begin(&st->profile);
+    OPUS_PROFILE_ENTER(OPUS_PROFILE_TOTAL);
+#endif
+    st->silk_rate_passes = 0;
+    ret = opus_encode_native_impl(st, pcm, frame_size, data, out_data_bytes, lsb_depth,
+          analysis_pcm, analysis_size, c1, c2, analysis_channels, downmix, float_api);
+#ifdef ENABLE_PROFILING
+    OPUS_PROFILE_LEAVE(OPUS_PROFILE_TOTAL);
+    opus_profile_end(prev_profile);
+#endif
+#ifdef SCRATCH_ARENA
+    opus_scratch_end(prev_scratch);
+#endif
+    return ret;
+}
+
 static opus_int32 opus_encode_frame_native(OpusEncoder *st, const opus_val16 *pcm, int frame_size,
                 unsigned char *data, opus_int32 max_data_bytes,
                 int float_api, int first_frame,
@@ -1847,14 +1965,25 @@ static opus_int32 opus_encode_frame_native(OpusEncoder *st, const opus_val16 *pc
 #endif
 
 #ifdef ENABLE_DRED
+    /* The latents the worker computed during the previous frame are one frame
+       old for this packet. */
+    dred_finish_job(st, frame_size);
     if ( st->dred_duration > 0 && st->dred_encoder.loaded ) {
-        int frame_size_400Hz;
         /* DRED Encoder */
-        dred_compute_latents( &st->dred_encoder, &pcm_buf[total_buffer*st->channels], frame_size, total_buffer, st->arch );
-        frame_size_400Hz = frame_size*400/st->Fs;
-        OPUS_MOVE(&st->activity_mem[frame_size_400Hz], st->activity_mem, 4*DRED_MAX_FRAMES-frame_size_400Hz);
-        for (i=0;i<frame_size_400Hz;i++)
-           st->activity_mem[i] = activity;
+        OPUS_PROFILE_ENTER(OPUS_PROFILE_DRED);
+        if (st->dred_worker.start != NULL) {
+           st->dred_job_size16k = dred_convert_frame_to_16k(&st->dred_encoder, &pcm_buf[total_buffer*st->channels], frame_size, st->dred_pcm16k);
+           st->dred_job_extra_delay = total_buffer;
+           st->dred_job_frame_size = frame_size;
+           st->dred_job_activity = activity;
+           st->dred_job_running = 1;
+           st->dred_worker.start(st->dred_worker.user_data, dred_worker_task, st);
+        } else {
+           dred_compute_latents( &st->dred_encoder, &pcm_buf[total_buffer*st->channels], frame_size, total_buffer, st->arch );
+           dred_update_activity(st, frame_size, activity);
+           st->dred_delay = 0;
+        }
+        OPUS_PROFILE_LEAVE(OPUS_PROFILE_DRED);
     } else {
         st->dred_encoder.latents_buffer_fill = 0;
         OPUS_CLEAR(st->activity_mem, DRED_MAX_FRAMES);
@@ -2030,7 +2159,9 @@ static opus_int32 opus_encode_frame_native(OpusEncoder *st, const opus_val16 *pc
             for (i=0;i<st->encoder_buffer*st->channels;i++)
                 pcm_silk[i] = FLOAT2INT16(st->delay_buffer[i]);
 #endif
+            OPUS_PROFILE_ENTER(OPUS_PROFILE_SILK);
             silk_Encode( silk_enc, &st->silk_mode, pcm_silk, st->encoder_buffer, NULL, &zero, prefill, activity );
+            OPUS_PROFILE_LEAVE(OPUS_PROFILE_SILK);
             /* Prevent a second switch in the real encode call. */
             st->silk_mode.opusCanSwitch = 0;
         }
@@ -2041,7 +2172,10 @@ static opus_int32 opus_encode_frame_native(OpusEncoder *st, const opus_val16 *pc
         for (i=0;i<frame_size*st->channels;i++)
             pcm_silk[i] = FLOAT2INT16(pcm_buf[total_buffer*st->channels + i]);
 #endif
+        OPUS_PROFILE_ENTER(OPUS_PROFILE_SILK);
         ret = silk_Encode( silk_enc, &st->silk_mode, pcm_silk, frame_size, &enc, &nBytes, 0, activity );
+        OPUS_PROFILE_LEAVE(OPUS_PROFILE_SILK);
+        st->silk_rate_passes += st->silk_mode.nRatePasses;
         if( ret ) {
             /*fprintf (stderr, "SILK encode error: %d\n", ret);*/
             /* Handle error */
@@ -2467,13 +2601,19 @@ opus_int32 opus_encode_float(OpusEncoder *st, const float *pcm, int analysis_fra
    int i, ret;
    int frame_size;
    VARDECL(opus_int16, in);
+#ifdef SCRATCH_ARENA
+   OpusScratchState prev_scratch = opus_scratch_begin(st->scratch, st->scratch_size);
+#endif
    ALLOC_STACK;
 
    frame_size = frame_size_select(analysis_frame_size, st->variable_duration, st->Fs);
-   if (frame_size <= 0)
+   if (frame_size <= 0 || !RESERVE_STACK(OPUS_ENCODER_SCRATCH_SIZE(st->channels)))
    {
       RESTORE_STACK;
-      return OPUS_BAD_ARG;
+#ifdef SCRATCH_ARENA
+      opus_scratch_end(prev_scratch);
+#endif
+      return frame_size <= 0 ? OPUS_BAD_ARG : OPUS_ALLOC_FAIL;
    }
    ALLOC(in, frame_size*st->channels, opus_int16);
 
@@ -2482,6 +2622,9 @@ opus_int32 opus_encode_float(OpusEncoder *st, const float *pcm, int analysis_fra
    ret = opus_encode_native(st, in, frame_size, data, max_data_bytes, 16,
                             pcm, analysis_frame_size, 0, -2, st->channels, downmix_float, 1);
    RESTORE_STACK;
+#ifdef SCRATCH_ARENA
+   opus_scratch_end(prev_scratch);
+#endif
    return ret;
 }
 #endif
@@ -2502,13 +2645,19 @@ opus_int32 opus_encode(OpusEncoder *st, const opus_int16 *pcm, int analysis_fram
    int i, ret;
    int frame_size;
    VARDECL(float, in);
+#ifdef SCRATCH_ARENA
+   OpusScratchState prev_scratch = opus_scratch_begin(st->scratch, st->scratch_size);
+#endif
    ALLOC_STACK;
 
    frame_size = frame_size_select(analysis_frame_size, st->variable_duration, st->Fs);
-   if (frame_size <= 0)
+   if (frame_size <= 0 || !RESERVE_STACK(OPUS_ENCODER_SCRATCH_SIZE(st->channels)))
    {
       RESTORE_STACK;
-      return OPUS_BAD_ARG;
+#ifdef SCRATCH_ARENA
+      opus_scratch_end(prev_scratch);
+#endif
+      return frame_size <= 0 ? OPUS_BAD_ARG : OPUS_ALLOC_FAIL;
    }
    ALLOC(in, frame_size*st->channels, float);
 
@@ -2517,6 +2666,9 @@ opus_int32 opus_encode(OpusEncoder *st, const opus_int16 *pcm, int analysis_fram
    ret = opus_encode_native(st, in, frame_size, data, max_data_bytes, 16,
                             pcm, analysis_frame_size, 0, -2, st->channels, downmix_int, 0);
    RESTORE_STACK;
+#ifdef SCRATCH_ARENA
+   opus_scratch_end(prev_scratch);
+#endif
    return ret;
 }
 opus_int32 opus_encode_float(OpusEncoder *st, const float *pcm, int analysis_frame_size,
@@ -2924,6 +3076,22 @@ int opus_encoder_ctl(OpusEncoder *st, int request, ...)
            *value = st->silk_mode.reducedDependency;
         }
         break;
+        case OPUS_SET_PITCH_TRACKING_REQUEST:
+        {
+           opus_int32 value = va_arg(ap, opus_int32);
+           if (value > 1 || value < 0)
+              goto bad_arg;
+           st->silk_mode.pitchTracking = value;
+        }
+        break;
+        case OPUS_GET_PITCH_TRACKING_REQUEST:
+        {
+           opus_int32 *value = va_arg(ap, opus_int32*);
+           if (!value)
+              goto bad_arg;
+           *value = st->silk_mode.pitchTracking;
+        }
+        break;
         case OPUS_SET_PHASE_INVERSION_DISABLED_REQUEST:
         {
             opus_int32 value = va_arg(ap, opus_int32);
@@ -2966,6 +3134,35 @@ int opus_encoder_ctl(OpusEncoder *st, int request, ...)
             *value = st->dred_duration;
         }
         break;
+        case OPUS_SET_DRED_WORKER_REQUEST:
+        {
+            const OpusDREDWorker *value = va_arg(ap, const OpusDREDWorker*);
+#ifdef NONTHREADSAFE_PSEUDOSTACK
+            (void)value;
+            ret = OPUS_UNIMPLEMENTED;
+#else
+            if (value != NULL && (value->start == NULL || value->wait == NULL))
+            {
+               goto bad_arg;
+            }
+            dred_finish_job(st, 0);
+            if (value != NULL)
+               st->dred_worker = *value;
+            else
+               OPUS_CLEAR(&st->dred_worker, 1);
+#endif
+        }
+        break;
+        case OPUS_GET_DRED_DELAY_REQUEST:
+        {
+            opus_int32 *value = va_arg(ap, opus_int32*);
+            if (!value)
+            {
+               goto bad_arg;
+            }
+            *value = st->dred_delay;
+        }
+        break;
 #endif
         case OPUS_RESET_STATE:
         {
@@ -2973,6 +3170,9 @@ int opus_encoder_ctl(OpusEncoder *st, int request, ...)
            silk_EncControlStruct dummy;
            char *start;
            silk_enc = (char*)st+st->silk_enc_offset;
+#ifdef ENABLE_DRED
+           dred_finish_job(st, 0);
+#endif
 #ifndef DISABLE_FLOAT_API
            tonality_analysis_reset(&st->analysis);
 #endif
@@ -3019,6 +3219,16 @@ int opus_encoder_ctl(OpusEncoder *st, int request, ...)
             ret = celt_encoder_ctl(celt_enc, OPUS_SET_ENERGY_MASK(value));
         }
         break;
+        case OPUS_GET_SILK_RATE_PASSES_REQUEST:
+        {
+            opus_int32 *value = va_arg(ap, opus_int32*);
+            if (!value)
+            {
+                goto bad_arg;
+            }
+            *value = st->silk_rate_passes;
+        }
+        break;
         case OPUS_GET_IN_DTX_REQUEST:
         {
             opus_int32 *value = va_arg(ap, opus_int32*);
@@ -3056,11 +3266,67 @@ int opus_encoder_ctl(OpusEncoder *st, int request, ...)
                goto bad_arg;
             }
 #ifdef ENABLE_DRED
+            dred_finish_job(st, 0);
             ret = dred_encoder_load_model(&st->dred_encoder, data, len);
+            if (ret == OPUS_OK)
+            {
+               /* The blob replaces any attached model. */
+               dnn_model_unref(st->dnn_model);
+               st->dnn_model = NULL;
+            }
 #endif
         }
         break;
 #endif
+#ifdef ENABLE_DRED
+        case OPUS_SET_DNN_MODEL_REQUEST:
+        {
+            OpusDNNModel *value = va_arg(ap, OpusDNNModel *);
+            dred_finish_job(st, 0);
+            ret = dred_encoder_set_model(&st->dred_encoder, value);
+            if (ret != OPUS_OK)
+               break;
+            dnn_model_ref(value);
+            dnn_model_unref(st->dnn_model);
+            st->dnn_model = value;
+        }
+        break;
+#endif
+#ifdef ENABLE_PROFILING
+        case OPUS_GET_PROFILE_STATS_REQUEST:
+        {
+            OpusProfileStats *value = va_arg(ap, OpusProfileStats*);
+            if (!value)
+            {
+               goto bad_arg;
+            }
+            *value = st->profile;
+        }
+        break;
+        case OPUS_RESET_PROFILE_STATS_REQUEST:
+        {
+            OPUS_CLEAR(&st->profile, 1);
+        }
+        break;
+#endif
+        case OPUS_SET_SCRATCH_ARENA_REQUEST:
+        {
+            void *value = va_arg(ap, void*);
+            opus_int32 size = va_arg(ap, opus_int32);
+#ifdef SCRATCH_ARENA
+            if (value != NULL && size < opus_encoder_get_scratch_size(st->channels))
+            {
+               goto bad_arg;
+            }
+            st->scratch = (char*)value;
+            st->scratch_size = value != NULL ? size : 0;
+#else
+            (void)value;
+            (void)size;
+            ret = OPUS_UNIMPLEMENTED;
+#endif
+        }
+        break;
         case CELT_GET_MODE_REQUEST:
         {
            const CELTMode ** value = va_arg(ap, const CELTMode**);
@@ -3083,7 +3349,22 @@ bad_arg:
     return OPUS_BAD_ARG;
 }
 
+void opus_encoder_deinit(OpusEncoder *st)
+{
+#ifdef ENABLE_DRED
+    if (st)
+    {
+       dred_finish_job(st, 0);
+       dnn_model_unref(st->dnn_model);
+       st->dnn_model = NULL;
+    }
+#else
+    (void)st;
+#endif
+}
+
 void opus_encoder_destroy(OpusEncoder *st)
 {
+    opus_encoder_deinit(st);
     opus_free(st);
 }
@@ -205,6 +205,11 @@ int opus_multistream_decode_native(
    /* Limit frame_size to avoid excessive stack allocations. */
    MUST_SUCCEED(opus_multistream_decoder_ctl(st, OPUS_GET_SAMPLE_RATE(&Fs)));
    frame_size = IMIN(frame_size, Fs/25*3);
+   if (!RESERVE_STACK(GLOBAL_STACK_SIZE + 2*frame_size*sizeof(opus_val16)))
+   {
+      RESTORE_STACK;
+      return OPUS_ALLOC_FAIL;
+   }
    ALLOC(buf, 2*frame_size, opus_val16);
    ptr = (char*)st + align(sizeof(OpusMSDecoder));
    coupled_size = opus_decoder_get_size(2);
@@ -433,6 +438,7 @@ int opus_multistream_decoder_ctl_va_list(OpusMSDecoder *st, int request,
        case OPUS_GET_GAIN_REQUEST:
        case OPUS_GET_LAST_PACKET_DURATION_REQUEST:
        case OPUS_GET_PHASE_INVERSION_DISABLED_REQUEST:
+       case OPUS_GET_DEEP_PLC_LOOKAHEAD_REQUEST:
        {
           OpusDecoder *dec;
           /* For int32* GET params, just query the first stream */
@@ -508,6 +514,7 @@ int opus_multistream_decoder_ctl_va_list(OpusMSDecoder *st, int request,
        break;
        case OPUS_SET_GAIN_REQUEST:
        case OPUS_SET_PHASE_INVERSION_DISABLED_REQUEST:
+       case OPUS_SET_DEEP_PLC_LOOKAHEAD_REQUEST:
        {
           int s;
           /* This works for int32 params */
@@ -456,6 +456,8 @@ static int opus_multistream_encoder_init_impl(
    st->bitrate_bps = OPUS_AUTO;
    st->application = application;
    st->variable_duration = OPUS_FRAMESIZE_ARG;
+   st->run_tasks = NULL;
+   st->run_tasks_data = NULL;
    for (i=0;i<st->layout.nb_channels;i++)
       st->layout.mapping[i] = mapping[i];
    if (!validate_layout(&st->layout))
@@ -799,6 +801,146 @@ static opus_int32 rate_allocation(
 
 /* Max size in case the encoder decides to return six frames (6 x 20 ms = 120 ms) */
 #define MS_FRAME_TMP (6*1275+12)
+
+/* Everything needed to encode one elementary stream, shared by all streams
+   of a packet. */
+typedef struct {
+   OpusMSEncoder *st;
+   opus_copy_channel_in_func copy_channel_in;
+   const void *pcm;
+   int analysis_frame_size;
+   int frame_size;
+   int lsb_depth;
+   downmix_func downmix;
+   int float_api;
+   void *user_data;
+   const opus_val16 *bandSMR;
+   /* Only used for concurrent encoding. */
+   unsigned char *stream_data;
+   opus_int32 stream_max;
+   opus_int32 stream_len[256];
+} MSEncodeJob;
+
+static OpusEncoder *ms_get_stream_encoder(OpusMSEncoder *st, int s)
+{
+   char *ptr;
+   int nb_coupled;
+   ptr = (char*)st + align(sizeof(OpusMSEncoder));
+   nb_coupled = IMIN(s, st->layout.nb_coupled_streams);
+   ptr += nb_coupled*align(opus_encoder_get_size(2));
+   ptr += (s-nb_coupled)*align(opus_encoder_get_size(1));
+   return (OpusEncoder*)ptr;
+}
+
+/* Bytes available to stream s once the previous streams used tot_size bytes. */
+static opus_int32 ms_stream_budget(const OpusMSEncoder *st, int s,
+      opus_int32 max_data_bytes, opus_int32 tot_size, opus_int32 Fs, int frame_size)
+{
+   opus_int32 curr_max;
+   /* number of bytes left (+Toc) */
+   curr_max = max_data_bytes - tot_size;
+   /* Reserve one byte for the last stream and two for the others */
+   curr_max -= IMAX(0,2*(st->layout.nb_streams-s-1)-1);
+   /* For 100 ms, reserve an extra byte per stream for the ToC */
+   if (Fs/frame_size == 10)
+     curr_max -= st->layout.nb_streams-s-1;
+   curr_max = IMIN(curr_max,MS_FRAME_TMP);
+   /* Repacketizer will add one or two bytes for self-delimited frames */
+   if (s != st->layout.nb_streams-1) curr_max -=  curr_max>253 ? 2 : 1;
+   return curr_max;
+}
+
+/* Streams can be encoded concurrently when the output they produce cannot
+   depend on how many bytes the previous streams used. For frames of 20 ms or
+   less opus_encode_native() clamps its budget to 1276 bytes, so any budget
+   above that is equivalent; longer frames need the full MS_FRAME_TMP. We check
+   this assuming every previous stream used its largest possible size. */
+static int ms_can_encode_concurrently(const OpusMSEncoder *st, opus_int32 max_data_bytes,
+      opus_int32 Fs, int frame_size, int vbr)
+{
+   int s;
+   opus_int32 stream_max;
+   if (st->run_tasks == NULL || !vbr || st->layout.nb_streams < 2)
+      return 0;
+   stream_max = frame_size <= Fs/50 ? 1276 : MS_FRAME_TMP;
+   for (s=0;s<st->layout.nb_streams;s++)
+   {
+      opus_int32 curr_max;
+      curr_max = ms_stream_budget(st, s, max_data_bytes, s*(stream_max+2), Fs, frame_size);
+      if (curr_max < IMIN(stream_max, ms_stream_budget(st, s, max_data_bytes, 0, Fs, frame_size)))
+         return 0;
+   }
+   return 1;
+}
+
+static opus_int32 ms_encode_stream(const MSEncodeJob *job, int s,
+      unsigned char *data, opus_int32 max_data_bytes)
+{
+   OpusMSEncoder *st;
+   OpusEncoder *enc;
+   int c1, c2;
+   opus_int32 len;
+   VARDECL(opus_val16, buf);
+   opus_val16 bandLogE[42];
+   SAVE_STACK;
+
+   st = job->st;
+   enc = ms_get_stream_encoder(st, s);
+   /* Only needed on the threads of a task runner. */
+   if (!RESERVE_STACK(2*job->frame_size*sizeof(opus_val16) + opus_encoder_get_scratch_size(2)))
+   {
+      RESTORE_STACK;
+      return OPUS_ALLOC_FAIL;
+   }
+   ALLOC(buf, 2*job->frame_size, opus_val16);
+   if (s < st->layout.nb_coupled_streams)
+   {
+      int i;
+      int left, right;
+      left = get_left_channel(&st->layout, s, -1);
+      right = get_right_channel(&st->layout, s, -1);
+      (*job->copy_channel_in)(buf, 2,
+         job->pcm, st->layout.nb_channels, left, job->frame_size, job->user_data);
+      (*job->copy_channel_in)(buf+1, 2,
+         job->pcm, st->layout.nb_channels, right, job->frame_size, job->user_data);
+      if (st->mapping_type == MAPPING_TYPE_SURROUND)
+      {
+         for (i=0;i<21;i++)
+         {
+            bandLogE[i] = job->bandSMR[21*left+i];
+            bandLogE[21+i] = job->bandSMR[21*right+i];
+         }
+      }
+      c1 = left;
+      c2 = right;
+   } else {
+      int i;
+      int chan = get_mono_channel(&st->layout, s, -1);
+      (*job->copy_channel_in)(buf, 1,
+         job->pcm, st->layout.nb_channels, chan, job->frame_size, job->user_data);
+      if (st->mapping_type == MAPPING_TYPE_SURROUND)
+      {
+         for (i=0;i<21;i++)
+            bandLogE[i] = job->bandSMR[21*chan+i];
+      }
+      c1 = chan;
+      c2 = -1;
+   }
+   if (st->mapping_type == MAPPING_TYPE_SURROUND)
+      opus_encoder_ctl(enc, OPUS_SET_ENERGY_MASK(bandLogE));
+   len = opus_encode_native(enc, buf, job->frame_size, data, max_data_bytes, job->lsb_depth,
+         job->pcm, job->analysis_frame_size, c1, c2, st->layout.nb_channels, job->downmix, job->float_api);
+   RESTORE_STACK;
+   return len;
+}
+
+static void ms_encode_stream_task(void *arg, int s)
+{
+   MSEncodeJob *job = (MSEncodeJob*)arg;
+   job->stream_len[s] = ms_encode_stream(job, s,
+         job->stream_data + s*job->stream_max, job->stream_max);
+}
+
 int opus_multistream_encode_native
 (
     OpusMSEncoder *st,
@@ -819,14 +961,15 @@ int opus_multistream_encode_native
    int s;
    char *ptr;
    int tot_size;
-   VARDECL(opus_val16, buf);
    VARDECL(opus_val16, bandSMR);
-   unsigned char tmp_data[MS_FRAME_TMP];
+   VARDECL(unsigned char, tmp_data);
+   unsigned char *stream_buf = NULL;
    OpusRepacketizer rp;
    opus_int32 vbr;
    const CELTMode *celt_mode;
    opus_int32 bitrates[256];
-   opus_val16 bandLogE[42];
+   MSEncodeJob job;
+   int concurrent;
    opus_val32 *mem = NULL;
    opus_val32 *preemph_mem=NULL;
    int frame_size;
@@ -862,10 +1005,15 @@ int opus_multistream_encode_native
       RESTORE_STACK;
       return OPUS_BUFFER_TOO_SMALL;
    }
-   ALLOC(buf, 2*frame_size, opus_val16);
    coupled_size = opus_encoder_get_size(2);
    mono_size = opus_encoder_get_size(1);
 
+   if (!RESERVE_STACK(21*st->layout.nb_channels*sizeof(opus_val16) + MS_FRAME_TMP
+         + 2*frame_size*sizeof(opus_val16) + opus_encoder_get_scratch_size(2)))
+   {
+      RESTORE_STACK;
+      return OPUS_ALLOC_FAIL;
+   }
    ALLOC(bandSMR, 21*st->layout.nb_channels, opus_val16);
    if (st->mapping_type == MAPPING_TYPE_SURROUND)
    {
@@ -922,83 +1070,69 @@ int opus_multistream_encode_native
       }
    }
 
-   ptr = (char*)st + align(sizeof(OpusMSEncoder));
+   job.st = st;
+   job.copy_channel_in = copy_channel_in;
+   job.pcm = pcm;
+   job.analysis_frame_size = analysis_frame_size;
+   job.frame_size = frame_size;
+   job.lsb_depth = lsb_depth;
+   job.downmix = downmix;
+   job.float_api = float_api;
+   job.user_data = user_data;
+   job.bandSMR = bandSMR;
+   concurrent = ms_can_encode_concurrently(st, max_data_bytes, Fs, frame_size, vbr);
+   job.stream_max = frame_size <= Fs/50 ? 1276 : MS_FRAME_TMP;
+   if (concurrent)
+   {
+      /* Every stream needs its own output buffer, which can reach nearly
+         2 MB with 255 streams, so it comes from the heap rather than the
+         stack or scratch arena. Fall back to the serial loop if it fails. */
+      stream_buf = (unsigned char *)opus_alloc(st->layout.nb_streams*job.stream_max);
+      concurrent = stream_buf != NULL;
+   }
+   ALLOC(tmp_data, MS_FRAME_TMP, unsigned char);
+   if (concurrent)
+   {
+      job.stream_data = stream_buf;
+      (*st->run_tasks)(st->run_tasks_data, ms_encode_stream_task, &job, st->layout.nb_streams);
+   }
+
    /* Counting ToC */
    tot_size = 0;
    for (s=0;s<st->layout.nb_streams;s++)
    {
-      OpusEncoder *enc;
+      unsigned char *stream_data;
       int len;
-      int curr_max;
-      int c1, c2;
       int ret;
 
       opus_repacketizer_init(&rp);
-      enc = (OpusEncoder*)ptr;
-      if (s < st->layout.nb_coupled_streams)
+      if (concurrent)
       {
-         int i;
-         int left, right;
-         left = get_left_channel(&st->layout, s, -1);
-         right = get_right_channel(&st->layout, s, -1);
-         (*copy_channel_in)(buf, 2,
-            pcm, st->layout.nb_channels, left, frame_size, user_data);
-         (*copy_channel_in)(buf+1, 2,
-            pcm, st->layout.nb_channels, right, frame_size, user_data);
-         ptr += align(coupled_size);
-         if (st->mapping_type == MAPPING_TYPE_SURROUND)
-         {
-            for (i=0;i<21;i++)
-            {
-               bandLogE[i] = bandSMR[21*left+i];
-               bandLogE[21+i] = bandSMR[21*right+i];
-            }
-         }
-         c1 = left;
-         c2 = right;
+         stream_data = stream_buf + s*job.stream_max;
+         len = job.stream_len[s];
       } else {
-         int i;
-         int chan = get_mono_channel(&st->layout, s, -1);
-         (*copy_channel_in)(buf, 1,
-            pcm, st->layout.nb_channels, chan, frame_size, user_data);
-         ptr += align(mono_size);
-         if (st->mapping_type == MAPPING_TYPE_SURROUND)
-         {
-            for (i=0;i<21;i++)
-               bandLogE[i] = bandSMR[21*chan+i];
-         }
-         c1 = chan;
-         c2 = -1;
+         int curr_max;
+         curr_max = ms_stream_budget(st, s, max_data_bytes, tot_size, Fs, frame_size);
+         if (!vbr && s == st->layout.nb_streams-1)
+            opus_encoder_ctl(ms_get_stream_encoder(st, s), OPUS_SET_BITRATE(curr_max*(8*Fs/frame_size)));
+         stream_data = tmp_data;
+         len = ms_encode_stream(&job, s, stream_data, curr_max);
       }
-      if (st->mapping_type == MAPPING_TYPE_SURROUND)
-         opus_encoder_ctl(enc, OPUS_SET_ENERGY_MASK(bandLogE));
-      /* number of bytes left (+Toc) */
-      curr_max = max_data_bytes - tot_size;
-      /* Reserve one byte for the last stream and two for the others */
-      curr_max -= IMAX(0,2*(st->layout.nb_streams-s-1)-1);
-      /* For 100 ms, reserve an extra byte per stream for the ToC */
-      if (Fs/frame_size == 10)
-        curr_max -= st->layout.nb_streams-s-1;
-      curr_max = IMIN(curr_max,MS_FRAME_TMP);
-      /* Repacketizer will add one or two bytes for self-delimited frames */
-      if (s != st->layout.nb_streams-1) curr_max -=  curr_max>253 ? 2 : 1;
-      if (!vbr && s == st->layout.nb_streams-1)
-         opus_encoder_ctl(enc, OPUS_SET_BITRATE(curr_max*(8*Fs/frame_size)));
-      len = opus_encode_native(enc, buf, frame_size, tmp_data, curr_max, lsb_depth,
-            pcm, analysis_frame_size, c1, c2, st->layout.nb_channels, downmix, float_api);
       if (len<0)
       {
+         opus_free(stream_buf);
          RESTORE_STACK;
          return len;
       }
       /* We need to use the repacketizer to add the self-delimiting lengths
          while taking into account the fact that the encoder can now return
          more than one frame at a time (e.g. 60 ms CELT-only) */
-      ret = opus_repacketizer_cat(&rp, tmp_data, len);
+      ret = opus_repacketizer_cat(&rp, stream_data, len);
       /* If the opus_repacketizer_cat() fails, then something's seriously wrong
          with the encoder. */
       if (ret != OPUS_OK)
       {
+         opus_free(stream_buf);
          RESTORE_STACK;
          return OPUS_INTERNAL_ERROR;
       }
@@ -1008,6 +1142,7 @@ int opus_multistream_encode_native
       tot_size += len;
    }
    /*printf("\n");*/
+   opus_free(stream_buf);
    RESTORE_STACK;
    return tot_size;
 }
@@ -1176,6 +1311,7 @@ int opus_multistream_encoder_ctl_va_list(OpusMSEncoder *st, int request,
    case OPUS_GET_INBAND_FEC_REQUEST:
    case OPUS_GET_FORCE_CHANNELS_REQUEST:
    case OPUS_GET_PREDICTION_DISABLED_REQUEST:
+   case OPUS_GET_PITCH_TRACKING_REQUEST:
    case OPUS_GET_PHASE_INVERSION_DISABLED_REQUEST:
    {
       OpusEncoder *enc;
@@ -1223,6 +1359,7 @@ int opus_multistream_encoder_ctl_va_list(OpusMSEncoder *st, int request,
    case OPUS_SET_FORCE_MODE_REQUEST:
    case OPUS_SET_FORCE_CHANNELS_REQUEST:
    case OPUS_SET_PREDICTION_DISABLED_REQUEST:
+   case OPUS_SET_PITCH_TRACKING_REQUEST:
    case OPUS_SET_PHASE_INVERSION_DISABLED_REQUEST:
    {
       int s;
@@ -1266,6 +1403,20 @@ int opus_multistream_encoder_ctl_va_list(OpusMSEncoder *st, int request,
       *value = (OpusEncoder*)ptr;
    }
    break;
+   case OPUS_MULTISTREAM_SET_TASK_RUNNER_REQUEST:
+   {
+      opus_ms_run_tasks_func value = va_arg(ap, opus_ms_run_tasks_func);
+      void *data = va_arg(ap, void*);
+#ifdef NONTHREADSAFE_PSEUDOSTACK
+      (void)value;
+      (void)data;
+      ret = OPUS_UNIMPLEMENTED;
+#else
+      st->run_tasks = value;
+      st->run_tasks_data = data;
+#endif
+   }
+   break;
    case OPUS_SET_EXPERT_FRAME_DURATION_REQUEST:
    {
        opus_int32 value = va_arg(ap, opus_int32);
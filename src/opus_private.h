@@ -31,6 +31,7 @@
 
 #include "arch.h"
 #include "opus.h"
+#include "opus_multistream.h"
 #include "celt.h"
 
 #include <stdarg.h> /* va_list */
@@ -91,6 +92,8 @@ struct OpusMSEncoder {
    int variable_duration;
    MappingType mapping_type;
    opus_int32 bitrate_bps;
+   opus_ms_run_tasks_func run_tasks;
+   void *run_tasks_data;
    /* Encoder states go here */
    /* then opus_val32 window_mem[channels*120]; */
    /* then opus_val32 preemph_mem[channels]; */
@@ -176,6 +179,10 @@ int opus_decode_native(OpusDecoder *st, const unsigned char *data, opus_int32 le
       opus_val16 *pcm, int frame_size, int decode_fec, int self_delimited,
       opus_int32 *packet_offset, int soft_clip, const OpusDRED *dred, opus_int32 dred_offset);
 
+#ifndef DISABLE_FLOAT_API
+void opus_pcm_soft_clip_impl(float *_x, int N, int C, float *declip_mem, int arch);
+#endif
+
 /* Make sure everything is properly aligned. */
 static OPUS_INLINE int align(int i)
 {
@@ -143,6 +143,11 @@ int opus_projection_decoder_init(OpusProjectionDecoder *st, opus_int32 Fs,
   }
 
   /* Convert demixing matrix input into internal format. */
+  if (!RESERVE_STACK(nb_input_streams * channels * sizeof(opus_int16)))
+  {
+    RESTORE_STACK;
+    return OPUS_ALLOC_FAIL;
+  }
   ALLOC(buf, nb_input_streams * channels, opus_int16);
   for (i = 0; i < nb_input_streams * channels; i++)
   {
@@ -145,6 +145,11 @@ opus_int32 opus_repacketizer_out_range_impl(OpusRepacketizer *rp, int begin, int
       int n = opus_packet_extensions_count(rp->paddings[i], rp->padding_len[i]);
       if (n > 0) total_ext_count += n;
    }
+   if (!RESERVE_STACK(total_ext_count*sizeof(opus_extension_data)))
+   {
+      RESTORE_STACK;
+      return OPUS_ALLOC_FAIL;
+   }
    ALLOC(all_extensions, total_ext_count ? total_ext_count : ALLOC_NONE, opus_extension_data);
    /* copy over any extensions that were passed in */
    for (ext_count=0;ext_count<nb_extensions;ext_count++)
@@ -258,7 +263,11 @@ opus_int32 opus_repacketizer_out_range_impl(OpusRepacketizer *rp, int begin, int
       {
          /* figure out how much space we need for the extensions */
          ext_len = opus_packet_extensions_generate(NULL, maxlen-tot_size, all_extensions, ext_count, 0);
-         if (ext_len < 0) return ext_len;
+         if (ext_len < 0)
+         {
+            RESTORE_STACK;
+            return ext_len;
+         }
          if (!pad)
             pad_amount = ext_len + ext_len/254 + 1;
       }
@@ -331,6 +340,7 @@ opus_int32 opus_packet_pad_impl(unsigned char *data, opus_int32 len, opus_int32
 {
    OpusRepacketizer rp;
    opus_int32 ret;
+   opus_int32 ext_count;
    VARDECL(unsigned char, copy);
    SAVE_STACK;
    if (len < 1)
@@ -339,13 +349,29 @@ opus_int32 opus_packet_pad_impl(unsigned char *data, opus_int32 len, opus_int32
       return OPUS_OK;
    else if (len > new_len)
       return OPUS_BAD_ARG;
+   /* Count the extensions opus_repacketizer_out_range_impl() will collect. */
+   opus_repacketizer_init(&rp);
+   ret = opus_repacketizer_cat(&rp, data, len);
+   if (ret != OPUS_OK)
+      return ret;
+   ext_count = opus_packet_extensions_count(rp.paddings[0], rp.padding_len[0]);
+   ext_count = nb_extensions + (ext_count > 0 ? ext_count : 0);
+   /* The second ALLOC may need up to 15 bytes of alignment. */
+   if (!RESERVE_STACK(len + 15 + ext_count*sizeof(opus_extension_data)))
+   {
+      RESTORE_STACK;
+      return OPUS_ALLOC_FAIL;
+   }
    ALLOC(copy, len, unsigned char);
    opus_repacketizer_init(&rp);
    /* Moving payload to the end of the packet so we can do in-place padding */
    OPUS_COPY(copy, data, len);
    ret = opus_repacketizer_cat(&rp, copy, len);
    if (ret != OPUS_OK)
+   {
+      RESTORE_STACK;
       return ret;
+   }
    ret = opus_repacketizer_out_range_impl(&rp, 0, rp.nb_frames, data, new_len, 0, pad, extensions, nb_extensions);
    RESTORE_STACK;
    return ret;
@@ -322,6 +322,57 @@ opus_int32 test_dec_api(void)
    fprintf(stdout,"    opus_decode_float() .......................... OK.\n");
 #endif
 
+   {
+      OpusProfileStats stats;
+      err=opus_decoder_ctl(dec,OPUS_GET_PROFILE_STATS(&stats));
+      if(err==OPUS_OK)
+      {
+         if(stats.calls[OPUS_PROFILE_TOTAL]<1)test_failed();
+         if(opus_decoder_ctl(dec,OPUS_RESET_PROFILE_STATS)!=OPUS_OK)test_failed();
+         if(opus_decoder_ctl(dec,OPUS_GET_PROFILE_STATS(&stats))!=OPUS_OK)test_failed();
+         if(stats.calls[OPUS_PROFILE_TOTAL]!=0||stats.time_ns[OPUS_PROFILE_TOTAL]!=0)test_failed();
+      } else if(err!=OPUS_UNIMPLEMENTED)test_failed();
+      cfgs++;
+      fprintf(stdout,"    OPUS_GET_PROFILE_STATS ....................... OK.\n");
+   }
+
+   {
+      OpusDNNGovernor *gov;
+      OpusDNNGovernorStats gstats;
+      gov=opus_dnn_governor_create(1000000,&err);
+      if(gov!=NULL)
+      {
+         if(err!=OPUS_OK)test_failed();
+         if(opus_dnn_governor_create(0,&err)!=NULL||err!=OPUS_BAD_ARG)test_failed();
+         if(opus_decoder_ctl(dec,OPUS_SET_DNN_GOVERNOR(gov))!=OPUS_OK)test_failed();
+         if(opus_dnn_governor_get_stats(gov,&gstats)!=OPUS_OK)test_failed();
+         if(gstats.decoders!=1||gstats.level!=0)test_failed();
+         /*The decoder keeps its own reference.*/
+         opus_dnn_governor_destroy(gov);
+         if(opus_decode(dec, NULL, 0, sbuf, 960, 0)!=960)test_failed();
+         if(opus_decoder_ctl(dec,OPUS_SET_DNN_GOVERNOR(NULL))!=OPUS_OK)test_failed();
+      } else if(err!=OPUS_UNIMPLEMENTED)test_failed();
+      cfgs++;
+      fprintf(stdout,"    OPUS_SET_DNN_GOVERNOR ........................ OK.\n");
+   }
+
+   err=opus_decoder_ctl(dec,OPUS_SET_DEEP_PLC_LOOKAHEAD(1));
+   if(err==OPUS_OK)
+   {
+      if(opus_decoder_ctl(dec,OPUS_SET_DEEP_PLC_LOOKAHEAD(2))!=OPUS_BAD_ARG)test_failed();
+      if(opus_decoder_ctl(dec,OPUS_SET_DEEP_PLC_LOOKAHEAD(-1))!=OPUS_BAD_ARG)test_failed();
+      VG_UNDEF(&i,sizeof(i));
+      if(opus_decoder_ctl(dec,OPUS_GET_DEEP_PLC_LOOKAHEAD(&i))!=OPUS_OK||i!=1)test_failed();
+      if(opus_decoder_ctl(dec,OPUS_GET_DEEP_PLC_LOOKAHEAD(null_int_ptr))!=OPUS_BAD_ARG)test_failed();
+      if(opus_decoder_ctl(dec,OPUS_RESET_STATE)!=OPUS_OK)test_failed();
+      if(opus_decoder_ctl(dec,OPUS_GET_DEEP_PLC_LOOKAHEAD(&i))!=OPUS_OK||i!=1)test_failed();
+      if(opus_decode(dec, packet, 3, sbuf, 960, 0)!=960)test_failed();
+      if(opus_decode(dec, NULL, 0, sbuf, 960, 0)!=960)test_failed();
+      if(opus_decoder_ctl(dec,OPUS_SET_DEEP_PLC_LOOKAHEAD(0))!=OPUS_OK)test_failed();
+   } else if(err!=OPUS_UNIMPLEMENTED)test_failed();
+   cfgs++;
+   fprintf(stdout,"    OPUS_SET_DEEP_PLC_LOOKAHEAD .................. OK.\n");
+
 #if 0
    /*These tests are disabled because the library crashes with null states*/
    if(opus_decoder_ctl(0,OPUS_RESET_STATE)         !=OPUS_INVALID_STATE)test_failed();
@@ -1062,6 +1113,30 @@ opus_int32 test_parse(void)
    fprintf(stdout,gok);\
    cfgs+=6;
 
+/*A worker that defers each task until it is waited for.*/
+typedef struct {
+   void (*task)(void *arg);
+   void *arg;
+   int started;
+} deferred_worker;
+
+static void deferred_start(void *user_data, void (*task)(void *arg), void *arg)
+{
+   deferred_worker *w=(deferred_worker *)user_data;
+   if(w->task)test_failed();
+   w->task=task;
+   w->arg=arg;
+   w->started++;
+}
+
+static void deferred_wait(void *user_data)
+{
+   deferred_worker *w=(deferred_worker *)user_data;
+   if(!w->task)test_failed();
+   w->task(w->arg);
+   w->task=NULL;
+}
+
 opus_int32 test_enc_api(void)
 {
    opus_uint32 enc_final_range;
@@ -1360,6 +1435,16 @@ opus_int32 test_enc_api(void)
      "    OPUS_SET_PREDICTION_DISABLED ................. OK.\n",
      "    OPUS_GET_PREDICTION_DISABLED ................. OK.\n")
 
+   err=opus_encoder_ctl(enc,OPUS_GET_PITCH_TRACKING(&i));
+   if(i!=0)test_failed();
+   cfgs++;
+   err=opus_encoder_ctl(enc,OPUS_GET_PITCH_TRACKING(null_int_ptr));
+   if(err!=OPUS_BAD_ARG)test_failed();
+   cfgs++;
+   CHECK_SETGET(OPUS_SET_PITCH_TRACKING(i),OPUS_GET_PITCH_TRACKING(&i),-1,2,1,0,
+     "    OPUS_SET_PITCH_TRACKING ...................... OK.\n",
+     "    OPUS_GET_PITCH_TRACKING ...................... OK.\n")
+
    err=opus_encoder_ctl(enc,OPUS_GET_EXPERT_FRAME_DURATION(null_int_ptr));
    if(err!=OPUS_BAD_ARG)test_failed();
    cfgs++;
@@ -1416,6 +1501,14 @@ opus_int32 test_enc_api(void)
    VG_CHECK(packet,i);
    cfgs++;
    fprintf(stdout,"    opus_encode() ................................ OK.\n");
+   if(opus_encoder_ctl(enc,OPUS_GET_SILK_RATE_PASSES(null_int_ptr))!=OPUS_BAD_ARG)test_failed();
+   cfgs++;
+   VG_UNDEF(&i,sizeof(i));
+   if(opus_encoder_ctl(enc,OPUS_GET_SILK_RATE_PASSES(&i))!=OPUS_OK)test_failed();
+   /*At most 7 passes for each of the (up to) 2 channels of a 20 ms SILK frame.*/
+   if(i<0||i>14)test_failed();
+   cfgs++;
+   fprintf(stdout,"    OPUS_GET_SILK_RATE_PASSES .................... OK.\n");
 #ifndef DISABLE_FLOAT_API
    memset(fbuf,0,sizeof(float)*2*960);
    VG_UNDEF(packet,sizeof(packet));
@@ -1426,6 +1519,77 @@ opus_int32 test_enc_api(void)
    fprintf(stdout,"    opus_encode_float() .......................... OK.\n");
 #endif
 
+   {
+      OpusProfileStats stats;
+      err=opus_encoder_ctl(enc,OPUS_GET_PROFILE_STATS(&stats));
+      if(err==OPUS_OK)
+      {
+         /*The counters survive OPUS_RESET_STATE and cover the calls above.*/
+         if(stats.calls[OPUS_PROFILE_TOTAL]<1)test_failed();
+         if(opus_encoder_ctl(enc,OPUS_RESET_PROFILE_STATS)!=OPUS_OK)test_failed();
+         if(opus_encoder_ctl(enc,OPUS_GET_PROFILE_STATS(&stats))!=OPUS_OK)test_failed();
+         if(stats.calls[OPUS_PROFILE_TOTAL]!=0||stats.time_ns[OPUS_PROFILE_TOTAL]!=0)test_failed();
+      } else if(err!=OPUS_UNIMPLEMENTED)test_failed();
+      cfgs++;
+      fprintf(stdout,"    OPUS_GET_PROFILE_STATS ....................... OK.\n");
+   }
+
+   {
+      int size;
+      void *arena;
+      size=opus_encoder_get_scratch_size(2);
+      err=opus_encoder_ctl(enc,OPUS_SET_SCRATCH_ARENA(NULL,0));
+      if(err==OPUS_OK)
+      {
+         if(size<=0)test_failed();
+         arena=malloc(size);
+         if(!arena)test_failed();
+         if(opus_encoder_ctl(enc,OPUS_SET_SCRATCH_ARENA(arena,size-1))!=OPUS_BAD_ARG)test_failed();
+         if(opus_encoder_ctl(enc,OPUS_SET_SCRATCH_ARENA(arena,size))!=OPUS_OK)test_failed();
+         /*The arena survives OPUS_RESET_STATE.*/
+         if(opus_encoder_ctl(enc,OPUS_RESET_STATE)!=OPUS_OK)test_failed();
+         i=opus_encode(enc, sbuf, 960, packet, sizeof(packet));
+         if(i<1 || (i>(opus_int32)sizeof(packet)))test_failed();
+         if(opus_encoder_ctl(enc,OPUS_SET_SCRATCH_ARENA(NULL,0))!=OPUS_OK)test_failed();
+         free(arena);
+      } else if(err!=OPUS_UNIMPLEMENTED||size!=0)test_failed();
+      cfgs++;
+      fprintf(stdout,"    OPUS_SET_SCRATCH_ARENA ....................... OK.\n");
+   }
+
+   {
+      OpusDREDWorker worker;
+      deferred_worker w;
+      opus_int32 delay;
+      memset(&w,0,sizeof(w));
+      worker.start=deferred_start;
+      worker.wait=deferred_wait;
+      worker.user_data=&w;
+      err=opus_encoder_ctl(enc,OPUS_SET_DRED_WORKER(&worker));
+      if(err==OPUS_OK)
+      {
+         worker.wait=NULL;
+         if(opus_encoder_ctl(enc,OPUS_SET_DRED_WORKER(&worker))!=OPUS_BAD_ARG)test_failed();
+         if(opus_encoder_ctl(enc,OPUS_GET_DRED_DELAY(&delay))!=OPUS_OK)test_failed();
+         if(opus_encoder_ctl(enc,OPUS_SET_DRED_DURATION(10))!=OPUS_OK)test_failed();
+         for(j=0;j<3;j++)
+         {
+            i=opus_encode(enc, sbuf, 960, packet, sizeof(packet));
+            if(i<1 || (i>(opus_int32)sizeof(packet)))test_failed();
+         }
+         /*The worker is only used when the DRED weights are loaded.*/
+         if(opus_encoder_ctl(enc,OPUS_GET_DRED_DELAY(&delay))!=OPUS_OK)test_failed();
+         if(w.started>0&&delay!=960)test_failed();
+         if(w.started==0&&delay!=0)test_failed();
+         /*Detaching waits for the outstanding task.*/
+         if(opus_encoder_ctl(enc,OPUS_SET_DRED_WORKER(NULL))!=OPUS_OK)test_failed();
+         if(w.task)test_failed();
+         if(opus_encoder_ctl(enc,OPUS_SET_DRED_DURATION(0))!=OPUS_OK)test_failed();
+      } else if(err!=OPUS_UNIMPLEMENTED)test_failed();
+      cfgs++;
+      fprintf(stdout,"    OPUS_SET_DRED_WORKER ......................... OK.\n");
+   }
+
 #if 0
    /*These tests are disabled because the library crashes with null states*/
    if(opus_encoder_ctl(0,OPUS_RESET_STATE)               !=OPUS_INVALID_STATE)test_failed();
@@ -1440,6 +1604,147 @@ opus_int32 test_enc_api(void)
    return cfgs;
 }
 
+/* Encodes 120 ms frames at complexity 10 in every mode, with DRED when it is
+   available, through arenas of exactly opus_encoder_get_scratch_size() bytes,
+   which must not be overrun, and checks the packets against encoders without
+   arenas. Multistream encoders take their own buffers from the thread's
+   fallback arena, which the streams then share unless they have arenas. */
+#define SCRATCH_GUARD 64
+int test_scratch_api(void)
+{
+   static const opus_int32 apps[3]={OPUS_APPLICATION_VOIP,
+          OPUS_APPLICATION_AUDIO,OPUS_APPLICATION_RESTRICTED_LOWDELAY};
+   static const opus_int32 rates[3]={6000,32000,510000};
+   unsigned char mapping[6];
+   unsigned char *packet;
+   unsigned char *ref_packet;
+   void *arenas[6];
+   short *pcm;
+   OpusMSEncoder *ms_ref;
+   OpusMSEncoder *ms_enc;
+   int streams, coupled;
+   int cfgs,c,a,r,i,j,err;
+   opus_int32 len,ref_len;
+   cfgs=0;
+   fprintf(stdout,"\n  Scratch arena tests\n");
+   fprintf(stdout,"  ---------------------------------------------------\n");
+   packet=malloc(1276*6*6);
+   ref_packet=malloc(1276*6*6);
+   pcm=malloc(sizeof(*pcm)*5760*6);
+   if(!packet||!ref_packet||!pcm)test_failed();
+   Rw=Rz=1;
+   for(i=0;i<5760*6;i++)pcm[i]=(short)(((int)(fast_rand()&0xFFFF)-32768)/2);
+
+   for(c=1;c<=2;c++)
+   {
+      for(a=0;a<3;a++)
+      {
+         for(r=0;r<3;r++)
+         {
+            OpusEncoder *ref;
+            OpusEncoder *enc;
+            void *arena;
+            int size;
+            ref=opus_encoder_create(48000,c,apps[a],&err);
+            if(err!=OPUS_OK||!ref)test_failed();
+            enc=opus_encoder_create(48000,c,apps[a],&err);
+            if(err!=OPUS_OK||!enc)test_failed();
+            size=opus_encoder_get_scratch_size(c);
+            arena=size>0?malloc(size+SCRATCH_GUARD):NULL;
+            if(arena)memset((char*)arena+size,0xA5,SCRATCH_GUARD);
+            err=opus_encoder_ctl(enc,OPUS_SET_SCRATCH_ARENA(arena,size));
+            if(err==OPUS_UNIMPLEMENTED&&size==0)
+            {
+               opus_encoder_destroy(ref);
+               opus_encoder_destroy(enc);
+               cfgs+=5;
+               continue;
+            }
+            if(err!=OPUS_OK||!arena)test_failed();
+            for(j=0;j<2;j++)
+            {
+               OpusEncoder *e=j?enc:ref;
+               if(opus_encoder_ctl(e,OPUS_SET_BITRATE(rates[r]*c))!=OPUS_OK)test_failed();
+               if(opus_encoder_ctl(e,OPUS_SET_COMPLEXITY(10))!=OPUS_OK)test_failed();
+               if(opus_encoder_ctl(e,OPUS_SET_PACKET_LOSS_PERC(20))!=OPUS_OK)test_failed();
+               err=opus_encoder_ctl(e,OPUS_SET_DRED_DURATION(104));
+               if(err!=OPUS_OK&&err!=OPUS_UNIMPLEMENTED)test_failed();
+               cfgs+=4;
+            }
+            for(i=0;i<3;i++)
+            {
+               ref_len=opus_encode(ref,pcm+i*960*c,5760,ref_packet,1276*6);
+               len=opus_encode(enc,pcm+i*960*c,5760,packet,1276*6);
+               if(ref_len<1||len!=ref_len||memcmp(packet,ref_packet,len)!=0)test_failed();
+               cfgs+=2;
+            }
+            for(i=0;i<SCRATCH_GUARD;i++)if(((unsigned char*)arena)[size+i]!=0xA5)test_failed();
+            opus_encoder_destroy(ref);
+            opus_encoder_destroy(enc);
+            free(arena);
+         }
+      }
+   }
+   fprintf(stdout,"    Largest frames in all modes .................. OK.\n");
+
+   ms_ref=opus_multistream_surround_encoder_create(48000,6,1,&streams,&coupled,
+         mapping,OPUS_APPLICATION_AUDIO,&err);
+   if(err!=OPUS_OK||!ms_ref)test_failed();
+   ms_enc=opus_multistream_surround_encoder_create(48000,6,1,&streams,&coupled,
+         mapping,OPUS_APPLICATION_AUDIO,&err);
+   if(err!=OPUS_OK||!ms_enc)test_failed();
+   for(j=0;j<2;j++)
+   {
+      OpusMSEncoder *e=j?ms_enc:ms_ref;
+      if(opus_multistream_encoder_ctl(e,OPUS_SET_BITRATE(OPUS_BITRATE_MAX))!=OPUS_OK)test_failed();
+      if(opus_multistream_encoder_ctl(e,OPUS_SET_COMPLEXITY(10))!=OPUS_OK)test_failed();
+      cfgs+=2;
+   }
+   for(i=0;i<streams;i++)
+   {
+      OpusEncoder *sub;
+      int size=opus_encoder_get_scratch_size(i<coupled?2:1);
+      arenas[i]=size>0?malloc(size+SCRATCH_GUARD):NULL;
+      if(arenas[i])memset((char*)arenas[i]+size,0xA5,SCRATCH_GUARD);
+      if(opus_multistream_encoder_ctl(ms_enc,OPUS_MULTISTREAM_GET_ENCODER_STATE(i,&sub))!=OPUS_OK)test_failed();
+      err=opus_encoder_ctl(sub,OPUS_SET_SCRATCH_ARENA(arenas[i],size));
+      if(err!=OPUS_OK&&(err!=OPUS_UNIMPLEMENTED||size!=0))test_failed();
+      cfgs+=2;
+   }
+   for(i=0;i<3;i++)
+   {
+      ref_len=opus_multistream_encode(ms_ref,pcm,5760,ref_packet,1276*6*6);
+      len=opus_multistream_encode(ms_enc,pcm,5760,packet,1276*6*6);
+      if(ref_len<1||len!=ref_len||memcmp(packet,ref_packet,len)!=0)test_failed();
+      cfgs+=2;
+   }
+   for(i=0;i<streams;i++)
+   {
+      int size=opus_encoder_get_scratch_size(i<coupled?2:1);
+      for(j=0;j<SCRATCH_GUARD&&arenas[i];j++)if(((unsigned char*)arenas[i])[size+j]!=0xA5)test_failed();
+   }
+   fprintf(stdout,"    Largest multistream frames ................... OK.\n");
+
+   /*The fallback arena is allocated again after a release.*/
+   opus_thread_scratch_release();
+   len=opus_multistream_encode(ms_ref,pcm,5760,packet,1276*6*6);
+   if(len<1)test_failed();
+   opus_thread_scratch_release();
+   opus_thread_scratch_release();
+   cfgs+=2;
+   fprintf(stdout,"    opus_thread_scratch_release() ................ OK.\n");
+
+   opus_multistream_encoder_destroy(ms_ref);
+   opus_multistream_encoder_destroy(ms_enc);
+   for(i=0;i<streams;i++)free(arenas[i]);
+   free(pcm);
+   free(ref_packet);
+   free(packet);
+   fprintf(stdout,"                     All scratch arena tests passed\n");
+   fprintf(stdout,"                             (%d API invocations)\n",cfgs);
+   return cfgs;
+}
+
 #define max_out (1276*48+48*2+2)
 int test_repacketizer_api(void)
 {
@@ -1895,6 +2200,7 @@ int main(int _argc, char **_argv)
    total+=test_msdec_api();
    total+=test_parse();
    total+=test_enc_api();
+   total+=test_scratch_api();
    total+=test_repacketizer_api();
    total+=test_malloc_fail();
 
@@ -0,0 +1,424 @@
+/* Copyright (c) 2026 Xiph.Org Foundation */
+/*
+   Redistribution and use in source and binary forms, with or without
+   modification, are permitted provided that the following conditions
+   are met:
+
+   - Redistributions of source code must retain the above copyright
+   notice, this list of conditions and the following disclaimer.
+
+   - Redistributions in binary form must reproduce the above copyright
+   notice, this list of conditions and the following disclaimer in the
+   documentation and/or other materials provided with the distribution.
+
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+   ``AS IS'' AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+   LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+   A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER
+   OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+   EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+   PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+   PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+   LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+   NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#ifndef _WIN32
+#include <unistd.h>
+#else
+#include <process.h>
+#define getpid _getpid
+#endif
+
+#include "opus.h"
+#include "test_opus_common.h"
+#include "../src/opus_private.h"
+#include "vec.h"
+#include "nnet.h"
+#include "cpu_support.h"
+#ifndef USE_WEIGHTS_FILE
+#include "dnn_model.h"
+#include "plc_data.h"
+#include "fargan_data.h"
+#include "pitchdnn_data.h"
+#ifdef ENABLE_OSCE
+#include "lace_data.h"
+#include "nolace_data.h"
+#endif
+#endif
+
+#define MAX_ROWS 80
+#define MAX_COLS 64
+
+/* Rounds to the nearest half-precision value (ties to even). Only needs to
+   handle the normal range used by the tests. */
+static opus_uint16 float_to_float16(float x)
+{
+   union {
+      opus_uint32 i;
+      float f;
+   } u;
+   opus_uint32 sign, mant;
+   int e;
+   u.f = x;
+   sign = (u.i>>16)&0x8000;
+   if ((u.i&0x7FFFFFFF) == 0) return sign;
+   e = (int)((u.i>>23)&0xFF) - 112;
+   mant = u.i&0x7FFFFF;
+   if (e <= 0 || e >= 31) test_failed();
+   mant = (mant>>13) + (((mant>>12)&1) && ((mant&0x2FFF) != 0));
+   return sign | (((opus_uint32)e<<10) + mant);
+}
+
+static void test_float16_to_float(void)
+{
+   static const struct {
+      opus_uint16 h;
+      float f;
+   } vals[] = {
+      {0x0000, 0.f}, {0x3C00, 1.f}, {0xC000, -2.f}, {0x3555, 0.333251953125f},
+      {0x7BFF, 65504.f}, {0x0400, 6.103515625e-05f}, {0x0001, 5.9604644775390625e-08f},
+      {0x83FF, -6.097555160522461e-05f}
+   };
+   unsigned i;
+   for (i=0;i<sizeof(vals)/sizeof(vals[0]);i++)
+   {
+      expect_true(float16_to_float(vals[i].h) == vals[i].f, "float16 value mismatch");
+      if (vals[i].h >= 0x0400 && vals[i].h < 0x8000) expect_true(float_to_float16(vals[i].f) == vals[i].h, "float16 round trip");
+   }
+   expect_true(float16_to_float(0x7C00) > 1e38f, "expected +inf");
+   fprintf(stdout,"    float16_to_float() ........................... OK.\n");
+}
+
+/* Compares sgemv_f16() against sgemv() on the widened weights (same result up
+   to the rounding of the accumulation) and on the original float weights
+   (within the half-precision quantization error). */
+static void test_sgemv_f16(void)
+{
+   static float w[MAX_ROWS*MAX_COLS];
+   static float w16f[MAX_ROWS*MAX_COLS];
+   static opus_uint16 w16[MAX_ROWS*MAX_COLS];
+   static const int sizes[][2] = {{1, 3}, {7, 5}, {8, 16}, {15, 1}, {16, 64}, {17, 33}, {48, 24}, {80, 64}};
+   float x[MAX_COLS];
+   float out[MAX_ROWS], out_ref[MAX_ROWS], out16[MAX_ROWS];
+   unsigned s;
+   int i, j;
+   for (s=0;s<sizeof(sizes)/sizeof(sizes[0]);s++)
+   {
+      int rows = sizes[s][0];
+      int cols = sizes[s][1];
+      for (j=0;j<cols;j++)
+      {
+         x[j] = ((int)(fast_rand()%2001)-1000)/1000.f;
+         for (i=0;i<rows;i++)
+         {
+            w[j*rows + i] = ((int)(fast_rand()%2001)-1000)/4000.f;
+            w16[j*rows + i] = float_to_float16(w[j*rows + i]);
+            w16f[j*rows + i] = float16_to_float(w16[j*rows + i]);
+         }
+      }
+      sgemv(out_ref, w, rows, cols, rows, x);
+      sgemv(out, w16f, rows, cols, rows, x);
+      sgemv_f16(out16, w16, rows, cols, rows, x);
+      for (i=0;i<rows;i++)
+      {
+         float mag=0;
+         for (j=0;j<cols;j++) mag += fabs(w[j*rows + i]*x[j]);
+         expect_true(fabs(out16[i]-out[i]) <= 1e-5f*(mag+1e-3f), "sgemv_f16() does not match sgemv() on the widened weights");
+         expect_true(fabs(out16[i]-out_ref[i]) <= (1.f/2048)*mag + 1e-6f, "sgemv_f16() too far from the float weights");
+      }
+   }
+   fprintf(stdout,"    sgemv_f16() .................................. OK.\n");
+}
+
+/* This file is built without the SIMD flags, so sgemv_f16() above is the C
+   version. Run half-precision layers through compute_linear() and
+   compute_linear_batch() instead, which dispatch to the F16C kernels where the
+   CPU has them, and compare against the C versions of both. */
+static void test_linear_f16(void)
+{
+   static float w[MAX_ROWS*MAX_COLS];
+   static opus_uint16 w16[MAX_ROWS*MAX_COLS];
+   static const int sizes[][2] = {{1, 3}, {7, 5}, {8, 16}, {15, 1}, {16, 64}, {17, 33}, {48, 24}, {80, 64}};
+   float x[3*MAX_COLS];
+   float out[3*MAX_ROWS], out_c[3*MAX_ROWS];
+   LinearLayer layer;
+   unsigned s;
+   int arch;
+   int i, j, k;
+   arch = opus_select_arch();
+   for (s=0;s<sizeof(sizes)/sizeof(sizes[0]);s++)
+   {
+      int rows = sizes[s][0];
+      int cols = sizes[s][1];
+      for (j=0;j<3*cols;j++) x[j] = ((int)(fast_rand()%2001)-1000)/1000.f;
+      for (j=0;j<rows*cols;j++)
+      {
+         w[j] = ((int)(fast_rand()%2001)-1000)/4000.f;
+         w16[j] = float_to_float16(w[j]);
+      }
+      memset(&layer, 0, sizeof(layer));
+      layer.float16_weights = w16;
+      layer.nb_inputs = cols;
+      layer.nb_outputs = rows;
+      compute_linear_c(&layer, out_c, x);
+      compute_linear(&layer, out, x, arch);
+      for (i=0;i<rows;i++)
+      {
+         float mag=0;
+         for (j=0;j<cols;j++) mag += fabs(w[j*rows + i]*x[j]);
+         expect_true(fabs(out[i]-out_c[i]) <= 1e-5f*(mag+1e-3f), "compute_linear() does not match compute_linear_c() on float16 weights");
+      }
+      compute_linear_batch_c(&layer, out_c, x, 3);
+      compute_linear_batch(&layer, out, x, 3, arch);
+      for (k=0;k<3;k++)
+      {
+         for (i=0;i<rows;i++)
+         {
+            float mag=0;
+            for (j=0;j<cols;j++) mag += fabs(w[j*rows + i]*x[k*cols + j]);
+            expect_true(fabs(out[k*rows + i]-out_c[k*rows + i]) <= 1e-5f*(mag+1e-3f), "compute_linear_batch() does not match compute_linear_batch_c() on float16 weights");
+         }
+      }
+   }
+   fprintf(stdout,"    compute_linear() on float16 weights (arch %d) . OK.\n", arch);
+}
+
+/* compute_linear_batch() must give exactly the same result as calling
+   compute_linear() once per input, for dense and sparse layers with float and
+   int8 weights. The larger sizes are split into several row blocks. */
+static void test_linear_batch(void)
+{
+   static float w[256*144];
+   static opus_int8 w8[640*256];
+   static int idx[(640/8)*(1+256/4)];
+   static float bias[640], subias[640], scale[640], diag[48];
+   static float x[7*256];
+   static float out[7*640], out_ref[7*640];
+   /* rows, cols, int8 weights, sparse, diag */
+   static const int sizes[][5] = {{48, 16, 0, 0, 1}, {40, 24, 0, 0, 0}, {144, 256, 0, 0, 0},
+                                  {40, 24, 0, 1, 0}, {144, 256, 0, 1, 0},
+                                  {64, 32, 1, 0, 0}, {640, 256, 1, 0, 0},
+                                  {64, 32, 1, 1, 0}, {640, 256, 1, 1, 0}};
+   static const int batch[] = {1, 4, 7};
+   LinearLayer layer;
+   unsigned s, b;
+   int arch;
+   int i, j, k;
+   arch = opus_select_arch();
+   for (s=0;s<sizeof(sizes)/sizeof(sizes[0]);s++)
+   {
+      int rows = sizes[s][0];
+      int cols = sizes[s][1];
+      int nb_weights = rows*cols;
+      memset(&layer, 0, sizeof(layer));
+      if (sizes[s][3])
+      {
+         int pos = 0;
+         nb_weights = 0;
+         for (i=0;i<rows;i+=8)
+         {
+            int nb_blocks = 0;
+            for (j=0;j<cols;j+=4)
+            {
+               if (fast_rand()&1) idx[pos + 1 + nb_blocks++] = j;
+            }
+            idx[pos] = nb_blocks;
+            pos += 1 + nb_blocks;
+            nb_weights += 32*nb_blocks;
+         }
+         layer.weights_idx = idx;
+      }
+      for (j=0;j<nb_weights;j++)
+      {
+         if (sizes[s][2]) w8[j] = (int)(fast_rand()%127)-63;
+         else w[j] = ((int)(fast_rand()%2001)-1000)/4000.f;
+      }
+      for (i=0;i<rows;i++)
+      {
+         bias[i] = ((int)(fast_rand()%2001)-1000)/1000.f;
+         subias[i] = ((int)(fast_rand()%2001)-1000)/1000.f;
+         scale[i] = (1+fast_rand()%1000)/(1000.f*128*64);
+      }
+      for (i=0;i<3*cols;i++) diag[i] = ((int)(fast_rand()%2001)-1000)/1000.f;
+      if (sizes[s][2])
+      {
+         layer.weights = w8;
+         layer.scale = scale;
+      }
+      else layer.float_weights = w;
+      layer.bias = bias;
+      layer.subias = subias;
+      if (sizes[s][4]) layer.diag = diag;
+      layer.nb_inputs = cols;
+      layer.nb_outputs = rows;
+      for (b=0;b<sizeof(batch)/sizeof(batch[0]);b++)
+      {
+         int K = batch[b];
+         for (j=0;j<K*cols;j++) x[j] = ((int)(fast_rand()%2001)-1000)/1000.f;
+         compute_linear_batch(&layer, out, x, K, arch);
+         for (k=0;k<K;k++) compute_linear(&layer, &out_ref[k*rows], &x[k*cols], arch);
+         expect_true(memcmp(out, out_ref, K*rows*sizeof(out[0])) == 0, "compute_linear_batch() does not match compute_linear()");
+      }
+   }
+   fprintf(stdout,"    compute_linear_batch() (arch %d) ............. OK.\n", arch);
+}
+
+#ifndef USE_WEIGHTS_FILE
+/* Serializes weight arrays into a version 1 blob without index, the same way
+   write_lpcnet_weights does. */
+static unsigned char *build_blob(const WeightArray *const *lists, int nb_lists, opus_int32 *len)
+{
+   unsigned char *blob;
+   int i, j;
+   opus_int32 pos;
+   *len = 0;
+   for (i=0;i<nb_lists;i++)
+      for (j=0;lists[i][j].name!=NULL;j++)
+         *len += WEIGHT_BLOCK_SIZE + (lists[i][j].size+WEIGHT_BLOCK_SIZE-1)/WEIGHT_BLOCK_SIZE*WEIGHT_BLOCK_SIZE;
+   blob = (unsigned char*)calloc(*len, 1);
+   if (blob == NULL) test_failed();
+   pos = 0;
+   for (i=0;i<nb_lists;i++)
+   {
+      for (j=0;lists[i][j].name!=NULL;j++)
+      {
+         WeightHead h;
+         memset(&h, 0, sizeof(h));
+         memcpy(h.head, "DNNw", 4);
+         h.version = WEIGHT_BLOB_VERSION;
+         h.type = lists[i][j].type;
+         h.size = lists[i][j].size;
+         h.block_size = (h.size+WEIGHT_BLOCK_SIZE-1)/WEIGHT_BLOCK_SIZE*WEIGHT_BLOCK_SIZE;
+         strncpy(h.name, lists[i][j].name, sizeof(h.name)-1);
+         memcpy(blob+pos, &h, sizeof(h));
+         memcpy(blob+pos+WEIGHT_BLOCK_SIZE, lists[i][j].data, h.size);
+         pos += WEIGHT_BLOCK_SIZE + h.block_size;
+      }
+   }
+   return blob;
+}
+
+/* Attaches one model to a created and an application-allocated decoder: both
+   must decode (and conceal) exactly like a decoder using the built-in weights
+   the model was built from, and each must hold, then release, a reference. */
+static void test_shared_model(void)
+{
+   static const WeightArray *const lists[] = {pitchdnn_arrays, plcmodel_arrays, fargan_arrays
+#ifdef ENABLE_OSCE
+      , lacelayers_arrays, nolacelayers_arrays
+#endif
+   };
+   OpusDNNModel *model;
+   OpusEncoder *enc;
+   OpusDecoder *dec[3];
+   unsigned char *blob;
+   unsigned char packet[1276];
+   opus_int16 in[320];
+   opus_int16 out[3][320];
+   opus_int32 len;
+   int i, j, k, err;
+
+   blob = build_blob(lists, sizeof(lists)/sizeof(lists[0]), &len);
+   model = opus_dnn_model_create(blob, len, &err);
+   expect_true(err == OPUS_OK && model != NULL, "opus_dnn_model_create() failed");
+   /* The model keeps its own copy of the blob. */
+   memset(blob, 0, len);
+   free(blob);
+
+   enc = opus_encoder_create(16000, 1, OPUS_APPLICATION_VOIP, &err);
+   expect_true(err == OPUS_OK, "opus_encoder_create() failed");
+   expect_true(opus_encoder_ctl(enc, OPUS_SET_BITRATE(16000)) == OPUS_OK, "OPUS_SET_BITRATE failed");
+   expect_true(opus_encoder_ctl(enc, OPUS_SET_FORCE_MODE(MODE_SILK_ONLY)) == OPUS_OK, "OPUS_SET_FORCE_MODE failed");
+   dec[0] = opus_decoder_create(16000, 1, &err);
+   expect_true(err == OPUS_OK, "opus_decoder_create() failed");
+   dec[1] = (OpusDecoder*)malloc(opus_decoder_get_size(1));
+   expect_true(dec[1] != NULL && opus_decoder_init(dec[1], 16000, 1) == OPUS_OK, "opus_decoder_init() failed");
+   /* Reference decoder using the built-in weights. */
+   dec[2] = opus_decoder_create(16000, 1, &err);
+   expect_true(err == OPUS_OK, "opus_decoder_create() failed");
+   for (k=0;k<3;k++)
+      expect_true(opus_decoder_ctl(dec[k], OPUS_SET_COMPLEXITY(10)) == OPUS_OK, "OPUS_SET_COMPLEXITY failed");
+
+   expect_true(opus_decoder_ctl(dec[0], OPUS_SET_DNN_MODEL(model)) == OPUS_OK, "OPUS_SET_DNN_MODEL failed");
+   expect_true(opus_decoder_ctl(dec[1], OPUS_SET_DNN_MODEL(model)) == OPUS_OK, "OPUS_SET_DNN_MODEL failed");
+   /* Attaching the same model again must not take another reference. */
+   expect_true(opus_decoder_ctl(dec[1], OPUS_SET_DNN_MODEL(model)) == OPUS_OK, "OPUS_SET_DNN_MODEL failed");
+   expect_true(model->refcount == 3, "each decoder should hold one reference");
+   /* The decoders keep the model alive. */
+   opus_dnn_model_destroy(model);
+   expect_true(model->refcount == 2, "opus_dnn_model_destroy() should drop the caller's reference");
+
+   for (i=0;i<50;i++)
+   {
+      for (j=0;j<320;j++)
+         in[j] = (opus_int16)(8000*sin(.05*(i*320+j)) + 3000*sin(.31*(i*320+j)) + (int)(fast_rand()%1001) - 500);
+      len = opus_encode(enc, in, 320, packet, sizeof(packet));
+      expect_true(len > 0, "opus_encode() failed");
+      /* Lose a few packets in a row to run the deep PLC. */
+      for (k=0;k<3;k++)
+      {
+         int ret = opus_decode(dec[k], i%10 >= 7 ? NULL : packet, len, out[k], 320, 0);
+         expect_true(ret == 320, "opus_decode() failed");
+      }
+      expect_true(memcmp(out[0], out[2], sizeof(out[0])) == 0, "shared model output differs from the built-in weights");
+      expect_true(memcmp(out[1], out[2], sizeof(out[1])) == 0, "shared model output differs from the built-in weights");
+   }
+   /* The model survives a reset. */
+   expect_true(opus_decoder_ctl(dec[0], OPUS_RESET_STATE) == OPUS_OK, "OPUS_RESET_STATE failed");
+   expect_true(model->refcount == 2, "OPUS_RESET_STATE should keep the model");
+
+   opus_decoder_deinit(dec[1]);
+   expect_true(model->refcount == 1, "opus_decoder_deinit() should release the model");
+   free(dec[1]);
+   /* Frees the model. */
+   opus_decoder_destroy(dec[0]);
+   opus_decoder_destroy(dec[2]);
+   opus_encoder_destroy(enc);
+   fprintf(stdout,"    OPUS_SET_DNN_MODEL on two decoders ........... OK.\n");
+}
+#endif
+
+int main(int _argc, char **_argv)
+{
+   const char * oversion;
+   int env_used;
+   char *env_seed;
+   env_used=0;
+   env_seed=getenv("SEED");
+   if(_argc>1)iseed=atoi(_argv[1]);
+   else if(env_seed)
+   {
+      iseed=atoi(env_seed);
+      env_used=1;
+   }
+   else iseed=(opus_uint32)time(NULL)^(((opus_uint32)getpid()&65535)<<16);
+   Rw=Rz=iseed;
+
+   oversion=opus_get_version_string();
+   if(!oversion)test_failed();
+   fprintf(stderr,"Testing %s DNN vector kernels. Random seed: %u (%.4X)\n", oversion, iseed, fast_rand() % 65535);
+   if(env_used)fprintf(stderr,"  Random seed set from the environment (SEED=%s).\n", env_seed);
+
+   test_float16_to_float();
+   test_sgemv_f16();
+   test_linear_f16();
+   test_linear_batch();
+#ifndef USE_WEIGHTS_FILE
+   test_shared_model();
+#endif
+
+   fprintf(stderr,"Tests completed successfully.\n");
+   return 0;
+}
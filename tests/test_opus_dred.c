@@ -33,6 +33,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include <math.h>
 #ifndef _WIN32
 #include <unistd.h>
 #else
@@ -83,6 +84,84 @@ void test_random_dred(void)
    opus_dred_decoder_destroy(dred_dec);
 }
 
+#define DRED_TEST_FRAMES 50
+
+/* opus_decoder_dred_decode() keeps the features it decodes in the decoder, so
+   a processed OpusDRED is left untouched, can be shared by several decoders
+   and outlives the DRED decoder that processed it. */
+void test_dred_shared(void)
+{
+   static const opus_int32 offsets[4] = {960, 2880, 1920, 2880};
+   int error;
+   int i, j;
+   int len, size, avail, dred_end;
+   OpusEncoder *enc;
+   OpusDecoder *dec_a;
+   OpusDecoder *dec_b;
+   OpusDREDDecoder *dred_dec;
+   OpusDRED *dred;
+   OpusDRED *dred_copy;
+   unsigned char *dred_bytes;
+   unsigned char packet[1500];
+   opus_int16 pcm[960];
+   opus_int16 out_a[960];
+   opus_int16 out_b[960];
+   enc = opus_encoder_create(48000, 1, OPUS_APPLICATION_VOIP, &error);
+   expect_true(error == OPUS_OK, "opus_encoder_create() failed");
+   expect_true(opus_encoder_ctl(enc, OPUS_SET_BITRATE(32000)) == OPUS_OK, "OPUS_SET_BITRATE failed");
+   expect_true(opus_encoder_ctl(enc, OPUS_SET_PACKET_LOSS_PERC(20)) == OPUS_OK, "OPUS_SET_PACKET_LOSS_PERC failed");
+   expect_true(opus_encoder_ctl(enc, OPUS_SET_DRED_DURATION(100)) == OPUS_OK, "OPUS_SET_DRED_DURATION failed");
+   dec_a = opus_decoder_create(48000, 1, &error);
+   expect_true(error == OPUS_OK, "opus_decoder_create() failed");
+   dred_dec = opus_dred_decoder_create(&error);
+   expect_true(error == OPUS_OK, "opus_dred_decoder_create() failed");
+   dred = opus_dred_alloc(&error);
+   expect_true(error == OPUS_OK, "opus_dred_alloc() failed");
+   len = 0;
+   for (i=0;i<DRED_TEST_FRAMES;i++)
+   {
+      for (j=0;j<960;j++)
+      {
+         int t = i*960 + j;
+         pcm[j] = (opus_int16)(6000*sin(.0196*t)*sin(.0003*t) + 2000*sin(.051*t) + (int)(fast_rand()%2001) - 1000);
+      }
+      len = opus_encode(enc, pcm, 960, packet, sizeof(packet));
+      expect_true(len > 0, "opus_encode() failed");
+      expect_true(opus_decode(dec_a, packet, len, out_a, 960, 0) == 960, "opus_decode() failed");
+   }
+   avail = opus_dred_parse(dred_dec, dred, packet, len, 48000, 48000, &dred_end, 0);
+   expect_true(avail >= offsets[1], "not enough DRED in the last packet");
+
+   size = opus_dred_get_size();
+   dred_copy = (OpusDRED*)malloc(size);
+   dred_bytes = (unsigned char*)malloc(size);
+   expect_true(dred_copy != NULL && dred_bytes != NULL, "malloc() failed");
+   memcpy(dred_copy, dred, size);
+   memcpy(dred_bytes, dred, size);
+   opus_dred_decoder_destroy(dred_dec);
+
+   size = opus_decoder_get_size(1);
+   dec_b = (OpusDecoder*)malloc(size);
+   expect_true(dec_b != NULL, "malloc() failed");
+   memcpy(dec_b, dec_a, size);
+   /* Both decoders go shallow, deep, back and deep again, so that their
+      features are extended and reused. */
+   for (i=0;i<4;i++)
+   {
+      expect_true(opus_decoder_dred_decode(dec_a, dred, offsets[i], out_a, 960) == 960, "opus_decoder_dred_decode() failed");
+      expect_true(opus_decoder_dred_decode(dec_b, i&1 ? dred : dred_copy, offsets[i], out_b, 960) == 960, "opus_decoder_dred_decode() failed");
+      expect_true(memcmp(out_a, out_b, sizeof(out_a)) == 0, "decoders sharing a DRED state disagree");
+   }
+   expect_true(memcmp(dred, dred_bytes, opus_dred_get_size()) == 0, "opus_decoder_dred_decode() modified the DRED state");
+
+   free(dec_b);
+   free(dred_bytes);
+   free(dred_copy);
+   opus_dred_free(dred);
+   opus_decoder_destroy(dec_a);
+   opus_encoder_destroy(enc);
+}
+
 int main(int argc, char **argv)
 {
    int env_used;
@@ -101,6 +180,7 @@ int main(int argc, char **argv)
    fprintf(stderr,"Testing dred. Random seed: %u (%.4X)\n", iseed, fast_rand() % 65535);
    if(env_used)fprintf(stderr,"  Random seed set from the environment (SEED=%s).\n", env_seed);
 
+   test_dred_shared();
    test_random_dred();
    fprintf(stderr,"Tests completed successfully.\n");
    return 0;
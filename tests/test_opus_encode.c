@@ -664,6 +664,108 @@ int run_test1(int no_fuzz)
    return 0;
 }
 
+static int task_runner_calls;
+
+/* Runs the tasks in reverse order to catch any dependency between them. */
+static void reverse_task_runner(void *user_data, opus_ms_run_task_func task, void *arg, int count)
+{
+   int i;
+   (void)user_data;
+   task_runner_calls++;
+   for (i=count-1;i>=0;i--)
+      task(arg, i);
+}
+
+void test_ms_task_runner(void)
+{
+   static const int fsizes[3]={960,480,2880};
+   static const int families[2]={1,2};
+   int f, t, err;
+   OpusMSEncoder *ref, *enc;
+   unsigned char mapping[256];
+   short *inbuf;
+   unsigned char *packet;
+   unsigned char *packet2;
+
+   fprintf(stdout,"  Multistream task runner tests.\n");
+   inbuf = (short*)malloc(sizeof(*inbuf)*SSAMPLES);
+   packet = (unsigned char*)malloc(16*8000);
+   packet2 = (unsigned char*)malloc(16*8000);
+   if(inbuf==NULL || packet==NULL || packet2==NULL)test_failed();
+   generate_music(inbuf, SSAMPLES/2);
+   for(f=0;f<2;f++)
+   {
+      int channels, streams, coupled;
+      channels = families[f]==1 ? 6 : 16;
+      ref = opus_multistream_surround_encoder_create(48000, channels, families[f],
+            &streams, &coupled, mapping, OPUS_APPLICATION_AUDIO, &err);
+      if(err!=OPUS_OK || ref==NULL)test_failed();
+      enc = opus_multistream_surround_encoder_create(48000, channels, families[f],
+            &streams, &coupled, mapping, OPUS_APPLICATION_AUDIO, &err);
+      if(err!=OPUS_OK || enc==NULL)test_failed();
+      err = opus_multistream_encoder_ctl(enc, OPUS_MULTISTREAM_SET_TASK_RUNNER(reverse_task_runner, NULL));
+      if(err==OPUS_UNIMPLEMENTED)
+      {
+         /* Not available with NONTHREADSAFE_PSEUDOSTACK. */
+         opus_multistream_encoder_destroy(ref);
+         opus_multistream_encoder_destroy(enc);
+         free(inbuf);
+         free(packet);
+         free(packet2);
+         fprintf(stdout,"    Task runner not supported, skipped.\n");
+         return;
+      }
+      if(err!=OPUS_OK)test_failed();
+      task_runner_calls=0;
+      for(t=0;t<30;t++)
+      {
+         int fsize, len, len2;
+         opus_int32 bitrate;
+         /* Alternate between buffers that allow concurrent encoding and ones
+            small enough to force the serial fallback. */
+         opus_int32 max_bytes = (t&1) ? 16*7662 : 4000;
+         fsize = fsizes[t%3];
+         bitrate = (t%5+1)*24000*streams;
+         if(opus_multistream_encoder_ctl(ref, OPUS_SET_BITRATE(bitrate))!=OPUS_OK)test_failed();
+         if(opus_multistream_encoder_ctl(enc, OPUS_SET_BITRATE(bitrate))!=OPUS_OK)test_failed();
+         len = opus_multistream_encode(ref, &inbuf[t*960*channels%(SSAMPLES-5760*16)], fsize, packet, max_bytes);
+         len2 = opus_multistream_encode(enc, &inbuf[t*960*channels%(SSAMPLES-5760*16)], fsize, packet2, max_bytes);
+         if(len<0 || len!=len2)test_failed();
+         if(memcmp(packet, packet2, len)!=0)test_failed();
+      }
+      if(task_runner_calls==0)test_failed();
+      opus_multistream_encoder_destroy(ref);
+      opus_multistream_encoder_destroy(enc);
+   }
+   /* 16 mono streams with 60 ms frames and a buffer large enough for
+      concurrent encoding, which needs 16 full-size per-stream buffers. */
+   for(t=0;t<16;t++)mapping[t]=t;
+   ref = opus_multistream_encoder_create(48000, 16, 16, 0, mapping, OPUS_APPLICATION_AUDIO, &err);
+   if(err!=OPUS_OK || ref==NULL)test_failed();
+   enc = opus_multistream_encoder_create(48000, 16, 16, 0, mapping, OPUS_APPLICATION_AUDIO, &err);
+   if(err!=OPUS_OK || enc==NULL)test_failed();
+   if(opus_multistream_encoder_ctl(enc, OPUS_MULTISTREAM_SET_TASK_RUNNER(reverse_task_runner, NULL))!=OPUS_OK)test_failed();
+   task_runner_calls=0;
+   for(t=0;t<6;t++)
+   {
+      int len, len2;
+      opus_int32 bitrate = (t+1)*32000*16;
+      if(opus_multistream_encoder_ctl(ref, OPUS_SET_BITRATE(bitrate))!=OPUS_OK)test_failed();
+      if(opus_multistream_encoder_ctl(enc, OPUS_SET_BITRATE(bitrate))!=OPUS_OK)test_failed();
+      len = opus_multistream_encode(ref, &inbuf[t*2880*16%(SSAMPLES-2880*16)], 2880, packet, 16*8000);
+      len2 = opus_multistream_encode(enc, &inbuf[t*2880*16%(SSAMPLES-2880*16)], 2880, packet2, 16*8000);
+      if(len<0 || len!=len2)test_failed();
+      if(memcmp(packet, packet2, len)!=0)test_failed();
+   }
+   if(task_runner_calls!=6)test_failed();
+   opus_multistream_encoder_destroy(ref);
+   opus_multistream_encoder_destroy(enc);
+   free(inbuf);
+   free(packet);
+   free(packet2);
+   fprintf(stdout,"    All task runner tests OK.\n");
+}
+
 void print_usage(char* _argv[])
 {
    fprintf(stderr,"Usage: %s [<seed>] [-fuzz <num_encoders> <num_settings_per_encoder>]\n",_argv[0]);
@@ -725,6 +827,8 @@ int main(int _argc, char **_argv)
      may cause the decoders to clip, which angers CLANG IOC.*/
    run_test1(getenv("TEST_OPUS_NOFUZZ")!=NULL);
 
+   test_ms_task_runner();
+
    /* Fuzz encoder settings online */
    if(getenv("TEST_OPUS_NOFUZZ")==NULL) {
       fprintf(stderr,"Running fuzz_encoder_settings with %d encoder(s) and %d setting change(s) each.\n",